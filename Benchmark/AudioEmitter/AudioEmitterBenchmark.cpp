@@ -0,0 +1,405 @@
+/**
+ * @file AudioEmitterBenchmark.cpp
+ * @brief 3Dの音をまとめて計算するエミッタ(AudioEmitterSystem)の確認とベンチマーク
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <numbers>
+#include <algorithm>
+
+#include "AudioEmitterSystem.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 止めるまで鳴り続ける偽のバックエンド
+	/// </summary>
+	class FakeVoiceBackend final : public Elysia::IVoiceBackend {
+	public:
+		uint32_t CreateVoice(const Elysia::AudioFormat& format) override {
+			format;
+			voices_.push_back({ .isPlaying = false, .left = 0.0f, .right = 0.0f });
+			return uint32_t(voices_.size() - 1u);
+		}
+
+		void Start(const uint32_t& voiceId, const Elysia::VoiceBuffer& buffer, const float& volume) override {
+			buffer;
+			volume;
+			voices_[voiceId].isPlaying = true;
+		}
+
+		void Stop(const uint32_t& voiceId) override {
+			voices_[voiceId].isPlaying = false;
+		}
+
+		void SetVolume(const uint32_t& voiceId, const float& volume) override {
+			voiceId;
+			volume;
+		}
+
+		void SetStereoGains(const uint32_t& voiceId, const float& left, const float& right) override {
+			voices_[voiceId].left = left;
+			voices_[voiceId].right = right;
+			++stereoGainCount_;
+		}
+
+		bool IsPlaying(const uint32_t& voiceId) const override {
+			return voices_[voiceId].isPlaying;
+		}
+
+		/// <summary>
+		/// 鳴り終わらせる
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		void Finish(const uint32_t& voiceId) {
+			voices_[voiceId].isPlaying = false;
+		}
+
+		/// <summary>
+		/// 鳴っている数
+		/// </summary>
+		/// <returns>数</returns>
+		uint32_t GetPlayingCount() const {
+			return uint32_t(std::count_if(voices_.begin(), voices_.end(), [](const FakeVoice& voice) {
+				return voice.isPlaying;
+			}));
+		}
+
+		/// <summary>
+		/// 左右の大きさを伝えられた回数
+		/// </summary>
+		/// <returns>回数</returns>
+		uint32_t GetStereoGainCount() const {
+			return stereoGainCount_;
+		}
+
+	private:
+		struct FakeVoice {
+			bool isPlaying;
+			float left;
+			float right;
+		};
+		std::vector<FakeVoice> voices_;
+		uint32_t stereoGainCount_ = 0u;
+	};
+
+	//48kHzの16bitモノラル
+	const Elysia::AudioFormat MONO_FORMAT = { .channelCount = 1u, .sampleRate = 48000u, .bitsPerSample = 16u };
+
+	/// <summary>
+	/// ずっとループする鳴らすもの
+	/// </summary>
+	/// <returns>鳴らすもの</returns>
+	Elysia::VoiceBuffer MakeLoopBuffer() {
+		static std::vector<uint8_t> data(4096u);
+		return { .data = data.data(), .byteCount = uint32_t(data.size()), .loopCount = Elysia::VoiceBuffer::LOOP_INFINITE_ };
+	}
+
+	/// <summary>
+	/// 設定
+	/// </summary>
+	/// <param name="curve">減衰の仕方</param>
+	/// <param name="priority">優先度</param>
+	/// <returns>設定</returns>
+	Elysia::AudioEmitterSettings MakeSettings(const Elysia::AttenuationCurve& curve, const int32_t& priority) {
+		return {
+			.minDistance = 1.0f,
+			.maxDistance = 30.0f,
+			.curve = curve,
+			.coneInnerAngle = 2.0f * std::numbers::pi_v<float>,
+			.coneOuterAngle = 2.0f * std::numbers::pi_v<float>,
+			.coneOuterGain = 1.0f,
+			.priority = priority,
+		};
+	}
+
+	//原点で+Zを向いている聞き手
+	const Elysia::AudioListener LISTENER = {
+		.position = { .x = 0.0f, .y = 0.0f, .z = 0.0f },
+		.forward = { .x = 0.0f, .y = 0.0f, .z = 1.0f },
+		.up = { .x = 0.0f, .y = 1.0f, .z = 0.0f },
+	};
+
+	/// <summary>
+	/// 減衰、コーン、パン
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckGain(bool& isValid) {
+		using Elysia::AudioEmitterSystem;
+		const Vector3 NO_DIRECTION = { .x = 0.0f, .y = 0.0f, .z = 0.0f };
+		Elysia::AudioEmitterSettings linear = MakeSettings(Elysia::AttenuationCurve::Linear, 0);
+		Elysia::AudioEmitterSettings inverse = MakeSettings(Elysia::AttenuationCurve::Inverse, 0);
+		Elysia::AudioEmitterSettings inverseSquare = MakeSettings(Elysia::AttenuationCurve::InverseSquare, 0);
+		auto gainAt = [&](const Elysia::AudioEmitterSettings& settings, const float& distance) {
+			return AudioEmitterSystem::CalculateGain(LISTENER, { .x = 0.0f, .y = 0.0f, .z = distance }, NO_DIRECTION, settings, 1.0f, 0.0f).gain;
+		};
+
+		//最小距離までは同じ大きさ、最大距離より遠ければ0
+		Check(gainAt(linear, 0.5f) == 1.0f && gainAt(inverse, 0.5f) == 1.0f, "最小距離までは減衰しない", isValid);
+		Check(gainAt(linear, 31.0f) == 0.0f && gainAt(inverse, 31.0f) == 0.0f, "最大距離より遠ければ聞こえない", isValid);
+		float linearMiddle = gainAt(linear, 15.5f);
+		Check(std::abs(linearMiddle - 0.5f) < 0.0001f, "線形は真ん中で半分", isValid);
+		Check(std::abs(gainAt(inverse, 4.0f) - 0.25f) < 0.0001f && std::abs(gainAt(inverseSquare, 4.0f) - 0.0625f) < 0.0001f, "距離に反比例、2乗に反比例", isValid);
+		Check(gainAt(linear, 5.0f) > gainAt(linear, 10.0f) && gainAt(inverseSquare, 2.0f) > gainAt(inverseSquare, 3.0f), "遠いほど小さい", isValid);
+
+		//コーン(内側90度、外側180度、外側は0.25)
+		Elysia::AudioEmitterSettings cone = linear;
+		cone.coneInnerAngle = std::numbers::pi_v<float> * 0.5f;
+		cone.coneOuterAngle = std::numbers::pi_v<float>;
+		cone.coneOuterGain = 0.25f;
+		//エミッタは(0,0,5)で-Zを向いていると聞き手の方を向いている
+		Vector3 position = { .x = 0.0f, .y = 0.0f, .z = 5.0f };
+		float front = AudioEmitterSystem::CalculateGain(LISTENER, position, { .x = 0.0f, .y = 0.0f, .z = -1.0f }, cone, 1.0f, 0.0f).gain;
+		float back = AudioEmitterSystem::CalculateGain(LISTENER, position, { .x = 0.0f, .y = 0.0f, .z = 1.0f }, cone, 1.0f, 0.0f).gain;
+		float omni = AudioEmitterSystem::CalculateGain(LISTENER, position, NO_DIRECTION, cone, 1.0f, 0.0f).gain;
+		Check(std::abs(front - omni) < 0.0001f && std::abs(back - omni * 0.25f) < 0.0001f, "コーンの内側と外側", isValid);
+
+		//右にあれば右が大きい
+		Elysia::AudioEmitterGain right = AudioEmitterSystem::CalculateGain(LISTENER, { .x = 5.0f, .y = 0.0f, .z = 0.0f }, NO_DIRECTION, linear, 1.0f, 0.0f);
+		Elysia::AudioEmitterGain left = AudioEmitterSystem::CalculateGain(LISTENER, { .x = -5.0f, .y = 0.0f, .z = 0.0f }, NO_DIRECTION, linear, 1.0f, 0.0f);
+		Elysia::AudioEmitterGain center = AudioEmitterSystem::CalculateGain(LISTENER, position, NO_DIRECTION, linear, 1.0f, 0.0f);
+		Check(right.pan > 0.99f && right.right > right.left && left.pan < -0.99f && left.left > left.right, "右にあれば右、左にあれば左", isValid);
+		Check(std::abs(center.left * center.left + center.right * center.right - center.gain * center.gain) < 0.0001f, "真ん中でも大きさが変わらない", isValid);
+
+		//遮られると小さくなる
+		float occluded = AudioEmitterSystem::CalculateGain(LISTENER, position, NO_DIRECTION, linear, 1.0f, 0.75f).gain;
+		Check(std::abs(occluded - center.gain * 0.25f) < 0.0001f, "遮られ具合", isValid);
+	}
+
+	/// <summary>
+	/// まとめて計算したものと1つずつ計算したものが同じか
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckBatch(bool& isValid) {
+		const uint32_t EMITTER_COUNT = 203u;
+		FakeVoiceBackend backend;
+		Elysia::VoicePool pool;
+		pool.Initialize(&backend);
+		pool.Reserve(MONO_FORMAT, 8u);
+		Elysia::AudioEmitterSystem system;
+		system.Initialize(&pool, EMITTER_COUNT);
+
+		uint32_t seed = 12345u;
+		auto random = [&seed](const float& range) {
+			seed = seed * 1664525u + 1013904223u;
+			return (float(seed >> 8u) / float(1u << 24u) * 2.0f - 1.0f) * range;
+		};
+
+		struct Expected {
+			Vector3 position;
+			Vector3 direction;
+			Elysia::AudioEmitterSettings settings;
+			float volume;
+			float occlusion;
+		};
+		std::vector<Expected> expecteds;
+		for (uint32_t i = 0u; i < EMITTER_COUNT; ++i) {
+			Elysia::AudioEmitterSettings settings = MakeSettings(Elysia::AttenuationCurve(i % 3u), 0);
+			settings.coneInnerAngle = 1.0f;
+			settings.coneOuterAngle = 2.5f;
+			settings.coneOuterGain = 0.3f;
+			Expected expected = {
+				.position = { .x = random(40.0f), .y = random(5.0f), .z = random(40.0f) },
+				.direction = (i % 2u == 0u) ? Vector3{ .x = random(1.0f), .y = 0.0f, .z = random(1.0f) } : Vector3{ .x = 0.0f, .y = 0.0f, .z = 0.0f },
+				.settings = settings,
+				.volume = 0.5f + random(0.5f),
+				.occlusion = (i % 5u == 0u) ? 0.5f : 0.0f,
+			};
+			uint32_t id = system.Create(MONO_FORMAT, MakeLoopBuffer(), settings);
+			system.SetPosition(id, expected.position);
+			system.SetDirection(id, expected.direction);
+			system.SetVolume(id, expected.volume);
+			system.SetOcclusion(id, expected.occlusion);
+			system.Play(id);
+			expecteds.push_back(expected);
+		}
+
+		Elysia::AudioListener listener = {
+			.position = { .x = 3.0f, .y = 1.0f, .z = -2.0f },
+			.forward = { .x = 0.6f, .y = 0.0f, .z = 0.8f },
+			.up = { .x = 0.0f, .y = 1.0f, .z = 0.0f },
+		};
+		system.Update(listener);
+
+		float maxError = 0.0f;
+		for (uint32_t id = 0u; id < EMITTER_COUNT; ++id) {
+			const Expected& expected = expecteds[id];
+			Elysia::AudioEmitterGain reference = Elysia::AudioEmitterSystem::CalculateGain(listener, expected.position, expected.direction, expected.settings, expected.volume, expected.occlusion);
+			Elysia::AudioEmitterGain gain = system.GetGain(id);
+			maxError = std::max({ maxError, std::abs(gain.gain - reference.gain), std::abs(gain.pan - reference.pan), std::abs(gain.left - reference.left), std::abs(gain.right - reference.right) });
+		}
+		std::printf("  1つずつ計算したものとの差 最大 %g\n", maxError);
+		Check(maxError < 0.0001f, "まとめて計算しても同じ", isValid);
+
+		//ボイスより多く聞こえていれば残りは仮想化する
+		const Elysia::AudioEmitterSystem::Statistics& statistics = system.GetStatistics();
+		Check(statistics.audibleCount == 8u && backend.GetPlayingCount() == 8u, "ボイスの数だけ鳴らす", isValid);
+		Check(statistics.audibleCount + statistics.virtualCount == EMITTER_COUNT, "鳴らせないものは仮想化", isValid);
+
+		//大きいものから鳴らす
+		std::vector<uint32_t> ids(EMITTER_COUNT);
+		for (uint32_t id = 0u; id < EMITTER_COUNT; ++id) {
+			ids[id] = id;
+		}
+		std::sort(ids.begin(), ids.end(), [&system](const uint32_t& a, const uint32_t& b) {
+			return system.GetGain(a).gain > system.GetGain(b).gain;
+		});
+		bool isLoudestAudible = std::all_of(ids.begin(), ids.begin() + 8, [&system](const uint32_t& id) {
+			return system.GetIsAudible(id);
+		});
+		Check(isLoudestAudible == true, "大きいものから鳴らす", isValid);
+
+		//聞き手が動いて十分に大きくなったものは入れ替える
+		//少しだけ大きいものでは入れ替えない
+		uint32_t quietId = ids[7];
+		uint32_t nextId = ids[8];
+		system.SetVolume(nextId, expecteds[nextId].volume * 1.1f);
+		system.Update(listener);
+		bool isKept = system.GetIsAudible(quietId) == true && system.GetIsAudible(nextId) == false;
+		system.SetVolume(nextId, expecteds[nextId].volume * 100.0f);
+		system.Update(listener);
+		Check(isKept == true && system.GetIsAudible(nextId) == true && system.GetIsAudible(quietId) == false, "十分に大きくなったら入れ替える", isValid);
+	}
+
+	/// <summary>
+	/// 仮想化と変わった時だけ伝えること
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckVirtualize(bool& isValid) {
+		FakeVoiceBackend backend;
+		Elysia::VoicePool pool;
+		pool.Initialize(&backend);
+		pool.Reserve(MONO_FORMAT, 4u);
+		Elysia::AudioEmitterSystem system;
+		system.Initialize(&pool, 16u);
+
+		uint32_t id = system.Create(MONO_FORMAT, MakeLoopBuffer(), MakeSettings(Elysia::AttenuationCurve::Linear, 0));
+		system.SetPosition(id, { .x = 100.0f, .y = 0.0f, .z = 0.0f });
+		system.Play(id);
+		system.Update(LISTENER);
+		Check(system.GetIsAudible(id) == false && backend.GetPlayingCount() == 0u, "遠い間はボイスを使わない", isValid);
+
+		//近づいたら鳴らす
+		system.SetPosition(id, { .x = 5.0f, .y = 0.0f, .z = 0.0f });
+		system.Update(LISTENER);
+		Check(system.GetIsAudible(id) == true && system.GetStatistics().startedCount == 1u, "近づいたら鳴らす", isValid);
+
+		//動かなければ何も伝えない
+		uint32_t stereoGainCount = backend.GetStereoGainCount();
+		for (uint32_t i = 0u; i < 10u; ++i) {
+			system.Update(LISTENER);
+		}
+		Check(backend.GetStereoGainCount() == stereoGainCount, "変わらなければ伝えない", isValid);
+
+		//少しだけ動いても伝えない、大きく動いたら伝える
+		system.SetPosition(id, { .x = 5.0f, .y = 0.0f, .z = 0.001f });
+		system.Update(LISTENER);
+		bool isSkipped = backend.GetStereoGainCount() == stereoGainCount;
+		system.SetPosition(id, { .x = 5.0f, .y = 0.0f, .z = 5.0f });
+		system.Update(LISTENER);
+		Check(isSkipped == true && backend.GetStereoGainCount() == stereoGainCount + 1u, "大きく変わった時だけ伝える", isValid);
+
+		//離れたら止める
+		system.SetPosition(id, { .x = 100.0f, .y = 0.0f, .z = 0.0f });
+		system.Update(LISTENER);
+		Check(system.GetIsAudible(id) == false && backend.GetPlayingCount() == 0u && system.GetStatistics().virtualCount == 1u, "離れたら止めて仮想化", isValid);
+
+		//止めたら鳴らさない
+		system.SetPosition(id, { .x = 5.0f, .y = 0.0f, .z = 0.0f });
+		system.Stop(id);
+		system.Update(LISTENER);
+		Check(backend.GetPlayingCount() == 0u && system.GetStatistics().virtualCount == 0u, "止めたら近くても鳴らさない", isValid);
+
+		//ループしない音は鳴り終わったら終わり
+		Elysia::VoiceBuffer oneShot = MakeLoopBuffer();
+		oneShot.loopCount = 0u;
+		uint32_t oneShotId = system.Create(MONO_FORMAT, oneShot, MakeSettings(Elysia::AttenuationCurve::Inverse, 0));
+		system.SetPosition(oneShotId, { .x = 2.0f, .y = 0.0f, .z = 0.0f });
+		system.Play(oneShotId);
+		system.Update(LISTENER);
+		bool isStarted = system.GetIsAudible(oneShotId);
+		for (uint32_t voiceId = 0u; voiceId < 4u; ++voiceId) {
+			backend.Finish(voiceId);
+		}
+		system.Update(LISTENER);
+		system.Update(LISTENER);
+		Check(isStarted == true && backend.GetPlayingCount() == 0u && system.GetStatistics().startedCount == 0u, "ループしない音は1回だけ", isValid);
+
+		//消したら番号を使い回す
+		system.Destroy(id);
+		uint32_t reusedId = system.Create(MONO_FORMAT, MakeLoopBuffer(), MakeSettings(Elysia::AttenuationCurve::Linear, 0));
+		Check(reusedId == id && system.GetStatistics().emitterCount == 2u, "消した番号を使い回す", isValid);
+	}
+
+	/// <summary>
+	/// たくさんのエミッタを動かし続ける
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Simulate(bool& isValid) {
+		const uint32_t EMITTER_COUNT = 1024u;
+		const uint32_t FRAME_COUNT = 60u * 60u;
+		FakeVoiceBackend backend;
+		Elysia::VoicePool pool;
+		pool.Initialize(&backend);
+		pool.Reserve(MONO_FORMAT, 32u);
+		Elysia::AudioEmitterSystem system;
+		system.Initialize(&pool, EMITTER_COUNT);
+		for (uint32_t i = 0u; i < EMITTER_COUNT; ++i) {
+			uint32_t id = system.Create(MONO_FORMAT, MakeLoopBuffer(), MakeSettings(Elysia::AttenuationCurve::Inverse, int32_t(i % 4u)));
+			system.Play(id);
+		}
+
+		uint64_t pushedCount = 0u;
+		uint32_t maxAudibleCount = 0u;
+		double updateMilliseconds = 0.0;
+		for (uint32_t frame = 0u; frame < FRAME_COUNT; ++frame) {
+			//エミッタは円の上をゆっくり回る
+			float time = float(frame) / 60.0f;
+			for (uint32_t id = 0u; id < EMITTER_COUNT; ++id) {
+				float angle = float(id) * 0.37f + time * 0.1f;
+				float radius = 5.0f + float(id % 64u);
+				system.SetPosition(id, { .x = std::cos(angle) * radius, .y = 0.0f, .z = std::sin(angle) * radius });
+			}
+			//聞き手は歩き回る
+			Elysia::AudioListener listener = LISTENER;
+			listener.position = { .x = std::sin(time * 0.2f) * 20.0f, .y = 0.0f, .z = std::cos(time * 0.3f) * 20.0f };
+
+			auto start = std::chrono::steady_clock::now();
+			system.Update(listener);
+			updateMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			pushedCount += system.GetStatistics().pushedCount;
+			maxAudibleCount = std::max(maxAudibleCount, system.GetStatistics().audibleCount);
+		}
+
+		std::printf("  エミッタ %u 個  %uフレーム\n", EMITTER_COUNT, FRAME_COUNT);
+		std::printf("  Update 平均 %.3f ms (1エミッタ %.1f ns)\n", updateMilliseconds / FRAME_COUNT, updateMilliseconds * 1000000.0 / FRAME_COUNT / EMITTER_COUNT);
+		std::printf("  伝えた回数 1フレーム平均 %.1f 回  鳴っている最大 %u\n", double(pushedCount) / FRAME_COUNT, maxAudibleCount);
+		Check(maxAudibleCount <= 32u && backend.GetPlayingCount() <= 32u, "ボイスの数を超えない", isValid);
+		Check(backend.GetStereoGainCount() < uint64_t(FRAME_COUNT) * 32u, "毎フレーム全部は伝えない", isValid);
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("大きさ\n");
+	CheckGain(isValid);
+	std::printf("まとめて計算\n");
+	CheckBatch(isValid);
+	std::printf("仮想化\n");
+	CheckVirtualize(isValid);
+	std::printf("シミュレーション\n");
+	Simulate(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,460 @@
+/**
+ * @file AudioMixerBenchmark.cpp
+ * @brief XAudio2に頼らずに音を混ぜるミキサー(AudioMixer)の確認とベンチマーク
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <numbers>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+
+#include "AudioMixer.h"
+#include "MixerDecoder.h"
+#include "AudioStream.h"
+#include "WaveFileStreamSink.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	//出力の周波数
+	const uint32_t SAMPLE_RATE = 48000u;
+	//1回に混ぜるフレーム数
+	const uint32_t FRAMES_PER_BLOCK = 512u;
+
+	/// <summary>
+	/// 16bitのモノラルの形式
+	/// </summary>
+	/// <param name="sampleRate">周波数</param>
+	/// <returns>形式</returns>
+	Elysia::AudioFormat MakeMonoFormat(const uint32_t& sampleRate) {
+		return { .channelCount = 1u, .sampleRate = sampleRate, .bitsPerSample = 16u, .isFloat = false };
+	}
+
+	/// <summary>
+	/// floatのモノラルの形式
+	/// </summary>
+	/// <returns>形式</returns>
+	Elysia::AudioFormat MakeFloatMonoFormat() {
+		return { .channelCount = 1u, .sampleRate = SAMPLE_RATE, .bitsPerSample = 32u, .isFloat = true };
+	}
+
+	/// <summary>
+	/// 正弦波を作る
+	/// </summary>
+	/// <param name="frequency">周波数</param>
+	/// <param name="sampleRate">サンプリング周波数</param>
+	/// <param name="frameCount">フレーム数</param>
+	/// <returns>16bitのモノラル</returns>
+	std::vector<int16_t> MakeSine(const float& frequency, const uint32_t& sampleRate, const uint32_t& frameCount) {
+		std::vector<int16_t> samples(frameCount);
+		for (uint32_t i = 0u; i < frameCount; ++i) {
+			double phase = 2.0 * std::numbers::pi * double(frequency) * double(i) / double(sampleRate);
+			samples[i] = int16_t(std::sin(phase) * 16000.0);
+		}
+		return samples;
+	}
+
+	/// <summary>
+	/// 鳴らすものを作る
+	/// </summary>
+	/// <param name="data">PCM</param>
+	/// <param name="byteCount">バイト数</param>
+	/// <returns>鳴らすもの</returns>
+	Elysia::AudioMixer::SourceBuffer MakeBuffer(const void* data, const size_t& byteCount) {
+		return {
+			.data = static_cast<const uint8_t*>(data),
+			.byteCount = uint32_t(byteCount),
+			.loopBegin = 0u,
+			.loopLength = 0u,
+			.loopCount = 0u,
+		};
+	}
+
+	/// <summary>
+	/// 混ぜる
+	/// </summary>
+	/// <param name="mixer">ミキサー</param>
+	/// <param name="frameCount">フレーム数</param>
+	/// <param name="chunkFrameCount">1回で頼むフレーム数</param>
+	/// <returns>ステレオのfloat</returns>
+	std::vector<float> Render(Elysia::AudioMixer& mixer, const uint32_t& frameCount, const uint32_t& chunkFrameCount) {
+		std::vector<float> output(size_t(frameCount) * 2u);
+		for (uint32_t frame = 0u; frame < frameCount; frame += chunkFrameCount) {
+			uint32_t count = std::min(chunkFrameCount, frameCount - frame);
+			mixer.Render(output.data() + size_t(frame) * 2u, count);
+		}
+		return output;
+	}
+
+	/// <summary>
+	/// 0を横切った回数
+	/// </summary>
+	/// <param name="output">ステレオのfloat</param>
+	/// <param name="channel">チャンネル</param>
+	/// <returns>回数</returns>
+	uint32_t CountZeroCrossings(const std::vector<float>& output, const uint32_t& channel) {
+		uint32_t count = 0u;
+		for (size_t i = 2u + channel; i < output.size(); i += 2u) {
+			if ((output[i - 2u] < 0.0f) != (output[i] < 0.0f)) {
+				++count;
+			}
+		}
+		return count;
+	}
+
+	/// <summary>
+	/// 実効値
+	/// </summary>
+	/// <param name="output">ステレオのfloat</param>
+	/// <param name="channel">チャンネル</param>
+	/// <param name="firstFrame">最初のフレーム(フィルターが落ち着いてから)</param>
+	/// <returns>実効値</returns>
+	double CalculateRms(const std::vector<float>& output, const uint32_t& channel, const size_t& firstFrame) {
+		double sum = 0.0;
+		size_t count = 0u;
+		for (size_t i = firstFrame * 2u + channel; i < output.size(); i += 2u) {
+			sum += double(output[i]) * double(output[i]);
+			++count;
+		}
+		return std::sqrt(sum / double(count));
+	}
+
+	/// <summary>
+	/// 色々かけた音を混ぜる
+	/// 何回やっても同じになるかの確認と、WAVファイルとの比較に使う
+	/// </summary>
+	/// <param name="mixer">ミキサー</param>
+	/// <param name="sines">鳴らすもの(鳴り終わるまで持っておく)</param>
+	void SetUpScene(Elysia::AudioMixer& mixer, std::vector<std::vector<int16_t>>& sines) {
+		mixer.Initialize({ .sampleRate = SAMPLE_RATE, .framesPerBlock = FRAMES_PER_BLOCK });
+		uint32_t musicBus = mixer.CreateBus(Elysia::AudioMixer::MASTER_BUS_);
+		uint32_t effectBus = mixer.CreateBus(Elysia::AudioMixer::MASTER_BUS_);
+		mixer.SetBusVolume(musicBus, 0.6f);
+		mixer.SetBusFilter(effectBus, { .type = Elysia::BiquadType::HighPass, .frequency = 150.0f, .q = 0.707f });
+
+		sines.clear();
+		for (uint32_t i = 0u; i < 8u; ++i) {
+			uint32_t sampleRate = (i % 2u == 0u) ? 44100u : SAMPLE_RATE;
+			sines.push_back(MakeSine(220.0f * float(i + 1u), sampleRate, sampleRate / 2u));
+		}
+		for (uint32_t i = 0u; i < 8u; ++i) {
+			uint32_t sampleRate = (i % 2u == 0u) ? 44100u : SAMPLE_RATE;
+			uint32_t sourceId = mixer.CreateSource(MakeMonoFormat(sampleRate), (i < 4u) ? musicBus : effectBus);
+			Elysia::AudioMixer::SourceBuffer buffer = MakeBuffer(sines[i].data(), sines[i].size() * sizeof(int16_t));
+			buffer.loopBegin = sampleRate / 8u;
+			buffer.loopCount = i % 3u;
+			mixer.SetVolume(sourceId, 0.2f);
+			mixer.SetPan(sourceId, float(i) / 4.0f - 1.0f);
+			mixer.SetFrequencyRatio(sourceId, 0.75f + float(i) * 0.1f);
+			if (i % 3u == 0u) {
+				mixer.SetFilter(sourceId, { .type = Elysia::BiquadType::LowPass, .frequency = 1000.0f, .q = 0.707f });
+			}
+			mixer.Start(sourceId, buffer);
+		}
+	}
+
+	/// <summary>
+	/// 周波数を変えて読むこと
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckResample(bool& isValid) {
+		//44.1kHzの441Hzを48kHzで鳴らしても441Hzのまま
+		Elysia::AudioMixer mixer;
+		mixer.Initialize({ .sampleRate = SAMPLE_RATE, .framesPerBlock = FRAMES_PER_BLOCK });
+		std::vector<int16_t> sine = MakeSine(441.0f, 44100u, 44100u * 2u);
+		uint32_t sourceId = mixer.CreateSource(MakeMonoFormat(44100u), Elysia::AudioMixer::MASTER_BUS_);
+		mixer.Start(sourceId, MakeBuffer(sine.data(), sine.size() * sizeof(int16_t)));
+		std::vector<float> output = Render(mixer, SAMPLE_RATE, FRAMES_PER_BLOCK);
+		uint32_t crossings = CountZeroCrossings(output, 0u);
+		std::printf("  441Hz 1秒で0を横切った回数 %u (882)\n", crossings);
+		Check(crossings >= 880u && crossings <= 884u, "周波数が違っても同じ高さ", isValid);
+
+		//ChangePitchと同じく比を2にすると1オクターブ上
+		std::vector<int16_t> sine48 = MakeSine(440.0f, SAMPLE_RATE, SAMPLE_RATE * 2u);
+		uint32_t pitchedId = mixer.CreateSource(MakeMonoFormat(SAMPLE_RATE), Elysia::AudioMixer::MASTER_BUS_);
+		mixer.Stop(sourceId);
+		mixer.SetFrequencyRatio(pitchedId, 2.0f);
+		mixer.Start(pitchedId, MakeBuffer(sine48.data(), sine48.size() * sizeof(int16_t)));
+		output = Render(mixer, SAMPLE_RATE / 2u, 1000u);
+		crossings = CountZeroCrossings(output, 0u);
+		std::printf("  440Hzを2倍で0.5秒 0を横切った回数 %u (880)\n", crossings);
+		Check(crossings >= 878u && crossings <= 882u, "比を2にすると1オクターブ上", isValid);
+		//2倍で読むので2秒の音が1秒で終わる
+		Render(mixer, SAMPLE_RATE / 2u + 8u, FRAMES_PER_BLOCK);
+		Check(mixer.IsPlaying(pitchedId) == false, "速く読んだ分早く終わる", isValid);
+	}
+
+	/// <summary>
+	/// ループする範囲
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckLoop(bool& isValid) {
+		Elysia::AudioMixer mixer;
+		mixer.Initialize({ .sampleRate = SAMPLE_RATE, .framesPerBlock = FRAMES_PER_BLOCK });
+		//フレームの番号が分かるように
+		std::vector<float> ramp(1000u);
+		for (uint32_t i = 0u; i < 1000u; ++i) {
+			ramp[i] = float(i) / 1000.0f;
+		}
+		uint32_t sourceId = mixer.CreateSource(MakeFloatMonoFormat(), Elysia::AudioMixer::MASTER_BUS_);
+		Elysia::AudioMixer::SourceBuffer buffer = MakeBuffer(ramp.data(), ramp.size() * sizeof(float));
+		buffer.loopBegin = 200u;
+		buffer.loopLength = 300u;
+		buffer.loopCount = 2u;
+		mixer.Start(sourceId, buffer);
+
+		//PartlyLoopPlayWaveと同じく、最初から終わりまで、範囲を2回、残り
+		std::vector<float> expected;
+		for (uint32_t i = 0u; i < 500u; ++i) {
+			expected.push_back(ramp[i]);
+		}
+		for (uint32_t loop = 0u; loop < 2u; ++loop) {
+			for (uint32_t i = 200u; i < 500u; ++i) {
+				expected.push_back(ramp[i]);
+			}
+		}
+		for (uint32_t i = 500u; i < 1000u; ++i) {
+			expected.push_back(ramp[i]);
+		}
+		expected.resize(2000u, 0.0f);
+
+		//ブロックの途中で区切っても同じ
+		std::vector<float> output = Render(mixer, 2000u, 97u);
+		bool isSame = true;
+		for (uint32_t i = 0u; i < 2000u; ++i) {
+			if (output[i * 2u] != expected[i] || output[i * 2u + 1u] != expected[i]) {
+				isSame = false;
+			}
+		}
+		Check(isSame == true, "範囲を決めた回数だけループ", isValid);
+		Check(mixer.IsPlaying(sourceId) == false, "ループし終わったら止まる", isValid);
+
+		//ずっとループしてもExitLoopで抜ける
+		buffer.loopCount = Elysia::AudioMixer::LOOP_INFINITE_;
+		mixer.Start(sourceId, buffer);
+		Render(mixer, 100000u, FRAMES_PER_BLOCK);
+		bool isLooping = mixer.IsPlaying(sourceId);
+		mixer.ExitLoop(sourceId);
+		Render(mixer, 1000u, FRAMES_PER_BLOCK);
+		Check(isLooping == true && mixer.IsPlaying(sourceId) == false, "ずっとループしてもExitLoopで抜ける", isValid);
+
+		//ループの継ぎ目でも補間する(0.5ずつ読む)
+		mixer.SetFrequencyRatio(sourceId, 0.5f);
+		buffer.loopCount = 1u;
+		mixer.Start(sourceId, buffer);
+		output = Render(mixer, 1000u, FRAMES_PER_BLOCK);
+		//499.5フレーム目は499と200の間
+		float seam = output[999u * 2u];
+		Check(std::abs(seam - (ramp[499] + ramp[200]) * 0.5f) < 0.0001f, "ループの継ぎ目も補間する", isValid);
+	}
+
+	/// <summary>
+	/// パンと行列とバス
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckRouting(bool& isValid) {
+		Elysia::AudioMixer mixer;
+		mixer.Initialize({ .sampleRate = SAMPLE_RATE, .framesPerBlock = FRAMES_PER_BLOCK });
+		std::vector<float> constant(4800u, 0.5f);
+		uint32_t sourceId = mixer.CreateSource(MakeFloatMonoFormat(), Elysia::AudioMixer::MASTER_BUS_);
+
+		//Audio::SetPanと同じ
+		mixer.SetPan(sourceId, -1.0f);
+		mixer.Start(sourceId, MakeBuffer(constant.data(), constant.size() * sizeof(float)));
+		std::vector<float> output = Render(mixer, 16u, 16u);
+		bool isLeft = output[10] == 0.5f && output[11] == 0.0f;
+		mixer.SetPan(sourceId, 0.5f);
+		output = Render(mixer, 16u, 16u);
+		Check(isLeft == true && std::abs(output[10] - 0.125f) < 0.00001f && std::abs(output[11] - 0.375f) < 0.00001f, "パン", isValid);
+
+		//行列で左右を入れ替える
+		const float swap[4] = { 0.0f, 1.0f, 1.0f, 0.0f };
+		std::vector<float> stereo(4800u * 2u);
+		for (uint32_t i = 0u; i < 4800u; ++i) {
+			stereo[i * 2u] = 0.25f;
+			stereo[i * 2u + 1u] = -0.5f;
+		}
+		Elysia::AudioFormat stereoFormat = { .channelCount = 2u, .sampleRate = SAMPLE_RATE, .bitsPerSample = 32u, .isFloat = true };
+		uint32_t stereoId = mixer.CreateSource(stereoFormat, Elysia::AudioMixer::MASTER_BUS_);
+		mixer.Stop(sourceId);
+		mixer.SetOutputMatrix(stereoId, swap);
+		mixer.Start(stereoId, MakeBuffer(stereo.data(), stereo.size() * sizeof(float)));
+		output = Render(mixer, 16u, 16u);
+		Check(output[10] == -0.5f && output[11] == 0.25f, "出力の行列", isValid);
+
+		//バスを重ねると音量が掛かる
+		uint32_t groupBus = mixer.CreateBus(Elysia::AudioMixer::MASTER_BUS_);
+		uint32_t childBus = mixer.CreateBus(groupBus);
+		mixer.SetBusVolume(groupBus, 0.5f);
+		mixer.SetBusVolume(childBus, 0.5f);
+		mixer.Stop(stereoId);
+		uint32_t childId = mixer.CreateSource(MakeFloatMonoFormat(), childBus);
+		mixer.Start(childId, MakeBuffer(constant.data(), constant.size() * sizeof(float)));
+		output = Render(mixer, 16u, 16u);
+		Check(output[10] == 0.125f && output[11] == 0.125f, "バスの音量が重なる", isValid);
+
+		//マスターの音量
+		mixer.SetBusVolume(Elysia::AudioMixer::MASTER_BUS_, 2.0f);
+		output = Render(mixer, 16u, 16u);
+		Check(output[10] == 0.25f && mixer.GetStatistics().activeSourceCount == 1u, "マスターの音量", isValid);
+	}
+
+	/// <summary>
+	/// フィルター
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckFilter(bool& isValid) {
+		const uint32_t FRAME_COUNT = SAMPLE_RATE / 2u;
+		std::vector<int16_t> low = MakeSine(200.0f, SAMPLE_RATE, FRAME_COUNT);
+		std::vector<int16_t> high = MakeSine(8000.0f, SAMPLE_RATE, FRAME_COUNT);
+		//かけない時の大きさ
+		double reference = 16000.0 / 32768.0 / std::numbers::sqrt2;
+
+		Elysia::AudioMixer mixer;
+		mixer.Initialize({ .sampleRate = SAMPLE_RATE, .framesPerBlock = FRAMES_PER_BLOCK });
+		uint32_t sourceId = mixer.CreateSource(MakeMonoFormat(SAMPLE_RATE), Elysia::AudioMixer::MASTER_BUS_);
+		mixer.SetFilter(sourceId, { .type = Elysia::BiquadType::LowPass, .frequency = 500.0f, .q = 0.707f });
+		mixer.Start(sourceId, MakeBuffer(high.data(), high.size() * sizeof(int16_t)));
+		double highRms = CalculateRms(Render(mixer, FRAME_COUNT, FRAMES_PER_BLOCK), 0u, 1000u);
+		mixer.Start(sourceId, MakeBuffer(low.data(), low.size() * sizeof(int16_t)));
+		double lowRms = CalculateRms(Render(mixer, FRAME_COUNT, FRAMES_PER_BLOCK), 0u, 1000u);
+		std::printf("  500Hzのローパス 200Hz %.3f  8kHz %.4f (かけない時 %.3f)\n", lowRms, highRms, reference);
+		Check(lowRms > reference * 0.8 && highRms < reference * 0.01, "ローパスは高い音だけ削る", isValid);
+
+		//バスにかけたハイパスで低い音が削れる
+		uint32_t busId = mixer.CreateBus(Elysia::AudioMixer::MASTER_BUS_);
+		mixer.SetBusFilter(busId, { .type = Elysia::BiquadType::HighPass, .frequency = 2000.0f, .q = 0.707f });
+		uint32_t busSourceId = mixer.CreateSource(MakeMonoFormat(SAMPLE_RATE), busId);
+		mixer.Stop(sourceId);
+		mixer.Start(busSourceId, MakeBuffer(low.data(), low.size() * sizeof(int16_t)));
+		double busRms = CalculateRms(Render(mixer, FRAME_COUNT, FRAMES_PER_BLOCK), 0u, 1000u);
+		std::printf("  バスの2kHzのハイパス 200Hz %.4f\n", busRms);
+		Check(busRms < reference * 0.02, "バスのフィルター", isValid);
+	}
+
+	/// <summary>
+	/// 何回やっても同じになることとWAVファイルへの書き出し
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckOffline(bool& isValid) {
+		const uint32_t FRAME_COUNT = SAMPLE_RATE * 2u;
+		std::vector<std::vector<int16_t>> sines;
+		Elysia::AudioMixer mixer;
+		SetUpScene(mixer, sines);
+		std::vector<float> first = Render(mixer, FRAME_COUNT, FRAMES_PER_BLOCK);
+		SetUpScene(mixer, sines);
+		//頼む大きさが違っても同じ
+		std::vector<float> second = Render(mixer, FRAME_COUNT, 333u);
+		Check(std::memcmp(first.data(), second.data(), first.size() * sizeof(float)) == 0, "何回混ぜても同じ", isValid);
+
+		//ストリーミングと同じ仕組みでWAVファイルに書き出す
+		std::filesystem::path filePath = std::filesystem::temp_directory_path() / "AudioMixerBenchmark.wav";
+		SetUpScene(mixer, sines);
+		std::unique_ptr<Elysia::MixerDecoder> decoder = std::make_unique<Elysia::MixerDecoder>();
+		decoder->Initialize(&mixer, FRAME_COUNT);
+		Elysia::AudioStream stream;
+		Elysia::WaveFileStreamSink sink;
+		sink.Initialize(filePath.string(), mixer.GetOutputFormat(), &stream);
+		stream.Initialize(std::move(decoder), &sink, { .bufferCount = 3u, .framesPerBuffer = FRAMES_PER_BLOCK });
+		stream.Restart(0u);
+		stream.Pump();
+		sink.Finalize();
+		Check(stream.GetIsEnded() == true && sink.GetWrittenBytes() == uint64_t(FRAME_COUNT) * 8u, "Pump1回で最後まで書き出す", isValid);
+
+		std::ifstream file(filePath, std::ios::binary);
+		std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		file.close();
+		std::filesystem::remove(filePath);
+		bool isHeaderValid = bytes.size() == 44u + size_t(FRAME_COUNT) * 8u;
+		if (isHeaderValid == true) {
+			uint32_t riffSize = 0u;
+			uint16_t formatTag = 0u;
+			uint32_t dataSize = 0u;
+			std::memcpy(&riffSize, bytes.data() + 4u, sizeof(riffSize));
+			std::memcpy(&formatTag, bytes.data() + 20u, sizeof(formatTag));
+			std::memcpy(&dataSize, bytes.data() + 40u, sizeof(dataSize));
+			isHeaderValid = std::memcmp(bytes.data(), "RIFF", 4u) == 0 && std::memcmp(bytes.data() + 36u, "data", 4u) == 0 &&
+				riffSize == bytes.size() - 8u && formatTag == 3u && dataSize == FRAME_COUNT * 8u;
+		}
+		Check(isHeaderValid == true, "WAVファイルのヘッダー", isValid);
+		Check(isHeaderValid == true && std::memcmp(bytes.data() + 44u, first.data(), first.size() * sizeof(float)) == 0, "書き出したものも同じ", isValid);
+	}
+
+	/// <summary>
+	/// 混ぜる時間
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Measure(bool& isValid) {
+		const uint32_t SOURCE_COUNT = 64u;
+		const uint32_t BUFFER_COUNT = 1000u;
+		Elysia::AudioMixer mixer;
+		mixer.Initialize({ .sampleRate = SAMPLE_RATE, .framesPerBlock = FRAMES_PER_BLOCK });
+		uint32_t musicBus = mixer.CreateBus(Elysia::AudioMixer::MASTER_BUS_);
+		uint32_t effectBus = mixer.CreateBus(Elysia::AudioMixer::MASTER_BUS_);
+		mixer.SetBusFilter(musicBus, { .type = Elysia::BiquadType::LowPass, .frequency = 4000.0f, .q = 0.707f });
+
+		std::vector<int16_t> sine44 = MakeSine(330.0f, 44100u, 44100u);
+		std::vector<int16_t> sine48 = MakeSine(330.0f, SAMPLE_RATE, SAMPLE_RATE);
+		for (uint32_t i = 0u; i < SOURCE_COUNT; ++i) {
+			//半分は周波数が同じ、4分の1はピッチを変える、4分の1はフィルターをかける
+			bool isSameRate = i % 2u == 0u;
+			const std::vector<int16_t>& sine = (isSameRate == true) ? sine48 : sine44;
+			uint32_t sourceId = mixer.CreateSource(MakeMonoFormat(isSameRate == true ? SAMPLE_RATE : 44100u), (i % 2u == 0u) ? musicBus : effectBus);
+			Elysia::AudioMixer::SourceBuffer buffer = MakeBuffer(sine.data(), sine.size() * sizeof(int16_t));
+			buffer.loopCount = Elysia::AudioMixer::LOOP_INFINITE_;
+			mixer.SetVolume(sourceId, 1.0f / float(SOURCE_COUNT));
+			mixer.SetPan(sourceId, float(i % 9u) / 4.0f - 1.0f);
+			if (i % 4u == 1u) {
+				mixer.SetFrequencyRatio(sourceId, 1.5f);
+			}
+			if (i % 4u == 3u) {
+				mixer.SetFilter(sourceId, { .type = Elysia::BiquadType::BandPass, .frequency = 1000.0f, .q = 2.0f });
+			}
+			mixer.Start(sourceId, buffer);
+		}
+
+		std::vector<float> output(size_t(FRAMES_PER_BLOCK) * 2u);
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0u; i < BUFFER_COUNT; ++i) {
+			mixer.Render(output.data(), FRAMES_PER_BLOCK);
+		}
+		double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		double bufferMilliseconds = double(FRAMES_PER_BLOCK) * 1000.0 / double(SAMPLE_RATE);
+		double perBuffer = milliseconds / BUFFER_COUNT;
+		std::printf("  ソース %u 個  バッファ %u フレーム(%.2f ms分)\n", SOURCE_COUNT, FRAMES_PER_BLOCK, bufferMilliseconds);
+		std::printf("  1バッファ %.1f us (1ソース %.2f us)  再生時間の %.2f%%\n", perBuffer * 1000.0, perBuffer * 1000.0 / SOURCE_COUNT, perBuffer / bufferMilliseconds * 100.0);
+		Check(mixer.GetStatistics().renderedBlockCount == BUFFER_COUNT && mixer.GetStatistics().activeSourceCount == SOURCE_COUNT, "全部のソースを混ぜた", isValid);
+		Check(perBuffer < bufferMilliseconds, "再生より速く混ぜられる", isValid);
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("周波数\n");
+	CheckResample(isValid);
+	std::printf("ループ\n");
+	CheckLoop(isValid);
+	std::printf("パンとバス\n");
+	CheckRouting(isValid);
+	std::printf("フィルター\n");
+	CheckFilter(isValid);
+	std::printf("書き出し\n");
+	CheckOffline(isValid);
+	std::printf("ベンチマーク\n");
+	Measure(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
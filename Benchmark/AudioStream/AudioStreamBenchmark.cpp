@@ -0,0 +1,361 @@
+/**
+ * @file AudioStreamBenchmark.cpp
+ * @brief 少しずつ展開しながら再生する(AudioStream)の確認とベンチマーク
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+#include "AudioStream.h"
+#include "AudioStreamer.h"
+#include "NullAudioStreamSink.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 何フレーム目かを書き込むデコーダー
+	/// 16bitステレオの左右にフレーム番号の下位と上位を入れるので、再生した中身から順番が分かる
+	/// </summary>
+	class FrameIndexDecoder final : public Elysia::IAudioDecoder {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="frameCount">全体のフレーム数</param>
+		explicit FrameIndexDecoder(const uint64_t& frameCount) : frameCount_(frameCount) {
+		}
+
+		const Elysia::AudioFormat& GetFormat() const override {
+			return format_;
+		}
+
+		uint32_t Decode(uint8_t* destination, const uint32_t& frameCount) override {
+			uint32_t decodedFrameCount = uint32_t(std::min<uint64_t>(frameCount, frameCount_ - position_));
+			for (uint32_t i = 0u; i < decodedFrameCount; ++i) {
+				uint32_t frame = uint32_t(position_ + i);
+				std::memcpy(destination + size_t(i) * 4u, &frame, sizeof(frame));
+			}
+			position_ += decodedFrameCount;
+			return decodedFrameCount;
+		}
+
+		bool Seek(const uint64_t& frame) override {
+			if (frame > frameCount_) {
+				return false;
+			}
+			position_ = frame;
+			return true;
+		}
+
+	private:
+		Elysia::AudioFormat format_ = { .channelCount = 2u, .sampleRate = 44100u, .bitsPerSample = 16u };
+		uint64_t frameCount_ = 0u;
+		uint64_t position_ = 0u;
+	};
+
+	/// <summary>
+	/// 再生した中身をフレーム番号に戻す
+	/// </summary>
+	/// <param name="data">再生した中身</param>
+	/// <returns>フレーム番号</returns>
+	std::vector<uint32_t> ToFrames(const std::vector<uint8_t>& data) {
+		std::vector<uint32_t> frames(data.size() / 4u);
+		std::memcpy(frames.data(), data.data(), frames.size() * 4u);
+		return frames;
+	}
+
+	/// <summary>
+	/// 範囲を足す
+	/// </summary>
+	/// <param name="frames">足す先</param>
+	/// <param name="begin">始まり</param>
+	/// <param name="end">終わり(含まない)</param>
+	void AppendRange(std::vector<uint32_t>& frames, const uint32_t& begin, const uint32_t& end) {
+		for (uint32_t frame = begin; frame < end; ++frame) {
+			frames.push_back(frame);
+		}
+	}
+
+	/// <summary>
+	/// 展開する人と再生する人を交互に動かして最後まで再生する
+	/// </summary>
+	/// <param name="stream">ストリーム</param>
+	/// <param name="sink">送り先</param>
+	/// <param name="consumeBytes">1回で再生するバイト数</param>
+	void PlayToEnd(Elysia::AudioStream& stream, Elysia::NullAudioStreamSink& sink, const uint32_t& consumeBytes) {
+		while (true) {
+			stream.Pump();
+			if (sink.Consume(consumeBytes) == 0u && stream.GetIsEnded() == true) {
+				break;
+			}
+		}
+	}
+
+	/// <summary>
+	/// ループの始まりと終わり、回数
+	/// </summary>
+	struct LoopCase {
+		const char* name;
+		uint32_t frameCount;
+		uint32_t loopBegin;
+		uint32_t loopEnd;
+		uint32_t loopCount;
+		uint32_t framesPerBuffer;
+	};
+
+	/// <summary>
+	/// 再生した順番
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckSequence(bool& isValid) {
+		const LoopCase CASES[] = {
+			{ "ループ無し", 10000u, 0u, 0u, 0u, 1024u },
+			{ "全体を2回ループ", 10000u, 0u, 0u, 2u, 1024u },
+			{ "途中から最後までを3回ループ", 10000u, 3000u, 0u, 3u, 1024u },
+			{ "途中の範囲を2回ループして最後まで", 10000u, 2500u, 7001u, 2u, 1000u },
+			{ "バッファより短い範囲をループ", 10000u, 100u, 150u, 5u, 4096u },
+			{ "ちょうどバッファの境目で終わる", 8192u, 0u, 0u, 1u, 1024u },
+		};
+		for (const LoopCase& loopCase : CASES) {
+			Elysia::NullAudioStreamSink sink;
+			Elysia::AudioStream stream;
+			sink.Initialize(&stream, true);
+			stream.Initialize(std::make_unique<FrameIndexDecoder>(loopCase.frameCount), &sink, { .bufferCount = 3u, .framesPerBuffer = loopCase.framesPerBuffer });
+			stream.SetLoopRange(loopCase.loopBegin, loopCase.loopEnd);
+			stream.Restart(loopCase.loopCount);
+			PlayToEnd(stream, sink, 777u * 4u);
+
+			//最初から終わりまで、残りのループ分だけ始まりから終わりまで、最後に始まりから最後まで
+			std::vector<uint32_t> expected;
+			uint32_t loopEnd = (loopCase.loopEnd == 0u) ? loopCase.frameCount : loopCase.loopEnd;
+			if (loopCase.loopCount == 0u) {
+				AppendRange(expected, 0u, loopCase.frameCount);
+			}
+			else {
+				AppendRange(expected, 0u, loopEnd);
+				for (uint32_t i = 1u; i < loopCase.loopCount; ++i) {
+					AppendRange(expected, loopCase.loopBegin, loopEnd);
+				}
+				AppendRange(expected, loopCase.loopBegin, loopCase.frameCount);
+			}
+			bool isMatched = ToFrames(sink.GetCapturedData()) == expected;
+			Check(isMatched == true && sink.GetIsEndOfStreamReached() == true && stream.GetQueuedCount() == 0u, loopCase.name, isValid);
+		}
+	}
+
+	/// <summary>
+	/// ループを抜ける、再生し直す、止める
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckControl(bool& isValid) {
+		const uint32_t FRAME_COUNT = 20000u;
+		const uint32_t LOOP_BEGIN = 5000u;
+		const uint32_t LOOP_END = 15000u;
+		{
+			//ずっとループしているところで抜ける
+			Elysia::NullAudioStreamSink sink;
+			Elysia::AudioStream stream;
+			sink.Initialize(&stream, true);
+			stream.Initialize(std::make_unique<FrameIndexDecoder>(FRAME_COUNT), &sink, { .bufferCount = 4u, .framesPerBuffer = 512u });
+			stream.SetLoopRange(LOOP_BEGIN, LOOP_END);
+			stream.Restart(Elysia::AudioStream::LOOP_INFINITE_);
+			for (uint32_t i = 0u; i < 200u; ++i) {
+				stream.Pump();
+				sink.Consume(1000u * 4u);
+			}
+			bool isLooping = stream.GetIsEnded() == false;
+			stream.ExitLoop();
+			PlayToEnd(stream, sink, 1000u * 4u);
+
+			//続いているか、ループの終わりから始まりに戻っているかのどちらか
+			std::vector<uint32_t> frames = ToFrames(sink.GetCapturedData());
+			bool isContinuous = frames.front() == 0u && frames.back() == FRAME_COUNT - 1u;
+			uint32_t loopedCount = 0u;
+			for (size_t i = 1u; i < frames.size(); ++i) {
+				if (frames[i] == frames[i - 1u] + 1u) {
+					continue;
+				}
+				isContinuous = isContinuous && frames[i - 1u] == LOOP_END - 1u && frames[i] == LOOP_BEGIN;
+				++loopedCount;
+			}
+			Check(isLooping == true && isContinuous == true && loopedCount >= 10u, "ずっとループしているところから抜ける", isValid);
+		}
+		{
+			//再生している途中で最初から
+			Elysia::NullAudioStreamSink sink;
+			Elysia::AudioStream stream;
+			sink.Initialize(&stream, true);
+			stream.Initialize(std::make_unique<FrameIndexDecoder>(FRAME_COUNT), &sink, { .bufferCount = 4u, .framesPerBuffer = 512u });
+			stream.Restart(0u);
+			stream.Pump();
+			sink.Consume(3000u * 4u);
+			size_t restartedBytes = sink.GetCapturedData().size();
+			stream.Restart(0u);
+			bool isFlushed = stream.GetQueuedCount() == 0u;
+			PlayToEnd(stream, sink, 1000u * 4u);
+			std::vector<uint8_t> restartedData(sink.GetCapturedData().begin() + std::ptrdiff_t(restartedBytes), sink.GetCapturedData().end());
+			std::vector<uint32_t> expected;
+			AppendRange(expected, 0u, FRAME_COUNT);
+			Check(isFlushed == true && ToFrames(restartedData) == expected, "途中で最初から再生し直す", isValid);
+		}
+		{
+			//止めたら展開しない
+			Elysia::NullAudioStreamSink sink;
+			Elysia::AudioStream stream;
+			sink.Initialize(&stream, false);
+			stream.Initialize(std::make_unique<FrameIndexDecoder>(FRAME_COUNT), &sink, { .bufferCount = 4u, .framesPerBuffer = 512u });
+			stream.Restart(Elysia::AudioStream::LOOP_INFINITE_);
+			stream.Pump();
+			sink.Consume(1000u * 4u);
+			stream.Stop();
+			uint32_t submittedCount = stream.Pump();
+			Check(submittedCount == 0u && stream.GetQueuedCount() == 0u && sink.Consume(4u) == 0u, "止めたら展開しない", isValid);
+		}
+	}
+
+	/// <summary>
+	/// 裏のスレッドで展開しながら再生する
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckStreamer(bool& isValid) {
+		//1分のBGM(15秒目から最後までを1回ループ)
+		const uint32_t FRAME_COUNT = 44100u * 60u;
+		const uint32_t LOOP_BEGIN = 44100u * 15u;
+		const uint32_t FRAMES_PER_BUFFER = 11025u;
+		//再生する人は1回で0.1秒分ずつ進める(実際の時間よりずっと速く)
+		const uint32_t CONSUME_FRAME_COUNT = 4410u;
+
+		Elysia::NullAudioStreamSink sink;
+		Elysia::AudioStream stream;
+		Elysia::AudioStreamer streamer;
+		sink.Initialize(&stream, true);
+		stream.Initialize(std::make_unique<FrameIndexDecoder>(FRAME_COUNT), &sink, { .bufferCount = 4u, .framesPerBuffer = FRAMES_PER_BUFFER });
+		stream.SetLoopRange(LOOP_BEGIN, 0u);
+		stream.Restart(1u);
+		//始める前に埋めておく
+		stream.Pump();
+		streamer.Initialize(std::chrono::milliseconds(2));
+		streamer.Add(&stream);
+
+		auto start = std::chrono::steady_clock::now();
+		while (sink.GetIsEndOfStreamReached() == false || stream.GetIsEnded() == false) {
+			uint32_t consumedBytes = sink.Consume(CONSUME_FRAME_COUNT * 4u);
+			//XAudio2StreamSinkと同じく、再生したら起こす
+			streamer.Notify();
+			if (consumedBytes == 0u) {
+				std::this_thread::yield();
+			}
+			else {
+				std::this_thread::sleep_for(std::chrono::microseconds(200));
+			}
+		}
+		double elapsedMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		streamer.Remove(&stream);
+		streamer.Finalize();
+
+		std::vector<uint32_t> expected;
+		AppendRange(expected, 0u, FRAME_COUNT);
+		AppendRange(expected, LOOP_BEGIN, FRAME_COUNT);
+		uint64_t trackBytes = uint64_t(FRAME_COUNT) * 4u;
+		std::printf("  1分のBGM: 全部展開すると %.1f MB  ストリーミングは %.1f KB\n",
+			double(trackBytes) / (1024.0 * 1024.0), double(stream.GetBufferBytes()) / 1024.0);
+		std::printf("  再生 %.1f ms  展開したバッファ %llu 個  途切れた回数 %u\n",
+			elapsedMilliseconds, static_cast<unsigned long long>(streamer.GetPumpedCount()), sink.GetStarvedCount());
+		Check(ToFrames(sink.GetCapturedData()) == expected, "裏のスレッドで展開しても順番通り", isValid);
+		Check(stream.GetBufferBytes() * 50u < trackBytes, "メモリは全部展開するより少ない", isValid);
+	}
+
+	/// <summary>
+	/// MP3を全部展開する時の増やし方
+	/// 読み込んだサンプルごとにresizeしてmemcpyするのと、長さから先に確保して直接展開するのを比べる
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void MeasureFullDecode(bool& isValid) {
+		//MP3の1フレーム(1152サンプル)ずつ出てくる3分のステレオ
+		const uint32_t SAMPLE_FRAME_COUNT = 1152u;
+		const uint32_t FRAME_COUNT = 44100u * 180u;
+		const uint32_t BLOCK_ALIGN = 4u;
+		const uint32_t DECODE_FRAME_COUNT = 4096u;
+		const uint32_t REPEAT_COUNT = 5u;
+		std::vector<uint8_t> sample(size_t(SAMPLE_FRAME_COUNT) * BLOCK_ALIGN, 0x5Au);
+
+		double resizeMilliseconds = 0.0;
+		double reserveMilliseconds = 0.0;
+		uint32_t resizeReallocationCount = 0u;
+		uint32_t reserveReallocationCount = 0u;
+		size_t resizeCapacity = 0u;
+		size_t reserveCapacity = 0u;
+		bool isSame = true;
+		for (uint32_t repeat = 0u; repeat < REPEAT_COUNT; ++repeat) {
+			//今までのやり方
+			auto start = std::chrono::steady_clock::now();
+			std::vector<uint8_t> resizeData;
+			resizeReallocationCount = 0u;
+			for (uint32_t frame = 0u; frame < FRAME_COUNT; frame += SAMPLE_FRAME_COUNT) {
+				size_t length = size_t(std::min(SAMPLE_FRAME_COUNT, FRAME_COUNT - frame)) * BLOCK_ALIGN;
+				size_t capacity = resizeData.capacity();
+				resizeData.resize(resizeData.size() + length);
+				std::memcpy(resizeData.data() + resizeData.size() - length, sample.data(), length);
+				resizeReallocationCount += uint32_t(resizeData.capacity() != capacity);
+			}
+			resizeMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			resizeCapacity = resizeData.capacity();
+
+			//長さから先に確保して、デコーダーに直接書かせる
+			start = std::chrono::steady_clock::now();
+			FrameIndexDecoder decoder(FRAME_COUNT);
+			std::vector<uint8_t> reserveData;
+			reserveData.reserve(size_t(FRAME_COUNT + DECODE_FRAME_COUNT) * BLOCK_ALIGN);
+			size_t capacity = reserveData.capacity();
+			reserveReallocationCount = 0u;
+			size_t decodedBytes = 0u;
+			while (true) {
+				reserveData.resize(decodedBytes + size_t(DECODE_FRAME_COUNT) * BLOCK_ALIGN);
+				uint32_t decodedFrameCount = decoder.Decode(reserveData.data() + decodedBytes, DECODE_FRAME_COUNT);
+				decodedBytes += size_t(decodedFrameCount) * BLOCK_ALIGN;
+				if (decodedFrameCount < DECODE_FRAME_COUNT) {
+					break;
+				}
+			}
+			reserveData.resize(decodedBytes);
+			reserveReallocationCount = uint32_t(reserveData.capacity() != capacity);
+			reserveMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			reserveCapacity = reserveData.capacity();
+			isSame = isSame && resizeData.size() == reserveData.size();
+		}
+
+		std::printf("  resize+memcpy   %8.2f ms  確保し直し %2u 回  確保した量 %.1f MB\n",
+			resizeMilliseconds / REPEAT_COUNT, resizeReallocationCount, double(resizeCapacity) / (1024.0 * 1024.0));
+		std::printf("  先に確保        %8.2f ms  確保し直し %2u 回  確保した量 %.1f MB\n",
+			reserveMilliseconds / REPEAT_COUNT, reserveReallocationCount, double(reserveCapacity) / (1024.0 * 1024.0));
+		Check(isSame == true && reserveReallocationCount == 0u, "先に確保すると確保し直さない", isValid);
+		Check(reserveCapacity <= resizeCapacity, "確保する量も増えない", isValid);
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("再生する順番\n");
+	CheckSequence(isValid);
+	std::printf("操作\n");
+	CheckControl(isValid);
+	std::printf("裏のスレッドで展開\n");
+	CheckStreamer(isValid);
+	std::printf("全部展開する時の増やし方\n");
+	MeasureFullDecode(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file ConstantBufferBenchmark.cpp
+ * @brief フレームごとの定数バッファ(LinearRingAllocator)の確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <deque>
+
+#include "LinearRingAllocator.h"
+
+namespace {
+
+	//1フレーム分の大きさ(ConstantBufferManagerと同じ)
+	const size_t REGION_SIZE_ = 1024u * 1024u;
+	//フレームの数
+	const uint32_t REGION_COUNT_ = 2u;
+	//計測するフレーム数
+	const uint32_t FRAME_COUNT_ = 600u;
+
+	/// <summary>
+	/// PixelShaderに送るカメラと同じ大きさ
+	/// </summary>
+	struct CameraConstant {
+		float worldPosition[3];
+	};
+
+	/// <summary>
+	/// フェンスの代わり
+	/// SignalしてからlatencyフレームたつとGPUが終わったことにする
+	/// </summary>
+	class SimulatedFence {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="latency">遅れるフレーム数</param>
+		explicit SimulatedFence(const uint32_t& latency) :latency_(latency) {}
+
+		/// <summary>
+		/// Signal
+		/// </summary>
+		/// <returns>フェンスの値</returns>
+		uint64_t Signal() {
+			++fenceValue_;
+			pending_.push_back(fenceValue_);
+			return fenceValue_;
+		}
+
+		/// <summary>
+		/// 1フレーム進める
+		/// </summary>
+		void Tick() {
+			while (pending_.size() > latency_) {
+				completedValue_ = pending_.front();
+				pending_.pop_front();
+			}
+		}
+
+		/// <summary>
+		/// 全部終わるまで待つ
+		/// </summary>
+		void Flush() {
+			if (pending_.empty() == false) {
+				completedValue_ = pending_.back();
+				pending_.clear();
+			}
+		}
+
+		/// <summary>
+		/// GPUが終わった値
+		/// </summary>
+		/// <returns>値</returns>
+		uint64_t GetCompletedValue()const {
+			return completedValue_;
+		}
+
+	private:
+		uint32_t latency_ = 0u;
+		uint64_t fenceValue_ = 0u;
+		uint64_t completedValue_ = 0u;
+		std::deque<uint64_t> pending_;
+	};
+
+	/// <summary>
+	/// フェンスと領域の使い回しが正しいか確認する
+	/// </summary>
+	/// <param name="latency">GPUの遅れ</param>
+	/// <returns>正しいかどうか</returns>
+	bool Validate(const uint32_t& latency) {
+		Elysia::LinearRingAllocator allocator;
+		allocator.Initialize(REGION_SIZE_, REGION_COUNT_);
+		SimulatedFence fence(latency);
+
+		//領域ごとに最後に使ったフレームのフェンスの値
+		std::vector<uint64_t> regionFences(REGION_COUNT_, 0u);
+		uint32_t stallCount = 0u;
+
+		for (uint32_t frame = 0u; frame < FRAME_COUNT_; ++frame) {
+			fence.Tick();
+			//GPUが使っていたら待つ
+			if (allocator.BeginFrame(fence.GetCompletedValue()) == false) {
+				++stallCount;
+				fence.Flush();
+				if (allocator.BeginFrame(fence.GetCompletedValue()) == false) {
+					std::printf("  NG: フェンスを待っても始められない (frame %u)\n", frame);
+					return false;
+				}
+			}
+
+			//まだGPUが読んでいる領域を使っていないか
+			uint32_t region = allocator.GetCurrentRegion();
+			if (regionFences[region] > fence.GetCompletedValue()) {
+				std::printf("  NG: GPUが使用中の領域を再利用した (frame %u)\n", frame);
+				return false;
+			}
+
+			//毎フレーム数を変える
+			uint32_t count = 100u + (frame * 37u) % 400u;
+			for (uint32_t i = 0u; i < count; ++i) {
+				size_t offset = allocator.Allocate(sizeof(CameraConstant) + (i % 3u) * 100u);
+				//アライメントと範囲
+				if (offset == Elysia::LinearRingAllocator::INVALID_OFFSET_ ||
+					offset % Elysia::LinearRingAllocator::CONSTANT_BUFFER_ALIGNMENT_ != 0u ||
+					offset / REGION_SIZE_ != region) {
+					std::printf("  NG: 確保した位置が正しくない (frame %u)\n", frame);
+					return false;
+				}
+			}
+
+			uint64_t fenceValue = fence.Signal();
+			allocator.EndFrame(fenceValue);
+			regionFences[region] = fenceValue;
+
+			//統計
+			if (allocator.GetPreviousStatistics().allocationCount != count) {
+				std::printf("  NG: 確保数が合わない (frame %u)\n", frame);
+				return false;
+			}
+		}
+
+		//入りきらない時は失敗を返す
+		fence.Flush();
+		allocator.BeginFrame(fence.GetCompletedValue());
+		if (allocator.Allocate(REGION_SIZE_ + 1u) != Elysia::LinearRingAllocator::INVALID_OFFSET_ ||
+			allocator.GetCurrentStatistics().failedCount != 1u) {
+			std::printf("  NG: 大きすぎる確保が失敗しない\n");
+			return false;
+		}
+
+		std::printf("  遅れ %u フレーム : OK (待った回数 %u)\n", latency, stallCount);
+		return true;
+	}
+
+	/// <summary>
+	/// 描画ごとにバッファを持つ場合と比べる
+	/// </summary>
+	/// <param name="drawCount">1フレームの描画数</param>
+	void Measure(const uint32_t& drawCount) {
+		//今まで: モデルごとのバッファに毎回書き込む
+		std::vector<CameraConstant> perModelBuffers(drawCount);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t frame = 0u; frame < FRAME_COUNT_; ++frame) {
+			for (uint32_t i = 0u; i < drawCount; ++i) {
+				CameraConstant constant = { .worldPosition = { static_cast<float>(frame), 0.0f, static_cast<float>(i) } };
+				std::memcpy(&perModelBuffers[i], &constant, sizeof(CameraConstant));
+			}
+		}
+		std::chrono::duration<double, std::micro> perModelTime = std::chrono::steady_clock::now() - start;
+
+		//フレームごとの領域から確保する
+		std::vector<uint8_t> mappedData(REGION_SIZE_ * REGION_COUNT_);
+		Elysia::LinearRingAllocator allocator;
+		allocator.Initialize(REGION_SIZE_, REGION_COUNT_);
+		uint64_t fenceValue = 0u;
+		start = std::chrono::steady_clock::now();
+		for (uint32_t frame = 0u; frame < FRAME_COUNT_; ++frame) {
+			allocator.BeginFrame(fenceValue);
+			for (uint32_t i = 0u; i < drawCount; ++i) {
+				CameraConstant constant = { .worldPosition = { static_cast<float>(frame), 0.0f, static_cast<float>(i) } };
+				size_t offset = allocator.Allocate(sizeof(CameraConstant));
+				std::memcpy(mappedData.data() + offset, &constant, sizeof(CameraConstant));
+			}
+			allocator.EndFrame(++fenceValue);
+		}
+		std::chrono::duration<double, std::micro> ringTime = std::chrono::steady_clock::now() - start;
+
+		const Elysia::LinearRingAllocator::Statistics& statistics = allocator.GetPreviousStatistics();
+		std::printf("  描画数 %5u : モデルごと %8.2f us/frame, リング %8.2f us/frame, 確保数 %u, 使用量 %zu バイト(要求 %zu)\n",
+			drawCount,
+			perModelTime.count() / static_cast<double>(FRAME_COUNT_),
+			ringTime.count() / static_cast<double>(FRAME_COUNT_),
+			statistics.allocationCount, statistics.usedBytes, statistics.requestedBytes);
+	}
+
+}
+
+int main() {
+	std::printf("フェンスと領域の確認\n");
+	bool isValid = true;
+	for (uint32_t latency = 0u; latency <= 3u; ++latency) {
+		if (Validate(latency) == false) {
+			isValid = false;
+		}
+	}
+
+	//モデルごとのMap/Unmapはドライバの呼び出しがあるので実際の差はこれより大きい
+	std::printf("1フレームの書き込み\n");
+	Measure(64u);
+	Measure(512u);
+	Measure(4096u);
+
+	return (isValid == true) ? 0 : 1;
+}
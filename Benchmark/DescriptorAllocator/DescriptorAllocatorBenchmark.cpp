@@ -0,0 +1,167 @@
+/**
+ * @file DescriptorAllocatorBenchmark.cpp
+ * @brief ディスクリプタの番号の管理(DescriptorAllocator)の確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <chrono>
+
+#include "DescriptorAllocator.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//SrvManagerと同じ構成
+	const uint32_t MAX_SRV_COUNT_ = 2024u;
+	const uint32_t FIRST_INDEX_ = 1u;
+	const uint32_t TRANSIENT_SRV_COUNT_PER_FRAME_ = 128u;
+	const uint32_t FRAME_COUNT_ = 2u;
+	const uint32_t PERSISTENT_COUNT_ = MAX_SRV_COUNT_ - FIRST_INDEX_ - TRANSIENT_SRV_COUNT_PER_FRAME_ * FRAME_COUNT_;
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 世代とフェンスで待つことの確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckHandles(bool& isValid) {
+		Elysia::DescriptorAllocator allocator;
+		allocator.Initialize(FIRST_INDEX_, 4u, 2u, FRAME_COUNT_);
+
+		Elysia::DescriptorHandle first = allocator.Allocate();
+		Elysia::DescriptorHandle second = allocator.Allocate();
+		Check(first.index == FIRST_INDEX_ && second.index == FIRST_INDEX_ + 1u, "最初の番号から順に確保", isValid);
+		Check(allocator.IsValid(first) == true && allocator.IsValid({}) == false, "有効なハンドルと無効なハンドル", isValid);
+
+		//フェンス10で解放
+		allocator.Free(first, 10u);
+		Check(allocator.IsValid(first) == false, "解放したハンドルはすぐ無効", isValid);
+		Elysia::DescriptorHandle third = allocator.Allocate();
+		Check(third.index != first.index, "GPUが終わるまで使い回さない", isValid);
+		Check(allocator.Collect(9u) == 0u && allocator.Collect(10u) == 1u, "フェンスを越えたら使い回せる", isValid);
+		Elysia::DescriptorHandle reused = allocator.Allocate();
+		Check(reused.index == first.index && reused.generation != first.generation, "使い回した番号は世代が違う", isValid);
+		Check(allocator.IsValid(first) == false && allocator.IsValid(reused) == true, "古いハンドルは無効のまま", isValid);
+
+		Elysia::DescriptorAllocator::Statistics statistics = allocator.GetStatistics();
+		Check(statistics.persistentUsedCount == 3u && statistics.persistentHighWater == 3u && statistics.pendingFreeCount == 0u, "使っている数と最大", isValid);
+
+		//一時的な領域はフレームのコンテキストごとに分かれる
+		allocator.BeginFrame(0u);
+		uint32_t transient0 = allocator.AllocateTransient(2u);
+		allocator.BeginFrame(1u);
+		uint32_t transient1 = allocator.AllocateTransient(1u);
+		Check(transient0 == FIRST_INDEX_ + 4u && transient1 == FIRST_INDEX_ + 6u, "一時的な領域はコンテキストごと", isValid);
+		allocator.BeginFrame(0u);
+		Check(allocator.AllocateTransient(1u) == transient0, "同じコンテキストで頭から使い直す", isValid);
+		statistics = allocator.GetStatistics();
+		Check(statistics.transientUsedCount == 1u && statistics.transientHighWater == 2u, "一時的な数と最大", isValid);
+	}
+
+	/// <summary>
+	/// シーンの切り替えでパーティクルなどを作り直し続ける
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckSceneChanges(bool& isValid) {
+		Elysia::DescriptorAllocator allocator;
+		allocator.Initialize(FIRST_INDEX_, PERSISTENT_COUNT_, TRANSIENT_SRV_COUNT_PER_FRAME_, FRAME_COUNT_);
+
+		//テクスチャなど解放しないもの
+		for (uint32_t i = 0u; i < 200u; ++i) {
+			allocator.Allocate();
+		}
+
+		//1シーンで300個作って次のシーンで全部解放する
+		//今までの加算するだけの確保だと7シーン目で上限を越える
+		const uint32_t SCENE_COUNT = 100u;
+		const uint32_t SCENE_OBJECT_COUNT = 300u;
+		uint64_t fenceValue = 0u;
+		std::vector<Elysia::DescriptorHandle> handles;
+		std::vector<bool> isUsed(MAX_SRV_COUNT_, false);
+		bool isOverlapped = false;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t scene = 0u; scene < SCENE_COUNT; ++scene) {
+			for (const Elysia::DescriptorHandle& handle : handles) {
+				allocator.Free(handle, fenceValue + 1u);
+				isUsed[handle.index] = false;
+			}
+			handles.clear();
+
+			//2フレーム遅れてGPUが終わる
+			++fenceValue;
+			allocator.Collect(fenceValue - 1u);
+			++fenceValue;
+			allocator.Collect(fenceValue - 1u);
+
+			for (uint32_t i = 0u; i < SCENE_OBJECT_COUNT; ++i) {
+				Elysia::DescriptorHandle handle = allocator.Allocate();
+				//使っている番号を渡していないか
+				if (isUsed[handle.index] == true) {
+					isOverlapped = true;
+				}
+				isUsed[handle.index] = true;
+				handles.push_back(handle);
+			}
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		Elysia::DescriptorAllocator::Statistics statistics = allocator.GetStatistics();
+		std::printf("  %uシーン: 使用 %u / %u, 最大 %u, 解放待ち %u, %.3f us/シーン\n",
+			SCENE_COUNT, statistics.persistentUsedCount, statistics.persistentCapacity, statistics.persistentHighWater, statistics.pendingFreeCount,
+			std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(SCENE_COUNT));
+		Check(isOverlapped == false, "使っている番号を重ねて渡さない", isValid);
+		Check(statistics.persistentHighWater <= 200u + SCENE_OBJECT_COUNT * 2u, "シーンを切り替えても増え続けない", isValid);
+	}
+
+	/// <summary>
+	/// 確保と解放の速さ
+	/// </summary>
+	void Measure() {
+		Elysia::DescriptorAllocator allocator;
+		allocator.Initialize(FIRST_INDEX_, PERSISTENT_COUNT_, TRANSIENT_SRV_COUNT_PER_FRAME_, FRAME_COUNT_);
+
+		const uint32_t OPERATION_COUNT = 1000000u;
+		std::mt19937 randomEngine(1u);
+		std::vector<Elysia::DescriptorHandle> handles;
+		uint64_t fenceValue = 0u;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0u; i < OPERATION_COUNT; ++i) {
+			if (handles.size() < 1000u && (handles.empty() == true || randomEngine() % 2u == 0u)) {
+				handles.push_back(allocator.Allocate());
+			}
+			else {
+				size_t index = randomEngine() % handles.size();
+				allocator.Free(handles[index], fenceValue);
+				handles[index] = handles.back();
+				handles.pop_back();
+			}
+			//64回ごとに1フレーム進める
+			if (i % 64u == 63u) {
+				++fenceValue;
+				allocator.Collect(fenceValue - 1u);
+			}
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		std::printf("  確保と解放 %u回: %.2f ns/回\n", OPERATION_COUNT,
+			std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(OPERATION_COUNT));
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("ハンドル\n");
+	CheckHandles(isValid);
+	std::printf("シーンの切り替え\n");
+	CheckSceneChanges(isValid);
+	std::printf("計測\n");
+	Measure();
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file FrameSyncBenchmark.cpp
+ * @brief 複数フレーム同時処理(FrameSynchronizer, DeferredReleaseQueue)の確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <utility>
+
+#include "FrameSynchronizer.h"
+#include "DeferredReleaseQueue.h"
+
+namespace {
+
+	//計測するフレーム数
+	const uint32_t FRAME_COUNT_ = 600u;
+
+	/// <summary>
+	/// GPUの代わり
+	/// フェンスの値ごとに終わる時刻を持つ
+	/// </summary>
+	class SimulatedGPU {
+	public:
+		/// <summary>
+		/// コマンドを実行してSignalする
+		/// </summary>
+		/// <param name="submitTime">送った時刻</param>
+		/// <param name="gpuTime">GPUの処理時間</param>
+		/// <returns>フェンスの値</returns>
+		uint64_t ExecuteAndSignal(const double& submitTime, const double& gpuTime) {
+			//前のフレームが終わってから始める
+			double startTime = std::max<double>(submitTime, busyUntil_);
+			busyUntil_ = startTime + gpuTime;
+			completeTimes_.push_back(busyUntil_);
+			return static_cast<uint64_t>(completeTimes_.size());
+		}
+
+		/// <summary>
+		/// フェンスの値に届く時刻
+		/// </summary>
+		/// <param name="fenceValue">フェンスの値</param>
+		/// <returns>時刻</returns>
+		double GetCompleteTime(const uint64_t& fenceValue)const {
+			return (fenceValue == 0u) ? 0.0 : completeTimes_[fenceValue - 1u];
+		}
+
+		/// <summary>
+		/// その時刻までに終わったフェンスの値
+		/// </summary>
+		/// <param name="time">時刻</param>
+		/// <returns>フェンスの値</returns>
+		uint64_t GetCompletedValue(const double& time)const {
+			return static_cast<uint64_t>(std::upper_bound(completeTimes_.begin(), completeTimes_.end(), time) - completeTimes_.begin());
+		}
+
+	private:
+		double busyUntil_ = 0.0;
+		std::vector<double> completeTimes_;
+	};
+
+	/// <summary>
+	/// GPUが使っている間に解放されていないか確かめる為のもの
+	/// </summary>
+	struct TrackedResource {
+		//最後に使ったフレームのフェンスの値
+		uint64_t lastUsedFenceValue;
+		//解放された時に書き込む先
+		uint64_t* releasedBeforeComplete;
+		//今GPUが終わった値
+		const uint64_t* completedFenceValue;
+
+		~TrackedResource() {
+			if (lastUsedFenceValue > *completedFenceValue) {
+				++(*releasedBeforeComplete);
+			}
+		}
+	};
+
+	/// <summary>
+	/// DirectXSetup::EndDrawと同じ流れでフレームを回す
+	/// </summary>
+	/// <param name="frameCount">同時に処理するフレームの数</param>
+	/// <param name="cpuTime">CPUの1フレームの時間(ms)</param>
+	/// <param name="gpuTime">GPUの1フレームの時間(ms)</param>
+	/// <param name="isValid">解放が正しかったか</param>
+	/// <returns>1フレームあたりの時間(ms)</returns>
+	double Simulate(const uint32_t& frameCount, const double& cpuTime, const double& gpuTime, bool& isValid) {
+		Elysia::FrameSynchronizer frameSynchronizer;
+		frameSynchronizer.Initialize(frameCount);
+		Elysia::DeferredReleaseQueue<std::unique_ptr<TrackedResource>> deferredReleaseQueue;
+		SimulatedGPU gpu;
+
+		double time = 0.0;
+		uint64_t completedFenceValue = 0u;
+		uint64_t releasedBeforeComplete = 0u;
+		//コンテキストを同時に使っていないか
+		std::vector<uint64_t> contextInUse(frameCount, 0u);
+
+		for (uint32_t frame = 0u; frame < FRAME_COUNT_; ++frame) {
+			//コンテキストを前に使ったフレームをGPUが終えているか
+			uint32_t frameIndex = frameSynchronizer.GetFrameIndex();
+			completedFenceValue = gpu.GetCompletedValue(time);
+			if (frameSynchronizer.IsReady(completedFenceValue) == false ||
+				contextInUse[frameIndex] > completedFenceValue) {
+				isValid = false;
+			}
+
+			//CPUで記録する
+			time += cpuTime;
+
+			//毎フレーム1つずつ使い終わったものを解放に回す
+			//(シーンから外れたモデルのバッファなど)
+			uint64_t fenceValue = gpu.ExecuteAndSignal(time, gpuTime);
+			contextInUse[frameIndex] = fenceValue;
+			//一時オブジェクトのデストラクタで数えないように直接作る
+			std::unique_ptr<TrackedResource> resource(new TrackedResource{
+				.lastUsedFenceValue = fenceValue,
+				.releasedBeforeComplete = &releasedBeforeComplete,
+				.completedFenceValue = &completedFenceValue,
+			});
+			deferredReleaseQueue.Push(std::move(resource), fenceValue);
+
+			//次のコンテキストが空くまで待つ
+			frameSynchronizer.EndFrame(fenceValue);
+			time = std::max<double>(time, gpu.GetCompleteTime(frameSynchronizer.GetWaitFenceValue()));
+			completedFenceValue = gpu.GetCompletedValue(time);
+			deferredReleaseQueue.Collect(completedFenceValue);
+		}
+
+		//終了時は全部待つ
+		completedFenceValue = gpu.GetCompletedValue(gpu.GetCompleteTime(FRAME_COUNT_));
+		deferredReleaseQueue.Collect(completedFenceValue);
+		if (releasedBeforeComplete != 0u || deferredReleaseQueue.GetCount() != 0u ||
+			frameSynchronizer.GetFrameNumber() != FRAME_COUNT_) {
+			isValid = false;
+		}
+
+		return gpu.GetCompleteTime(FRAME_COUNT_) / static_cast<double>(FRAME_COUNT_);
+	}
+
+	/// <summary>
+	/// CPUとGPUの時間の組み合わせごとに比べる
+	/// </summary>
+	/// <param name="cpuTime">CPUの1フレームの時間(ms)</param>
+	/// <param name="gpuTime">GPUの1フレームの時間(ms)</param>
+	/// <returns>正しいかどうか</returns>
+	bool Measure(const double& cpuTime, const double& gpuTime) {
+		bool isValid = true;
+		std::printf("  CPU %5.2f ms, GPU %5.2f ms :", cpuTime, gpuTime);
+		for (uint32_t frameCount = 1u; frameCount <= 3u; ++frameCount) {
+			double frameTime = Simulate(frameCount, cpuTime, gpuTime, isValid);
+			std::printf(" %uフレーム %6.2f ms", frameCount, frameTime);
+		}
+		std::printf(" %s\n", (isValid == true) ? "OK" : "NG");
+		return isValid;
+	}
+
+}
+
+int main() {
+	//1フレームだとCPUとGPUが交互に待つので足し算になる
+	//2フレーム以上だと重なるので遅い方だけになる
+	std::printf("1フレームあたりの時間\n");
+	bool isValid = true;
+	const double TIMES[][2] = {
+		{ 8.0, 8.0 },
+		{ 4.0, 12.0 },
+		{ 12.0, 4.0 },
+		{ 10.0, 6.0 },
+	};
+	for (const auto& time : TIMES) {
+		if (Measure(time[0], time[1]) == false) {
+			isValid = false;
+		}
+	}
+
+	return (isValid == true) ? 0 : 1;
+}
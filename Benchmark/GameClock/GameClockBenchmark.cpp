@@ -0,0 +1,368 @@
+/**
+ * @file GameClockBenchmark.cpp
+ * @brief ゲームの時間(GameClock)の確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include "GameClock.h"
+#include "InterpolatedMatrix.h"
+#include "Matrix4x4Calculation.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確かめる時間(秒)
+	const double SIMULATION_SECOND_ = 10.0;
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 固定の間隔で進めるゲームの代わり
+	/// 跳ねるボールを進める
+	/// </summary>
+	struct BallSimulation {
+		float position = 10.0f;
+		float velocity = 0.0f;
+		uint64_t stepCount = 0u;
+
+		/// <summary>
+		/// 1回進める
+		/// </summary>
+		/// <param name="deltaTime">間隔</param>
+		void Step(const float& deltaTime) {
+			velocity -= 9.8f * deltaTime;
+			position += velocity * deltaTime;
+			if (position < 0.0f) {
+				position = -position;
+				velocity = -velocity * 0.8f;
+			}
+			++stepCount;
+		}
+
+		/// <summary>
+		/// 同じ状態かどうか
+		/// </summary>
+		/// <param name="other">もう1つ</param>
+		/// <returns>ビットまで同じかどうか</returns>
+		bool IsSame(const BallSimulation& other) const {
+			return std::memcmp(&position, &other.position, sizeof(float)) == 0 &&
+				std::memcmp(&velocity, &other.velocity, sizeof(float)) == 0 &&
+				stepCount == other.stepCount;
+		}
+	};
+
+	/// <summary>
+	/// 走らせた結果
+	/// </summary>
+	struct RunResult {
+		//進めた回数の合計
+		uint64_t stepTotalCount;
+		//1フレームで進めた最小と最大の回数
+		uint32_t minStepCount;
+		uint32_t maxStepCount;
+		//補間の割合が0～1に収まっていたか
+		bool isAlphaInRange;
+	};
+
+	/// <summary>
+	/// フレームの時間を渡して走らせる
+	/// 決まった回数だけ進めた時のボールも残す
+	/// </summary>
+	/// <param name="frameTimes">フレームの時間</param>
+	/// <param name="stopStepCount">ボールを止める回数</param>
+	/// <param name="ball">ボール</param>
+	/// <returns>結果</returns>
+	RunResult Run(const std::vector<double>& frameTimes, const uint64_t& stopStepCount, BallSimulation& ball) {
+		Elysia::GameClock* gameClock = Elysia::GameClock::GetInstance();
+		gameClock->Initialize(Elysia::GameClock::DEFAULT_SETTINGS_);
+		RunResult result = { .stepTotalCount = 0u, .minStepCount = UINT32_MAX, .maxStepCount = 0u, .isAlphaInRange = true };
+		for (const double& frameTime : frameTimes) {
+			gameClock->Advance(frameTime);
+			uint32_t stepCount = gameClock->GetFixedStepCount();
+			for (uint32_t i = 0u; i < stepCount; ++i) {
+				if (ball.stepCount < stopStepCount) {
+					ball.Step(gameClock->GetFixedDeltaTime());
+				}
+			}
+			result.minStepCount = std::min(result.minStepCount, stepCount);
+			result.maxStepCount = std::max(result.maxStepCount, stepCount);
+			float alpha = gameClock->GetInterpolationAlpha();
+			if (alpha < 0.0f || alpha > 1.0f) {
+				result.isAlphaInRange = false;
+			}
+		}
+		result.stepTotalCount = gameClock->GetFixedStepTotalCount();
+		return result;
+	}
+
+	/// <summary>
+	/// 一定のフレームレートのフレームの時間を作る
+	/// </summary>
+	/// <param name="frameRate">フレームレート</param>
+	/// <returns>フレームの時間</returns>
+	std::vector<double> MakeConstantFrameTimes(const double& frameRate) {
+		size_t frameCount = size_t(SIMULATION_SECOND_ * frameRate + 0.5);
+		return std::vector<double>(frameCount, 1.0 / frameRate);
+	}
+
+	/// <summary>
+	/// 色々なフレームレートで同じように進むか
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckFrameRates(bool& isValid) {
+		//10秒で600回
+		const uint64_t EXPECTED_STEP_COUNT = uint64_t(SIMULATION_SECOND_ * 60.0);
+		//比べるボールは全部同じ回数で止める
+		const uint64_t STOP_STEP_COUNT = EXPECTED_STEP_COUNT - 1u;
+
+		BallSimulation referenceBall = {};
+		for (uint64_t i = 0u; i < STOP_STEP_COUNT; ++i) {
+			referenceBall.Step(Elysia::GameClock::DEFAULT_SETTINGS_.fixedDeltaTime);
+		}
+
+		const double FRAME_RATES[] = { 30.0, 60.0, 75.0, 120.0, 144.0, 240.0 };
+		for (const double& frameRate : FRAME_RATES) {
+			BallSimulation ball = {};
+			RunResult result = Run(MakeConstantFrameTimes(frameRate), STOP_STEP_COUNT, ball);
+			std::printf("  %6.1fHz 合計%4llu回 1フレーム%u～%u回\n", frameRate,
+				static_cast<unsigned long long>(result.stepTotalCount), result.minStepCount, result.maxStepCount);
+
+			char name[64] = {};
+			std::snprintf(name, sizeof(name), "%.0fHz 10秒で600回(±1)進む", frameRate);
+			Check(result.stepTotalCount + 1u >= EXPECTED_STEP_COUNT && result.stepTotalCount <= EXPECTED_STEP_COUNT + 1u, name, isValid);
+			std::snprintf(name, sizeof(name), "%.0fHz 固定の間隔で進めた結果が同じ", frameRate);
+			Check(ball.IsSame(referenceBall) == true, name, isValid);
+			std::snprintf(name, sizeof(name), "%.0fHz 補間の割合が0～1", frameRate);
+			Check(result.isAlphaInRange == true, name, isValid);
+
+			//60Hzなら毎フレーム1回、30Hzなら毎フレーム2回
+			if (frameRate == 60.0) {
+				Check(result.minStepCount == 1u && result.maxStepCount == 1u, "60Hz 毎フレーム1回", isValid);
+			}
+			if (frameRate == 30.0) {
+				Check(result.minStepCount == 2u && result.maxStepCount == 2u, "30Hz 毎フレーム2回", isValid);
+			}
+			if (frameRate > 60.0) {
+				Check(result.maxStepCount == 1u, "60Hzより速い画面では多くても1回", isValid);
+			}
+		}
+
+		//測る時刻が揺れる(VSyncの間隔そのものは揺れないので、ずれは溜まらない)
+		std::mt19937 randomEngine(7u);
+		std::uniform_real_distribution<double> jitter(-0.0003, 0.0003);
+		std::vector<double> jitteredFrameTimes(MakeConstantFrameTimes(60.0));
+		double previousJitter = 0.0;
+		for (double& frameTime : jitteredFrameTimes) {
+			double currentJitter = jitter(randomEngine);
+			frameTime += currentJitter - previousJitter;
+			previousJitter = currentJitter;
+		}
+		BallSimulation jitteredBall = {};
+		RunResult jitteredResult = Run(jitteredFrameTimes, STOP_STEP_COUNT, jitteredBall);
+		Check(jitteredResult.minStepCount == 1u && jitteredResult.maxStepCount == 1u, "60Hz ±0.3ms揺れても毎フレーム1回", isValid);
+		Check(jitteredBall.IsSame(referenceBall) == true, "60Hz ±0.3ms揺れても結果が同じ", isValid);
+
+		//ばらばらのフレームの時間
+		std::uniform_real_distribution<double> randomFrameTime(0.004, 0.040);
+		std::vector<double> randomFrameTimes;
+		double totalTime = 0.0;
+		while (totalTime < SIMULATION_SECOND_) {
+			randomFrameTimes.push_back(randomFrameTime(randomEngine));
+			totalTime += randomFrameTimes.back();
+		}
+		BallSimulation randomBall = {};
+		Run(randomFrameTimes, STOP_STEP_COUNT, randomBall);
+		Check(randomBall.IsSame(referenceBall) == true, "4～40msばらばらでも結果が同じ", isValid);
+	}
+
+	/// <summary>
+	/// 重いフレーム、一時停止、速さ
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckControl(bool& isValid) {
+		Elysia::GameClock* gameClock = Elysia::GameClock::GetInstance();
+		const Elysia::GameClock::Settings& settings = Elysia::GameClock::DEFAULT_SETTINGS_;
+
+		//1秒止まった後
+		gameClock->Initialize(settings);
+		gameClock->Advance(1.0);
+		Check(gameClock->GetFixedStepCount() == settings.maxFixedStepCount, "1秒止まっても最大の回数まで", isValid);
+		Check(gameClock->GetDroppedStepCount() == 60u - settings.maxFixedStepCount, "追いつけない分は捨てる", isValid);
+		gameClock->Advance(1.0 / 60.0);
+		Check(gameClock->GetFixedStepCount() == 1u, "次のフレームからは普通に戻る", isValid);
+
+		//少し重いフレームは追いつく
+		gameClock->Initialize(settings);
+		gameClock->Advance(0.050);
+		Check(gameClock->GetFixedStepCount() == 3u && gameClock->GetDroppedStepCount() == 0u, "50msのフレームは3回進めて追いつく", isValid);
+
+		//一時停止
+		gameClock->Initialize(settings);
+		gameClock->SetIsPause(true);
+		for (uint32_t i = 0u; i < 60u; ++i) {
+			gameClock->Advance(1.0 / 60.0);
+		}
+		Check(gameClock->GetFixedStepTotalCount() == 0u, "止めている間は進めない", isValid);
+		Check(gameClock->GetDeltaTime() == 0.0f && gameClock->GetUnscaledDeltaTime() > 0.0f, "止めていても実際の時間は測る", isValid);
+		gameClock->SetIsPause(false);
+		gameClock->Advance(1.0 / 60.0);
+		Check(gameClock->GetFixedStepCount() == 1u, "再開したら止めていた分は進めない", isValid);
+
+		//半分の速さ
+		gameClock->Initialize(settings);
+		gameClock->SetTimeScale(0.5f);
+		for (uint32_t i = 0u; i < 600u; ++i) {
+			gameClock->Advance(1.0 / 60.0);
+		}
+		uint64_t halfStepCount = gameClock->GetFixedStepTotalCount();
+		Check(halfStepCount >= 299u && halfStepCount <= 301u, "半分の速さなら10秒で300回", isValid);
+		gameClock->SetTimeScale(1.0f);
+	}
+
+	/// <summary>
+	/// 行列がほぼ同じかどうか
+	/// </summary>
+	/// <param name="m1">行列1</param>
+	/// <param name="m2">行列2</param>
+	/// <returns>ほぼ同じかどうか</returns>
+	bool IsNearlyEqual(const Matrix4x4& m1, const Matrix4x4& m2) {
+		for (uint32_t row = 0u; row < 4u; ++row) {
+			for (uint32_t column = 0u; column < 4u; ++column) {
+				if (std::abs(m1.m[row][column] - m2.m[row][column]) > 0.0001f) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 描画の補間
+	/// WorldTransformとCameraは固定の間隔で進める度にInterpolatedMatrixへ行列を渡し、描画で補間の割合で混ぜる
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckInterpolation(bool& isValid) {
+		//分けて組み直すと元に戻るか
+		//回転の大きいものと反転したものも入れる
+		const Vector3 ROTATES[] = { {0.0f,0.0f,0.0f},{0.3f,-1.2f,2.0f},{3.1f,0.0f,0.0f},{0.0f,3.0f,0.0f},{0.0f,0.0f,-3.1f},{1.5f,1.5f,1.5f} };
+		bool isRoundTrip = true;
+		for (const Vector3& rotate : ROTATES) {
+			for (const float& scaleX : { 2.0f, -1.0f }) {
+				Matrix4x4 matrix = Matrix4x4Calculation::MakeAffineMatrix({ .x = scaleX,.y = 0.5f,.z = 3.0f }, rotate, { .x = 1.0f,.y = -2.0f,.z = 3.0f });
+				QuaternionTransform transform = Elysia::InterpolatedMatrix::Decompose(matrix);
+				if (IsNearlyEqual(Matrix4x4Calculation::MakeQuaternionAffineMatrix(transform.scale, transform.rotate, transform.translate), matrix) == false) {
+					isRoundTrip = false;
+				}
+			}
+		}
+		Check(isRoundTrip, "分けて組み直すと元の行列に戻る", isValid);
+
+		//目標のフレームレートは0(待たない)や60より速くても良い
+		Elysia::GameClock* gameClock = Elysia::GameClock::GetInstance();
+		Elysia::GameClock::Settings settings = Elysia::GameClock::DEFAULT_SETTINGS_;
+		settings.targetFrameRate = 0.0f;
+		gameClock->Initialize(settings);
+		gameClock->SetTargetFrameRate(144.0f);
+		Check(gameClock->GetTargetFrameRate() == 144.0f, "目標を0や144にできる", isValid);
+
+		//144Hzで1回に1ずつ進みながら回るもの
+		const double FRAME_RATE = 144.0;
+		const float SPEED = 1.0f;
+		const float ROTATE_SPEED = 0.05f;
+		float position = 0.0f;
+		float angle = 0.0f;
+		Elysia::InterpolatedMatrix interpolatedMatrix;
+		interpolatedMatrix.Reset(Matrix4x4Calculation::MakeAffineMatrix({ 1.0f,1.0f,1.0f }, { 0.0f,angle,0.0f }, { position,0.0f,0.0f }));
+
+		std::vector<float> drawnPositions;
+		std::vector<float> steppedPositions;
+		bool isScaleKept = true;
+		for (const double& frameTime : MakeConstantFrameTimes(FRAME_RATE)) {
+			gameClock->Advance(frameTime);
+			uint64_t stepTotalCount = gameClock->GetFixedStepTotalCount();
+			for (uint32_t i = 0u; i < gameClock->GetFixedStepCount(); ++i) {
+				position += SPEED;
+				angle += ROTATE_SPEED;
+				interpolatedMatrix.Step(Matrix4x4Calculation::MakeAffineMatrix({ 1.0f,1.0f,1.0f }, { 0.0f,angle,0.0f }, { position,0.0f,0.0f }), stepTotalCount);
+			}
+			Matrix4x4 drawnMatrix = interpolatedMatrix.Get(gameClock->GetInterpolationAlpha(), stepTotalCount);
+			drawnPositions.push_back(drawnMatrix.m[3][0]);
+			steppedPositions.push_back(interpolatedMatrix.GetCurrent().m[3][0]);
+
+			//回転の途中でも縮まない
+			float scaleX = std::sqrt(drawnMatrix.m[0][0] * drawnMatrix.m[0][0] + drawnMatrix.m[0][1] * drawnMatrix.m[0][1] + drawnMatrix.m[0][2] * drawnMatrix.m[0][2]);
+			if (std::abs(scaleX - 1.0f) > 0.001f) {
+				isScaleKept = false;
+			}
+		}
+
+		//1フレームで進む量が一定かどうか
+		//補間しないと進まないフレームと1回分進むフレームが混ざる
+		//最初に進めるまでは前の状態が無いので、1回進めた後から比べる
+		const float EXPECTED_DELTA = SPEED * float(60.0 / FRAME_RATE);
+		float maxError = 0.0f;
+		float maxSteppedError = 0.0f;
+		for (size_t i = 1u; i < drawnPositions.size(); ++i) {
+			if (steppedPositions[i - 1u] < SPEED) {
+				continue;
+			}
+			maxError = std::max(maxError, std::abs(drawnPositions[i] - drawnPositions[i - 1u] - EXPECTED_DELTA));
+			maxSteppedError = std::max(maxSteppedError, std::abs(steppedPositions[i] - steppedPositions[i - 1u] - EXPECTED_DELTA));
+		}
+		std::printf("  144Hz 1フレームの移動量のずれ 補間あり%.3f 補間なし%.3f (1回の移動量%.1f)\n", maxError, maxSteppedError, SPEED);
+		Check(maxError < SPEED * 0.1f, "144Hz 補間した位置が滑らかに進む", isValid);
+		Check(maxSteppedError > SPEED * 0.5f, "144Hz 補間しないと止まるフレームがある", isValid);
+		Check(isScaleKept, "144Hz 回転を補間しても縮まない", isValid);
+
+		//止まったら補間しない
+		interpolatedMatrix.Step(interpolatedMatrix.GetCurrent(), gameClock->GetFixedStepTotalCount());
+		Check(interpolatedMatrix.IsInterpolating(gameClock->GetFixedStepTotalCount()) == false, "止まったら補間しない", isValid);
+		//更新されずにGameClockだけ進んだら今の行列を使う
+		interpolatedMatrix.Step(Matrix4x4Calculation::MakeTranslateMatrix({ 1.0f,2.0f,3.0f }), gameClock->GetFixedStepTotalCount());
+		gameClock->Advance(1.0 / 60.0);
+		Check(interpolatedMatrix.IsInterpolating(gameClock->GetFixedStepTotalCount()) == false, "更新されなかったものは補間しない", isValid);
+	}
+
+	/// <summary>
+	/// 1フレーム進めるのに掛かる時間
+	/// </summary>
+	void Measure() {
+		Elysia::GameClock* gameClock = Elysia::GameClock::GetInstance();
+		gameClock->Initialize(Elysia::GameClock::DEFAULT_SETTINGS_);
+		const uint32_t COUNT = 1000000u;
+		uint64_t stepTotalCount = 0u;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0u; i < COUNT; ++i) {
+			gameClock->Advance(1.0 / 144.0);
+			stepTotalCount += gameClock->GetFixedStepCount();
+		}
+		double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		std::printf("  Advance %.1fns/回 (%llu回進めた)\n", nanoseconds / COUNT, static_cast<unsigned long long>(stepTotalCount));
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("フレームレート\n");
+	CheckFrameRates(isValid);
+	std::printf("重いフレーム、一時停止、速さ\n");
+	CheckControl(isValid);
+	std::printf("描画の補間\n");
+	CheckInterpolation(isValid);
+	std::printf("計測\n");
+	Measure();
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,415 @@
+/**
+ * @file LevelDataParseBenchmark.cpp
+ * @brief レベルデータ読み込み(DOM,SAX,バイナリ)の比較
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <filesystem>
+
+#include "LevelDataParser.h"
+#include "LevelDataBinary.h"
+#include "LevelObjectIndex.h"
+#include "LevelObjectDiff.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+#pragma region メモリの計測
+
+namespace {
+	//確保中のバイト数
+	size_t currentBytes = 0u;
+	//最大のバイト数
+	size_t peakBytes = 0u;
+	//確保した回数
+	size_t allocationCount = 0u;
+
+	//サイズを記録する領域
+	//アライメントを崩さないように16バイト取る
+	const size_t HEADER_SIZE_ = 16u;
+}
+
+void* operator new(size_t size) {
+	void* memory = std::malloc(size + HEADER_SIZE_);
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	*static_cast<size_t*>(memory) = size;
+	currentBytes += size;
+	peakBytes = std::max(peakBytes, currentBytes);
+	++allocationCount;
+	return static_cast<char*>(memory) + HEADER_SIZE_;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+	if (memory == nullptr) {
+		return;
+	}
+	char* head = static_cast<char*>(memory) - HEADER_SIZE_;
+	currentBytes -= *reinterpret_cast<size_t*>(head);
+	std::free(head);
+}
+
+void operator delete[](void* memory) noexcept {
+	operator delete(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+	operator delete(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+	operator delete(memory);
+}
+
+#pragma endregion
+
+namespace {
+
+	/// <summary>
+	/// 計測結果
+	/// </summary>
+	struct Result {
+		//1回あたりの時間(中央値)
+		double microseconds;
+		//読み込み中の最大メモリ(計測開始時点からの増分)
+		size_t peakBytes;
+		//確保の回数
+		size_t allocationCount;
+		//オブジェクト数
+		size_t objectCount;
+	};
+
+	/// <summary>
+	/// 読み込み関数
+	/// </summary>
+	using ParseFunction = bool(*)(const std::string&, std::vector<Elysia::LevelObjectData>&, Elysia::StringInterner&);
+
+	/// <summary>
+	/// 計測
+	/// </summary>
+	/// <param name="parse">読み込み関数</param>
+	/// <param name="fullFilePath">フルパス</param>
+	/// <param name="iterationCount">回数</param>
+	/// <returns>結果</returns>
+	Result Measure(const ParseFunction& parse, const std::string& fullFilePath, const uint32_t& iterationCount) {
+		Result result = {};
+
+		//メモリの計測は1回目だけ
+		{
+			Elysia::StringInterner stringInterner;
+			std::vector<Elysia::LevelObjectData> objectDatas;
+			size_t baseBytes = currentBytes;
+			peakBytes = currentBytes;
+			size_t baseCount = allocationCount;
+			parse(fullFilePath, objectDatas, stringInterner);
+			result.peakBytes = peakBytes - baseBytes;
+			result.allocationCount = allocationCount - baseCount;
+			result.objectCount = objectDatas.size();
+		}
+
+		//時間の計測
+		std::vector<double> times;
+		times.reserve(iterationCount);
+		for (uint32_t i = 0u; i < iterationCount; ++i) {
+			Elysia::StringInterner stringInterner;
+			std::vector<Elysia::LevelObjectData> objectDatas;
+			auto start = std::chrono::steady_clock::now();
+			parse(fullFilePath, objectDatas, stringInterner);
+			auto end = std::chrono::steady_clock::now();
+			times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+		}
+		std::sort(times.begin(), times.end());
+		result.microseconds = times[times.size() / 2u];
+
+		return result;
+	}
+
+	//クックしたファイルの場所
+	std::string cookedFilePath;
+
+	/// <summary>
+	/// クックしたファイルから読み込む
+	/// </summary>
+	/// <param name="objectDatas">オブジェクトデータ</param>
+	/// <param name="stringInterner">タイプ名の登録先</param>
+	/// <returns>読み込めたかどうか</returns>
+	bool ReadCookedFile(const std::string&, std::vector<Elysia::LevelObjectData>& objectDatas, Elysia::StringInterner& stringInterner) {
+		return LevelDataBinary::Read(cookedFilePath, objectDatas, stringInterner);
+	}
+
+	/// <summary>
+	/// 2つの読み込み結果が同じかどうか
+	/// </summary>
+	/// <param name="parse">比較する読み込み関数</param>
+	/// <param name="fullFilePath">フルパス</param>
+	/// <returns>同じかどうか</returns>
+	bool IsSameResult(const ParseFunction& parse, const std::string& fullFilePath) {
+		Elysia::StringInterner stringInterner;
+		std::vector<Elysia::LevelObjectData> domDatas;
+		std::vector<Elysia::LevelObjectData> saxDatas;
+		LevelDataParser::ParseWithDom(fullFilePath, domDatas, stringInterner);
+		parse(fullFilePath, saxDatas, stringInterner);
+
+		if (domDatas.size() != saxDatas.size()) {
+			return false;
+		}
+
+		auto isSameVector = [](const Vector3& v1, const Vector3& v2) {
+			return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z;
+		};
+		for (size_t i = 0u; i < domDatas.size(); ++i) {
+			const Elysia::LevelObjectData& dom = domDatas[i];
+			const Elysia::LevelObjectData& sax = saxDatas[i];
+			if (dom.name != sax.name || dom.type != sax.type || dom.modelFileName != sax.modelFileName ||
+				dom.colliderType != sax.colliderType || dom.isInvisible != sax.isInvisible ||
+				dom.isHavingCollider != sax.isHavingCollider ||
+				dom.levelAudioData.fileName != sax.levelAudioData.fileName ||
+				dom.levelAudioData.isLoop != sax.levelAudioData.isLoop ||
+				dom.levelAudioData.isOnArea != sax.levelAudioData.isOnArea ||
+				!isSameVector(dom.transform.scale, sax.transform.scale) ||
+				!isSameVector(dom.transform.rotate, sax.transform.rotate) ||
+				!isSameVector(dom.transform.translate, sax.transform.translate) ||
+				!isSameVector(dom.center, sax.center) ||
+				!isSameVector(dom.size, sax.size)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 再読み込みしても索引から同じ名前のオブジェクトを引けるかどうか
+	/// </summary>
+	/// <param name="fullFilePath">フルパス</param>
+	/// <returns>引けるかどうか</returns>
+	bool IsIndexKeptAfterReload(const std::string& fullFilePath) {
+		Elysia::StringInterner stringInterner;
+		std::vector<Elysia::LevelObjectData> objectDatas;
+		LevelDataParser::ParseWithSax(fullFilePath, objectDatas, stringInterner);
+		Elysia::LevelObjectIndex objectIndex;
+		objectIndex.Build(objectDatas, stringInterner);
+
+		//先に枠を取得しておく
+		std::vector<uint32_t> slots;
+		slots.reserve(objectDatas.size());
+		for (const Elysia::LevelObjectData& objectData : objectDatas) {
+			slots.push_back(objectIndex.GetSlot(objectData.name, stringInterner));
+		}
+
+		//再読み込み
+		//索引が前のデータの名前を指していたら分かるように、名前を書き換えてから捨てる
+		std::vector<Elysia::LevelObjectData> reloadedDatas;
+		LevelDataParser::ParseWithSax(fullFilePath, reloadedDatas, stringInterner);
+		for (Elysia::LevelObjectData& objectData : objectDatas) {
+			objectData.name.assign(objectData.name.size(), '?');
+		}
+		objectDatas = std::move(reloadedDatas);
+		objectIndex.Build(objectDatas, stringInterner);
+
+		size_t typeIndexCount = 0u;
+		for (size_t i = 0u; i < objectDatas.size(); ++i) {
+			const std::string& name = objectDatas[i].name;
+			//枠は変わらない
+			if (objectIndex.GetSlot(name, stringInterner) != slots[i]) {
+				return false;
+			}
+			//枠から同じ名前のオブジェクトを引ける
+			uint32_t index = objectIndex.GetIndex(slots[i]);
+			if (index == Elysia::LevelObjectHandle::INVALID_ || objectDatas[index].name != name) {
+				return false;
+			}
+			typeIndexCount += (objectIndex.GetTypeIndices(objectDatas[i].type).empty() == false) ? 1u : 0u;
+		}
+		return typeIndexCount == objectDatas.size();
+	}
+
+	/// <summary>
+	/// オブジェクトデータを作る
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <param name="modelFileName">モデルのファイル名</param>
+	/// <returns>オブジェクトデータ</returns>
+	Elysia::LevelObjectData MakeObjectData(const std::string& name, const std::string& modelFileName) {
+		Elysia::LevelObjectData objectData = {};
+		objectData.type = "Stage";
+		objectData.name = name;
+		objectData.modelFileName = modelFileName;
+		return objectData;
+	}
+
+	/// <summary>
+	/// 前回のオブジェクトが1つずつ対応先か削除のどちらかに入っているかどうか
+	/// </summary>
+	/// <param name="diff">結果</param>
+	/// <param name="previousCount">前回の数</param>
+	/// <returns>入っているかどうか</returns>
+	bool IsEveryPreviousHandled(const LevelObjectDiff::Result& diff, const size_t& previousCount) {
+		std::vector<uint32_t> handledCounts(previousCount, 0u);
+		for (const LevelObjectDiff::Entry& entry : diff.entries) {
+			if (entry.action != LevelObjectDiff::Action::Add) {
+				++handledCounts[entry.previousIndex];
+			}
+		}
+		for (const uint32_t& index : diff.removedIndices) {
+			++handledCounts[index];
+		}
+		return std::all_of(handledCounts.begin(), handledCounts.end(), [](const uint32_t& count) {
+			return count == 1u;
+		});
+	}
+
+	/// <summary>
+	/// 再読み込みの追加,削除,作り直し,反映の振り分けの確認
+	/// </summary>
+	/// <param name="filePaths">レベルデータのファイル</param>
+	/// <returns>正しいかどうか</returns>
+	bool CheckReloadDiff(const std::vector<std::string>& filePaths) {
+		using LevelObjectDiff::Action;
+		bool isValid = true;
+		std::printf("再読み込みの振り分け\n");
+
+		//同じ名前が複数あっても前から順に対応させ、残りは全部消す
+		{
+			std::vector<Elysia::LevelObjectData> previous = {
+				MakeObjectData("Wall", "wall.obj"),
+				MakeObjectData("Tree", "tree.obj"),
+				MakeObjectData("Wall", "wall.obj"),
+				MakeObjectData("Gate", "gate.obj"),
+			};
+			std::vector<Elysia::LevelObjectData> current = {
+				MakeObjectData("Wall", "wall.obj"),
+				MakeObjectData("Gate", "gate2.obj"),
+				MakeObjectData("Rock", "rock.obj"),
+			};
+			LevelObjectDiff::Result diff = LevelObjectDiff::Make(previous, current);
+			Benchmark::Check(diff.entries.size() == 3u &&
+				diff.entries[0].action == Action::Patch && diff.entries[0].previousIndex == 0u &&
+				diff.entries[1].action == Action::Regenerate && diff.entries[1].previousIndex == 3u &&
+				diff.entries[2].action == Action::Add, "反映,作り直し,追加", isValid);
+			Benchmark::Check(diff.removedIndices == std::vector<uint32_t>({ 1u, 2u }), "2つ目の同じ名前も消す", isValid);
+			Benchmark::Check(IsEveryPreviousHandled(diff, previous.size()), "前回のものは全部1回だけ扱う", isValid);
+		}
+
+		//同じ名前が増えた分は追加
+		{
+			std::vector<Elysia::LevelObjectData> previous = {
+				MakeObjectData("Wall", "wall.obj"),
+			};
+			std::vector<Elysia::LevelObjectData> current = {
+				MakeObjectData("Wall", "wall.obj"),
+				MakeObjectData("Wall", "wall.obj"),
+			};
+			LevelObjectDiff::Result diff = LevelObjectDiff::Make(previous, current);
+			Benchmark::Check(diff.entries.size() == 2u &&
+				diff.entries[0].action == Action::Patch &&
+				diff.entries[1].action == Action::Add &&
+				diff.removedIndices.empty() == true, "同じ名前が増えた分は追加", isValid);
+		}
+
+		//音源の設定が変わったら作り直す
+		{
+			std::vector<Elysia::LevelObjectData> previous = { MakeObjectData("Speaker", "speaker.obj") };
+			std::vector<Elysia::LevelObjectData> current = { MakeObjectData("Speaker", "speaker.obj") };
+			current[0].levelAudioData.isLoop = !previous[0].levelAudioData.isLoop;
+			LevelObjectDiff::Result diff = LevelObjectDiff::Make(previous, current);
+			Benchmark::Check(diff.entries.size() == 1u && diff.entries[0].action == Action::Regenerate, "音源の設定が変わったら作り直す", isValid);
+		}
+
+		//同じファイルを読み直したら全部反映だけ
+		for (const std::string& filePath : filePaths) {
+			Elysia::StringInterner stringInterner;
+			std::vector<Elysia::LevelObjectData> previous;
+			std::vector<Elysia::LevelObjectData> current;
+			LevelDataParser::ParseWithSax(filePath, previous, stringInterner);
+			LevelDataParser::ParseWithSax(filePath, current, stringInterner);
+			LevelObjectDiff::Result diff = LevelObjectDiff::Make(previous, current);
+			bool isAllPatch = std::all_of(diff.entries.begin(), diff.entries.end(), [](const LevelObjectDiff::Entry& entry) {
+				return entry.action == Action::Patch;
+			});
+			std::string name = std::filesystem::path(filePath).filename().string() + " 読み直しは全部反映";
+			Benchmark::Check(isAllPatch == true && diff.removedIndices.empty() == true && IsEveryPreviousHandled(diff, previous.size()), name.c_str(), isValid);
+		}
+		return isValid;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	//レベルデータの場所
+	std::string levelDataDirectory = std::string(ELYSIA_RESOURCES_DIRECTORY) + "LevelData/";
+	if (argc > 1) {
+		levelDataDirectory = argv[1];
+	}
+	//回数
+	const uint32_t ITERATION_COUNT = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 50u;
+
+	//Resources/LevelData/*/*.json
+	std::vector<std::string> filePaths;
+	for (const auto& folder : std::filesystem::directory_iterator(levelDataDirectory)) {
+		if (folder.is_directory() == false) {
+			continue;
+		}
+		for (const auto& entry : std::filesystem::directory_iterator(folder.path())) {
+			if (entry.is_regular_file() && entry.path().extension() == ".json") {
+				filePaths.push_back(entry.path().string());
+			}
+		}
+	}
+	std::sort(filePaths.begin(), filePaths.end());
+
+	std::printf("%-28s %8s %7s | %9s %9s %6s | %9s %9s %6s | %9s %9s %6s | %6s %6s %5s %6s\n",
+		"file", "bytes", "objects", "dom[us]", "dom peak", "dom new", "sax[us]", "sax peak", "sax new", "bin[us]", "bin peak", "bin new", "sax", "bin", "same", "reload");
+
+	//クックしたファイルは一時フォルダに書き出す
+	cookedFilePath = (std::filesystem::temp_directory_path() / "ElysiaLevelDataParseBenchmark.lvl").string();
+
+	bool isAllSame = true;
+	for (const std::string& filePath : filePaths) {
+		Result dom = Measure(LevelDataParser::ParseWithDom, filePath, ITERATION_COUNT);
+		Result sax = Measure(LevelDataParser::ParseWithSax, filePath, ITERATION_COUNT);
+
+		//バイナリ
+		{
+			Elysia::StringInterner stringInterner;
+			std::vector<Elysia::LevelObjectData> objectDatas;
+			LevelDataParser::ParseWithSax(filePath, objectDatas, stringInterner);
+			LevelDataBinary::Write(cookedFilePath, objectDatas, std::filesystem::file_size(filePath));
+		}
+		Result binary = Measure(ReadCookedFile, filePath, ITERATION_COUNT);
+
+		bool isSame = IsSameResult(LevelDataParser::ParseWithSax, filePath) && IsSameResult(ReadCookedFile, filePath);
+		//再読み込み後の索引
+		bool isIndexKept = IsIndexKeptAfterReload(filePath);
+		isAllSame = isAllSame && isSame && isIndexKept;
+
+		std::printf("%-28s %8ju %7zu | %9.1f %9zu %6zu | %9.1f %9zu %6zu | %9.1f %9zu %6zu | %5.1fx %5.1fx %5s %6s\n",
+			std::filesystem::path(filePath).filename().string().c_str(),
+			static_cast<uintmax_t>(std::filesystem::file_size(filePath)),
+			sax.objectCount,
+			dom.microseconds, dom.peakBytes, dom.allocationCount,
+			sax.microseconds, sax.peakBytes, sax.allocationCount,
+			binary.microseconds, binary.peakBytes, binary.allocationCount,
+			dom.microseconds / sax.microseconds,
+			dom.microseconds / binary.microseconds,
+			isSame ? "yes" : "NO",
+			isIndexKept ? "yes" : "NO");
+	}
+	std::filesystem::remove(cookedFilePath);
+
+	//再読み込みの振り分け
+	isAllSame = CheckReloadDiff(filePaths) && isAllSame;
+
+	//結果が違ったら失敗
+	return isAllSame ? 0 : 1;
+}
@@ -0,0 +1,501 @@
+/**
+ * @file MathSimdBenchmark.cpp
+ * @brief SIMDの行列計算と配列をまとめた計算が、SIMDを使わない計算と同じ結果になるかの確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <numbers>
+#include <algorithm>
+
+#include "Matrix4x4Calculation.h"
+#include "BatchCalculation.h"
+#include "SimdCalculation.h"
+#include "Calculation/QuaternionCalculation.h"
+#include "VectorCalculation.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確かめる数
+	const uint32_t CHECK_COUNT_ = 4096u;
+	//まとめた計算で確かめる数(4で割り切れない残りも確かめる)
+	const uint32_t BATCH_CHECK_COUNT_ = 1027u;
+	//計測する数
+	const uint32_t MEASURE_COUNT_ = 256u;
+	//計測で回す回数
+	const uint32_t MEASURE_REPEAT_COUNT_ = 4000u;
+	//許容する相対誤差
+	const float TOLERANCE_ = 1.0e-4f;
+	//sin,cosで許容する誤差
+	const float SIN_COS_TOLERANCE_ = 1.0e-6f;
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 2つの行列の差(大きい方の要素で割った相対誤差)
+	/// </summary>
+	/// <param name="m1">行列1</param>
+	/// <param name="m2">行列2</param>
+	/// <returns>最大の誤差</returns>
+	float GetError(const Matrix4x4& m1, const Matrix4x4& m2) {
+		float scale = 1.0f;
+		for (uint32_t i = 0u; i < 4u; ++i) {
+			for (uint32_t j = 0u; j < 4u; ++j) {
+				scale = std::max(scale, std::max(std::fabs(m1.m[i][j]), std::fabs(m2.m[i][j])));
+			}
+		}
+		float error = 0.0f;
+		for (uint32_t i = 0u; i < 4u; ++i) {
+			for (uint32_t j = 0u; j < 4u; ++j) {
+				error = std::max(error, std::fabs(m1.m[i][j] - m2.m[i][j]) / scale);
+			}
+		}
+		return error;
+	}
+
+	/// <summary>
+	/// 確かめるデータ
+	/// </summary>
+	struct MathData {
+		std::vector<Vector3> scales;
+		std::vector<Vector3> rotates;
+		std::vector<Quaternion> quaternions;
+		std::vector<Vector3> translates;
+		std::vector<Matrix4x4> matrices;
+		std::vector<Vector3> points;
+	};
+
+	/// <summary>
+	/// データを作る
+	/// </summary>
+	/// <param name="count">数</param>
+	/// <returns>データ</returns>
+	MathData CreateMathData(const uint32_t& count) {
+		//毎回同じデータにする
+		std::mt19937 randomEngine(count);
+		std::uniform_real_distribution<float> scaleDistribution(0.25f, 4.0f);
+		std::uniform_real_distribution<float> angleDistribution(-2.0f * std::numbers::pi_v<float>, 2.0f * std::numbers::pi_v<float>);
+		std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+		MathData data = {};
+		for (uint32_t i = 0u; i < count; ++i) {
+			Vector3 scale = { .x = scaleDistribution(randomEngine),.y = scaleDistribution(randomEngine),.z = scaleDistribution(randomEngine) };
+			Vector3 rotate = { .x = angleDistribution(randomEngine),.y = angleDistribution(randomEngine),.z = angleDistribution(randomEngine) };
+			Vector3 axis = VectorCalculation::Normalize({ .x = distribution(randomEngine),.y = distribution(randomEngine),.z = distribution(randomEngine) });
+			Vector3 translate = { .x = distribution(randomEngine),.y = distribution(randomEngine),.z = distribution(randomEngine) };
+			data.scales.push_back(scale);
+			data.rotates.push_back(rotate);
+			data.quaternions.push_back(QuaternionCalculation::MakeRotateAxisAngleQuaternion(axis, angleDistribution(randomEngine)));
+			data.translates.push_back(translate);
+			data.matrices.push_back(Matrix4x4Calculation::Scalar::MakeAffineMatrix(scale, rotate, translate));
+			data.points.push_back({ .x = distribution(randomEngine),.y = distribution(randomEngine),.z = distribution(randomEngine) });
+		}
+		return data;
+	}
+
+	/// <summary>
+	/// 今までのMakeAffineMatrixと同じ計算
+	/// </summary>
+	Matrix4x4 MakeAffineMatrixByMultiply(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+		Matrix4x4 scaleMatrix = Matrix4x4Calculation::MakeScaleMatrix(scale);
+		Matrix4x4 rotateMatrix = Matrix4x4Calculation::Scalar::Multiply(Matrix4x4Calculation::MakeRotateXMatrix(rotate.x),
+			Matrix4x4Calculation::Scalar::Multiply(Matrix4x4Calculation::MakeRotateYMatrix(rotate.y), Matrix4x4Calculation::MakeRotateZMatrix(rotate.z)));
+		Matrix4x4 translateMatrix = Matrix4x4Calculation::MakeTranslateMatrix(translate);
+		return Matrix4x4Calculation::Scalar::Multiply(scaleMatrix, Matrix4x4Calculation::Scalar::Multiply(rotateMatrix, translateMatrix));
+	}
+
+	/// <summary>
+	/// 今までのクォータニオンのアフィン行列と同じ計算
+	/// </summary>
+	Matrix4x4 MakeQuaternionAffineMatrixByMultiply(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+		Matrix4x4 scaleMatrix = Matrix4x4Calculation::MakeScaleMatrix(scale);
+		Matrix4x4 rotateMatrix = QuaternionCalculation::MakeRotateMatrix(rotate);
+		Matrix4x4 translateMatrix = Matrix4x4Calculation::MakeTranslateMatrix(translate);
+		return Matrix4x4Calculation::Scalar::Multiply(scaleMatrix, Matrix4x4Calculation::Scalar::Multiply(rotateMatrix, translateMatrix));
+	}
+
+	/// <summary>
+	/// 行列の計算の確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckMatrix(bool& isValid) {
+		const MathData DATA = CreateMathData(CHECK_COUNT_);
+		float multiplyError = 0.0f;
+		float inverseError = 0.0f;
+		float inverseAffineError = 0.0f;
+		float scalarInverseAffineError = 0.0f;
+		float identityError = 0.0f;
+		float affineError = 0.0f;
+		float scalarAffineError = 0.0f;
+		float quaternionAffineError = 0.0f;
+		const Matrix4x4 IDENTITY = Matrix4x4Calculation::MakeIdentity4x4();
+		for (uint32_t i = 0u; i < CHECK_COUNT_; ++i) {
+			const Matrix4x4& m1 = DATA.matrices[i];
+			const Matrix4x4& m2 = DATA.matrices[(i + 1u) % CHECK_COUNT_];
+			multiplyError = std::max(multiplyError, GetError(Matrix4x4Calculation::Multiply(m1, m2), Matrix4x4Calculation::Scalar::Multiply(m1, m2)));
+			inverseError = std::max(inverseError, GetError(Matrix4x4Calculation::Inverse(m1), Matrix4x4Calculation::Scalar::Inverse(m1)));
+			inverseAffineError = std::max(inverseAffineError, GetError(Matrix4x4Calculation::InverseAffine(m1), Matrix4x4Calculation::Scalar::Inverse(m1)));
+			scalarInverseAffineError = std::max(scalarInverseAffineError, GetError(Matrix4x4Calculation::Scalar::InverseAffine(m1), Matrix4x4Calculation::Scalar::Inverse(m1)));
+			identityError = std::max(identityError, GetError(Matrix4x4Calculation::Multiply(m1, Matrix4x4Calculation::InverseAffine(m1)), IDENTITY));
+
+			const Vector3& scale = DATA.scales[i];
+			const Vector3& translate = DATA.translates[i];
+			affineError = std::max(affineError, GetError(Matrix4x4Calculation::MakeAffineMatrix(scale, DATA.rotates[i], translate), MakeAffineMatrixByMultiply(scale, DATA.rotates[i], translate)));
+			scalarAffineError = std::max(scalarAffineError, GetError(Matrix4x4Calculation::Scalar::MakeAffineMatrix(scale, DATA.rotates[i], translate), MakeAffineMatrixByMultiply(scale, DATA.rotates[i], translate)));
+			quaternionAffineError = std::max(quaternionAffineError, GetError(Matrix4x4Calculation::MakeQuaternionAffineMatrix(scale, DATA.quaternions[i], translate), MakeQuaternionAffineMatrixByMultiply(scale, DATA.quaternions[i], translate)));
+		}
+		std::printf("  最大の相対誤差 Multiply %.2e Inverse %.2e InverseAffine %.2e MakeAffineMatrix %.2e\n", multiplyError, inverseError, inverseAffineError, affineError);
+		Check(multiplyError <= TOLERANCE_, "Multiply", isValid);
+		Check(inverseError <= TOLERANCE_, "Inverse", isValid);
+		Check(inverseAffineError <= TOLERANCE_, "InverseAffine", isValid);
+		Check(scalarInverseAffineError <= TOLERANCE_, "Scalar::InverseAffine", isValid);
+		Check(identityError <= TOLERANCE_, "M * InverseAffine(M)が単位行列", isValid);
+		Check(affineError <= TOLERANCE_, "MakeAffineMatrix", isValid);
+		Check(scalarAffineError <= TOLERANCE_, "Scalar::MakeAffineMatrix", isValid);
+		Check(quaternionAffineError <= TOLERANCE_, "MakeQuaternionAffineMatrix", isValid);
+	}
+
+	/// <summary>
+	/// 2つのベクトルの配列の差(大きい方の要素で割った相対誤差)
+	/// </summary>
+	/// <param name="v1">配列1</param>
+	/// <param name="v2">配列2</param>
+	/// <returns>最大の誤差</returns>
+	float GetError(const std::vector<Vector3>& v1, const std::vector<Vector3>& v2) {
+		float error = 0.0f;
+		for (size_t i = 0u; i < v1.size(); ++i) {
+			float scale = std::max({ 1.0f, std::fabs(v1[i].x), std::fabs(v1[i].y), std::fabs(v1[i].z) });
+			error = std::max(error, std::fabs(v1[i].x - v2[i].x) / scale);
+			error = std::max(error, std::fabs(v1[i].y - v2[i].y) / scale);
+			error = std::max(error, std::fabs(v1[i].z - v2[i].z) / scale);
+		}
+		return error;
+	}
+
+	/// <summary>
+	/// 2つの行列の配列の差
+	/// </summary>
+	/// <param name="m1">配列1</param>
+	/// <param name="m2">配列2</param>
+	/// <returns>最大の誤差</returns>
+	float GetError(const std::vector<Matrix4x4>& m1, const std::vector<Matrix4x4>& m2) {
+		float error = 0.0f;
+		for (size_t i = 0u; i < m1.size(); ++i) {
+			error = std::max(error, GetError(m1[i], m2[i]));
+		}
+		return error;
+	}
+
+	/// <summary>
+	/// まとめた計算の確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckBatch(bool& isValid) {
+		const MathData DATA = CreateMathData(BATCH_CHECK_COUNT_);
+		//透視投影を含めてwで割るところも確かめる
+		const Matrix4x4 PROJECTION = Matrix4x4Calculation::Multiply(DATA.matrices[0], Matrix4x4Calculation::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 1000.0f));
+		std::vector<Vector3> points(BATCH_CHECK_COUNT_);
+		std::vector<Vector3> scalarPoints(BATCH_CHECK_COUNT_);
+		std::vector<Matrix4x4> matrices(BATCH_CHECK_COUNT_);
+		std::vector<Matrix4x4> scalarMatrices(BATCH_CHECK_COUNT_);
+
+		BatchCalculation::TransformPoints(DATA.points, DATA.matrices[1], points);
+		BatchCalculation::Scalar::TransformPoints(DATA.points, DATA.matrices[1], scalarPoints);
+		Check(GetError(points, scalarPoints) <= TOLERANCE_, "TransformPoints", isValid);
+
+		BatchCalculation::TransformPoints(DATA.points, PROJECTION, points);
+		BatchCalculation::Scalar::TransformPoints(DATA.points, PROJECTION, scalarPoints);
+		Check(GetError(points, scalarPoints) <= TOLERANCE_, "TransformPoints(透視投影)", isValid);
+
+		//同じ配列に書き込んでも良い
+		points = DATA.points;
+		BatchCalculation::TransformPoints(points, DATA.matrices[1], points);
+		BatchCalculation::Scalar::TransformPoints(DATA.points, DATA.matrices[1], scalarPoints);
+		Check(GetError(points, scalarPoints) <= TOLERANCE_, "TransformPoints(同じ配列)", isValid);
+
+		BatchCalculation::TransformNormals(DATA.points, DATA.matrices[2], points);
+		BatchCalculation::Scalar::TransformNormals(DATA.points, DATA.matrices[2], scalarPoints);
+		Check(GetError(points, scalarPoints) <= TOLERANCE_, "TransformNormals", isValid);
+
+		std::vector<Matrix4x4> rightMatrices(DATA.matrices.rbegin(), DATA.matrices.rend());
+		BatchCalculation::MultiplyMany(DATA.matrices, rightMatrices, matrices);
+		BatchCalculation::Scalar::MultiplyMany(DATA.matrices, rightMatrices, scalarMatrices);
+		Check(GetError(matrices, scalarMatrices) <= TOLERANCE_, "MultiplyMany", isValid);
+
+		BatchCalculation::MultiplyMany(DATA.matrices, DATA.matrices[3], matrices);
+		BatchCalculation::Scalar::MultiplyMany(DATA.matrices, DATA.matrices[3], scalarMatrices);
+		Check(GetError(matrices, scalarMatrices) <= TOLERANCE_, "MultiplyMany(同じ行列)", isValid);
+
+		BatchCalculation::MakeAffineMany(DATA.scales, DATA.rotates, DATA.translates, matrices);
+		BatchCalculation::Scalar::MakeAffineMany(DATA.scales, DATA.rotates, DATA.translates, scalarMatrices);
+		Check(GetError(matrices, scalarMatrices) <= TOLERANCE_, "MakeAffineMany", isValid);
+
+		BatchCalculation::MakeQuaternionAffineMany(DATA.scales, DATA.quaternions, DATA.translates, matrices);
+		BatchCalculation::Scalar::MakeQuaternionAffineMany(DATA.scales, DATA.quaternions, DATA.translates, scalarMatrices);
+		Check(GetError(matrices, scalarMatrices) <= TOLERANCE_, "MakeQuaternionAffineMany", isValid);
+
+		BatchCalculation::MakeRotateMatrixMany(DATA.quaternions, matrices);
+		BatchCalculation::Scalar::MakeRotateMatrixMany(DATA.quaternions, scalarMatrices);
+		Check(GetError(matrices, scalarMatrices) <= TOLERANCE_, "MakeRotateMatrixMany", isValid);
+
+		//1つずつの計算とも比べる
+		float singleError = 0.0f;
+		for (uint32_t i = 0u; i < BATCH_CHECK_COUNT_; ++i) {
+			singleError = std::max(singleError, GetError(matrices[i], QuaternionCalculation::MakeRotateMatrix(DATA.quaternions[i])));
+		}
+		Check(singleError <= TOLERANCE_, "MakeRotateMatrixMany = MakeRotateMatrix", isValid);
+	}
+
+	/// <summary>
+	/// sin,cosの確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckSinCos(bool& isValid) {
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+		//ゲームで使う範囲(±数千ラジアン)
+		const float RANGE = 1000.0f;
+		const uint32_t COUNT = 100000u;
+		float maxError = 0.0f;
+		for (uint32_t i = 0u; i < COUNT; i += 4u) {
+			float radians[4] = {};
+			for (uint32_t j = 0u; j < 4u; ++j) {
+				radians[j] = -RANGE + 2.0f * RANGE * float(i + j) / float(COUNT);
+			}
+			SimdCalculation::Float4 sinValue = {};
+			SimdCalculation::Float4 cosValue = {};
+			SimdCalculation::SinCos(SimdCalculation::Load(radians), sinValue, cosValue);
+			float sines[4] = {};
+			float cosines[4] = {};
+			SimdCalculation::Store(sines, sinValue);
+			SimdCalculation::Store(cosines, cosValue);
+			for (uint32_t j = 0u; j < 4u; ++j) {
+				//基準はdoubleで求める
+				maxError = std::max(maxError, float(std::fabs(double(sines[j]) - std::sin(double(radians[j])))));
+				maxError = std::max(maxError, float(std::fabs(double(cosines[j]) - std::cos(double(radians[j])))));
+			}
+		}
+		std::printf("  最大の誤差 SinCos %.2e\n", maxError);
+		Check(maxError <= SIN_COS_TOLERANCE_, "SinCos", isValid);
+#else
+		isValid;
+		std::printf("  SIMDを使わない設定なので確かめない\n");
+#endif
+	}
+
+	/// <summary>
+	/// 1個あたりの時間(ナノ秒)を測る
+	/// </summary>
+	/// <typeparam name="Function">全部の計算</typeparam>
+	/// <param name="function">処理</param>
+	/// <returns>時間</returns>
+	template<typename Function>
+	double Measure(Function function) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t repeat = 0u; repeat < MEASURE_REPEAT_COUNT_; ++repeat) {
+			function();
+		}
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() / double(MEASURE_REPEAT_COUNT_) / double(MEASURE_COUNT_);
+	}
+
+	/// <summary>
+	/// 結果を表示
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <param name="beforeTime">比べる元の時間</param>
+	/// <param name="afterTime">新しい方の時間</param>
+	void Print(const char* name, const double& beforeTime, const double& afterTime) {
+		std::printf("  %-32s %8.2fns -> %8.2fns %6.2fx\n", name, beforeTime, afterTime, beforeTime / std::max(afterTime, 0.001));
+	}
+
+	/// <summary>
+	/// 計測
+	/// </summary>
+	void MeasureMatrix() {
+		const MathData DATA = CreateMathData(MEASURE_COUNT_);
+		std::vector<Matrix4x4> results(MEASURE_COUNT_);
+
+		double scalarMultiply = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::Scalar::Multiply(DATA.matrices[i], results[i]);
+			}
+		});
+		double simdMultiply = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::Multiply(DATA.matrices[i], results[i]);
+			}
+		});
+		Print("Multiply", scalarMultiply, simdMultiply);
+
+		double scalarInverse = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::Scalar::Inverse(DATA.matrices[i]);
+			}
+		});
+		double simdInverse = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::Inverse(DATA.matrices[i]);
+			}
+		});
+		Print("Inverse", scalarInverse, simdInverse);
+
+		double simdInverseAffine = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::InverseAffine(DATA.matrices[i]);
+			}
+		});
+		Print("Scalar::Inverse -> InverseAffine", scalarInverse, simdInverseAffine);
+
+		double multiplyAffine = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = MakeAffineMatrixByMultiply(DATA.scales[i], DATA.rotates[i], DATA.translates[i]);
+			}
+		});
+		double scalarAffine = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::Scalar::MakeAffineMatrix(DATA.scales[i], DATA.rotates[i], DATA.translates[i]);
+			}
+		});
+		double simdAffine = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::MakeAffineMatrix(DATA.scales[i], DATA.rotates[i], DATA.translates[i]);
+			}
+		});
+		Print("S*R*T -> Scalar::MakeAffine", multiplyAffine, scalarAffine);
+		Print("S*R*T -> MakeAffineMatrix", multiplyAffine, simdAffine);
+
+		double multiplyQuaternionAffine = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = MakeQuaternionAffineMatrixByMultiply(DATA.scales[i], DATA.quaternions[i], DATA.translates[i]);
+			}
+		});
+		double quaternionAffine = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::MakeQuaternionAffineMatrix(DATA.scales[i], DATA.quaternions[i], DATA.translates[i]);
+			}
+		});
+		Print("S*R*T -> MakeQuaternionAffine", multiplyQuaternionAffine, quaternionAffine);
+
+		//最適化で消されないように結果を使う
+		double sum = 0.0;
+		for (const Matrix4x4& result : results) {
+			sum += double(result.m[3][0]);
+		}
+		std::printf("  (%.3f)\n", sum);
+	}
+
+
+	/// <summary>
+	/// まとめた計算の計測
+	/// 1つずつ関数を呼ぶのと比べる
+	/// </summary>
+	void MeasureBatch() {
+		const MathData DATA = CreateMathData(MEASURE_COUNT_);
+		std::vector<Vector3> points(MEASURE_COUNT_);
+		std::vector<Matrix4x4> results(MEASURE_COUNT_);
+		const Matrix4x4& matrix = DATA.matrices[0];
+
+		double singleTransform = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				points[i] = VectorCalculation::TransformCalculation(DATA.points[i], matrix);
+			}
+		});
+		double batchTransform = Measure([&]() {
+			BatchCalculation::TransformPoints(DATA.points, matrix, points);
+		});
+		Print("TransformCalculation -> Points", singleTransform, batchTransform);
+
+		double singleMultiply = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::Multiply(DATA.matrices[i], matrix);
+			}
+		});
+		double batchMultiply = Measure([&]() {
+			BatchCalculation::MultiplyMany(DATA.matrices, matrix, results);
+		});
+		Print("Multiply -> MultiplyMany", singleMultiply, batchMultiply);
+
+		double singleAffine = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::MakeAffineMatrix(DATA.scales[i], DATA.rotates[i], DATA.translates[i]);
+			}
+		});
+		double batchAffine = Measure([&]() {
+			BatchCalculation::MakeAffineMany(DATA.scales, DATA.rotates, DATA.translates, results);
+		});
+		Print("MakeAffineMatrix -> Many", singleAffine, batchAffine);
+
+		double singleQuaternionAffine = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = Matrix4x4Calculation::MakeQuaternionAffineMatrix(DATA.scales[i], DATA.quaternions[i], DATA.translates[i]);
+			}
+		});
+		double batchQuaternionAffine = Measure([&]() {
+			BatchCalculation::MakeQuaternionAffineMany(DATA.scales, DATA.quaternions, DATA.translates, results);
+		});
+		Print("MakeQuaternionAffine -> Many", singleQuaternionAffine, batchQuaternionAffine);
+
+		double singleRotate = Measure([&]() {
+			for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+				results[i] = QuaternionCalculation::MakeRotateMatrix(DATA.quaternions[i]);
+			}
+		});
+		double batchRotate = Measure([&]() {
+			BatchCalculation::MakeRotateMatrixMany(DATA.quaternions, results);
+		});
+		Print("MakeRotateMatrix -> Many", singleRotate, batchRotate);
+
+		//最適化で消されないように結果を使う
+		double sum = 0.0;
+		for (uint32_t i = 0u; i < MEASURE_COUNT_; ++i) {
+			sum += double(results[i].m[3][0] + points[i].x);
+		}
+		std::printf("  (%.3f)\n", sum);
+	}
+
+}
+
+int main() {
+#if defined(__GNUC__) && defined(ELYSIA_MATH_AVX)
+	//AVXで作った時は使えない機械では確かめない
+	if (__builtin_cpu_supports("avx2") == false || __builtin_cpu_supports("fma") == false) {
+		std::printf("この機械ではAVX2とFMAが使えないので確かめない\n");
+		return 0;
+	}
+#endif
+
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+#if defined(ELYSIA_MATH_AVX) && defined(ELYSIA_MATH_FMA)
+	std::printf("SSE+AVX+FMA\n");
+#elif defined(ELYSIA_MATH_AVX)
+	std::printf("SSE+AVX\n");
+#else
+	std::printf("SSE\n");
+#endif
+#elif ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_NEON
+	std::printf("NEON\n");
+#else
+	std::printf("SIMDなし\n");
+#endif
+
+	bool isValid = true;
+	std::printf("行列\n");
+	CheckMatrix(isValid);
+	std::printf("配列をまとめた計算\n");
+	CheckBatch(isValid);
+	std::printf("sin,cos\n");
+	CheckSinCos(isValid);
+	std::printf("計測(SIMDなし -> SIMD)\n");
+	MeasureMatrix();
+	std::printf("配列をまとめた計算の計測(1つずつ呼ぶ -> まとめて呼ぶ)\n");
+	MeasureBatch();
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file ParallelRecordBenchmark.cpp
+ * @brief 並列記録(ParallelCommandRecorder)の順番の確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <chrono>
+
+#include "ParallelCommandRecorder.h"
+#include "ICommandRecordBackend.h"
+
+namespace {
+
+	//計測するフレーム数
+	const uint32_t FRAME_COUNT_ = 60u;
+	//1パスあたりの描画の数
+	const uint32_t ITEM_COUNT_ = 600u;
+
+	/// <summary>
+	/// コマンドリストの代わり
+	/// 積まれた値を配列に記録して、送られた順番に並べる
+	/// </summary>
+	class MockCommandRecordBackend final : public Elysia::ICommandRecordBackend {
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="recorder">並列記録</param>
+		void Initialize(Elysia::ParallelCommandRecorder* recorder) {
+			recorder_ = recorder;
+		}
+
+		void PrepareChunks(const uint32_t& firstChunkIndex, const uint32_t& chunkCount)override {
+			if (chunkLogs_.size() < firstChunkIndex + chunkCount) {
+				chunkLogs_.resize(firstChunkIndex + chunkCount);
+			}
+		}
+
+		void BeginChunk(const uint32_t& chunkIndex)override {
+			chunkLogs_[chunkIndex].clear();
+			recordingLog_ = &chunkLogs_[chunkIndex];
+		}
+
+		void EndChunk(const uint32_t&)override {
+			recordingLog_ = nullptr;
+		}
+
+		void Submit(const uint32_t& firstChunkIndex, const uint32_t& chunkCount)override {
+			//メインの記録先が先
+			FlushMainLog();
+			for (uint32_t i = 0u; i < chunkCount; ++i) {
+				const std::vector<uint32_t>& chunkLog = chunkLogs_[firstChunkIndex + i];
+				submitted_.insert(submitted_.end(), chunkLog.begin(), chunkLog.end());
+			}
+		}
+
+		/// <summary>
+		/// コマンドを積む
+		/// DirectXSetup::GetCommandListと同じ流れで記録先を決める
+		/// </summary>
+		/// <param name="value">値</param>
+		void Record(const uint32_t& value) {
+			if (recordingLog_ == nullptr && recorder_->GetIsInPass() == true) {
+				recorder_->RecordInline();
+			}
+			std::vector<uint32_t>* log = (recordingLog_ != nullptr) ? recordingLog_ : &mainLog_;
+			log->push_back(value);
+		}
+
+		/// <summary>
+		/// フレームの終わりにメインの記録先を送る
+		/// </summary>
+		void FlushMainLog() {
+			submitted_.insert(submitted_.end(), mainLog_.begin(), mainLog_.end());
+			mainLog_.clear();
+		}
+
+		/// <summary>
+		/// 送られた順番を取り出す
+		/// </summary>
+		/// <returns>値</returns>
+		std::vector<uint32_t> TakeSubmitted() {
+			std::vector<uint32_t> submitted;
+			submitted.swap(submitted_);
+			return submitted;
+		}
+
+	private:
+		Elysia::ParallelCommandRecorder* recorder_ = nullptr;
+		std::vector<std::vector<uint32_t>> chunkLogs_;
+		std::vector<uint32_t> mainLog_;
+		std::vector<uint32_t> submitted_;
+		static thread_local std::vector<uint32_t>* recordingLog_;
+	};
+
+	thread_local std::vector<uint32_t>* MockCommandRecordBackend::recordingLog_ = nullptr;
+
+	/// <summary>
+	/// 描画1つ分の重さの代わり
+	/// </summary>
+	/// <param name="value">値</param>
+	/// <param name="workCount">重さ</param>
+	/// <returns>値</returns>
+	uint32_t SimulateWork(const uint32_t& value, const uint32_t& workCount) {
+		uint32_t hash = value;
+		for (uint32_t i = 0u; i < workCount; ++i) {
+			hash = hash * 1664525u + 1013904223u;
+		}
+		//結果を使わないと最適化で消されるので0にならない値を混ぜる
+		return (hash == 0xffffffffu) ? value + 1u : value;
+	}
+
+	/// <summary>
+	/// 3D,ポストエフェクト,スプライトと同じように3つのパスを回す
+	/// </summary>
+	/// <param name="workerCount">ワーカースレッドの数</param>
+	/// <param name="itemsPerChunk">1チャンクあたりの描画の数</param>
+	/// <param name="inlineInterval">直接積む描画の間隔(0だと直接積まない)</param>
+	/// <param name="workCount">描画1つ分の重さ</param>
+	/// <param name="isValid">順番が正しかったか</param>
+	/// <returns>1フレームあたりの時間(ms)</returns>
+	double Simulate(const uint32_t& workerCount, const uint32_t& itemsPerChunk, const uint32_t& inlineInterval, const uint32_t& workCount, bool& isValid) {
+		Elysia::ParallelCommandRecorder recorder;
+		MockCommandRecordBackend backend;
+		backend.Initialize(&recorder);
+		recorder.Initialize(&backend, workerCount, itemsPerChunk);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t frame = 0u; frame < FRAME_COUNT_; ++frame) {
+			//メインスレッドでそのまま積んだ時の順番
+			std::vector<uint32_t> expected;
+			uint32_t value = 0u;
+
+			for (uint32_t pass = 0u; pass < 3u; ++pass) {
+				//パスの前のバリアやクリア
+				backend.Record(value);
+				expected.push_back(value);
+				++value;
+
+				recorder.BeginPass();
+				for (uint32_t item = 0u; item < ITEM_COUNT_; ++item) {
+					//パーティクルのように直接積む描画
+					if (inlineInterval != 0u && item % inlineInterval == 0u) {
+						backend.Record(value);
+						expected.push_back(value);
+						++value;
+						continue;
+					}
+
+					//1つの描画で複数のコマンドを積む
+					uint32_t firstValue = value;
+					recorder.Push([&backend, firstValue, workCount]() {
+						for (uint32_t i = 0u; i < 3u; ++i) {
+							backend.Record(SimulateWork(firstValue + i, workCount));
+						}
+					});
+					for (uint32_t i = 0u; i < 3u; ++i) {
+						expected.push_back(value);
+						++value;
+					}
+				}
+				recorder.EndPass();
+			}
+
+			//ImGuiやバリア
+			backend.Record(value);
+			expected.push_back(value);
+			backend.FlushMainLog();
+			recorder.BeginFrame();
+
+			if (backend.TakeSubmitted() != expected) {
+				isValid = false;
+			}
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		recorder.Finalize();
+		return std::chrono::duration<double, std::milli>(end - start).count() / static_cast<double>(FRAME_COUNT_);
+	}
+
+	/// <summary>
+	/// ワーカーの数ごとに比べる
+	/// </summary>
+	/// <param name="itemsPerChunk">1チャンクあたりの描画の数</param>
+	/// <param name="inlineInterval">直接積む描画の間隔</param>
+	/// <param name="workCount">描画1つ分の重さ</param>
+	/// <returns>正しいかどうか</returns>
+	bool Measure(const uint32_t& itemsPerChunk, const uint32_t& inlineInterval, const uint32_t& workCount) {
+		bool isValid = true;
+		std::printf("  チャンク %3u, 直接積む間隔 %3u, 重さ %5u :", itemsPerChunk, inlineInterval, workCount);
+		const uint32_t WORKER_COUNTS[] = { 0u, 1u, 3u, 8u };
+		for (uint32_t workerCount : WORKER_COUNTS) {
+			double frameTime = Simulate(workerCount, itemsPerChunk, inlineInterval, workCount, isValid);
+			std::printf(" %uスレッド %7.3f ms", workerCount, frameTime);
+		}
+		std::printf(" %s\n", (isValid == true) ? "OK" : "NG");
+		return isValid;
+	}
+
+}
+
+int main() {
+	//送られる順番がメインスレッドだけで積んだ時と同じか確かめる
+	//直接積む描画が混ざるとチャンクが細かく分かれる
+	std::printf("1フレームあたりの時間\n");
+	bool isValid = true;
+	const uint32_t CASES[][3] = {
+		{ 32u, 0u, 2000u },
+		{ 32u, 0u, 20000u },
+		{ 1u, 0u, 2000u },
+		{ 32u, 50u, 2000u },
+		{ 32u, 7u, 2000u },
+		{ 500u, 3u, 2000u },
+	};
+	for (const auto& testCase : CASES) {
+		if (Measure(testCase[0], testCase[1], testCase[2]) == false) {
+			isValid = false;
+		}
+	}
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * @file BenchmarkCheck.h
+ * @brief ベンチマークの確認の表示
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+
+/// <summary>
+/// ベンチマーク
+/// </summary>
+namespace Benchmark {
+
+	/// <summary>
+	/// 確認
+	/// 1つでもNGならisValidをfalseにするので、mainの戻り値にしてctestで失敗させる
+	/// </summary>
+	/// <param name="condition">条件</param>
+	/// <param name="name">名前</param>
+	/// <param name="isValid">全体の結果</param>
+	inline void Check(const bool& condition, const char* name, bool& isValid) {
+		std::printf("  %-48s %s\n", name, (condition == true) ? "OK" : "NG");
+		if (condition == false) {
+			isValid = false;
+		}
+	}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @file MathCompatibility.h
+ * @brief MSVC以外でエンジンの数学関数を使えるようにする
+ * @author 茂木翼
+ */
+
+#include <cmath>
+
+//libstdc++はstd::sinfなどをstd名前空間に入れていないので補う
+//MSVCではそのまま使えるので何もしない
+#if defined(__GLIBCXX__)
+namespace std {
+	using ::sinf;
+	using ::cosf;
+	using ::tanf;
+	using ::asinf;
+	using ::acosf;
+	using ::atanf;
+	using ::atan2f;
+	using ::sqrtf;
+	using ::powf;
+	using ::fabsf;
+	using ::floorf;
+	using ::ceilf;
+	using ::fmodf;
+	using ::expf;
+	using ::logf;
+}
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * @file corecrt_math.h
+ * @brief MSVCのcorecrt_math.hの代わり
+ * @author 茂木翼
+ */
+
+#include <cmath>
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * @file imgui.h
+ * @brief ImGuiの代わり
+ * @author 茂木翼
+ */
+
+//ImGuiを使うのはデバッグの表示だけで、_DEBUGの中に書いてあるので中身は要らない
@@ -0,0 +1,331 @@
+/**
+ * @file ProfilerBenchmark.cpp
+ * @brief プロファイラの確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <filesystem>
+
+#include <json.hpp>
+
+#include "Profiler.h"
+
+/// <summary>
+/// 計測を切った時の確認用(ProfilerDisabled.cppで定義)
+/// </summary>
+void RunDisabledScopes();
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 名前で区間を探す
+	/// </summary>
+	/// <param name="frame">フレーム</param>
+	/// <param name="name">名前</param>
+	/// <returns>区間(無ければnullptr)</returns>
+	const Elysia::ProfileZone* FindZone(const Elysia::ProfileFrame& frame, const char* name) {
+		for (const Elysia::ProfileZone& zone : frame.zones) {
+			if (std::strcmp(zone.name, name) == 0) {
+				return &zone;
+			}
+		}
+		return nullptr;
+	}
+
+	/// <summary>
+	/// 内側の区間が外側の区間に収まっているか
+	/// </summary>
+	/// <param name="inner">内側</param>
+	/// <param name="outer">外側</param>
+	/// <returns>収まっているか</returns>
+	bool IsInside(const Elysia::ProfileZone* inner, const Elysia::ProfileZone* outer) {
+		return inner != nullptr && outer != nullptr &&
+			inner->beginTime >= outer->beginTime && inner->endTime <= outer->endTime &&
+			inner->depth == outer->depth + 1u && inner->threadIndex == outer->threadIndex;
+	}
+
+	/// <summary>
+	/// 入れ子の確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckNesting(bool& isValid) {
+		Elysia::Profiler* profiler = Elysia::Profiler::GetInstance();
+		ELYSIA_PROFILE_THREAD("メイン");
+		profiler->NewFrame();
+		{
+			ELYSIA_PROFILE_SCOPE("Update");
+			{
+				ELYSIA_PROFILE_SCOPE("Collision");
+			}
+			{
+				ELYSIA_PROFILE_SCOPE("Enemy");
+				{
+					ELYSIA_PROFILE_SCOPE("Animation");
+				}
+			}
+		}
+		profiler->NewFrame();
+
+		const Elysia::ProfileFrame& frame = profiler->GetLastFrame();
+		const Elysia::ProfileZone* update = FindZone(frame, "Update");
+		const Elysia::ProfileZone* collision = FindZone(frame, "Collision");
+		const Elysia::ProfileZone* enemy = FindZone(frame, "Enemy");
+		const Elysia::ProfileZone* animation = FindZone(frame, "Animation");
+		Check(frame.zones.size() == 4u, "4つの区間が閉じる", isValid);
+		Check(update != nullptr && update->depth == 0u, "一番外側は深さ0", isValid);
+		Check(IsInside(collision, update) == true && IsInside(enemy, update) == true, "子は親に収まる", isValid);
+		Check(IsInside(animation, enemy) == true, "孫は子に収まる", isValid);
+		Check(collision != nullptr && enemy != nullptr && collision->endTime <= enemy->beginTime, "兄弟は重ならない", isValid);
+		Check(update != nullptr && update->beginTime >= frame.beginTime && update->endTime <= frame.endTime, "区間はフレームに収まる", isValid);
+		Check(profiler->GetThreadName(update->threadIndex) == "メイン", "スレッドの名前", isValid);
+
+		//フレームをまたぐ区間は閉じたフレームに入る
+		{
+			ELYSIA_PROFILE_SCOPE("Loading");
+			profiler->NewFrame();
+		}
+		Check(FindZone(profiler->GetLastFrame(), "Loading") == nullptr, "閉じていない区間はまだ入らない", isValid);
+		profiler->NewFrame();
+		Check(FindZone(profiler->GetLastFrame(), "Loading") != nullptr, "閉じたフレームに入る", isValid);
+	}
+
+	/// <summary>
+	/// 複数のスレッドから書きながら集める
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckThreads(bool& isValid) {
+		Elysia::Profiler* profiler = Elysia::Profiler::GetInstance();
+		const uint32_t THREAD_COUNT = 4u;
+		const uint32_t ITERATION_COUNT = 100000u;
+
+		profiler->NewFrame();
+		uint64_t droppedCountBefore = profiler->GetDroppedCount();
+		std::atomic<uint32_t> finishedCount = 0u;
+		std::vector<std::thread> threads;
+		for (uint32_t i = 0u; i < THREAD_COUNT; ++i) {
+			threads.emplace_back([&finishedCount]() {
+				ELYSIA_PROFILE_THREAD("ワーカー");
+				for (uint32_t j = 0u; j < ITERATION_COUNT; ++j) {
+					ELYSIA_PROFILE_SCOPE("Job");
+					ELYSIA_PROFILE_SCOPE("Inner");
+				}
+				finishedCount.fetch_add(1u);
+			});
+		}
+
+		//書いている間も集める
+		uint64_t jobCount = 0u;
+		uint64_t innerCount = 0u;
+		bool isNested = true;
+		auto collect = [&]() {
+			profiler->NewFrame();
+			const Elysia::ProfileFrame& frame = profiler->GetLastFrame();
+			for (const Elysia::ProfileZone& zone : frame.zones) {
+				if (std::strcmp(zone.name, "Job") == 0) {
+					++jobCount;
+					isNested = isNested && zone.depth == 0u;
+				}
+				else if (std::strcmp(zone.name, "Inner") == 0) {
+					//外側が書けずに集めた直後に内側だけ書けることがある
+					++innerCount;
+					isNested = isNested && zone.depth <= 1u;
+				}
+			}
+		};
+		while (finishedCount.load() < THREAD_COUNT) {
+			collect();
+			std::this_thread::yield();
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		collect();
+
+		uint64_t droppedCount = profiler->GetDroppedCount() - droppedCountBefore;
+		uint64_t expectedCount = uint64_t(THREAD_COUNT) * ITERATION_COUNT;
+		std::printf("  %u本 x %u回 集めた区間%llu 書けなかった%llu\n", THREAD_COUNT, ITERATION_COUNT,
+			static_cast<unsigned long long>(jobCount + innerCount), static_cast<unsigned long long>(droppedCount));
+		Check(jobCount <= expectedCount && innerCount <= expectedCount, "多く数えない", isValid);
+		Check(jobCount + innerCount + droppedCount == expectedCount * 2u, "集めた数と書けなかった数で全部", isValid);
+		Check(isNested == true, "スレッドごとの深さが崩れない", isValid);
+	}
+
+	/// <summary>
+	/// いっぱいになった時
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckOverflow(bool& isValid) {
+		Elysia::Profiler* profiler = Elysia::Profiler::GetInstance();
+		const uint32_t COUNT = Elysia::ProfileEventRing::CAPACITY_;
+
+		profiler->NewFrame();
+		uint64_t droppedCountBefore = profiler->GetDroppedCount();
+		{
+			//外側が閉じる前にいっぱいになる
+			ELYSIA_PROFILE_SCOPE("Outer");
+			for (uint32_t i = 0u; i < COUNT; ++i) {
+				ELYSIA_PROFILE_SCOPE("Middle");
+				ELYSIA_PROFILE_SCOPE("Leaf");
+			}
+		}
+		profiler->NewFrame();
+
+		const Elysia::ProfileFrame& frame = profiler->GetLastFrame();
+		const Elysia::ProfileZone* outer = FindZone(frame, "Outer");
+		bool isInside = true;
+		for (const Elysia::ProfileZone& zone : frame.zones) {
+			if (outer != nullptr && zone.name != outer->name) {
+				isInside = isInside && zone.beginTime >= outer->beginTime && zone.endTime <= outer->endTime && zone.depth > 0u;
+			}
+		}
+		uint64_t droppedCount = profiler->GetDroppedCount() - droppedCountBefore;
+		Check(droppedCount > 0u, "溢れた分は書かない", isValid);
+		Check(outer != nullptr && outer->depth == 0u, "外側の終わりは必ず書ける", isValid);
+		Check(isInside == true, "書けた区間は全部外側に収まる", isValid);
+		Check(frame.zones.size() + droppedCount == uint64_t(COUNT) * 2u + 1u, "書けた数と書けなかった数で全部", isValid);
+
+		//集めた後はまた書ける
+		{
+			ELYSIA_PROFILE_SCOPE("After");
+		}
+		profiler->NewFrame();
+		Check(FindZone(profiler->GetLastFrame(), "After") != nullptr, "集めた後はまた書ける", isValid);
+	}
+
+	/// <summary>
+	/// chrome://tracingのJSON
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckChromeTrace(bool& isValid) {
+		Elysia::Profiler* profiler = Elysia::Profiler::GetInstance();
+		const std::string FILE_PATH = (std::filesystem::temp_directory_path() / "ElysiaProfileBenchmark.json").string();
+		const uint32_t FRAME_COUNT = 3u;
+
+		profiler->NewFrame();
+		profiler->RequestCapture(FRAME_COUNT, FILE_PATH);
+		for (uint32_t i = 0u; i < FRAME_COUNT; ++i) {
+			{
+				ELYSIA_PROFILE_SCOPE("Framework::Update");
+				ELYSIA_PROFILE_SCOPE("\"Quoted\\Name\"");
+			}
+			profiler->NewFrame();
+		}
+		Check(profiler->GetIsCapturing() == false, "指定したフレーム数で終わる", isValid);
+
+		nlohmann::json root;
+		std::ifstream file(FILE_PATH);
+		bool isParsed = false;
+		try {
+			file >> root;
+			isParsed = true;
+		}
+		catch (const nlohmann::json::exception&) {
+			isParsed = false;
+		}
+		Check(isParsed == true && root.contains("traceEvents") == true, "JSONとして読める", isValid);
+		if (isParsed == false) {
+			return;
+		}
+
+		uint32_t zoneCount = 0u;
+		uint32_t frameMarkerCount = 0u;
+		uint32_t threadNameCount = 0u;
+		bool isQuoted = false;
+		bool isPositive = true;
+		for (const nlohmann::json& event : root["traceEvents"]) {
+			const std::string phase = event["ph"].get<std::string>();
+			if (phase == "X") {
+				++zoneCount;
+				isPositive = isPositive && event["ts"].get<double>() >= 0.0 && event["dur"].get<double>() >= 0.0;
+				isQuoted = isQuoted || event["name"].get<std::string>() == "\"Quoted\\Name\"";
+			}
+			else if (phase == "i") {
+				++frameMarkerCount;
+			}
+			else if (phase == "M") {
+				++threadNameCount;
+			}
+		}
+		Check(zoneCount == FRAME_COUNT * 2u, "区間の数", isValid);
+		Check(frameMarkerCount == FRAME_COUNT, "フレームの区切り", isValid);
+		Check(threadNameCount == profiler->GetThreadCount(), "スレッドの名前", isValid);
+		Check(isPositive == true, "時刻と長さが負にならない", isValid);
+		Check(isQuoted == true, "名前をエスケープする", isValid);
+		std::filesystem::remove(FILE_PATH);
+	}
+
+	/// <summary>
+	/// 計測を切った時
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckDisabled(bool& isValid) {
+		Elysia::Profiler* profiler = Elysia::Profiler::GetInstance();
+		profiler->NewFrame();
+		RunDisabledScopes();
+		profiler->NewFrame();
+		Check(profiler->GetLastFrame().zones.empty() == true, "切ると何も書かない", isValid);
+	}
+
+	/// <summary>
+	/// 1区間に掛かる時間
+	/// </summary>
+	void Measure() {
+		Elysia::Profiler* profiler = Elysia::Profiler::GetInstance();
+		const uint32_t COUNT = 1000000u;
+		//リングバッファが溢れないように時々集める
+		const uint32_t FRAME_LENGTH = 4096u;
+
+		profiler->NewFrame();
+		uint64_t start = Elysia::Profiler::GetTime();
+		for (uint32_t i = 0u; i < COUNT; ++i) {
+			ELYSIA_PROFILE_SCOPE("Measure");
+			if (i % FRAME_LENGTH == FRAME_LENGTH - 1u) {
+				profiler->NewFrame();
+			}
+		}
+		uint64_t scopeTime = Elysia::Profiler::GetTime() - start;
+
+		//時刻を取るだけ
+		start = Elysia::Profiler::GetTime();
+		uint64_t sum = 0u;
+		for (uint32_t i = 0u; i < COUNT; ++i) {
+			sum += Elysia::Profiler::GetTime();
+		}
+		uint64_t clockTime = Elysia::Profiler::GetTime() - start;
+
+		std::printf("  区間 %.1fns/回 (集める分を含む) 時刻の取得 %.1fns/回 (%llu)\n",
+			double(scopeTime) / COUNT, double(clockTime) / COUNT, static_cast<unsigned long long>(sum & 1u));
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("入れ子\n");
+	CheckNesting(isValid);
+	std::printf("複数のスレッド\n");
+	CheckThreads(isValid);
+	std::printf("いっぱいになった時\n");
+	CheckOverflow(isValid);
+	std::printf("chrome://tracing\n");
+	CheckChromeTrace(isValid);
+	std::printf("計測を切った時\n");
+	CheckDisabled(isValid);
+	std::printf("計測\n");
+	Measure();
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+/**
+ * @file ProfilerDisabled.cpp
+ * @brief 計測を切った時に何も書かないかの確認用
+ * @author 茂木翼
+ */
+
+//リリースと同じように切る
+#undef ELYSIA_PROFILER_ENABLE
+#define ELYSIA_PROFILER_ENABLE 0
+#include "Profiler.h"
+
+void RunDisabledScopes() {
+	ELYSIA_PROFILE_THREAD("切った時");
+	for (int i = 0; i < 16; ++i) {
+		ELYSIA_PROFILE_SCOPE("Disabled");
+	}
+}
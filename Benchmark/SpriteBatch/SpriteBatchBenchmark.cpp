@@ -0,0 +1,238 @@
+/**
+ * @file SpriteBatchBenchmark.cpp
+ * @brief スプライトをまとめて描画する時の頂点とグループの確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <chrono>
+
+#include "SpriteBatchBuilder.h"
+#include "Matrix4x4Calculation.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//画面の大きさ
+	const float SCREEN_WIDTH_ = 1280.0f;
+	const float SCREEN_HEIGHT_ = 720.0f;
+	//通常ブレンド
+	const uint32_t BLEND_MODE_NORMAL_ = 1u;
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// スプライトを作る
+	/// </summary>
+	/// <param name="position">座標</param>
+	/// <param name="size">サイズ</param>
+	/// <param name="textureHandle">テクスチャ</param>
+	/// <returns>スプライト</returns>
+	Elysia::SpriteQuad MakeQuad(const Vector2& position, const Vector2& size, const uint32_t& textureHandle) {
+		return {
+			.position = position,
+			.size = size,
+			.scale = {.x = 1.0f,.y = 1.0f },
+			.rotate = 0.0f,
+			.anchorPoint = {.x = 0.0f,.y = 0.0f },
+			.isFlipX = false,
+			.isFlipY = false,
+			.depth = 0.0f,
+			.texLeftTop = {.x = 0.0f,.y = 0.0f },
+			.texRightBottom = {.x = 1.0f,.y = 1.0f },
+			.uvScale = {.x = 1.0f,.y = 1.0f },
+			.uvRotate = 0.0f,
+			.uvTranslate = {.x = 0.0f,.y = 0.0f },
+			.color = {.x = 1.0f,.y = 1.0f,.z = 1.0f,.w = 1.0f },
+			.textureHandle = textureHandle,
+			.blendMode = BLEND_MODE_NORMAL_,
+		};
+	}
+
+	/// <summary>
+	/// 行ベクトルに行列をかける
+	/// </summary>
+	/// <param name="vector">ベクトル</param>
+	/// <param name="matrix">行列</param>
+	/// <returns>結果</returns>
+	Vector4 Transform(const Vector4& vector, const Matrix4x4& matrix) {
+		return {
+			.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + vector.w * matrix.m[3][0],
+			.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + vector.w * matrix.m[3][1],
+			.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + vector.w * matrix.m[3][2],
+			.w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + vector.w * matrix.m[3][3],
+		};
+	}
+
+	/// <summary>
+	/// 今までのSprite::Drawと同じく行列で計算した頂点と比べる
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckVertices(bool& isValid) {
+		std::mt19937 randomEngine(1u);
+		std::uniform_real_distribution<float> random(0.0f, 1.0f);
+
+		float maxError = 0.0f;
+		for (uint32_t i = 0u; i < 1000u; ++i) {
+			Elysia::SpriteQuad quad = MakeQuad({ .x = random(randomEngine) * SCREEN_WIDTH_,.y = random(randomEngine) * SCREEN_HEIGHT_ },
+				{ .x = 16.0f + random(randomEngine) * 256.0f,.y = 16.0f + random(randomEngine) * 256.0f }, 1u);
+			quad.scale = { .x = 0.5f + random(randomEngine),.y = 0.5f + random(randomEngine) };
+			quad.rotate = random(randomEngine) * 6.28f;
+			quad.anchorPoint = { .x = random(randomEngine),.y = random(randomEngine) };
+			quad.isFlipX = (i % 2u == 0u);
+			quad.isFlipY = (i % 3u == 0u);
+			quad.depth = (i % 5u == 0u) ? 1.0f : 0.0f;
+			quad.texLeftTop = { .x = random(randomEngine) * 0.5f,.y = random(randomEngine) * 0.5f };
+			quad.texRightBottom = { .x = 0.5f + random(randomEngine) * 0.5f,.y = 0.5f + random(randomEngine) * 0.5f };
+			quad.uvScale = { .x = 0.5f + random(randomEngine),.y = 0.5f + random(randomEngine) };
+			quad.uvRotate = random(randomEngine) * 6.28f;
+			quad.uvTranslate = { .x = random(randomEngine),.y = random(randomEngine) };
+
+			Elysia::SpriteBatchBuilder builder;
+			builder.Add(quad);
+			builder.Build(SCREEN_WIDTH_, SCREEN_HEIGHT_);
+			const std::vector<Elysia::SpriteBatchVertex>& vertices = builder.GetVertices();
+
+			//Sprite::Drawと同じ計算
+			float left = (0.0f - quad.anchorPoint.x) * quad.size.x;
+			float right = (1.0f - quad.anchorPoint.x) * quad.size.x;
+			float top = (0.0f - quad.anchorPoint.y) * quad.size.y;
+			float bottom = (1.0f - quad.anchorPoint.y) * quad.size.y;
+			if (quad.isFlipX == true) {
+				left = -left;
+				right = -right;
+			}
+			if (quad.isFlipY == true) {
+				top = -top;
+				bottom = -bottom;
+			}
+			Matrix4x4 affineMatrix = Matrix4x4Calculation::MakeAffineMatrix({ quad.scale.x,quad.scale.y,1.0f }, { 0.0f,0.0f,quad.rotate }, { quad.position.x,quad.position.y,quad.depth });
+			Matrix4x4 projectionMatrix = Matrix4x4Calculation::MakeOrthographicMatrix(0.0f, 0.0f, SCREEN_WIDTH_, SCREEN_HEIGHT_, 0.0f, 100.0f);
+			Matrix4x4 worldViewProjectionMatrix = Matrix4x4Calculation::Multiply(affineMatrix, projectionMatrix);
+			Matrix4x4 uvTransformMatrix = Matrix4x4Calculation::MakeScaleMatrix({ quad.uvScale.x,quad.uvScale.y,1.0f });
+			uvTransformMatrix = Matrix4x4Calculation::Multiply(uvTransformMatrix, Matrix4x4Calculation::MakeRotateZMatrix(quad.uvRotate));
+			uvTransformMatrix = Matrix4x4Calculation::Multiply(uvTransformMatrix, Matrix4x4Calculation::MakeTranslateMatrix({ quad.uvTranslate.x,quad.uvTranslate.y,0.0f }));
+
+			const Vector4 LOCAL_POSITIONS[4] = { {left,bottom,0.0f,1.0f},{left,top,0.0f,1.0f},{right,bottom,0.0f,1.0f},{right,top,0.0f,1.0f} };
+			const Vector4 TEX_COORDS[4] = {
+				{quad.texLeftTop.x,quad.texRightBottom.y,0.0f,1.0f},{quad.texLeftTop.x,quad.texLeftTop.y,0.0f,1.0f},
+				{quad.texRightBottom.x,quad.texRightBottom.y,0.0f,1.0f},{quad.texRightBottom.x,quad.texLeftTop.y,0.0f,1.0f} };
+			for (uint32_t vertex = 0u; vertex < 4u; ++vertex) {
+				Vector4 position = Transform(LOCAL_POSITIONS[vertex], worldViewProjectionMatrix);
+				Vector4 texCoord = Transform(TEX_COORDS[vertex], uvTransformMatrix);
+				maxError = std::fmax(maxError, std::fabs(position.x - vertices[vertex].position.x));
+				maxError = std::fmax(maxError, std::fabs(position.y - vertices[vertex].position.y));
+				maxError = std::fmax(maxError, std::fabs(position.z - vertices[vertex].position.z));
+				maxError = std::fmax(maxError, std::fabs(texCoord.x - vertices[vertex].texCoord.x));
+				maxError = std::fmax(maxError, std::fabs(texCoord.y - vertices[vertex].texCoord.y));
+			}
+		}
+		std::printf("  最大誤差 %g\n", maxError);
+		Check(maxError < 1.0e-4f, "行列で計算した頂点と一致", isValid);
+	}
+
+	/// <summary>
+	/// まとめ方の確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckGroups(bool& isValid) {
+		Elysia::SpriteBatchBuilder builder;
+
+		//重ならない同じテクスチャはまとまる
+		builder.Add(MakeQuad({ .x = 0.0f,.y = 0.0f }, { .x = 32.0f,.y = 32.0f }, 1u));
+		builder.Add(MakeQuad({ .x = 100.0f,.y = 0.0f }, { .x = 32.0f,.y = 32.0f }, 2u));
+		builder.Add(MakeQuad({ .x = 200.0f,.y = 0.0f }, { .x = 32.0f,.y = 32.0f }, 1u));
+		builder.Build(SCREEN_WIDTH_, SCREEN_HEIGHT_);
+		Check(builder.GetGroups().size() == 2u && builder.GetGroups()[0].quadCount == 2u, "重ならない同じテクスチャはまとまる", isValid);
+		//まとめた後の頂点が正しい位置に並んでいるか
+		Check(builder.GetVertices()[4].position.x > builder.GetVertices()[0].position.x && builder.GetVertices()[8].position.x < builder.GetVertices()[4].position.x,
+			"まとめた頂点の並び", isValid);
+
+		//間に重なるスプライトがあればまとめない
+		builder.Reset();
+		builder.Add(MakeQuad({ .x = 0.0f,.y = 0.0f }, { .x = 64.0f,.y = 64.0f }, 1u));
+		builder.Add(MakeQuad({ .x = 32.0f,.y = 32.0f }, { .x = 64.0f,.y = 64.0f }, 2u));
+		builder.Add(MakeQuad({ .x = 48.0f,.y = 48.0f }, { .x = 64.0f,.y = 64.0f }, 1u));
+		builder.Build(SCREEN_WIDTH_, SCREEN_HEIGHT_);
+		const std::vector<Elysia::SpriteBatchGroup>& groups = builder.GetGroups();
+		Check(groups.size() == 3u && groups[0].textureHandle == 1u && groups[1].textureHandle == 2u && groups[2].textureHandle == 1u,
+			"重なる時は描く順番を変えない", isValid);
+
+		//ブレンドモードが違えばまとめない
+		builder.Reset();
+		Elysia::SpriteQuad additive = MakeQuad({ .x = 100.0f,.y = 0.0f }, { .x = 32.0f,.y = 32.0f }, 1u);
+		additive.blendMode = 2u;
+		builder.Add(MakeQuad({ .x = 0.0f,.y = 0.0f }, { .x = 32.0f,.y = 32.0f }, 1u));
+		builder.Add(additive);
+		builder.Build(SCREEN_WIDTH_, SCREEN_HEIGHT_);
+		Check(builder.GetGroups().size() == 2u, "ブレンドモードが違えばまとめない", isValid);
+	}
+
+	/// <summary>
+	/// UIのような配置
+	/// 背景、HPのバー、鍵の一覧、説明の文字など
+	/// </summary>
+	/// <param name="builder">書き込み先</param>
+	void AddUserInterface(Elysia::SpriteBatchBuilder& builder) {
+		//背景と枠
+		builder.Add(MakeQuad({ .x = 0.0f,.y = 0.0f }, { .x = SCREEN_WIDTH_,.y = SCREEN_HEIGHT_ }, 1u));
+		//HPのバー
+		for (uint32_t i = 0u; i < 20u; ++i) {
+			builder.Add(MakeQuad({ .x = 20.0f + 24.0f * float(i),.y = 20.0f }, { .x = 20.0f,.y = 20.0f }, 2u));
+		}
+		//鍵の一覧
+		for (uint32_t i = 0u; i < 10u; ++i) {
+			builder.Add(MakeQuad({ .x = 20.0f + 40.0f * float(i),.y = 640.0f }, { .x = 36.0f,.y = 36.0f }, 3u));
+			builder.Add(MakeQuad({ .x = 24.0f + 40.0f * float(i),.y = 644.0f }, { .x = 28.0f,.y = 28.0f }, 4u));
+		}
+		//ゲージ
+		for (uint32_t i = 0u; i < 8u; ++i) {
+			builder.Add(MakeQuad({ .x = 1000.0f,.y = 100.0f + 60.0f * float(i) }, { .x = 200.0f,.y = 40.0f }, 5u));
+			builder.Add(MakeQuad({ .x = 1004.0f,.y = 104.0f + 60.0f * float(i) }, { .x = 192.0f,.y = 32.0f }, 6u));
+		}
+	}
+
+	/// <summary>
+	/// UIのような配置での描画回数と速さ
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Measure(bool& isValid) {
+		Elysia::SpriteBatchBuilder builder;
+		AddUserInterface(builder);
+		builder.Build(SCREEN_WIDTH_, SCREEN_HEIGHT_);
+		uint32_t quadCount = builder.GetQuadCount();
+		uint32_t drawCallCount = static_cast<uint32_t>(builder.GetGroups().size());
+		std::printf("  スプライト %u枚: 描画 %u回 (今まで %u回)\n", quadCount, drawCallCount, quadCount);
+		Check(drawCallCount * 4u < quadCount, "描画の回数が減る", isValid);
+
+		//1フレーム分を何度も作る
+		const uint32_t FRAME_COUNT = 10000u;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t frame = 0u; frame < FRAME_COUNT; ++frame) {
+			builder.Reset();
+			AddUserInterface(builder);
+			builder.Build(SCREEN_WIDTH_, SCREEN_HEIGHT_);
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		std::printf("  1フレーム: %.3f us\n", std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(FRAME_COUNT));
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("頂点\n");
+	CheckVertices(isValid);
+	std::printf("グループ\n");
+	CheckGroups(isValid);
+	std::printf("計測\n");
+	Measure(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
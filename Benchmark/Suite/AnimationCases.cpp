@@ -0,0 +1,130 @@
+/**
+ * @file AnimationCases.cpp
+ * @brief アニメーションの計測
+ * @author 茂木翼
+ */
+
+#include "BenchmarkSuite.h"
+
+#include <cmath>
+#include <random>
+#include <numbers>
+#include <memory>
+
+#include "Animation.h"
+#include "VectorCalculation.h"
+#include "Calculation/QuaternionCalculation.h"
+
+namespace {
+
+	//ジョイントの数(人型のモデルくらい)
+	const uint32_t JOINT_COUNT_ = 64u;
+	//1つのジョイントのキーフレームの数
+	const uint32_t KEY_FRAME_COUNT_ = 48u;
+	//アニメーションの尺(秒)
+	const float DURATION_ = 2.0f;
+	//1回の呼び出しで進める時間(60FPSの1フレーム)
+	const float DELTA_TIME_ = 1.0f / 60.0f;
+
+	/// <summary>
+	/// 計測に使うデータ
+	/// </summary>
+	struct AnimationData {
+		//スケルトン
+		Skeleton skeleton;
+		//アニメーション
+		Animation animation;
+		//アニメーションの時間
+		float animationTime;
+	};
+
+	/// <summary>
+	/// ノードを作る
+	/// 子を2つずつ持たせて、数がJOINT_COUNT_になるまで広げる
+	/// </summary>
+	/// <param name="node">ノード</param>
+	/// <param name="nodeCount">作ったノードの数</param>
+	/// <param name="depth">深さ</param>
+	void CreateNode(Node& node, uint32_t& nodeCount, const uint32_t& depth) {
+		node.name = "Joint" + std::to_string(nodeCount);
+		node.transform = {
+			.scale = {.x = 1.0f,.y = 1.0f,.z = 1.0f },
+			.rotate = QuaternionCalculation::IdentityQuaternion(),
+			.translate = {.x = 0.0f,.y = 0.25f,.z = 0.0f },
+		};
+		++nodeCount;
+
+		const uint32_t MAX_DEPTH = 6u;
+		if (depth >= MAX_DEPTH) {
+			return;
+		}
+		for (uint32_t i = 0u; i < 2u && nodeCount < JOINT_COUNT_; ++i) {
+			node.children.push_back({});
+			CreateNode(node.children.back(), nodeCount, depth + 1u);
+		}
+	}
+
+	/// <summary>
+	/// データを作る
+	/// </summary>
+	/// <returns>データ</returns>
+	std::shared_ptr<AnimationData> CreateAnimationData() {
+		std::shared_ptr<AnimationData> data = std::make_shared<AnimationData>();
+		Node rootNode = {};
+		uint32_t nodeCount = 0u;
+		CreateNode(rootNode, nodeCount, 0u);
+		data->skeleton.Create(rootNode);
+
+		//毎回同じデータにする
+		std::mt19937 randomEngine(2024u);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		data->animation.duration = DURATION_;
+		for (const Joint& joint : data->skeleton.joints) {
+			NodeAnimation& nodeAnimation = data->animation.nodeAnimations[joint.name];
+			for (uint32_t i = 0u; i < KEY_FRAME_COUNT_; ++i) {
+				float time = DURATION_ * float(i) / float(KEY_FRAME_COUNT_ - 1u);
+				Vector3 axis = VectorCalculation::Normalize({ .x = distribution(randomEngine),.y = distribution(randomEngine) + 2.0f,.z = distribution(randomEngine) });
+				nodeAnimation.translate.keyFrames.push_back({ .value = {.x = distribution(randomEngine),.y = 0.25f,.z = distribution(randomEngine) },.time = time });
+				nodeAnimation.rotate.keyFrames.push_back({ .value = QuaternionCalculation::MakeRotateAxisAngleQuaternion(axis, distribution(randomEngine)),.time = time });
+				nodeAnimation.scale.keyFrames.push_back({ .value = {.x = 1.0f,.y = 1.0f,.z = 1.0f },.time = time });
+			}
+		}
+		data->animationTime = 0.0f;
+		return data;
+	}
+
+	/// <summary>
+	/// スケルトンから確認用の値を作る
+	/// </summary>
+	/// <param name="skeleton">スケルトン</param>
+	/// <returns>値</returns>
+	double SumSkeleton(const Skeleton& skeleton) {
+		double sum = 0.0;
+		for (const Joint& joint : skeleton.joints) {
+			sum += double(joint.transform.translate.x + joint.skeletonSpaceMatrix.m[3][1]);
+		}
+		return sum;
+	}
+}
+
+void Elysia::RegisterAnimationCases(BenchmarkSuite& suite) {
+	std::shared_ptr<AnimationData> data = CreateAnimationData();
+
+	//キーフレームからの値の計算
+	//AnimationManager::ApplyAnimationもこれを呼んでいる
+	suite.Register("Animation.ApplyAnimation/" + std::to_string(JOINT_COUNT_), 1u, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			data->animationTime = std::fmodf(data->animationTime + DELTA_TIME_, DURATION_);
+			ApplyAnimation(data->skeleton, data->animation, data->animationTime);
+		}
+		return SumSkeleton(data->skeleton);
+	});
+
+	//ジョイントの行列の更新
+	suite.Register("Skeleton.Update/" + std::to_string(JOINT_COUNT_), 1u, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			data->skeleton.Update();
+		}
+		return SumSkeleton(data->skeleton);
+	});
+}
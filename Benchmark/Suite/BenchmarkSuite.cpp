@@ -0,0 +1,125 @@
+#include "BenchmarkSuite.h"
+
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+#include <json.hpp>
+
+namespace {
+	//最適化で処理が消されないように結果を書き込む先
+	volatile double sink = 0.0;
+	//回数の上限
+	const uint64_t MAX_ITERATION_COUNT_ = 1ull << 32u;
+}
+
+void Elysia::BenchmarkSuite::Register(const std::string& name, const uint64_t& operationCount, const std::function<double(const uint64_t&)>& function) {
+	cases_.push_back({ .name = name, .operationCount = operationCount, .function = function });
+}
+
+double Elysia::BenchmarkSuite::Measure(const BenchmarkCase& benchmarkCase, const uint64_t& iterationCount) {
+	auto start = std::chrono::steady_clock::now();
+	double checksum = benchmarkCase.function(iterationCount);
+	auto end = std::chrono::steady_clock::now();
+	sink = sink + checksum;
+	return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+std::vector<Elysia::BenchmarkResult> Elysia::BenchmarkSuite::Run(const BenchmarkOption& option) const {
+	std::vector<BenchmarkResult> results;
+	const double MIN_SAMPLE_NANOSECONDS = option.minSampleMilliseconds * 1.0e6;
+
+	for (const BenchmarkCase& benchmarkCase : cases_) {
+		if (option.filter.empty() == false && benchmarkCase.name.find(option.filter) == std::string::npos) {
+			continue;
+		}
+
+		//1回の計測が最低時間を超えるまで回数を倍にする
+		//1回目は準備(キャッシュなど)も兼ねる
+		uint64_t iterationCount = 1u;
+		while (Measure(benchmarkCase, iterationCount) < MIN_SAMPLE_NANOSECONDS && iterationCount < MAX_ITERATION_COUNT_) {
+			iterationCount *= 2u;
+		}
+
+		//計測
+		std::vector<double> samples;
+		samples.reserve(option.sampleCount);
+		const double OPERATION_COUNT = double(iterationCount * benchmarkCase.operationCount);
+		for (uint32_t i = 0u; i < option.sampleCount; ++i) {
+			samples.push_back(Measure(benchmarkCase, iterationCount) / OPERATION_COUNT);
+		}
+		std::sort(samples.begin(), samples.end());
+
+		results.push_back({
+			.name = benchmarkCase.name,
+			.medianNanoseconds = samples[samples.size() / 2u],
+			.minNanoseconds = samples.front(),
+			.iterationCount = iterationCount,
+		});
+	}
+
+	return results;
+}
+
+bool Elysia::BenchmarkSuite::WriteJson(const std::string& filePath, const std::vector<BenchmarkResult>& results) {
+	nlohmann::json root = nlohmann::json::object();
+	root["unit"] = "ns/op";
+	nlohmann::json& cases = root["cases"];
+	cases = nlohmann::json::object();
+	for (const BenchmarkResult& result : results) {
+		cases[result.name] = {
+			{ "median", result.medianNanoseconds },
+			{ "min", result.minNanoseconds },
+			{ "iterations", result.iterationCount },
+		};
+	}
+
+	std::ofstream file(filePath);
+	if (file.is_open() == false) {
+		return false;
+	}
+	file << root.dump(2) << "\n";
+	return file.good();
+}
+
+bool Elysia::BenchmarkSuite::ReadJson(const std::string& filePath, std::vector<BenchmarkResult>& baselines) {
+	std::ifstream file(filePath);
+	if (file.is_open() == false) {
+		return false;
+	}
+
+	//壊れていても止めずに読めなかったことにする
+	nlohmann::json root = nlohmann::json::parse(file, nullptr, false);
+	if (root.is_discarded() == true || root.contains("cases") == false || root["cases"].is_object() == false) {
+		return false;
+	}
+
+	for (const auto& [name, value] : root["cases"].items()) {
+		baselines.push_back({
+			.name = name,
+			.medianNanoseconds = value.value("median", 0.0),
+			.minNanoseconds = value.value("min", 0.0),
+			.iterationCount = value.value("iterations", uint64_t(0u)),
+		});
+	}
+	return true;
+}
+
+Elysia::BenchmarkComparison Elysia::BenchmarkSuite::Compare(const BenchmarkResult& result, const std::vector<BenchmarkResult>& baselines, const double& tolerance, double& ratio) {
+	ratio = 0.0;
+	auto it = std::find_if(baselines.begin(), baselines.end(), [&result](const BenchmarkResult& baseline) {
+		return baseline.name == result.name;
+	});
+	if (it == baselines.end() || it->minNanoseconds <= 0.0) {
+		return BenchmarkComparison::New;
+	}
+
+	ratio = result.minNanoseconds / it->minNanoseconds;
+	if (ratio > 1.0 + tolerance) {
+		return BenchmarkComparison::Slower;
+	}
+	//速くなった方も同じ幅で知らせて、基準を更新するきっかけにする
+	if (ratio < 1.0 / (1.0 + tolerance)) {
+		return BenchmarkComparison::Faster;
+	}
+	return BenchmarkComparison::Same;
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file BenchmarkSuite.h
+ * @brief エンジンの処理をまとめて計測し、基準と比べるクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 計測する処理
+	/// </summary>
+	struct BenchmarkCase {
+		//名前(「Matrix4x4.Multiply」のようにする)
+		std::string name;
+		//1回の呼び出しで何個処理するか
+		uint64_t operationCount;
+		//指定回数だけ処理して、最適化で消されないように結果から作った値を返す
+		std::function<double(const uint64_t& iterationCount)> function;
+	};
+
+	/// <summary>
+	/// 計測の結果
+	/// </summary>
+	struct BenchmarkResult {
+		//名前
+		std::string name;
+		//1個あたりの時間(ナノ秒)の中央値
+		double medianNanoseconds;
+		//1個あたりの時間(ナノ秒)の最小値
+		double minNanoseconds;
+		//1回の計測で呼んだ回数
+		uint64_t iterationCount;
+	};
+
+	/// <summary>
+	/// 基準と比べた結果
+	/// </summary>
+	enum class BenchmarkComparison {
+		//基準に無い
+		New,
+		//許容の範囲内
+		Same,
+		//速くなった
+		Faster,
+		//遅くなった
+		Slower,
+	};
+
+	/// <summary>
+	/// 実行の設定
+	/// </summary>
+	struct BenchmarkOption {
+		//名前にこの文字列を含むものだけ計測する(空なら全部)
+		std::string filter;
+		//1回の計測の最低時間(ミリ秒)
+		double minSampleMilliseconds;
+		//計測する回数
+		uint32_t sampleCount;
+	};
+
+	/// <summary>
+	/// エンジンの処理をまとめて計測し、基準と比べるクラス
+	/// 回数は1回の計測が最低時間を超えるまで倍にして決め、複数回計測した中央値と最小値を出す
+	/// </summary>
+	class BenchmarkSuite final {
+	public:
+		//通常の1回の計測の最低時間(ミリ秒)
+		static constexpr double DEFAULT_MIN_SAMPLE_MILLISECONDS_ = 20.0;
+		//通常の計測する回数
+		static const uint32_t DEFAULT_SAMPLE_COUNT_ = 7u;
+		//速く済ませる時の1回の計測の最低時間(ミリ秒)
+		static constexpr double QUICK_MIN_SAMPLE_MILLISECONDS_ = 2.0;
+		//速く済ませる時の計測する回数
+		static const uint32_t QUICK_SAMPLE_COUNT_ = 3u;
+
+	public:
+		/// <summary>
+		/// 登録
+		/// </summary>
+		/// <param name="name">名前</param>
+		/// <param name="operationCount">1回の呼び出しで何個処理するか</param>
+		/// <param name="function">処理</param>
+		void Register(const std::string& name, const uint64_t& operationCount, const std::function<double(const uint64_t&)>& function);
+
+		/// <summary>
+		/// 計測
+		/// </summary>
+		/// <param name="option">設定</param>
+		/// <returns>結果</returns>
+		std::vector<BenchmarkResult> Run(const BenchmarkOption& option) const;
+
+		/// <summary>
+		/// 結果をJSONで書き出す
+		/// </summary>
+		/// <param name="filePath">保存先</param>
+		/// <param name="results">結果</param>
+		/// <returns>書けたかどうか</returns>
+		static bool WriteJson(const std::string& filePath, const std::vector<BenchmarkResult>& results);
+
+		/// <summary>
+		/// JSONから基準を読み込む
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <param name="baselines">基準</param>
+		/// <returns>読めたかどうか</returns>
+		static bool ReadJson(const std::string& filePath, std::vector<BenchmarkResult>& baselines);
+
+		/// <summary>
+		/// 基準と比べる
+		/// 計測のぶれが少ない最小値で比べる
+		/// </summary>
+		/// <param name="result">結果</param>
+		/// <param name="baselines">基準</param>
+		/// <param name="tolerance">許容する割合(0.3なら30%遅くなるまで許す)</param>
+		/// <param name="ratio">基準に対する割合</param>
+		/// <returns>比べた結果</returns>
+		static BenchmarkComparison Compare(const BenchmarkResult& result, const std::vector<BenchmarkResult>& baselines, const double& tolerance, double& ratio);
+
+	public:
+		/// <summary>
+		/// 登録した処理を取得
+		/// </summary>
+		/// <returns>処理</returns>
+		inline const std::vector<BenchmarkCase>& GetCases() const {
+			return cases_;
+		}
+
+	private:
+		/// <summary>
+		/// 1回計測する
+		/// </summary>
+		/// <param name="benchmarkCase">処理</param>
+		/// <param name="iterationCount">回数</param>
+		/// <returns>時間(ナノ秒)</returns>
+		static double Measure(const BenchmarkCase& benchmarkCase, const uint64_t& iterationCount);
+
+	private:
+		//登録した処理
+		std::vector<BenchmarkCase> cases_;
+
+	};
+
+	/// <summary>
+	/// 行列とクォータニオンの計算を登録
+	/// </summary>
+	/// <param name="suite">登録先</param>
+	void RegisterMathCases(BenchmarkSuite& suite);
+
+	/// <summary>
+	/// 当たり判定と押し戻しを登録
+	/// </summary>
+	/// <param name="suite">登録先</param>
+	void RegisterCollisionCases(BenchmarkSuite& suite);
+
+	/// <summary>
+	/// アニメーションを登録
+	/// </summary>
+	/// <param name="suite">登録先</param>
+	void RegisterAnimationCases(BenchmarkSuite& suite);
+
+	/// <summary>
+	/// パーティクルを登録
+	/// </summary>
+	/// <param name="suite">登録先</param>
+	void RegisterParticleCases(BenchmarkSuite& suite);
+
+	/// <summary>
+	/// レベルデータの読み込みを登録
+	/// </summary>
+	/// <param name="suite">登録先</param>
+	void RegisterLevelDataCases(BenchmarkSuite& suite);
+
+}
@@ -0,0 +1,258 @@
+/**
+ * @file CollisionCases.cpp
+ * @brief 当たり判定と押し戻しの計測
+ * @author 茂木翼
+ */
+
+#include "BenchmarkSuite.h"
+
+#include <random>
+#include <numbers>
+#include <memory>
+
+#include "CollisionManager.h"
+#include "CollisionCalculation.h"
+#include "PushBackCalculation.h"
+#include "VectorCalculation.h"
+
+namespace {
+
+	//1回の呼び出しで処理する数
+	const uint32_t DATA_COUNT_ = 256u;
+	//総当たりで計測するコライダーの数
+	const uint32_t COLLIDER_COUNTS_[] = { 16u, 64u, 256u };
+	//配置する範囲
+	const float FIELD_SIZE_ = 40.0f;
+
+	/// <summary>
+	/// 計測用のコライダー
+	/// 当たった回数を数えるだけ
+	/// </summary>
+	class BenchmarkCollider : public Collider {
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="collisionType">当たり判定の種類</param>
+		/// <param name="position">座標</param>
+		void Initialize(const uint32_t& collisionType, const Vector3& position) {
+			collisionType_ = collisionType;
+			position_ = position;
+			radius_ = 1.5f;
+			aabb_ = {
+				.min = {.x = position.x - 1.0f,.y = position.y - 1.0f,.z = position.z - 1.0f },
+				.max = {.x = position.x + 1.0f,.y = position.y + 1.0f,.z = position.z + 1.0f },
+			};
+			const float CENTER_RADIAN = std::atan2f(position.z, position.x);
+			fan3D_ = {
+				.position = position,
+				.length = 10.0f,
+				.sideThetaAngle = std::numbers::pi_v<float> / 6.0f,
+				.sidePhiAngleSize = 0.0f,
+				.direction = {.x = std::cosf(CENTER_RADIAN),.y = 0.0f,.z = std::sinf(CENTER_RADIAN) },
+				.rightVector = {},
+				.leftVector = {},
+				.centerRadian = CENTER_RADIAN,
+				.centerPhi = 0.0f,
+			};
+			plane_ = { .position = position,.length = 8.0f,.width = 8.0f };
+		}
+
+		/// <summary>
+		/// 接触
+		/// </summary>
+		void OnCollision() override {
+			++hitCount_;
+		}
+
+		/// <summary>
+		/// 非接触
+		/// </summary>
+		void OffCollision() override {
+		}
+
+		/// <summary>
+		/// ワールド座標を取得
+		/// </summary>
+		/// <returns>ワールド座標</returns>
+		Vector3 GetWorldPosition() override {
+			return position_;
+		}
+
+		/// <summary>
+		/// 当たった回数を取得
+		/// </summary>
+		/// <returns>回数</returns>
+		inline uint64_t GetHitCount() const {
+			return hitCount_;
+		}
+
+	private:
+		//座標
+		Vector3 position_ = {};
+		//当たった回数
+		uint64_t hitCount_ = 0u;
+	};
+
+	/// <summary>
+	/// 計測に使うデータ
+	/// </summary>
+	struct CollisionData {
+		//AABB
+		std::vector<AABB> aabbs;
+		//点
+		std::vector<Vector3> points;
+		//平面
+		std::vector<Plane> planes;
+		//扇
+		std::vector<Fan3D> fans;
+		//AABBの中心
+		std::vector<Vector3> centers;
+		//押し戻す相手(原点付近に集めて重なりやすくする)
+		std::vector<AABB> pushTargets;
+	};
+
+	/// <summary>
+	/// 範囲内の座標を作る
+	/// </summary>
+	/// <param name="randomEngine">ランダムエンジン</param>
+	/// <returns>座標</returns>
+	Vector3 RandomPosition(std::mt19937& randomEngine) {
+		std::uniform_real_distribution<float> distribution(-FIELD_SIZE_ / 2.0f, FIELD_SIZE_ / 2.0f);
+		return { .x = distribution(randomEngine),.y = distribution(randomEngine) / 8.0f,.z = distribution(randomEngine) };
+	}
+
+	/// <summary>
+	/// データを作る
+	/// </summary>
+	/// <returns>データ</returns>
+	std::shared_ptr<CollisionData> CreateCollisionData() {
+		std::shared_ptr<CollisionData> data = std::make_shared<CollisionData>();
+		//毎回同じデータにする
+		std::mt19937 randomEngine(2024u);
+		for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+			BenchmarkCollider collider = {};
+			collider.Initialize(ColliderType::AABBType, RandomPosition(randomEngine));
+			data->aabbs.push_back(collider.GetAABB());
+			data->planes.push_back(collider.GetPlane());
+			data->fans.push_back(collider.GetFan3D());
+			data->points.push_back(RandomPosition(randomEngine));
+			data->centers.push_back(collider.GetWorldPosition());
+
+			//範囲の広いAABBにして半分くらいが重なるようにする
+			Vector3 targetPosition = VectorCalculation::Multiply(RandomPosition(randomEngine), 0.5f);
+			data->pushTargets.push_back({
+				.min = VectorCalculation::Subtract(targetPosition, { .x = 8.0f,.y = 8.0f,.z = 8.0f }),
+				.max = VectorCalculation::Add(targetPosition, { .x = 8.0f,.y = 8.0f,.z = 8.0f }),
+			});
+		}
+		return data;
+	}
+
+	/// <summary>
+	/// 総当たりの計測を登録
+	/// </summary>
+	/// <param name="suite">登録先</param>
+	/// <param name="colliderCount">コライダーの数</param>
+	void RegisterCheckAllCollision(Elysia::BenchmarkSuite& suite, const uint32_t& colliderCount) {
+		//球、AABB、点、扇、平面を順番に混ぜる
+		const uint32_t COLLIDER_TYPES[] = {
+			ColliderType::SphereType,
+			ColliderType::AABBType,
+			ColliderType::PointType,
+			ColliderType::FanType,
+			ColliderType::PlaneType,
+		};
+		std::shared_ptr<std::vector<BenchmarkCollider>> colliders = std::make_shared<std::vector<BenchmarkCollider>>(colliderCount);
+		std::mt19937 randomEngine(colliderCount);
+		for (uint32_t i = 0u; i < colliderCount; ++i) {
+			(*colliders)[i].Initialize(COLLIDER_TYPES[i % std::size(COLLIDER_TYPES)], RandomPosition(randomEngine));
+		}
+
+		std::shared_ptr<Elysia::CollisionManager> collisionManager = std::make_shared<Elysia::CollisionManager>();
+		for (BenchmarkCollider& collider : *colliders) {
+			collisionManager->RegisterList(&collider);
+		}
+
+		//ゲームと同じく1フレームで1回呼ぶので1回を1個とする
+		suite.Register("CollisionManager.CheckAllCollision/" + std::to_string(colliderCount), 1u, [colliders, collisionManager](const uint64_t& iterationCount) {
+			for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+				collisionManager->CheckAllCollision();
+			}
+			uint64_t hitCount = 0u;
+			for (const BenchmarkCollider& collider : *colliders) {
+				hitCount += collider.GetHitCount();
+			}
+			return double(hitCount);
+		});
+	}
+}
+
+void Elysia::RegisterCollisionCases(BenchmarkSuite& suite) {
+	std::shared_ptr<CollisionData> data = CreateCollisionData();
+
+	//AABB同士
+	suite.Register("CollisionCalculation.IsCollisionAABBPair", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		uint64_t hitCount = 0u;
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				hitCount += CollisionCalculation::IsCollisionAABBPair(data->aabbs[i], data->aabbs[(i + iteration + 1u) % DATA_COUNT_]);
+			}
+		}
+		return double(hitCount);
+	});
+
+	//AABBと点
+	suite.Register("CollisionCalculation.IsCollisionAABBAndPoint", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		uint64_t hitCount = 0u;
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				hitCount += CollisionCalculation::IsCollisionAABBAndPoint(data->aabbs[i], data->points[(i + iteration) % DATA_COUNT_]);
+			}
+		}
+		return double(hitCount);
+	});
+
+	//平面と点
+	suite.Register("CollisionCalculation.IsCollisionPlaneAndPoint", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		uint64_t hitCount = 0u;
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				hitCount += CollisionCalculation::IsCollisionPlaneAndPoint(data->points[(i + iteration) % DATA_COUNT_], data->planes[i]);
+			}
+		}
+		return double(hitCount);
+	});
+
+	//扇と点
+	suite.Register("CollisionCalculation.IsFanCollision", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		uint64_t hitCount = 0u;
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				hitCount += CollisionCalculation::IsFanCollision(data->fans[i], data->points[(i + iteration) % DATA_COUNT_]);
+			}
+		}
+		return double(hitCount);
+	});
+
+	//押し戻し
+	//書き換わるので毎回元のデータから始める
+	suite.Register("PushBackCalculation.FixPosition", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		double sum = 0.0;
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				AABB mainAABB = data->aabbs[i];
+				Vector3 centerPosition = data->centers[i];
+				const AABB& targetAABB = data->pushTargets[(i + iteration) % DATA_COUNT_];
+				PushBackCalculation::FixPosition(centerPosition, mainAABB, targetAABB);
+				sum += double(centerPosition.x + centerPosition.y + centerPosition.z);
+			}
+		}
+		return sum;
+	});
+
+	//総当たり
+	for (const uint32_t& colliderCount : COLLIDER_COUNTS_) {
+		RegisterCheckAllCollision(suite, colliderCount);
+	}
+}
@@ -0,0 +1,130 @@
+/**
+ * @file EngineBenchmark.cpp
+ * @brief エンジンのCPU側の処理をまとめて計測し、基準と比べる
+ * @author 茂木翼
+ *
+ * 使い方
+ * EngineBenchmark [--quick] [--filter 文字列] [--json 保存先] [--baseline 基準] [--tolerance 割合]
+ * --json     結果を機械で読めるJSONで書き出す(基準の更新にも使う)
+ * --baseline 基準と比べて、許容より遅くなった物があれば1を返す
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BenchmarkSuite.h"
+
+namespace {
+
+	//既定の許容する割合
+	//計測する機械の揺れを考えて広めにしておく
+	const double DEFAULT_TOLERANCE_ = 0.3;
+
+	/// <summary>
+	/// 比べた結果の表示名
+	/// </summary>
+	/// <param name="comparison">比べた結果</param>
+	/// <returns>表示名</returns>
+	const char* GetComparisonName(const Elysia::BenchmarkComparison& comparison) {
+		switch (comparison) {
+		case Elysia::BenchmarkComparison::New:
+			return "新規";
+		case Elysia::BenchmarkComparison::Faster:
+			return "速くなった";
+		case Elysia::BenchmarkComparison::Slower:
+			return "遅くなった";
+		default:
+			return "OK";
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	//引数
+	Elysia::BenchmarkOption option = {
+		.filter = "",
+		.minSampleMilliseconds = Elysia::BenchmarkSuite::DEFAULT_MIN_SAMPLE_MILLISECONDS_,
+		.sampleCount = Elysia::BenchmarkSuite::DEFAULT_SAMPLE_COUNT_,
+	};
+	std::string jsonFilePath;
+	std::string baselineFilePath;
+	double tolerance = DEFAULT_TOLERANCE_;
+	for (int i = 1; i < argc; ++i) {
+		const bool IS_HAVING_VALUE = (i + 1 < argc);
+		if (std::strcmp(argv[i], "--quick") == 0) {
+			option.minSampleMilliseconds = Elysia::BenchmarkSuite::QUICK_MIN_SAMPLE_MILLISECONDS_;
+			option.sampleCount = Elysia::BenchmarkSuite::QUICK_SAMPLE_COUNT_;
+		}
+		else if (std::strcmp(argv[i], "--filter") == 0 && IS_HAVING_VALUE == true) {
+			option.filter = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--json") == 0 && IS_HAVING_VALUE == true) {
+			jsonFilePath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--baseline") == 0 && IS_HAVING_VALUE == true) {
+			baselineFilePath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--tolerance") == 0 && IS_HAVING_VALUE == true) {
+			tolerance = std::atof(argv[++i]);
+		}
+		else {
+			std::printf("不明な引数です: %s\n", argv[i]);
+			return 2;
+		}
+	}
+
+	//登録
+	Elysia::BenchmarkSuite suite;
+	Elysia::RegisterMathCases(suite);
+	Elysia::RegisterCollisionCases(suite);
+	Elysia::RegisterAnimationCases(suite);
+	Elysia::RegisterParticleCases(suite);
+	Elysia::RegisterLevelDataCases(suite);
+
+	//基準
+	std::vector<Elysia::BenchmarkResult> baselines;
+	if (baselineFilePath.empty() == false && Elysia::BenchmarkSuite::ReadJson(baselineFilePath, baselines) == false) {
+		std::printf("基準を読み込めませんでした: %s\n", baselineFilePath.c_str());
+		return 2;
+	}
+
+	//計測
+	std::printf("エンジンのベンチマーク(1個あたりのナノ秒)\n");
+	std::vector<Elysia::BenchmarkResult> results = suite.Run(option);
+	uint32_t slowerCount = 0u;
+	for (const Elysia::BenchmarkResult& result : results) {
+		std::printf("  %-48s 中央値 %12.2f  最小 %12.2f", result.name.c_str(), result.medianNanoseconds, result.minNanoseconds);
+		if (baselines.empty() == false) {
+			double ratio = 0.0;
+			Elysia::BenchmarkComparison comparison = Elysia::BenchmarkSuite::Compare(result, baselines, tolerance, ratio);
+			if (comparison == Elysia::BenchmarkComparison::Slower) {
+				++slowerCount;
+			}
+			if (comparison == Elysia::BenchmarkComparison::New) {
+				std::printf("  %s", GetComparisonName(comparison));
+			}
+			else {
+				std::printf("  x%.2f %s", ratio, GetComparisonName(comparison));
+			}
+		}
+		std::printf("\n");
+	}
+
+	//書き出し
+	if (jsonFilePath.empty() == false) {
+		if (Elysia::BenchmarkSuite::WriteJson(jsonFilePath, results) == false) {
+			std::printf("結果を書き出せませんでした: %s\n", jsonFilePath.c_str());
+			return 2;
+		}
+		std::printf("結果を書き出しました: %s\n", jsonFilePath.c_str());
+	}
+
+	if (slowerCount > 0u) {
+		std::printf("許容(%.0f%%)より遅くなった物が%u個あります\n", tolerance * 100.0, slowerCount);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file LevelDataCases.cpp
+ * @brief レベルデータ読み込みの計測
+ * @author 茂木翼
+ */
+
+#include "BenchmarkSuite.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "LevelDataParser.h"
+
+void Elysia::RegisterLevelDataCases(BenchmarkSuite& suite) {
+	//Resources/LevelData/*/*.json
+	const std::string LEVEL_DATA_DIRECTORY = std::string(ELYSIA_RESOURCES_DIRECTORY) + "LevelData/";
+	std::vector<std::string> filePaths;
+	if (std::filesystem::exists(LEVEL_DATA_DIRECTORY) == false) {
+		return;
+	}
+	for (const auto& folder : std::filesystem::directory_iterator(LEVEL_DATA_DIRECTORY)) {
+		if (folder.is_directory() == false) {
+			continue;
+		}
+		for (const auto& file : std::filesystem::directory_iterator(folder.path())) {
+			if (file.path().extension() == ".json") {
+				filePaths.push_back(file.path().string());
+			}
+		}
+	}
+	//ディレクトリの順番に依らないようにする
+	std::sort(filePaths.begin(), filePaths.end());
+
+	//全部のファイルを読んで1回とする
+	//実際に使っているSAXと、比較用のDOMの両方
+	suite.Register("LevelDataParser.ParseWithSax", 1u, [filePaths](const uint64_t& iterationCount) {
+		size_t objectCount = 0u;
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (const std::string& filePath : filePaths) {
+				Elysia::StringInterner stringInterner;
+				std::vector<Elysia::LevelObjectData> objectDatas;
+				LevelDataParser::ParseWithSax(filePath, objectDatas, stringInterner);
+				objectCount += objectDatas.size();
+			}
+		}
+		return double(objectCount);
+	});
+
+	suite.Register("LevelDataParser.ParseWithDom", 1u, [filePaths](const uint64_t& iterationCount) {
+		size_t objectCount = 0u;
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (const std::string& filePath : filePaths) {
+				Elysia::StringInterner stringInterner;
+				std::vector<Elysia::LevelObjectData> objectDatas;
+				LevelDataParser::ParseWithDom(filePath, objectDatas, stringInterner);
+				objectCount += objectDatas.size();
+			}
+		}
+		return double(objectCount);
+	});
+}
@@ -0,0 +1,193 @@
+/**
+ * @file MathCases.cpp
+ * @brief 行列とクォータニオンの計算、配列をまとめた計算の計測
+ * @author 茂木翼
+ */
+
+#include "BenchmarkSuite.h"
+
+#include <random>
+#include <numbers>
+#include <memory>
+
+#include "VectorCalculation.h"
+#include "Matrix4x4Calculation.h"
+#include "BatchCalculation.h"
+#include "Calculation/QuaternionCalculation.h"
+
+namespace {
+
+	//1回の呼び出しで処理する数
+	const uint32_t DATA_COUNT_ = 256u;
+
+	/// <summary>
+	/// 計測に使うデータ
+	/// </summary>
+	struct MathData {
+		//スケール
+		std::vector<Vector3> scales;
+		//回転(オイラー角)
+		std::vector<Vector3> rotates;
+		//座標
+		std::vector<Vector3> translates;
+		//アフィン行列
+		std::vector<Matrix4x4> matrices;
+		//クォータニオン
+		std::vector<Quaternion> quaternions;
+		//頂点
+		std::vector<Vector3> points;
+		//書き込み先
+		std::vector<Matrix4x4> outputMatrices;
+		std::vector<Vector3> outputPoints;
+		std::vector<Quaternion> outputQuaternions;
+	};
+
+	/// <summary>
+	/// データを作る
+	/// </summary>
+	/// <returns>データ</returns>
+	std::shared_ptr<MathData> CreateMathData() {
+		std::shared_ptr<MathData> data = std::make_shared<MathData>();
+		//毎回同じデータにする
+		std::mt19937 randomEngine(2024u);
+		std::uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+		std::uniform_real_distribution<float> angleDistribution(-std::numbers::pi_v<float>, std::numbers::pi_v<float>);
+		std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> axisDistribution(-1.0f, 1.0f);
+
+		for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+			Vector3 scale = { .x = scaleDistribution(randomEngine),.y = scaleDistribution(randomEngine),.z = scaleDistribution(randomEngine) };
+			Vector3 rotate = { .x = angleDistribution(randomEngine),.y = angleDistribution(randomEngine),.z = angleDistribution(randomEngine) };
+			Vector3 translate = { .x = positionDistribution(randomEngine),.y = positionDistribution(randomEngine),.z = positionDistribution(randomEngine) };
+			data->scales.push_back(scale);
+			data->rotates.push_back(rotate);
+			data->translates.push_back(translate);
+			data->matrices.push_back(Matrix4x4Calculation::MakeAffineMatrix(scale, rotate, translate));
+
+			Vector3 axis = { .x = axisDistribution(randomEngine),.y = axisDistribution(randomEngine),.z = axisDistribution(randomEngine) + 2.0f };
+			axis = VectorCalculation::Normalize(axis);
+			data->quaternions.push_back(QuaternionCalculation::MakeRotateAxisAngleQuaternion(axis, angleDistribution(randomEngine)));
+			data->points.push_back({ .x = positionDistribution(randomEngine),.y = positionDistribution(randomEngine),.z = positionDistribution(randomEngine) });
+		}
+		data->outputMatrices.resize(DATA_COUNT_);
+		data->outputPoints.resize(DATA_COUNT_);
+		data->outputQuaternions.resize(DATA_COUNT_);
+		return data;
+	}
+
+	/// <summary>
+	/// 行列の結果から確認用の値を作る
+	/// </summary>
+	/// <param name="matrices">行列</param>
+	/// <returns>値</returns>
+	double SumMatrices(const std::vector<Matrix4x4>& matrices) {
+		double sum = 0.0;
+		for (const Matrix4x4& matrix : matrices) {
+			sum += double(matrix.m[0][0] + matrix.m[1][1] + matrix.m[2][2] + matrix.m[3][0]);
+		}
+		return sum;
+	}
+}
+
+void Elysia::RegisterMathCases(BenchmarkSuite& suite) {
+	std::shared_ptr<MathData> data = CreateMathData();
+
+	//行列の積
+	suite.Register("Matrix4x4.Multiply", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				data->outputMatrices[i] = Matrix4x4Calculation::Multiply(data->matrices[i], data->matrices[(i + 1u) % DATA_COUNT_]);
+			}
+		}
+		return SumMatrices(data->outputMatrices);
+	});
+
+	//逆行列
+	suite.Register("Matrix4x4.Inverse", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				data->outputMatrices[i] = Matrix4x4Calculation::Inverse(data->matrices[i]);
+			}
+		}
+		return SumMatrices(data->outputMatrices);
+	});
+
+	//アフィン行列の逆行列
+	suite.Register("Matrix4x4.InverseAffine", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				data->outputMatrices[i] = Matrix4x4Calculation::InverseAffine(data->matrices[i]);
+			}
+		}
+		return SumMatrices(data->outputMatrices);
+	});
+
+	//アフィン行列
+	suite.Register("Matrix4x4.MakeAffineMatrix", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				data->outputMatrices[i] = Matrix4x4Calculation::MakeAffineMatrix(data->scales[i], data->rotates[i], data->translates[i]);
+			}
+		}
+		return SumMatrices(data->outputMatrices);
+	});
+
+	//クォータニオンからアフィン行列
+	suite.Register("Matrix4x4.MakeQuaternionAffineMatrix", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				data->outputMatrices[i] = Matrix4x4Calculation::MakeQuaternionAffineMatrix(data->scales[i], data->quaternions[i], data->translates[i]);
+			}
+		}
+		return SumMatrices(data->outputMatrices);
+	});
+
+	//球面線形補間
+	suite.Register("Quaternion.Slerp", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			//補間の割合も少しずつ変える
+			float t = float(iteration % 16u) / 16.0f;
+			for (uint32_t i = 0u; i < DATA_COUNT_; ++i) {
+				data->outputQuaternions[i] = QuaternionCalculation::QuaternionSlerp(data->quaternions[i], data->quaternions[(i + 1u) % DATA_COUNT_], t);
+			}
+		}
+		double sum = 0.0;
+		for (const Quaternion& quaternion : data->outputQuaternions) {
+			sum += double(quaternion.w);
+		}
+		return sum;
+	});
+
+	//配列をまとめた計算
+	suite.Register("Batch.TransformPoints", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			BatchCalculation::TransformPoints(data->points, data->matrices[iteration % DATA_COUNT_], data->outputPoints);
+		}
+		double sum = 0.0;
+		for (const Vector3& point : data->outputPoints) {
+			sum += double(point.x);
+		}
+		return sum;
+	});
+
+	suite.Register("Batch.MultiplyMany", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			BatchCalculation::MultiplyMany(data->matrices, data->matrices[iteration % DATA_COUNT_], data->outputMatrices);
+		}
+		return SumMatrices(data->outputMatrices);
+	});
+
+	suite.Register("Batch.MakeAffineMany", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			BatchCalculation::MakeAffineMany(data->scales, data->rotates, data->translates, data->outputMatrices);
+		}
+		return SumMatrices(data->outputMatrices);
+	});
+
+	suite.Register("Batch.MakeQuaternionAffineMany", DATA_COUNT_, [data](const uint64_t& iterationCount) {
+		for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+			BatchCalculation::MakeQuaternionAffineMany(data->scales, data->quaternions, data->translates, data->outputMatrices);
+		}
+		return SumMatrices(data->outputMatrices);
+	});
+}
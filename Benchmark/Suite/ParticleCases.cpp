@@ -0,0 +1,129 @@
+/**
+ * @file ParticleCases.cpp
+ * @brief パーティクルの計測
+ * @author 茂木翼
+ */
+
+#include "BenchmarkSuite.h"
+
+#include <list>
+#include <random>
+#include <numbers>
+#include <memory>
+
+#include "Particle.h"
+#include "Matrix4x4Calculation.h"
+
+namespace {
+
+	//パーティクルの数
+	const uint32_t PARTICLE_COUNTS_[] = { 256u, 4096u };
+	//1回の呼び出しで進める時間(60FPSの1フレーム)
+	const float DELTA_TIME_ = 1.0f / 60.0f;
+
+	/// <summary>
+	/// 計測に使うデータ
+	/// Particle3DはD3D12のリソースを持っているので、計算に使う物だけを同じ形で持つ
+	/// </summary>
+	struct ParticleData {
+		//パーティクル
+		std::list<ParticleInformation> particles;
+		//GPUに送るデータ
+		std::vector<ParticleForGPU> particleForGpuData;
+		//カメラのワールド行列
+		Matrix4x4 cameraWorldMatrix;
+		//描画する数
+		uint32_t numInstance;
+	};
+
+	/// <summary>
+	/// データを作る
+	/// </summary>
+	/// <param name="particleCount">パーティクルの数</param>
+	/// <returns>データ</returns>
+	std::shared_ptr<ParticleData> CreateParticleData(const uint32_t& particleCount) {
+		std::shared_ptr<ParticleData> data = std::make_shared<ParticleData>();
+		//毎回同じデータにする
+		std::mt19937 randomEngine(particleCount);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> timeDistribution(1.0f, 3.0f);
+		for (uint32_t i = 0u; i < particleCount; ++i) {
+			Vector3 translate = { .x = distribution(randomEngine),.y = distribution(randomEngine),.z = distribution(randomEngine) };
+			Transform transform = { .scale = {.x = 1.0f,.y = 1.0f,.z = 1.0f },.rotate = {},.translate = translate };
+			data->particles.push_back({
+				.transform = transform,
+				.initialTransform = transform,
+				.velocity = {.x = distribution(randomEngine),.y = distribution(randomEngine),.z = distribution(randomEngine) },
+				.color = {.x = 1.0f,.y = 1.0f,.z = 1.0f,.w = 1.0f },
+				.lifeTime = timeDistribution(randomEngine),
+				.currentTime = 0.0f,
+				.isInvisible = false,
+				.absorbT = 0.0f,
+			});
+		}
+		data->particleForGpuData.resize(particleCount);
+		data->cameraWorldMatrix = Matrix4x4Calculation::MakeAffineMatrix({ .x = 1.0f,.y = 1.0f,.z = 1.0f }, { .x = 0.2f,.y = 0.5f,.z = 0.0f }, { .x = 0.0f,.y = 5.0f,.z = -20.0f });
+		data->numInstance = 0u;
+		return data;
+	}
+
+	/// <summary>
+	/// 更新
+	/// Particle3D::Updateの通常の放出(NormalRelease)と同じ計算
+	/// 寿命が来たら最初からやり直して数を保つ
+	/// </summary>
+	/// <param name="data">データ</param>
+	void UpdateParticle(ParticleData& data) {
+		data.numInstance = 0u;
+		for (ParticleInformation& particle : data.particles) {
+			particle.currentTime += DELTA_TIME_;
+			if (particle.lifeTime <= particle.currentTime) {
+				particle.currentTime = 0.0f;
+				particle.transform = particle.initialTransform;
+				continue;
+			}
+
+			particle.transform.translate.y += 0.0001f;
+
+			//Y軸でπ/2回転
+			Matrix4x4 backToFrontMatrix = Matrix4x4Calculation::MakeRotateYMatrix(std::numbers::pi_v<float>);
+			//カメラの回転を適用する
+			Matrix4x4 billBoardMatrix = Matrix4x4Calculation::Multiply(backToFrontMatrix, data.cameraWorldMatrix);
+			//平行成分はいらない
+			billBoardMatrix.m[3][0] = 0.0f;
+			billBoardMatrix.m[3][1] = 0.0f;
+			billBoardMatrix.m[3][2] = 0.0f;
+
+			Matrix4x4 scaleMatrix = Matrix4x4Calculation::MakeScaleMatrix(particle.transform.scale);
+			Matrix4x4 translateMatrix = Matrix4x4Calculation::MakeTranslateMatrix(particle.transform.translate);
+			Matrix4x4 worldMatrix = Matrix4x4Calculation::Multiply(scaleMatrix, Matrix4x4Calculation::Multiply(billBoardMatrix, translateMatrix));
+
+			//ワールド行列と色のデータを設定
+			ParticleForGPU& particleForGpu = data.particleForGpuData[data.numInstance];
+			particleForGpu.world = worldMatrix;
+			particleForGpu.color = { .x = 1.0f,.y = 1.0f,.z = 1.0f,.w = 1.0f };
+			//透明になっていく
+			float alpha = 1.0f - (particle.currentTime / particle.lifeTime);
+			particleForGpu.color.w = alpha;
+			particle.color = particleForGpu.color;
+
+			++data.numInstance;
+		}
+	}
+}
+
+void Elysia::RegisterParticleCases(BenchmarkSuite& suite) {
+	for (const uint32_t& particleCount : PARTICLE_COUNTS_) {
+		std::shared_ptr<ParticleData> data = CreateParticleData(particleCount);
+		suite.Register("Particle3D.Update/" + std::to_string(particleCount), particleCount, [data](const uint64_t& iterationCount) {
+			for (uint64_t iteration = 0u; iteration < iterationCount; ++iteration) {
+				UpdateParticle(*data);
+			}
+			double sum = double(data->numInstance);
+			for (uint32_t i = 0u; i < data->numInstance; ++i) {
+				sum += double(data->particleForGpuData[i].world.m[3][1]);
+			}
+			return sum;
+		});
+	}
+}
@@ -0,0 +1,374 @@
+/**
+ * @file TextureAtlasBenchmark.cpp
+ * @brief UIの画像をまとめるアトラス(TextureAtlasBuilder)の確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "TextureAtlasBuilder.h"
+#include "TextureAtlasCooker.h"
+#include "TextureCooker.h"
+#include "MappedFile.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//エンジンと同じ設定
+	const uint32_t ATLAS_WIDTH_ = 4096u;
+	const uint32_t ATLAS_MAX_HEIGHT_ = 16384u;
+	const uint32_t ATLAS_MIP_LEVELS_ = 4u;
+
+	//UserInterfaceAtlasでまとめている画像
+	const std::vector<std::string> USER_INTERFACE_FILE_PATHS_ = {
+		"Sprite/Player/PlayerHP.png",
+		"Sprite/Player/PlayerHPBack.png",
+		"Sprite/Item/Key/Key.png",
+		"Sprite/Item/KeyList.png",
+		"Sprite/Key/PickUpKey.png",
+		"Sprite/Gauge/Gauge.png",
+		"Sprite/Gauge/GaugeFrame.png",
+		"Sprite/Explanation/Explanation1.png",
+		"Sprite/Explanation/Explanation2.png",
+		"Sprite/Explanation/ExplanationNext1.png",
+		"Sprite/Explanation/ExplanationNext2.png",
+		"Sprite/Escape/EscapeText.png",
+		"Sprite/Escape/ToGoal.png",
+	};
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 画像ごとに違う色で塗った画素を作る
+	/// 端の画素が分かるように位置も入れる
+	/// </summary>
+	/// <param name="index">画像の番号</param>
+	/// <param name="width">幅</param>
+	/// <param name="height">高さ</param>
+	/// <returns>RGBA8の画素</returns>
+	std::vector<uint8_t> MakePixels(const uint32_t& index, const uint32_t& width, const uint32_t& height) {
+		std::vector<uint8_t> pixels(size_t(width) * height * 4u);
+		for (uint32_t y = 0u; y < height; ++y) {
+			for (uint32_t x = 0u; x < width; ++x) {
+				uint8_t* pixel = &pixels[(size_t(y) * width + x) * 4u];
+				pixel[0] = uint8_t(index);
+				pixel[1] = uint8_t(x);
+				pixel[2] = uint8_t(y);
+				pixel[3] = 255u;
+			}
+		}
+		return pixels;
+	}
+
+	/// <summary>
+	/// PNGのヘッダーから大きさを読む
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <param name="width">幅</param>
+	/// <param name="height">高さ</param>
+	/// <returns>読めたかどうか</returns>
+	bool ReadPngSize(const std::string& filePath, uint32_t& width, uint32_t& height) {
+		std::ifstream file(filePath, std::ios::binary);
+		uint8_t header[24] = {};
+		if (file.read(reinterpret_cast<char*>(header), sizeof(header)).good() == false) {
+			return false;
+		}
+		//IHDRはビッグエンディアン
+		width = (uint32_t(header[16]) << 24u) | (uint32_t(header[17]) << 16u) | (uint32_t(header[18]) << 8u) | uint32_t(header[19]);
+		height = (uint32_t(header[20]) << 24u) | (uint32_t(header[21]) << 16u) | (uint32_t(header[22]) << 8u) | uint32_t(header[23]);
+		return true;
+	}
+
+	/// <summary>
+	/// 詰めた矩形が重ならず、揃っているかの確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckPacker(bool& isValid) {
+		std::mt19937 randomEngine(1u);
+		std::uniform_int_distribution<uint32_t> random(1u, 300u);
+		std::vector<uint32_t> widths(500u);
+		std::vector<uint32_t> heights(500u);
+		for (size_t i = 0u; i < widths.size(); ++i) {
+			widths[i] = random(randomEngine);
+			heights[i] = random(randomEngine);
+		}
+
+		const uint32_t WIDTH = 2048u;
+		const uint32_t ALIGNMENT = 8u;
+		Elysia::RectanglePacker packer;
+		std::vector<Elysia::PackedRectangle> rectangles;
+		uint32_t usedHeight = packer.Pack(widths, heights, WIDTH, ALIGNMENT, rectangles);
+
+		bool isInside = true;
+		bool isAligned = true;
+		bool isLargeEnough = true;
+		bool isOverlapped = false;
+		uint64_t usedArea = 0u;
+		for (size_t i = 0u; i < rectangles.size(); ++i) {
+			const Elysia::PackedRectangle& a = rectangles[i];
+			isInside = isInside && a.x + a.width <= WIDTH && a.y + a.height <= usedHeight;
+			isAligned = isAligned && a.x % ALIGNMENT == 0u && a.y % ALIGNMENT == 0u && a.width % ALIGNMENT == 0u && a.height % ALIGNMENT == 0u;
+			isLargeEnough = isLargeEnough && a.width >= widths[i] && a.height >= heights[i];
+			usedArea += uint64_t(widths[i]) * heights[i];
+			for (size_t j = i + 1u; j < rectangles.size(); ++j) {
+				const Elysia::PackedRectangle& b = rectangles[j];
+				if (a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height) {
+					isOverlapped = true;
+				}
+			}
+		}
+		std::printf("  500個: %u x %u, 使用率 %.1f%%\n", WIDTH, usedHeight, 100.0 * double(usedArea) / (double(WIDTH) * usedHeight));
+		Check(usedHeight > 0u && rectangles.size() == widths.size(), "全部入る", isValid);
+		Check(isInside == true, "はみ出さない", isValid);
+		Check(isOverlapped == false, "重ならない", isValid);
+		Check(isAligned == true && isLargeEnough == true, "位置と大きさが揃っている", isValid);
+
+		//幅より大きいものは入らない
+		Check(packer.Pack({ WIDTH + 1u }, { 1u }, WIDTH, ALIGNMENT, rectangles) == 0u, "幅より大きいものは失敗", isValid);
+	}
+
+	/// <summary>
+	/// 画素、ガター、UVの確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckBuilder(bool& isValid) {
+		const uint32_t SIZES[][2] = { {64u,64u},{192u,64u},{32u,32u},{320u,32u},{13u,7u},{100u,50u} };
+		const uint32_t IMAGE_COUNT = uint32_t(std::size(SIZES));
+
+		Elysia::TextureAtlasBuilder builder;
+		for (uint32_t i = 0u; i < IMAGE_COUNT; ++i) {
+			std::vector<uint8_t> pixels = MakePixels(i + 1u, SIZES[i][0], SIZES[i][1]);
+			builder.Add("Image" + std::to_string(i), SIZES[i][0], SIZES[i][1], pixels.data(), size_t(SIZES[i][0]) * 4u);
+		}
+		Elysia::TextureAtlasBuilder::Settings settings = Elysia::TextureAtlasBuilder::MakeMipSafeSettings(512u, 4096u, ATLAS_MIP_LEVELS_);
+		settings.padding = 2u;
+		Check(builder.Build(settings) == true, "作れる", isValid);
+
+		uint32_t width = builder.GetWidth();
+		uint32_t height = builder.GetHeight();
+		const std::vector<uint8_t>& atlas = builder.GetPixels();
+		auto pixelAt = [&](const uint32_t& x, const uint32_t& y) {
+			return &atlas[(size_t(y) * width + x) * 4u];
+		};
+
+		bool isCopied = true;
+		bool isGutterExtruded = true;
+		bool isUVMatched = true;
+		bool isMipSafe = true;
+		//画素の持ち主(ガターも含む)
+		std::vector<int32_t> owners(size_t(width) * height, -1);
+		for (uint32_t i = 0u; i < IMAGE_COUNT; ++i) {
+			const Elysia::AtlasRegion& region = builder.GetRegions()[i];
+			for (uint32_t y = 0u; y < region.height; ++y) {
+				for (uint32_t x = 0u; x < region.width; ++x) {
+					const uint8_t* pixel = pixelAt(region.x + x, region.y + y);
+					isCopied = isCopied && pixel[0] == i + 1u && pixel[1] == uint8_t(x) && pixel[2] == uint8_t(y);
+				}
+			}
+			//ガターは一番近い端の画素と同じ
+			for (int32_t y = -int32_t(settings.gutter); y < int32_t(region.height + settings.gutter); ++y) {
+				for (int32_t x = -int32_t(settings.gutter); x < int32_t(region.width + settings.gutter); ++x) {
+					uint32_t sourceX = uint32_t(std::clamp<int32_t>(x, 0, int32_t(region.width) - 1));
+					uint32_t sourceY = uint32_t(std::clamp<int32_t>(y, 0, int32_t(region.height) - 1));
+					uint32_t atlasX = uint32_t(int32_t(region.x) + x);
+					uint32_t atlasY = uint32_t(int32_t(region.y) + y);
+					const uint8_t* pixel = pixelAt(atlasX, atlasY);
+					isGutterExtruded = isGutterExtruded && pixel[0] == i + 1u && pixel[1] == uint8_t(sourceX) && pixel[2] == uint8_t(sourceY);
+					owners[size_t(atlasY) * width + atlasX] = int32_t(i);
+				}
+			}
+			isUVMatched = isUVMatched &&
+				std::fabs(region.texLeftTop.x * float(width) - float(region.x)) < 1.0e-3f &&
+				std::fabs(region.texLeftTop.y * float(height) - float(region.y)) < 1.0e-3f &&
+				std::fabs(region.texRightBottom.x * float(width) - float(region.x + region.width)) < 1.0e-3f &&
+				std::fabs(region.texRightBottom.y * float(height) - float(region.y + region.height)) < 1.0e-3f;
+
+			//どのミップでも、画像に掛かる画素は自分の画素とガターだけから作られる
+			for (uint32_t level = 1u; level < ATLAS_MIP_LEVELS_; ++level) {
+				uint32_t block = 1u << level;
+				for (uint32_t blockY = region.y / block * block; blockY < region.y + region.height; blockY += block) {
+					for (uint32_t blockX = region.x / block * block; blockX < region.x + region.width; blockX += block) {
+						for (uint32_t y = blockY; y < blockY + block && y < height; ++y) {
+							for (uint32_t x = blockX; x < blockX + block && x < width; ++x) {
+								isMipSafe = isMipSafe && owners[size_t(y) * width + x] == int32_t(i);
+							}
+						}
+					}
+				}
+			}
+		}
+		Check(isCopied == true, "画素がそのまま入る", isValid);
+		Check(isGutterExtruded == true, "ガターは端の画素を伸ばす", isValid);
+		Check(isUVMatched == true, "UVが画素の端と一致", isValid);
+		Check(isMipSafe == true, "ミップマップで隣の画像が混ざらない", isValid);
+
+		//同じ入力なら同じ結果
+		Elysia::TextureAtlasBuilder other;
+		for (uint32_t i = 0u; i < IMAGE_COUNT; ++i) {
+			std::vector<uint8_t> pixels = MakePixels(i + 1u, SIZES[i][0], SIZES[i][1]);
+			other.Add("Image" + std::to_string(i), SIZES[i][0], SIZES[i][1], pixels.data(), size_t(SIZES[i][0]) * 4u);
+		}
+		other.Build(settings);
+		Check(other.GetPixels() == builder.GetPixels(), "同じ入力なら同じ画素", isValid);
+	}
+
+	/// <summary>
+	/// UIの画像をまとめた時の大きさと速さ
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Measure(bool& isValid) {
+		std::vector<uint32_t> widths;
+		std::vector<uint32_t> heights;
+		uint64_t sourceArea = 0u;
+		for (const std::string& filePath : USER_INTERFACE_FILE_PATHS_) {
+			uint32_t width = 0u;
+			uint32_t height = 0u;
+			if (ReadPngSize(std::string(ELYSIA_RESOURCES_DIRECTORY) + filePath, width, height) == false) {
+				std::printf("  %s が読めない\n", filePath.c_str());
+				isValid = false;
+				return;
+			}
+			widths.push_back(width);
+			heights.push_back(height);
+			sourceArea += uint64_t(width) * height;
+		}
+
+		//画素の中身は関係ないので同じ大きさの画像で組む
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		Elysia::TextureAtlasBuilder builder;
+		for (size_t i = 0u; i < widths.size(); ++i) {
+			std::vector<uint8_t> pixels = MakePixels(uint32_t(i + 1u), widths[i], heights[i]);
+			builder.Add(USER_INTERFACE_FILE_PATHS_[i], widths[i], heights[i], pixels.data(), size_t(widths[i]) * 4u);
+		}
+		bool isBuilt = builder.Build(Elysia::TextureAtlasBuilder::MakeMipSafeSettings(ATLAS_WIDTH_, ATLAS_MAX_HEIGHT_, ATLAS_MIP_LEVELS_));
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		uint64_t atlasArea = uint64_t(builder.GetWidth()) * builder.GetHeight();
+		std::printf("  UI %zu枚 -> アトラス %u x %u (使用率 %.1f%%), SRV %zu -> 1, %.2f ms\n",
+			widths.size(), builder.GetWidth(), builder.GetHeight(), 100.0 * double(sourceArea) / double(atlasArea),
+			widths.size(), std::chrono::duration<double, std::milli>(end - start).count());
+		Check(isBuilt == true, "UIの画像が1枚に入る", isValid);
+	}
+
+	/// <summary>
+	/// UIのアトラスのクックの確認
+	/// 1回クックすれば次からは表とDDSを読むだけで、画像が1枚でも変われば作り直す
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckCook(bool& isValid) {
+		//元の画像は変更を確かめるので一時フォルダに写す
+		std::filesystem::path workDirectory = std::filesystem::temp_directory_path() / "ElysiaTextureAtlasBenchmark";
+		std::filesystem::remove_all(workDirectory);
+		std::vector<std::string> filePaths;
+		for (const std::string& filePath : USER_INTERFACE_FILE_PATHS_) {
+			std::filesystem::path copiedFilePath = workDirectory / "Source" / filePath;
+			std::filesystem::create_directories(copiedFilePath.parent_path());
+			std::filesystem::copy_file(std::string(ELYSIA_RESOURCES_DIRECTORY) + filePath, copiedFilePath);
+			filePaths.push_back(copiedFilePath.generic_string());
+		}
+		const std::string cookedDirectory = (workDirectory / "Cooked").generic_string() + "/";
+		const Elysia::TextureAtlasBuilder::Settings settings = Elysia::TextureAtlasBuilder::MakeMipSafeSettings(ATLAS_WIDTH_, ATLAS_MAX_HEIGHT_, ATLAS_MIP_LEVELS_);
+
+		std::string cookedTexturePath;
+		std::vector<Elysia::AtlasRegion> regions;
+		Check(TextureAtlasCooker::FindCookedFiles(filePaths, settings, ATLAS_MIP_LEVELS_, cookedDirectory, cookedTexturePath, regions) == false, "クック前は見つからない", isValid);
+
+		std::chrono::steady_clock::time_point cookStart = std::chrono::steady_clock::now();
+		bool isCooked = TextureAtlasCooker::Cook(filePaths, settings, ATLAS_MIP_LEVELS_, cookedDirectory);
+		std::chrono::steady_clock::time_point cookEnd = std::chrono::steady_clock::now();
+		Check(isCooked == true, "UIの画像をクック出来る", isValid);
+
+		std::chrono::steady_clock::time_point findStart = std::chrono::steady_clock::now();
+		bool isFound = TextureAtlasCooker::FindCookedFiles(filePaths, settings, ATLAS_MIP_LEVELS_, cookedDirectory, cookedTexturePath, regions);
+		std::chrono::steady_clock::time_point findEnd = std::chrono::steady_clock::now();
+		Check(isFound == true, "クック後は見つかる", isValid);
+		if (isCooked == false || isFound == false) {
+			return;
+		}
+
+		//DDSは大きさとミップマップの数がアトラスと一致する
+		Elysia::MappedFile textureFile;
+		TextureCooker::DDSHeader header = {};
+		bool isHeaderRead = textureFile.Open(cookedTexturePath) == true && textureFile.GetSize() >= sizeof(TextureCooker::DDSHeader);
+		if (isHeaderRead == true) {
+			std::memcpy(&header, textureFile.GetData(), sizeof(TextureCooker::DDSHeader));
+		}
+		uint64_t mipBytes = 0u;
+		for (uint32_t mip = 0u; mip < ATLAS_MIP_LEVELS_; ++mip) {
+			mipBytes += uint64_t(std::max<uint32_t>(header.width >> mip, 1u)) * std::max<uint32_t>(header.height >> mip, 1u) * 4u;
+		}
+		std::printf("  クック %.1f ms, 読み込みの確認 %.2f ms, %u x %u, %zu bytes\n",
+			std::chrono::duration<double, std::milli>(cookEnd - cookStart).count(),
+			std::chrono::duration<double, std::milli>(findEnd - findStart).count(),
+			header.width, header.height, textureFile.GetSize());
+		Check(isHeaderRead == true && header.dxgiFormat == TextureCooker::R8G8B8A8UnormSrgb && header.mipMapCount == ATLAS_MIP_LEVELS_ &&
+			textureFile.GetSize() == sizeof(TextureCooker::DDSHeader) + mipBytes, "DDSはRGBA8でミップマップ付き", isValid);
+
+		//範囲はその場で詰めたものと同じ
+		Elysia::TextureAtlasBuilder builder;
+		for (size_t i = 0u; i < regions.size(); ++i) {
+			std::vector<uint8_t> pixels = MakePixels(uint32_t(i + 1u), regions[i].width, regions[i].height);
+			builder.Add(filePaths[i], regions[i].width, regions[i].height, pixels.data(), size_t(regions[i].width) * 4u);
+		}
+		builder.Build(settings);
+		bool isRegionMatched = builder.GetWidth() == header.width && builder.GetHeight() == header.height && builder.GetRegions().size() == regions.size();
+		for (size_t i = 0u; isRegionMatched == true && i < regions.size(); ++i) {
+			const Elysia::AtlasRegion& expected = builder.GetRegions()[i];
+			isRegionMatched = expected.name == regions[i].name && expected.x == regions[i].x && expected.y == regions[i].y &&
+				expected.texLeftTop.x == regions[i].texLeftTop.x && expected.texLeftTop.y == regions[i].texLeftTop.y &&
+				expected.texRightBottom.x == regions[i].texRightBottom.x && expected.texRightBottom.y == regions[i].texRightBottom.y;
+		}
+		Check(isRegionMatched == true, "範囲の表はその場で詰めたものと一致", isValid);
+
+		//並びや設定が変わったら使わない
+		std::vector<std::string> reversedFilePaths(filePaths.rbegin(), filePaths.rend());
+		std::vector<Elysia::AtlasRegion> otherRegions;
+		std::string otherTexturePath;
+		Check(TextureAtlasCooker::FindCookedFiles(reversedFilePaths, settings, ATLAS_MIP_LEVELS_, cookedDirectory, otherTexturePath, otherRegions) == false, "並びが変わったら作り直す", isValid);
+		Check(TextureAtlasCooker::FindCookedFiles(filePaths, settings, ATLAS_MIP_LEVELS_ - 1u, cookedDirectory, otherTexturePath, otherRegions) == false, "ミップマップの数が変わったら作り直す", isValid);
+
+		//1枚でも中身が変わったら使わない
+		{
+			std::ofstream file(filePaths.back(), std::ios::binary | std::ios::app);
+			file.put('\0');
+		}
+		Check(TextureAtlasCooker::FindCookedFiles(filePaths, settings, ATLAS_MIP_LEVELS_, cookedDirectory, otherTexturePath, otherRegions) == false, "画像が変わったら作り直す", isValid);
+
+		//壊れた表は読まない
+		std::vector<uint8_t> table = TextureAtlasCooker::MakeTable(builder.GetWidth(), builder.GetHeight(), builder.GetRegions());
+		Check(TextureAtlasCooker::ParseTable(table.data(), table.size(), otherRegions) == true && otherRegions.size() == regions.size(), "表を読み戻せる", isValid);
+		Check(TextureAtlasCooker::ParseTable(table.data(), table.size() - 1u, otherRegions) == false, "途中で切れた表は読まない", isValid);
+
+		textureFile.Close();
+		std::error_code errorCode;
+		std::filesystem::remove_all(workDirectory, errorCode);
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("矩形を詰める\n");
+	CheckPacker(isValid);
+	std::printf("アトラス\n");
+	CheckBuilder(isValid);
+	std::printf("計測\n");
+	Measure(isValid);
+	std::printf("クック\n");
+	CheckCook(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,378 @@
+/**
+ * @file TextureCookBenchmark.cpp
+ * @brief テクスチャのクック(TextureCooker)の確認と計測
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+
+#include "TextureCooker.h"
+#include "BlockCompressor.h"
+#include "PngDecoder.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//合成した画像をクックした結果のハッシュ
+	//エンコーダーを変えて結果が変わったらTextureCooker::VERSIONを上げてここも直す
+	const uint64_t EXPECTED_COOKED_HASH_ = 0x067234211D69954Cull;
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 計測用の画像を作る
+	/// なめらかなグラデーションに少しノイズを足す
+	/// </summary>
+	/// <param name="width">幅</param>
+	/// <param name="height">高さ</param>
+	/// <param name="alphaType">0:不透明 1:切り抜き 2:なめらか</param>
+	/// <returns>画像</returns>
+	PngDecoder::Image MakeImage(const uint32_t& width, const uint32_t& height, const uint32_t& alphaType) {
+		std::mt19937 randomEngine(width * 31u + height * 7u + alphaType);
+		std::uniform_int_distribution<int32_t> noise(-3, 3);
+		PngDecoder::Image image = {
+			.width = width,
+			.height = height,
+			.channelCount = 4u,
+			.pixels = std::vector<uint8_t>(size_t(width) * height * 4u),
+		};
+		for (uint32_t y = 0u; y < height; ++y) {
+			for (uint32_t x = 0u; x < width; ++x) {
+				uint8_t* pixel = &image.pixels[(size_t(y) * width + x) * 4u];
+				pixel[0] = uint8_t(std::clamp<int32_t>(int32_t(x * 255u / width) + noise(randomEngine), 0, 255));
+				pixel[1] = uint8_t(std::clamp<int32_t>(int32_t(y * 255u / height) + noise(randomEngine), 0, 255));
+				pixel[2] = uint8_t(std::clamp<int32_t>(int32_t((x + y) * 127u / (width + height)) + 64 + noise(randomEngine), 0, 255));
+				uint32_t distance = uint32_t(std::abs(int32_t(x) - int32_t(width / 2u)) + std::abs(int32_t(y) - int32_t(height / 2u)));
+				switch (alphaType) {
+				case 0:
+					pixel[3] = 255u;
+					break;
+				case 1:
+					pixel[3] = (distance < width / 3u) ? 255u : 0u;
+					break;
+				default:
+					pixel[3] = uint8_t(255u - std::min<uint32_t>(distance * 255u / width, 255u));
+					break;
+				}
+			}
+		}
+		return image;
+	}
+
+	/// <summary>
+	/// 一番大きいミップを戻す
+	/// </summary>
+	/// <param name="texture">クックしたテクスチャ</param>
+	/// <param name="channelCount">戻す画像のチャンネル数</param>
+	/// <returns>画素</returns>
+	std::vector<uint8_t> DecodeTopLevel(const TextureCooker::CookedTexture& texture, const uint32_t& channelCount) {
+		std::vector<uint8_t> pixels(size_t(texture.width) * texture.height * channelCount);
+		if (texture.format == TextureCooker::R8Unorm || texture.format == TextureCooker::R8G8B8A8UnormSrgb) {
+			std::memcpy(pixels.data(), texture.data.data(), pixels.size());
+			return pixels;
+		}
+
+		uint32_t blockWidth = (texture.width + 3u) / 4u;
+		uint32_t bytesPerBlock = (texture.format == TextureCooker::BC1UnormSrgb || texture.format == TextureCooker::BC4Unorm) ? 8u : 16u;
+		uint8_t rgba[BlockCompressor::BLOCK_PIXEL_COUNT * 4u] = {};
+		for (uint32_t by = 0u; by < texture.height / 4u; ++by) {
+			for (uint32_t bx = 0u; bx < texture.width / 4u; ++bx) {
+				const uint8_t* block = texture.data.data() + (size_t(by) * blockWidth + bx) * bytesPerBlock;
+				switch (texture.format) {
+				case TextureCooker::BC1UnormSrgb:
+					BlockCompressor::DecodeBC1(block, rgba);
+					break;
+				case TextureCooker::BC3UnormSrgb:
+					BlockCompressor::DecodeBC3(block, rgba);
+					break;
+				case TextureCooker::BC4Unorm:
+					BlockCompressor::DecodeBC4(block, rgba, 4u);
+					break;
+				default:
+					BlockCompressor::DecodeBC7(block, rgba);
+					break;
+				}
+				for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+					size_t x = bx * 4u + i % 4u;
+					size_t y = by * 4u + i / 4u;
+					std::memcpy(&pixels[(y * texture.width + x) * channelCount], &rgba[i * 4u], channelCount);
+				}
+			}
+		}
+		return pixels;
+	}
+
+	/// <summary>
+	/// PSNR(dB)
+	/// </summary>
+	/// <param name="a">画素</param>
+	/// <param name="b">画素</param>
+	/// <param name="channelCount">チャンネル数</param>
+	/// <param name="channelMask">比べるチャンネル(ビット)</param>
+	/// <returns>PSNR</returns>
+	double ComputePSNR(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, const uint32_t& channelCount, const uint32_t& channelMask) {
+		double squaredError = 0.0;
+		size_t count = 0u;
+		for (size_t i = 0u; i < a.size(); ++i) {
+			if (((channelMask >> (i % channelCount)) & 1u) == 0u) {
+				continue;
+			}
+			double difference = double(a[i]) - double(b[i]);
+			squaredError += difference * difference;
+			++count;
+		}
+		if (squaredError == 0.0) {
+			return 99.0;
+		}
+		return 10.0 * std::log10(255.0 * 255.0 / (squaredError / double(count)));
+	}
+
+	/// <summary>
+	/// ファイルを全部読む
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>中身</returns>
+	std::vector<uint8_t> ReadFile(const std::string& filePath) {
+		std::ifstream file(filePath, std::ios::binary);
+		return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	}
+
+	/// <summary>
+	/// ブロック単位の確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckBlocks(bool& isValid) {
+		uint8_t rgba[BlockCompressor::BLOCK_PIXEL_COUNT * 4u] = {};
+		uint8_t decoded[BlockCompressor::BLOCK_PIXEL_COUNT * 4u] = {};
+		uint8_t block[16] = {};
+		auto maxError = [&]() {
+			int32_t result = 0;
+			for (uint32_t i = 0u; i < sizeof(rgba); ++i) {
+				result = std::max<int32_t>(result, std::abs(int32_t(rgba[i]) - int32_t(decoded[i])));
+			}
+			return result;
+		};
+
+		//単色
+		for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+			rgba[i * 4u + 0u] = 200u;
+			rgba[i * 4u + 1u] = 100u;
+			rgba[i * 4u + 2u] = 37u;
+			rgba[i * 4u + 3u] = 255u;
+		}
+		BlockCompressor::EncodeBC1(rgba, block);
+		BlockCompressor::DecodeBC1(block, decoded);
+		Check(maxError() <= 4, "BC1 単色の誤差が565の範囲", isValid);
+		BlockCompressor::EncodeBC7(rgba, block);
+		Check(BlockCompressor::DecodeBC7(block, decoded) == true && maxError() <= 1, "BC7 単色の誤差が1以下", isValid);
+
+		//0と255だけのアルファはBC3でそのまま残る
+		for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+			rgba[i * 4u + 3u] = (i % 3u == 0u) ? 0u : 255u;
+		}
+		BlockCompressor::EncodeBC3(rgba, block);
+		BlockCompressor::DecodeBC3(block, decoded);
+		bool isAlphaExact = true;
+		for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+			isAlphaExact = isAlphaExact && decoded[i * 4u + 3u] == rgba[i * 4u + 3u];
+		}
+		Check(isAlphaExact == true, "BC3 切り抜きのアルファがそのまま", isValid);
+
+		//BC4は2値ならそのまま
+		uint8_t values[BlockCompressor::BLOCK_PIXEL_COUNT] = {};
+		uint8_t decodedValues[BlockCompressor::BLOCK_PIXEL_COUNT] = {};
+		for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+			values[i] = (i % 2u == 0u) ? 17u : 230u;
+		}
+		BlockCompressor::EncodeBC4(values, 1u, block);
+		BlockCompressor::DecodeBC4(block, decodedValues, 1u);
+		Check(std::memcmp(values, decodedValues, sizeof(values)) == 0, "BC4 2値がそのまま", isValid);
+
+		//BC7の先頭の番号は最上位ビットが0
+		std::mt19937 randomEngine(3u);
+		std::uniform_int_distribution<uint32_t> random(0u, 255u);
+		bool isAnchorValid = true;
+		int32_t randomMaxError = 0;
+		for (uint32_t n = 0u; n < 1000u; ++n) {
+			for (uint8_t& value : rgba) {
+				value = uint8_t(random(randomEngine));
+			}
+			BlockCompressor::EncodeBC7(rgba, block);
+			isAnchorValid = isAnchorValid && BlockCompressor::DecodeBC7(block, decoded);
+			randomMaxError = std::max<int32_t>(randomMaxError, maxError());
+		}
+		std::printf("  BC7 ランダムなブロックの最大誤差 %d\n", randomMaxError);
+		Check(isAnchorValid == true, "BC7 モード6として読める", isValid);
+	}
+
+	/// <summary>
+	/// 画像単位の確認
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckImages(bool& isValid) {
+		const char* ALPHA_TYPE_NAMES[3] = { "不透明","切り抜き","なめらか" };
+		const TextureCooker::Format EXPECTED_FORMATS[3] = { TextureCooker::BC1UnormSrgb,TextureCooker::BC3UnormSrgb,TextureCooker::BC7UnormSrgb };
+		const double MIN_PSNRS[3] = { 35.0,35.0,38.0 };
+		for (uint32_t alphaType = 0u; alphaType < 3u; ++alphaType) {
+			PngDecoder::Image image = MakeImage(256u, 128u, alphaType);
+			TextureCooker::Format format = TextureCooker::ChooseFormat(image);
+			TextureCooker::CookedTexture texture = TextureCooker::Compress(image, format, TextureCooker::MIP_LEVELS);
+			std::vector<uint8_t> decoded = DecodeTopLevel(texture, 4u);
+			double colorPSNR = ComputePSNR(image.pixels, decoded, 4u, 0x7u);
+			double alphaPSNR = ComputePSNR(image.pixels, decoded, 4u, 0x8u);
+			std::printf("  %-12s 色 %.1fdB アルファ %.1fdB\n", ALPHA_TYPE_NAMES[alphaType], colorPSNR, alphaPSNR);
+			Check(format == EXPECTED_FORMATS[alphaType], "アルファに合った形式を選ぶ", isValid);
+			Check(colorPSNR >= MIN_PSNRS[alphaType] && alphaPSNR >= MIN_PSNRS[alphaType], "誤差が小さい", isValid);
+		}
+
+		//4の倍数でなければ無圧縮
+		PngDecoder::Image oddImage = MakeImage(862u, 862u, 0u);
+		Check(TextureCooker::ChooseFormat(oddImage) == TextureCooker::R8G8B8A8UnormSrgb, "4の倍数でなければRGBA8", isValid);
+
+		//ミップマップは線形で平均する
+		//白黒の市松模様は線形で0.5の灰色(sRGBで188)になる
+		PngDecoder::Image checker = {
+			.width = 4u,
+			.height = 4u,
+			.channelCount = 4u,
+			.pixels = std::vector<uint8_t>(64u),
+		};
+		for (uint32_t i = 0u; i < 16u; ++i) {
+			uint8_t value = ((i % 4u + i / 4u) % 2u == 0u) ? 255u : 0u;
+			checker.pixels[i * 4u + 0u] = value;
+			checker.pixels[i * 4u + 1u] = value;
+			checker.pixels[i * 4u + 2u] = value;
+			checker.pixels[i * 4u + 3u] = 255u;
+		}
+		TextureCooker::CookedTexture checkerTexture = TextureCooker::Compress(checker, TextureCooker::R8G8B8A8UnormSrgb, TextureCooker::MIP_LEVELS);
+		Check(checkerTexture.mipLevels == 3u && checkerTexture.data.size() == (16u + 4u + 1u) * 4u, "ミップマップの数は1x1まで", isValid);
+		Check(checkerTexture.data[64] == 188u, "sRGBは線形で平均する", isValid);
+
+		//DDSのヘッダーと全体のサイズ
+		PngDecoder::Image image = MakeImage(256u, 128u, 2u);
+		TextureCooker::CookedTexture texture = TextureCooker::Compress(image, TextureCooker::ChooseFormat(image), TextureCooker::MIP_LEVELS);
+		std::vector<uint8_t> dds = TextureCooker::MakeDDS(texture);
+		TextureCooker::DDSHeader header = {};
+		std::memcpy(&header, dds.data(), sizeof(header));
+		//256x128 + 128x64 + 64x32 + 32x16 を16バイトのブロックで
+		size_t expectedSize = sizeof(header) + (64u * 32u + 32u * 16u + 16u * 8u + 8u * 4u) * 16u;
+		Check(std::memcmp(dds.data(), "DDS ", 4u) == 0 && header.fourCC == 0x30315844u && header.dxgiFormat == TextureCooker::BC7UnormSrgb, "DDSのヘッダー", isValid);
+		Check(header.mipMapCount == TextureCooker::MIP_LEVELS && dds.size() == expectedSize, "DDSのサイズ", isValid);
+
+		//何度やっても、どの環境でも同じバイト列
+		std::vector<uint8_t> again = TextureCooker::MakeDDS(TextureCooker::Compress(image, TextureCooker::ChooseFormat(image), TextureCooker::MIP_LEVELS));
+		uint64_t cookedHash = TextureCooker::ComputeContentHash(dds.data(), dds.size());
+		std::printf("  クックした結果のハッシュ %016llx\n", static_cast<unsigned long long>(cookedHash));
+		Check(dds == again, "同じ入力なら同じバイト列", isValid);
+		Check(cookedHash == EXPECTED_COOKED_HASH_, "決まったバイト列になる", isValid);
+
+		//中身が1バイトでも違えば別のファイル
+		std::vector<uint8_t> source = { 1u,2u,3u,4u };
+		uint64_t hash = TextureCooker::ComputeContentHash(source.data(), source.size());
+		source[3] = 5u;
+		Check(hash != TextureCooker::ComputeContentHash(source.data(), source.size()), "中身が変わればハッシュも変わる", isValid);
+		Check(TextureCooker::GetCookedFilePath("Cooked/", 0x1234u) == "Cooked/0000000000001234.dds", "ハッシュからパスを作る", isValid);
+
+		//クックしていなければ読み込んだ所でクックし、次からはそれが見つかる
+		const std::string sourceFilePath = std::string(ELYSIA_RESOURCES_DIRECTORY) + "Sprite/Gauge/Gauge.png";
+		const std::string cookedDirectory = (std::filesystem::temp_directory_path() / "ElysiaTextureCookFile").generic_string() + "/";
+		std::error_code errorCode;
+		std::filesystem::remove_all(cookedDirectory, errorCode);
+		Check(TextureCooker::FindCookedFile(sourceFilePath, cookedDirectory).empty() == true, "クック前は見つからない", isValid);
+		std::string cookedFilePath = TextureCooker::CookFile(sourceFilePath, cookedDirectory);
+		Check(cookedFilePath.empty() == false && TextureCooker::FindCookedFile(sourceFilePath, cookedDirectory) == cookedFilePath, "読み込んだ所でクックすると次から見つかる", isValid);
+		Check(TextureCooker::CookFile(std::string(ELYSIA_RESOURCES_DIRECTORY) + "External/Texture/HouseFloor/texture2021032_48_TP_V4.jpg", cookedDirectory).empty() == true, "PNG以外はクックしない", isValid);
+		std::filesystem::remove_all(cookedDirectory, errorCode);
+	}
+
+	/// <summary>
+	/// 実際のリソースで計測
+	/// 今までの読み込み(展開してミップマップを作る)とクックしたDDSの読み込みを比べる
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Measure(bool& isValid) {
+		std::vector<std::string> filePaths;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(std::string(ELYSIA_RESOURCES_DIRECTORY) + "Sprite/")) {
+			if (entry.is_regular_file() && entry.path().extension() == ".png") {
+				filePaths.push_back(entry.path().string());
+			}
+		}
+		std::sort(filePaths.begin(), filePaths.end());
+		std::filesystem::path temporaryDirectory = std::filesystem::temp_directory_path() / "ElysiaTextureCookBenchmark";
+		std::filesystem::create_directories(temporaryDirectory);
+
+		double decodeMilliseconds = 0.0;
+		double cookedMilliseconds = 0.0;
+		uint64_t uncompressedBytes = 0u;
+		uint64_t cookedBytes = 0u;
+		double minPSNR = 99.0;
+		uint32_t decodedCount = 0u;
+		uint32_t formatCounts[100] = {};
+		for (const std::string& filePath : filePaths) {
+			std::vector<uint8_t> source = ReadFile(filePath);
+
+			//今まで: 展開してRGBA8のままミップマップを作る
+			auto start = std::chrono::high_resolution_clock::now();
+			PngDecoder::Image image = {};
+			if (PngDecoder::Decode(source.data(), source.size(), image) == false) {
+				continue;
+			}
+			TextureCooker::Format rawFormat = (image.channelCount == 1u) ? TextureCooker::R8Unorm : TextureCooker::R8G8B8A8UnormSrgb;
+			TextureCooker::CookedTexture raw = TextureCooker::Compress(image, rawFormat, TextureCooker::MIP_LEVELS);
+			decodeMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			++decodedCount;
+
+			//クック
+			TextureCooker::Format format = TextureCooker::ChooseFormat(image);
+			TextureCooker::CookedTexture cooked = TextureCooker::Compress(image, format, TextureCooker::MIP_LEVELS);
+			std::string cookedFilePath = TextureCooker::GetCookedFilePath(temporaryDirectory.string() + "/", TextureCooker::ComputeContentHash(source.data(), source.size()));
+			TextureCooker::Cook(source.data(), source.size(), cookedFilePath);
+			++formatCounts[format];
+
+			//クックした後: DDSを読むだけ
+			start = std::chrono::high_resolution_clock::now();
+			std::vector<uint8_t> dds = ReadFile(cookedFilePath);
+			cookedMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+			uncompressedBytes += raw.data.size();
+			cookedBytes += dds.size();
+			minPSNR = std::min<double>(minPSNR, ComputePSNR(image.pixels, DecodeTopLevel(cooked, image.channelCount), image.channelCount, 0xFu));
+		}
+		std::filesystem::remove_all(temporaryDirectory);
+
+		std::printf("  Resources/Sprite %u枚 (BC1 %u, BC3 %u, BC7 %u, BC4 %u, 無圧縮 %u)\n", decodedCount,
+			formatCounts[TextureCooker::BC1UnormSrgb], formatCounts[TextureCooker::BC3UnormSrgb], formatCounts[TextureCooker::BC7UnormSrgb],
+			formatCounts[TextureCooker::BC4Unorm], formatCounts[TextureCooker::R8G8B8A8UnormSrgb] + formatCounts[TextureCooker::R8Unorm]);
+		std::printf("  展開+ミップマップ %9.2f ms  ->  DDSの読み込み %7.2f ms\n", decodeMilliseconds, cookedMilliseconds);
+		std::printf("  GPUに送るサイズ   %9.2f MB  ->  %9.2f MB\n", double(uncompressedBytes) / (1024.0 * 1024.0), double(cookedBytes) / (1024.0 * 1024.0));
+		std::printf("  一番悪いPSNR %.1fdB\n", minPSNR);
+		Check(decodedCount == filePaths.size(), "全部のスプライトを展開できる", isValid);
+		Check(cookedBytes < uncompressedBytes, "サイズが小さくなる", isValid);
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("ブロック圧縮\n");
+	CheckBlocks(isValid);
+	std::printf("クック\n");
+	CheckImages(isValid);
+	std::printf("計測\n");
+	Measure(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,301 @@
+/**
+ * @file TextureStreamingBenchmark.cpp
+ * @brief テクスチャのミップを載せる方針(TextureResidencyPolicy)のシミュレーション
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+#include "TextureResidencyPolicy.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// BC1で圧縮した時のミップごとのバイト数
+	/// </summary>
+	/// <param name="size">一番大きいミップの幅と高さ</param>
+	/// <returns>ミップごとのバイト数</returns>
+	std::vector<uint64_t> MakeMipBytes(const uint32_t& size) {
+		std::vector<uint64_t> mipBytes;
+		for (uint32_t width = size; ; width /= 2u) {
+			uint64_t blockCount = std::max<uint64_t>((width + 3u) / 4u, 1u);
+			mipBytes.push_back(blockCount * blockCount * 8u);
+			if (width == 1u) {
+				break;
+			}
+		}
+		return mipBytes;
+	}
+
+	/// <summary>
+	/// 設定
+	/// </summary>
+	/// <param name="budgetBytes">予算</param>
+	/// <param name="uploadBytesPerFrame">1フレームで載せるバイト数</param>
+	/// <returns>設定</returns>
+	Elysia::TextureResidencyPolicy::Settings MakeSettings(const uint64_t& budgetBytes, const uint64_t& uploadBytesPerFrame) {
+		return {
+			.budgetBytes = budgetBytes,
+			.uploadBytesPerFrame = uploadBytesPerFrame,
+			.alwaysResidentBytes = 64u * 1024u,
+			.unusedFrameCount = 120u,
+			.fullDetailDistance = 10.0f,
+		};
+	}
+
+	/// <summary>
+	/// 基本的な動き
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckBasic(bool& isValid) {
+		Elysia::TextureResidencyPolicy policy;
+		policy.Initialize(MakeSettings(64u * 1024u * 1024u, 1024u * 1024u), 16u);
+		std::vector<uint64_t> mipBytes = MakeMipBytes(2048u);
+		uint32_t id = policy.Register(mipBytes);
+
+		//最初は小さいミップだけ
+		uint64_t alwaysResidentBytes = 0u;
+		for (uint32_t mip = policy.GetResidentMip(id); mip < mipBytes.size(); ++mip) {
+			alwaysResidentBytes += mipBytes[mip];
+		}
+		Check(policy.GetResidentMip(id) > 0u && alwaysResidentBytes <= 64u * 1024u, "最初は小さいミップだけが載っている", isValid);
+
+		//使われていなければ何もしない
+		bool isChanged = false;
+		for (uint32_t i = 0u; i < 10u; ++i) {
+			isChanged = isChanged || policy.Update().empty() == false;
+		}
+		Check(isChanged == false, "使われなければ載せない", isValid);
+
+		//距離から欲しいミップ
+		Check(policy.ComputeMipFromDistance(5.0f) == 0u && policy.ComputeMipFromDistance(20.0f) == 1u &&
+			policy.ComputeMipFromDistance(45.0f) == 2u, "距離が2倍になるごとに1段粗くなる", isValid);
+
+		//遠くで使われたら途中まで
+		uint32_t frameCount = 0u;
+		for (; frameCount < 100u && policy.GetResidentMip(id) != 2u; ++frameCount) {
+			policy.RequestMip(id, policy.ComputeMipFromDistance(45.0f));
+			policy.Update();
+		}
+		for (uint32_t i = 0u; i < 5u; ++i) {
+			policy.RequestMip(id, 2u);
+			policy.Update();
+		}
+		Check(policy.GetResidentMip(id) == 2u, "遠くで使われたら途中のミップまで載せる", isValid);
+
+		//近くで使われたら1段ずつ細かくなる
+		uint32_t previousMip = policy.GetResidentMip(id);
+		bool isOneByOne = true;
+		bool isUploadLimited = true;
+		for (frameCount = 0u; frameCount < 100u && policy.GetResidentMip(id) != 0u; ++frameCount) {
+			policy.MarkUsed(id);
+			policy.Update();
+			uint32_t mip = policy.GetResidentMip(id);
+			isOneByOne = isOneByOne && previousMip - mip <= 1u;
+			//1枚で上限を超えるミップはそれだけを載せる
+			uint64_t uploadedBytes = policy.GetStatistics().uploadedBytes;
+			isUploadLimited = isUploadLimited && (uploadedBytes <= 1024u * 1024u || uploadedBytes == mipBytes[mip]);
+			previousMip = mip;
+		}
+		Check(policy.GetResidentMip(id) == 0u, "近くで使われたら一番細かいミップまで載せる", isValid);
+		Check(isOneByOne == true && isUploadLimited == true, "1フレームで載せる量を守る", isValid);
+
+		//同じフレームで何度も要求されたら一番細かいもの
+		Elysia::TextureResidencyPolicy threadedPolicy;
+		threadedPolicy.Initialize(MakeSettings(64u * 1024u * 1024u, 64u * 1024u * 1024u), 16u);
+		uint32_t threadedId = threadedPolicy.Register(mipBytes);
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0u; t < 4u; ++t) {
+			threads.emplace_back([&threadedPolicy, threadedId, t]() {
+				for (uint32_t i = 0u; i < 10000u; ++i) {
+					threadedPolicy.RequestMip(threadedId, 1u + (i + t) % 5u);
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		threadedPolicy.Update();
+		Check(threadedPolicy.GetDesiredMip(threadedId) == 1u, "複数のスレッドからの要求は一番細かいものになる", isValid);
+	}
+
+	/// <summary>
+	/// 長く使われていないものから降ろす
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckEviction(bool& isValid) {
+		std::vector<uint64_t> mipBytes = MakeMipBytes(1024u);
+		uint64_t fullBytes = 0u;
+		for (const uint64_t& bytes : mipBytes) {
+			fullBytes += bytes;
+		}
+
+		//2枚分と少し
+		Elysia::TextureResidencyPolicy policy;
+		policy.Initialize(MakeSettings(fullBytes * 2u + fullBytes / 2u, 64u * 1024u * 1024u), 16u);
+		uint32_t a = policy.Register(mipBytes);
+		uint32_t b = policy.Register(mipBytes);
+		uint32_t c = policy.Register(mipBytes);
+
+		//aを使ってからbを使う
+		for (uint32_t i = 0u; i < 20u; ++i) {
+			policy.MarkUsed(a);
+			policy.Update();
+		}
+		for (uint32_t i = 0u; i < 20u; ++i) {
+			policy.MarkUsed(b);
+			policy.Update();
+		}
+		Check(policy.GetResidentMip(a) == 0u && policy.GetResidentMip(b) == 0u, "予算内なら使われなくなっても残す", isValid);
+
+		//cを使うとaが降ろされる
+		for (uint32_t i = 0u; i < 20u; ++i) {
+			policy.MarkUsed(b);
+			policy.MarkUsed(c);
+			policy.Update();
+		}
+		Check(policy.GetResidentMip(c) == 0u && policy.GetResidentMip(b) == 0u && policy.GetResidentMip(a) > 0u,
+			"長く使われていないものから降ろす", isValid);
+		Check(policy.GetStatistics().residentBytes <= policy.GetSettings().budgetBytes, "予算を超えない", isValid);
+
+		//使っているものより優先度の低いものが無ければ諦める
+		for (uint32_t i = 0u; i < 20u; ++i) {
+			policy.MarkUsed(a);
+			policy.MarkUsed(b);
+			policy.MarkUsed(c);
+			policy.Update();
+		}
+		bool isFit = policy.GetStatistics().residentBytes <= policy.GetSettings().budgetBytes;
+		uint32_t fullCount = uint32_t(policy.GetResidentMip(a) == 0u) + uint32_t(policy.GetResidentMip(b) == 0u) + uint32_t(policy.GetResidentMip(c) == 0u);
+		Check(isFit == true && fullCount == 2u, "全部使われていたら入るだけ載せる", isValid);
+		std::printf("  全部使われている時のミップ a:%u b:%u c:%u (待ち %u)\n", policy.GetResidentMip(a), policy.GetResidentMip(b), policy.GetResidentMip(c),
+			policy.GetStatistics().pendingCount);
+
+		//予算を減らしたら降ろす
+		policy.SetBudgetBytes(fullBytes);
+		policy.MarkUsed(c);
+		policy.Update();
+		Check(policy.GetStatistics().residentBytes <= fullBytes, "予算を減らしたら次の更新で収める", isValid);
+	}
+
+	/// <summary>
+	/// カメラが並んだテクスチャの横を通り過ぎる
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Simulate(bool& isValid) {
+		//1m間隔で並んだ2048枚のテクスチャ(大きさはまちまち)
+		const uint32_t TEXTURE_COUNT = 2048u;
+		const float SPACING = 1.0f;
+		//カメラから見える距離
+		const float VIEW_DISTANCE = 80.0f;
+		const uint64_t BUDGET_BYTES = 64u * 1024u * 1024u;
+		const uint64_t UPLOAD_BYTES_PER_FRAME = 4u * 1024u * 1024u;
+
+		//枚数が多いので常に載せておく量は少なめにする
+		Elysia::TextureResidencyPolicy::Settings settings = MakeSettings(BUDGET_BYTES, UPLOAD_BYTES_PER_FRAME);
+		settings.alwaysResidentBytes = 16u * 1024u;
+		Elysia::TextureResidencyPolicy policy;
+		policy.Initialize(settings, TEXTURE_COUNT);
+		const uint32_t SIZES[] = { 256u, 512u, 1024u, 2048u };
+		uint64_t largestMipBytes = 0u;
+		for (uint32_t i = 0u; i < TEXTURE_COUNT; ++i) {
+			std::vector<uint64_t> mipBytes = MakeMipBytes(SIZES[(i * 7u) % 4u]);
+			largestMipBytes = std::max(largestMipBytes, mipBytes[0]);
+			policy.Register(mipBytes);
+		}
+
+		//カメラを0.2m/フレームで動かす
+		const float SPEED = 0.2f;
+		uint32_t frameCount = uint32_t(float(TEXTURE_COUNT) * SPACING / SPEED);
+		bool isInBudget = true;
+		bool isUploadLimited = true;
+		uint64_t maxResidentBytes = 0u;
+		uint64_t totalUploadedBytes = 0u;
+		uint64_t totalEvictedBytes = 0u;
+		//すぐ近くのテクスチャが一番細かいミップになっていた割合
+		uint32_t nearCount = 0u;
+		uint32_t nearSatisfiedCount = 0u;
+		double updateMilliseconds = 0.0;
+		for (uint32_t frame = 0u; frame < frameCount; ++frame) {
+			float cameraPosition = float(frame) * SPEED;
+			//見えているものを使う
+			int32_t first = std::max<int32_t>(int32_t((cameraPosition - VIEW_DISTANCE) / SPACING), 0);
+			int32_t last = std::min<int32_t>(int32_t((cameraPosition + VIEW_DISTANCE) / SPACING), int32_t(TEXTURE_COUNT) - 1);
+			for (int32_t i = first; i <= last; ++i) {
+				float distance = std::abs(float(i) * SPACING - cameraPosition);
+				policy.RequestMip(uint32_t(i), policy.ComputeMipFromDistance(distance));
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			policy.Update();
+			updateMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			const Elysia::TextureResidencyPolicy::Statistics& statistics = policy.GetStatistics();
+			isInBudget = isInBudget && statistics.residentBytes <= BUDGET_BYTES;
+			isUploadLimited = isUploadLimited && (statistics.uploadedBytes <= std::max(UPLOAD_BYTES_PER_FRAME, largestMipBytes));
+			maxResidentBytes = std::max(maxResidentBytes, statistics.residentBytes);
+			totalUploadedBytes += statistics.uploadedBytes;
+			totalEvictedBytes += statistics.evictedBytes;
+
+			//少し前から近くにあるもの
+			for (int32_t i = std::max(first, 0); i <= last; ++i) {
+				float distance = std::abs(float(i) * SPACING - cameraPosition);
+				if (distance < 3.0f && float(i) * SPACING > cameraPosition) {
+					++nearCount;
+					nearSatisfiedCount += uint32_t(policy.GetResidentMip(uint32_t(i)) == 0u);
+				}
+			}
+		}
+
+		const Elysia::TextureResidencyPolicy::Statistics& statistics = policy.GetStatistics();
+		double nearRatio = double(nearSatisfiedCount) / double(std::max(nearCount, 1u));
+		std::printf("  %u枚 %uフレーム 全部載せると %.1f MB\n", TEXTURE_COUNT, frameCount, double(statistics.fullBytes) / (1024.0 * 1024.0));
+		std::printf("  予算 %.1f MB  一番多い時 %.1f MB\n", double(BUDGET_BYTES) / (1024.0 * 1024.0), double(maxResidentBytes) / (1024.0 * 1024.0));
+		std::printf("  載せた量 %.1f MB  降ろした量 %.1f MB\n", double(totalUploadedBytes) / (1024.0 * 1024.0), double(totalEvictedBytes) / (1024.0 * 1024.0));
+		std::printf("  すぐ近くが一番細かいミップだった割合 %.1f%%\n", nearRatio * 100.0);
+		std::printf("  Update 平均 %.3f ms\n", updateMilliseconds / double(frameCount));
+		Check(isInBudget == true, "予算を超えない", isValid);
+		Check(isUploadLimited == true, "1フレームで載せる量を守る", isValid);
+		Check(nearRatio > 0.95, "近いものを優先して載せる", isValid);
+		Check(maxResidentBytes < statistics.fullBytes / 4u, "全部載せるより少ない", isValid);
+
+		//止まったら欲しいミップに落ち着く
+		for (uint32_t frame = 0u; frame < 200u; ++frame) {
+			float cameraPosition = float(TEXTURE_COUNT / 2u) * SPACING;
+			for (uint32_t i = TEXTURE_COUNT / 2u - 20u; i <= TEXTURE_COUNT / 2u + 20u; ++i) {
+				float distance = std::abs(float(i) * SPACING - cameraPosition);
+				policy.RequestMip(i, policy.ComputeMipFromDistance(distance));
+			}
+			policy.Update();
+		}
+		bool isConverged = true;
+		for (uint32_t i = TEXTURE_COUNT / 2u - 20u; i <= TEXTURE_COUNT / 2u + 20u; ++i) {
+			isConverged = isConverged && policy.GetResidentMip(i) <= policy.GetDesiredMip(i);
+		}
+		Check(isConverged == true && policy.GetStatistics().residentBytes <= BUDGET_BYTES, "止まったら欲しいミップに落ち着く", isValid);
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("基本\n");
+	CheckBasic(isValid);
+	std::printf("降ろす\n");
+	CheckEviction(isValid);
+	std::printf("シミュレーション\n");
+	Simulate(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
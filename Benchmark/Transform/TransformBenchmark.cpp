@@ -0,0 +1,249 @@
+/**
+ * @file TransformBenchmark.cpp
+ * @brief トランスフォーム更新(毎フレーム全計算,変更分だけ計算)の比較
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "TransformHierarchy.h"
+#include "Matrix4x4Calculation.h"
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	using Benchmark::Check;
+
+	//オブジェクトの数
+	//ゲームステージと同じくらい
+	const uint32_t OBJECT_COUNT_ = 1024u;
+	//子を持つ親の数
+	const uint32_t PARENT_COUNT_ = 64u;
+	//計測するフレーム数
+	const uint32_t FRAME_COUNT_ = 600u;
+
+	/// <summary>
+	/// 今までのWorldTransform::Updateと同じ計算
+	/// </summary>
+	struct FullUpdateTransform {
+		Vector3 scale;
+		Vector3 rotate;
+		Vector3 translate;
+		Matrix4x4 worldMatrix;
+		Matrix4x4 worldInverseTransposeMatrix;
+	};
+
+	/// <summary>
+	/// 1フレームあたりの時間(マイクロ秒)を測る
+	/// </summary>
+	/// <typeparam name="Function">1フレーム分の処理</typeparam>
+	/// <param name="function">処理</param>
+	/// <returns>時間</returns>
+	template<typename Function>
+	double Measure(Function function) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t frame = 0u; frame < FRAME_COUNT_; ++frame) {
+			function(frame);
+		}
+		std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() / static_cast<double>(FRAME_COUNT_);
+	}
+
+	/// <summary>
+	/// 計測
+	/// </summary>
+	/// <param name="dynamicRate">毎フレーム動くオブジェクトの割合</param>
+	void Run(const float& dynamicRate) {
+		const uint32_t dynamicCount = static_cast<uint32_t>(static_cast<float>(OBJECT_COUNT_) * dynamicRate);
+
+		//毎フレーム全部計算する
+		std::vector<FullUpdateTransform> transforms(OBJECT_COUNT_);
+		for (uint32_t i = 0u; i < OBJECT_COUNT_; ++i) {
+			transforms[i] = { .scale = {1.0f,1.0f,1.0f},.rotate = {0.0f,0.1f * static_cast<float>(i),0.0f},.translate = {static_cast<float>(i),0.0f,0.0f},.worldMatrix = {},.worldInverseTransposeMatrix = {} };
+		}
+		double fullTime = Measure([&](const uint32_t& frame) {
+			for (uint32_t i = 0u; i < dynamicCount; ++i) {
+				transforms[i].translate.y = static_cast<float>(frame);
+			}
+			for (uint32_t i = 0u; i < OBJECT_COUNT_; ++i) {
+				FullUpdateTransform& transform = transforms[i];
+				transform.worldMatrix = Matrix4x4Calculation::MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+				transform.worldInverseTransposeMatrix = Matrix4x4Calculation::MakeTransposeMatrix(Matrix4x4Calculation::Inverse(transform.worldMatrix));
+				//親子関係
+				if (i >= PARENT_COUNT_) {
+					transform.worldMatrix = Matrix4x4Calculation::Multiply(transform.worldMatrix, transforms[i % PARENT_COUNT_].worldMatrix);
+				}
+			}
+		});
+
+		//変わったものだけ計算する
+		Elysia::TransformHierarchy hierarchy;
+		for (uint32_t i = 0u; i < OBJECT_COUNT_; ++i) {
+			uint32_t node = hierarchy.Create((i >= PARENT_COUNT_) ? i % PARENT_COUNT_ : Elysia::TransformHierarchy::NO_PARENT_);
+			hierarchy.SetRotate(node, { 0.0f,0.1f * static_cast<float>(i),0.0f });
+			hierarchy.SetTranslate(node, { static_cast<float>(i),0.0f,0.0f });
+		}
+		std::vector<uint8_t> constantBuffer(static_cast<size_t>(OBJECT_COUNT_) * Elysia::TransformHierarchy::CONSTANT_STRIDE_);
+		size_t updatedCount = 0u;
+		double hierarchyTime = Measure([&](const uint32_t& frame) {
+			//子を持たないものを動かす
+			for (uint32_t i = 0u; i < dynamicCount; ++i) {
+				uint32_t node = OBJECT_COUNT_ - 1u - i;
+				hierarchy.SetTranslate(node, { static_cast<float>(node),static_cast<float>(frame),0.0f });
+			}
+			hierarchy.Update();
+			hierarchy.WriteConstants(constantBuffer.data());
+			updatedCount = hierarchy.GetUpdatedNodes().size();
+		});
+
+		std::printf("%5.1f%% dynamic | full %9.2f us | hierarchy %9.2f us (%4zu updated/frame) | %6.1fx\n",
+			dynamicRate * 100.0f, fullTime, hierarchyTime, updatedCount, fullTime / std::max(hierarchyTime, 0.001));
+	}
+
+	/// <summary>
+	/// 行列がほぼ同じかどうか
+	/// </summary>
+	/// <param name="m1">行列1</param>
+	/// <param name="m2">行列2</param>
+	/// <returns>ほぼ同じかどうか</returns>
+	bool IsNearlyEqual(const Matrix4x4& m1, const Matrix4x4& m2) {
+		for (uint32_t row = 0u; row < 4u; ++row) {
+			for (uint32_t column = 0u; column < 4u; ++column) {
+				if (std::abs(m1.m[row][column] - m2.m[row][column]) > 0.0001f) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 親子関係の確認
+	/// </summary>
+	/// <returns>全部正しいかどうか</returns>
+	bool CheckParent() {
+		bool isValid = true;
+		using Elysia::TransformHierarchy;
+
+		//循環する親は設定しない
+		TransformHierarchy hierarchy;
+		uint32_t a = hierarchy.Create();
+		uint32_t b = hierarchy.Create(a);
+		uint32_t c = hierarchy.Create(b);
+		Check(hierarchy.SetParent(a, a) == false, "reject self parent", isValid);
+		Check(hierarchy.SetParent(a, c) == false && hierarchy.GetParent(a) == TransformHierarchy::NO_PARENT_, "reject cycle through descendants", isValid);
+		hierarchy.Update();
+
+		//一度並べ直した後に、番号の小さいものを親にする
+		//0,1,2を作って0の親を1にすると順番は1,2,0になる
+		//その後2の親を0にしても番号の大小では並べ直しが必要か分からない
+		TransformHierarchy reorder;
+		for (uint32_t i = 0u; i < 3u; ++i) {
+			reorder.Create();
+		}
+		reorder.SetTranslate(0u, { .x = 1.0f,.y = 0.0f,.z = 0.0f });
+		reorder.SetTranslate(1u, { .x = 10.0f,.y = 0.0f,.z = 0.0f });
+		reorder.SetTranslate(2u, { .x = 100.0f,.y = 0.0f,.z = 0.0f });
+		reorder.SetParent(0u, 1u);
+		reorder.Update();
+		//同じフレームで祖先も動かす
+		reorder.SetTranslate(1u, { .x = 20.0f,.y = 0.0f,.z = 0.0f });
+		reorder.SetParent(2u, 0u);
+		reorder.Update();
+		Check(std::abs(reorder.GetWorldPosition(2u).x - 121.0f) < 0.0001f, "reparent to earlier node re-sorts", isValid);
+
+		//親より子が先に来ていないか
+		const std::vector<uint32_t>& order = reorder.GetOrder();
+		bool isParentFirst = true;
+		for (size_t i = 0u; i < order.size(); ++i) {
+			uint32_t parent = reorder.GetParent(order[i]);
+			if (parent != TransformHierarchy::NO_PARENT_ && std::find(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(i), parent) == order.begin() + static_cast<std::ptrdiff_t>(i)) {
+				isParentFirst = false;
+			}
+		}
+		Check(isParentFirst, "parents come before children", isValid);
+
+		//消すと子は親が無くなり、番号は使い回す
+		reorder.Destroy(0u);
+		reorder.Update();
+		Check(reorder.GetParent(2u) == TransformHierarchy::NO_PARENT_ && std::abs(reorder.GetWorldPosition(2u).x - 100.0f) < 0.0001f, "destroy detaches children", isValid);
+		Check(reorder.Create() == 0u && reorder.IsAlive(0u), "destroyed node is reused", isValid);
+		return isValid;
+	}
+
+	/// <summary>
+	/// まとめて計算した結果と1つずつ計算した結果の比較と、定数の書き込みの確認
+	/// </summary>
+	/// <returns>全部正しいかどうか</returns>
+	bool CheckCalculation() {
+		bool isValid = true;
+
+		//クォータニオンとオイラー角を混ぜる
+		const uint32_t count = 37u;
+		Elysia::TransformHierarchy hierarchy;
+		for (uint32_t i = 0u; i < count; ++i) {
+			uint32_t node = hierarchy.Create((i >= 4u) ? i % 4u : Elysia::TransformHierarchy::NO_PARENT_);
+			float value = static_cast<float>(i);
+			hierarchy.SetScale(node, { .x = 1.0f + 0.1f * value,.y = 1.0f,.z = 2.0f });
+			hierarchy.SetTranslate(node, { .x = value,.y = -value,.z = 0.5f * value });
+			if (i % 2u == 0u) {
+				hierarchy.SetQuaternion(node, { .x = 0.0f,.y = std::sin(0.05f * value),.z = 0.0f,.w = std::cos(0.05f * value) });
+			}
+			else {
+				hierarchy.SetRotate(node, { .x = 0.1f * value,.y = 0.2f,.z = -0.3f * value });
+			}
+		}
+		hierarchy.Update();
+
+		//1つずつ計算したもの
+		bool isSame = true;
+		for (uint32_t i = 0u; i < count; ++i) {
+			float value = static_cast<float>(i);
+			Vector3 scale = { .x = 1.0f + 0.1f * value,.y = 1.0f,.z = 2.0f };
+			Vector3 translate = { .x = value,.y = -value,.z = 0.5f * value };
+			Matrix4x4 local = (i % 2u == 0u) ?
+				Matrix4x4Calculation::MakeQuaternionAffineMatrix(scale, { .x = 0.0f,.y = std::sin(0.05f * value),.z = 0.0f,.w = std::cos(0.05f * value) }, translate) :
+				Matrix4x4Calculation::MakeAffineMatrix(scale, { .x = 0.1f * value,.y = 0.2f,.z = -0.3f * value }, translate);
+			Matrix4x4 world = (i >= 4u) ? Matrix4x4Calculation::Multiply(local, hierarchy.GetWorldMatrix(i % 4u)) : local;
+			if (IsNearlyEqual(world, hierarchy.GetWorldMatrix(i)) == false) {
+				isSame = false;
+			}
+		}
+		Check(isSame, "batched local matrices match scalar", isValid);
+
+		//1つだけ動かした次のフレームでも全部書かれているか
+		//リングの領域はフレームごとに違うので前の内容は残っていない
+		hierarchy.SetTranslate(5u, { .x = 3.0f,.y = 3.0f,.z = 3.0f });
+		hierarchy.Update();
+		std::vector<uint8_t> frameData(static_cast<size_t>(hierarchy.GetCount()) * Elysia::TransformHierarchy::CONSTANT_STRIDE_, 0u);
+		hierarchy.WriteConstants(frameData.data());
+		bool isAllWritten = true;
+		for (uint32_t node = 0u; node < count; ++node) {
+			const Elysia::TransformHierarchy::ConstantData* data = reinterpret_cast<const Elysia::TransformHierarchy::ConstantData*>(frameData.data() + static_cast<size_t>(node) * Elysia::TransformHierarchy::CONSTANT_STRIDE_);
+			if (IsNearlyEqual(data->world, hierarchy.GetWorldMatrix(node)) == false) {
+				isAllWritten = false;
+			}
+		}
+		Check(hierarchy.GetUpdatedNodes().size() == 1u && isAllWritten, "every live node written each frame", isValid);
+		return isValid;
+	}
+
+}
+
+int main() {
+	std::printf("%u objects, %u parents, %u frames\n", OBJECT_COUNT_, PARENT_COUNT_, FRAME_COUNT_);
+	Run(0.0f);
+	Run(0.05f);
+	Run(0.25f);
+	Run(1.0f);
+
+	//確認
+	bool isValid = CheckParent();
+	isValid = CheckCalculation() && isValid;
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,251 @@
+/**
+ * @file VoicePoolBenchmark.cpp
+ * @brief 効果音を重ねて鳴らすボイスプール(VoicePool)の確認とベンチマーク
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include "VoicePool.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// 時間を進めると鳴り終わる偽のバックエンド
+	/// </summary>
+	class FakeVoiceBackend final : public Elysia::IVoiceBackend {
+	public:
+		uint32_t CreateVoice(const Elysia::AudioFormat& format) override {
+			voices_.push_back({ .format = format, .remainingFrameCount = 0u, .volume = 0.0f, .startCount = 0u });
+			return uint32_t(voices_.size() - 1u);
+		}
+
+		void Start(const uint32_t& voiceId, const Elysia::VoiceBuffer& buffer, const float& volume) override {
+			FakeVoice& voice = voices_[voiceId];
+			voice.remainingFrameCount = buffer.byteCount / voice.format.GetBlockAlign() * (buffer.loopCount + 1u);
+			voice.volume = volume;
+			++voice.startCount;
+		}
+
+		void Stop(const uint32_t& voiceId) override {
+			voices_[voiceId].remainingFrameCount = 0u;
+		}
+
+		void SetVolume(const uint32_t& voiceId, const float& volume) override {
+			voices_[voiceId].volume = volume;
+		}
+
+		void SetStereoGains(const uint32_t& voiceId, const float& left, const float& right) override {
+			//このベンチマークでは左右は見ない
+			voiceId;
+			left;
+			right;
+		}
+
+		bool IsPlaying(const uint32_t& voiceId) const override {
+			return voices_[voiceId].remainingFrameCount > 0u;
+		}
+
+		/// <summary>
+		/// 時間を進める
+		/// </summary>
+		/// <param name="frameCount">フレーム数</param>
+		void Advance(const uint32_t& frameCount) {
+			for (FakeVoice& voice : voices_) {
+				voice.remainingFrameCount -= std::min(voice.remainingFrameCount, frameCount);
+			}
+		}
+
+		/// <summary>
+		/// 鳴っている数
+		/// </summary>
+		/// <returns>数</returns>
+		uint32_t GetPlayingCount() const {
+			return uint32_t(std::count_if(voices_.begin(), voices_.end(), [](const FakeVoice& voice) {
+				return voice.remainingFrameCount > 0u;
+			}));
+		}
+
+		/// <summary>
+		/// 作ったボイスの数
+		/// </summary>
+		/// <returns>数</returns>
+		uint32_t GetVoiceCount() const {
+			return uint32_t(voices_.size());
+		}
+
+		/// <summary>
+		/// 音量
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <returns>音量</returns>
+		float GetVolume(const uint32_t& voiceId) const {
+			return voices_[voiceId].volume;
+		}
+
+	private:
+		struct FakeVoice {
+			Elysia::AudioFormat format;
+			uint32_t remainingFrameCount;
+			float volume;
+			uint32_t startCount;
+		};
+		std::vector<FakeVoice> voices_;
+	};
+
+	//44.1kHzの16bitステレオ(足音など)
+	const Elysia::AudioFormat STEREO_FORMAT = { .channelCount = 2u, .sampleRate = 44100u, .bitsPerSample = 16u };
+	//48kHzの16bitモノラル(敵の声など)
+	const Elysia::AudioFormat MONO_FORMAT = { .channelCount = 1u, .sampleRate = 48000u, .bitsPerSample = 16u };
+
+	/// <summary>
+	/// 鳴らすもの
+	/// </summary>
+	/// <param name="format">形式</param>
+	/// <param name="frameCount">長さ</param>
+	/// <returns>鳴らすもの</returns>
+	Elysia::VoiceBuffer MakeBuffer(const Elysia::AudioFormat& format, const uint32_t& frameCount) {
+		static std::vector<uint8_t> data(1024u * 1024u);
+		return { .data = data.data(), .byteCount = frameCount * format.GetBlockAlign(), .loopCount = 0u };
+	}
+
+	/// <summary>
+	/// 重ねて鳴らす、横取り、ハンドル
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckBasic(bool& isValid) {
+		const uint32_t VOICE_COUNT = 8u;
+		FakeVoiceBackend backend;
+		Elysia::VoicePool pool;
+		pool.Initialize(&backend);
+		pool.Reserve(STEREO_FORMAT, VOICE_COUNT);
+		pool.Reserve(MONO_FORMAT, 4u);
+		//同じ形式をもう一度Reserveしても増えない
+		pool.Reserve(STEREO_FORMAT, VOICE_COUNT);
+		uint32_t createdCount = backend.GetVoiceCount();
+		Check(createdCount == VOICE_COUNT + 4u, "形式ごとに先に作っておく", isValid);
+
+		//同じ音を続けて鳴らしても途切れない
+		std::vector<Elysia::VoiceHandle> handles;
+		for (uint32_t i = 0u; i < VOICE_COUNT; ++i) {
+			handles.push_back(pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 10000u), 0, 1.0f));
+			backend.Advance(10u);
+		}
+		bool isAllPlaying = std::all_of(handles.begin(), handles.end(), [&pool](const Elysia::VoiceHandle& handle) {
+			return pool.IsPlaying(handle);
+		});
+		Check(isAllPlaying == true && backend.GetPlayingCount() == VOICE_COUNT, "同じ音を重ねて鳴らす", isValid);
+
+		//いっぱいなら一番古いものを横取りする
+		Elysia::VoiceHandle newHandle = pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 10000u), 0, 1.0f);
+		bool isOldestStolen = newHandle.IsValid() == true && newHandle.index == handles[0].index &&
+			pool.IsPlaying(handles[0]) == false && pool.IsPlaying(handles[1]) == true;
+		Check(isOldestStolen == true && pool.GetStatistics().stolenCount == 1u, "同じ優先度なら一番古いものを横取り", isValid);
+
+		//古いハンドルでは新しい音に触れない
+		pool.Stop(handles[0]);
+		pool.SetVolume(handles[0], 0.25f);
+		Check(pool.IsPlaying(newHandle) == true && backend.GetVolume(newHandle.index) == 1.0f, "古いハンドルは無効", isValid);
+
+		//いっぱいの時は低い優先度の音は鳴らせない
+		Elysia::VoiceHandle lowRejectedHandle = pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 10000u), -5, 1.0f);
+		Check(lowRejectedHandle.IsValid() == false && pool.GetStatistics().rejectedCount == 1u, "低い優先度の音は横取りしない", isValid);
+
+		//優先度の高い音は低いものから横取りする
+		pool.Stop(newHandle);
+		Elysia::VoiceHandle lowHandle = pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 10000u), -5, 1.0f);
+		Elysia::VoiceHandle highHandle = pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 10000u), 10, 1.0f);
+		Check(lowHandle.IsValid() == true && highHandle.IsValid() == true && highHandle.index == lowHandle.index, "優先度の低いものから横取り", isValid);
+
+		//全部が高い優先度なら低いものは鳴らさない
+		for (uint32_t i = 0u; i < VOICE_COUNT; ++i) {
+			pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 10000u), 10, 1.0f);
+		}
+		Elysia::VoiceHandle rejectedHandle = pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 10000u), 0, 1.0f);
+		Check(rejectedHandle.IsValid() == false && pool.GetStatistics().rejectedCount == 2u, "全部が高い優先度なら鳴らさない", isValid);
+
+		//形式が違えば別のボイス
+		Elysia::VoiceHandle monoHandle = pool.Play(MONO_FORMAT, MakeBuffer(MONO_FORMAT, 100u), 0, 0.5f);
+		Check(monoHandle.IsValid() == true && backend.GetPlayingCount() == VOICE_COUNT + 1u, "形式ごとに分ける", isValid);
+
+		//鳴り終わったものは横取りせずに使う
+		backend.Advance(20000u);
+		uint32_t stolenCount = pool.GetStatistics().stolenCount;
+		for (uint32_t i = 0u; i < VOICE_COUNT; ++i) {
+			pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 10000u), 0, 1.0f);
+		}
+		Check(pool.GetStatistics().stolenCount == stolenCount && pool.IsPlaying(monoHandle) == false, "鳴り終わったものを使う", isValid);
+		Check(backend.GetVoiceCount() == createdCount, "鳴らす時にボイスを作らない", isValid);
+	}
+
+	/// <summary>
+	/// 足音、鍵、敵の声を重ねて鳴らし続ける
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Simulate(bool& isValid) {
+		FakeVoiceBackend backend;
+		Elysia::VoicePool pool;
+		pool.Initialize(&backend);
+		pool.Reserve(STEREO_FORMAT, 8u);
+		pool.Reserve(MONO_FORMAT, 8u);
+
+		//1フレーム(60fps)は735サンプル
+		const uint32_t FRAME_SAMPLE_COUNT = 735u;
+		const uint32_t FRAME_COUNT = 60u * 600u;
+		uint32_t seed = 12345u;
+		auto random = [&seed]() {
+			seed = seed * 1664525u + 1013904223u;
+			return seed >> 8u;
+		};
+
+		uint32_t highPriorityCount = 0u;
+		uint32_t highPriorityPlayedCount = 0u;
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t frame = 0u; frame < FRAME_COUNT; ++frame) {
+			//足音は毎フレームのように鳴る(優先度低、ボイスより多く重なる)
+			if (frame % 2u == 0u) {
+				pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 12000u), 0, 0.5f);
+			}
+			if (frame % 3u == 0u) {
+				pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 8000u), 0, 0.5f);
+			}
+			//敵の声はたまに(優先度中)
+			if (random() % 20u == 0u) {
+				pool.Play(MONO_FORMAT, MakeBuffer(MONO_FORMAT, 30000u), 5, 1.0f);
+			}
+			//鍵を拾う音はまれ(優先度高)
+			if (random() % 300u == 0u) {
+				++highPriorityCount;
+				highPriorityPlayedCount += uint32_t(pool.Play(STEREO_FORMAT, MakeBuffer(STEREO_FORMAT, 20000u), 10, 1.0f).IsValid());
+			}
+			backend.Advance(FRAME_SAMPLE_COUNT);
+		}
+		double elapsedMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		const Elysia::VoicePool::Statistics& statistics = pool.GetStatistics();
+		std::printf("  %uフレーム  鳴らした %u 回  横取り %u 回  鳴らせなかった %u 回\n", FRAME_COUNT, statistics.playCount, statistics.stolenCount, statistics.rejectedCount);
+		std::printf("  Play 平均 %.1f ns\n", elapsedMilliseconds * 1000000.0 / double(statistics.playCount));
+		Check(highPriorityPlayedCount == highPriorityCount, "優先度の高い音は必ず鳴る", isValid);
+		Check(backend.GetVoiceCount() == 16u, "ボイスは増えない", isValid);
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("基本\n");
+	CheckBasic(isValid);
+	std::printf("シミュレーション\n");
+	Simulate(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
@@ -0,0 +1,380 @@
+/**
+ * @file WaveFileBenchmark.cpp
+ * @brief メモリマップドファイルで開くWAVファイル(WaveFile)の確認とベンチマーク
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+
+#include "WaveFile.h"
+
+#include "Platform/BenchmarkCheck.h"
+
+namespace {
+
+	//確認は全部のベンチマークで共通
+	using Benchmark::Check;
+
+	/// <summary>
+	/// WAVファイルを組み立てる
+	/// </summary>
+	class WaveWriter final {
+	public:
+		/// <summary>
+		/// 値を足す
+		/// </summary>
+		/// <typeparam name="T">型</typeparam>
+		/// <param name="value">値</param>
+		template<typename T>
+		void Add(const T& value) {
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+			bytes_.insert(bytes_.end(), bytes, bytes + sizeof(T));
+		}
+
+		/// <summary>
+		/// 識別子を足す
+		/// </summary>
+		/// <param name="id">識別子</param>
+		void AddId(const char* id) {
+			bytes_.insert(bytes_.end(), id, id + 4);
+		}
+
+		/// <summary>
+		/// チャンクを足す(奇数なら1バイト埋める)
+		/// </summary>
+		/// <param name="id">識別子</param>
+		/// <param name="body">中身</param>
+		void AddChunk(const char* id, const std::vector<uint8_t>& body) {
+			AddId(id);
+			Add(uint32_t(body.size()));
+			bytes_.insert(bytes_.end(), body.begin(), body.end());
+			if (body.size() % 2u == 1u) {
+				bytes_.push_back(0u);
+			}
+		}
+
+		/// <summary>
+		/// 中身を取得
+		/// </summary>
+		/// <returns>中身</returns>
+		std::vector<uint8_t>& GetBytes() {
+			return bytes_;
+		}
+
+	private:
+		std::vector<uint8_t> bytes_;
+	};
+
+	/// <summary>
+	/// 値を並べる
+	/// </summary>
+	/// <param name="values">値</param>
+	/// <returns>バイト列</returns>
+	std::vector<uint8_t> ToBytes(const std::vector<uint32_t>& values) {
+		std::vector<uint8_t> bytes(values.size() * sizeof(uint32_t));
+		std::memcpy(bytes.data(), values.data(), bytes.size());
+		return bytes;
+	}
+
+	/// <summary>
+	/// 色々なチャンクが入ったWAVファイルを作る
+	/// </summary>
+	/// <param name="frameCount">フレーム数</param>
+	/// <returns>ファイルの中身</returns>
+	std::vector<uint8_t> MakeRichWave(const uint32_t& frameCount) {
+		WaveWriter body;
+		body.AddId("WAVE");
+		//DAWが書き出すbextとJUNK
+		body.AddChunk("JUNK", std::vector<uint8_t>(28u, 0u));
+		body.AddChunk("bext", std::vector<uint8_t>(603u, 0x20u));
+
+		//WAVEFORMATEXTENSIBLEの16bitステレオ
+		WaveWriter format;
+		format.Add(uint16_t(0xFFFEu));
+		format.Add(uint16_t(2u));
+		format.Add(uint32_t(44100u));
+		format.Add(uint32_t(44100u * 4u));
+		format.Add(uint16_t(4u));
+		format.Add(uint16_t(16u));
+		format.Add(uint16_t(22u));
+		format.Add(uint16_t(16u));
+		format.Add(uint32_t(3u));
+		//KSDATAFORMAT_SUBTYPE_PCM
+		format.Add(uint16_t(1u));
+		for (uint32_t i = 0u; i < 14u; ++i) {
+			format.Add(uint8_t(i));
+		}
+		body.AddChunk("fmt ", format.GetBytes());
+
+		//ラベル
+		body.AddChunk("LIST", { 'a','d','t','l','l','a','b','l', 5u, 0u, 0u, 0u, 1u, 0u, 0u, 0u, 'A' });
+
+		//PCM
+		std::vector<uint8_t> pcm(size_t(frameCount) * 4u);
+		for (size_t i = 0u; i < pcm.size(); ++i) {
+			pcm[i] = uint8_t(i * 7u);
+		}
+		body.AddChunk("data", pcm);
+
+		//目印2つ
+		body.AddChunk("cue ", ToBytes({ 2u, 1u, 100u, 0x61746164u, 0u, 0u, 100u, 2u, 900u, 0x61746164u, 0u, 0u, 900u }));
+		//ループ1つ(終わりのフレームも含む)
+		body.AddChunk("smpl", ToBytes({ 0u, 0u, 22675u, 60u, 0u, 0u, 0u, 1u, 0u, 1u, 0u, 100u, 899u, 0u, 0u }));
+
+		WaveWriter file;
+		file.AddId("RIFF");
+		file.Add(uint32_t(body.GetBytes().size()));
+		std::vector<uint8_t> bytes = file.GetBytes();
+		bytes.insert(bytes.end(), body.GetBytes().begin(), body.GetBytes().end());
+		return bytes;
+	}
+
+	/// <summary>
+	/// 解析した結果がファイルの中に収まっているか
+	/// </summary>
+	/// <param name="data">ファイルの中身</param>
+	/// <param name="size">バイト数</param>
+	/// <param name="information">解析した結果</param>
+	/// <returns>収まっているかどうか</returns>
+	bool IsInside(const uint8_t* data, const size_t& size, const Elysia::WaveInformation& information) {
+		uint32_t blockAlign = information.format.GetBlockAlign();
+		if (blockAlign == 0u || information.byteCount == 0u || information.byteCount % blockAlign != 0u) {
+			return false;
+		}
+		if (information.data < data || information.data + information.byteCount > data + size) {
+			return false;
+		}
+		uint32_t frameCount = information.byteCount / blockAlign;
+		for (const Elysia::WaveLoop& loop : information.loops) {
+			if (loop.length == 0u || uint64_t(loop.begin) + loop.length > frameCount) {
+				return false;
+			}
+		}
+		for (const Elysia::WaveCue& cue : information.cues) {
+			if (cue.position >= frameCount) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// チャンクの解析
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void CheckParse(bool& isValid) {
+		std::vector<uint8_t> bytes = MakeRichWave(1000u);
+		Elysia::WaveInformation information = {};
+		bool isParsed = Elysia::WaveFile::Parse(bytes.data(), bytes.size(), information);
+		Check(isParsed == true && information.format.channelCount == 2u && information.format.sampleRate == 44100u &&
+			information.format.bitsPerSample == 16u && information.format.isFloat == false, "WAVEFORMATEXTENSIBLEのfmt", isValid);
+		Check(isParsed == true && information.byteCount == 4000u && information.data[4] == uint8_t(4u * 7u), "知らないチャンクを飛ばしてdataを指す", isValid);
+		Check(information.loops.size() == 1u && information.loops[0].begin == 100u && information.loops[0].length == 800u && information.loops[0].playCount == 0u, "smplのループ", isValid);
+		Check(information.cues.size() == 2u && information.cues[0].position == 100u && information.cues[1].id == 2u && information.cues[1].position == 900u, "cueの目印", isValid);
+
+		//書き出しの途中で切れたファイルはある分だけ
+		size_t dataOffset = size_t(information.data - bytes.data());
+		Elysia::WaveInformation truncated = {};
+		bool isTruncatedParsed = Elysia::WaveFile::Parse(bytes.data(), dataOffset + 1001u, truncated);
+		Check(isTruncatedParsed == true && truncated.byteCount == 1000u && truncated.loops.empty() == true, "切れたdataはフレームの区切りまで", isValid);
+
+		//RIFFの大きさが間違っていてもファイルの大きさまで
+		std::vector<uint8_t> wrongSize = bytes;
+		uint32_t hugeSize = 0xFFFFFFF0u;
+		std::memcpy(wrongSize.data() + 4u, &hugeSize, sizeof(hugeSize));
+		Elysia::WaveInformation wrongSizeInformation = {};
+		Check(Elysia::WaveFile::Parse(wrongSize.data(), wrongSize.size(), wrongSizeInformation) == true && wrongSizeInformation.loops.size() == 1u, "RIFFの大きさが間違っていても読む", isValid);
+
+		//読めないもの
+		Elysia::WaveInformation invalid = {};
+		std::vector<uint8_t> notRiff = bytes;
+		notRiff[0] = 'X';
+		std::vector<uint8_t> adpcm = bytes;
+		size_t formatOffset = std::search(adpcm.begin(), adpcm.end(), std::begin("fmt "), std::end("fmt ") - 1) - adpcm.begin();
+		adpcm[formatOffset + 8u] = 2u;
+		adpcm[formatOffset + 9u] = 0u;
+		bool isRejected = Elysia::WaveFile::Parse(notRiff.data(), notRiff.size(), invalid) == false &&
+			Elysia::WaveFile::Parse(adpcm.data(), adpcm.size(), invalid) == false &&
+			Elysia::WaveFile::Parse(bytes.data(), dataOffset - 8u, invalid) == false &&
+			Elysia::WaveFile::Parse(bytes.data(), 11u, invalid) == false &&
+			Elysia::WaveFile::Parse(nullptr, 0u, invalid) == false;
+		Check(isRejected == true, "RIFFでない、鳴らせない形式、dataが無い", isValid);
+	}
+
+	/// <summary>
+	/// 壊したファイルを読ませる
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Fuzz(bool& isValid) {
+		const uint32_t ITERATION_COUNT = 200000u;
+		std::vector<uint8_t> original = MakeRichWave(300u);
+		uint32_t seed = 2463534242u;
+		auto random = [&seed]() {
+			seed ^= seed << 13u;
+			seed ^= seed >> 17u;
+			seed ^= seed << 5u;
+			return seed;
+		};
+
+		uint32_t parsedCount = 0u;
+		uint32_t outsideCount = 0u;
+		std::vector<uint8_t> bytes;
+
+		//決まった壊し方
+		//RIFFの大きさがWAVEの4バイトより小さい
+		bool isSmallRiffRejected = true;
+		for (uint32_t riffSize = 0u; riffSize < 4u; ++riffSize) {
+			for (size_t length : { size_t(12u), size_t(13u), size_t(19u), size_t(20u), original.size() }) {
+				std::vector<uint8_t> exact(original.begin(), original.begin() + length);
+				std::memcpy(exact.data() + 4u, &riffSize, sizeof(riffSize));
+				Elysia::WaveInformation information = {};
+				isSmallRiffRejected = isSmallRiffRejected && Elysia::WaveFile::Parse(exact.data(), exact.size(), information) == false;
+			}
+		}
+		Check(isSmallRiffRejected == true, "RIFFの大きさが0から3", isValid);
+		//全ての長さで切る(チャンクのヘッダの途中で切れるものを含む)
+		for (size_t length = 0u; length <= original.size(); ++length) {
+			std::vector<uint8_t> exact(original.begin(), original.begin() + length);
+			Elysia::WaveInformation information = {};
+			if (Elysia::WaveFile::Parse(exact.data(), exact.size(), information) == true &&
+				IsInside(exact.data(), exact.size(), information) == false) {
+				++outsideCount;
+			}
+		}
+		for (uint32_t iteration = 0u; iteration < ITERATION_COUNT; ++iteration) {
+			bytes = original;
+			//バイトを書き換える、大きさを壊す、切る
+			uint32_t mutationCount = 1u + random() % 8u;
+			for (uint32_t i = 0u; i < mutationCount; ++i) {
+				size_t offset = random() % bytes.size();
+				switch (random() % 3u) {
+				case 0u:
+					bytes[offset] = uint8_t(random());
+					break;
+				case 1u: {
+					uint32_t value = (random() % 2u == 0u) ? random() : 0xFFFFFFFFu - random() % 16u;
+					if (offset + 4u <= bytes.size()) {
+						std::memcpy(bytes.data() + offset, &value, sizeof(value));
+					}
+					break;
+				}
+				default:
+					bytes.resize(offset + 1u);
+					break;
+				}
+			}
+			//ちょうど終わりまでの領域に入れ直して、はみ出しがあれば分かるように
+			std::vector<uint8_t> exact(bytes.begin(), bytes.end());
+			Elysia::WaveInformation information = {};
+			if (Elysia::WaveFile::Parse(exact.data(), exact.size(), information) == true) {
+				++parsedCount;
+				if (IsInside(exact.data(), exact.size(), information) == false) {
+					++outsideCount;
+				}
+			}
+		}
+		std::printf("  %u回壊して %u回読めた\n", ITERATION_COUNT, parsedCount);
+		Check(outsideCount == 0u, "読めたものは全部ファイルの中を指す", isValid);
+	}
+
+	/// <summary>
+	/// 今までの読み込み
+	/// ifstreamで読んでnew char[]にコピーする(JUNKは1つだけ飛ばせる)
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <param name="byteCount">PCMのバイト数</param>
+	/// <returns>PCM</returns>
+	char* LoadLegacy(const std::string& filePath, uint32_t& byteCount) {
+		std::ifstream file(filePath, std::ios_base::binary);
+		char riff[12] = {};
+		file.read(riff, sizeof(riff));
+		char chunkId[4] = {};
+		uint32_t chunkSize = 0u;
+		file.read(chunkId, 4);
+		file.read(reinterpret_cast<char*>(&chunkSize), 4);
+		char format[18] = {};
+		file.read(format, std::min<uint32_t>(chunkSize, sizeof(format)));
+		file.read(chunkId, 4);
+		file.read(reinterpret_cast<char*>(&chunkSize), 4);
+		if (std::memcmp(chunkId, "JUNK", 4u) == 0) {
+			file.seekg(chunkSize, std::ios_base::cur);
+			file.read(chunkId, 4);
+			file.read(reinterpret_cast<char*>(&chunkSize), 4);
+		}
+		char* buffer = new char[chunkSize];
+		file.read(buffer, chunkSize);
+		byteCount = chunkSize;
+		return buffer;
+	}
+
+	/// <summary>
+	/// Resources/Audioで今までの読み込みと比べる
+	/// </summary>
+	/// <param name="isValid">全体の結果</param>
+	void Measure(bool& isValid) {
+		const uint32_t ITERATION_COUNT = 20u;
+		std::vector<std::string> filePaths;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(std::string(ELYSIA_RESOURCES_DIRECTORY) + "Audio/")) {
+			if (entry.is_regular_file() == true && entry.path().extension() == ".wav") {
+				filePaths.push_back(entry.path().string());
+			}
+		}
+		std::sort(filePaths.begin(), filePaths.end());
+
+		std::printf("  %-16s %9s | %10s %10s | %7s\n", "file", "bytes", "legacy[us]", "mapped[us]", "same");
+		double legacyTotal = 0.0;
+		double mappedTotal = 0.0;
+		bool isAllSame = true;
+		for (const std::string& filePath : filePaths) {
+			double legacyMicroseconds = 0.0;
+			double mappedMicroseconds = 0.0;
+			bool isSame = true;
+			for (uint32_t i = 0u; i < ITERATION_COUNT; ++i) {
+				auto start = std::chrono::steady_clock::now();
+				uint32_t legacyByteCount = 0u;
+				char* legacy = LoadLegacy(filePath, legacyByteCount);
+				legacyMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+				start = std::chrono::steady_clock::now();
+				Elysia::WaveFile waveFile;
+				bool isOpened = waveFile.Open(filePath);
+				mappedMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+				//同じPCMを指しているか(比べると全部のページに触るので時間の外で)
+				const Elysia::WaveInformation& information = waveFile.GetInformation();
+				isSame = isSame && isOpened == true && information.byteCount == legacyByteCount &&
+					std::memcmp(information.data, legacy, legacyByteCount) == 0;
+				delete[] legacy;
+			}
+			legacyTotal += legacyMicroseconds;
+			mappedTotal += mappedMicroseconds;
+			isAllSame = isAllSame && isSame;
+			std::printf("  %-16s %9ju | %10.1f %10.1f | %7s\n", std::filesystem::path(filePath).filename().string().c_str(),
+				static_cast<uintmax_t>(std::filesystem::file_size(filePath)), legacyMicroseconds / ITERATION_COUNT, mappedMicroseconds / ITERATION_COUNT,
+				(isSame == true) ? "yes" : "no");
+		}
+		std::printf("  合計 今まで %.1f us  マップ %.1f us (%.1f倍)\n", legacyTotal / ITERATION_COUNT, mappedTotal / ITERATION_COUNT, legacyTotal / std::max(mappedTotal, 0.001));
+		Check(filePaths.empty() == false && isAllSame == true, "今までの読み込みと同じPCM", isValid);
+	}
+
+}
+
+int main() {
+	bool isValid = true;
+	std::printf("チャンク\n");
+	CheckParse(isValid);
+	std::printf("壊れたファイル\n");
+	Fuzz(isValid);
+	std::printf("Resources/Audio\n");
+	Measure(isValid);
+
+	return (isValid == true) ? 0 : 1;
+}
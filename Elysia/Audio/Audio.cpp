@@ -1,5 +1,8 @@
 #include "Audio.h"
 
+#include "Camera.h"
+#include "Profiler.h"
+
 
 uint32_t Elysia::Audio::index_ = 0u;
 
@@ -55,6 +58,46 @@ void Elysia::Audio::Initialize() {
 	//聞き手
 	emitter_.ChannelCount = 1;
 	emitter_.CurveDistanceScaler = emitter_.DopplerScaler = 1.0f;
+
+	//ストリーミングで展開するスレッド
+	streamer_.Initialize(STREAMING_INTERVAL_);
+
+	//重ねて鳴らす効果音のボイス
+	XAUDIO2_VOICE_DETAILS masterVoiceDetails = {};
+	masterVoice_->GetVoiceDetails(&masterVoiceDetails);
+	voiceBackend_.Initialize(xAudio2_.Get(), masterVoiceDetails.InputChannels);
+	voicePool_.Initialize(&voiceBackend_);
+
+	//3Dの音
+	emitterSystem_.Initialize(&voicePool_, MAX_EMITTER_COUNT_);
+
+	//ソフトウェアミキサー
+	AudioMixer::Settings mixerSettings = {
+		.sampleRate = MIXER_SAMPLE_RATE_,
+		.framesPerBlock = MIXER_FRAMES_PER_BLOCK_,
+	};
+	mixer_.Initialize(mixerSettings);
+	std::unique_ptr<MixerDecoder> mixerDecoder = std::make_unique<MixerDecoder>();
+	//止めるまでずっと混ぜる
+	mixerDecoder->Initialize(&mixer_, 0u);
+
+	//ステレオのfloatで流す
+	WAVEFORMATEX mixerWaveFormat = ToWaveFormat(mixer_.GetOutputFormat());
+	AudioStream::Settings mixerStreamSettings = {
+		.bufferCount = MIXER_BUFFER_COUNT_,
+		.framesPerBuffer = MIXER_FRAMES_PER_BLOCK_,
+	};
+	mixerStream_ = std::make_unique<AudioStream>();
+	mixerSink_ = std::make_unique<XAudio2StreamSink>();
+	mixerSink_->Initialize(xAudio2_.Get(), mixerWaveFormat, mixerStream_.get(), &streamer_);
+	mixerStream_->Initialize(std::move(mixerDecoder), mixerSink_.get(), mixerStreamSettings);
+	streamer_.Add(mixerStream_.get());
+
+	//何も鳴らしていない間も無音を流し続ける
+	mixerStream_->Restart(0u);
+	mixerStream_->Pump();
+	hResult = mixerSink_->GetSourceVoice()->Start(0);
+	assert(SUCCEEDED(hResult));
 }
 
 
@@ -63,6 +106,7 @@ void Elysia::Audio::Initialize() {
 
 #pragma region 基本セット
 uint32_t Elysia::Audio::Load(const std::string& fileName) {
+	ELYSIA_PROFILE_SCOPE("Audio::Load");
 
 	//一度読み込んだものは２度読み込まず返すだけ
 	if (Elysia::Audio::GetInstance()->audioInformation_.find(fileName) != Elysia::Audio::GetInstance()->audioInformation_.end()) {
@@ -114,97 +158,50 @@ uint32_t Elysia::Audio::LoadWave(const std::string& fileName) {
 	++index_;
 
 
-#pragma region １,ファイルオープン
-	//ファイル入力ストリームのインスタンス
-	std::ifstream file;
-	//.wavファイルをバイナリモードで開く
-	file.open(fileName, std::ios_base::binary);
-	//ファイルオープン失敗を検出する
-	assert(file.is_open());
-
-#pragma endregion
-
-#pragma region ２,wavデータ読み込み
-
-	//RIFFヘッダーの読み込み
-	RiffHeader riff;
-	file.read((char*)&riff, sizeof(riff));
-	//ファイルがRIFFかチェック
-	if (strncmp(riff.chunk.id, "RIFF", 4) != 0) {
-		assert(0);
-	}
-	//タイプがWAVEかチェック
-	if (strncmp(riff.type, "WAVE", 4) != 0) {
-		assert(0);
-	}
-
-	//Formatチャンクの読み込み
-	FormatChunk format = {};
-	//チャンクヘッダーの確認
-	file.read((char*)&format, sizeof(ChunkHeader));
-	//何かここ空白入れないとダメらしい
-	//後ろが4だからかな・・
-	if (strncmp(format.chunk.id, "fmt ", 4) != 0) {
-		assert(0);
-	}
-
-	//チャンク本体の読み込み
-	assert(format.chunk.size <= sizeof(format.fmt));
-	file.read((char*)&format.fmt, format.chunk.size);
-
-
-	//Dataチャンクの読み込み
-	ChunkHeader data;
-	file.read((char*)&data, sizeof(data));
-	//JUNKチャンクを検出した場合
-	if (strncmp(data.id, "JUNK", 4) == 0) {
-		//読み込み位置をJUNKチャンクの終わりまで進める
-		file.seekg(data.size, std::ios_base::cur);
-		//再読み込み
-		file.read((char*)&data, sizeof(data));
-
-	}
-
-	//メインのデータチャンク
-	if (strncmp(data.id, "data", 4) != 0) {
-		assert(0);
-	}
-
-	//Dataチャンクのデータ部(波形データ)の読み込み
-	char* pBuffer = new char[data.size];
-	file.read(pBuffer, data.size);
-#pragma endregion
-
-#pragma region ３,Waveファイルを閉じる
-	file.close();
-
+#pragma region １,ファイルを開く
+	//メモリマップドファイルで開いて、全部のチャンクを見る
+	//LIST、bext、JUNKなど知らないチャンクは飛ばす
+	std::shared_ptr<WaveFile> waveFile = std::make_shared<WaveFile>();
+	bool isOpened = waveFile->Open(fileName);
+	//開けない、WAVとして読めない、鳴らせない形式
+	assert(isOpened == true);
+	isOpened;
+	const WaveInformation& information = waveFile->GetInformation();
+	WAVEFORMATEX waveFormat = ToWaveFormat(information.format);
 
 #pragma endregion
 
-
-
-
-#pragma region 読み込んだ音声データを返す
-
+#pragma region ２,読み込んだ音声データを記録
 
 	//波形フォーマットを基にSourceVoiceの生成
 	HRESULT hResult = Elysia::Audio::GetInstance()->xAudio2_->CreateSourceVoice(
 		&Elysia::Audio::GetInstance()->audioInformation_[fileName].sourceVoice,
-		&format.fmt);
+		&waveFormat);
 	assert(SUCCEEDED(hResult));
 
+	//PCMはコピーせずにファイルを直接指す
+	//どのボイスで鳴らしても同じものを指すので、開いている間は重ねて鳴らして良い
 	SoundData newSoundData = {
-
-		.wfex = format.fmt,
-		.pBuffer = reinterpret_cast<BYTE*>(pBuffer),
-		.bufferSize = data.size,
+		.wfex = waveFormat,
+		.pBuffer = information.data,
+		.bufferSize = int32_t(information.byteCount),
 	};
 
 	//記録
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].fileName = fileName;
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].handle = handle;
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].soundData = newSoundData;
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].extension = "wave";
+	AudioInformation& audioInformation = Elysia::Audio::GetInstance()->audioInformation_[fileName];
+	audioInformation.fileName = fileName;
+	audioInformation.handle = handle;
+	audioInformation.soundData = newSoundData;
+	audioInformation.extension = "wave";
+	//smplチャンクのループ(無ければ全体)
+	if (information.loops.empty() == false) {
+		audioInformation.loopBegin = information.loops.front().begin;
+		audioInformation.loopLength = information.loops.front().length;
+	}
+	audioInformation.waveFile = std::move(waveFile);
+
+	//重ねて鳴らす時のボイスも読み込む時に作っておく
+	Elysia::Audio::GetInstance()->voicePool_.Reserve(ToAudioFormat(waveFormat), VOICE_COUNT_PER_FORMAT_);
 
 
 	//handleを返す
@@ -232,69 +229,57 @@ uint32_t Elysia::Audio::LoadMP3(const std::string& fileName) {
 
 
 	//記録
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].fileName = fileName;
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].handle = handle;
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].extension = "mp3";
-
-
-	//stringからLPCWCHARに変換する
-	int size_needed = MultiByteToWideChar(CP_UTF8, 0, fileName.c_str(), (int)fileName.size(), NULL, 0);
-	std::wstring wstr(size_needed, 0);
-	MultiByteToWideChar(CP_UTF8, 0, fileName.c_str(), (int)fileName.size(), &wstr[0], size_needed);
-	LPCWSTR lpcWString = wstr.c_str();
-
-
-	//ソースリーダーの作成
-	HRESULT hResult = MFCreateSourceReaderFromURL(lpcWString, nullptr, &Elysia::Audio::GetInstance()->audioInformation_[fileName].sourceReader);
-	assert(SUCCEEDED(hResult));
-
-
-
-	//メディアタイプの取得
-	IMFMediaType* pMFMediaType{ nullptr };
-	MFCreateMediaType(&pMFMediaType);
-	pMFMediaType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Audio);
-	pMFMediaType->SetGUID(MF_MT_SUBTYPE, MFAudioFormat_PCM);
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].sourceReader->SetCurrentMediaType(DWORD(MF_SOURCE_READER_FIRST_AUDIO_STREAM), nullptr, pMFMediaType);
-
-	pMFMediaType->Release();
-	pMFMediaType = nullptr;
-	Elysia::Audio::GetInstance()->audioInformation_[fileName].sourceReader->GetCurrentMediaType(DWORD(MF_SOURCE_READER_FIRST_AUDIO_STREAM), &pMFMediaType);
-
-	//オーディオデータ形式の作成
-	WAVEFORMATEX* waveFormat{};
-	MFCreateWaveFormatExFromMFMediaType(pMFMediaType, &waveFormat, nullptr);
-
-
+	AudioInformation& audioInformation = Elysia::Audio::GetInstance()->audioInformation_[fileName];
+	audioInformation.fileName = fileName;
+	audioInformation.handle = handle;
+	audioInformation.extension = "mp3";
+
+
+	//デコーダーを開く
+	std::unique_ptr<MediaFoundationDecoder> decoder = std::make_unique<MediaFoundationDecoder>();
+	decoder->Open(fileName);
+	const AudioFormat& format = decoder->GetFormat();
+	WAVEFORMATEX waveFormat = decoder->GetWaveFormat();
+
+	//長いBGMは少しずつ展開しながら再生する
+	//全部展開するとメモリを使う上に、読み込みで止まってしまう
+	if (float_t(decoder->GetFrameCount()) >= STREAMING_SECOND_ * float_t(format.sampleRate)) {
+		AudioStream::Settings settings = {
+			.bufferCount = STREAMING_BUFFER_COUNT_,
+			.framesPerBuffer = uint32_t(STREAMING_BUFFER_SECOND_ * float_t(format.sampleRate)),
+		};
+		audioInformation.stream = std::make_unique<AudioStream>();
+		audioInformation.streamSink = std::make_unique<XAudio2StreamSink>();
+		audioInformation.streamSink->Initialize(xAudio2_.Get(), waveFormat, audioInformation.stream.get(), &streamer_);
+		audioInformation.stream->Initialize(std::move(decoder), audioInformation.streamSink.get(), settings);
+		audioInformation.sourceVoice = audioInformation.streamSink->GetSourceVoice();
+		streamer_.Add(audioInformation.stream.get());
+		return handle;
+	}
 
-	while (true)
-	{
-		IMFSample* pMFSample{ nullptr };
-		DWORD dwStreamFlags{ 0 };
-		Audio::GetInstance()->audioInformation_[fileName].sourceReader->ReadSample(DWORD(MF_SOURCE_READER_FIRST_AUDIO_STREAM), 0, nullptr, &dwStreamFlags, nullptr, &pMFSample);
 
-		if (dwStreamFlags & MF_SOURCE_READERF_ENDOFSTREAM)
-		{
+	//短い効果音は全部展開しておく
+	//長さが分かっているので先に確保して、直接展開する(足りなければ増やす)
+	uint32_t blockAlign = format.GetBlockAlign();
+	std::vector<BYTE>& mediaData = audioInformation.mediaData;
+	mediaData.reserve(size_t(decoder->GetFrameCount() + DECODE_FRAME_COUNT_) * blockAlign);
+	size_t decodedBytes = 0u;
+	while (true) {
+		mediaData.resize(decodedBytes + size_t(DECODE_FRAME_COUNT_) * blockAlign);
+		uint32_t decodedFrameCount = decoder->Decode(mediaData.data() + decodedBytes, DECODE_FRAME_COUNT_);
+		decodedBytes += size_t(decodedFrameCount) * blockAlign;
+		if (decodedFrameCount < DECODE_FRAME_COUNT_) {
 			break;
 		}
-
-		IMFMediaBuffer* pMFMediaBuffer{ nullptr };
-		pMFSample->ConvertToContiguousBuffer(&pMFMediaBuffer);
-
-		BYTE* pBuffer{ nullptr };
-		DWORD cbCurrentLength{ 0 };
-		pMFMediaBuffer->Lock(&pBuffer, nullptr, &cbCurrentLength);
-
-		Elysia::Audio::GetInstance()->audioInformation_[fileName].mediaData.resize(Elysia::Audio::GetInstance()->audioInformation_[fileName].mediaData.size() + cbCurrentLength);
-		memcpy(Elysia::Audio::GetInstance()->audioInformation_[fileName].mediaData.data() + Elysia::Audio::GetInstance()->audioInformation_[fileName].mediaData.size() - cbCurrentLength, pBuffer, cbCurrentLength);
-
-		pMFMediaBuffer->Unlock();
-
-		pMFMediaBuffer->Release();
-		pMFSample->Release();
 	}
+	mediaData.resize(decodedBytes);
 
-	Elysia::Audio::GetInstance()->xAudio2_->CreateSourceVoice(&Elysia::Audio::GetInstance()->audioInformation_[fileName].sourceVoice, waveFormat);
+	HRESULT hResult = Elysia::Audio::GetInstance()->xAudio2_->CreateSourceVoice(&audioInformation.sourceVoice, &waveFormat);
+	assert(SUCCEEDED(hResult));
+	audioInformation.soundData.wfex = waveFormat;
+
+	//重ねて鳴らす時のボイスも読み込む時に作っておく
+	voicePool_.Reserve(format, VOICE_COUNT_PER_FORMAT_);
 
 
 	return handle;
@@ -330,6 +315,12 @@ void Elysia::Audio::PlayMP3(const uint32_t& audioHandle, const bool& isLoop) {
 	//ファイルキーの取得
 	std::string fileKey = GetAudioInformationKey(audioHandle);
 
+	//ストリーミング再生
+	if (audioInformation_[fileKey].stream != nullptr) {
+		PlayStream(audioInformation_[fileKey], (isLoop == true) ? AudioStream::LOOP_INFINITE_ : 0u);
+		return;
+	}
+
 	HRESULT hResult = audioInformation_[fileKey].sourceVoice->FlushSourceBuffers();
 	assert(SUCCEEDED(hResult));
 
@@ -358,6 +349,13 @@ void Elysia::Audio::PlayMP3(const uint32_t& audioHandle, const bool& isLoop) {
 void Elysia::Audio::PlayMP3(const uint32_t& audioHandle, const uint32_t& loopCount) {
 	//ファイルキーの取得
 	std::string fileKey = GetAudioInformationKey(audioHandle);
+
+	//ストリーミング再生
+	if (audioInformation_[fileKey].stream != nullptr) {
+		PlayStream(audioInformation_[fileKey], (loopCount > 0u) ? loopCount - 1u : 0u);
+		return;
+	}
+
 	HRESULT hResult = audioInformation_[fileKey].sourceVoice->FlushSourceBuffers();
 	assert(SUCCEEDED(hResult));
 
@@ -462,6 +460,177 @@ void Elysia::Audio::Stop(const uint32_t& audioHandle) {
 
 	HRESULT hResult = audioInformation_[fileKey].sourceVoice->Stop();
 	assert(SUCCEEDED(hResult));
+
+	//ストリーミングは送ってあるものを捨てて、展開も止める
+	if (audioInformation_[fileKey].stream != nullptr) {
+		audioInformation_[fileKey].stream->Stop();
+	}
+}
+
+#pragma endregion
+
+
+#pragma region 重ねて鳴らす効果音
+Elysia::VoiceHandle Elysia::Audio::PlayOneShot(const uint32_t& audioHandle, const int32_t& priority, const float_t& volume) {
+	//ファイルキーの取得
+	std::string fileKey = GetAudioInformationKey(audioHandle);
+	const AudioInformation& audioInformation = audioInformation_[fileKey];
+	//ストリーミングするBGMは重ねて鳴らせない
+	assert(audioInformation.stream == nullptr);
+
+	//全部展開してあるもの
+	VoiceBuffer buffer = {};
+	if (audioInformation.extension == "wave") {
+		buffer.data = audioInformation.soundData.pBuffer;
+		buffer.byteCount = uint32_t(audioInformation.soundData.bufferSize);
+	}
+	else {
+		buffer.data = audioInformation.mediaData.data();
+		buffer.byteCount = uint32_t(audioInformation.mediaData.size());
+	}
+	buffer.loopCount = 0u;
+
+	return voicePool_.Play(ToAudioFormat(audioInformation.soundData.wfex), buffer, priority, volume);
+}
+
+void Elysia::Audio::StopOneShot(const VoiceHandle& voiceHandle) {
+	voicePool_.Stop(voiceHandle);
+}
+
+void Elysia::Audio::ChangeOneShotVolume(const VoiceHandle& voiceHandle, const float_t& volume) {
+	voicePool_.SetVolume(voiceHandle, volume);
+}
+
+bool Elysia::Audio::IsPlayingOneShot(const VoiceHandle& voiceHandle) const {
+	return voicePool_.IsPlaying(voiceHandle);
+}
+
+#pragma endregion
+
+
+#pragma region 3Dの音
+uint32_t Elysia::Audio::CreateEmitter(const uint32_t& audioHandle, const AudioEmitterSettings& settings, const bool& isLoop) {
+	//ファイルキーの取得
+	std::string fileKey = GetAudioInformationKey(audioHandle);
+	const AudioInformation& audioInformation = audioInformation_[fileKey];
+	//ストリーミングするBGMは3Dで鳴らせない
+	assert(audioInformation.stream == nullptr);
+
+	//全部展開してあるもの
+	VoiceBuffer buffer = {};
+	if (audioInformation.extension == "wave") {
+		buffer.data = audioInformation.soundData.pBuffer;
+		buffer.byteCount = uint32_t(audioInformation.soundData.bufferSize);
+	}
+	else {
+		buffer.data = audioInformation.mediaData.data();
+		buffer.byteCount = uint32_t(audioInformation.mediaData.size());
+	}
+	buffer.loopCount = (isLoop == true) ? VoiceBuffer::LOOP_INFINITE_ : 0u;
+
+	return emitterSystem_.Create(ToAudioFormat(audioInformation.soundData.wfex), buffer, settings);
+}
+
+void Elysia::Audio::DestroyEmitter(const uint32_t& emitterId) {
+	emitterSystem_.Destroy(emitterId);
+}
+
+void Elysia::Audio::PlayEmitter(const uint32_t& emitterId) {
+	emitterSystem_.Play(emitterId);
+}
+
+void Elysia::Audio::StopEmitter(const uint32_t& emitterId) {
+	emitterSystem_.Stop(emitterId);
+}
+
+void Elysia::Audio::SetEmitterPosition(const uint32_t& emitterId, const Vector3& position) {
+	emitterSystem_.SetPosition(emitterId, position);
+}
+
+void Elysia::Audio::SetEmitterDirection(const uint32_t& emitterId, const Vector3& direction) {
+	emitterSystem_.SetDirection(emitterId, direction);
+}
+
+void Elysia::Audio::SetEmitterVolume(const uint32_t& emitterId, const float_t& volume) {
+	emitterSystem_.SetVolume(emitterId, volume);
+}
+
+void Elysia::Audio::SetEmitterOcclusion(const uint32_t& emitterId, const float_t& occlusion) {
+	emitterSystem_.SetOcclusion(emitterId, occlusion);
+}
+
+void Elysia::Audio::Update3D(const Camera& camera) {
+	//カメラのワールド行列の行がそれぞれ右、上、前を向いている
+	AudioListener listener = {
+		.position = camera.GetWorldPosition(),
+		.forward = {.x = camera.worldMatrix.m[2][0], .y = camera.worldMatrix.m[2][1], .z = camera.worldMatrix.m[2][2] },
+		.up = {.x = camera.worldMatrix.m[1][0], .y = camera.worldMatrix.m[1][1], .z = camera.worldMatrix.m[1][2] },
+	};
+	emitterSystem_.Update(listener);
+}
+
+#pragma endregion
+
+
+#pragma region ソフトウェアミキサー
+uint32_t Elysia::Audio::CreateMixerSource(const uint32_t& audioHandle, const uint32_t& busId) {
+	//ファイルキーの取得
+	std::string fileKey = GetAudioInformationKey(audioHandle);
+	const AudioInformation& audioInformation = audioInformation_[fileKey];
+	//ストリーミングするBGMはミキサーで鳴らせない
+	assert(audioInformation.stream == nullptr);
+
+	return mixer_.CreateSource(ToAudioFormat(audioInformation.soundData.wfex), busId);
+}
+
+void Elysia::Audio::PlayOnMixer(const uint32_t& sourceId, const uint32_t& audioHandle, const float_t& loopBeginSecond, const float_t& loopLengthSecond, const uint32_t& loopCount) {
+	//ファイルキーの取得
+	std::string fileKey = GetAudioInformationKey(audioHandle);
+	const AudioInformation& audioInformation = audioInformation_[fileKey];
+	assert(audioInformation.stream == nullptr);
+
+	//全部展開してあるもの
+	AudioMixer::SourceBuffer buffer = {};
+	if (audioInformation.extension == "wave") {
+		buffer.data = audioInformation.soundData.pBuffer;
+		buffer.byteCount = uint32_t(audioInformation.soundData.bufferSize);
+	}
+	else {
+		buffer.data = audioInformation.mediaData.data();
+		buffer.byteCount = uint32_t(audioInformation.mediaData.size());
+	}
+
+	//秒からフレームに直す
+	float_t sampleRate = float_t(audioInformation.soundData.wfex.nSamplesPerSec);
+	buffer.loopBegin = uint32_t(loopBeginSecond * sampleRate);
+	buffer.loopLength = uint32_t(loopLengthSecond * sampleRate);
+	buffer.loopCount = loopCount;
+	mixer_.Start(sourceId, buffer);
+}
+
+#pragma endregion
+
+
+#pragma region 形式
+Elysia::AudioFormat Elysia::Audio::ToAudioFormat(const WAVEFORMATEX& waveFormat) {
+	return {
+		.channelCount = waveFormat.nChannels,
+		.sampleRate = waveFormat.nSamplesPerSec,
+		.bitsPerSample = waveFormat.wBitsPerSample,
+		.isFloat = waveFormat.wFormatTag == WAVE_FORMAT_IEEE_FLOAT,
+	};
+}
+
+WAVEFORMATEX Elysia::Audio::ToWaveFormat(const AudioFormat& format) {
+	return {
+		.wFormatTag = WORD((format.isFloat == true) ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM),
+		.nChannels = WORD(format.channelCount),
+		.nSamplesPerSec = format.sampleRate,
+		.nAvgBytesPerSec = format.sampleRate * format.GetBlockAlign(),
+		.nBlockAlign = WORD(format.GetBlockAlign()),
+		.wBitsPerSample = WORD(format.bitsPerSample),
+		.cbSize = 0u,
+	};
 }
 
 #pragma endregion
@@ -472,6 +641,13 @@ void Elysia::Audio::ExitLoop(const uint32_t& audioHandle) {
 
 	//ファイルキーの取得
 	std::string fileKey = GetAudioInformationKey(audioHandle);
+
+	//ストリーミングは今の周の終わりで止める
+	if (audioInformation_[fileKey].stream != nullptr) {
+		audioInformation_[fileKey].stream->ExitLoop();
+		return;
+	}
+
 	//ExitLoop関数でループを抜ける
 	HRESULT hr = audioInformation_[fileKey].sourceVoice->ExitLoop();
 	assert(SUCCEEDED(hr));
@@ -588,6 +764,58 @@ void Elysia::Audio::PartlyLoopPlayWave(const uint32_t& audioHandle, const float_
 
 }
 
+void Elysia::Audio::EmbeddedLoopPlayWave(const uint32_t& audioHandle) {
+	//ファイルキーの取得
+	std::string fileKey = GetAudioInformationKey(audioHandle);
+	const AudioInformation& audioInformation = audioInformation_[fileKey];
+	//smplチャンクはWAVにしか無い
+	assert(audioInformation.waveFile != nullptr);
+
+	//再生する波形データの設定
+	XAUDIO2_BUFFER buffer{};
+	buffer.pAudioData = audioInformation.soundData.pBuffer;
+	buffer.AudioBytes = audioInformation.soundData.bufferSize;
+	buffer.Flags = XAUDIO2_END_OF_STREAM;
+	buffer.LoopCount = XAUDIO2_LOOP_INFINITE;
+	//読み込んだ時に範囲の中に収まっているか確かめてある
+	buffer.LoopBegin = audioInformation.loopBegin;
+	buffer.LoopLength = audioInformation.loopLength;
+
+	//Buffer登録
+	HRESULT hResult = audioInformation.sourceVoice->SubmitSourceBuffer(&buffer);
+	assert(SUCCEEDED(hResult));
+
+	//波形データの再生
+	hResult = audioInformation.sourceVoice->Start(0);
+	assert(SUCCEEDED(hResult));
+}
+
+void Elysia::Audio::SetLoopPoints(const uint32_t& audioHandle, const float_t& beginSecond, const float_t& endSecond) {
+	//ファイルキーの取得
+	std::string fileKey = GetAudioInformationKey(audioHandle);
+	//Waveと短いMP3は全部展開しているので、PartlyLoopPlayWaveなどを使ってね
+	assert(audioInformation_[fileKey].stream != nullptr);
+
+	//秒からフレームに直す
+	float_t sampleRate = float_t(audioInformation_[fileKey].stream->GetFormat().sampleRate);
+	audioInformation_[fileKey].stream->SetLoopRange(uint64_t(beginSecond * sampleRate), uint64_t(endSecond * sampleRate));
+}
+
+void Elysia::Audio::PlayStream(AudioInformation& audioInformation, const uint32_t& loopCount) {
+	//止めてから捨てないと、再生中のバッファが残ってしまう
+	HRESULT hResult = audioInformation.sourceVoice->Stop();
+	assert(SUCCEEDED(hResult));
+	audioInformation.stream->Restart(loopCount);
+
+	//すぐ鳴るように、空いているバッファはここで展開しておく
+	//残りは捨てたバッファが戻ってきたら展開するスレッドが埋める
+	audioInformation.stream->Pump();
+
+	//波形データの再生
+	hResult = audioInformation.sourceVoice->Start(0);
+	assert(SUCCEEDED(hResult));
+}
+
 #pragma endregion
 
 //一応マイナスにも出来るらしい
@@ -976,14 +1204,31 @@ void Elysia::Audio::Finalize() {
 
 	//pXAPO_->Finalize();
 
+	//展開するスレッドを先に止める
+	streamer_.Finalize();
+
+	//ソフトウェアミキサーの出力を止める
+	if (mixerSink_ != nullptr) {
+		mixerSink_->Finalize();
+		mixerSink_.reset();
+		mixerStream_.reset();
+	}
+
 	//あるもの全部消す
 	for (std::map<std::string, AudioInformation>::iterator it = audioInformation_.begin(); it != audioInformation_.end(); ++it) {
-		if ((*it).second.sourceVoice != nullptr) {
+		//ストリーミングのソースボイスは送り先が持っている
+		if ((*it).second.streamSink != nullptr) {
+			(*it).second.streamSink->Finalize();
+		}
+		else if ((*it).second.sourceVoice != nullptr) {
 			(*it).second.sourceVoice->DestroyVoice();
-			delete[](*it).second.soundData.pBuffer;
 		}
 	}
 
+	//重ねて鳴らす効果音のボイスを消す
+	voicePool_.StopAll();
+	voiceBackend_.Finalize();
+
 	//残りを消す
 	audioInformation_.clear();
 
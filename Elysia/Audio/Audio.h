@@ -34,6 +34,19 @@ using Microsoft::WRL::ComPtr;
 
 
 #include "AudioInformation.h"
+#include "MediaFoundationDecoder.h"
+#include "AudioStreamer.h"
+#include "VoicePool.h"
+#include "XAudio2VoiceBackend.h"
+#include "AudioEmitterSystem.h"
+#include "AudioMixer.h"
+#include "MixerDecoder.h"
+#include "WaveFile.h"
+
+/// <summary>
+/// カメラ
+/// </summary>
+struct Camera;
 
 
 namespace Elysia {
@@ -173,6 +186,142 @@ namespace Elysia {
 
 #pragma endregion
 
+#pragma region 重ねて鳴らす効果音
+
+		/// <summary>
+		/// 効果音を重ねて鳴らす
+		/// 読み込んだ時に作っておいたボイスから空いているものを使うので、同じ音を連続で鳴らしても途切れない
+		/// 空いていなければ優先度が低くて古いものを止めて鳴らす
+		/// </summary>
+		/// <param name="audioHandle">ハンドル</param>
+		/// <param name="priority">優先度(大きい方が優先)</param>
+		/// <param name="volume">音量</param>
+		/// <returns>鳴らしている音のハンドル(鳴らせなければ無効)</returns>
+		VoiceHandle PlayOneShot(const uint32_t& audioHandle, const int32_t& priority, const float_t& volume);
+
+		/// <summary>
+		/// 重ねて鳴らした効果音を止める
+		/// </summary>
+		/// <param name="voiceHandle">鳴らしている音のハンドル</param>
+		void StopOneShot(const VoiceHandle& voiceHandle);
+
+		/// <summary>
+		/// 重ねて鳴らした効果音の音量を変える
+		/// </summary>
+		/// <param name="voiceHandle">鳴らしている音のハンドル</param>
+		/// <param name="volume">音量</param>
+		void ChangeOneShotVolume(const VoiceHandle& voiceHandle, const float_t& volume);
+
+		/// <summary>
+		/// 重ねて鳴らした効果音が鳴っているかどうか
+		/// </summary>
+		/// <param name="voiceHandle">鳴らしている音のハンドル</param>
+		/// <returns>鳴っているかどうか</returns>
+		bool IsPlayingOneShot(const VoiceHandle& voiceHandle) const;
+
+#pragma endregion
+
+#pragma region 3Dの音
+
+		/// <summary>
+		/// 3Dの音を鳴らすエミッタを作る
+		/// 聞こえない間はボイスを使わないので、たくさん置いても良い
+		/// </summary>
+		/// <param name="audioHandle">ハンドル(全部展開してあるもの)</param>
+		/// <param name="settings">設定</param>
+		/// <param name="isLoop">ループするかどうか</param>
+		/// <returns>エミッタの番号</returns>
+		uint32_t CreateEmitter(const uint32_t& audioHandle, const AudioEmitterSettings& settings, const bool& isLoop);
+
+		/// <summary>
+		/// エミッタを消す
+		/// </summary>
+		/// <param name="emitterId">エミッタの番号</param>
+		void DestroyEmitter(const uint32_t& emitterId);
+
+		/// <summary>
+		/// エミッタを鳴らす
+		/// 実際に鳴り始めるのは聞こえる所にある時のUpdate3Dから
+		/// </summary>
+		/// <param name="emitterId">エミッタの番号</param>
+		void PlayEmitter(const uint32_t& emitterId);
+
+		/// <summary>
+		/// エミッタを止める
+		/// </summary>
+		/// <param name="emitterId">エミッタの番号</param>
+		void StopEmitter(const uint32_t& emitterId);
+
+		/// <summary>
+		/// エミッタの座標を設定
+		/// </summary>
+		/// <param name="emitterId">エミッタの番号</param>
+		/// <param name="position">座標</param>
+		void SetEmitterPosition(const uint32_t& emitterId, const Vector3& position);
+
+		/// <summary>
+		/// エミッタの向きを設定(コーンを使う時)
+		/// </summary>
+		/// <param name="emitterId">エミッタの番号</param>
+		/// <param name="direction">向き</param>
+		void SetEmitterDirection(const uint32_t& emitterId, const Vector3& direction);
+
+		/// <summary>
+		/// エミッタの音量を設定
+		/// </summary>
+		/// <param name="emitterId">エミッタの番号</param>
+		/// <param name="volume">音量</param>
+		void SetEmitterVolume(const uint32_t& emitterId, const float_t& volume);
+
+		/// <summary>
+		/// エミッタの遮られ具合を設定
+		/// </summary>
+		/// <param name="emitterId">エミッタの番号</param>
+		/// <param name="occlusion">遮られ具合(0なら遮られていない、1なら聞こえない)</param>
+		void SetEmitterOcclusion(const uint32_t& emitterId, const float_t& occlusion);
+
+		/// <summary>
+		/// 3Dの音の更新
+		/// カメラを聞き手にして全部のエミッタの大きさをまとめて計算し、変わったものだけボイスに伝える
+		/// カメラの更新の後に1回呼んでね
+		/// </summary>
+		/// <param name="camera">カメラ</param>
+		void Update3D(const Camera& camera);
+
+#pragma endregion
+
+
+#pragma region ソフトウェアミキサー
+
+		/// <summary>
+		/// ソフトウェアミキサーで鳴らすソースを作る
+		/// バスやフィルター、パンはGetMixerから設定してね
+		/// </summary>
+		/// <param name="audioHandle">ハンドル(全部展開してあるもの、形式を合わせる)</param>
+		/// <param name="busId">送り先のバス</param>
+		/// <returns>ソースの番号</returns>
+		uint32_t CreateMixerSource(const uint32_t& audioHandle, const uint32_t& busId);
+
+		/// <summary>
+		/// ソフトウェアミキサーで鳴らす
+		/// PartlyLoopPlayWaveと同じように範囲を決めてループ出来る
+		/// </summary>
+		/// <param name="sourceId">ソースの番号</param>
+		/// <param name="audioHandle">ハンドル</param>
+		/// <param name="loopBeginSecond">ループの始まり(秒)</param>
+		/// <param name="loopLengthSecond">ループの長さ(秒、0なら最後まで)</param>
+		/// <param name="loopCount">ループする回数(最初の1回は含まない)</param>
+		void PlayOnMixer(const uint32_t& sourceId, const uint32_t& audioHandle, const float_t& loopBeginSecond, const float_t& loopLengthSecond, const uint32_t& loopCount);
+
+		/// <summary>
+		/// ソフトウェアミキサーを取得
+		/// </summary>
+		/// <returns>ミキサー</returns>
+		inline AudioMixer& GetMixer() {
+			return mixer_;
+		}
+
+#pragma endregion
 
 #pragma region ループ
 
@@ -207,6 +356,22 @@ namespace Elysia {
 		/// <param name="ループの長さ(秒)"></param>
 		void PartlyLoopPlayWave(const uint32_t& audioHandle, const float_t& start, const float_t& lengthSecond);
 
+		/// <summary>
+		/// ファイルに書いてあるループ(smplチャンク)で再生
+		/// 書いていなければ全体をループ
+		/// </summary>
+		/// <param name="audioHandle">ハンドル(WAV)</param>
+		void EmbeddedLoopPlayWave(const uint32_t& audioHandle);
+
+		/// <summary>
+		/// ループする範囲の設定(ストリーミング再生するBGMのみ)
+		/// 次に再生した時から有効
+		/// </summary>
+		/// <param name="audioHandle">ハンドル</param>
+		/// <param name="beginSecond">ループの始まり(秒)</param>
+		/// <param name="endSecond">ループの終わり(秒、0なら最後まで)</param>
+		void SetLoopPoints(const uint32_t& audioHandle, const float_t& beginSecond, const float_t& endSecond);
+
 
 #pragma endregion
 
@@ -364,6 +529,27 @@ namespace Elysia {
 			return {};
 		}
 
+		/// <summary>
+		/// ストリーミング再生
+		/// </summary>
+		/// <param name="audioInformation">オーディオ情報</param>
+		/// <param name="loopCount">ループする回数(最初の1回は含まない)</param>
+		void PlayStream(AudioInformation& audioInformation, const uint32_t& loopCount);
+
+		/// <summary>
+		/// 波形フォーマットから形式に変換
+		/// </summary>
+		/// <param name="waveFormat">波形フォーマット</param>
+		/// <returns>形式</returns>
+		static AudioFormat ToAudioFormat(const WAVEFORMATEX& waveFormat);
+
+		/// <summary>
+		/// 形式から波形フォーマットに変換
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <returns>波形フォーマット</returns>
+		static WAVEFORMATEX ToWaveFormat(const AudioFormat& format);
+
 	private:
 
 		//自分のエンジンではA4は442Hz基準にする
@@ -435,6 +621,43 @@ namespace Elysia {
 		static const uint32_t SUBMIXVOICE_AMOUNT_ = 64u;
 		std::array<IXAudio2SubmixVoice*, SUBMIXVOICE_AMOUNT_> submixVoice_{};
 
+		//これより長いMP3は全部展開せずにストリーミング再生する
+		//短い効果音はすぐ鳴らしたいので今まで通り全部展開しておく
+		static constexpr float_t STREAMING_SECOND_ = 10.0f;
+		//ストリーミングのバッファ1つの長さ(秒)
+		static constexpr float_t STREAMING_BUFFER_SECOND_ = 0.25f;
+		//ストリーミングのバッファの数
+		static constexpr uint32_t STREAMING_BUFFER_COUNT_ = 4u;
+		//展開するスレッドが起こされなくても見に行く間隔
+		static constexpr std::chrono::milliseconds STREAMING_INTERVAL_ = std::chrono::milliseconds(10);
+		//全部展開する時に1回で展開するフレーム数
+		static constexpr uint32_t DECODE_FRAME_COUNT_ = 4096u;
+		//ストリーミングで展開するスレッド
+		AudioStreamer streamer_;
+
+		//重ねて鳴らす効果音のために、形式ごとに作っておくボイスの数
+		static constexpr uint32_t VOICE_COUNT_PER_FORMAT_ = 8u;
+		//重ねて鳴らす効果音のボイス
+		XAudio2VoiceBackend voiceBackend_;
+		VoicePool voicePool_;
+
+		//3Dの音のエミッタの最大数
+		static constexpr uint32_t MAX_EMITTER_COUNT_ = 256u;
+		//3Dの音
+		AudioEmitterSystem emitterSystem_;
+
+		//ソフトウェアミキサーの出力の周波数
+		static constexpr uint32_t MIXER_SAMPLE_RATE_ = 48000u;
+		//ソフトウェアミキサーで1回に混ぜるフレーム数
+		static constexpr uint32_t MIXER_FRAMES_PER_BLOCK_ = 512u;
+		//ソフトウェアミキサーの出力のバッファの数(遅れはこれ*ブロック分)
+		static constexpr uint32_t MIXER_BUFFER_COUNT_ = 3u;
+		//ソフトウェアミキサー
+		//出力はストリーミングと同じ仕組みでXAudio2のソースボイスに流す
+		AudioMixer mixer_;
+		std::unique_ptr<AudioStream> mixerStream_;
+		std::unique_ptr<XAudio2StreamSink> mixerSink_;
+
 	};
 
 }
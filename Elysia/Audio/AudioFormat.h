@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file AudioFormat.h
+ * @brief PCMの形式
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// PCMの形式
+	/// XAudio2のWAVEFORMATEXに頼らずに扱えるようにする
+	/// </summary>
+	struct AudioFormat {
+		//チャンネル数
+		uint32_t channelCount;
+		//サンプリング周波数
+		uint32_t sampleRate;
+		//1サンプルのビット数
+		uint32_t bitsPerSample;
+		//浮動小数点かどうか
+		bool isFloat = false;
+
+		/// <summary>
+		/// 1フレーム(全チャンネル分の1サンプル)のバイト数
+		/// </summary>
+		/// <returns>バイト数</returns>
+		inline uint32_t GetBlockAlign() const {
+			return channelCount * bitsPerSample / 8u;
+		}
+
+		/// <summary>
+		/// 同じ形式かどうか
+		/// </summary>
+		bool operator==(const AudioFormat& other) const = default;
+	};
+
+}
@@ -8,41 +8,13 @@
 #include <cstdint>
 #include <xaudio2.h>
 #include <string>
-#include <mfreadwrite.h>
+#include <vector>
+#include <memory>
 
+#include "AudioStream.h"
+#include "XAudio2StreamSink.h"
+#include "WaveFile.h"
 
-//チャンク...データの塊みたいなもの
-
-/// <summary>
-/// チャンクヘッダ
-/// </summary>
-struct ChunkHeader {
-	//チャンク毎のID
-	char id[4];
-	//チャンクサイズ
-	int32_t size;
-};
-
-/// <summary>
-/// FMTチャンク
-/// </summary>
-struct FormatChunk {
-	//fmt
-	ChunkHeader chunk;
-	//波形フォーマット
-	WAVEFORMATEX fmt;
-
-};
-
-/// <summary>
-/// RIFFヘッダー
-/// </summary>
-struct RiffHeader {
-	//RIFF
-	ChunkHeader chunk;
-	//WAVE
-	char type[4];
-};
 
 /// <summary>
 /// 音声データ
@@ -52,7 +24,7 @@ struct SoundData {
 	WAVEFORMATEX wfex;
 
 	//バッファの先頭アドレス
-	BYTE* pBuffer;
+	const BYTE* pBuffer;
 
 	//バッファのサイズ
 	int32_t bufferSize;
@@ -73,14 +45,23 @@ struct AudioInformation {
 	SoundData soundData = {};
 
 	//サウンドボイス
-	IXAudio2SourceVoice* sourceVoice;
-
-	//ソースリーダー
-	IMFSourceReader* sourceReader;
+	IXAudio2SourceVoice* sourceVoice = nullptr;
 
 	//メディアデータ
 	std::vector<BYTE> mediaData;
 
+	//ストリーミング再生(長いBGMだけ。それ以外はnullptr)
+	std::unique_ptr<Elysia::AudioStream> stream;
+	//ストリーミングの送り先(ソースボイスを持っている)
+	std::unique_ptr<Elysia::XAudio2StreamSink> streamSink;
+
+	//WAVファイル(PCMはここを直接指している)
+	//ボイスやミキサーが鳴らしている間は閉じないように共有する
+	std::shared_ptr<Elysia::WaveFile> waveFile;
+	//ファイルに書いてあるループ(フレーム、長さが0なら全体)
+	uint32_t loopBegin = 0u;
+	uint32_t loopLength = 0u;
+
 	//ハンドル
 	uint32_t handle;
 
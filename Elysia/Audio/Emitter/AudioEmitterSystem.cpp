@@ -0,0 +1,455 @@
+#include "AudioEmitterSystem.h"
+
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+
+//SSEが使える時は4つのエミッタをまとめて計算する
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define ELYSIA_AUDIO_EMITTER_SSE
+#endif
+
+namespace {
+
+	//0で割らないように
+	const float MIN_LENGTH_ = 0.0001f;
+	//コーンを使わない時の外側のcos(どの向きでも内側になる)
+	const float NO_CONE_COS_ = -3.0f;
+
+	/// <summary>
+	/// まとめて計算する時の値
+	/// </summary>
+	struct LaneParameters {
+		float minDistance;
+		float maxDistance;
+		float inverseRange;
+		float linearWeight;
+		float inverseWeight;
+		float inverseSquareWeight;
+		float coneOuterCos;
+		float inverseConeRange;
+		float coneOuterGain;
+	};
+
+	/// <summary>
+	/// 設定からまとめて計算する時の値を作る
+	/// </summary>
+	/// <param name="settings">設定</param>
+	/// <param name="direction">向き(正規化済み、0なら全方向)</param>
+	/// <returns>値</returns>
+	LaneParameters MakeLaneParameters(const Elysia::AudioEmitterSettings& settings, const Vector3& direction) {
+		LaneParameters parameters = {};
+		parameters.minDistance = std::max(settings.minDistance, MIN_LENGTH_);
+		parameters.maxDistance = std::max(settings.maxDistance, parameters.minDistance + MIN_LENGTH_);
+		parameters.inverseRange = 1.0f / (parameters.maxDistance - parameters.minDistance);
+		parameters.linearWeight = (settings.curve == Elysia::AttenuationCurve::Linear) ? 1.0f : 0.0f;
+		parameters.inverseWeight = (settings.curve == Elysia::AttenuationCurve::Inverse) ? 1.0f : 0.0f;
+		parameters.inverseSquareWeight = (settings.curve == Elysia::AttenuationCurve::InverseSquare) ? 1.0f : 0.0f;
+
+		//向きが無いか、外側が全方向ならコーンは使わない
+		bool hasDirection = direction.x != 0.0f || direction.y != 0.0f || direction.z != 0.0f;
+		if (hasDirection == false || settings.coneOuterAngle >= 2.0f * std::numbers::pi_v<float>) {
+			parameters.coneOuterCos = NO_CONE_COS_;
+			parameters.inverseConeRange = 1.0f;
+			parameters.coneOuterGain = 1.0f;
+		}
+		else {
+			float innerCos = std::cos(std::min(settings.coneInnerAngle, settings.coneOuterAngle) * 0.5f);
+			float outerCos = std::cos(settings.coneOuterAngle * 0.5f);
+			parameters.coneOuterCos = outerCos;
+			parameters.inverseConeRange = 1.0f / std::max(innerCos - outerCos, MIN_LENGTH_);
+			parameters.coneOuterGain = settings.coneOuterGain;
+		}
+		return parameters;
+	}
+
+	/// <summary>
+	/// 1つのエミッタの大きさを計算
+	/// SSEの計算と同じ順番で計算する
+	/// </summary>
+	Elysia::AudioEmitterGain CalculateLane(const Elysia::AudioListener& listener, const Vector3& right, const Vector3& position, const Vector3& direction, const LaneParameters& parameters, const float& volume, const float& openness) {
+		//エミッタから聞き手
+		Vector3 toListener = {
+			.x = listener.position.x - position.x,
+			.y = listener.position.y - position.y,
+			.z = listener.position.z - position.z,
+		};
+		float distance = std::sqrt(toListener.x * toListener.x + toListener.y * toListener.y + toListener.z * toListener.z);
+		float inverseDistance = 1.0f / std::max(distance, MIN_LENGTH_);
+
+		//距離の減衰
+		float linear = std::clamp(1.0f - (distance - parameters.minDistance) * parameters.inverseRange, 0.0f, 1.0f);
+		float inverse = parameters.minDistance / std::max(distance, parameters.minDistance);
+		float distanceGain = parameters.linearWeight * linear + parameters.inverseWeight * inverse + parameters.inverseSquareWeight * inverse * inverse;
+		if (distance > parameters.maxDistance) {
+			distanceGain = 0.0f;
+		}
+
+		//コーン
+		float cosAngle = (direction.x * toListener.x + direction.y * toListener.y + direction.z * toListener.z) * inverseDistance;
+		float coneT = std::clamp((cosAngle - parameters.coneOuterCos) * parameters.inverseConeRange, 0.0f, 1.0f);
+		float coneGain = parameters.coneOuterGain + (1.0f - parameters.coneOuterGain) * coneT;
+
+		Elysia::AudioEmitterGain gain = {};
+		gain.gain = distanceGain * coneGain * volume * openness;
+		//聞き手の右にあれば正
+		gain.pan = std::clamp(-(toListener.x * right.x + toListener.y * right.y + toListener.z * right.z) * inverseDistance, -1.0f, 1.0f);
+		//真ん中でも大きさが変わらないように2乗の和を1にする
+		gain.left = gain.gain * std::sqrt(std::max(0.5f - 0.5f * gain.pan, 0.0f));
+		gain.right = gain.gain * std::sqrt(std::max(0.5f + 0.5f * gain.pan, 0.0f));
+		return gain;
+	}
+
+	/// <summary>
+	/// 聞き手の右
+	/// </summary>
+	/// <param name="listener">聞き手</param>
+	/// <returns>右</returns>
+	Vector3 CalculateRight(const Elysia::AudioListener& listener) {
+		//左手系なので上×前が右
+		return {
+			.x = listener.up.y * listener.forward.z - listener.up.z * listener.forward.y,
+			.y = listener.up.z * listener.forward.x - listener.up.x * listener.forward.z,
+			.z = listener.up.x * listener.forward.y - listener.up.y * listener.forward.x,
+		};
+	}
+
+	/// <summary>
+	/// 正規化(0ならそのまま)
+	/// </summary>
+	/// <param name="vector">ベクトル</param>
+	/// <returns>正規化したもの</returns>
+	Vector3 NormalizeOrZero(const Vector3& vector) {
+		float length = std::sqrt(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+		if (length < MIN_LENGTH_) {
+			return { .x = 0.0f, .y = 0.0f, .z = 0.0f };
+		}
+		return { .x = vector.x / length, .y = vector.y / length, .z = vector.z / length };
+	}
+
+}
+
+void Elysia::AudioEmitterSystem::Initialize(VoicePool* voicePool, const uint32_t& maxEmitterCount) {
+	assert(voicePool != nullptr);
+	voicePool_ = voicePool;
+	emitters_.assign(maxEmitterCount, {});
+	freeIds_.clear();
+	for (uint32_t id = maxEmitterCount; id > 0u; --id) {
+		freeIds_.push_back(id - 1u);
+	}
+	usedCount_ = 0u;
+	candidateIds_.reserve(maxEmitterCount);
+	playingIds_.reserve(maxEmitterCount);
+
+	//4つずつ計算するので切り上げて確保する
+	size_t laneCount = (size_t(maxEmitterCount) + LANE_COUNT_ - 1u) / LANE_COUNT_ * LANE_COUNT_;
+	for (std::vector<float>* values : { &positionX_, &positionY_, &positionZ_, &directionX_, &directionY_, &directionZ_,
+		&minDistance_, &maxDistance_, &inverseRange_, &linearWeight_, &inverseWeight_, &inverseSquareWeight_,
+		&coneOuterCos_, &inverseConeRange_, &coneOuterGain_, &volume_, &openness_, &gain_, &pan_, &left_, &right_ }) {
+		values->assign(laneCount, 0.0f);
+	}
+	//使っていないところも0で割らないようにしておく
+	std::fill(maxDistance_.begin(), maxDistance_.end(), 1.0f);
+	std::fill(inverseRange_.begin(), inverseRange_.end(), 1.0f);
+	std::fill(coneOuterCos_.begin(), coneOuterCos_.end(), NO_CONE_COS_);
+	std::fill(inverseConeRange_.begin(), inverseConeRange_.end(), 1.0f);
+	statistics_ = {};
+}
+
+uint32_t Elysia::AudioEmitterSystem::Create(const AudioFormat& format, const VoiceBuffer& buffer, const AudioEmitterSettings& settings) {
+	//最大数を超えないようにしてね
+	assert(freeIds_.empty() == false);
+	uint32_t id = freeIds_.back();
+	freeIds_.pop_back();
+	usedCount_ = std::max(usedCount_, id + 1u);
+
+	emitters_[id] = {
+		.format = format,
+		.buffer = buffer,
+		.settings = settings,
+		.direction = { .x = 0.0f, .y = 0.0f, .z = 0.0f },
+		.volume = 1.0f,
+		.isUsed = true,
+		.isPlaying = false,
+		.voiceHandle = {},
+		.pushedLeft = 0.0f,
+		.pushedRight = 0.0f,
+	};
+	positionX_[id] = positionY_[id] = positionZ_[id] = 0.0f;
+	openness_[id] = 1.0f;
+	RefreshParameters(id);
+	++statistics_.emitterCount;
+	return id;
+}
+
+void Elysia::AudioEmitterSystem::Destroy(const uint32_t& id) {
+	assert(id < usedCount_ && emitters_[id].isUsed == true);
+	Emitter& emitter = emitters_[id];
+	voicePool_->Stop(emitter.voiceHandle);
+	emitter.voiceHandle = {};
+	emitter.isUsed = false;
+	emitter.isPlaying = false;
+	RefreshParameters(id);
+	freeIds_.push_back(id);
+	--statistics_.emitterCount;
+}
+
+void Elysia::AudioEmitterSystem::Play(const uint32_t& id) {
+	emitters_[id].isPlaying = true;
+	RefreshParameters(id);
+}
+
+void Elysia::AudioEmitterSystem::Stop(const uint32_t& id) {
+	emitters_[id].isPlaying = false;
+	RefreshParameters(id);
+}
+
+void Elysia::AudioEmitterSystem::SetPosition(const uint32_t& id, const Vector3& position) {
+	positionX_[id] = position.x;
+	positionY_[id] = position.y;
+	positionZ_[id] = position.z;
+}
+
+void Elysia::AudioEmitterSystem::SetDirection(const uint32_t& id, const Vector3& direction) {
+	emitters_[id].direction = NormalizeOrZero(direction);
+	RefreshParameters(id);
+}
+
+void Elysia::AudioEmitterSystem::SetVolume(const uint32_t& id, const float& volume) {
+	emitters_[id].volume = volume;
+	RefreshParameters(id);
+}
+
+void Elysia::AudioEmitterSystem::SetOcclusion(const uint32_t& id, const float& occlusion) {
+	openness_[id] = 1.0f - std::clamp(occlusion, 0.0f, 1.0f);
+}
+
+void Elysia::AudioEmitterSystem::Update(const AudioListener& listener) {
+	statistics_.audibleCount = 0u;
+	statistics_.virtualCount = 0u;
+	statistics_.startedCount = 0u;
+	statistics_.stoppedCount = 0u;
+	statistics_.pushedCount = 0u;
+
+	//全部まとめて計算
+	CalculateGains(listener);
+
+	//聞こえなくなったものを先に止めてボイスを空ける
+	//鳴らしているものは変わった時だけボイスに伝える
+	candidateIds_.clear();
+	playingIds_.clear();
+	for (uint32_t id = 0u; id < usedCount_; ++id) {
+		Emitter& emitter = emitters_[id];
+		if (emitter.isUsed == false) {
+			continue;
+		}
+
+		//横取りされたか鳴り終わった
+		if (emitter.voiceHandle.IsValid() == true && voicePool_->IsPlaying(emitter.voiceHandle) == false) {
+			emitter.voiceHandle = {};
+			//ループしないものは1回鳴らしたら終わり
+			if (emitter.buffer.loopCount != VoiceBuffer::LOOP_INFINITE_) {
+				emitter.isPlaying = false;
+				RefreshParameters(id);
+			}
+		}
+
+		bool isAudible = emitter.isPlaying == true && gain_[id] > AUDIBLE_GAIN_;
+		if (isAudible == false && emitter.voiceHandle.IsValid() == true) {
+			//聞こえなくなったので止める
+			voicePool_->Stop(emitter.voiceHandle);
+			emitter.voiceHandle = {};
+			++statistics_.stoppedCount;
+		}
+		else if (isAudible == true && emitter.voiceHandle.IsValid() == false) {
+			candidateIds_.push_back(id);
+		}
+		else if (emitter.voiceHandle.IsValid() == true) {
+			playingIds_.push_back(id);
+			if (std::abs(left_[id] - emitter.pushedLeft) > GAIN_EPSILON_ || std::abs(right_[id] - emitter.pushedRight) > GAIN_EPSILON_) {
+				PushGains(id);
+			}
+		}
+	}
+
+	//優先度の高い順、大きい順に鳴らす
+	std::sort(candidateIds_.begin(), candidateIds_.end(), [this](const uint32_t& a, const uint32_t& b) {
+		int32_t priorityA = emitters_[a].settings.priority;
+		int32_t priorityB = emitters_[b].settings.priority;
+		if (priorityA != priorityB) {
+			return priorityA > priorityB;
+		}
+		return gain_[a] > gain_[b];
+	});
+	for (const uint32_t& id : candidateIds_) {
+		Emitter& emitter = emitters_[id];
+		//同じ優先度のものは横取りしない(取り合って毎フレーム鳴らし直さないように)
+		emitter.voiceHandle = voicePool_->TryPlay(emitter.format, emitter.buffer, emitter.settings.priority, 1.0f);
+		if (emitter.voiceHandle.IsValid() == false) {
+			//十分に小さいものが鳴っていれば入れ替える
+			uint32_t replaceId = FindReplaceable(id);
+			if (replaceId == INVALID_ID_) {
+				continue;
+			}
+			voicePool_->Stop(emitters_[replaceId].voiceHandle);
+			emitters_[replaceId].voiceHandle = {};
+			++statistics_.stoppedCount;
+			emitter.voiceHandle = voicePool_->TryPlay(emitter.format, emitter.buffer, emitter.settings.priority, 1.0f);
+			assert(emitter.voiceHandle.IsValid() == true);
+		}
+		playingIds_.push_back(id);
+		PushGains(id);
+		++statistics_.startedCount;
+	}
+
+	//数える
+	for (uint32_t id = 0u; id < usedCount_; ++id) {
+		const Emitter& emitter = emitters_[id];
+		if (emitter.voiceHandle.IsValid() == true) {
+			++statistics_.audibleCount;
+		}
+		else if (emitter.isUsed == true && emitter.isPlaying == true) {
+			++statistics_.virtualCount;
+		}
+	}
+}
+
+Elysia::AudioEmitterGain Elysia::AudioEmitterSystem::CalculateGain(const AudioListener& listener, const Vector3& position, const Vector3& direction, const AudioEmitterSettings& settings, const float& volume, const float& occlusion) {
+	Vector3 normalizedDirection = NormalizeOrZero(direction);
+	return CalculateLane(listener, CalculateRight(listener), position, normalizedDirection, MakeLaneParameters(settings, normalizedDirection), volume, 1.0f - std::clamp(occlusion, 0.0f, 1.0f));
+}
+
+Elysia::AudioEmitterGain Elysia::AudioEmitterSystem::GetGain(const uint32_t& id) const {
+	return { .gain = gain_[id], .pan = pan_[id], .left = left_[id], .right = right_[id] };
+}
+
+void Elysia::AudioEmitterSystem::RefreshParameters(const uint32_t& id) {
+	const Emitter& emitter = emitters_[id];
+	LaneParameters parameters = MakeLaneParameters(emitter.settings, emitter.direction);
+	directionX_[id] = emitter.direction.x;
+	directionY_[id] = emitter.direction.y;
+	directionZ_[id] = emitter.direction.z;
+	minDistance_[id] = parameters.minDistance;
+	maxDistance_[id] = parameters.maxDistance;
+	inverseRange_[id] = parameters.inverseRange;
+	linearWeight_[id] = parameters.linearWeight;
+	inverseWeight_[id] = parameters.inverseWeight;
+	inverseSquareWeight_[id] = parameters.inverseSquareWeight;
+	coneOuterCos_[id] = parameters.coneOuterCos;
+	inverseConeRange_[id] = parameters.inverseConeRange;
+	coneOuterGain_[id] = parameters.coneOuterGain;
+	//鳴らしていなければ0にしておけば、まとめて計算しても聞こえない
+	volume_[id] = (emitter.isUsed == true && emitter.isPlaying == true) ? emitter.volume : 0.0f;
+}
+
+void Elysia::AudioEmitterSystem::PushGains(const uint32_t& id) {
+	Emitter& emitter = emitters_[id];
+	voicePool_->SetStereoGains(emitter.voiceHandle, left_[id], right_[id]);
+	emitter.pushedLeft = left_[id];
+	emitter.pushedRight = right_[id];
+	++statistics_.pushedCount;
+}
+
+uint32_t Elysia::AudioEmitterSystem::FindReplaceable(const uint32_t& id) const {
+	const Emitter& emitter = emitters_[id];
+	uint32_t replaceId = INVALID_ID_;
+	for (const uint32_t& playingId : playingIds_) {
+		const Emitter& playing = emitters_[playingId];
+		//入れ替えたものは無効になっている
+		if (playing.voiceHandle.IsValid() == false || playing.settings.priority != emitter.settings.priority || (playing.format == emitter.format) == false) {
+			continue;
+		}
+		if (replaceId == INVALID_ID_ || gain_[playingId] < gain_[replaceId]) {
+			replaceId = playingId;
+		}
+	}
+	if (replaceId != INVALID_ID_ && gain_[id] < gain_[replaceId] * REPLACE_GAIN_RATIO_) {
+		return INVALID_ID_;
+	}
+	return replaceId;
+}
+
+void Elysia::AudioEmitterSystem::CalculateGains(const AudioListener& listener) {
+	Vector3 right = CalculateRight(listener);
+	uint32_t laneCount = (usedCount_ + LANE_COUNT_ - 1u) / LANE_COUNT_ * LANE_COUNT_;
+
+#ifdef ELYSIA_AUDIO_EMITTER_SSE
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 minusOne = _mm_set1_ps(-1.0f);
+	const __m128 minLength = _mm_set1_ps(MIN_LENGTH_);
+	const __m128 listenerX = _mm_set1_ps(listener.position.x);
+	const __m128 listenerY = _mm_set1_ps(listener.position.y);
+	const __m128 listenerZ = _mm_set1_ps(listener.position.z);
+	const __m128 rightX = _mm_set1_ps(right.x);
+	const __m128 rightY = _mm_set1_ps(right.y);
+	const __m128 rightZ = _mm_set1_ps(right.z);
+	for (uint32_t i = 0u; i < laneCount; i += LANE_COUNT_) {
+		//エミッタから聞き手
+		__m128 toListenerX = _mm_sub_ps(listenerX, _mm_loadu_ps(&positionX_[i]));
+		__m128 toListenerY = _mm_sub_ps(listenerY, _mm_loadu_ps(&positionY_[i]));
+		__m128 toListenerZ = _mm_sub_ps(listenerZ, _mm_loadu_ps(&positionZ_[i]));
+		__m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(toListenerX, toListenerX), _mm_mul_ps(toListenerY, toListenerY)), _mm_mul_ps(toListenerZ, toListenerZ)));
+		__m128 inverseDistance = _mm_div_ps(one, _mm_max_ps(distance, minLength));
+
+		//距離の減衰
+		__m128 minDistance = _mm_loadu_ps(&minDistance_[i]);
+		__m128 linear = _mm_sub_ps(one, _mm_mul_ps(_mm_sub_ps(distance, minDistance), _mm_loadu_ps(&inverseRange_[i])));
+		linear = _mm_min_ps(_mm_max_ps(linear, zero), one);
+		__m128 inverse = _mm_div_ps(minDistance, _mm_max_ps(distance, minDistance));
+		__m128 distanceGain = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_loadu_ps(&linearWeight_[i]), linear),
+			_mm_mul_ps(_mm_loadu_ps(&inverseWeight_[i]), inverse)),
+			_mm_mul_ps(_mm_loadu_ps(&inverseSquareWeight_[i]), _mm_mul_ps(inverse, inverse)));
+		//最大距離より遠ければ0
+		distanceGain = _mm_and_ps(distanceGain, _mm_cmple_ps(distance, _mm_loadu_ps(&maxDistance_[i])));
+
+		//コーン
+		__m128 cosAngle = _mm_mul_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_loadu_ps(&directionX_[i]), toListenerX),
+			_mm_mul_ps(_mm_loadu_ps(&directionY_[i]), toListenerY)),
+			_mm_mul_ps(_mm_loadu_ps(&directionZ_[i]), toListenerZ)), inverseDistance);
+		__m128 coneT = _mm_mul_ps(_mm_sub_ps(cosAngle, _mm_loadu_ps(&coneOuterCos_[i])), _mm_loadu_ps(&inverseConeRange_[i]));
+		coneT = _mm_min_ps(_mm_max_ps(coneT, zero), one);
+		__m128 coneOuterGain = _mm_loadu_ps(&coneOuterGain_[i]);
+		__m128 coneGain = _mm_add_ps(coneOuterGain, _mm_mul_ps(_mm_sub_ps(one, coneOuterGain), coneT));
+
+		__m128 gain = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(distanceGain, coneGain), _mm_loadu_ps(&volume_[i])), _mm_loadu_ps(&openness_[i]));
+		//聞き手の右にあれば正
+		__m128 pan = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(toListenerX, rightX), _mm_mul_ps(toListenerY, rightY)), _mm_mul_ps(toListenerZ, rightZ)), inverseDistance);
+		pan = _mm_min_ps(_mm_max_ps(_mm_sub_ps(zero, pan), minusOne), one);
+		__m128 halfPan = _mm_mul_ps(half, pan);
+		__m128 left = _mm_mul_ps(gain, _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(half, halfPan), zero)));
+		__m128 rightGain = _mm_mul_ps(gain, _mm_sqrt_ps(_mm_max_ps(_mm_add_ps(half, halfPan), zero)));
+
+		_mm_storeu_ps(&gain_[i], gain);
+		_mm_storeu_ps(&pan_[i], pan);
+		_mm_storeu_ps(&left_[i], left);
+		_mm_storeu_ps(&right_[i], rightGain);
+	}
+#else
+	for (uint32_t i = 0u; i < laneCount; ++i) {
+		LaneParameters parameters = {
+			.minDistance = minDistance_[i],
+			.maxDistance = maxDistance_[i],
+			.inverseRange = inverseRange_[i],
+			.linearWeight = linearWeight_[i],
+			.inverseWeight = inverseWeight_[i],
+			.inverseSquareWeight = inverseSquareWeight_[i],
+			.coneOuterCos = coneOuterCos_[i],
+			.inverseConeRange = inverseConeRange_[i],
+			.coneOuterGain = coneOuterGain_[i],
+		};
+		Vector3 position = { .x = positionX_[i], .y = positionY_[i], .z = positionZ_[i] };
+		Vector3 direction = { .x = directionX_[i], .y = directionY_[i], .z = directionZ_[i] };
+		AudioEmitterGain gain = CalculateLane(listener, right, position, direction, parameters, volume_[i], openness_[i]);
+		gain_[i] = gain.gain;
+		pan_[i] = gain.pan;
+		left_[i] = gain.left;
+		right_[i] = gain.right;
+	}
+#endif
+}
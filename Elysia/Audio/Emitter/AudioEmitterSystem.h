@@ -0,0 +1,337 @@
+#pragma once
+
+/**
+ * @file AudioEmitterSystem.h
+ * @brief 3Dの音(エミッタ)をまとめて更新するクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "Vector3.h"
+#include "AudioFormat.h"
+#include "VoicePool.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 距離による減衰の仕方
+	/// </summary>
+	enum class AttenuationCurve : uint32_t {
+		//最小距離から最大距離までまっすぐ小さくなる
+		Linear,
+		//距離に反比例(最大距離で切る)
+		Inverse,
+		//距離の2乗に反比例(最大距離で切る)
+		InverseSquare,
+	};
+
+	/// <summary>
+	/// エミッタの設定
+	/// </summary>
+	struct AudioEmitterSettings {
+		//この距離までは減衰しない
+		float minDistance;
+		//この距離より遠いと聞こえない
+		float maxDistance;
+		//減衰の仕方
+		AttenuationCurve curve;
+		//コーンの内側の角度(ラジアン、全体の角度)
+		//向きを設定していなければ全方向に鳴る
+		float coneInnerAngle;
+		//コーンの外側の角度(ラジアン、全体の角度)
+		float coneOuterAngle;
+		//コーンの外側での音量
+		float coneOuterGain;
+		//ボイスが足りない時の優先度
+		int32_t priority;
+	};
+
+	/// <summary>
+	/// 聞き手
+	/// </summary>
+	struct AudioListener {
+		//位置
+		Vector3 position;
+		//前(正規化してね)
+		Vector3 forward;
+		//上(正規化してね)
+		Vector3 up;
+	};
+
+	/// <summary>
+	/// 計算した大きさ
+	/// </summary>
+	struct AudioEmitterGain {
+		//全体の大きさ
+		float gain;
+		//左右(-1が左、1が右)
+		float pan;
+		//左に送る大きさ
+		float left;
+		//右に送る大きさ
+		float right;
+	};
+
+	/// <summary>
+	/// 3Dの音(エミッタ)をまとめて更新するクラス
+	/// 全部のエミッタの大きさと左右を1回でまとめて(SSEで4つずつ)計算して、
+	/// 変わったものだけをボイスに伝える
+	/// 聞こえないくらい小さいものはボイスを止めて(仮想化)、聞こえるようになったら鳴らし直す
+	/// ボイスはVoicePoolから借りるので、偽のバックエンドで確かめられる
+	/// </summary>
+	class AudioEmitterSystem final {
+	public:
+		/// <summary>
+		/// 統計
+		/// </summary>
+		struct Statistics {
+			//エミッタの数
+			uint32_t emitterCount;
+			//聞こえている数
+			uint32_t audibleCount;
+			//仮想化している数(鳴らしたいけど聞こえない)
+			uint32_t virtualCount;
+			//このフレームでボイスを鳴らした数
+			uint32_t startedCount;
+			//このフレームでボイスを止めた数
+			uint32_t stoppedCount;
+			//このフレームで大きさを伝えた数
+			uint32_t pushedCount;
+		};
+
+		//無効な番号
+		static constexpr uint32_t INVALID_ID_ = UINT32_MAX;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="voicePool">ボイスプール</param>
+		/// <param name="maxEmitterCount">エミッタの最大数</param>
+		void Initialize(VoicePool* voicePool, const uint32_t& maxEmitterCount);
+
+		/// <summary>
+		/// エミッタを作る
+		/// 作っただけでは鳴らないので、Playを呼んでね
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <param name="buffer">鳴らすもの(ずっと鳴らすならループにしてね)</param>
+		/// <param name="settings">設定</param>
+		/// <returns>番号</returns>
+		uint32_t Create(const AudioFormat& format, const VoiceBuffer& buffer, const AudioEmitterSettings& settings);
+
+		/// <summary>
+		/// エミッタを消す
+		/// </summary>
+		/// <param name="id">番号</param>
+		void Destroy(const uint32_t& id);
+
+		/// <summary>
+		/// 鳴らす
+		/// 聞こえる所にあれば次のUpdateでボイスを鳴らす
+		/// </summary>
+		/// <param name="id">番号</param>
+		void Play(const uint32_t& id);
+
+		/// <summary>
+		/// 止める
+		/// </summary>
+		/// <param name="id">番号</param>
+		void Stop(const uint32_t& id);
+
+		/// <summary>
+		/// 位置の設定
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <param name="position">位置</param>
+		void SetPosition(const uint32_t& id, const Vector3& position);
+
+		/// <summary>
+		/// 向きの設定(コーンを使う時だけ)
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <param name="direction">向き(0なら全方向)</param>
+		void SetDirection(const uint32_t& id, const Vector3& direction);
+
+		/// <summary>
+		/// 音量の設定
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <param name="volume">音量</param>
+		void SetVolume(const uint32_t& id, const float& volume);
+
+		/// <summary>
+		/// 遮られている割合の設定
+		/// 壁の向こうなどを呼び出し側で調べて渡してね
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <param name="occlusion">0で遮られていない、1で聞こえない</param>
+		void SetOcclusion(const uint32_t& id, const float& occlusion);
+
+		/// <summary>
+		/// 全部のエミッタの更新
+		/// 聞こえなくなったものを止めてから、優先度の高い順、大きい順に空いているボイスで鳴らす
+		/// </summary>
+		/// <param name="listener">聞き手</param>
+		void Update(const AudioListener& listener);
+
+		/// <summary>
+		/// 1つのエミッタの大きさを計算(SSEを使わない確認用)
+		/// </summary>
+		/// <param name="listener">聞き手</param>
+		/// <param name="position">位置</param>
+		/// <param name="direction">向き(0なら全方向)</param>
+		/// <param name="settings">設定</param>
+		/// <param name="volume">音量</param>
+		/// <param name="occlusion">遮られている割合</param>
+		/// <returns>大きさ</returns>
+		static AudioEmitterGain CalculateGain(const AudioListener& listener, const Vector3& position, const Vector3& direction, const AudioEmitterSettings& settings, const float& volume, const float& occlusion);
+
+	public:
+		/// <summary>
+		/// 計算した大きさを取得
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <returns>大きさ</returns>
+		AudioEmitterGain GetGain(const uint32_t& id) const;
+
+		/// <summary>
+		/// 聞こえているか(ボイスを鳴らしているか)
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <returns>聞こえているか</returns>
+		inline bool GetIsAudible(const uint32_t& id) const {
+			return emitters_[id].voiceHandle.IsValid();
+		}
+
+		/// <summary>
+		/// 統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		inline const Statistics& GetStatistics() const {
+			return statistics_;
+		}
+
+	private:
+		/// <summary>
+		/// まとめて計算しないもの
+		/// </summary>
+		struct Emitter {
+			//形式
+			AudioFormat format;
+			//鳴らすもの
+			VoiceBuffer buffer;
+			//設定
+			AudioEmitterSettings settings;
+			//向き
+			Vector3 direction;
+			//音量
+			float volume;
+			//使っているかどうか
+			bool isUsed;
+			//鳴らしたいかどうか
+			bool isPlaying;
+			//鳴らしているボイス(仮想化していたら無効)
+			VoiceHandle voiceHandle;
+			//最後にボイスに伝えた大きさ
+			float pushedLeft;
+			float pushedRight;
+		};
+
+		/// <summary>
+		/// まとめて計算する時の値を設定から作り直す
+		/// </summary>
+		/// <param name="id">番号</param>
+		void RefreshParameters(const uint32_t& id);
+
+		/// <summary>
+		/// 大きさをまとめて計算
+		/// </summary>
+		/// <param name="listener">聞き手</param>
+		void CalculateGains(const AudioListener& listener);
+
+		/// <summary>
+		/// ボイスに左右の大きさを伝える
+		/// </summary>
+		/// <param name="id">番号</param>
+		void PushGains(const uint32_t& id);
+
+		/// <summary>
+		/// 鳴らしている中で入れ替えられるものを探す
+		/// 同じ形式、同じ優先度で、十分に小さいもの
+		/// </summary>
+		/// <param name="id">鳴らしたいエミッタの番号</param>
+		/// <returns>入れ替えるエミッタの番号(無ければINVALID_ID_)</returns>
+		uint32_t FindReplaceable(const uint32_t& id) const;
+
+	private:
+		//聞こえないとみなす大きさ(-60dB)
+		static constexpr float AUDIBLE_GAIN_ = 0.001f;
+		//これ以上変わったらボイスに伝える
+		static constexpr float GAIN_EPSILON_ = 0.002f;
+		//まとめて計算する数
+		static constexpr uint32_t LANE_COUNT_ = 4u;
+		//鳴らしているものよりこの倍以上大きければ入れ替える(境目で行ったり来たりしないように)
+		static constexpr float REPLACE_GAIN_RATIO_ = 2.0f;
+
+	private:
+		//ボイスプール
+		VoicePool* voicePool_ = nullptr;
+		//エミッタ
+		std::vector<Emitter> emitters_;
+		//空いている番号
+		std::vector<uint32_t> freeIds_;
+		//使ったことのある番号の数(4の倍数に切り上げて計算する)
+		uint32_t usedCount_ = 0u;
+		//このフレームで鳴らしたいのにボイスが無いもの
+		std::vector<uint32_t> candidateIds_;
+		//ボイスを鳴らしているもの
+		std::vector<uint32_t> playingIds_;
+
+		//ここから下はまとめて計算するための並び(SoA)
+		//位置
+		std::vector<float> positionX_;
+		std::vector<float> positionY_;
+		std::vector<float> positionZ_;
+		//向き
+		std::vector<float> directionX_;
+		std::vector<float> directionY_;
+		std::vector<float> directionZ_;
+		//最小距離
+		std::vector<float> minDistance_;
+		//最大距離
+		std::vector<float> maxDistance_;
+		//1/(最大距離-最小距離)
+		std::vector<float> inverseRange_;
+		//減衰の仕方(使うものだけ1)
+		std::vector<float> linearWeight_;
+		std::vector<float> inverseWeight_;
+		std::vector<float> inverseSquareWeight_;
+		//コーンの外側のcos
+		std::vector<float> coneOuterCos_;
+		//1/(内側のcos-外側のcos)
+		std::vector<float> inverseConeRange_;
+		//コーンの外側での音量
+		std::vector<float> coneOuterGain_;
+		//音量(鳴らしていなければ0)
+		std::vector<float> volume_;
+		//遮られていない割合
+		std::vector<float> openness_;
+
+		//計算した大きさ
+		std::vector<float> gain_;
+		std::vector<float> pan_;
+		std::vector<float> left_;
+		std::vector<float> right_;
+
+		//統計
+		Statistics statistics_ = {};
+
+	};
+
+}
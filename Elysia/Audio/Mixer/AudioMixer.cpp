@@ -0,0 +1,510 @@
+#include "AudioMixer.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+//SSEが使える時はまとめて計算する
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define ELYSIA_AUDIO_MIXER_SSE
+#endif
+
+namespace {
+
+	/// <summary>
+	/// 音量を掛けて足す
+	/// </summary>
+	/// <param name="destination">足す先</param>
+	/// <param name="source">足すもの</param>
+	/// <param name="gain">音量</param>
+	/// <param name="count">サンプル数</param>
+	void MixAdd(float* destination, const float* source, const float& gain, const uint32_t& count) {
+		uint32_t i = 0u;
+#ifdef ELYSIA_AUDIO_MIXER_SSE
+		__m128 gains = _mm_set1_ps(gain);
+		for (; i + 4u <= count; i += 4u) {
+			__m128 mixed = _mm_add_ps(_mm_loadu_ps(destination + i), _mm_mul_ps(_mm_loadu_ps(source + i), gains));
+			_mm_storeu_ps(destination + i, mixed);
+		}
+#endif
+		for (; i < count; ++i) {
+			destination[i] += source[i] * gain;
+		}
+	}
+
+	/// <summary>
+	/// 音量を掛ける
+	/// </summary>
+	/// <param name="samples">サンプル</param>
+	/// <param name="gain">音量</param>
+	/// <param name="count">サンプル数</param>
+	void Scale(float* samples, const float& gain, const uint32_t& count) {
+		uint32_t i = 0u;
+#ifdef ELYSIA_AUDIO_MIXER_SSE
+		__m128 gains = _mm_set1_ps(gain);
+		for (; i + 4u <= count; i += 4u) {
+			_mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), gains));
+		}
+#endif
+		for (; i < count; ++i) {
+			samples[i] *= gain;
+		}
+	}
+
+	/// <summary>
+	/// 同じ間隔で読む時の線形補間
+	/// 周波数の比が1の時(ほとんどの音)はずれが一定なのでまとめて計算できる
+	/// </summary>
+	/// <param name="destination">書き込み先</param>
+	/// <param name="source">読むもの(count + 1サンプル)</param>
+	/// <param name="fraction">ずれ</param>
+	/// <param name="count">サンプル数</param>
+	void LerpUnitStep(float* destination, const float* source, const float& fraction, const uint32_t& count) {
+		uint32_t i = 0u;
+#ifdef ELYSIA_AUDIO_MIXER_SSE
+		__m128 fractions = _mm_set1_ps(fraction);
+		for (; i + 4u <= count; i += 4u) {
+			__m128 current = _mm_loadu_ps(source + i);
+			__m128 next = _mm_loadu_ps(source + i + 1u);
+			_mm_storeu_ps(destination + i, _mm_add_ps(current, _mm_mul_ps(_mm_sub_ps(next, current), fractions)));
+		}
+#endif
+		for (; i < count; ++i) {
+			destination[i] = source[i] + (source[i + 1u] - source[i]) * fraction;
+		}
+	}
+
+	/// <summary>
+	/// 間隔を変えて読む時の線形補間
+	/// </summary>
+	/// <param name="destination">書き込み先</param>
+	/// <param name="source">読むもの</param>
+	/// <param name="fraction">最初のずれ(固定小数点)</param>
+	/// <param name="step">間隔(固定小数点)</param>
+	/// <param name="count">サンプル数</param>
+	void LerpVariableStep(float* destination, const float* source, const uint64_t& fraction, const uint64_t& step, const uint32_t& count) {
+		const uint64_t FRACTION_MASK = (uint64_t(1u) << Elysia::AudioMixer::FRACTION_BITS_) - 1u;
+		const float FRACTION_SCALE = 1.0f / float(uint64_t(1u) << Elysia::AudioMixer::FRACTION_BITS_);
+		uint32_t i = 0u;
+#ifdef ELYSIA_AUDIO_MIXER_SSE
+		//読む場所はばらばらなので4つずつ集めてから補間する
+		for (; i + 4u <= count; i += 4u) {
+			alignas(16) float currents[4] = {};
+			alignas(16) float nexts[4] = {};
+			alignas(16) float fractions[4] = {};
+			for (uint32_t lane = 0u; lane < 4u; ++lane) {
+				uint64_t position = fraction + uint64_t(i + lane) * step;
+				size_t index = size_t(position >> Elysia::AudioMixer::FRACTION_BITS_);
+				currents[lane] = source[index];
+				nexts[lane] = source[index + 1u];
+				fractions[lane] = float(position & FRACTION_MASK) * FRACTION_SCALE;
+			}
+			__m128 current = _mm_load_ps(currents);
+			__m128 lerped = _mm_add_ps(current, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(nexts), current), _mm_load_ps(fractions)));
+			_mm_storeu_ps(destination + i, lerped);
+		}
+#endif
+		for (; i < count; ++i) {
+			uint64_t position = fraction + uint64_t(i) * step;
+			size_t index = size_t(position >> Elysia::AudioMixer::FRACTION_BITS_);
+			float t = float(position & FRACTION_MASK) * FRACTION_SCALE;
+			destination[i] = source[index] + (source[index + 1u] - source[index]) * t;
+		}
+	}
+
+}
+
+void Elysia::AudioMixer::Initialize(const Settings& settings) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(settings.sampleRate > 0u && settings.framesPerBlock > 0u);
+	settings_ = settings;
+	sources_.clear();
+	buses_.clear();
+	for (std::vector<float>& window : window_) {
+		window.clear();
+	}
+	for (std::vector<float>& resampled : resampled_) {
+		resampled.assign(settings_.framesPerBlock, 0.0f);
+	}
+	statistics_ = {};
+
+	//マスター
+	Bus master = {
+		.parentBusId = MASTER_BUS_,
+		.volume = 1.0f,
+		.filter = {},
+		.samples = {},
+	};
+	for (std::vector<float>& samples : master.samples) {
+		samples.assign(settings_.framesPerBlock, 0.0f);
+	}
+	buses_.push_back(std::move(master));
+}
+
+uint32_t Elysia::AudioMixer::CreateBus(const uint32_t& parentBusId) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	//番号の大きい方から混ぜるので、送り先は先に作ってあること
+	assert(parentBusId < buses_.size());
+
+	Bus bus = {
+		.parentBusId = parentBusId,
+		.volume = 1.0f,
+		.filter = {},
+		.samples = {},
+	};
+	for (std::vector<float>& samples : bus.samples) {
+		samples.assign(settings_.framesPerBlock, 0.0f);
+	}
+	buses_.push_back(std::move(bus));
+	return uint32_t(buses_.size() - 1u);
+}
+
+void Elysia::AudioMixer::SetBusVolume(const uint32_t& busId, const float& volume) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(busId < buses_.size());
+	buses_[busId].volume = volume;
+}
+
+void Elysia::AudioMixer::SetBusFilter(const uint32_t& busId, const BiquadParameters& parameters) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(busId < buses_.size());
+	Filter& filter = buses_[busId].filter;
+	for (BiquadFilter& channel : filter.channels) {
+		channel.SetParameters(parameters, settings_.sampleRate);
+	}
+	//かけ始めは前の値が残っていないように
+	if (filter.isEnabled == false) {
+		for (BiquadFilter& channel : filter.channels) {
+			channel.Reset();
+		}
+	}
+	filter.isEnabled = true;
+}
+
+void Elysia::AudioMixer::ClearBusFilter(const uint32_t& busId) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(busId < buses_.size());
+	buses_[busId].filter.isEnabled = false;
+}
+
+uint32_t Elysia::AudioMixer::CreateSource(const AudioFormat& format, const uint32_t& busId) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(busId < buses_.size());
+	//16bit整数か32bit浮動小数点だけ
+	assert((format.isFloat == false && format.bitsPerSample == 16u) || (format.isFloat == true && format.bitsPerSample == 32u));
+	assert(format.channelCount >= 1u && format.channelCount <= MAX_SOURCE_CHANNEL_COUNT_);
+	assert(format.sampleRate > 0u);
+
+	Source source = {
+		.format = format,
+		.busId = busId,
+		.buffer = {},
+		.frameCount = 0u,
+		.loopEnd = 0u,
+		.remainingLoopCount = 0u,
+		.position = 0u,
+		.volume = 1.0f,
+		.frequencyRatio = 1.0f,
+		.outputMatrix = {},
+		.filter = {},
+		.isPlaying = false,
+	};
+	//モノラルは両方に、ステレオはそのまま
+	if (format.channelCount == 1u) {
+		source.outputMatrix = { 1.0f, 1.0f, 0.0f, 0.0f };
+	}
+	else {
+		source.outputMatrix = { 1.0f, 0.0f, 0.0f, 1.0f };
+	}
+	sources_.push_back(source);
+
+	//混ぜる時に確保しないように、ここで一番大きいものに合わせておく
+	size_t windowCapacity = CalculateWindowCapacity(format);
+	for (std::vector<float>& window : window_) {
+		if (window.size() < windowCapacity) {
+			window.resize(windowCapacity, 0.0f);
+		}
+	}
+	return uint32_t(sources_.size() - 1u);
+}
+
+void Elysia::AudioMixer::Start(const uint32_t& sourceId, const SourceBuffer& buffer) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	Source& source = sources_[sourceId];
+	uint32_t blockAlign = source.format.GetBlockAlign();
+	assert(buffer.data != nullptr && buffer.byteCount >= blockAlign);
+
+	source.buffer = buffer;
+	source.frameCount = buffer.byteCount / blockAlign;
+	//長さが0なら最後まで
+	source.loopEnd = (buffer.loopLength == 0u) ? source.frameCount : buffer.loopBegin + buffer.loopLength;
+	assert(buffer.loopBegin < source.loopEnd && source.loopEnd <= source.frameCount);
+	source.remainingLoopCount = buffer.loopCount;
+	source.position = 0u;
+	for (BiquadFilter& channel : source.filter.channels) {
+		channel.Reset();
+	}
+	source.isPlaying = true;
+}
+
+void Elysia::AudioMixer::Stop(const uint32_t& sourceId) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	sources_[sourceId].isPlaying = false;
+}
+
+void Elysia::AudioMixer::ExitLoop(const uint32_t& sourceId) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	sources_[sourceId].remainingLoopCount = 0u;
+}
+
+void Elysia::AudioMixer::SetVolume(const uint32_t& sourceId, const float& volume) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	sources_[sourceId].volume = volume;
+}
+
+void Elysia::AudioMixer::SetFrequencyRatio(const uint32_t& sourceId, const float& ratio) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	//作業用の大きさを超えないように
+	sources_[sourceId].frequencyRatio = std::clamp(ratio, 1.0f / 1024.0f, MAX_FREQUENCY_RATIO_);
+}
+
+void Elysia::AudioMixer::SetPan(const uint32_t& sourceId, const float& pan) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	Source& source = sources_[sourceId];
+	float left = 0.5f - pan / 2.0f;
+	float right = 0.5f + pan / 2.0f;
+	if (source.format.channelCount == 1u) {
+		source.outputMatrix = { left, right, 0.0f, 0.0f };
+	}
+	else {
+		source.outputMatrix = { left, 0.0f, 0.0f, right };
+	}
+}
+
+void Elysia::AudioMixer::SetOutputMatrix(const uint32_t& sourceId, const float* matrix) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	assert(matrix != nullptr);
+	Source& source = sources_[sourceId];
+	uint32_t count = OUTPUT_CHANNEL_COUNT_ * source.format.channelCount;
+	std::copy(matrix, matrix + count, source.outputMatrix.begin());
+}
+
+void Elysia::AudioMixer::SetFilter(const uint32_t& sourceId, const BiquadParameters& parameters) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	Filter& filter = sources_[sourceId].filter;
+	for (BiquadFilter& channel : filter.channels) {
+		channel.SetParameters(parameters, settings_.sampleRate);
+	}
+	if (filter.isEnabled == false) {
+		for (BiquadFilter& channel : filter.channels) {
+			channel.Reset();
+		}
+	}
+	filter.isEnabled = true;
+}
+
+void Elysia::AudioMixer::ClearFilter(const uint32_t& sourceId) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	sources_[sourceId].filter.isEnabled = false;
+}
+
+bool Elysia::AudioMixer::IsPlaying(const uint32_t& sourceId) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(sourceId < sources_.size());
+	return sources_[sourceId].isPlaying;
+}
+
+void Elysia::AudioMixer::Render(float* output, const uint32_t& frameCount) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(output != nullptr);
+	//作業用の大きさに収まるように分けて混ぜる
+	uint32_t renderedFrameCount = 0u;
+	while (renderedFrameCount < frameCount) {
+		uint32_t blockFrameCount = std::min(frameCount - renderedFrameCount, settings_.framesPerBlock);
+		RenderBlock(output + size_t(renderedFrameCount) * OUTPUT_CHANNEL_COUNT_, blockFrameCount);
+		renderedFrameCount += blockFrameCount;
+	}
+	statistics_.renderedFrameCount += frameCount;
+}
+
+Elysia::AudioMixer::Statistics Elysia::AudioMixer::GetStatistics() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return statistics_;
+}
+
+void Elysia::AudioMixer::RenderBlock(float* output, const uint32_t& frameCount) {
+	for (Bus& bus : buses_) {
+		for (std::vector<float>& samples : bus.samples) {
+			std::fill(samples.begin(), samples.begin() + frameCount, 0.0f);
+		}
+	}
+
+	//ソースをバスに足す
+	uint32_t activeSourceCount = 0u;
+	for (Source& source : sources_) {
+		if (source.isPlaying == false) {
+			continue;
+		}
+		++activeSourceCount;
+
+		//鳴り終わったらそこまでにする
+		//フィルターの余韻も鳴り終わったところで切ると、何フレームずつ頼まれても同じになる
+		uint32_t channelCount = source.format.channelCount;
+		uint32_t resampledFrameCount = ResampleSource(source, frameCount);
+
+		Bus& bus = buses_[source.busId];
+		for (uint32_t channel = 0u; channel < channelCount; ++channel) {
+			if (source.filter.isEnabled == true) {
+				source.filter.channels[channel].Process(resampled_[channel].data(), resampledFrameCount);
+			}
+			for (uint32_t outputChannel = 0u; outputChannel < OUTPUT_CHANNEL_COUNT_; ++outputChannel) {
+				float gain = source.outputMatrix[outputChannel * channelCount + channel] * source.volume;
+				if (gain == 0.0f) {
+					continue;
+				}
+				MixAdd(bus.samples[outputChannel].data(), resampled_[channel].data(), gain, resampledFrameCount);
+			}
+		}
+	}
+
+	//番号の大きいバスから送り先に足していく(送り先は必ず番号が小さい)
+	for (uint32_t busId = uint32_t(buses_.size()); busId-- > 0u;) {
+		Bus& bus = buses_[busId];
+		for (uint32_t channel = 0u; channel < OUTPUT_CHANNEL_COUNT_; ++channel) {
+			float* samples = bus.samples[channel].data();
+			if (bus.filter.isEnabled == true) {
+				bus.filter.channels[channel].Process(samples, frameCount);
+			}
+			if (busId == MASTER_BUS_) {
+				Scale(samples, bus.volume, frameCount);
+			}
+			else {
+				MixAdd(buses_[bus.parentBusId].samples[channel].data(), samples, bus.volume, frameCount);
+			}
+		}
+	}
+
+	//左右交互に並べる
+	const float* left = buses_[MASTER_BUS_].samples[0].data();
+	const float* right = buses_[MASTER_BUS_].samples[1].data();
+	for (uint32_t i = 0u; i < frameCount; ++i) {
+		output[i * OUTPUT_CHANNEL_COUNT_] = left[i];
+		output[i * OUTPUT_CHANNEL_COUNT_ + 1u] = right[i];
+	}
+
+	++statistics_.renderedBlockCount;
+	statistics_.activeSourceCount = activeSourceCount;
+}
+
+uint32_t Elysia::AudioMixer::ResampleSource(Source& source, const uint32_t& frameCount) {
+	//出力の1フレームでソースを何フレーム進めるか
+	//固定小数点にしておくと、何フレームずつ頼まれても進み方が全く同じになる
+	double ratio = double(source.frequencyRatio) * double(source.format.sampleRate) / double(settings_.sampleRate);
+	uint64_t step = uint64_t(std::llround(std::ldexp(ratio, int32_t(FRACTION_BITS_))));
+	uint64_t fraction = source.position & ((uint64_t(1u) << FRACTION_BITS_) - 1u);
+	//補間で次のフレームも読むので1つ多く
+	uint32_t windowFrameCount = uint32_t((fraction + uint64_t(frameCount - 1u) * step) >> FRACTION_BITS_) + 2u;
+	assert(windowFrameCount <= window_[0].size());
+	uint32_t validFrameCount = FetchWindow(source, source.position >> FRACTION_BITS_, windowFrameCount);
+
+	//最後のフレームを超えて読む前まで
+	uint32_t resampledFrameCount = frameCount;
+	if (validFrameCount < windowFrameCount) {
+		uint64_t validPosition = uint64_t(validFrameCount) << FRACTION_BITS_;
+		uint64_t count = (validPosition > fraction) ? (validPosition - fraction + step - 1u) / step : 0u;
+		resampledFrameCount = uint32_t(std::min<uint64_t>(count, frameCount));
+	}
+
+	for (uint32_t channel = 0u; channel < source.format.channelCount; ++channel) {
+		if (step == (uint64_t(1u) << FRACTION_BITS_)) {
+			LerpUnitStep(resampled_[channel].data(), window_[channel].data(), float(fraction) / float(uint64_t(1u) << FRACTION_BITS_), frameCount);
+		}
+		else {
+			LerpVariableStep(resampled_[channel].data(), window_[channel].data(), fraction, step, frameCount);
+		}
+	}
+	AdvanceSource(source, uint64_t(frameCount) * step);
+	return resampledFrameCount;
+}
+
+uint32_t Elysia::AudioMixer::FetchWindow(const Source& source, const uint64_t& firstFrame, const uint32_t& windowFrameCount) {
+	uint32_t channelCount = source.format.channelCount;
+	uint32_t loopBegin = source.buffer.loopBegin;
+	//進める時と同じようにループの終わりで始まりに戻る
+	uint64_t frame = firstFrame;
+	uint32_t remainingLoopCount = source.remainingLoopCount;
+	uint32_t filledFrameCount = 0u;
+	while (filledFrameCount < windowFrameCount) {
+		if (remainingLoopCount > 0u && frame >= source.loopEnd) {
+			frame = loopBegin + (frame - source.loopEnd);
+			if (remainingLoopCount != LOOP_INFINITE_) {
+				--remainingLoopCount;
+			}
+			continue;
+		}
+
+		//最後まで行ったら残りは無音
+		if (frame >= source.frameCount) {
+			for (uint32_t channel = 0u; channel < channelCount; ++channel) {
+				std::fill(window_[channel].begin() + filledFrameCount, window_[channel].begin() + windowFrameCount, 0.0f);
+			}
+			return filledFrameCount;
+		}
+
+		//ループの終わりか最後までは続けて読める
+		uint64_t runEnd = (remainingLoopCount > 0u) ? source.loopEnd : source.frameCount;
+		uint32_t runFrameCount = uint32_t(std::min<uint64_t>(windowFrameCount - filledFrameCount, runEnd - frame));
+		if (source.format.isFloat == true) {
+			const float* samples = reinterpret_cast<const float*>(source.buffer.data) + frame * channelCount;
+			for (uint32_t i = 0u; i < runFrameCount; ++i) {
+				for (uint32_t channel = 0u; channel < channelCount; ++channel) {
+					window_[channel][filledFrameCount + i] = samples[i * channelCount + channel];
+				}
+			}
+		}
+		else {
+			const int16_t* samples = reinterpret_cast<const int16_t*>(source.buffer.data) + frame * channelCount;
+			for (uint32_t i = 0u; i < runFrameCount; ++i) {
+				for (uint32_t channel = 0u; channel < channelCount; ++channel) {
+					window_[channel][filledFrameCount + i] = float(samples[i * channelCount + channel]) * (1.0f / 32768.0f);
+				}
+			}
+		}
+		filledFrameCount += runFrameCount;
+		frame += runFrameCount;
+	}
+	return filledFrameCount;
+}
+
+void Elysia::AudioMixer::AdvanceSource(Source& source, const uint64_t& advance) {
+	source.position += advance;
+	//ループの終わりを超えた分は始まりから
+	uint64_t loopEnd = uint64_t(source.loopEnd) << FRACTION_BITS_;
+	uint64_t loopLength = uint64_t(source.loopEnd - source.buffer.loopBegin) << FRACTION_BITS_;
+	while (source.remainingLoopCount > 0u && source.position >= loopEnd) {
+		source.position -= loopLength;
+		if (source.remainingLoopCount != LOOP_INFINITE_) {
+			--source.remainingLoopCount;
+		}
+	}
+	if (source.remainingLoopCount == 0u && (source.position >> FRACTION_BITS_) >= source.frameCount) {
+		source.isPlaying = false;
+	}
+}
+
+uint32_t Elysia::AudioMixer::CalculateWindowCapacity(const AudioFormat& format) const {
+	//一番速く読む時に1ブロックで読むフレーム数と、補間とずれの分
+	double maxStep = double(MAX_FREQUENCY_RATIO_) * double(format.sampleRate) / double(settings_.sampleRate);
+	return uint32_t(std::ceil(double(settings_.framesPerBlock) * maxStep)) + 3u;
+}
@@ -0,0 +1,342 @@
+#pragma once
+
+/**
+ * @file AudioMixer.h
+ * @brief XAudio2に頼らずに音を混ぜるクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <mutex>
+
+#include "AudioFormat.h"
+#include "BiquadFilter.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// XAudio2に頼らずに音を混ぜるクラス
+	/// ソース(1つの音)を周波数を変えながら読み、フィルター、パンをかけてバス(サブミックス)に足し、
+	/// バスをまとめてステレオのfloatにする
+	/// 出力はMixerDecoderでストリーミングの送り先(XAudio2、何も鳴らさない、WAVファイル)に流す
+	/// ゲームのスレッドからの設定と、展開するスレッドからのRenderが重なっても良い
+	/// </summary>
+	class AudioMixer final {
+	public:
+		/// <summary>
+		/// 設定
+		/// </summary>
+		struct Settings {
+			//出力のサンプリング周波数
+			uint32_t sampleRate;
+			//1回に混ぜるフレーム数(これより多く頼まれたら分けて混ぜる)
+			uint32_t framesPerBlock;
+		};
+
+		/// <summary>
+		/// 鳴らすもの
+		/// XAUDIO2_BUFFERと同じようにループする範囲を決められる
+		/// </summary>
+		struct SourceBuffer {
+			//PCM(鳴り終わるまで持っておいてね)
+			const uint8_t* data;
+			//バイト数
+			uint32_t byteCount;
+			//ループの始まり(フレーム)
+			uint32_t loopBegin;
+			//ループの長さ(フレーム、0なら最後まで)
+			uint32_t loopLength;
+			//ループする回数(最初の1回は含まない)
+			uint32_t loopCount;
+		};
+
+		/// <summary>
+		/// 統計
+		/// </summary>
+		struct Statistics {
+			//混ぜたフレーム数
+			uint64_t renderedFrameCount;
+			//混ぜた回数(ブロック数)
+			uint64_t renderedBlockCount;
+			//最後に混ぜた時に鳴っていたソースの数
+			uint32_t activeSourceCount;
+		};
+
+		//出力のチャンネル数(ステレオ)
+		static constexpr uint32_t OUTPUT_CHANNEL_COUNT_ = 2u;
+		//ソースのチャンネル数の上限
+		static constexpr uint32_t MAX_SOURCE_CHANNEL_COUNT_ = 2u;
+		//全部が集まるバス
+		static constexpr uint32_t MASTER_BUS_ = 0u;
+		//ずっとループ(XAUDIO2_LOOP_INFINITEと同じ)
+		static constexpr uint32_t LOOP_INFINITE_ = 255u;
+		//周波数の比の上限(XAUDIO2_DEFAULT_FREQ_RATIOより広め)
+		static constexpr float MAX_FREQUENCY_RATIO_ = 4.0f;
+		//読んでいる位置の小数部分のビット数
+		static constexpr uint32_t FRACTION_BITS_ = 32u;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="settings">設定</param>
+		void Initialize(const Settings& settings);
+
+		/// <summary>
+		/// バスを作る
+		/// 送り先は先に作ってあるバスにしてね(順番に混ぜられるように)
+		/// </summary>
+		/// <param name="parentBusId">送り先のバス</param>
+		/// <returns>番号</returns>
+		uint32_t CreateBus(const uint32_t& parentBusId);
+
+		/// <summary>
+		/// バスの音量を設定
+		/// </summary>
+		/// <param name="busId">バス</param>
+		/// <param name="volume">音量</param>
+		void SetBusVolume(const uint32_t& busId, const float& volume);
+
+		/// <summary>
+		/// バスにフィルターをかける
+		/// </summary>
+		/// <param name="busId">バス</param>
+		/// <param name="parameters">設定</param>
+		void SetBusFilter(const uint32_t& busId, const BiquadParameters& parameters);
+
+		/// <summary>
+		/// バスのフィルターを外す
+		/// </summary>
+		/// <param name="busId">バス</param>
+		void ClearBusFilter(const uint32_t& busId);
+
+		/// <summary>
+		/// ソースを作る
+		/// 16bit整数か32bit浮動小数点の、モノラルかステレオ
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <param name="busId">送り先のバス</param>
+		/// <returns>番号</returns>
+		uint32_t CreateSource(const AudioFormat& format, const uint32_t& busId);
+
+		/// <summary>
+		/// 鳴らす
+		/// 鳴っていたら止めて最初から
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		/// <param name="buffer">鳴らすもの</param>
+		void Start(const uint32_t& sourceId, const SourceBuffer& buffer);
+
+		/// <summary>
+		/// 止める
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		void Stop(const uint32_t& sourceId);
+
+		/// <summary>
+		/// ループを抜ける
+		/// 今の周の終わりから最後まで鳴らして止まる
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		void ExitLoop(const uint32_t& sourceId);
+
+		/// <summary>
+		/// 音量を設定
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		/// <param name="volume">音量</param>
+		void SetVolume(const uint32_t& sourceId, const float& volume);
+
+		/// <summary>
+		/// 周波数の比を設定(ピッチ)
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		/// <param name="ratio">比(1で元の高さ、2で1オクターブ上)</param>
+		void SetFrequencyRatio(const uint32_t& sourceId, const float& ratio);
+
+		/// <summary>
+		/// パンを設定
+		/// Audio::SetPanと同じで、左は0.5-pan/2、右は0.5+pan/2
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		/// <param name="pan">-1で左、1で右</param>
+		void SetPan(const uint32_t& sourceId, const float& pan);
+
+		/// <summary>
+		/// 出力の行列を設定
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		/// <param name="matrix">[出力のチャンネル * ソースのチャンネル数 + ソースのチャンネル]</param>
+		void SetOutputMatrix(const uint32_t& sourceId, const float* matrix);
+
+		/// <summary>
+		/// フィルターをかける
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		/// <param name="parameters">設定</param>
+		void SetFilter(const uint32_t& sourceId, const BiquadParameters& parameters);
+
+		/// <summary>
+		/// フィルターを外す
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		void ClearFilter(const uint32_t& sourceId);
+
+		/// <summary>
+		/// 鳴っているかどうか
+		/// </summary>
+		/// <param name="sourceId">ソース</param>
+		/// <returns>鳴っているかどうか</returns>
+		bool IsPlaying(const uint32_t& sourceId);
+
+		/// <summary>
+		/// 混ぜる
+		/// </summary>
+		/// <param name="output">書き込み先(ステレオのfloatをframeCountフレーム分)</param>
+		/// <param name="frameCount">フレーム数</param>
+		void Render(float* output, const uint32_t& frameCount);
+
+	public:
+		/// <summary>
+		/// 設定を取得
+		/// </summary>
+		/// <returns>設定</returns>
+		inline const Settings& GetSettings() const {
+			return settings_;
+		}
+
+		/// <summary>
+		/// 出力の形式を取得
+		/// </summary>
+		/// <returns>形式</returns>
+		inline AudioFormat GetOutputFormat() const {
+			return { .channelCount = OUTPUT_CHANNEL_COUNT_, .sampleRate = settings_.sampleRate, .bitsPerSample = 32u, .isFloat = true };
+		}
+
+		/// <summary>
+		/// 統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		Statistics GetStatistics();
+
+	private:
+		/// <summary>
+		/// チャンネルごとのフィルター
+		/// </summary>
+		struct Filter {
+			std::array<BiquadFilter, OUTPUT_CHANNEL_COUNT_> channels;
+			bool isEnabled;
+		};
+
+		/// <summary>
+		/// ソース
+		/// </summary>
+		struct Source {
+			//形式
+			AudioFormat format;
+			//送り先のバス
+			uint32_t busId;
+			//鳴らすもの
+			SourceBuffer buffer;
+			//全部のフレーム数
+			uint32_t frameCount;
+			//ループの終わり(フレーム)
+			uint32_t loopEnd;
+			//残りのループ回数
+			uint32_t remainingLoopCount;
+			//今読んでいる位置(フレームの固定小数点、小数は補間に使う)
+			uint64_t position;
+			//音量
+			float volume;
+			//周波数の比
+			float frequencyRatio;
+			//出力の行列
+			std::array<float, OUTPUT_CHANNEL_COUNT_* MAX_SOURCE_CHANNEL_COUNT_> outputMatrix;
+			//フィルター
+			Filter filter;
+			//鳴っているかどうか
+			bool isPlaying;
+		};
+
+		/// <summary>
+		/// バス
+		/// </summary>
+		struct Bus {
+			//送り先(マスターは自分)
+			uint32_t parentBusId;
+			//音量
+			float volume;
+			//フィルター
+			Filter filter;
+			//混ぜている途中のもの(チャンネルごと)
+			std::array<std::vector<float>, OUTPUT_CHANNEL_COUNT_> samples;
+		};
+
+		/// <summary>
+		/// 1ブロック分混ぜる
+		/// </summary>
+		/// <param name="output">書き込み先</param>
+		/// <param name="frameCount">フレーム数(framesPerBlock以下)</param>
+		void RenderBlock(float* output, const uint32_t& frameCount);
+
+		/// <summary>
+		/// ソースを出力の周波数に合わせて読む
+		/// 結果はresampled_に入る
+		/// </summary>
+		/// <param name="source">ソース</param>
+		/// <param name="frameCount">フレーム数</param>
+		/// <returns>鳴り終わるまでのフレーム数</returns>
+		uint32_t ResampleSource(Source& source, const uint32_t& frameCount);
+
+		/// <summary>
+		/// ソースのフレームを読んでfloatにする(ループを考える)
+		/// 結果はwindow_に入る
+		/// </summary>
+		/// <param name="source">ソース</param>
+		/// <param name="firstFrame">最初のフレーム</param>
+		/// <param name="windowFrameCount">読むフレーム数</param>
+		/// <returns>最後までに読めたフレーム数(残りは0で埋める)</returns>
+		uint32_t FetchWindow(const Source& source, const uint64_t& firstFrame, const uint32_t& windowFrameCount);
+
+		/// <summary>
+		/// ソースのフレームを進める
+		/// ループの終わりを超えたら始まりに戻す
+		/// </summary>
+		/// <param name="source">ソース</param>
+		/// <param name="advance">進めるフレーム数(固定小数点)</param>
+		void AdvanceSource(Source& source, const uint64_t& advance);
+
+		/// <summary>
+		/// 1回で読むソースのフレーム数の上限
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <returns>フレーム数</returns>
+		uint32_t CalculateWindowCapacity(const AudioFormat& format) const;
+
+	private:
+		//設定
+		Settings settings_ = {};
+		//ソース
+		std::vector<Source> sources_;
+		//バス
+		std::vector<Bus> buses_;
+
+		//ここから下は混ぜる時に使う作業用(Renderの中で確保しないように作る時に大きさを決める)
+		//ソースから読んだもの(チャンネルごと)
+		std::array<std::vector<float>, MAX_SOURCE_CHANNEL_COUNT_> window_;
+		//出力の周波数に合わせたもの(チャンネルごと)
+		std::array<std::vector<float>, MAX_SOURCE_CHANNEL_COUNT_> resampled_;
+
+		//設定とRenderが重ならないようにする
+		std::mutex mutex_;
+		//統計
+		Statistics statistics_ = {};
+
+	};
+
+}
@@ -0,0 +1,71 @@
+#include "BiquadFilter.h"
+
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+
+void Elysia::BiquadFilter::SetParameters(const BiquadParameters& parameters, const uint32_t& sampleRate) {
+	assert(sampleRate > 0u);
+	//ナイキスト周波数を超えると不安定になる
+	float frequency = std::clamp(parameters.frequency, 1.0f, float(sampleRate) * 0.49f);
+	float q = std::max(parameters.q, 0.01f);
+	float omega = 2.0f * std::numbers::pi_v<float> * frequency / float(sampleRate);
+	float cosOmega = std::cos(omega);
+	float alpha = std::sin(omega) / (2.0f * q);
+
+	float b0 = 0.0f;
+	float b1 = 0.0f;
+	float b2 = 0.0f;
+	switch (parameters.type) {
+	case BiquadType::LowPass:
+		b0 = (1.0f - cosOmega) * 0.5f;
+		b1 = 1.0f - cosOmega;
+		b2 = (1.0f - cosOmega) * 0.5f;
+		break;
+	case BiquadType::HighPass:
+		b0 = (1.0f + cosOmega) * 0.5f;
+		b1 = -(1.0f + cosOmega);
+		b2 = (1.0f + cosOmega) * 0.5f;
+		break;
+	case BiquadType::BandPass:
+		//ピークの大きさが1になる方
+		b0 = alpha;
+		b1 = 0.0f;
+		b2 = -alpha;
+		break;
+	case BiquadType::Notch:
+		b0 = 1.0f;
+		b1 = -2.0f * cosOmega;
+		b2 = 1.0f;
+		break;
+	}
+
+	float a0 = 1.0f + alpha;
+	b0_ = b0 / a0;
+	b1_ = b1 / a0;
+	b2_ = b2 / a0;
+	a1_ = -2.0f * cosOmega / a0;
+	a2_ = (1.0f - alpha) / a0;
+}
+
+void Elysia::BiquadFilter::Reset() {
+	z1_ = 0.0f;
+	z2_ = 0.0f;
+}
+
+void Elysia::BiquadFilter::Process(float* samples, const uint32_t& sampleCount) {
+	//前のサンプルに依存するのでまとめて計算できない
+	//メンバを直接書き換えるより速いのでローカルに持ってくる
+	float z1 = z1_;
+	float z2 = z2_;
+	for (uint32_t i = 0u; i < sampleCount; ++i) {
+		float input = samples[i];
+		float output = b0_ * input + z1;
+		z1 = b1_ * input - a1_ * output + z2;
+		z2 = b2_ * input - a2_ * output;
+		samples[i] = output;
+	}
+	z1_ = z1;
+	z2_ = z2;
+}
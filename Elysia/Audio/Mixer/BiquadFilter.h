@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * @file BiquadFilter.h
+ * @brief 2次のIIRフィルター(バイクアッド)
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// フィルターの種類
+	/// XAudio2のXAUDIO2_FILTER_TYPEと同じものを用意する
+	/// </summary>
+	enum class BiquadType : uint32_t {
+		//ローパス
+		LowPass,
+		//ハイパス
+		HighPass,
+		//バンドパス
+		BandPass,
+		//ノッチ
+		Notch,
+	};
+
+	/// <summary>
+	/// フィルターの設定
+	/// </summary>
+	struct BiquadParameters {
+		//種類
+		BiquadType type;
+		//カットオフ(中心)周波数(Hz)
+		float frequency;
+		//Q(0.7071で平ら)
+		float q;
+	};
+
+	/// <summary>
+	/// 2次のIIRフィルター(バイクアッド)
+	/// 係数はRBJのAudio EQ Cookbookの式で作る
+	/// 1つのチャンネル分の状態を持つので、チャンネルごとに用意してね
+	/// </summary>
+	class BiquadFilter final {
+	public:
+		/// <summary>
+		/// 設定
+		/// </summary>
+		/// <param name="parameters">設定</param>
+		/// <param name="sampleRate">サンプリング周波数</param>
+		void SetParameters(const BiquadParameters& parameters, const uint32_t& sampleRate);
+
+		/// <summary>
+		/// 前のサンプルを忘れる
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// かける
+		/// </summary>
+		/// <param name="samples">サンプル(書き換える)</param>
+		/// <param name="sampleCount">サンプル数</param>
+		void Process(float* samples, const uint32_t& sampleCount);
+
+	private:
+		//係数(a0で割ってある)
+		float b0_ = 1.0f;
+		float b1_ = 0.0f;
+		float b2_ = 0.0f;
+		float a1_ = 0.0f;
+		float a2_ = 0.0f;
+		//前のサンプル(転置直接形II)
+		float z1_ = 0.0f;
+		float z2_ = 0.0f;
+
+	};
+
+}
@@ -0,0 +1,37 @@
+#include "MixerDecoder.h"
+
+#include <cassert>
+#include <algorithm>
+
+#include "AudioMixer.h"
+
+void Elysia::MixerDecoder::Initialize(AudioMixer* mixer, const uint64_t& frameCount) {
+	assert(mixer != nullptr);
+	mixer_ = mixer;
+	format_ = mixer_->GetOutputFormat();
+	frameCount_ = frameCount;
+	renderedFrameCount_ = 0u;
+}
+
+const Elysia::AudioFormat& Elysia::MixerDecoder::GetFormat() const {
+	return format_;
+}
+
+uint32_t Elysia::MixerDecoder::Decode(uint8_t* destination, const uint32_t& frameCount) {
+	uint32_t renderFrameCount = frameCount;
+	if (frameCount_ != 0u) {
+		renderFrameCount = uint32_t(std::min<uint64_t>(frameCount, frameCount_ - renderedFrameCount_));
+	}
+	//バッファはブロックの大きさごとに取っているのでfloatとして書いて良い
+	mixer_->Render(reinterpret_cast<float*>(destination), renderFrameCount);
+	renderedFrameCount_ += renderFrameCount;
+	return renderFrameCount;
+}
+
+bool Elysia::MixerDecoder::Seek(const uint64_t& frame) {
+	if (frame != 0u) {
+		return false;
+	}
+	renderedFrameCount_ = 0u;
+	return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file MixerDecoder.h
+ * @brief ミキサーの出力をストリーミングで流すためのデコーダー
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+#include "IAudioDecoder.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	class AudioMixer;
+
+	/// <summary>
+	/// ミキサーの出力をストリーミングで流すためのデコーダー
+	/// 展開する代わりにミキサーで混ぜるので、AudioStreamと送り先を選ぶだけで
+	/// XAudio2で鳴らす、何も鳴らさない、WAVファイルに書き出す、を切り替えられる
+	/// </summary>
+	class MixerDecoder final : public IAudioDecoder {
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="mixer">ミキサー</param>
+		/// <param name="frameCount">混ぜるフレーム数(0ならずっと、書き出す時は長さを決める)</param>
+		void Initialize(AudioMixer* mixer, const uint64_t& frameCount);
+
+		/// <summary>
+		/// 形式を取得
+		/// </summary>
+		/// <returns>形式</returns>
+		const AudioFormat& GetFormat() const override;
+
+		/// <summary>
+		/// 混ぜる
+		/// </summary>
+		/// <param name="destination">書き込み先(frameCountフレーム分)</param>
+		/// <param name="frameCount">混ぜたいフレーム数</param>
+		/// <returns>混ぜたフレーム数</returns>
+		uint32_t Decode(uint8_t* destination, const uint32_t& frameCount) override;
+
+		/// <summary>
+		/// 指定したフレームに移動
+		/// 混ぜたものは戻せないので、最初(数え直し)だけ
+		/// </summary>
+		/// <param name="frame">フレーム</param>
+		/// <returns>移動できたかどうか</returns>
+		bool Seek(const uint64_t& frame) override;
+
+	private:
+		//ミキサー
+		AudioMixer* mixer_ = nullptr;
+		//形式
+		AudioFormat format_ = {};
+		//混ぜるフレーム数
+		uint64_t frameCount_ = 0u;
+		//混ぜたフレーム数
+		uint64_t renderedFrameCount_ = 0u;
+
+	};
+
+}
@@ -0,0 +1,122 @@
+#include "AudioStream.h"
+
+#include <cassert>
+#include <algorithm>
+
+void Elysia::AudioStream::Initialize(std::unique_ptr<IAudioDecoder> decoder, IAudioStreamSink* sink, const Settings& settings) {
+	assert(decoder != nullptr && sink != nullptr);
+	//2つ以上無いと再生中に次を展開出来ない
+	assert(settings.bufferCount >= 2u && settings.framesPerBuffer > 0u);
+
+	decoder_ = std::move(decoder);
+	sink_ = sink;
+	settings_ = settings;
+	bytesPerBuffer_ = settings_.framesPerBuffer * decoder_->GetFormat().GetBlockAlign();
+	buffers_.assign(size_t(bytesPerBuffer_) * settings_.bufferCount, 0u);
+	writeIndex_ = 0u;
+	queuedCount_.store(0u, std::memory_order_release);
+	position_ = 0u;
+	isEnded_.store(true, std::memory_order_release);
+}
+
+void Elysia::AudioStream::SetLoopRange(const uint64_t& loopBeginFrame, const uint64_t& loopEndFrame) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(loopEndFrame == 0u || loopBeginFrame < loopEndFrame);
+	loopBeginFrame_ = loopBeginFrame;
+	loopEndFrame_ = loopEndFrame;
+}
+
+void Elysia::AudioStream::Restart(const uint32_t& loopCount) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	//送ってあるものは捨てる
+	//捨てたバッファもOnBufferEndで戻ってくるので、戻ってきたものから使う
+	sink_->Flush();
+	bool isSeeked = decoder_->Seek(0u);
+	assert(isSeeked == true);
+	isSeeked;
+	position_ = 0u;
+	remainingLoopCount_ = loopCount;
+	isEnded_.store(false, std::memory_order_release);
+}
+
+void Elysia::AudioStream::Stop() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	sink_->Flush();
+	isEnded_.store(true, std::memory_order_release);
+}
+
+void Elysia::AudioStream::ExitLoop() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	remainingLoopCount_ = 0u;
+}
+
+uint32_t Elysia::AudioStream::Pump() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	uint32_t submittedCount = 0u;
+	uint32_t blockAlign = decoder_->GetFormat().GetBlockAlign();
+	while (isEnded_.load(std::memory_order_relaxed) == false && queuedCount_.load(std::memory_order_acquire) < settings_.bufferCount) {
+		uint8_t* buffer = buffers_.data() + size_t(writeIndex_) * bytesPerBuffer_;
+		uint32_t frameCount = FillBuffer(buffer);
+		bool isEndOfStream = isEnded_.load(std::memory_order_relaxed);
+
+		//ちょうど前のバッファで終わっていたら終わりだけを伝える
+		if (frameCount == 0u) {
+			sink_->Submit(nullptr, 0u, true);
+			break;
+		}
+
+		//送った途端に再生し終わることもあるので先に数える
+		queuedCount_.fetch_add(1u, std::memory_order_acq_rel);
+		sink_->Submit(buffer, frameCount * blockAlign, isEndOfStream);
+		writeIndex_ = (writeIndex_ + 1u) % settings_.bufferCount;
+		++submittedCount;
+	}
+	return submittedCount;
+}
+
+void Elysia::AudioStream::OnBufferEnd() {
+	uint32_t previousCount = queuedCount_.fetch_sub(1u, std::memory_order_acq_rel);
+	assert(previousCount > 0u);
+	previousCount;
+}
+
+uint32_t Elysia::AudioStream::FillBuffer(uint8_t* destination) {
+	uint32_t blockAlign = decoder_->GetFormat().GetBlockAlign();
+	uint32_t filledFrameCount = 0u;
+	//ループの始まりに戻ってから1フレームも展開できなければ終わりにする(空の範囲で回り続けないように)
+	bool isJustLooped = false;
+	while (filledFrameCount < settings_.framesPerBuffer) {
+		//ループが残っていればループの終わりまで
+		bool isLooping = remainingLoopCount_ > 0u;
+		uint64_t endFrame = (isLooping == true && loopEndFrame_ != 0u) ? loopEndFrame_ : UINT64_MAX;
+		uint32_t requestFrameCount = uint32_t(std::min<uint64_t>(settings_.framesPerBuffer - filledFrameCount, endFrame - position_));
+		uint32_t decodedFrameCount = (requestFrameCount > 0u) ? decoder_->Decode(destination + size_t(filledFrameCount) * blockAlign, requestFrameCount) : 0u;
+		filledFrameCount += decodedFrameCount;
+		position_ += decodedFrameCount;
+		if (decodedFrameCount > 0u) {
+			isJustLooped = false;
+		}
+
+		//まだ続きがある
+		if (decodedFrameCount == requestFrameCount && position_ < endFrame) {
+			continue;
+		}
+
+		//ループの終わりか最後に着いた
+		if (isLooping == true && isJustLooped == false) {
+			if (remainingLoopCount_ != LOOP_INFINITE_) {
+				--remainingLoopCount_;
+			}
+			bool isSeeked = decoder_->Seek(loopBeginFrame_);
+			assert(isSeeked == true);
+			isSeeked;
+			position_ = loopBeginFrame_;
+			isJustLooped = true;
+			continue;
+		}
+
+		isEnded_.store(true, std::memory_order_release);
+		break;
+	}
+	return filledFrameCount;
+}
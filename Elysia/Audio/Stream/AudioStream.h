@@ -0,0 +1,165 @@
+#pragma once
+
+/**
+ * @file AudioStream.h
+ * @brief 少しずつ展開しながら再生するクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#include "IAudioDecoder.h"
+#include "IAudioStreamSink.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 少しずつ展開しながら再生するクラス
+	/// 長いBGMを全部展開しておくとメモリを使う上に読み込みで止まるので、
+	/// 小さいバッファをいくつか輪のように使い回して、空いたものから展開して送る
+	/// Pumpは展開するスレッド、OnBufferEndは再生するスレッドから呼ばれる
+	/// </summary>
+	class AudioStream final {
+	public:
+		/// <summary>
+		/// 設定
+		/// </summary>
+		struct Settings {
+			//バッファの数
+			uint32_t bufferCount;
+			//1つのバッファのフレーム数
+			uint32_t framesPerBuffer;
+		};
+
+		//ずっとループ
+		static constexpr uint32_t LOOP_INFINITE_ = UINT32_MAX;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="decoder">デコーダー</param>
+		/// <param name="sink">送り先</param>
+		/// <param name="settings">設定</param>
+		void Initialize(std::unique_ptr<IAudioDecoder> decoder, IAudioStreamSink* sink, const Settings& settings);
+
+		/// <summary>
+		/// ループする範囲の設定
+		/// </summary>
+		/// <param name="loopBeginFrame">ループの始まり</param>
+		/// <param name="loopEndFrame">ループの終わり(0なら最後まで)</param>
+		void SetLoopRange(const uint64_t& loopBeginFrame, const uint64_t& loopEndFrame);
+
+		/// <summary>
+		/// 最初から再生し直す
+		/// 送ってあるバッファは捨てる
+		/// </summary>
+		/// <param name="loopCount">ループする回数(最初の1回は含まない)</param>
+		void Restart(const uint32_t& loopCount);
+
+		/// <summary>
+		/// 止める
+		/// 送ってあるバッファを捨てて、次のRestartまで展開しない
+		/// </summary>
+		void Stop();
+
+		/// <summary>
+		/// ループを抜ける
+		/// 今の周の終わりまで再生して止まる
+		/// </summary>
+		void ExitLoop();
+
+		/// <summary>
+		/// 空いているバッファに展開して送る
+		/// </summary>
+		/// <returns>送ったバッファの数</returns>
+		uint32_t Pump();
+
+		/// <summary>
+		/// バッファを再生し終わった
+		/// 再生するスレッドから呼ばれる
+		/// </summary>
+		void OnBufferEnd();
+
+	public:
+		/// <summary>
+		/// 最後まで送ったかどうか
+		/// </summary>
+		/// <returns>送ったかどうか</returns>
+		inline bool GetIsEnded() const {
+			return isEnded_.load(std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// 再生待ちのバッファの数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		inline uint32_t GetQueuedCount() const {
+			return queuedCount_.load(std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// バッファに使っているバイト数を取得
+		/// </summary>
+		/// <returns>バイト数</returns>
+		inline size_t GetBufferBytes() const {
+			return buffers_.size();
+		}
+
+		/// <summary>
+		/// 形式を取得
+		/// </summary>
+		/// <returns>形式</returns>
+		inline const AudioFormat& GetFormat() const {
+			return decoder_->GetFormat();
+		}
+
+	private:
+		/// <summary>
+		/// 1つのバッファを埋める
+		/// ループの終わりに着いたら始まりに戻って続ける
+		/// </summary>
+		/// <param name="destination">書き込み先</param>
+		/// <returns>書き込んだフレーム数</returns>
+		uint32_t FillBuffer(uint8_t* destination);
+
+	private:
+		//デコーダー
+		std::unique_ptr<IAudioDecoder> decoder_ = nullptr;
+		//送り先
+		IAudioStreamSink* sink_ = nullptr;
+		//設定
+		Settings settings_ = {};
+		//1つのバッファのバイト数
+		uint32_t bytesPerBuffer_ = 0u;
+		//全部のバッファ
+		std::vector<uint8_t> buffers_;
+
+		//展開とRestartが重ならないようにする
+		std::mutex mutex_;
+		//次に書き込むバッファ
+		uint32_t writeIndex_ = 0u;
+		//再生待ちのバッファの数
+		//再生し終わる順番は送った順番と同じなので、数だけ分かれば空いているバッファが分かる
+		std::atomic<uint32_t> queuedCount_ = 0u;
+		//今展開しているフレーム
+		uint64_t position_ = 0u;
+		//ループの始まり
+		uint64_t loopBeginFrame_ = 0u;
+		//ループの終わり(0なら最後まで)
+		uint64_t loopEndFrame_ = 0u;
+		//残りのループ回数
+		uint32_t remainingLoopCount_ = 0u;
+		//最後まで送ったかどうか(止めている時も)
+		std::atomic<bool> isEnded_ = true;
+
+	};
+
+}
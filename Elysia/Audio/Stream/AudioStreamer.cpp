@@ -0,0 +1,71 @@
+#include "AudioStreamer.h"
+
+#include <cassert>
+#include <algorithm>
+
+#include "AudioStream.h"
+#include "Profiler.h"
+
+void Elysia::AudioStreamer::Initialize(const std::chrono::milliseconds& interval) {
+	assert(thread_.joinable() == false);
+	interval_ = interval;
+	isExit_ = false;
+	isNotified_.store(false, std::memory_order_release);
+	thread_ = std::thread(&AudioStreamer::Run, this);
+}
+
+void Elysia::AudioStreamer::Finalize() {
+	if (thread_.joinable() == false) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isExit_ = true;
+	}
+	condition_.notify_one();
+	thread_.join();
+	streams_.clear();
+}
+
+void Elysia::AudioStreamer::Add(AudioStream* stream) {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		assert(std::find(streams_.begin(), streams_.end(), stream) == streams_.end());
+		streams_.push_back(stream);
+		isNotified_.store(true, std::memory_order_release);
+	}
+	condition_.notify_one();
+}
+
+void Elysia::AudioStreamer::Remove(AudioStream* stream) {
+	//展開している途中ならここで待つ
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::erase(streams_, stream);
+}
+
+void Elysia::AudioStreamer::Notify() {
+	//再生するスレッドを止めたくないのでロックしない
+	//起こし損ねても間隔が来れば見に行く
+	isNotified_.store(true, std::memory_order_release);
+	condition_.notify_one();
+}
+
+void Elysia::AudioStreamer::Run() {
+	ELYSIA_PROFILE_THREAD("オーディオのストリーミング");
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (isExit_ == false) {
+		condition_.wait_for(lock, interval_, [this]() {
+			return isNotified_.load(std::memory_order_acquire) == true || isExit_ == true;
+		});
+		isNotified_.store(false, std::memory_order_release);
+		if (isExit_ == true) {
+			break;
+		}
+
+		//Removeと重ならないようにロックしたまま展開する
+		ELYSIA_PROFILE_SCOPE("AudioStreamer::Pump");
+		for (AudioStream* stream : streams_) {
+			pumpedCount_.fetch_add(stream->Pump(), std::memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @file AudioStreamer.h
+ * @brief 裏のスレッドでストリームを展開し続けるクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	class AudioStream;
+
+	/// <summary>
+	/// 裏のスレッドでストリームを展開し続けるクラス
+	/// バッファが再生し終わったらNotifyで起こしてもらい、空いたバッファに展開する
+	/// 起こされなくても一定の間隔で見に行く
+	/// </summary>
+	class AudioStreamer final {
+	public:
+		/// <summary>
+		/// 初期化
+		/// スレッドを立てる
+		/// </summary>
+		/// <param name="interval">起こされなくても見に行く間隔</param>
+		void Initialize(const std::chrono::milliseconds& interval);
+
+		/// <summary>
+		/// 解放
+		/// スレッドを止める
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// ストリームを追加
+		/// </summary>
+		/// <param name="stream">ストリーム</param>
+		void Add(AudioStream* stream);
+
+		/// <summary>
+		/// ストリームを外す
+		/// 戻ってきた後はスレッドから触らない
+		/// </summary>
+		/// <param name="stream">ストリーム</param>
+		void Remove(AudioStream* stream);
+
+		/// <summary>
+		/// スレッドを起こす
+		/// 再生するスレッドから呼んで良い
+		/// </summary>
+		void Notify();
+
+	public:
+		/// <summary>
+		/// 展開した回数を取得
+		/// </summary>
+		/// <returns>回数</returns>
+		inline uint64_t GetPumpedCount() const {
+			return pumpedCount_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		/// <summary>
+		/// スレッドで回す
+		/// </summary>
+		void Run();
+
+	private:
+		//スレッド
+		std::thread thread_;
+		//ストリームを触る時
+		std::mutex mutex_;
+		//起こす
+		std::condition_variable condition_;
+		//ストリーム
+		std::vector<AudioStream*> streams_;
+		//起こされた
+		std::atomic<bool> isNotified_ = false;
+		//止める
+		bool isExit_ = false;
+		//起こされなくても見に行く間隔
+		std::chrono::milliseconds interval_ = {};
+		//送ったバッファの数
+		std::atomic<uint64_t> pumpedCount_ = 0u;
+
+	};
+
+}
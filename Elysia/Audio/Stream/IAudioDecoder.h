@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ * @file IAudioDecoder.h
+ * @brief 少しずつPCMに展開するデコーダーのインターフェイス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+#include "AudioFormat.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 少しずつPCMに展開するデコーダーのインターフェイス
+	/// WindowsではMediaFoundation、Linuxでの確認では合成した波形になる
+	/// </summary>
+	class IAudioDecoder {
+	public:
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		virtual ~IAudioDecoder() = default;
+
+		/// <summary>
+		/// 形式を取得
+		/// </summary>
+		/// <returns>形式</returns>
+		virtual const AudioFormat& GetFormat() const = 0;
+
+		/// <summary>
+		/// 展開
+		/// </summary>
+		/// <param name="destination">書き込み先(frameCountフレーム分)</param>
+		/// <param name="frameCount">展開したいフレーム数</param>
+		/// <returns>展開したフレーム数(最後まで行ったらframeCountより少なくなる)</returns>
+		virtual uint32_t Decode(uint8_t* destination, const uint32_t& frameCount) = 0;
+
+		/// <summary>
+		/// 指定したフレームに移動
+		/// </summary>
+		/// <param name="frame">フレーム</param>
+		/// <returns>移動できたかどうか</returns>
+		virtual bool Seek(const uint64_t& frame) = 0;
+
+	};
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file IAudioStreamSink.h
+ * @brief ストリーミング再生でPCMを送る先のインターフェイス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// ストリーミング再生でPCMを送る先のインターフェイス
+	/// 送ったバッファは順番に再生し、再生し終わったらAudioStream::OnBufferEndを呼ぶ
+	/// WindowsではXAudio2のソースボイス、Linuxでの確認では何も鳴らさない
+	/// </summary>
+	class IAudioStreamSink {
+	public:
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		virtual ~IAudioStreamSink() = default;
+
+		/// <summary>
+		/// バッファを送る
+		/// 再生し終わるまで中身は書き換えない
+		/// </summary>
+		/// <param name="data">PCM</param>
+		/// <param name="byteCount">バイト数(0なら終わりだけを伝える)</param>
+		/// <param name="isEndOfStream">最後のバッファかどうか</param>
+		virtual void Submit(const uint8_t* data, const uint32_t& byteCount, const bool& isEndOfStream) = 0;
+
+		/// <summary>
+		/// 送ったバッファを捨てる
+		/// 捨てたバッファもOnBufferEndを呼ぶ
+		/// </summary>
+		virtual void Flush() = 0;
+
+	};
+
+}
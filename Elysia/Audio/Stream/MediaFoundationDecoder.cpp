@@ -0,0 +1,139 @@
+#include "MediaFoundationDecoder.h"
+
+#include <cassert>
+#include <algorithm>
+
+#pragma comment(lib, "mfplat.lib")
+#pragma comment(lib, "Mfreadwrite.lib")
+#pragma comment(lib, "mfuuid.lib")
+
+void Elysia::MediaFoundationDecoder::Open(const std::string& fileName) {
+	//stringからLPCWCHARに変換する
+	int sizeNeeded = MultiByteToWideChar(CP_UTF8, 0, fileName.c_str(), int(fileName.size()), NULL, 0);
+	std::wstring wideFileName(sizeNeeded, 0);
+	MultiByteToWideChar(CP_UTF8, 0, fileName.c_str(), int(fileName.size()), &wideFileName[0], sizeNeeded);
+
+	//ソースリーダーの作成
+	HRESULT hResult = MFCreateSourceReaderFromURL(wideFileName.c_str(), nullptr, &sourceReader_);
+	assert(SUCCEEDED(hResult));
+
+	//PCMで読み出すように設定
+	Microsoft::WRL::ComPtr<IMFMediaType> mediaType = nullptr;
+	hResult = MFCreateMediaType(&mediaType);
+	assert(SUCCEEDED(hResult));
+	mediaType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Audio);
+	mediaType->SetGUID(MF_MT_SUBTYPE, MFAudioFormat_PCM);
+	hResult = sourceReader_->SetCurrentMediaType(DWORD(MF_SOURCE_READER_FIRST_AUDIO_STREAM), nullptr, mediaType.Get());
+	assert(SUCCEEDED(hResult));
+
+	//実際に読み出す形式
+	Microsoft::WRL::ComPtr<IMFMediaType> currentMediaType = nullptr;
+	hResult = sourceReader_->GetCurrentMediaType(DWORD(MF_SOURCE_READER_FIRST_AUDIO_STREAM), &currentMediaType);
+	assert(SUCCEEDED(hResult));
+	WAVEFORMATEX* waveFormat = nullptr;
+	hResult = MFCreateWaveFormatExFromMFMediaType(currentMediaType.Get(), &waveFormat, nullptr);
+	assert(SUCCEEDED(hResult));
+	waveFormat_ = *waveFormat;
+	//PCMなので拡張部分は要らない
+	waveFormat_.cbSize = 0u;
+	CoTaskMemFree(waveFormat);
+
+	format_ = {
+		.channelCount = waveFormat_.nChannels,
+		.sampleRate = waveFormat_.nSamplesPerSec,
+		.bitsPerSample = waveFormat_.wBitsPerSample,
+	};
+
+	//長さ
+	PROPVARIANT duration = {};
+	hResult = sourceReader_->GetPresentationAttribute(DWORD(MF_SOURCE_READER_MEDIASOURCE), MF_PD_DURATION, &duration);
+	if (SUCCEEDED(hResult) == true) {
+		frameCount_ = duration.uhVal.QuadPart * format_.sampleRate / TIME_UNIT_PER_SECOND_;
+	}
+	PropVariantClear(&duration);
+
+	pending_.clear();
+	pendingOffset_ = 0u;
+	isSeeked_ = false;
+}
+
+uint32_t Elysia::MediaFoundationDecoder::Decode(uint8_t* destination, const uint32_t& frameCount) {
+	uint32_t blockAlign = format_.GetBlockAlign();
+	size_t requestBytes = size_t(frameCount) * blockAlign;
+	size_t writtenBytes = 0u;
+	while (writtenBytes < requestBytes) {
+		//前に読んだものを使い切ったら次を読む
+		if (pendingOffset_ == pending_.size() && ReadSample() == false) {
+			break;
+		}
+		size_t copyBytes = std::min(requestBytes - writtenBytes, pending_.size() - pendingOffset_);
+		std::copy_n(pending_.data() + pendingOffset_, copyBytes, destination + writtenBytes);
+		pendingOffset_ += copyBytes;
+		writtenBytes += copyBytes;
+	}
+	return uint32_t(writtenBytes / blockAlign);
+}
+
+bool Elysia::MediaFoundationDecoder::Seek(const uint64_t& frame) {
+	PROPVARIANT position = {};
+	position.vt = VT_I8;
+	position.hVal.QuadPart = LONGLONG(frame * TIME_UNIT_PER_SECOND_ / format_.sampleRate);
+	HRESULT hResult = sourceReader_->SetCurrentPosition(GUID_NULL, position);
+	if (FAILED(hResult) == true) {
+		return false;
+	}
+
+	//MP3はフレームの頭にしか移動できないので、次のサンプルで細かく合わせる
+	pending_.clear();
+	pendingOffset_ = 0u;
+	seekFrame_ = frame;
+	isSeeked_ = true;
+	return true;
+}
+
+bool Elysia::MediaFoundationDecoder::ReadSample() {
+	while (true) {
+		Microsoft::WRL::ComPtr<IMFSample> sample = nullptr;
+		DWORD streamFlags = 0u;
+		HRESULT hResult = sourceReader_->ReadSample(DWORD(MF_SOURCE_READER_FIRST_AUDIO_STREAM), 0, nullptr, &streamFlags, nullptr, &sample);
+		if (FAILED(hResult) == true || (streamFlags & MF_SOURCE_READERF_ENDOFSTREAM) != 0u) {
+			return false;
+		}
+		//空のこともある
+		if (sample == nullptr) {
+			continue;
+		}
+
+		Microsoft::WRL::ComPtr<IMFMediaBuffer> mediaBuffer = nullptr;
+		hResult = sample->ConvertToContiguousBuffer(&mediaBuffer);
+		assert(SUCCEEDED(hResult));
+		BYTE* data = nullptr;
+		DWORD currentLength = 0u;
+		hResult = mediaBuffer->Lock(&data, nullptr, &currentLength);
+		assert(SUCCEEDED(hResult));
+
+		//シークした先より前の分は飛ばす
+		size_t skipBytes = 0u;
+		if (isSeeked_ == true) {
+			LONGLONG sampleTime = 0;
+			if (SUCCEEDED(sample->GetSampleTime(&sampleTime)) == true) {
+				uint64_t sampleFrame = uint64_t(std::max<LONGLONG>(sampleTime, 0)) * format_.sampleRate / TIME_UNIT_PER_SECOND_;
+				if (seekFrame_ > sampleFrame) {
+					skipBytes = std::min<size_t>(size_t(seekFrame_ - sampleFrame) * format_.GetBlockAlign(), currentLength);
+				}
+			}
+		}
+
+		//前のサンプルと同じくらいの大きさなので、確保し直しはほとんど起きない
+		pending_.assign(data + skipBytes, data + currentLength);
+		pendingOffset_ = 0u;
+		mediaBuffer->Unlock();
+
+		//サンプル全部を飛ばしたら、次のサンプルでも合わせる
+		if (pending_.empty() == true) {
+			continue;
+		}
+		isSeeked_ = false;
+		return true;
+	}
+}
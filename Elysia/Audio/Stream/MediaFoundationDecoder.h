@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * @file MediaFoundationDecoder.h
+ * @brief MediaFoundationで少しずつ展開するデコーダー
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <vector>
+#include <xaudio2.h>
+#include <mfapi.h>
+#include <mfidl.h>
+#include <mfreadwrite.h>
+#include <wrl.h>
+
+#include "IAudioDecoder.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// MediaFoundationで少しずつ展開するデコーダー
+	/// MP3などをPCMにして読み出す
+	/// </summary>
+	class MediaFoundationDecoder final : public IAudioDecoder {
+	public:
+		/// <summary>
+		/// ファイルを開く
+		/// </summary>
+		/// <param name="fileName">ファイル名</param>
+		void Open(const std::string& fileName);
+
+		/// <summary>
+		/// 形式を取得
+		/// </summary>
+		/// <returns>形式</returns>
+		const AudioFormat& GetFormat() const override {
+			return format_;
+		}
+
+		/// <summary>
+		/// 展開
+		/// </summary>
+		/// <param name="destination">書き込み先</param>
+		/// <param name="frameCount">展開したいフレーム数</param>
+		/// <returns>展開したフレーム数(最後まで行ったら少なくなる)</returns>
+		uint32_t Decode(uint8_t* destination, const uint32_t& frameCount) override;
+
+		/// <summary>
+		/// 指定したフレームに移動
+		/// </summary>
+		/// <param name="frame">フレーム</param>
+		/// <returns>移動出来たかどうか</returns>
+		bool Seek(const uint64_t& frame) override;
+
+	public:
+		/// <summary>
+		/// 波形フォーマットを取得
+		/// </summary>
+		/// <returns>波形フォーマット</returns>
+		inline const WAVEFORMATEX& GetWaveFormat() const {
+			return waveFormat_;
+		}
+
+		/// <summary>
+		/// 全体のフレーム数を取得
+		/// ファイルに書いてある長さなので目安
+		/// </summary>
+		/// <returns>フレーム数</returns>
+		inline uint64_t GetFrameCount() const {
+			return frameCount_;
+		}
+
+	private:
+		/// <summary>
+		/// 次のサンプルを読み込む
+		/// </summary>
+		/// <returns>読み込めたかどうか(最後まで行ったらfalse)</returns>
+		bool ReadSample();
+
+	private:
+		//MediaFoundationの時間の単位(100ナノ秒)
+		static constexpr uint64_t TIME_UNIT_PER_SECOND_ = 10000000u;
+
+	private:
+		//ソースリーダー
+		Microsoft::WRL::ComPtr<IMFSourceReader> sourceReader_ = nullptr;
+		//波形フォーマット
+		WAVEFORMATEX waveFormat_ = {};
+		//形式
+		AudioFormat format_ = {};
+		//全体のフレーム数
+		uint64_t frameCount_ = 0u;
+		//読み込んだけどまだ渡していないもの
+		std::vector<uint8_t> pending_;
+		//pending_のどこまで渡したか
+		size_t pendingOffset_ = 0u;
+		//シークした先(サンプルの途中に行きたい時は、次に読んだサンプルの頭を飛ばす)
+		uint64_t seekFrame_ = 0u;
+		//シークした直後かどうか
+		bool isSeeked_ = false;
+
+	};
+
+}
@@ -0,0 +1,71 @@
+#include "NullAudioStreamSink.h"
+
+#include <algorithm>
+
+#include "AudioStream.h"
+
+void Elysia::NullAudioStreamSink::Initialize(AudioStream* stream, const bool& isCapture) {
+	stream_ = stream;
+	isCapture_ = isCapture;
+	queue_.clear();
+	capturedData_.clear();
+	consumedBytes_ = 0u;
+	isEndOfStreamReached_ = false;
+	starvedCount_ = 0u;
+}
+
+void Elysia::NullAudioStreamSink::Submit(const uint8_t* data, const uint32_t& byteCount, const bool& isEndOfStream) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	//終わりだけを伝えられた
+	if (byteCount == 0u) {
+		if (queue_.empty() == true) {
+			isEndOfStreamReached_ = isEndOfStream;
+		}
+		else {
+			queue_.back().isEndOfStream = isEndOfStream;
+		}
+		return;
+	}
+	queue_.push_back({ .data = data, .byteCount = byteCount, .offset = 0u, .isEndOfStream = isEndOfStream });
+	isEndOfStreamReached_ = false;
+}
+
+void Elysia::NullAudioStreamSink::Flush() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	//XAudio2と同じく捨てたものも再生し終わった事にする
+	for (size_t i = 0u; i < queue_.size(); ++i) {
+		stream_->OnBufferEnd();
+	}
+	queue_.clear();
+}
+
+uint32_t Elysia::NullAudioStreamSink::Consume(const uint32_t& byteCount) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	uint32_t consumedBytes = 0u;
+	while (consumedBytes < byteCount) {
+		if (queue_.empty() == true) {
+			//最後まで行っていないのに無くなった(展開が間に合わなかった)
+			if (isEndOfStreamReached_ == false) {
+				++starvedCount_;
+			}
+			break;
+		}
+
+		QueuedBuffer& buffer = queue_.front();
+		uint32_t count = std::min(byteCount - consumedBytes, buffer.byteCount - buffer.offset);
+		if (isCapture_ == true) {
+			capturedData_.insert(capturedData_.end(), buffer.data + buffer.offset, buffer.data + buffer.offset + count);
+		}
+		buffer.offset += count;
+		consumedBytes += count;
+
+		//1つ再生し終わった
+		if (buffer.offset == buffer.byteCount) {
+			isEndOfStreamReached_ = buffer.isEndOfStream;
+			queue_.pop_front();
+			stream_->OnBufferEnd();
+		}
+	}
+	consumedBytes_ += consumedBytes;
+	return consumedBytes;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * @file NullAudioStreamSink.h
+ * @brief 何も鳴らさない送り先
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+#include "IAudioStreamSink.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	class AudioStream;
+
+	/// <summary>
+	/// 何も鳴らさない送り先
+	/// Consumeで再生した事にして、再生した中身を取っておける
+	/// オーディオデバイスが無くてもストリーミングの動きを確かめられる
+	/// </summary>
+	class NullAudioStreamSink final : public IAudioStreamSink {
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="stream">再生し終わったことを伝える先</param>
+		/// <param name="isCapture">再生した中身を取っておくかどうか</param>
+		void Initialize(AudioStream* stream, const bool& isCapture);
+
+		/// <summary>
+		/// バッファを送る
+		/// </summary>
+		/// <param name="data">PCM</param>
+		/// <param name="byteCount">バイト数</param>
+		/// <param name="isEndOfStream">最後のバッファかどうか</param>
+		void Submit(const uint8_t* data, const uint32_t& byteCount, const bool& isEndOfStream) override;
+
+		/// <summary>
+		/// 送ったバッファを捨てる
+		/// </summary>
+		void Flush() override;
+
+		/// <summary>
+		/// 再生した事にする
+		/// </summary>
+		/// <param name="byteCount">再生するバイト数</param>
+		/// <returns>再生したバイト数(送られたものが足りなければ少なくなる)</returns>
+		uint32_t Consume(const uint32_t& byteCount);
+
+	public:
+		/// <summary>
+		/// 再生した中身を取得
+		/// </summary>
+		/// <returns>中身</returns>
+		inline const std::vector<uint8_t>& GetCapturedData() const {
+			return capturedData_;
+		}
+
+		/// <summary>
+		/// 再生したバイト数を取得
+		/// </summary>
+		/// <returns>バイト数</returns>
+		inline uint64_t GetConsumedBytes() const {
+			return consumedBytes_;
+		}
+
+		/// <summary>
+		/// 最後のバッファまで再生したかどうか
+		/// </summary>
+		/// <returns>再生したかどうか</returns>
+		inline bool GetIsEndOfStreamReached() const {
+			return isEndOfStreamReached_;
+		}
+
+		/// <summary>
+		/// 途中で再生するものが無くなった回数を取得
+		/// </summary>
+		/// <returns>回数</returns>
+		inline uint32_t GetStarvedCount() const {
+			return starvedCount_;
+		}
+
+	private:
+		/// <summary>
+		/// 送られたバッファ
+		/// </summary>
+		struct QueuedBuffer {
+			const uint8_t* data;
+			uint32_t byteCount;
+			//どこまで再生したか
+			uint32_t offset;
+			bool isEndOfStream;
+		};
+
+	private:
+		//再生し終わったことを伝える先
+		AudioStream* stream_ = nullptr;
+		//再生した中身を取っておくかどうか
+		bool isCapture_ = false;
+		//送ったものと再生するものが別のスレッドなので
+		std::mutex mutex_;
+		//送られたバッファ
+		std::deque<QueuedBuffer> queue_;
+		//再生した中身
+		std::vector<uint8_t> capturedData_;
+		//再生したバイト数
+		uint64_t consumedBytes_ = 0u;
+		//最後のバッファまで再生したかどうか
+		bool isEndOfStreamReached_ = false;
+		//最後でもないのに再生するものが無くなった回数
+		uint32_t starvedCount_ = 0u;
+
+	};
+
+}
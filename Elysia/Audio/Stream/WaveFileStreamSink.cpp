@@ -0,0 +1,61 @@
+#include "WaveFileStreamSink.h"
+
+#include <cassert>
+
+#include "AudioStream.h"
+
+Elysia::WaveFileStreamSink::~WaveFileStreamSink() {
+	Finalize();
+}
+
+void Elysia::WaveFileStreamSink::Initialize(const std::string& filePath, const AudioFormat& format, AudioStream* stream) {
+	assert(stream != nullptr);
+	stream_ = stream;
+	writtenBytes_ = 0u;
+	file_.open(filePath, std::ios::binary | std::ios::trunc);
+	assert(file_.is_open() == true);
+
+	//大きさは閉じる時に書く
+	//1はPCM、3はIEEE_FLOAT
+	const uint16_t formatTag = (format.isFloat == true) ? 3u : 1u;
+	file_.write("RIFF", 4);
+	WriteValue<uint32_t>(0u);
+	file_.write("WAVE", 4);
+	file_.write("fmt ", 4);
+	WriteValue<uint32_t>(16u);
+	WriteValue<uint16_t>(formatTag);
+	WriteValue<uint16_t>(uint16_t(format.channelCount));
+	WriteValue<uint32_t>(format.sampleRate);
+	WriteValue<uint32_t>(format.sampleRate * format.GetBlockAlign());
+	WriteValue<uint16_t>(uint16_t(format.GetBlockAlign()));
+	WriteValue<uint16_t>(uint16_t(format.bitsPerSample));
+	file_.write("data", 4);
+	WriteValue<uint32_t>(0u);
+}
+
+void Elysia::WaveFileStreamSink::Submit(const uint8_t* data, const uint32_t& byteCount, const bool& isEndOfStream) {
+	isEndOfStream;
+	//終わりだけを伝えられた
+	if (byteCount == 0u) {
+		return;
+	}
+	file_.write(reinterpret_cast<const char*>(data), byteCount);
+	writtenBytes_ += byteCount;
+	//書き込んだのでもう使わない
+	stream_->OnBufferEnd();
+}
+
+void Elysia::WaveFileStreamSink::Flush() {
+}
+
+void Elysia::WaveFileStreamSink::Finalize() {
+	if (file_.is_open() == false) {
+		return;
+	}
+	//大きさを書き戻す
+	file_.seekp(RIFF_SIZE_OFFSET_);
+	WriteValue<uint32_t>(uint32_t(HEADER_BYTES_ - 8u + writtenBytes_));
+	file_.seekp(DATA_SIZE_OFFSET_);
+	WriteValue<uint32_t>(uint32_t(writtenBytes_));
+	file_.close();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file WaveFileStreamSink.h
+ * @brief WAVファイルに書き出す送り先
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <string>
+#include <fstream>
+
+#include "IAudioStreamSink.h"
+#include "AudioFormat.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	class AudioStream;
+
+	/// <summary>
+	/// WAVファイルに書き出す送り先
+	/// 送られた途端に書き込んで再生し終わった事にするので、Pumpを1回呼べば最後まで書き出せる
+	/// 時間に関係なく同じものが出来るので、ミキサーの結果を聴いて確かめる時に使う
+	/// </summary>
+	class WaveFileStreamSink final : public IAudioStreamSink {
+	public:
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~WaveFileStreamSink() override;
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="filePath">書き出すファイル</param>
+		/// <param name="format">形式</param>
+		/// <param name="stream">再生し終わったことを伝える先</param>
+		void Initialize(const std::string& filePath, const AudioFormat& format, AudioStream* stream);
+
+		/// <summary>
+		/// バッファを送る(書き込む)
+		/// </summary>
+		/// <param name="data">PCM</param>
+		/// <param name="byteCount">バイト数</param>
+		/// <param name="isEndOfStream">最後のバッファかどうか</param>
+		void Submit(const uint8_t* data, const uint32_t& byteCount, const bool& isEndOfStream) override;
+
+		/// <summary>
+		/// 送ったバッファを捨てる
+		/// すぐに書き込んでいるので捨てるものは無い
+		/// </summary>
+		void Flush() override;
+
+		/// <summary>
+		/// 大きさを書き込んで閉じる
+		/// </summary>
+		void Finalize();
+
+	public:
+		/// <summary>
+		/// 書き込んだPCMのバイト数を取得
+		/// </summary>
+		/// <returns>バイト数</returns>
+		inline uint64_t GetWrittenBytes() const {
+			return writtenBytes_;
+		}
+
+	private:
+		/// <summary>
+		/// 値をそのまま書き込む
+		/// </summary>
+		/// <typeparam name="T">型</typeparam>
+		/// <param name="value">値</param>
+		template<typename T>
+		void WriteValue(const T& value);
+
+	private:
+		//RIFFチャンクの大きさを書く場所
+		static constexpr std::streamoff RIFF_SIZE_OFFSET_ = 4;
+		//dataチャンクの大きさを書く場所
+		static constexpr std::streamoff DATA_SIZE_OFFSET_ = 40;
+		//ヘッダーのバイト数
+		static constexpr uint32_t HEADER_BYTES_ = 44u;
+
+		//書き出すファイル
+		std::ofstream file_;
+		//再生し終わったことを伝える先
+		AudioStream* stream_ = nullptr;
+		//書き込んだPCMのバイト数
+		uint64_t writtenBytes_ = 0u;
+
+	};
+
+	template<typename T>
+	inline void WaveFileStreamSink::WriteValue(const T& value) {
+		file_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+}
@@ -0,0 +1,53 @@
+#include "XAudio2StreamSink.h"
+
+#include <cassert>
+
+#include "AudioStream.h"
+#include "AudioStreamer.h"
+
+void Elysia::XAudio2StreamSink::Initialize(IXAudio2* xAudio2, const WAVEFORMATEX& waveFormat, AudioStream* stream, AudioStreamer* streamer) {
+	stream_ = stream;
+	streamer_ = streamer;
+	//自分をコールバックにする
+	HRESULT hResult = xAudio2->CreateSourceVoice(&sourceVoice_, &waveFormat, 0u, XAUDIO2_DEFAULT_FREQ_RATIO, this);
+	assert(SUCCEEDED(hResult));
+}
+
+void Elysia::XAudio2StreamSink::Finalize() {
+	if (sourceVoice_ != nullptr) {
+		//再生するスレッドが終わるまで待ってくれる
+		sourceVoice_->DestroyVoice();
+		sourceVoice_ = nullptr;
+	}
+}
+
+void Elysia::XAudio2StreamSink::Submit(const uint8_t* data, const uint32_t& byteCount, const bool& isEndOfStream) {
+	//終わりだけを伝えられたら、最後に送ったバッファを最後にする
+	if (byteCount == 0u) {
+		HRESULT hResult = sourceVoice_->Discontinuity();
+		assert(SUCCEEDED(hResult));
+		hResult;
+		return;
+	}
+
+	XAUDIO2_BUFFER buffer = {};
+	buffer.pAudioData = data;
+	buffer.AudioBytes = byteCount;
+	buffer.Flags = (isEndOfStream == true) ? XAUDIO2_END_OF_STREAM : 0u;
+	HRESULT hResult = sourceVoice_->SubmitSourceBuffer(&buffer);
+	assert(SUCCEEDED(hResult));
+	hResult;
+}
+
+void Elysia::XAudio2StreamSink::Flush() {
+	//止めてから呼んでね(再生中のバッファは捨てられない)
+	//捨てたバッファもOnBufferEndが呼ばれる
+	HRESULT hResult = sourceVoice_->FlushSourceBuffers();
+	assert(SUCCEEDED(hResult));
+	hResult;
+}
+
+void STDMETHODCALLTYPE Elysia::XAudio2StreamSink::OnBufferEnd(void*) {
+	stream_->OnBufferEnd();
+	streamer_->Notify();
+}
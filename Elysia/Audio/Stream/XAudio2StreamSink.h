@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * @file XAudio2StreamSink.h
+ * @brief XAudio2のソースボイスに送る送り先
+ * @author 茂木翼
+ */
+
+#include <xaudio2.h>
+
+#include "IAudioStreamSink.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	class AudioStream;
+	class AudioStreamer;
+
+	/// <summary>
+	/// XAudio2のソースボイスに送る送り先
+	/// ソースボイスはこのクラスが持つ
+	/// バッファを再生し終わったらストリームに伝えて、展開するスレッドを起こす
+	/// </summary>
+	class XAudio2StreamSink final : public IAudioStreamSink, public IXAudio2VoiceCallback {
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="xAudio2">XAudio2</param>
+		/// <param name="waveFormat">波形フォーマット</param>
+		/// <param name="stream">再生し終わったことを伝える先</param>
+		/// <param name="streamer">展開するスレッド</param>
+		void Initialize(IXAudio2* xAudio2, const WAVEFORMATEX& waveFormat, AudioStream* stream, AudioStreamer* streamer);
+
+		/// <summary>
+		/// 解放
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// バッファを送る
+		/// </summary>
+		/// <param name="data">PCM</param>
+		/// <param name="byteCount">バイト数</param>
+		/// <param name="isEndOfStream">最後のバッファかどうか</param>
+		void Submit(const uint8_t* data, const uint32_t& byteCount, const bool& isEndOfStream) override;
+
+		/// <summary>
+		/// 送ったバッファを捨てる
+		/// </summary>
+		void Flush() override;
+
+		/// <summary>
+		/// ソースボイスを取得
+		/// </summary>
+		/// <returns>ソースボイス</returns>
+		inline IXAudio2SourceVoice* GetSourceVoice() const {
+			return sourceVoice_;
+		}
+
+	public:
+		//ここから下はXAudio2の再生するスレッドから呼ばれる
+		void STDMETHODCALLTYPE OnVoiceProcessingPassStart(UINT32) override {}
+		void STDMETHODCALLTYPE OnVoiceProcessingPassEnd() override {}
+		void STDMETHODCALLTYPE OnStreamEnd() override {}
+		void STDMETHODCALLTYPE OnBufferStart(void*) override {}
+		void STDMETHODCALLTYPE OnLoopEnd(void*) override {}
+		void STDMETHODCALLTYPE OnVoiceError(void*, HRESULT) override {}
+
+		/// <summary>
+		/// バッファを再生し終わった
+		/// </summary>
+		void STDMETHODCALLTYPE OnBufferEnd(void*) override;
+
+	private:
+		//ソースボイス
+		IXAudio2SourceVoice* sourceVoice_ = nullptr;
+		//再生し終わったことを伝える先
+		AudioStream* stream_ = nullptr;
+		//展開するスレッド
+		AudioStreamer* streamer_ = nullptr;
+
+	};
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file IVoiceBackend.h
+ * @brief ボイスプールが使う実際のボイスのインターフェイス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+#include "AudioFormat.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// ボイスで鳴らすもの
+	/// </summary>
+	struct VoiceBuffer {
+		//PCM(鳴り終わるまで持っておいてね)
+		const uint8_t* data;
+		//バイト数
+		uint32_t byteCount;
+		//ループする回数(最初の1回は含まない)
+		uint32_t loopCount;
+
+		//ずっとループ(XAUDIO2_LOOP_INFINITEと同じ)
+		static constexpr uint32_t LOOP_INFINITE_ = 255u;
+	};
+
+	/// <summary>
+	/// ボイスプールが使う実際のボイスのインターフェイス
+	/// WindowsではXAudio2のソースボイス、確認用には何も鳴らさないもの
+	/// </summary>
+	class IVoiceBackend {
+	public:
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		virtual ~IVoiceBackend() = default;
+
+		/// <summary>
+		/// ボイスを作る
+		/// 読み込みの時だけ呼ばれる(再生中には作らない)
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <returns>ボイスの番号</returns>
+		virtual uint32_t CreateVoice(const AudioFormat& format) = 0;
+
+		/// <summary>
+		/// 鳴らす
+		/// 鳴っている途中なら止めてから鳴らし直す
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <param name="buffer">鳴らすもの</param>
+		/// <param name="volume">音量</param>
+		virtual void Start(const uint32_t& voiceId, const VoiceBuffer& buffer, const float& volume) = 0;
+
+		/// <summary>
+		/// 止める
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		virtual void Stop(const uint32_t& voiceId) = 0;
+
+		/// <summary>
+		/// 音量を変える
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <param name="volume">音量</param>
+		virtual void SetVolume(const uint32_t& voiceId, const float& volume) = 0;
+
+		/// <summary>
+		/// 左右のスピーカーに送る大きさを変える
+		/// 3Dの音で、距離の減衰と左右の振り分けをまとめて渡す
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <param name="left">左</param>
+		/// <param name="right">右</param>
+		virtual void SetStereoGains(const uint32_t& voiceId, const float& left, const float& right) = 0;
+
+		/// <summary>
+		/// 鳴っているかどうか
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <returns>鳴っているかどうか</returns>
+		virtual bool IsPlaying(const uint32_t& voiceId) const = 0;
+
+	};
+
+}
@@ -0,0 +1,156 @@
+#include "VoicePool.h"
+
+#include <cassert>
+
+void Elysia::VoicePool::Initialize(IVoiceBackend* backend) {
+	assert(backend != nullptr);
+	backend_ = backend;
+	voices_.clear();
+	groups_.clear();
+	sequence_ = 0u;
+	statistics_ = {};
+}
+
+void Elysia::VoicePool::Reserve(const AudioFormat& format, const uint32_t& voiceCount) {
+	FormatGroup* group = FindGroup(format);
+	if (group == nullptr) {
+		groups_.push_back({ .format = format, .voiceIndices = {} });
+		group = &groups_.back();
+	}
+
+	//足りない分だけ作る
+	while (group->voiceIndices.size() < voiceCount) {
+		Voice voice = {
+			.voiceId = backend_->CreateVoice(format),
+			.generation = 0u,
+			.sequence = 0u,
+			.priority = 0,
+			.isActive = false,
+		};
+		group->voiceIndices.push_back(uint32_t(voices_.size()));
+		voices_.push_back(voice);
+	}
+	statistics_.voiceCount = uint32_t(voices_.size());
+}
+
+Elysia::VoiceHandle Elysia::VoicePool::Play(const AudioFormat& format, const VoiceBuffer& buffer, const int32_t& priority, const float& volume) {
+	return PlayVoice(format, buffer, priority, volume, true);
+}
+
+Elysia::VoiceHandle Elysia::VoicePool::TryPlay(const AudioFormat& format, const VoiceBuffer& buffer, const int32_t& priority, const float& volume) {
+	return PlayVoice(format, buffer, priority, volume, false);
+}
+
+Elysia::VoiceHandle Elysia::VoicePool::PlayVoice(const AudioFormat& format, const VoiceBuffer& buffer, const int32_t& priority, const float& volume, const bool& isStealingSamePriority) {
+	FormatGroup* group = FindGroup(format);
+	//再生中にボイスを作らないように、読み込む時にReserveしておいてね
+	assert(group != nullptr && group->voiceIndices.empty() == false);
+
+	//空いているものを探す
+	//無ければ優先度が低くて古いものを横取りする候補にする
+	uint32_t freeIndex = UINT32_MAX;
+	uint32_t victimIndex = UINT32_MAX;
+	for (const uint32_t& index : group->voiceIndices) {
+		Voice& voice = voices_[index];
+		if (voice.isActive == true && backend_->IsPlaying(voice.voiceId) == false) {
+			//鳴り終わっていた
+			voice.isActive = false;
+		}
+		if (voice.isActive == false) {
+			freeIndex = index;
+			break;
+		}
+		if (victimIndex == UINT32_MAX) {
+			victimIndex = index;
+			continue;
+		}
+		const Voice& victim = voices_[victimIndex];
+		if (voice.priority < victim.priority || (voice.priority == victim.priority && voice.sequence < victim.sequence)) {
+			victimIndex = index;
+		}
+	}
+
+	uint32_t index = freeIndex;
+	if (index == UINT32_MAX) {
+		//鳴っているものの方が大事なら鳴らさない
+		int32_t victimPriority = voices_[victimIndex].priority;
+		if (victimPriority > priority || (victimPriority == priority && isStealingSamePriority == false)) {
+			++statistics_.rejectedCount;
+			return {};
+		}
+		backend_->Stop(voices_[victimIndex].voiceId);
+		++statistics_.stolenCount;
+		index = victimIndex;
+	}
+
+	Voice& voice = voices_[index];
+	//0は無効にしているので飛ばす
+	++voice.generation;
+	if (voice.generation == 0u) {
+		voice.generation = 1u;
+	}
+	voice.sequence = ++sequence_;
+	voice.priority = priority;
+	voice.isActive = true;
+	backend_->Start(voice.voiceId, buffer, volume);
+	++statistics_.playCount;
+	return { .index = index, .generation = voice.generation };
+}
+
+void Elysia::VoicePool::Stop(const VoiceHandle& handle) {
+	const Voice* found = FindVoice(handle);
+	if (found == nullptr) {
+		return;
+	}
+	Voice& voice = voices_[handle.index];
+	backend_->Stop(voice.voiceId);
+	voice.isActive = false;
+}
+
+void Elysia::VoicePool::SetVolume(const VoiceHandle& handle, const float& volume) {
+	const Voice* voice = FindVoice(handle);
+	if (voice != nullptr) {
+		backend_->SetVolume(voice->voiceId, volume);
+	}
+}
+
+void Elysia::VoicePool::SetStereoGains(const VoiceHandle& handle, const float& left, const float& right) {
+	const Voice* voice = FindVoice(handle);
+	if (voice != nullptr) {
+		backend_->SetStereoGains(voice->voiceId, left, right);
+	}
+}
+
+bool Elysia::VoicePool::IsPlaying(const VoiceHandle& handle) const {
+	const Voice* voice = FindVoice(handle);
+	return voice != nullptr && backend_->IsPlaying(voice->voiceId) == true;
+}
+
+void Elysia::VoicePool::StopAll() {
+	for (Voice& voice : voices_) {
+		if (voice.isActive == true) {
+			backend_->Stop(voice.voiceId);
+			voice.isActive = false;
+		}
+	}
+}
+
+const Elysia::VoicePool::Voice* Elysia::VoicePool::FindVoice(const VoiceHandle& handle) const {
+	if (handle.IsValid() == false || handle.index >= voices_.size()) {
+		return nullptr;
+	}
+	const Voice& voice = voices_[handle.index];
+	if (voice.generation != handle.generation || voice.isActive == false) {
+		return nullptr;
+	}
+	return &voice;
+}
+
+Elysia::VoicePool::FormatGroup* Elysia::VoicePool::FindGroup(const AudioFormat& format) {
+	for (FormatGroup& group : groups_) {
+		if (group.format == format) {
+			return &group;
+		}
+	}
+	return nullptr;
+}
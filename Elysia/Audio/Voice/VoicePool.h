@@ -0,0 +1,205 @@
+#pragma once
+
+/**
+ * @file VoicePool.h
+ * @brief 効果音を重ねて鳴らすためのボイスプール
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "AudioFormat.h"
+#include "IVoiceBackend.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 鳴らしている1つの音
+	/// 同じボイスが別の音に使われたら世代が変わるので、古いハンドルでは触れない
+	/// </summary>
+	struct VoiceHandle {
+		//ボイスの番号
+		uint32_t index = 0u;
+		//世代(0は無効)
+		uint32_t generation = 0u;
+
+		/// <summary>
+		/// 有効かどうか
+		/// </summary>
+		/// <returns>有効かどうか</returns>
+		inline bool IsValid() const {
+			return generation != 0u;
+		}
+	};
+
+	/// <summary>
+	/// 効果音を重ねて鳴らすためのボイスプール
+	/// 形式ごとにボイスを先に作っておき、鳴らす時は空いているものを使う
+	/// 空いていなければ優先度が低くて古いものを止めて使う(横取り)
+	/// 実際のボイスには触らないので、偽のバックエンドで確かめられる
+	/// </summary>
+	class VoicePool final {
+	public:
+		/// <summary>
+		/// 統計
+		/// </summary>
+		struct Statistics {
+			//鳴らした回数
+			uint32_t playCount;
+			//横取りした回数
+			uint32_t stolenCount;
+			//優先度が足りなくて鳴らせなかった回数
+			uint32_t rejectedCount;
+			//作ったボイスの数
+			uint32_t voiceCount;
+		};
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="backend">実際のボイス</param>
+		void Initialize(IVoiceBackend* backend);
+
+		/// <summary>
+		/// 形式ごとのボイスを作っておく
+		/// 既にある形式なら足りない分だけ作る
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <param name="voiceCount">ボイスの数</param>
+		void Reserve(const AudioFormat& format, const uint32_t& voiceCount);
+
+		/// <summary>
+		/// 鳴らす
+		/// </summary>
+		/// <param name="format">形式(Reserveしておいてね)</param>
+		/// <param name="buffer">鳴らすもの</param>
+		/// <param name="priority">優先度(大きい方が優先)</param>
+		/// <param name="volume">音量</param>
+		/// <returns>ハンドル(鳴らせなければ無効)</returns>
+		VoiceHandle Play(const AudioFormat& format, const VoiceBuffer& buffer, const int32_t& priority, const float& volume);
+
+		/// <summary>
+		/// 空いていれば鳴らす
+		/// 同じ優先度のものは横取りしない(毎フレーム鳴らし直すものが取り合わないように)
+		/// </summary>
+		/// <param name="format">形式(Reserveしておいてね)</param>
+		/// <param name="buffer">鳴らすもの</param>
+		/// <param name="priority">優先度(大きい方が優先)</param>
+		/// <param name="volume">音量</param>
+		/// <returns>ハンドル(鳴らせなければ無効)</returns>
+		VoiceHandle TryPlay(const AudioFormat& format, const VoiceBuffer& buffer, const int32_t& priority, const float& volume);
+
+		/// <summary>
+		/// 止める
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		void Stop(const VoiceHandle& handle);
+
+		/// <summary>
+		/// 音量を変える
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <param name="volume">音量</param>
+		void SetVolume(const VoiceHandle& handle, const float& volume);
+
+		/// <summary>
+		/// 左右のスピーカーに送る大きさを変える
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <param name="left">左</param>
+		/// <param name="right">右</param>
+		void SetStereoGains(const VoiceHandle& handle, const float& left, const float& right);
+
+		/// <summary>
+		/// 鳴っているかどうか
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns>鳴っているかどうか(止めた、鳴り終わった、横取りされたらfalse)</returns>
+		bool IsPlaying(const VoiceHandle& handle) const;
+
+		/// <summary>
+		/// 全部止める
+		/// </summary>
+		void StopAll();
+
+	public:
+		/// <summary>
+		/// 統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		inline const Statistics& GetStatistics() const {
+			return statistics_;
+		}
+
+	private:
+		/// <summary>
+		/// ボイス
+		/// </summary>
+		struct Voice {
+			//バックエンドでの番号
+			uint32_t voiceId;
+			//世代
+			uint32_t generation;
+			//鳴らした順番(小さい方が古い)
+			uint64_t sequence;
+			//優先度
+			int32_t priority;
+			//鳴らしているかどうか(鳴り終わったかはバックエンドに聞く)
+			bool isActive;
+		};
+
+		/// <summary>
+		/// 同じ形式のボイスのまとまり
+		/// </summary>
+		struct FormatGroup {
+			//形式
+			AudioFormat format;
+			//ボイスの番号
+			std::vector<uint32_t> voiceIndices;
+		};
+
+		/// <summary>
+		/// ハンドルが指しているボイスを取得
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns>ボイス(古いハンドルならnullptr)</returns>
+		const Voice* FindVoice(const VoiceHandle& handle) const;
+
+		/// <summary>
+		/// 形式のまとまりを探す
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <returns>まとまり(無ければnullptr)</returns>
+		FormatGroup* FindGroup(const AudioFormat& format);
+
+		/// <summary>
+		/// 空いているボイスか横取りしたボイスで鳴らす
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <param name="buffer">鳴らすもの</param>
+		/// <param name="priority">優先度</param>
+		/// <param name="volume">音量</param>
+		/// <param name="isStealingSamePriority">同じ優先度のものも横取りするか</param>
+		/// <returns>ハンドル(鳴らせなければ無効)</returns>
+		VoiceHandle PlayVoice(const AudioFormat& format, const VoiceBuffer& buffer, const int32_t& priority, const float& volume, const bool& isStealingSamePriority);
+
+	private:
+		//実際のボイス
+		IVoiceBackend* backend_ = nullptr;
+		//全部のボイス
+		std::vector<Voice> voices_;
+		//形式ごとのまとまり
+		std::vector<FormatGroup> groups_;
+		//鳴らした順番
+		uint64_t sequence_ = 0u;
+		//統計
+		Statistics statistics_ = {};
+
+	};
+
+}
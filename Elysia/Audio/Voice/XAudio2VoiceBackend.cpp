@@ -0,0 +1,111 @@
+#include "XAudio2VoiceBackend.h"
+
+#include <cassert>
+
+void Elysia::XAudio2VoiceBackend::Initialize(IXAudio2* xAudio2, const uint32_t& outputChannelCount) {
+	xAudio2_ = xAudio2;
+	outputChannelCount_ = outputChannelCount;
+	sourceVoices_.clear();
+	channelCounts_.clear();
+	isPanned_.clear();
+}
+
+void Elysia::XAudio2VoiceBackend::Finalize() {
+	for (IXAudio2SourceVoice* sourceVoice : sourceVoices_) {
+		sourceVoice->DestroyVoice();
+	}
+	sourceVoices_.clear();
+	channelCounts_.clear();
+	isPanned_.clear();
+}
+
+uint32_t Elysia::XAudio2VoiceBackend::CreateVoice(const AudioFormat& format) {
+	//波形フォーマット
+	WAVEFORMATEX waveFormat = {};
+	waveFormat.wFormatTag = (format.isFloat == true) ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+	waveFormat.nChannels = WORD(format.channelCount);
+	waveFormat.nSamplesPerSec = format.sampleRate;
+	waveFormat.wBitsPerSample = WORD(format.bitsPerSample);
+	waveFormat.nBlockAlign = WORD(format.GetBlockAlign());
+	waveFormat.nAvgBytesPerSec = format.sampleRate * format.GetBlockAlign();
+
+	IXAudio2SourceVoice* sourceVoice = nullptr;
+	HRESULT hResult = xAudio2_->CreateSourceVoice(&sourceVoice, &waveFormat);
+	assert(SUCCEEDED(hResult));
+	sourceVoices_.push_back(sourceVoice);
+	channelCounts_.push_back(format.channelCount);
+	isPanned_.push_back(false);
+	return uint32_t(sourceVoices_.size() - 1u);
+}
+
+void Elysia::XAudio2VoiceBackend::Start(const uint32_t& voiceId, const VoiceBuffer& buffer, const float& volume) {
+	IXAudio2SourceVoice* sourceVoice = sourceVoices_[voiceId];
+	//横取りした時は前の音が残っているので捨てる
+	HRESULT hResult = sourceVoice->Stop();
+	assert(SUCCEEDED(hResult));
+	hResult = sourceVoice->FlushSourceBuffers();
+	assert(SUCCEEDED(hResult));
+	//3Dの音で左右を変えていたら真ん中に戻す
+	if (isPanned_[voiceId] == true) {
+		SetStereoGains(voiceId, 1.0f, 1.0f);
+		isPanned_[voiceId] = false;
+	}
+
+	XAUDIO2_BUFFER xAudio2Buffer = {};
+	xAudio2Buffer.pAudioData = buffer.data;
+	xAudio2Buffer.AudioBytes = buffer.byteCount;
+	xAudio2Buffer.Flags = XAUDIO2_END_OF_STREAM;
+	xAudio2Buffer.LoopCount = buffer.loopCount;
+	hResult = sourceVoice->SubmitSourceBuffer(&xAudio2Buffer);
+	assert(SUCCEEDED(hResult));
+	hResult = sourceVoice->SetVolume(volume);
+	assert(SUCCEEDED(hResult));
+	hResult = sourceVoice->Start(0);
+	assert(SUCCEEDED(hResult));
+}
+
+void Elysia::XAudio2VoiceBackend::Stop(const uint32_t& voiceId) {
+	IXAudio2SourceVoice* sourceVoice = sourceVoices_[voiceId];
+	HRESULT hResult = sourceVoice->Stop();
+	assert(SUCCEEDED(hResult));
+	hResult = sourceVoice->FlushSourceBuffers();
+	assert(SUCCEEDED(hResult));
+}
+
+void Elysia::XAudio2VoiceBackend::SetVolume(const uint32_t& voiceId, const float& volume) {
+	HRESULT hResult = sourceVoices_[voiceId]->SetVolume(volume);
+	assert(SUCCEEDED(hResult));
+	hResult;
+}
+
+void Elysia::XAudio2VoiceBackend::SetStereoGains(const uint32_t& voiceId, const float& left, const float& right) {
+	//出力の前の左右(0,1番)にだけ送る
+	//モノラルは両方に、ステレオはそれぞれの側に
+	uint32_t channelCount = channelCounts_[voiceId];
+	outputMatrix_.assign(size_t(channelCount) * outputChannelCount_, 0.0f);
+	for (uint32_t source = 0u; source < channelCount && source < 2u; ++source) {
+		if (channelCount == 1u || source == 0u) {
+			outputMatrix_[0u * channelCount + source] = left;
+		}
+		if (outputChannelCount_ >= 2u && (channelCount == 1u || source == 1u)) {
+			outputMatrix_[1u * channelCount + source] = right;
+		}
+	}
+	//モノラルのスピーカーなら足す
+	if (outputChannelCount_ == 1u) {
+		for (uint32_t source = 0u; source < channelCount && source < 2u; ++source) {
+			outputMatrix_[source] = (left + right) * 0.5f;
+		}
+	}
+	HRESULT hResult = sourceVoices_[voiceId]->SetOutputMatrix(nullptr, channelCount, outputChannelCount_, outputMatrix_.data());
+	assert(SUCCEEDED(hResult));
+	hResult;
+	isPanned_[voiceId] = true;
+}
+
+bool Elysia::XAudio2VoiceBackend::IsPlaying(const uint32_t& voiceId) const {
+	//再生待ちのバッファが無ければ鳴り終わっている
+	XAUDIO2_VOICE_STATE state = {};
+	sourceVoices_[voiceId]->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+	return state.BuffersQueued > 0u;
+}
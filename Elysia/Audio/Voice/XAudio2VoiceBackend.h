@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * @file XAudio2VoiceBackend.h
+ * @brief XAudio2のソースボイスを使うボイスプールのバックエンド
+ * @author 茂木翼
+ */
+
+#include <vector>
+#include <xaudio2.h>
+
+#include "IVoiceBackend.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// XAudio2のソースボイスを使うボイスプールのバックエンド
+	/// </summary>
+	class XAudio2VoiceBackend final : public IVoiceBackend {
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="xAudio2">XAudio2</param>
+		/// <param name="outputChannelCount">マスターボイスのチャンネル数</param>
+		void Initialize(IXAudio2* xAudio2, const uint32_t& outputChannelCount);
+
+		/// <summary>
+		/// 解放
+		/// 作ったソースボイスを全部消す
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// ボイスを作る
+		/// </summary>
+		/// <param name="format">形式</param>
+		/// <returns>ボイスの番号</returns>
+		uint32_t CreateVoice(const AudioFormat& format) override;
+
+		/// <summary>
+		/// 鳴らす
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <param name="buffer">鳴らすもの</param>
+		/// <param name="volume">音量</param>
+		void Start(const uint32_t& voiceId, const VoiceBuffer& buffer, const float& volume) override;
+
+		/// <summary>
+		/// 止める
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		void Stop(const uint32_t& voiceId) override;
+
+		/// <summary>
+		/// 音量を変える
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <param name="volume">音量</param>
+		void SetVolume(const uint32_t& voiceId, const float& volume) override;
+
+		/// <summary>
+		/// 左右のスピーカーに送る大きさを変える
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <param name="left">左</param>
+		/// <param name="right">右</param>
+		void SetStereoGains(const uint32_t& voiceId, const float& left, const float& right) override;
+
+		/// <summary>
+		/// 鳴っているかどうか
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <returns>鳴っているかどうか</returns>
+		bool IsPlaying(const uint32_t& voiceId) const override;
+
+		/// <summary>
+		/// ソースボイスを取得
+		/// </summary>
+		/// <param name="voiceId">ボイスの番号</param>
+		/// <returns>ソースボイス</returns>
+		inline IXAudio2SourceVoice* GetSourceVoice(const uint32_t& voiceId) const {
+			return sourceVoices_[voiceId];
+		}
+
+	private:
+		//XAudio2
+		IXAudio2* xAudio2_ = nullptr;
+		//マスターボイスのチャンネル数
+		uint32_t outputChannelCount_ = 0u;
+		//ボイスごとのチャンネル数
+		std::vector<uint32_t> channelCounts_;
+		//ボイスごとに左右を変えたかどうか
+		std::vector<bool> isPanned_;
+		//出力の行列(毎回確保しないように持っておく)
+		std::vector<float> outputMatrix_;
+		//作ったソースボイス
+		std::vector<IXAudio2SourceVoice*> sourceVoices_;
+
+	};
+
+}
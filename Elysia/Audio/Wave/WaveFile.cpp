@@ -0,0 +1,241 @@
+#include "WaveFile.h"
+
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+	//チャンクヘッダーのバイト数
+	const size_t CHUNK_HEADER_BYTES = 8u;
+	//RIFFヘッダーのバイト数
+	const size_t RIFF_HEADER_BYTES = 12u;
+	//fmtチャンクの最低限のバイト数
+	const uint32_t FORMAT_BYTES = 16u;
+	//WAVEFORMATEXTENSIBLEのバイト数
+	const uint32_t EXTENSIBLE_FORMAT_BYTES = 40u;
+	//smplチャンクのループより前のバイト数
+	const uint32_t SAMPLER_HEADER_BYTES = 36u;
+	//smplチャンクのループ1つのバイト数
+	const uint32_t SAMPLER_LOOP_BYTES = 24u;
+	//cueチャンクの目印1つのバイト数
+	const uint32_t CUE_POINT_BYTES = 24u;
+
+	//形式
+	const uint16_t FORMAT_PCM = 1u;
+	const uint16_t FORMAT_IEEE_FLOAT = 3u;
+	const uint16_t FORMAT_EXTENSIBLE = 0xFFFEu;
+
+	/// <summary>
+	/// 値を読む
+	/// 揃っていない場所もあるのでコピーする
+	/// </summary>
+	/// <typeparam name="T">型</typeparam>
+	/// <param name="data">読む場所</param>
+	/// <returns>値</returns>
+	template<typename T>
+	T ReadValue(const uint8_t* data) {
+		T value = {};
+		std::memcpy(&value, data, sizeof(T));
+		return value;
+	}
+
+	/// <summary>
+	/// チャンクの識別子が同じか
+	/// </summary>
+	/// <param name="data">識別子</param>
+	/// <param name="id">比べるもの</param>
+	/// <returns>同じかどうか</returns>
+	bool IsChunk(const uint8_t* data, const char* id) {
+		return std::memcmp(data, id, 4u) == 0;
+	}
+
+	/// <summary>
+	/// fmtチャンクを読む
+	/// </summary>
+	/// <param name="data">チャンクの中身</param>
+	/// <param name="size">バイト数</param>
+	/// <param name="format">形式</param>
+	/// <returns>鳴らせる形式かどうか</returns>
+	bool ParseFormat(const uint8_t* data, const uint32_t& size, Elysia::AudioFormat& format) {
+		if (size < FORMAT_BYTES) {
+			return false;
+		}
+		uint16_t formatTag = ReadValue<uint16_t>(data);
+		uint16_t channelCount = ReadValue<uint16_t>(data + 2u);
+		uint32_t sampleRate = ReadValue<uint32_t>(data + 4u);
+		uint16_t blockAlign = ReadValue<uint16_t>(data + 12u);
+		uint16_t bitsPerSample = ReadValue<uint16_t>(data + 14u);
+
+		//WAVEFORMATEXTENSIBLEは本当の形式がSubFormatのGUIDの先頭にある
+		if (formatTag == FORMAT_EXTENSIBLE) {
+			if (size < EXTENSIBLE_FORMAT_BYTES) {
+				return false;
+			}
+			formatTag = ReadValue<uint16_t>(data + 24u);
+		}
+
+		//XAudio2で鳴らせるもの
+		bool isFloat = formatTag == FORMAT_IEEE_FLOAT;
+		if (formatTag != FORMAT_PCM && isFloat == false) {
+			return false;
+		}
+		if (isFloat == true && bitsPerSample != 32u) {
+			return false;
+		}
+		if (bitsPerSample != 8u && bitsPerSample != 16u && bitsPerSample != 24u && bitsPerSample != 32u) {
+			return false;
+		}
+		if (channelCount == 0u || sampleRate == 0u || blockAlign != channelCount * (bitsPerSample / 8u)) {
+			return false;
+		}
+
+		format = {
+			.channelCount = channelCount,
+			.sampleRate = sampleRate,
+			.bitsPerSample = bitsPerSample,
+			.isFloat = isFloat,
+		};
+		return true;
+	}
+
+	/// <summary>
+	/// smplチャンクのループを読む
+	/// </summary>
+	/// <param name="data">チャンクの中身</param>
+	/// <param name="size">バイト数</param>
+	/// <param name="loops">ループ</param>
+	void ParseSampler(const uint8_t* data, const uint32_t& size, std::vector<Elysia::WaveLoop>& loops) {
+		if (size < SAMPLER_HEADER_BYTES) {
+			return;
+		}
+		//数が大きすぎても入っている分だけ
+		uint32_t loopCount = std::min(ReadValue<uint32_t>(data + 28u), (size - SAMPLER_HEADER_BYTES) / SAMPLER_LOOP_BYTES);
+		for (uint32_t i = 0u; i < loopCount; ++i) {
+			const uint8_t* loop = data + SAMPLER_HEADER_BYTES + size_t(i) * SAMPLER_LOOP_BYTES;
+			//終わりのフレームも含む
+			uint32_t begin = ReadValue<uint32_t>(loop + 8u);
+			uint32_t end = ReadValue<uint32_t>(loop + 12u);
+			if (end < begin) {
+				continue;
+			}
+			loops.push_back({ .begin = begin, .length = end - begin + 1u, .playCount = ReadValue<uint32_t>(loop + 20u) });
+		}
+	}
+
+	/// <summary>
+	/// cueチャンクの目印を読む
+	/// </summary>
+	/// <param name="data">チャンクの中身</param>
+	/// <param name="size">バイト数</param>
+	/// <param name="cues">目印</param>
+	void ParseCue(const uint8_t* data, const uint32_t& size, std::vector<Elysia::WaveCue>& cues) {
+		if (size < 4u) {
+			return;
+		}
+		uint32_t cueCount = std::min(ReadValue<uint32_t>(data), (size - 4u) / CUE_POINT_BYTES);
+		for (uint32_t i = 0u; i < cueCount; ++i) {
+			const uint8_t* cue = data + 4u + size_t(i) * CUE_POINT_BYTES;
+			//dataチャンクの中の位置はSampleOffset
+			cues.push_back({ .id = ReadValue<uint32_t>(cue), .position = ReadValue<uint32_t>(cue + 20u) });
+		}
+	}
+
+}
+
+bool Elysia::WaveFile::Open(const std::string& filePath) {
+	Close();
+	if (mappedFile_.Open(filePath) == false) {
+		return false;
+	}
+	if (Parse(mappedFile_.GetData(), mappedFile_.GetSize(), information_) == false) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void Elysia::WaveFile::Close() {
+	mappedFile_.Close();
+	information_ = {};
+}
+
+bool Elysia::WaveFile::Parse(const uint8_t* data, const size_t& size, WaveInformation& information) {
+	information = {};
+	if (data == nullptr || size < RIFF_HEADER_BYTES || IsChunk(data, "RIFF") == false || IsChunk(data + 8u, "WAVE") == false) {
+		return false;
+	}
+
+	//WAVEの4バイトも入らない大きさは壊れている
+	size_t riffEnd = size_t(ReadValue<uint32_t>(data + 4u)) + CHUNK_HEADER_BYTES;
+	if (riffEnd < RIFF_HEADER_BYTES) {
+		return false;
+	}
+
+	//RIFFの大きさが間違っているファイルもあるので、ファイルの大きさを超えないようにする
+	size_t end = std::min(size, riffEnd);
+	bool isFormatFound = false;
+	bool isDataFound = false;
+	size_t offset = RIFF_HEADER_BYTES;
+	//引き算だと桁が回り込むので足し算で比べる
+	while (offset + CHUNK_HEADER_BYTES <= end) {
+		const uint8_t* chunk = data + offset;
+		size_t chunkSize = ReadValue<uint32_t>(chunk + 4u);
+		const uint8_t* body = chunk + CHUNK_HEADER_BYTES;
+		size_t remainingBytes = end - offset - CHUNK_HEADER_BYTES;
+
+		if (chunkSize > remainingBytes) {
+			//書き出しの途中で止まったファイルはdataが切れていることがあるので、ある分だけ使う
+			if (IsChunk(chunk, "data") == false) {
+				break;
+			}
+			chunkSize = remainingBytes;
+		}
+
+		if (IsChunk(chunk, "fmt ") == true && isFormatFound == false) {
+			if (ParseFormat(body, uint32_t(chunkSize), information.format) == false) {
+				return false;
+			}
+			isFormatFound = true;
+		}
+		else if (IsChunk(chunk, "data") == true && isDataFound == false) {
+			information.data = body;
+			information.byteCount = uint32_t(chunkSize);
+			isDataFound = true;
+		}
+		else if (IsChunk(chunk, "smpl") == true) {
+			ParseSampler(body, uint32_t(chunkSize), information.loops);
+		}
+		else if (IsChunk(chunk, "cue ") == true) {
+			ParseCue(body, uint32_t(chunkSize), information.cues);
+		}
+
+		//チャンクは2バイトごとに揃えてある
+		offset += CHUNK_HEADER_BYTES + chunkSize + (chunkSize & 1u);
+		if (offset >= end) {
+			break;
+		}
+	}
+
+	if (isFormatFound == false || isDataFound == false) {
+		information = {};
+		return false;
+	}
+
+	//途中で切れたフレームは使わない
+	uint32_t blockAlign = information.format.GetBlockAlign();
+	information.byteCount -= information.byteCount % blockAlign;
+	if (information.byteCount == 0u) {
+		information = {};
+		return false;
+	}
+
+	//範囲の外を指すループと目印は捨てる
+	uint32_t frameCount = information.byteCount / blockAlign;
+	std::erase_if(information.loops, [&frameCount](const WaveLoop& loop) {
+		return loop.length == 0u || loop.begin >= frameCount || loop.length > frameCount - loop.begin;
+	});
+	std::erase_if(information.cues, [&frameCount](const WaveCue& cue) {
+		return cue.position >= frameCount;
+	});
+	return true;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file WaveFile.h
+ * @brief メモリマップドファイルで開くWAVファイル
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AudioFormat.h"
+#include "MappedFile.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// smplチャンクのループ
+	/// </summary>
+	struct WaveLoop {
+		//始まり(フレーム)
+		uint32_t begin;
+		//長さ(フレーム)
+		uint32_t length;
+		//ループする回数(0ならずっと)
+		uint32_t playCount;
+	};
+
+	/// <summary>
+	/// cueチャンクの目印
+	/// </summary>
+	struct WaveCue {
+		//番号
+		uint32_t id;
+		//位置(フレーム)
+		uint32_t position;
+	};
+
+	/// <summary>
+	/// WAVファイルの中身
+	/// </summary>
+	struct WaveInformation {
+		//形式
+		AudioFormat format;
+		//PCM(ファイルの中を直接指す)
+		const uint8_t* data;
+		//PCMのバイト数
+		uint32_t byteCount;
+		//ループ
+		std::vector<WaveLoop> loops;
+		//目印
+		std::vector<WaveCue> cues;
+	};
+
+	/// <summary>
+	/// メモリマップドファイルで開くWAVファイル
+	/// 全部のチャンクを見て、知らないチャンク(LIST、bext、JUNKなど)は飛ばす
+	/// PCMはコピーせずにマップしたところを指すので、開いている間は同じものを何個のボイスで鳴らしても良い
+	/// </summary>
+	class WaveFile final {
+	public:
+		/// <summary>
+		/// 開く
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <returns>開けたかどうか(WAVとして読めなければfalse)</returns>
+		bool Open(const std::string& filePath);
+
+		/// <summary>
+		/// 閉じる
+		/// </summary>
+		void Close();
+
+		/// <summary>
+		/// 解析
+		/// 壊れたファイルでも範囲の外は読まない
+		/// </summary>
+		/// <param name="data">ファイルの中身</param>
+		/// <param name="size">バイト数</param>
+		/// <param name="information">中身</param>
+		/// <returns>WAVとして読めたかどうか</returns>
+		static bool Parse(const uint8_t* data, const size_t& size, WaveInformation& information);
+
+	public:
+		/// <summary>
+		/// 中身を取得
+		/// </summary>
+		/// <returns>中身</returns>
+		inline const WaveInformation& GetInformation() const {
+			return information_;
+		}
+
+		/// <summary>
+		/// フレーム数を取得
+		/// </summary>
+		/// <returns>フレーム数</returns>
+		inline uint32_t GetFrameCount() const {
+			return information_.byteCount / information_.format.GetBlockAlign();
+		}
+
+	private:
+		//ファイル
+		MappedFile mappedFile_;
+		//中身
+		WaveInformation information_ = {};
+
+	};
+
+}
@@ -1,13 +1,14 @@
 #include "Camera.h"
 #include "Matrix4x4Calculation.h"
 #include "WindowsSetup.h"
+#include "GameClock.h"
 
 
 
 //初期化
 void Camera::Initialize() {
 	//Resource作成
-	resource = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(CameraMatrixData)).Get();
+	resource.Initialize(sizeof(CameraMatrixData));
 
 	//アスペクト比
 	aspectRatio = float(Elysia::WindowsSetup::GetInstance()->GetClientWidth()) / float(Elysia::WindowsSetup::GetInstance()->GetClientHeight());
@@ -21,13 +22,14 @@ void Camera::Initialize() {
 	//ワールド行列を計算
 	worldMatrix = Matrix4x4Calculation::MakeAffineMatrix(scale, rotate, translate);
 	//逆行列を計算
-	viewMatrix = Matrix4x4Calculation::Inverse(worldMatrix);
+	viewMatrix = Matrix4x4Calculation::InverseAffine(worldMatrix);
 	//射影を計算
 	projectionMatrix = Matrix4x4Calculation::MakePerspectiveFovMatrix(fov_, aspectRatio, nearClip, farClip);
 	//正射影行列(正規化)を計算
 	orthographicMatrix = Matrix4x4Calculation::MakeOrthographicMatrix(0, 0, float(Elysia::WindowsSetup::GetInstance()->GetClientWidth()), float(Elysia::WindowsSetup::GetInstance()->GetClientHeight()), 0.0f, 100.0f);
 
-
+	//最初の転送では補間しない
+	isTransferred_ = false;
 }
 
 
@@ -37,7 +39,7 @@ void Camera::Update() {
 	worldMatrix = Matrix4x4Calculation::MakeAffineMatrix(scale, rotate, translate);
 
 	//逆行列を計算
-	viewMatrix = Matrix4x4Calculation::Inverse(worldMatrix);
+	viewMatrix = Matrix4x4Calculation::InverseAffine(worldMatrix);
 	//射影を計算
 	projectionMatrix = Matrix4x4Calculation::MakePerspectiveFovMatrix(fov_, aspectRatio, nearClip, farClip);
 	//正射影行列(正規化)を計算
@@ -48,10 +50,55 @@ void Camera::Update() {
 }
 
 void Camera::Transfer() {
+	//描画で補間する為に前の位置と向きと一緒に持っておく
+	//初回は前が無いので補間しない
+	Matrix4x4 cameraMatrix = Matrix4x4Calculation::InverseAffine(viewMatrix);
+	if (isTransferred_ == false) {
+		interpolatedCameraMatrix_.Reset(cameraMatrix);
+		isTransferred_ = true;
+	}
+	else {
+		interpolatedCameraMatrix_.Step(cameraMatrix, Elysia::GameClock::GetInstance()->GetFixedStepTotalCount());
+	}
+
 	//それぞれにデータの書き込み
-	resource->Map(0, nullptr, reinterpret_cast<void**>(&cameraMatrixData));
-	cameraMatrixData->viewMatrix_ = viewMatrix;
-	cameraMatrixData->projectionMatrix_ = projectionMatrix;
-	cameraMatrixData->orthographicMatrix_ = orthographicMatrix;
-	resource->Unmap(0, nullptr);
+	WriteConstants(viewMatrix);
+	isInterpolatedWritten_ = false;
+	interpolatedFrameCount_ = UINT64_MAX;
+}
+
+void Camera::WriteConstants(const Matrix4x4& view) const {
+	CameraMatrixData cameraMatrixData = {
+		.viewMatrix_ = view,
+		.projectionMatrix_ = projectionMatrix,
+		.orthographicMatrix_ = orthographicMatrix,
+	};
+	resource.Write(cameraMatrixData);
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS Camera::GetGPUVirtualAddress() const {
+	Elysia::GameClock* gameClock = Elysia::GameClock::GetInstance();
+	uint64_t stepTotalCount = gameClock->GetFixedStepTotalCount();
+
+	//動いていなければ転送した値をそのまま使う
+	//前のフレームで補間した値が残っていたら今の値に戻す
+	if (interpolatedCameraMatrix_.IsInterpolating(stepTotalCount) == false) {
+		if (isInterpolatedWritten_ == true) {
+			WriteConstants(viewMatrix);
+			isInterpolatedWritten_ = false;
+			interpolatedFrameCount_ = UINT64_MAX;
+		}
+		return resource.GetGPUVirtualAddress();
+	}
+
+	//前に転送した時と今の間から見る
+	//同じフレームで何回描画しても補間は1回だけ
+	uint64_t frameCount = gameClock->GetFrameCount();
+	if (interpolatedFrameCount_ != frameCount) {
+		Matrix4x4 cameraMatrix = interpolatedCameraMatrix_.Get(gameClock->GetInterpolationAlpha(), stepTotalCount);
+		WriteConstants(Matrix4x4Calculation::InverseAffine(cameraMatrix));
+		isInterpolatedWritten_ = true;
+		interpolatedFrameCount_ = frameCount;
+	}
+	return resource.GetGPUVirtualAddress();
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include "Matrix4x4.h"
 #include "Vector3.h"
 #include "DirectXSetup.h"
+#include "RingConstantBuffer.h"
+#include "InterpolatedMatrix.h"
 
 /// <summary>
 /// GPUに送る行列データ
@@ -46,9 +48,17 @@ public:
 
 	/// <summary>
 	/// 転送
+	/// 固定の間隔で進める時に1回だけ呼ぶ
 	/// </summary>
 	void Transfer();
 
+	/// <summary>
+	/// 描画に使うGPUのアドレスを取得
+	/// 前に転送した時と今のカメラの位置と向きをGameClockの補間の割合で混ぜてから書き込む
+	/// </summary>
+	/// <returns>アドレス</returns>
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const;
+
 
 public:
 
@@ -69,7 +79,8 @@ public:
 	
 public:
 	//リソース
-	ComPtr<ID3D12Resource> resource;
+	//描画の時に補間した値を書き込むのでconstでも書き換えられるようにする
+	mutable Elysia::RingConstantBuffer resource = {};
 
 	//角度
 	float_t fov_ = 0.45f;
@@ -95,11 +106,25 @@ public:
 	Matrix4x4 projectionMatrix = {};
 	//正射影行列
 	Matrix4x4 orthographicMatrix={};
-	//転送用のデータ
-	CameraMatrixData* cameraMatrixData = nullptr;
+
+private:
+	/// <summary>
+	/// 定数バッファに書き込む
+	/// </summary>
+	/// <param name="view">ビュー行列</param>
+	void WriteConstants(const Matrix4x4& view) const;
 
 private:
 	//スケール
 	Vector3 scale = {.x= 1.0f,.y= 1.0f,.z= 1.0f };
+	//前に転送した時と今のカメラのワールド行列
+	//ビュー行列を直接設定して転送する場合もあるのでビュー行列の逆から作る
+	Elysia::InterpolatedMatrix interpolatedCameraMatrix_ = {};
+	//転送したかどうか
+	bool isTransferred_ = false;
+	//補間した値を書き込んだフレーム
+	mutable uint64_t interpolatedFrameCount_ = UINT64_MAX;
+	//定数バッファに補間した値が入っているかどうか
+	mutable bool isInterpolatedWritten_ = false;
 
 };
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "D3D12CommandRecordBackend.h"
+
+#include <cassert>
+
+#include "DirectXSetup.h"
+
+void Elysia::D3D12CommandRecordBackend::Initialize(const uint32_t& frameCount) {
+	chunkContexts_.resize(frameCount);
+}
+
+void Elysia::D3D12CommandRecordBackend::PrepareChunks(const uint32_t& firstChunkIndex, const uint32_t& chunkCount) {
+	DirectXSetup* directXSetup = DirectXSetup::GetInstance();
+	frameIndex_ = directXSetup->GetFrameIndex();
+	std::vector<ChunkContext>& chunkContexts = chunkContexts_[frameIndex_];
+
+	//足りない分だけ作る
+	//一度作ったものは次のフレームから使い回す
+	while (chunkContexts.size() < firstChunkIndex + chunkCount) {
+		ChunkContext chunkContext = {};
+		HRESULT hr = directXSetup->GetDevice()->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&chunkContext.commandAllocator));
+		assert(SUCCEEDED(hr));
+		hr = directXSetup->GetDevice()->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, chunkContext.commandAllocator.Get(), nullptr, IID_PPV_ARGS(&chunkContext.commandList));
+		assert(SUCCEEDED(hr));
+		//記録を始める時にResetするので閉じておく
+		hr = chunkContext.commandList->Close();
+		assert(SUCCEEDED(hr));
+		chunkContexts.push_back(std::move(chunkContext));
+	}
+
+	//番号を振った時点の描画先で記録する
+	CommandRecordRenderState renderState = directXSetup->GetRenderState();
+	for (uint32_t i = 0u; i < chunkCount; ++i) {
+		chunkContexts[firstChunkIndex + i].renderState = renderState;
+	}
+}
+
+void Elysia::D3D12CommandRecordBackend::BeginChunk(const uint32_t& chunkIndex) {
+	ChunkContext& chunkContext = chunkContexts_[frameIndex_][chunkIndex];
+
+	//このコンテキストを前に使ったフレームはGPUが終えているのでResetして良い
+	HRESULT hr = chunkContext.commandAllocator->Reset();
+	assert(SUCCEEDED(hr));
+	hr = chunkContext.commandList->Reset(chunkContext.commandAllocator.Get(), nullptr);
+	assert(SUCCEEDED(hr));
+
+	ApplyRenderState(chunkContext.commandList.Get(), chunkContext.renderState);
+
+	//このスレッドのGetCommandListはこのチャンクのコマンドリストを返す
+	DirectXSetup::SetRecordingCommandList(chunkContext.commandList.Get());
+}
+
+void Elysia::D3D12CommandRecordBackend::EndChunk(const uint32_t& chunkIndex) {
+	HRESULT hr = chunkContexts_[frameIndex_][chunkIndex].commandList->Close();
+	assert(SUCCEEDED(hr));
+
+	DirectXSetup::SetRecordingCommandList(nullptr);
+}
+
+void Elysia::D3D12CommandRecordBackend::Submit(const uint32_t& firstChunkIndex, const uint32_t& chunkCount) {
+	submitCommandLists_.clear();
+	for (uint32_t i = 0u; i < chunkCount; ++i) {
+		submitCommandLists_.push_back(chunkContexts_[frameIndex_][firstChunkIndex + i].commandList.Get());
+	}
+
+	//メインのコマンドリストに今まで積んだもの(バリアやクリア)の後に実行される
+	DirectXSetup::GetInstance()->ExecuteAfterMainCommandList(submitCommandLists_);
+}
+
+void Elysia::D3D12CommandRecordBackend::Finalize() {
+	chunkContexts_.clear();
+	submitCommandLists_.clear();
+}
+
+void Elysia::D3D12CommandRecordBackend::ApplyRenderState(ID3D12GraphicsCommandList* commandList, const CommandRecordRenderState& renderState) {
+	ID3D12DescriptorHeap* descriptorHeaps[] = { renderState.srvDescriptorHeap };
+	commandList->SetDescriptorHeaps(1, descriptorHeaps);
+	commandList->OMSetRenderTargets(1, &renderState.rtvHandle, false, &renderState.dsvHandle);
+	commandList->RSSetViewports(1, &renderState.viewport);
+	commandList->RSSetScissorRects(1, &renderState.scissorRect);
+}
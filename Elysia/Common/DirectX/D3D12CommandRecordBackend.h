@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file D3D12CommandRecordBackend.h
+ * @brief チャンクごとのコマンドリストに記録するクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+#include <d3d12.h>
+#include <wrl.h>
+using Microsoft::WRL::ComPtr;
+
+#include "ICommandRecordBackend.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 描画先などの状態
+	/// コマンドリストをまたいで引き継がれないので、チャンクごとに設定し直す
+	/// </summary>
+	struct CommandRecordRenderState {
+		//RTV
+		D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle;
+		//DSV
+		D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle;
+		//ビューポート
+		D3D12_VIEWPORT viewport;
+		//シザー
+		D3D12_RECT scissorRect;
+		//SRVのディスクリプタヒープ
+		ID3D12DescriptorHeap* srvDescriptorHeap;
+	};
+
+	/// <summary>
+	/// チャンクごとのコマンドリストに記録するクラス
+	/// コマンドリストとアロケータはフレームのコンテキストごとに用意して使い回す
+	/// </summary>
+	class D3D12CommandRecordBackend final : public ICommandRecordBackend {
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="frameCount">同時に処理するフレームの数</param>
+		void Initialize(const uint32_t& frameCount);
+
+		/// <summary>
+		/// チャンクの準備
+		/// </summary>
+		/// <param name="firstChunkIndex">最初の番号</param>
+		/// <param name="chunkCount">数</param>
+		void PrepareChunks(const uint32_t& firstChunkIndex, const uint32_t& chunkCount)override;
+
+		/// <summary>
+		/// チャンクの記録開始
+		/// </summary>
+		/// <param name="chunkIndex">番号</param>
+		void BeginChunk(const uint32_t& chunkIndex)override;
+
+		/// <summary>
+		/// チャンクの記録終了
+		/// </summary>
+		/// <param name="chunkIndex">番号</param>
+		void EndChunk(const uint32_t& chunkIndex)override;
+
+		/// <summary>
+		/// メインのコマンドリストに続けて番号順に送る
+		/// </summary>
+		/// <param name="firstChunkIndex">最初の番号</param>
+		/// <param name="chunkCount">数</param>
+		void Submit(const uint32_t& firstChunkIndex, const uint32_t& chunkCount)override;
+
+		/// <summary>
+		/// 解放
+		/// </summary>
+		void Finalize();
+
+	public:
+		/// <summary>
+		/// 状態をコマンドリストに設定
+		/// </summary>
+		/// <param name="commandList">コマンドリスト</param>
+		/// <param name="renderState">状態</param>
+		static void ApplyRenderState(ID3D12GraphicsCommandList* commandList, const CommandRecordRenderState& renderState);
+
+	private:
+		/// <summary>
+		/// チャンク1つ分
+		/// </summary>
+		struct ChunkContext {
+			//アロケータ
+			ComPtr<ID3D12CommandAllocator> commandAllocator;
+			//コマンドリスト
+			ComPtr<ID3D12GraphicsCommandList> commandList;
+			//記録を始める時の状態
+			CommandRecordRenderState renderState;
+		};
+
+		//コンテキストごとのチャンク
+		std::vector<std::vector<ChunkContext>> chunkContexts_;
+		//今のコンテキスト
+		uint32_t frameIndex_ = 0u;
+		//送る時に使う
+		std::vector<ID3D12CommandList*> submitCommandLists_;
+
+	};
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file DeferredReleaseQueue.h
+ * @brief GPUが使い終わるまで解放を遅らせるキュー
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <cassert>
+#include <deque>
+#include <utility>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// GPUが使い終わるまで解放を遅らせるキュー
+	/// 入れた時のフェンスの値をGPUが越えたら中身を破棄する
+	/// </summary>
+	/// <typeparam name="T">解放するもの(ComPtrなど)</typeparam>
+	template<typename T>
+	class DeferredReleaseQueue final {
+	public:
+		/// <summary>
+		/// 追加
+		/// </summary>
+		/// <param name="object">解放するもの</param>
+		/// <param name="fenceValue">このフェンスの値をGPUが越えたら解放して良い</param>
+		void Push(T&& object, const uint64_t& fenceValue);
+
+		/// <summary>
+		/// GPUが使い終わったものを解放
+		/// </summary>
+		/// <param name="completedFenceValue">GPUが終わったフェンスの値</param>
+		/// <returns>解放した数</returns>
+		size_t Collect(const uint64_t& completedFenceValue);
+
+		/// <summary>
+		/// 全て解放
+		/// GPUが止まっている時だけ呼ぶ
+		/// </summary>
+		inline void Clear() {
+			entries_.clear();
+		}
+
+	public:
+		/// <summary>
+		/// 解放待ちの数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		inline size_t GetCount()const {
+			return entries_.size();
+		}
+
+	private:
+		/// <summary>
+		/// 解放待ち
+		/// </summary>
+		struct Entry {
+			//解放して良くなるフェンスの値
+			uint64_t fenceValue;
+			//解放するもの
+			T object;
+		};
+
+		//フェンスの値が小さい順に並ぶ
+		std::deque<Entry> entries_;
+
+	};
+
+}
+
+template<typename T>
+inline void Elysia::DeferredReleaseQueue<T>::Push(T&& object, const uint64_t& fenceValue) {
+	//後から入れたものほどフェンスの値が大きいので先頭から見るだけで良い
+	assert(entries_.empty() == true || entries_.back().fenceValue <= fenceValue);
+	entries_.push_back({ .fenceValue = fenceValue, .object = std::move(object) });
+}
+
+template<typename T>
+inline size_t Elysia::DeferredReleaseQueue<T>::Collect(const uint64_t& completedFenceValue) {
+	size_t count = 0u;
+	while (entries_.empty() == false && entries_.front().fenceValue <= completedFenceValue) {
+		entries_.pop_front();
+		++count;
+	}
+	return count;
+}
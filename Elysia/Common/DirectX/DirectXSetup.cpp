@@ -1,5 +1,6 @@
 #include "DirectXSetup.h"
 #include <thread>
+#include <algorithm>
 #include <d3dx12.h>
 
 #include "WindowsSetup.h"
@@ -8,8 +9,11 @@
 #include "SrvManager.h"
 #include "RtvManager.h"
 #include "Vector4.h"
+#include "GameClock.h"
 
 
+//このスレッドで記録するコマンドリスト
+thread_local ID3D12GraphicsCommandList* Elysia::DirectXSetup::recordingCommandList_ = nullptr;
 
 Elysia::DirectXSetup::DirectXSetup() {
 	//ウィンドウクラスのインスタンスを取得
@@ -74,6 +78,7 @@ ComPtr<ID3D12Resource> Elysia::DirectXSetup::CreateBufferResource(const size_t&
 		nullptr, IID_PPV_ARGS(&resource));
 	assert(SUCCEEDED(hr));
 
+
 	return resource;
 }
 
@@ -283,17 +288,19 @@ void Elysia::DirectXSetup::GenerateCommand() {
 	assert(SUCCEEDED(hr));
 
 	//コマンドアロケータを生成する
-	ComPtr<ID3D12CommandAllocator> commandAllocator = nullptr;
-	hr = DirectXSetup::GetInstance()->device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator));
-	//コマンドアロケータの生成が上手くいかなかったので起動できない
-	assert(SUCCEEDED(hr));
+	//GPUが使っている間はResetできないのでフレームごとに用意する
+	for (uint32_t i = 0u; i < FRAME_COUNT_; ++i) {
+		hr = DirectXSetup::GetInstance()->device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&DirectXSetup::GetInstance()->commandAllocators_[i]));
+		//コマンドアロケータの生成が上手くいかなかったので起動できない
+		assert(SUCCEEDED(hr));
+	}
 
 	//コマンドリストを生成する
 	ComPtr<ID3D12GraphicsCommandList> commandList = nullptr;
 	hr = DirectXSetup::GetInstance()->device_->CreateCommandList(
 		0, 
 		D3D12_COMMAND_LIST_TYPE_DIRECT, 
-		commandAllocator.Get(),
+		DirectXSetup::GetInstance()->commandAllocators_[0].Get(),
 		nullptr, 
 		IID_PPV_ARGS(&commandList));
 
@@ -302,7 +309,6 @@ void Elysia::DirectXSetup::GenerateCommand() {
 
 	//ローカルに入れた値をメンバ変数に保存しよう
 	DirectXSetup::GetInstance()->commandQueue_ = commandQueue;
-	DirectXSetup::GetInstance()->commandAllocator_ = commandAllocator;
 	DirectXSetup::GetInstance()->commandList_ = commandList;
 }
 
@@ -342,7 +348,8 @@ void Elysia::DirectXSetup::GenerateSwapChain() {
 		//モニタにうつしたら中身を破棄
 		.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD,					
 
-	
+		//Presentで止まらずに、次のフレームを始められるまでオブジェクトで待つ
+		.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT,
 	};
 	
 
@@ -358,6 +365,12 @@ void Elysia::DirectXSetup::GenerateSwapChain() {
 	
 	DirectXSetup::GetInstance()->swapChain_.swapChainDesc = swapChainDesc;
 
+	//先に進めるフレームの数
+	hr = DirectXSetup::GetInstance()->swapChain_.swapChain->SetMaximumFrameLatency(FRAME_COUNT_);
+	assert(SUCCEEDED(hr));
+	DirectXSetup::GetInstance()->frameLatencyWaitableObject_ = DirectXSetup::GetInstance()->swapChain_.swapChain->GetFrameLatencyWaitableObject();
+	assert(DirectXSetup::GetInstance()->frameLatencyWaitableObject_ != nullptr);
+
 }
 
 void Elysia::DirectXSetup::GenarateDescriptorHeap() {
@@ -427,6 +440,9 @@ void Elysia::DirectXSetup::GenarateFence() {
 	DirectXSetup::GetInstance()->fenceEvent_ = fenceEvent;
 	DirectXSetup::GetInstance()->fence_ = fence;
 
+	//フレームごとのコンテキスト
+	DirectXSetup::GetInstance()->frameSynchronizer_.Initialize(FRAME_COUNT_);
+
 
 }
 
@@ -446,6 +462,7 @@ void Elysia::DirectXSetup::GenarateViewport(const uint32_t& width,const uint32_t
 
 	//ビューポートの設定
 	DirectXSetup::GetInstance()->GetCommandList()->RSSetViewports(1, &viewport);
+	DirectXSetup::GetInstance()->viewport_ = viewport;
 
 }
 
@@ -463,6 +480,7 @@ void Elysia::DirectXSetup::GenarateScissor(const uint32_t& right,const uint32_t&
 	
 	//シザーを生成
 	DirectXSetup::GetInstance()->GetCommandList()->RSSetScissorRects(1, &scissorRect);
+	DirectXSetup::GetInstance()->scissorRect_ = scissorRect;
 	
 
 }
@@ -526,7 +544,13 @@ void Elysia::DirectXSetup::InitializeFPS() {
 	//std::chrono::steady_clock...逆行しないタイマー
 	DirectXSetup::GetInstance()->frameEndTime_ = std::chrono::steady_clock::now();
 
-	
+	//1マイクロ秒ずつ眠るとCPUを使い続けてしまうので高精度タイマーで待つ
+	DirectXSetup::GetInstance()->frameTimer_ = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	//高精度タイマーが無い環境では普通のタイマーにする
+	if (DirectXSetup::GetInstance()->frameTimer_ == nullptr) {
+		DirectXSetup::GetInstance()->frameTimer_ = CreateWaitableTimerExW(nullptr, nullptr, 0u, TIMER_ALL_ACCESS);
+	}
+	assert(DirectXSetup::GetInstance()->frameTimer_ != nullptr);
 }
 
 #pragma endregion
@@ -596,17 +620,31 @@ void Elysia::DirectXSetup::SecondInitialize() {
 	//フェンスを生成
 	GenarateFence();
 
+	//並列記録
+	//メインスレッドも記録するので1つ少なくする
+	uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+	uint32_t workerCount = (hardwareThreadCount > 1u) ? std::min(hardwareThreadCount - 1u, MAX_RECORD_WORKER_COUNT_) : 0u;
+	DirectXSetup::GetInstance()->commandRecordBackend_.Initialize(FRAME_COUNT_);
+	DirectXSetup::GetInstance()->parallelCommandRecorder_.Initialize(&DirectXSetup::GetInstance()->commandRecordBackend_, workerCount, RECORD_ITEMS_PER_CHUNK_);
+
 }
 
 
 
 void Elysia::DirectXSetup::UpdateFPS() {
-	//1/60秒ピッタリの時間
+	//目標のフレームレートはゲームの時間の方で決める
+	//0なら待たずに画面の更新(VSync)に合わせる
+	float targetFrameRate = GameClock::GetInstance()->GetTargetFrameRate();
+	if (targetFrameRate <= 0.0f) {
+		DirectXSetup::GetInstance()->frameEndTime_ = std::chrono::steady_clock::now();
+		return;
+	}
+
 	//1フレームの時間
-	const std::chrono::microseconds MIN_TIME(uint64_t(1000000.0f / 60.0f));
+	const std::chrono::microseconds MIN_TIME(uint64_t(1000000.0f / targetFrameRate));
 	
-	//1/60秒よりわずかに短い時間
-	const std::chrono::microseconds MIN_CHECK_TIME(uint64_t(1000000.0f / 65.0f));
+	//1フレームよりわずかに短い時間(60FPSの時に1/65秒)
+	const std::chrono::microseconds MIN_CHECK_TIME(uint64_t(1000000.0f / (targetFrameRate * (65.0f / 60.0f))));
 
 
 
@@ -618,13 +656,20 @@ void Elysia::DirectXSetup::UpdateFPS() {
 	//現在時間から前回の時間を引くことで前回からの経過時間を取得する
 	std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - DirectXSetup::GetInstance()->frameEndTime_);
 
-	//前回から1/60秒経つまで待機する
-	//1/60秒(よりわずかに短い時間)経っていない場合
+	//前回から1フレーム経つまで待機する
+	//1フレーム(よりわずかに短い時間)経っていない場合
 	if (elapsed < MIN_CHECK_TIME) {
-		//1/60秒経過するまで微小なスリープを繰り返す
+		//残りの時間だけタイマーで眠る
+		//単位は100ナノ秒で、負の値は今からの相対時間
+		LARGE_INTEGER dueTime = {};
+		dueTime.QuadPart = -static_cast<LONGLONG>((MIN_TIME - elapsed).count() * 10);
+		if (SetWaitableTimer(DirectXSetup::GetInstance()->frameTimer_, &dueTime, 0, nullptr, nullptr, FALSE) != FALSE) {
+			WaitForSingleObject(DirectXSetup::GetInstance()->frameTimer_, INFINITE);
+		}
+
+		//タイマーの誤差の分だけ残っていたら譲りながら待つ
 		while (std::chrono::steady_clock::now() - DirectXSetup::GetInstance()->frameEndTime_ < MIN_TIME) {
-			//1マイクロ秒スリープ
-			std::this_thread::sleep_for(std::chrono::microseconds(1));
+			std::this_thread::yield();
 		}
 	}
 
@@ -735,7 +780,7 @@ void Elysia::DirectXSetup::StartDraw() {
 
 	//描画先のRTVとDSVを設定する
 	//描画先のRTVを設定する
-	DirectXSetup::GetInstance()->GetCommandList()->OMSetRenderTargets(1, &RtvManager::GetInstance()->GetRtvHandle(backBufferIndex_), false, &DirectXSetup::GetInstance()->dsvHandle_);
+	SetRenderTarget(RtvManager::GetInstance()->GetRtvHandle(backBufferIndex_));
 	//指定した色で画面全体をクリアする
 	float clearColor[] = { 0.0f,0.0f,0.0f,1.0f };
 	DirectXSetup::GetInstance()->GetCommandList()->ClearRenderTargetView(RtvManager::GetInstance()->GetRtvHandle(backBufferIndex_), clearColor, 0, nullptr);
@@ -790,29 +835,144 @@ void Elysia::DirectXSetup::EndDraw() {
 	DirectXSetup::GetInstance()->commandQueue_->Signal(DirectXSetup::GetInstance()->fence_.Get(), fenceValue_);
 	
 
+	//今のフレームのコンテキストを記録して次のコンテキストに進む
+	//ここでGPUを待たないので、GPUがこのフレームを描画している間にCPUは次のフレームを進められる
+	frameSynchronizer_.EndFrame(fenceValue_);
+
+	//次に使うコンテキストを前に使ったフレームをGPUが終えるまで待つ
+	WaitForFenceValue(frameSynchronizer_.GetWaitFenceValue());
+
+	//GPUが使い終わったリソースの解放
+	deferredReleaseQueue_.Collect(fence_->GetCompletedValue());
+
+	//リセット
+	//GPUが使い終わったコンテキストのアロケータなのでResetして良い
+	ID3D12CommandAllocator* commandAllocator = commandAllocators_[frameSynchronizer_.GetFrameIndex()].Get();
+	hr = commandAllocator->Reset();
+	assert(SUCCEEDED(hr));
+	hr = DirectXSetup::GetInstance()->commandList_->Reset(commandAllocator, nullptr);
+	assert(SUCCEEDED(hr));
+
+	//チャンクの番号はフレームごとに0から振る
+	parallelCommandRecorder_.BeginFrame();
+}
+
+void Elysia::DirectXSetup::WaitForFenceValue(const uint64_t& fenceValue) {
 	//Fenceの値が指定したSignal値にたどりついているか確認する
 	//GetCompletedValueの初期値はFence作成時に渡した初期値
-	if (DirectXSetup::GetInstance()->fence_->GetCompletedValue() < fenceValue_) {
+	if (fence_->GetCompletedValue() < fenceValue) {
 		//指定したSignalにたどりついていないので、たどり着くまで待つようにイベントを設定する
-		DirectXSetup::GetInstance()->fence_->SetEventOnCompletion(fenceValue_, fenceEvent_);
+		fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
 		//イベントを待つ
 		WaitForSingleObject(fenceEvent_, INFINITE);
 	}
-	
+}
+
+void Elysia::DirectXSetup::WaitForNextFrame() {
+	//スワップチェインが次のフレームを受け取れるまで待つ
+	//入力を読む前に待つことで表示までの遅れが少なくなる
+	WaitForSingleObjectEx(frameLatencyWaitableObject_, 1000, TRUE);
+
 	//FPSの更新
 	UpdateFPS();
+}
 
-	//リセット
-	hr = DirectXSetup::GetInstance()->commandAllocator_->Reset();
+void Elysia::DirectXSetup::Flush() {
+	//最後にSignalした値までGPUが終えるまで待つ
+	WaitForFenceValue(fenceValue_);
+
+	//もうGPUは何も使っていない
+	deferredReleaseQueue_.Collect(fence_->GetCompletedValue());
+}
+
+void Elysia::DirectXSetup::DeferRelease(ComPtr<ID3D12Resource> resource) {
+	if (resource == nullptr) {
+		return;
+	}
+	//今のフレームでSignalする値を越えたら解放する
+	deferredReleaseQueue_.Push(std::move(resource), fenceValue_ + 1u);
+}
+
+void Elysia::DirectXSetup::SetRenderTarget(const D3D12_CPU_DESCRIPTOR_HANDLE& rtvHandle) {
+	//先にGetCommandListを呼ぶことで、並列記録の途中であればこれより前のチャンクは前の描画先で記録される
+	ComPtr<ID3D12GraphicsCommandList> commandList = DirectXSetup::GetInstance()->GetCommandList();
+	commandList->OMSetRenderTargets(1, &rtvHandle, false, &DirectXSetup::GetInstance()->dsvHandle_);
+	DirectXSetup::GetInstance()->renderTargetHandle_ = rtvHandle;
+}
+
+void Elysia::DirectXSetup::SetRecordingCommandList(ID3D12GraphicsCommandList* commandList) {
+	recordingCommandList_ = commandList;
+}
+
+ComPtr<ID3D12GraphicsCommandList> Elysia::DirectXSetup::GetCommandList() const {
+	//並列記録中のスレッドはそのチャンクに積む
+	if (recordingCommandList_ != nullptr) {
+		return recordingCommandList_;
+	}
+
+	//パスの途中でメインスレッドから直接積まれる時は、
+	//それまでにPushされた描画より後に送られるようにチャンクを区切る
+	ParallelCommandRecorder& parallelCommandRecorder = DirectXSetup::GetInstance()->parallelCommandRecorder_;
+	if (parallelCommandRecorder.GetIsInPass() == true) {
+		parallelCommandRecorder.RecordInline();
+		if (recordingCommandList_ != nullptr) {
+			return recordingCommandList_;
+		}
+	}
+
+	return DirectXSetup::GetInstance()->commandList_;
+}
+
+void Elysia::DirectXSetup::BeginRenderPass() {
+	parallelCommandRecorder_.BeginPass();
+}
+
+void Elysia::DirectXSetup::EndRenderPass() {
+	parallelCommandRecorder_.EndPass();
+}
+
+void Elysia::DirectXSetup::ExecuteAfterMainCommandList(const std::vector<ID3D12CommandList*>& commandLists) {
+	//メインのコマンドリストに積んだもの(バリアやクリア)を先に実行する
+	HRESULT hr = commandList_->Close();
 	assert(SUCCEEDED(hr));
-	hr = DirectXSetup::GetInstance()->commandList_->Reset(DirectXSetup::GetInstance()->commandAllocator_.Get(), nullptr);
+	std::vector<ID3D12CommandList*> executeCommandLists;
+	executeCommandLists.reserve(commandLists.size() + 1u);
+	executeCommandLists.push_back(commandList_.Get());
+	executeCommandLists.insert(executeCommandLists.end(), commandLists.begin(), commandLists.end());
+	commandQueue_->ExecuteCommandLists(static_cast<UINT>(executeCommandLists.size()), executeCommandLists.data());
+
+	//同じアロケータで続きを記録する
+	//アロケータはこのフレームのコンテキストのものなので、GPUが終わるまでResetされない
+	hr = commandList_->Reset(commandAllocators_[frameSynchronizer_.GetFrameIndex()].Get(), nullptr);
 	assert(SUCCEEDED(hr));
+	D3D12CommandRecordBackend::ApplyRenderState(commandList_.Get(), GetRenderState());
+}
+
+Elysia::CommandRecordRenderState Elysia::DirectXSetup::GetRenderState() const {
+	CommandRecordRenderState renderState = {
+		.rtvHandle = renderTargetHandle_,
+		.dsvHandle = dsvHandle_,
+		.viewport = viewport_,
+		.scissorRect = scissorRect_,
+		.srvDescriptorHeap = SrvManager::GetInstance()->GetSrvDescriptorHeap().Get(),
+	};
+	return renderState;
 }
 
 void Elysia::DirectXSetup::Release() {
 
+	//ワーカースレッドを止める
+	parallelCommandRecorder_.Finalize();
+
+	//GPUが使い終わるまで待ってから解放
+	Flush();
+	commandRecordBackend_.Finalize();
+	deferredReleaseQueue_.Clear();
+
 	//解放処理
 	CloseHandle(fenceEvent_);
+	CloseHandle(frameTimer_);
+	CloseHandle(frameLatencyWaitableObject_);
 }
 
 
@@ -12,6 +12,7 @@
 #include <dxgidebug.h>
 #include <dxcapi.h>
 #include <chrono>
+#include <vector>
 
 
 #pragma comment(lib,"d3d12.lib")
@@ -22,6 +23,11 @@
 #include <wrl.h>
 using Microsoft::WRL::ComPtr;
 
+#include "FrameSynchronizer.h"
+#include "DeferredReleaseQueue.h"
+#include "ParallelCommandRecorder.h"
+#include "D3D12CommandRecordBackend.h"
+
 
 
 
@@ -63,6 +69,11 @@ namespace Elysia{
 	/// DirectXの機能をまとめたクラス
 	/// </summary>
 	class DirectXSetup final {
+	public:
+		//同時に処理するフレームの数
+		//CPUがNフレーム目を記録している間にGPUがN-1フレーム目を描画する
+		static constexpr uint32_t FRAME_COUNT_ = 2u;
+
 	private:
 		/// <summary>
 		/// コンストラクタ
@@ -198,6 +209,20 @@ namespace Elysia{
 		/// <param name="afterState"></param>
 		static void SetResourceBarrierForSwapChain(const D3D12_RESOURCE_STATES& beforeState, const D3D12_RESOURCE_STATES& afterState);
 
+		/// <summary>
+		/// 描画先の設定
+		/// 並列記録のチャンクにも同じ描画先を設定する為に覚えておく
+		/// </summary>
+		/// <param name="rtvHandle">RTVのハンドル</param>
+		static void SetRenderTarget(const D3D12_CPU_DESCRIPTOR_HANDLE& rtvHandle);
+
+		/// <summary>
+		/// このスレッドで記録するコマンドリストの設定
+		/// nullptrでメインのコマンドリストに戻る
+		/// </summary>
+		/// <param name="commandList">コマンドリスト</param>
+		static void SetRecordingCommandList(ID3D12GraphicsCommandList* commandList);
+
 
 
 	private:
@@ -248,6 +273,54 @@ namespace Elysia{
 		/// </summary>
 		void EndDraw();
 
+		/// <summary>
+		/// GPUが指定したフェンスの値にたどり着くまで待つ
+		/// </summary>
+		/// <param name="fenceValue">フェンスの値</param>
+		void WaitForFenceValue(const uint64_t& fenceValue);
+
+		/// <summary>
+		/// 次のフレームを始められるまで待つ
+		/// スワップチェインの待機とFPS固定を行う
+		/// </summary>
+		void WaitForNextFrame();
+
+		/// <summary>
+		/// GPUの処理が全て終わるまで待つ
+		/// </summary>
+		void Flush();
+
+		/// <summary>
+		/// GPUが今のフレームを使い終わってから解放する
+		/// 描画に使ったリソースを持っているクラスは、破棄する時にここへ渡すこと
+		/// </summary>
+		/// <param name="resource">リソース</param>
+		void DeferRelease(ComPtr<ID3D12Resource> resource);
+
+		/// <summary>
+		/// 描画パスの開始
+		/// ここからEndRenderPassまでにPushされた描画は並列で記録する
+		/// </summary>
+		void BeginRenderPass();
+
+		/// <summary>
+		/// 描画パスの終了
+		/// </summary>
+		void EndRenderPass();
+
+		/// <summary>
+		/// メインのコマンドリストを閉じて、その後ろに続けてコマンドリストを実行する
+		/// メインのコマンドリストは同じアロケータで記録し直す
+		/// </summary>
+		/// <param name="commandLists">続けて実行するコマンドリスト</param>
+		void ExecuteAfterMainCommandList(const std::vector<ID3D12CommandList*>& commandLists);
+
+		/// <summary>
+		/// 今の描画先などの状態を取得
+		/// </summary>
+		/// <returns>状態</returns>
+		CommandRecordRenderState GetRenderState() const;
+
 		/// <summary>
 		/// 解放
 		/// </summary>
@@ -277,10 +350,17 @@ namespace Elysia{
 
 		/// <summary>
 		/// コマンドリストの取得
+		/// 並列記録中のスレッドではそのチャンクのコマンドリストを返す
 		/// </summary>
 		/// <returns></returns>
-		inline ComPtr<ID3D12GraphicsCommandList> GetCommandList() const {
-			return DirectXSetup::GetInstance()->commandList_;
+		ComPtr<ID3D12GraphicsCommandList> GetCommandList() const;
+
+		/// <summary>
+		/// 並列記録の取得
+		/// </summary>
+		/// <returns></returns>
+		inline ParallelCommandRecorder* GetParallelCommandRecorder() {
+			return &parallelCommandRecorder_;
 		}
 
 		/// <summary>
@@ -317,6 +397,30 @@ namespace Elysia{
 			return depthStencilResource_;
 		}
 
+		/// <summary>
+		/// 最後にSignalしたフェンスの値を取得
+		/// </summary>
+		/// <returns></returns>
+		inline uint64_t GetFenceValue() const {
+			return fenceValue_;
+		}
+
+		/// <summary>
+		/// GPUが終わったフェンスの値を取得
+		/// </summary>
+		/// <returns></returns>
+		inline uint64_t GetCompletedFenceValue() const {
+			return fence_->GetCompletedValue();
+		}
+
+		/// <summary>
+		/// 今のフレームのコンテキストの番号を取得
+		/// </summary>
+		/// <returns></returns>
+		inline uint32_t GetFrameIndex() const {
+			return frameSynchronizer_.GetFrameIndex();
+		}
+
 	private:
 		//ウィンドウクラス
 		WindowsSetup* windowsSetup_ = nullptr;
@@ -334,8 +438,8 @@ namespace Elysia{
 		ComPtr<ID3D12GraphicsCommandList> commandList_ = nullptr;
 		//コマンドキュー
 		ComPtr<ID3D12CommandQueue> commandQueue_ = nullptr;
-		//コマンドアロケータ
-		ComPtr<ID3D12CommandAllocator> commandAllocator_ = nullptr;
+		//コマンドアロケータ(フレームごと)
+		ComPtr<ID3D12CommandAllocator> commandAllocators_[FRAME_COUNT_] = {};
 
 		//DSV
 		ComPtr<ID3D12DescriptorHeap> dsvDescriptorHeap_ = nullptr;
@@ -363,6 +467,11 @@ namespace Elysia{
 		//イベント
 		HANDLE fenceEvent_ = nullptr;
 
+		//フレームごとのコンテキストの管理
+		FrameSynchronizer frameSynchronizer_ = {};
+		//GPUが使い終わるまで解放を待つリソース
+		DeferredReleaseQueue<ComPtr<ID3D12Resource>> deferredReleaseQueue_ = {};
+
 		//デバッグコントローラー
 		ComPtr<ID3D12Debug1> debugController_ = nullptr;
 
@@ -374,6 +483,28 @@ namespace Elysia{
 		//FPS
 		//記録時間(FPS固定用)
 		std::chrono::steady_clock::time_point frameEndTime_;
+		//FPS固定用のタイマー
+		HANDLE frameTimer_ = nullptr;
+		//スワップチェインの待機用
+		HANDLE frameLatencyWaitableObject_ = nullptr;
+
+		//並列記録
+		//ワーカースレッドの最大数
+		static constexpr uint32_t MAX_RECORD_WORKER_COUNT_ = 3u;
+		//1チャンクあたりの描画の数
+		static constexpr uint32_t RECORD_ITEMS_PER_CHUNK_ = 32u;
+		//チャンクごとのコマンドリスト
+		D3D12CommandRecordBackend commandRecordBackend_ = {};
+		//チャンク分けと順番
+		ParallelCommandRecorder parallelCommandRecorder_;
+		//このスレッドで記録するコマンドリスト
+		static thread_local ID3D12GraphicsCommandList* recordingCommandList_;
+		//描画先
+		D3D12_CPU_DESCRIPTOR_HANDLE renderTargetHandle_ = {};
+		//ビューポート
+		D3D12_VIEWPORT viewport_ = {};
+		//シザー
+		D3D12_RECT scissorRect_ = {};
 
 	};
 
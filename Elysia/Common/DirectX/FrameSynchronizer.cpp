@@ -0,0 +1,28 @@
+#include "FrameSynchronizer.h"
+
+#include <cassert>
+
+void Elysia::FrameSynchronizer::Initialize(const uint32_t& frameCount) {
+	assert(frameCount > 0u);
+
+	//最初はどのコンテキストも待たなくて良い
+	frameFenceValues_.assign(frameCount, 0u);
+	frameIndex_ = 0u;
+	frameNumber_ = 0u;
+}
+
+void Elysia::FrameSynchronizer::EndFrame(const uint64_t& fenceValue) {
+	//フェンスの値は増えていくだけ
+	assert(fenceValue > frameFenceValues_[frameIndex_]);
+
+	//このフェンスをGPUが越えるまで今のコンテキストは使わない
+	frameFenceValues_[frameIndex_] = fenceValue;
+
+	//次のコンテキストへ
+	frameIndex_ = (frameIndex_ + 1u) % static_cast<uint32_t>(frameFenceValues_.size());
+	++frameNumber_;
+}
+
+bool Elysia::FrameSynchronizer::IsReady(const uint64_t& completedFenceValue) const {
+	return frameFenceValues_[frameIndex_] <= completedFenceValue;
+}
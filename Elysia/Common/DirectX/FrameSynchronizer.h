@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file FrameSynchronizer.h
+ * @brief 複数フレームを同時に処理する為のフェンスの管理
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 複数フレームを同時に処理する為のフェンスの管理
+	/// フレームごとのコンテキスト(コマンドアロケータなど)を順番に使い回し、
+	/// そのコンテキストを前に使ったフレームをGPUが終えたかどうかだけを見る
+	/// GPUのオブジェクトは持たないのでフェンスの値さえ渡せば単体で動く
+	/// </summary>
+	class FrameSynchronizer final {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		FrameSynchronizer() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~FrameSynchronizer() = default;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="frameCount">同時に処理するフレームの数</param>
+		void Initialize(const uint32_t& frameCount);
+
+		/// <summary>
+		/// フレームの終了
+		/// 今のフレームでSignalした値を記録して次のコンテキストに進む
+		/// </summary>
+		/// <param name="fenceValue">今のフレームでSignalしたフェンスの値</param>
+		void EndFrame(const uint64_t& fenceValue);
+
+		/// <summary>
+		/// 今のコンテキストを使い始めて良いかどうか
+		/// </summary>
+		/// <param name="completedFenceValue">GPUが終わったフェンスの値</param>
+		/// <returns>使い始めて良いかどうか</returns>
+		bool IsReady(const uint64_t& completedFenceValue) const;
+
+	public:
+		/// <summary>
+		/// 今のコンテキストを使い始める前に待つフェンスの値を取得
+		/// </summary>
+		/// <returns>フェンスの値</returns>
+		inline uint64_t GetWaitFenceValue()const {
+			return frameFenceValues_[frameIndex_];
+		}
+
+		/// <summary>
+		/// 今のコンテキストの番号を取得
+		/// </summary>
+		/// <returns>番号</returns>
+		inline uint32_t GetFrameIndex()const {
+			return frameIndex_;
+		}
+
+		/// <summary>
+		/// 同時に処理するフレームの数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		inline uint32_t GetFrameCount()const {
+			return static_cast<uint32_t>(frameFenceValues_.size());
+		}
+
+		/// <summary>
+		/// 今までに終えたフレームの数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		inline uint64_t GetFrameNumber()const {
+			return frameNumber_;
+		}
+
+	private:
+		//コンテキストごとに最後にSignalしたフェンスの値
+		std::vector<uint64_t> frameFenceValues_;
+		//今のコンテキスト
+		uint32_t frameIndex_ = 0u;
+		//今までに終えたフレームの数
+		uint64_t frameNumber_ = 0u;
+
+	};
+
+};
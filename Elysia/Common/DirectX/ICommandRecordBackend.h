@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file ICommandRecordBackend.h
+ * @brief コマンドを並列で記録する先のインターフェイス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// コマンドを並列で記録する先のインターフェイス
+	/// チャンクの番号はフレームの中で0から順番に振られ、その順番で送る
+	/// D3D12ではチャンクごとのコマンドリスト、Linuxでの確認では配列になる
+	/// </summary>
+	class ICommandRecordBackend {
+	public:
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		virtual ~ICommandRecordBackend() = default;
+
+		/// <summary>
+		/// チャンクの準備
+		/// メインスレッドで番号を振った時に呼ばれる
+		/// 記録に必要な状態(描画先など)はここで控えておく
+		/// </summary>
+		/// <param name="firstChunkIndex">最初の番号</param>
+		/// <param name="chunkCount">数</param>
+		virtual void PrepareChunks(const uint32_t& firstChunkIndex, const uint32_t& chunkCount) = 0;
+
+		/// <summary>
+		/// チャンクの記録開始
+		/// 呼んだスレッドの記録先をこのチャンクにする
+		/// 別のチャンクであれば別のスレッドから同時に呼ばれる
+		/// </summary>
+		/// <param name="chunkIndex">番号</param>
+		virtual void BeginChunk(const uint32_t& chunkIndex) = 0;
+
+		/// <summary>
+		/// チャンクの記録終了
+		/// </summary>
+		/// <param name="chunkIndex">番号</param>
+		virtual void EndChunk(const uint32_t& chunkIndex) = 0;
+
+		/// <summary>
+		/// メインの記録先に続けて番号順に送る
+		/// メインスレッドから呼ばれる
+		/// </summary>
+		/// <param name="firstChunkIndex">最初の番号</param>
+		/// <param name="chunkCount">数</param>
+		virtual void Submit(const uint32_t& firstChunkIndex, const uint32_t& chunkCount) = 0;
+
+	};
+
+}
@@ -0,0 +1,213 @@
+#include "ParallelCommandRecorder.h"
+
+#include <cassert>
+#include <algorithm>
+
+#include "ICommandRecordBackend.h"
+#include "Profiler.h"
+
+Elysia::ParallelCommandRecorder::~ParallelCommandRecorder() {
+	Finalize();
+}
+
+void Elysia::ParallelCommandRecorder::Initialize(ICommandRecordBackend* backend, const uint32_t& workerCount, const uint32_t& itemsPerChunk) {
+	assert(backend != nullptr);
+	assert(itemsPerChunk > 0u);
+	assert(workers_.empty() == true);
+
+	backend_ = backend;
+	itemsPerChunk_ = itemsPerChunk;
+	isExiting_ = false;
+
+	//ワーカースレッドを立てておく
+	//毎フレーム立てると重いので待たせておいて使い回す
+	for (uint32_t i = 0u; i < workerCount; ++i) {
+		workers_.emplace_back(&ParallelCommandRecorder::WorkerMain, this);
+	}
+}
+
+void Elysia::ParallelCommandRecorder::BeginFrame() {
+	assert(isInPass_ == false);
+
+	previousStatistics_ = statistics_;
+	statistics_ = {};
+	nextChunkIndex_ = 0u;
+}
+
+void Elysia::ParallelCommandRecorder::BeginPass() {
+	assert(isInPass_ == false);
+
+	isInPass_ = true;
+	items_.clear();
+	chunks_.clear();
+	pendingBegin_ = 0u;
+	passFirstChunkIndex_ = nextChunkIndex_;
+	isInlineOpen_ = false;
+	++statistics_.passCount;
+}
+
+void Elysia::ParallelCommandRecorder::Push(std::function<void()>&& item) {
+	assert(isInPass_ == true);
+
+	//直接積んでいたチャンクはここで閉じる
+	if (isInlineOpen_ == true) {
+		CloseInlineChunk();
+	}
+	items_.push_back(std::move(item));
+	++statistics_.itemCount;
+}
+
+void Elysia::ParallelCommandRecorder::RecordInline() {
+	assert(isInPass_ == true);
+
+	//既に開いている
+	if (isInlineOpen_ == true) {
+		return;
+	}
+	//まだ何もPushされていない時はメインの記録先に直接積んで良い
+	//メインの記録先はチャンクより先に送られるので順番は変わらない
+	if (items_.empty() == true) {
+		return;
+	}
+
+	//それまでの描画に先に番号を振る
+	SealPendingItems();
+
+	//その場で記録するチャンクを開く
+	inlineChunkIndex_ = nextChunkIndex_;
+	++nextChunkIndex_;
+	backend_->PrepareChunks(inlineChunkIndex_, 1u);
+	backend_->BeginChunk(inlineChunkIndex_);
+	isInlineOpen_ = true;
+	++statistics_.inlineChunkCount;
+}
+
+void Elysia::ParallelCommandRecorder::EndPass() {
+	assert(isInPass_ == true);
+
+	if (isInlineOpen_ == true) {
+		CloseInlineChunk();
+	}
+	SealPendingItems();
+
+	//記録
+	//1つだけの時はスレッドに渡す方が遅い
+	if (workers_.empty() == true || chunks_.size() <= 1u) {
+		for (const Chunk& chunk : chunks_) {
+			RecordChunk(chunk);
+		}
+	}
+	else {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			nextChunk_.store(0u);
+			finishedWorkerCount_ = 0u;
+			++jobGeneration_;
+		}
+		workCondition_.notify_all();
+
+		//メインスレッドも記録する
+		RecordAvailableChunks();
+
+		//ワーカーが全員終わるまで待つ
+		//終わる前に次のパスに進むとitems_やchunks_が書き換わってしまう
+		std::unique_lock<std::mutex> lock(mutex_);
+		doneCondition_.wait(lock, [this]() {
+			return finishedWorkerCount_ == static_cast<uint32_t>(workers_.size());
+		});
+	}
+
+	//番号順に送る
+	uint32_t chunkCount = nextChunkIndex_ - passFirstChunkIndex_;
+	if (chunkCount > 0u) {
+		backend_->Submit(passFirstChunkIndex_, chunkCount);
+	}
+
+	//描画の中で持っている参照はここで手放す
+	items_.clear();
+	chunks_.clear();
+	isInPass_ = false;
+}
+
+void Elysia::ParallelCommandRecorder::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isExiting_ = true;
+	}
+	workCondition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+}
+
+void Elysia::ParallelCommandRecorder::SealPendingItems() {
+	size_t pendingCount = items_.size() - pendingBegin_;
+	if (pendingCount == 0u) {
+		return;
+	}
+
+	//均等に分ける
+	uint32_t chunkCount = static_cast<uint32_t>((pendingCount + itemsPerChunk_ - 1u) / itemsPerChunk_);
+	size_t itemsPerChunk = (pendingCount + chunkCount - 1u) / chunkCount;
+	backend_->PrepareChunks(nextChunkIndex_, chunkCount);
+	for (uint32_t i = 0u; i < chunkCount; ++i) {
+		size_t beginItem = pendingBegin_ + itemsPerChunk * i;
+		Chunk chunk = {
+			.chunkIndex = nextChunkIndex_,
+			.beginItem = beginItem,
+			.endItem = std::min<size_t>(beginItem + itemsPerChunk, items_.size()),
+		};
+		chunks_.push_back(chunk);
+		++nextChunkIndex_;
+	}
+	pendingBegin_ = items_.size();
+	statistics_.deferredChunkCount += chunkCount;
+}
+
+void Elysia::ParallelCommandRecorder::CloseInlineChunk() {
+	backend_->EndChunk(inlineChunkIndex_);
+	isInlineOpen_ = false;
+}
+
+void Elysia::ParallelCommandRecorder::RecordChunk(const Chunk& chunk) {
+	ELYSIA_PROFILE_SCOPE("ParallelCommandRecorder::RecordChunk");
+	backend_->BeginChunk(chunk.chunkIndex);
+	for (size_t i = chunk.beginItem; i < chunk.endItem; ++i) {
+		items_[i]();
+	}
+	backend_->EndChunk(chunk.chunkIndex);
+}
+
+void Elysia::ParallelCommandRecorder::RecordAvailableChunks() {
+	//早く終わったスレッドが次のチャンクを取るので、チャンクの重さに差があっても偏らない
+	//どのスレッドが記録しても送る順番は番号で決まる
+	for (size_t index = nextChunk_.fetch_add(1u); index < chunks_.size(); index = nextChunk_.fetch_add(1u)) {
+		RecordChunk(chunks_[index]);
+	}
+}
+
+void Elysia::ParallelCommandRecorder::WorkerMain() {
+	ELYSIA_PROFILE_THREAD("コマンドの記録");
+	uint64_t generation = 0u;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			workCondition_.wait(lock, [this, &generation]() {
+				return isExiting_ == true || jobGeneration_ != generation;
+			});
+			if (isExiting_ == true) {
+				return;
+			}
+			generation = jobGeneration_;
+		}
+
+		RecordAvailableChunks();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			++finishedWorkerCount_;
+		}
+		doneCondition_.notify_one();
+	}
+}
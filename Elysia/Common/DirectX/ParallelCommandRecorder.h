@@ -0,0 +1,225 @@
+#pragma once
+
+/**
+ * @file ParallelCommandRecorder.h
+ * @brief 描画コマンドをチャンクに分けて複数のスレッドで記録するクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// コマンドを並列で記録する先のインターフェイス
+	/// </summary>
+	class ICommandRecordBackend;
+
+	/// <summary>
+	/// 描画コマンドをチャンクに分けて複数のスレッドで記録するクラス
+	/// パス(3D,ポストエフェクト,スプライト)の間にPushされた描画をまとめて、
+	/// EndPassでチャンクごとに別々のスレッドで記録し、番号順に送る
+	/// Pushできない描画がメインスレッドから直接積まれる時はRecordInlineでチャンクを区切り、
+	/// その場で記録するので順番は直接積んだ時と変わらない
+	/// </summary>
+	class ParallelCommandRecorder final {
+	public:
+		/// <summary>
+		/// 統計
+		/// </summary>
+		struct Statistics {
+			//パスの数
+			uint32_t passCount;
+			//Pushされた描画の数
+			uint32_t itemCount;
+			//スレッドで記録したチャンクの数
+			uint32_t deferredChunkCount;
+			//メインスレッドでその場で記録したチャンクの数
+			uint32_t inlineChunkCount;
+		};
+
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		ParallelCommandRecorder() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~ParallelCommandRecorder();
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// </summary>
+		/// <param name="parallelCommandRecorder"></param>
+		ParallelCommandRecorder(const ParallelCommandRecorder& parallelCommandRecorder) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="parallelCommandRecorder"></param>
+		/// <returns></returns>
+		ParallelCommandRecorder& operator=(const ParallelCommandRecorder& parallelCommandRecorder) = delete;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="backend">記録先</param>
+		/// <param name="workerCount">ワーカースレッドの数(0だとメインスレッドだけで記録)</param>
+		/// <param name="itemsPerChunk">1チャンクあたりの描画の数の目安</param>
+		void Initialize(ICommandRecordBackend* backend, const uint32_t& workerCount, const uint32_t& itemsPerChunk);
+
+		/// <summary>
+		/// フレームの開始
+		/// チャンクの番号を0に戻す
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// パスの開始
+		/// </summary>
+		void BeginPass();
+
+		/// <summary>
+		/// 描画を追加
+		/// 中で使うものはEndPassまで生きている必要がある
+		/// </summary>
+		/// <param name="item">コマンドを積む処理</param>
+		void Push(std::function<void()>&& item);
+
+		/// <summary>
+		/// メインスレッドから直接積む前に呼ぶ
+		/// それまでにPushされた描画より後に送られるチャンクを開く
+		/// </summary>
+		void RecordInline();
+
+		/// <summary>
+		/// パスの終了
+		/// 溜めた描画を記録して送る
+		/// </summary>
+		void EndPass();
+
+		/// <summary>
+		/// 解放
+		/// </summary>
+		void Finalize();
+
+	public:
+		/// <summary>
+		/// パスの途中かどうか
+		/// </summary>
+		/// <returns></returns>
+		inline bool GetIsInPass()const {
+			return isInPass_;
+		}
+
+		/// <summary>
+		/// ワーカースレッドの数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		inline uint32_t GetWorkerCount()const {
+			return static_cast<uint32_t>(workers_.size());
+		}
+
+		/// <summary>
+		/// 前のフレームの統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		inline const Statistics& GetStatistics()const {
+			return previousStatistics_;
+		}
+
+	private:
+		/// <summary>
+		/// チャンク
+		/// </summary>
+		struct Chunk {
+			//番号
+			uint32_t chunkIndex;
+			//描画の範囲
+			size_t beginItem;
+			size_t endItem;
+		};
+
+		/// <summary>
+		/// まだチャンクに入っていない描画に番号を振る
+		/// </summary>
+		void SealPendingItems();
+
+		/// <summary>
+		/// 開いているチャンクを閉じる
+		/// </summary>
+		void CloseInlineChunk();
+
+		/// <summary>
+		/// チャンクを記録
+		/// </summary>
+		/// <param name="chunk">チャンク</param>
+		void RecordChunk(const Chunk& chunk);
+
+		/// <summary>
+		/// 取れるだけチャンクを取って記録
+		/// </summary>
+		void RecordAvailableChunks();
+
+		/// <summary>
+		/// ワーカースレッドの処理
+		/// </summary>
+		void WorkerMain();
+
+	private:
+		//記録先
+		ICommandRecordBackend* backend_ = nullptr;
+		//1チャンクあたりの描画の数の目安
+		uint32_t itemsPerChunk_ = 1u;
+
+		//パスの途中かどうか
+		bool isInPass_ = false;
+		//パスの描画
+		std::vector<std::function<void()>> items_;
+		//まだ番号が振られていない最初の描画
+		size_t pendingBegin_ = 0u;
+		//スレッドで記録するチャンク
+		std::vector<Chunk> chunks_;
+		//次に振る番号
+		uint32_t nextChunkIndex_ = 0u;
+		//今のパスの最初の番号
+		uint32_t passFirstChunkIndex_ = 0u;
+		//メインスレッドで開いているチャンク
+		bool isInlineOpen_ = false;
+		uint32_t inlineChunkIndex_ = 0u;
+
+		//統計
+		Statistics statistics_ = {};
+		Statistics previousStatistics_ = {};
+
+		//ワーカースレッド
+		std::vector<std::thread> workers_;
+		std::mutex mutex_;
+		//仕事が来たことを伝える
+		std::condition_variable workCondition_;
+		//仕事が終わったことを伝える
+		std::condition_variable doneCondition_;
+		//仕事を出した回数
+		uint64_t jobGeneration_ = 0u;
+		//仕事を終えたワーカーの数
+		uint32_t finishedWorkerCount_ = 0u;
+		//次に取るチャンク
+		std::atomic<size_t> nextChunk_ = 0u;
+		//終了
+		bool isExiting_ = false;
+
+	};
+
+}
@@ -0,0 +1,46 @@
+#include "FileWatcher.h"
+
+void Elysia::FileWatcher::Initialize(const std::string& filePath) {
+	filePath_ = filePath;
+
+	//今の状態を基準にする
+	Stamp stamp = {};
+	GetCurrentStamp(stamp);
+	reportedStamp_ = stamp;
+	previousStamp_ = stamp;
+}
+
+bool Elysia::FileWatcher::IsChanged() {
+	//消されている、書き換え中などで取れない時は変更なしとする
+	Stamp stamp = {};
+	if (GetCurrentStamp(stamp) == false) {
+		return false;
+	}
+
+	//前回から変わっている時はまだ書き込み中かもしれないので待つ
+	if (stamp != previousStamp_) {
+		previousStamp_ = stamp;
+		return false;
+	}
+
+	//止まっていて、最後に伝えた時と違ったら変更
+	if (stamp != reportedStamp_) {
+		reportedStamp_ = stamp;
+		return true;
+	}
+	return false;
+}
+
+bool Elysia::FileWatcher::GetCurrentStamp(Stamp& stamp)const {
+	//例外を投げないようにerror_codeで受け取る
+	std::error_code errorCode;
+	stamp.writeTime = std::filesystem::last_write_time(filePath_, errorCode);
+	if (errorCode) {
+		return false;
+	}
+	stamp.size = std::filesystem::file_size(filePath_, errorCode);
+	if (errorCode) {
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file FileWatcher.h
+ * @brief ファイルの更新監視
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <cstdint>
+#include <filesystem>
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// ファイルの更新監視
+	/// 更新時刻とサイズを見て変わったかどうかを調べる
+	/// </summary>
+	class FileWatcher final {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		FileWatcher() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~FileWatcher() = default;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// 今の状態を基準にする
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		void Initialize(const std::string& filePath);
+
+		/// <summary>
+		/// 変更されたかどうか
+		/// 書き込み途中を拾わないように、前回調べた時から変化が止まっていたら変更とみなす
+		/// 1回の変更につき1度だけtrueを返す
+		/// </summary>
+		/// <returns>変更されたかどうか</returns>
+		bool IsChanged();
+
+	public:
+		/// <summary>
+		/// ファイルパスを取得
+		/// </summary>
+		/// <returns>ファイルパス</returns>
+		inline const std::string& GetFilePath()const {
+			return filePath_;
+		}
+
+	private:
+		/// <summary>
+		/// ファイルの状態
+		/// </summary>
+		struct Stamp {
+			//更新時刻
+			std::filesystem::file_time_type writeTime = {};
+			//サイズ
+			uintmax_t size = 0u;
+
+			/// <summary>
+			/// 比較
+			/// </summary>
+			bool operator==(const Stamp& stamp)const = default;
+		};
+
+		/// <summary>
+		/// 今の状態を取得
+		/// </summary>
+		/// <param name="stamp">状態</param>
+		/// <returns>取得できたかどうか</returns>
+		bool GetCurrentStamp(Stamp& stamp)const;
+
+	private:
+		//ファイルパス
+		std::string filePath_;
+		//最後に変更を伝えた時の状態
+		Stamp reportedStamp_ = {};
+		//前回調べた時の状態
+		Stamp previousStamp_ = {};
+
+	};
+
+};
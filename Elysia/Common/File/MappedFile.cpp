@@ -0,0 +1,116 @@
+#include "MappedFile.h"
+
+#include <filesystem>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // _WIN32
+
+Elysia::MappedFile::~MappedFile() {
+	Close();
+}
+
+#ifdef _WIN32
+
+bool Elysia::MappedFile::Open(const std::string& filePath) {
+	//開き直す場合は一度閉じる
+	Close();
+
+	//ファイルを開く
+	std::filesystem::path path = filePath;
+	HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	//サイズの取得
+	LARGE_INTEGER fileSize = {};
+	if (GetFileSizeEx(fileHandle, &fileSize) == FALSE || fileSize.QuadPart == 0) {
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	//マッピング
+	HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+	if (mappingHandle == nullptr) {
+		CloseHandle(fileHandle);
+		return false;
+	}
+	void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0u, 0u, 0u);
+	if (view == nullptr) {
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	//記録
+	fileHandle_ = fileHandle;
+	mappingHandle_ = mappingHandle;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+}
+
+void Elysia::MappedFile::Close() {
+	if (data_ != nullptr) {
+		UnmapViewOfFile(data_);
+		data_ = nullptr;
+	}
+	if (mappingHandle_ != nullptr) {
+		CloseHandle(mappingHandle_);
+		mappingHandle_ = nullptr;
+	}
+	if (fileHandle_ != nullptr) {
+		CloseHandle(fileHandle_);
+		fileHandle_ = nullptr;
+	}
+	size_ = 0u;
+}
+
+#else
+
+bool Elysia::MappedFile::Open(const std::string& filePath) {
+	//開き直す場合は一度閉じる
+	Close();
+
+	//ファイルを開く
+	int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) {
+		return false;
+	}
+
+	//サイズの取得
+	struct stat fileStatus = {};
+	if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0) {
+		close(fileDescriptor);
+		return false;
+	}
+
+	//マッピング
+	//マップした後はファイルディスクリプタを閉じても問題ない
+	void* view = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+
+	//記録
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(fileStatus.st_size);
+	return true;
+}
+
+void Elysia::MappedFile::Close() {
+	if (data_ != nullptr) {
+		munmap(const_cast<uint8_t*>(data_), size_);
+		data_ = nullptr;
+	}
+	size_ = 0u;
+}
+
+#endif // _WIN32
@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file MappedFile.h
+ * @brief メモリマップドファイル(読み込み専用)
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <cstdint>
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// メモリマップドファイル(読み込み専用)
+	/// ファイルの中身をコピーせずにそのままメモリとして読める
+	/// </summary>
+	class MappedFile final {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		MappedFile() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~MappedFile();
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// </summary>
+		/// <param name="mappedFile"></param>
+		MappedFile(const MappedFile& mappedFile) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="mappedFile"></param>
+		/// <returns></returns>
+		MappedFile& operator=(const MappedFile& mappedFile) = delete;
+
+	public:
+		/// <summary>
+		/// 開く
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <returns>開けたかどうか</returns>
+		bool Open(const std::string& filePath);
+
+		/// <summary>
+		/// 閉じる
+		/// </summary>
+		void Close();
+
+	public:
+		/// <summary>
+		/// 先頭のアドレスを取得
+		/// </summary>
+		/// <returns>アドレス</returns>
+		inline const uint8_t* GetData()const {
+			return data_;
+		}
+
+		/// <summary>
+		/// サイズを取得
+		/// </summary>
+		/// <returns>サイズ</returns>
+		inline size_t GetSize()const {
+			return size_;
+		}
+
+		/// <summary>
+		/// 開いているかどうか
+		/// </summary>
+		/// <returns>開いているかどうか</returns>
+		inline bool GetIsOpen()const {
+			return data_ != nullptr;
+		}
+
+	private:
+		//先頭のアドレス
+		const uint8_t* data_ = nullptr;
+		//サイズ
+		size_t size_ = 0u;
+
+#ifdef _WIN32
+		//ファイルのハンドル
+		void* fileHandle_ = nullptr;
+		//マッピングのハンドル
+		void* mappingHandle_ = nullptr;
+#endif // _WIN32
+
+	};
+
+};
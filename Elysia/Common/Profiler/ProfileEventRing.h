@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * @file ProfileEventRing.h
+ * @brief 計測の始まりと終わりを溜めるリングバッファ
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <atomic>
+#include <array>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 計測の出来事の種類
+	/// </summary>
+	enum class ProfileEventType : uint32_t {
+		//始まり
+		Begin,
+		//終わり
+		End,
+	};
+
+	/// <summary>
+	/// 計測の出来事
+	/// </summary>
+	struct ProfileEvent {
+		//名前(文字列リテラルを指す)
+		const char* name;
+		//時刻(ナノ秒)
+		uint64_t time;
+		//種類
+		ProfileEventType type;
+	};
+
+	/// <summary>
+	/// 計測の始まりと終わりを溜めるリングバッファ
+	/// 書くのは持ち主のスレッドだけ、読むのはフレームの始めに集めるスレッドだけなのでロックが要らない
+	/// </summary>
+	class ProfileEventRing final {
+	public:
+		//溜められる数(2の累乗)
+		static const uint32_t CAPACITY_ = 1u << 14u;
+
+	public:
+		/// <summary>
+		/// 始まりを書く
+		/// 書いた始まりの終わりは必ず書けるように、閉じていない分の場所を残しておく
+		/// </summary>
+		/// <param name="name">名前</param>
+		/// <param name="time">時刻(ナノ秒)</param>
+		/// <returns>書けたかどうか</returns>
+		inline bool PushBegin(const char* name, const uint64_t& time) {
+			uint64_t writeIndex = writeIndex_.load(std::memory_order_relaxed);
+			uint64_t usedCount = writeIndex - readIndex_.load(std::memory_order_acquire);
+			//自分の始まりと終わり、外側の終わりの分が要る
+			if (usedCount + openCount_ + 2u > CAPACITY_) {
+				droppedCount_.store(droppedCount_.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+				return false;
+			}
+			events_[writeIndex & (CAPACITY_ - 1u)] = { .name = name, .time = time, .type = ProfileEventType::Begin };
+			writeIndex_.store(writeIndex + 1u, std::memory_order_release);
+			++openCount_;
+			return true;
+		}
+
+		/// <summary>
+		/// 終わりを書く
+		/// PushBeginで書けた時だけ呼ぶ
+		/// </summary>
+		/// <param name="name">名前</param>
+		/// <param name="time">時刻(ナノ秒)</param>
+		inline void PushEnd(const char* name, const uint64_t& time) {
+			uint64_t writeIndex = writeIndex_.load(std::memory_order_relaxed);
+			events_[writeIndex & (CAPACITY_ - 1u)] = { .name = name, .time = time, .type = ProfileEventType::End };
+			writeIndex_.store(writeIndex + 1u, std::memory_order_release);
+			--openCount_;
+		}
+
+		/// <summary>
+		/// 溜まっている分を全部取り出す
+		/// </summary>
+		/// <typeparam name="Function">1つずつ受け取る関数</typeparam>
+		/// <param name="function">関数</param>
+		template<typename Function>
+		inline void Drain(Function&& function) {
+			uint64_t readIndex = readIndex_.load(std::memory_order_relaxed);
+			uint64_t writeIndex = writeIndex_.load(std::memory_order_acquire);
+			for (; readIndex < writeIndex; ++readIndex) {
+				function(events_[readIndex & (CAPACITY_ - 1u)]);
+			}
+			//読み終わったところまで書いて良い
+			readIndex_.store(readIndex, std::memory_order_release);
+		}
+
+	public:
+		/// <summary>
+		/// いっぱいで書けなかった数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		inline uint64_t GetDroppedCount() const {
+			return droppedCount_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		//読んだ数(読む側だけが書く)
+		std::atomic<uint64_t> readIndex_ = 0u;
+		//出来事
+		//書いた数と読んだ数の間に挟んで、書く側と読む側が同じキャッシュラインを取り合わないようにする
+		std::array<ProfileEvent, CAPACITY_> events_ = {};
+		//書いた数(持ち主のスレッドだけが書く)
+		std::atomic<uint64_t> writeIndex_ = 0u;
+		//閉じていない始まりの数(持ち主のスレッドだけが触る)
+		uint32_t openCount_ = 0u;
+		//書けなかった数(持ち主のスレッドだけが数える)
+		std::atomic<uint64_t> droppedCount_ = 0u;
+
+	};
+
+}
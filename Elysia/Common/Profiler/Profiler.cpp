@@ -0,0 +1,305 @@
+#include "Profiler.h"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+#include <unordered_map>
+#include <string_view>
+
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
+
+namespace {
+
+	/// <summary>
+	/// JSONの文字列に入れられるようにする
+	/// </summary>
+	/// <param name="text">文字列</param>
+	/// <returns>エスケープした文字列</returns>
+	std::string EscapeJson(const std::string_view& text) {
+		std::string result;
+		result.reserve(text.size());
+		for (const char& character : text) {
+			if (character == '"' || character == '\\') {
+				result.push_back('\\');
+				result.push_back(character);
+			}
+			else if (static_cast<unsigned char>(character) < 0x20u) {
+				char escaped[8] = {};
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(character));
+				result += escaped;
+			}
+			else {
+				result.push_back(character);
+			}
+		}
+		return result;
+	}
+
+}
+
+Elysia::Profiler* Elysia::Profiler::GetInstance() {
+	static Profiler instance;
+	return &instance;
+}
+
+Elysia::Profiler::ThreadState* Elysia::Profiler::RegisterThread() {
+	std::lock_guard<std::mutex> lock(threadMutex_);
+	std::unique_ptr<ThreadState> threadState = std::make_unique<ThreadState>();
+	threadState->threadIndex = uint32_t(threadStates_.size());
+	threadState->name = "スレッド" + std::to_string(threadState->threadIndex);
+	threadStates_.push_back(std::move(threadState));
+	return threadStates_.back().get();
+}
+
+void Elysia::Profiler::SetThreadName(const std::string& name) {
+	ThreadState* threadState = threadState_;
+	if (threadState == nullptr) {
+		threadState = RegisterThread();
+		threadState_ = threadState;
+	}
+	std::lock_guard<std::mutex> lock(threadMutex_);
+	threadState->name = name;
+}
+
+void Elysia::Profiler::NewFrame() {
+	uint64_t now = GetTime();
+
+	{
+		//登録と重ならないようにする
+		//書く側はロックしないので、集めている間も止まらない
+		std::lock_guard<std::mutex> lock(threadMutex_);
+		for (const std::unique_ptr<ThreadState>& threadState : threadStates_) {
+			threadState->ring.Drain([this, &threadState](const ProfileEvent& event) {
+				if (event.type == ProfileEventType::Begin) {
+					threadState->openEvents.push_back(event);
+					return;
+				}
+				//始まりと終わりは必ず組になっている
+				assert(threadState->openEvents.empty() == false);
+				const ProfileEvent& beginEvent = threadState->openEvents.back();
+				currentFrame_.zones.push_back({
+					.name = beginEvent.name,
+					.beginTime = beginEvent.time,
+					.endTime = event.time,
+					.depth = uint32_t(threadState->openEvents.size() - 1u),
+					.threadIndex = threadState->threadIndex,
+				});
+				threadState->openEvents.pop_back();
+			});
+		}
+	}
+
+	//最初の呼び出しは始まりを決めるだけ
+	if (currentFrame_.beginTime != 0u) {
+		currentFrame_.endTime = now;
+		//入れ替えて区間の配列を使い回す
+		std::swap(lastFrame_, currentFrame_);
+
+		//保存
+		if (captureRemainingCount_ > 0u) {
+			captureFrames_.push_back(lastFrame_);
+			--captureRemainingCount_;
+			if (captureRemainingCount_ == 0u) {
+				WriteChromeTrace(captureFilePath_, captureFrames_);
+				captureFrames_.clear();
+			}
+		}
+	}
+
+	currentFrame_.frameIndex = lastFrame_.frameIndex + 1u;
+	currentFrame_.beginTime = now;
+	currentFrame_.endTime = now;
+	currentFrame_.zones.clear();
+}
+
+void Elysia::Profiler::RequestCapture(const uint32_t& frameCount, const std::string& filePath) {
+	assert(frameCount > 0u);
+	captureFrames_.clear();
+	captureFrames_.reserve(frameCount);
+	captureRemainingCount_ = frameCount;
+	captureFilePath_ = filePath;
+}
+
+bool Elysia::Profiler::WriteChromeTrace(const std::string& filePath, const std::vector<ProfileFrame>& frames) {
+	std::ofstream file(filePath, std::ios::binary);
+	if (file.is_open() == false) {
+		return false;
+	}
+
+	//最初のフレームの始まりを0にする
+	uint64_t originTime = (frames.empty() == true) ? 0u : frames.front().beginTime;
+	//ナノ秒を小数点以下3桁のマイクロ秒にする
+	auto toMicroseconds = [originTime](const uint64_t& time) {
+		return double(int64_t(time - originTime)) / 1000.0;
+	};
+
+	file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	char line[256] = {};
+	bool isFirst = true;
+	auto writeSeparator = [&file, &isFirst]() {
+		if (isFirst == false) {
+			file << ",\n";
+		}
+		isFirst = false;
+	};
+
+	//スレッドの名前
+	{
+		std::lock_guard<std::mutex> lock(threadMutex_);
+		for (const std::unique_ptr<ThreadState>& threadState : threadStates_) {
+			writeSeparator();
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadState->threadIndex
+				<< ",\"args\":{\"name\":\"" << EscapeJson(threadState->name) << "\"}}";
+		}
+	}
+
+	for (const ProfileFrame& frame : frames) {
+		//フレームの区切り
+		writeSeparator();
+		std::snprintf(line, sizeof(line), "{\"name\":\"Frame %llu\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":%.3f}",
+			static_cast<unsigned long long>(frame.frameIndex), toMicroseconds(frame.beginTime));
+		file << line;
+
+		for (const ProfileZone& zone : frame.zones) {
+			writeSeparator();
+			file << "{\"name\":\"" << EscapeJson(zone.name) << "\",\"cat\":\"Elysia\",\"ph\":\"X\"";
+			std::snprintf(line, sizeof(line), ",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				zone.threadIndex, toMicroseconds(zone.beginTime), double(zone.endTime - zone.beginTime) / 1000.0);
+			file << line;
+		}
+	}
+	file << "\n]}\n";
+
+	return file.good();
+}
+
+uint32_t Elysia::Profiler::GetThreadCount() {
+	std::lock_guard<std::mutex> lock(threadMutex_);
+	return uint32_t(threadStates_.size());
+}
+
+std::string Elysia::Profiler::GetThreadName(const uint32_t& threadIndex) {
+	std::lock_guard<std::mutex> lock(threadMutex_);
+	assert(threadIndex < threadStates_.size());
+	return threadStates_[threadIndex]->name;
+}
+
+uint64_t Elysia::Profiler::GetDroppedCount() {
+	std::lock_guard<std::mutex> lock(threadMutex_);
+	uint64_t droppedCount = 0u;
+	for (const std::unique_ptr<ThreadState>& threadState : threadStates_) {
+		droppedCount += threadState->ring.GetDroppedCount();
+	}
+	return droppedCount;
+}
+
+void Elysia::Profiler::DisplayImGui() {
+#ifdef _DEBUG
+	//1段の高さ
+	const float ROW_HEIGHT = 18.0f;
+	//合計の表に出す数
+	const size_t SUMMARY_COUNT = 16u;
+
+	ImGui::Begin("プロファイラ");
+
+	if (ImGui::Checkbox("止める", &isDisplayPause_) == true && isDisplayPause_ == true) {
+		pausedFrame_ = lastFrame_;
+	}
+	const ProfileFrame& frame = (isDisplayPause_ == true) ? pausedFrame_ : lastFrame_;
+	uint64_t frameDuration = std::max<uint64_t>(frame.endTime - frame.beginTime, 1u);
+	ImGui::Text("フレーム %llu : %.3f ms", static_cast<unsigned long long>(frame.frameIndex), double(frameDuration) / 1000000.0);
+	ImGui::Text("書けなかった数 : %llu", static_cast<unsigned long long>(GetDroppedCount()));
+
+	//chrome://tracingで読むファイルに保存
+	ImGui::InputInt("保存するフレーム数", &displayCaptureFrameCount_);
+	displayCaptureFrameCount_ = std::clamp(displayCaptureFrameCount_, 1, 3600);
+	if (GetIsCapturing() == true) {
+		ImGui::Text("保存中 : 残り%uフレーム", captureRemainingCount_);
+	}
+	else if (ImGui::Button("chrome://tracing用に保存") == true) {
+		RequestCapture(uint32_t(displayCaptureFrameCount_), DEFAULT_TRACE_FILE_PATH_);
+	}
+
+	//スレッドごとに階層を縦に、時間を横に並べる
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+	uint32_t threadCount = GetThreadCount();
+	for (uint32_t threadIndex = 0u; threadIndex < threadCount; ++threadIndex) {
+		uint32_t maxDepth = 0u;
+		bool isUsed = false;
+		for (const ProfileZone& zone : frame.zones) {
+			if (zone.threadIndex == threadIndex) {
+				maxDepth = std::max(maxDepth, zone.depth);
+				isUsed = true;
+			}
+		}
+		if (isUsed == false) {
+			continue;
+		}
+
+		ImGui::Text("%s", GetThreadName(threadIndex).c_str());
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		ImGui::PushID(int32_t(threadIndex));
+		ImGui::InvisibleButton("flame", ImVec2(width, float(maxDepth + 1u) * ROW_HEIGHT));
+		ImGui::PopID();
+		bool isHovered = ImGui::IsItemHovered();
+		ImVec2 mousePosition = ImGui::GetIO().MousePos;
+
+		for (const ProfileZone& zone : frame.zones) {
+			if (zone.threadIndex != threadIndex) {
+				continue;
+			}
+			//前のフレームから続いている区間もあるので端で切る
+			double begin = std::clamp(double(int64_t(zone.beginTime - frame.beginTime)) / double(frameDuration), 0.0, 1.0);
+			double end = std::clamp(double(int64_t(zone.endTime - frame.beginTime)) / double(frameDuration), 0.0, 1.0);
+			ImVec2 minimum = ImVec2(origin.x + float(begin) * width, origin.y + float(zone.depth) * ROW_HEIGHT);
+			ImVec2 maximum = ImVec2(std::max(origin.x + float(end) * width, minimum.x + 1.0f), minimum.y + ROW_HEIGHT - 1.0f);
+
+			//名前で色を決めて、同じ処理は毎フレーム同じ色にする
+			uint32_t hash = 2166136261u;
+			for (const char* character = zone.name; *character != '\0'; ++character) {
+				hash = (hash ^ uint32_t(static_cast<unsigned char>(*character))) * 16777619u;
+			}
+			ImU32 color = ImColor::HSV(float(hash % 360u) / 360.0f, 0.5f, 0.8f);
+			drawList->AddRectFilled(minimum, maximum, color);
+
+			//入る幅なら名前を書く
+			if (maximum.x - minimum.x > ImGui::CalcTextSize(zone.name).x + 4.0f) {
+				drawList->AddText(ImVec2(minimum.x + 2.0f, minimum.y + 1.0f), IM_COL32(0, 0, 0, 255), zone.name);
+			}
+
+			if (isHovered == true &&
+				mousePosition.x >= minimum.x && mousePosition.x < maximum.x &&
+				mousePosition.y >= minimum.y && mousePosition.y < maximum.y) {
+				ImGui::SetTooltip("%s\n%.3f ms", zone.name, double(zone.endTime - zone.beginTime) / 1000000.0);
+			}
+		}
+	}
+
+	//名前ごとの合計
+	struct Summary {
+		uint64_t totalTime;
+		uint32_t count;
+	};
+	std::unordered_map<std::string_view, Summary> summaries;
+	for (const ProfileZone& zone : frame.zones) {
+		Summary& summary = summaries[zone.name];
+		summary.totalTime += zone.endTime - zone.beginTime;
+		++summary.count;
+	}
+	std::vector<std::pair<std::string_view, Summary>> sortedSummaries(summaries.begin(), summaries.end());
+	std::sort(sortedSummaries.begin(), sortedSummaries.end(), [](const auto& a, const auto& b) {
+		return a.second.totalTime > b.second.totalTime;
+	});
+	ImGui::Separator();
+	for (size_t i = 0u; i < std::min(sortedSummaries.size(), SUMMARY_COUNT); ++i) {
+		ImGui::Text("%8.3f ms %4u回 %s", double(sortedSummaries[i].second.totalTime) / 1000000.0,
+			sortedSummaries[i].second.count, std::string(sortedSummaries[i].first).c_str());
+	}
+
+	ImGui::End();
+#endif
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+/**
+ * @file Profiler.h
+ * @brief CPUの処理時間を階層で計測するクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include "ProfileEventRing.h"
+
+//計測するかどうか
+//リリースでも現場で計測したい時はプロジェクトの設定で1にする
+#ifndef ELYSIA_PROFILER_ENABLE
+#ifdef _DEBUG
+#define ELYSIA_PROFILER_ENABLE 1
+#else
+#define ELYSIA_PROFILER_ENABLE 0
+#endif
+#endif
+
+#if ELYSIA_PROFILER_ENABLE
+#define ELYSIA_PROFILE_CONCAT_INNER(a, b) a##b
+#define ELYSIA_PROFILE_CONCAT(a, b) ELYSIA_PROFILE_CONCAT_INNER(a, b)
+//このスコープを抜けるまでを計測する
+//名前は文字列リテラルにしてね
+#define ELYSIA_PROFILE_SCOPE(name) Elysia::ProfileScope ELYSIA_PROFILE_CONCAT(profileScope, __LINE__)(name)
+//このスレッドの名前を付ける
+#define ELYSIA_PROFILE_THREAD(name) Elysia::Profiler::GetInstance()->SetThreadName(name)
+#else
+#define ELYSIA_PROFILE_SCOPE(name) ((void)0)
+#define ELYSIA_PROFILE_THREAD(name) ((void)0)
+#endif
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 計測した区間
+	/// </summary>
+	struct ProfileZone {
+		//名前
+		const char* name;
+		//始まりと終わりの時刻(ナノ秒)
+		uint64_t beginTime;
+		uint64_t endTime;
+		//入れ子の深さ
+		uint32_t depth;
+		//スレッドの番号
+		uint32_t threadIndex;
+	};
+
+	/// <summary>
+	/// 1フレーム分の計測
+	/// </summary>
+	struct ProfileFrame {
+		//フレームの番号
+		uint64_t frameIndex;
+		//始まりと終わりの時刻(ナノ秒)
+		uint64_t beginTime;
+		uint64_t endTime;
+		//このフレームで閉じた区間
+		std::vector<ProfileZone> zones;
+	};
+
+	/// <summary>
+	/// CPUの処理時間を階層で計測するクラス
+	/// 各スレッドは自分のリングバッファに始まりと終わりを書くだけで、フレームの始めにまとめて区間にする
+	/// 最後のフレームをImGuiで表示し、頼まれたフレーム数をchrome://tracingのJSONで保存する
+	/// </summary>
+	class Profiler final {
+	public:
+		//保存する時の既定のフレーム数
+		static const uint32_t DEFAULT_CAPTURE_FRAME_COUNT_ = 120u;
+		//既定の保存先
+		static constexpr const char* DEFAULT_TRACE_FILE_PATH_ = "ElysiaProfile.json";
+
+	private:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		Profiler() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~Profiler() = default;
+
+	public:
+		/// <summary>
+		/// インスタンスの取得
+		/// </summary>
+		/// <returns>インスタンス</returns>
+		static Profiler* GetInstance();
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// </summary>
+		/// <param name="profiler"></param>
+		Profiler(const Profiler& profiler) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="profiler"></param>
+		/// <returns></returns>
+		Profiler& operator=(const Profiler& profiler) = delete;
+
+	public:
+		/// <summary>
+		/// 今の時刻を取得
+		/// </summary>
+		/// <returns>時刻(ナノ秒)</returns>
+		static inline uint64_t GetTime() {
+			return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		/// <summary>
+		/// このスレッドのリングバッファを取得
+		/// 初めて呼んだ時に登録する
+		/// </summary>
+		/// <returns>リングバッファ</returns>
+		static inline ProfileEventRing* GetThreadRing() {
+			if (threadState_ == nullptr) {
+				threadState_ = GetInstance()->RegisterThread();
+			}
+			return &threadState_->ring;
+		}
+
+		/// <summary>
+		/// このスレッドの名前を付ける
+		/// </summary>
+		/// <param name="name">名前</param>
+		void SetThreadName(const std::string& name);
+
+		/// <summary>
+		/// フレームの区切り
+		/// 全部のスレッドから集めて、前のフレームの計測を閉じる
+		/// </summary>
+		void NewFrame();
+
+		/// <summary>
+		/// 次から指定したフレーム数を保存する
+		/// </summary>
+		/// <param name="frameCount">フレーム数</param>
+		/// <param name="filePath">保存先</param>
+		void RequestCapture(const uint32_t& frameCount, const std::string& filePath);
+
+		/// <summary>
+		/// chrome://tracingで読めるJSONで書き出す
+		/// </summary>
+		/// <param name="filePath">保存先</param>
+		/// <param name="frames">フレーム</param>
+		/// <returns>書けたかどうか</returns>
+		bool WriteChromeTrace(const std::string& filePath, const std::vector<ProfileFrame>& frames);
+
+		/// <summary>
+		/// ImGui表示用
+		/// 最後のフレームを階層ごとに横に並べて表示する
+		/// </summary>
+		void DisplayImGui();
+
+	public:
+		/// <summary>
+		/// 最後に閉じたフレームを取得
+		/// </summary>
+		/// <returns>フレーム</returns>
+		inline const ProfileFrame& GetLastFrame() const {
+			return lastFrame_;
+		}
+
+		/// <summary>
+		/// 保存している途中かどうか
+		/// </summary>
+		/// <returns>途中かどうか</returns>
+		inline bool GetIsCapturing() const {
+			return captureRemainingCount_ > 0u;
+		}
+
+		/// <summary>
+		/// 登録したスレッドの数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		uint32_t GetThreadCount();
+
+		/// <summary>
+		/// スレッドの名前を取得
+		/// </summary>
+		/// <param name="threadIndex">スレッドの番号</param>
+		/// <returns>名前</returns>
+		std::string GetThreadName(const uint32_t& threadIndex);
+
+		/// <summary>
+		/// 全部のスレッドでいっぱいで書けなかった数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		uint64_t GetDroppedCount();
+
+	private:
+		/// <summary>
+		/// スレッドごとの状態
+		/// </summary>
+		struct ThreadState {
+			//リングバッファ
+			ProfileEventRing ring;
+			//名前
+			std::string name;
+			//番号
+			uint32_t threadIndex;
+			//集める側で閉じていない始まり
+			std::vector<ProfileEvent> openEvents;
+		};
+
+		/// <summary>
+		/// 呼んだスレッドを登録する
+		/// </summary>
+		/// <returns>状態</returns>
+		ThreadState* RegisterThread();
+
+	private:
+		//このスレッドの状態
+		static inline thread_local ThreadState* threadState_ = nullptr;
+
+	private:
+		//登録したスレッド
+		//スレッドが終わっても他から指されている可能性があるので消さない
+		std::mutex threadMutex_;
+		std::vector<std::unique_ptr<ThreadState>> threadStates_;
+
+		//集めている途中のフレーム
+		ProfileFrame currentFrame_ = {};
+		//最後に閉じたフレーム
+		ProfileFrame lastFrame_ = {};
+
+		//保存するフレーム
+		std::vector<ProfileFrame> captureFrames_;
+		//残りのフレーム数
+		uint32_t captureRemainingCount_ = 0u;
+		//保存先
+		std::string captureFilePath_;
+
+		//ImGuiの表示を止めるか
+		bool isDisplayPause_ = false;
+		//止めた時のフレーム
+		ProfileFrame pausedFrame_ = {};
+		//ImGuiから保存するフレーム数
+		int32_t displayCaptureFrameCount_ = int32_t(DEFAULT_CAPTURE_FRAME_COUNT_);
+
+	};
+
+	/// <summary>
+	/// スコープを抜けるまでを計測するクラス
+	/// ELYSIA_PROFILE_SCOPEから使う
+	/// </summary>
+	class ProfileScope final {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="name">名前(文字列リテラル)</param>
+		explicit inline ProfileScope(const char* name) : name_(name) {
+			ring_ = Profiler::GetThreadRing();
+			//いっぱいで書けなかったら終わりも書かない
+			if (ring_->PushBegin(name, Profiler::GetTime()) == false) {
+				ring_ = nullptr;
+			}
+		}
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		inline ~ProfileScope() {
+			if (ring_ != nullptr) {
+				ring_->PushEnd(name_, Profiler::GetTime());
+			}
+		}
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// </summary>
+		/// <param name="profileScope"></param>
+		ProfileScope(const ProfileScope& profileScope) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="profileScope"></param>
+		/// <returns></returns>
+		ProfileScope& operator=(const ProfileScope& profileScope) = delete;
+
+	private:
+		//名前
+		const char* name_ = nullptr;
+		//書いたリングバッファ
+		ProfileEventRing* ring_ = nullptr;
+
+	};
+
+}
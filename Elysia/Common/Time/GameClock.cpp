@@ -0,0 +1,68 @@
+#include "GameClock.h"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+Elysia::GameClock* Elysia::GameClock::GetInstance() {
+	static GameClock instance;
+	return &instance;
+}
+
+void Elysia::GameClock::Initialize(const Settings& settings) {
+	assert(settings.fixedDeltaTime > 0.0f && settings.maxFixedStepCount > 0u);
+	settings_ = settings;
+	previousTime_ = std::chrono::steady_clock::now();
+	accumulator_ = 0.0;
+	fixedStepCount_ = 0u;
+	interpolationAlpha_ = 0.0f;
+	deltaTime_ = 0.0f;
+	unscaledDeltaTime_ = 0.0f;
+	fixedStepTotalCount_ = 0u;
+	droppedStepCount_ = 0u;
+	frameCount_ = 0u;
+}
+
+void Elysia::GameClock::Tick() {
+	//前のTickからの実際の時間
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	double realDeltaTime = std::chrono::duration<double>(now - previousTime_).count();
+	previousTime_ = now;
+	Advance(realDeltaTime);
+}
+
+void Elysia::GameClock::Advance(const double& realDeltaTime) {
+	assert(realDeltaTime >= 0.0);
+	++frameCount_;
+	unscaledDeltaTime_ = float(realDeltaTime);
+
+	//止めている時は時間が流れない
+	double scaledDeltaTime = (isPause_ == true) ? 0.0 : realDeltaTime * double(timeScale_);
+	deltaTime_ = float(scaledDeltaTime);
+	accumulator_ += scaledDeltaTime;
+
+	//溜まった時間で何回進めるか
+	//少し足りなくても1回分とみなして、その分は次のフレームで返してもらう
+	double fixedDeltaTime = double(settings_.fixedDeltaTime);
+	double stepCount = std::floor((accumulator_ + STEP_TOLERANCE_) / fixedDeltaTime);
+	accumulator_ -= stepCount * fixedDeltaTime;
+
+	//進めすぎないようにする
+	//捨てた分はゲームの中の時間が遅れる
+	uint64_t wholeStepCount = uint64_t(stepCount);
+	if (wholeStepCount > settings_.maxFixedStepCount) {
+		droppedStepCount_ += wholeStepCount - settings_.maxFixedStepCount;
+		wholeStepCount = settings_.maxFixedStepCount;
+	}
+	fixedStepCount_ = uint32_t(wholeStepCount);
+	fixedStepTotalCount_ += wholeStepCount;
+
+	//最後に進めた時から次までのどこにいるか
+	interpolationAlpha_ = float(std::clamp(accumulator_ / fixedDeltaTime, 0.0, 1.0));
+}
+
+void Elysia::GameClock::SetTimeScale(const float& timeScale) {
+	//逆には流せない
+	assert(timeScale >= 0.0f);
+	timeScale_ = timeScale;
+}
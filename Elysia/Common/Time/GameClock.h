@@ -0,0 +1,253 @@
+#pragma once
+
+/**
+ * @file GameClock.h
+ * @brief ゲームの時間を管理するクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <chrono>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// ゲームの時間を管理するクラス
+	/// 実際のフレームの時間を測って、ゲームの処理を固定の間隔で何回進めるかを決める
+	/// 速い画面では進めないフレームがあり、重いフレームの後は追いつくまで何回か進める
+	/// 時間の流れる速さと一時停止もここで決める
+	/// </summary>
+	class GameClock final {
+	public:
+		/// <summary>
+		/// 設定
+		/// </summary>
+		struct Settings {
+			//固定の間隔(秒)
+			float fixedDeltaTime;
+			//1フレームで進める最大の回数
+			//これを超えた分は捨てる(重すぎる時に追いつこうとしてさらに重くならないように)
+			uint32_t maxFixedStepCount;
+			//目標のフレームレート(0なら待たずに画面の更新に合わせる)
+			float targetFrameRate;
+		};
+
+		//今までと同じ60FPS
+		static constexpr Settings DEFAULT_SETTINGS_ = {
+			.fixedDeltaTime = 1.0f / 60.0f,
+			.maxFixedStepCount = 5u,
+			.targetFrameRate = 60.0f,
+		};
+
+	private:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		GameClock() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~GameClock() = default;
+
+	public:
+		/// <summary>
+		/// インスタンスの取得
+		/// </summary>
+		/// <returns>インスタンス</returns>
+		static GameClock* GetInstance();
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// </summary>
+		/// <param name="gameClock"></param>
+		GameClock(const GameClock& gameClock) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="gameClock"></param>
+		/// <returns></returns>
+		GameClock& operator=(const GameClock& gameClock) = delete;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="settings">設定</param>
+		void Initialize(const Settings& settings);
+
+		/// <summary>
+		/// 1フレーム進める
+		/// 前に呼んだ時からの実際の時間を測る
+		/// </summary>
+		void Tick();
+
+		/// <summary>
+		/// 指定した時間だけ1フレーム進める
+		/// 画面が無いところでは好きなフレームレートで進められる
+		/// </summary>
+		/// <param name="realDeltaTime">実際のフレームの時間(秒)</param>
+		void Advance(const double& realDeltaTime);
+
+		/// <summary>
+		/// 時間の流れる速さの設定
+		/// </summary>
+		/// <param name="timeScale">速さ(1で普通)</param>
+		void SetTimeScale(const float& timeScale);
+
+		/// <summary>
+		/// 一時停止の設定
+		/// 止めている間は固定の間隔で進めない
+		/// </summary>
+		/// <param name="isPause">止めるかどうか</param>
+		inline void SetIsPause(const bool& isPause) {
+			this->isPause_ = isPause;
+		}
+
+		/// <summary>
+		/// 目標のフレームレートの設定
+		/// </summary>
+		/// <param name="targetFrameRate">フレームレート(0なら待たない)</param>
+		inline void SetTargetFrameRate(const float& targetFrameRate) {
+			this->settings_.targetFrameRate = targetFrameRate;
+		}
+
+	public:
+		/// <summary>
+		/// 固定の間隔を取得
+		/// ゲームの処理(当たり判定やタイマー)はこれで進める
+		/// </summary>
+		/// <returns>間隔(秒)</returns>
+		inline float GetFixedDeltaTime() const {
+			return settings_.fixedDeltaTime;
+		}
+
+		/// <summary>
+		/// このフレームで固定の間隔で進める回数を取得
+		/// </summary>
+		/// <returns>回数</returns>
+		inline uint32_t GetFixedStepCount() const {
+			return fixedStepCount_;
+		}
+
+		/// <summary>
+		/// 補間の割合を取得
+		/// 最後に進めた時から次に進めるまでのどこにいるか(0～1)
+		/// WorldTransformとCameraが描画で前の状態と今の状態を補間する時に使う
+		/// </summary>
+		/// <returns>割合</returns>
+		inline float GetInterpolationAlpha() const {
+			return interpolationAlpha_;
+		}
+
+		/// <summary>
+		/// このフレームの時間を取得
+		/// 速さと一時停止が掛かっている
+		/// </summary>
+		/// <returns>時間(秒)</returns>
+		inline float GetDeltaTime() const {
+			return deltaTime_;
+		}
+
+		/// <summary>
+		/// このフレームの実際の時間を取得
+		/// </summary>
+		/// <returns>時間(秒)</returns>
+		inline float GetUnscaledDeltaTime() const {
+			return unscaledDeltaTime_;
+		}
+
+		/// <summary>
+		/// 固定の間隔で進めた時間の合計を取得
+		/// </summary>
+		/// <returns>時間(秒)</returns>
+		inline double GetFixedTime() const {
+			return double(fixedStepTotalCount_) * settings_.fixedDeltaTime;
+		}
+
+		/// <summary>
+		/// 固定の間隔で進めた回数の合計を取得
+		/// </summary>
+		/// <returns>回数</returns>
+		inline uint64_t GetFixedStepTotalCount() const {
+			return fixedStepTotalCount_;
+		}
+
+		/// <summary>
+		/// 追いつけずに捨てた回数の合計を取得
+		/// </summary>
+		/// <returns>回数</returns>
+		inline uint64_t GetDroppedStepCount() const {
+			return droppedStepCount_;
+		}
+
+		/// <summary>
+		/// フレーム数を取得
+		/// </summary>
+		/// <returns>フレーム数</returns>
+		inline uint64_t GetFrameCount() const {
+			return frameCount_;
+		}
+
+		/// <summary>
+		/// 時間の流れる速さを取得
+		/// </summary>
+		/// <returns>速さ</returns>
+		inline float GetTimeScale() const {
+			return timeScale_;
+		}
+
+		/// <summary>
+		/// 一時停止しているかどうか
+		/// </summary>
+		/// <returns>止めているかどうか</returns>
+		inline bool GetIsPause() const {
+			return isPause_;
+		}
+
+		/// <summary>
+		/// 目標のフレームレートを取得
+		/// </summary>
+		/// <returns>フレームレート(0なら待たない)</returns>
+		inline float GetTargetFrameRate() const {
+			return settings_.targetFrameRate;
+		}
+
+	private:
+		//実際の時間とぴったり同じでなくても1回分とみなす誤差(秒)
+		//60Hzの画面で16.6ms前後で揺れても、毎フレーム1回ずつ進めるように
+		static constexpr double STEP_TOLERANCE_ = 0.0005;
+
+	private:
+		//設定
+		Settings settings_ = DEFAULT_SETTINGS_;
+		//前にTickした時間
+		std::chrono::steady_clock::time_point previousTime_ = {};
+		//まだ進めていない時間
+		double accumulator_ = 0.0;
+		//このフレームで進める回数
+		uint32_t fixedStepCount_ = 0u;
+		//補間の割合
+		float interpolationAlpha_ = 0.0f;
+		//このフレームの時間
+		float deltaTime_ = 0.0f;
+		//このフレームの実際の時間
+		float unscaledDeltaTime_ = 0.0f;
+		//時間の流れる速さ
+		float timeScale_ = 1.0f;
+		//一時停止
+		bool isPause_ = false;
+		//固定の間隔で進めた回数の合計
+		uint64_t fixedStepTotalCount_ = 0u;
+		//捨てた回数の合計
+		uint64_t droppedStepCount_ = 0u;
+		//フレーム数
+		uint64_t frameCount_ = 0u;
+
+	};
+
+}
@@ -8,9 +8,14 @@
 #include "Input.h"
 #include "SrvManager.h"
 #include "RtvManager.h"
+#include "ConstantBufferManager.h"
+#include "SpriteBatch.h"
+#include "TextureManager.h"
 #include "Audio.h"
 #include "LevelDataManager.h"
 #include "GlobalVariables.h"
+#include "GameClock.h"
+#include "Profiler.h"
 
 Elysia::Framework::Framework(){
 
@@ -23,6 +28,8 @@ Elysia::Framework::Framework(){
 	srvManager_ = Elysia::SrvManager::GetInstance();
 	//RTV
 	rtvManager_ = Elysia::RtvManager::GetInstance();
+	//定数バッファ
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 	//ImGui管理クラス
 	imGuiManager_ = Elysia::ImGuiManager::GetInstance();
 	//パイプライン
@@ -35,6 +42,10 @@ Elysia::Framework::Framework(){
 	globalVariables_ = Elysia::GlobalVariables::GetInstance();
 	//レベルデータ管理クラス
 	levelDataManager_ = Elysia::LevelDataManager::GetInstance();
+	//ゲームの時間
+	gameClock_ = Elysia::GameClock::GetInstance();
+	//CPUの処理時間の計測
+	profiler_ = Elysia::Profiler::GetInstance();
 
 }
 
@@ -69,6 +80,9 @@ void Elysia::Framework::Initialize(){
 	///DirectX第2の初期化
 	directXSetup_->SecondInitialize();
 
+	//定数バッファの初期化
+	constantBufferManager_->Initialize();
+
 #ifdef _DEBUG
 	//ImGuiManagerの初期化
 	imGuiManager_->Initialize();
@@ -77,13 +91,21 @@ void Elysia::Framework::Initialize(){
 	//パイプラインの初期化
 	pipelineManager_->Initialize();
 
+	//スプライトをまとめて描画するクラスの初期化
+	SpriteBatch::GetInstance()->Initialize();
+
 	//Inputの初期化
 	input_->Initialize();
 	
 	//Audioの初期化
 	audio_->Initialize();
 
+	//計測の表示でメインのスレッドだと分かるようにする
+	ELYSIA_PROFILE_THREAD("メイン");
+
 	//JSON読み込みの初期化
+	//保存は裏のスレッドで書く
+	globalVariables_->Initialize();
 	globalVariables_->LoadAllFile();
 
 	//ゲームシーン管理クラスの生成
@@ -91,50 +113,124 @@ void Elysia::Framework::Initialize(){
 	//初期化
 	gameManager_->Initialize();
 
+	//時間の初期化
+	//読み込みに掛かった時間を最初のフレームに入れないように最後にする
+	gameClock_->Initialize(GameClock::DEFAULT_SETTINGS_);
+
 }
 
 
 #pragma region ゲームループ内の関数
 
 void Elysia::Framework::BeginFrame(){
+
+#if ELYSIA_PROFILER_ENABLE
+	//前のフレームの計測を全部のスレッドから集める
+	//待っている時間もフレームに入れるので最初にする
+	profiler_->NewFrame();
+#endif
+	ELYSIA_PROFILE_SCOPE("Framework::BeginFrame");
 	
+	//次のフレームを始められるまで待つ
+	directXSetup_->WaitForNextFrame();
+
+	//実際に掛かった時間から、このフレームでゲームを何回進めるかを決める
+	gameClock_->Tick();
+
 	//SRVの更新
+	//解放されたものの使い回しとフレームごとの一時的な領域のリセット
+	srvManager_->BeginFrame();
 	srvManager_->PreDraw();
 
+	//定数バッファのフレーム開始
+	constantBufferManager_->BeginFrame();
+
 #ifdef _DEBUG
 	//ImGuiの開始
-	imGuiManager_->BeginFrame();
+	//ゲームを進めないフレームは前の表示をそのまま使う
+	if (gameClock_->GetFixedStepCount() > 0u) {
+		imGuiManager_->BeginFrame();
+	}
 #endif
 }
 
 void Elysia::Framework::Update(){
+	ELYSIA_PROFILE_SCOPE("Framework::Update");
 
-	//グローバル変数の更新
-	globalVariables_->Update();
+	//ゲームは固定の間隔で進める
+	//速い画面では進めないフレームがあり、重いフレームの後は追いつくまで何回か進める
+	uint32_t fixedStepCount = gameClock_->GetFixedStepCount();
+	if (fixedStepCount == 0u) {
+		return;
+	}
+	for (uint32_t i = 0u; i < fixedStepCount; ++i) {
+#ifdef _DEBUG
+		//同じフレームで何回も表示しないように、最後の回の表示だけを残す
+		if (i > 0u) {
+			imGuiManager_->RestartFrame();
+		}
+#endif
 
-	//入力の更新
-	input_->Update();
-	
-	//ゲームシーンの更新
-	gameManager_->Update();
+		//グローバル変数の更新
+		globalVariables_->Update();
+
+		//入力の更新
+		input_->Update();
+
+		//ゲームシーンの更新
+		gameManager_->Update();
+	}
+
+#ifdef _DEBUG
+	//前のフレームの定数バッファの使用量
+	constantBufferManager_->DisplayImGui();
+	//前のフレームのスプライトの描画回数
+	SpriteBatch::GetInstance()->DisplayImGui();
+	//テクスチャのストリーミングの使用量
+	TextureManager::GetInstance()->DisplayStreamingImGui();
+	//前のフレームのCPUの処理時間
+	profiler_->DisplayImGui();
+#endif
+
+#if ELYSIA_PROFILER_ENABLE
+	//ImGuiが無いリリースでもF12で保存出来るようにする
+	if (input_->IsTriggerKey(DIK_F12) == true) {
+		profiler_->RequestCapture(Profiler::DEFAULT_CAPTURE_FRAME_COUNT_, Profiler::DEFAULT_TRACE_FILE_PATH_);
+	}
+#endif
 }
 
 void Elysia::Framework::Draw(){
+	ELYSIA_PROFILE_SCOPE("Framework::Draw");
 	
+	//前のフレームで使われたテクスチャのミップを載せる
+	//記録の前に転送のコマンドを積んでおく
+	TextureManager::GetInstance()->UpdateStreaming();
+
 	//PostEffectの描画前処理
 	gameManager_->PreDrawPostEffectFirst();
 
 	//3Dオブジェクトの描画
+	//パスの中でPushされた描画はパスの終わりに複数のスレッドで記録する
+	directXSetup_->BeginRenderPass();
 	gameManager_->DrawObject3D();
+	directXSetup_->EndRenderPass();
 	
 	//描画始め(スワップチェイン)
 	DirectXSetup::GetInstance()->StartDraw();
 
 	//PostEffectの描画
+	directXSetup_->BeginRenderPass();
 	gameManager_->DrawPostEffect();
+	directXSetup_->EndRenderPass();
 
 	//スプライトの描画
+	//テクスチャとブレンドモードが同じものはまとめて描画する
+	directXSetup_->BeginRenderPass();
+	SpriteBatch::GetInstance()->Begin();
 	gameManager_->DrawSprite();
+	SpriteBatch::GetInstance()->End();
+	directXSetup_->EndRenderPass();
 	
 #ifdef _DEBUG
 	//ImGuiの描画
@@ -145,6 +241,7 @@ void Elysia::Framework::Draw(){
 
 
 void Elysia::Framework::EndFrame() {
+	ELYSIA_PROFILE_SCOPE("Framework::EndFrame");
 
 #ifdef _DEBUG
 	////ImGuiのフレーム終わり
@@ -153,12 +250,21 @@ void Elysia::Framework::EndFrame() {
 	//最後で切り替える
 	directXSetup_->EndDraw();
 
+	//定数バッファのフレーム終わり
+	constantBufferManager_->EndFrame();
+
 }
 #pragma endregion
 
 
 void Elysia::Framework::Finalize() {
 
+	//GPUが描画し終わるまで待つ
+	directXSetup_->Flush();
+
+	//頼まれている調整項目の保存を書き終えてからスレッドを止める
+	globalVariables_->Finalize();
+
 	//レベルエディタの解放
 	levelDataManager_->Finalize();
 
@@ -170,6 +276,9 @@ void Elysia::Framework::Finalize() {
 	imGuiManager_->Finalize();
 #endif
 
+	//定数バッファの解放
+	constantBufferManager_->Finalize();
+
 	//DirectXの解放
 	directXSetup_->Release();
 	
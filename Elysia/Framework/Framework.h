@@ -42,6 +42,11 @@ namespace Elysia {
 	/// </summary>
 	class RtvManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 	/// <summary>
 	/// ImGui管理クラス
 	/// </summary>
@@ -72,6 +77,16 @@ namespace Elysia {
 	/// </summary>
 	class LevelDataManager;
 
+	/// <summary>
+	/// ゲームの時間を管理するクラス
+	/// </summary>
+	class GameClock;
+
+	/// <summary>
+	/// CPUの処理時間を計測するクラス
+	/// </summary>
+	class Profiler;
+
 	/// <summary>
 	/// フレームワーク
 	/// </summary>
@@ -134,6 +149,8 @@ namespace Elysia {
 		SrvManager* srvManager_ = nullptr;
 		//RTV管理クラス
 		RtvManager* rtvManager_ = nullptr;
+		//定数バッファ管理クラス
+		ConstantBufferManager* constantBufferManager_ = nullptr;
 		//ImGui管理クラス
 		ImGuiManager* imGuiManager_ = nullptr;
 		//パイプライン管理クラス
@@ -146,6 +163,10 @@ namespace Elysia {
 		GlobalVariables* globalVariables_ = nullptr;
 		//レベルデータ管理クラス
 		LevelDataManager* levelDataManager_ = nullptr;
+		//ゲームの時間を管理するクラス
+		GameClock* gameClock_ = nullptr;
+		//CPUの処理時間を計測するクラス
+		Profiler* profiler_ = nullptr;
 
 	private:
 		//ゲームの管理クラス
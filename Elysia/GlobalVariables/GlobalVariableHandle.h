@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * @file GlobalVariableHandle.h
+ * @brief 調整項目を直接読むためのハンドル
+ * @author 茂木翼
+ */
+
+#include <cassert>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 調整項目を直接読むためのハンドル
+	/// GlobalVariables::Bindで作る
+	/// 項目の値を指しているので、ImGuiやファイルの読み込みで書き換えた値がそのまま読める
+	/// 毎フレームグループ名とキーで探さなくて良い
+	/// </summary>
+	/// <typeparam name="T">値の型</typeparam>
+	template<typename T>
+	class GlobalVariableHandle final {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		GlobalVariableHandle() = default;
+
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="value">項目の値</param>
+		explicit GlobalVariableHandle(const T* value) : value_(value) {
+		}
+
+	public:
+		/// <summary>
+		/// 値を取得
+		/// </summary>
+		/// <returns>値</returns>
+		inline const T& Get() const {
+			//Bindしてから使ってね
+			assert(value_ != nullptr);
+			return *value_;
+		}
+
+		/// <summary>
+		/// Bindしたかどうか
+		/// </summary>
+		/// <returns>Bindしたかどうか</returns>
+		inline bool GetIsBound() const {
+			return value_ != nullptr;
+		}
+
+	private:
+		//項目の値
+		//std::mapの要素は追加や削除をしても動かないので、ずっと同じ場所を指せる
+		const T* value_ = nullptr;
+
+	};
+
+}
@@ -4,13 +4,45 @@
 
 #include "ImGuiManager.h"
 #include "WindowsSetup.h"
+#include "Profiler.h"
 
 
+Elysia::GlobalVariables::~GlobalVariables(){
+    //Finalizeを呼ばずに終わった時もスレッドを残さない
+    Finalize();
+}
+
 Elysia::GlobalVariables* Elysia::GlobalVariables::GetInstance(){
     static GlobalVariables instance;
     return &instance;
 }
 
+void Elysia::GlobalVariables::Initialize(){
+    assert(saveThread_.joinable() == false);
+    isSaveThreadExit_ = false;
+    saveThread_ = std::thread(&GlobalVariables::RunSaveThread, this);
+}
+
+void Elysia::GlobalVariables::Finalize(){
+    if (saveThread_.joinable() == false) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(saveMutex_);
+        isSaveThreadExit_ = true;
+    }
+    //スレッドは頼まれている保存を全部書いてから止まる
+    saveCondition_.notify_one();
+    saveThread_.join();
+}
+
+void Elysia::GlobalVariables::Flush(){
+    std::unique_lock<std::mutex> lock(saveMutex_);
+    flushCondition_.wait(lock, [this]() {
+        return pendingSaves_.empty() == true && isWriting_ == false;
+    });
+}
+
 void Elysia::GlobalVariables::CreateGroup(const std::string& groupName){
     //指定名のオブジェクトが無ければ追加
     datas_[groupName];
@@ -20,12 +52,10 @@ void Elysia::GlobalVariables::SetValue(const std::string& groupName, const std::
     //グループの参照
     Group& group = datas_[groupName];
     
-    //新しい項目のデータを設定
-    Item newItem{};
-    newItem.value = value;
-
-    //設定した項目をstd::mapに追加
-    group.items[key] = newItem;
+    //項目が無ければ追加して、値を書き込む
+    //Bindしたハンドルが同じ場所を指し続けられるように、項目を作り直さない
+    group.items[key].value = value;
+    ++group.revision;
 
 }
 
@@ -33,12 +63,10 @@ void Elysia::GlobalVariables::SetValue(const std::string& groupName, const std::
     //グループの参照
     Group& group = datas_[groupName];
 
-    //新しい項目のデータを設定
-    Item newItem{};
-    newItem.value = value;
-
-    //設定した項目をstd::mapに追加
-    group.items[key] = newItem;
+    //項目が無ければ追加して、値を書き込む
+    //Bindしたハンドルが同じ場所を指し続けられるように、項目を作り直さない
+    group.items[key].value = value;
+    ++group.revision;
 
 }
 
@@ -46,24 +74,20 @@ void Elysia::GlobalVariables::SetValue(const std::string& groupName, const std::
     //グループの参照
     Group& group = datas_[groupName];
 
-    //新しい項目のデータを設定
-    Item newItem{};
-    newItem.value = value;
-
-    //設定した項目をstd::mapに追加
-    group.items[key] = newItem;
+    //項目が無ければ追加して、値を書き込む
+    //Bindしたハンドルが同じ場所を指し続けられるように、項目を作り直さない
+    group.items[key].value = value;
+    ++group.revision;
 }
 
 void Elysia::GlobalVariables::SetValue(const std::string& groupName, const std::string& key, const Vector3& value){
     //グループの参照
     Group& group = datas_[groupName];
 
-    //新しい項目のデータを設定
-    Item newItem{};
-    newItem.value = value;
-
-    //設定した項目をstd::mapに追加
-    group.items[key] = newItem;
+    //項目が無ければ追加して、値を書き込む
+    //Bindしたハンドルが同じ場所を指し続けられるように、項目を作り直さない
+    group.items[key].value = value;
+    ++group.revision;
 
 }
 
@@ -103,6 +127,11 @@ void Elysia::GlobalVariables::AddItem(const std::string& groupName, const std::s
     if (itItem == itGroup->second.items.end()) {
         SetValue(groupName, key, value);
     }
+    //ファイルに小数点無しで書かれていてintとして読まれていたらfloatに直す
+    else if (std::holds_alternative<int32_t>(itItem->second.value) == true) {
+        itItem->second.value = static_cast<float>(std::get<int32_t>(itItem->second.value));
+        ++group.revision;
+    }
 }
 
 void Elysia::GlobalVariables::AddItem(const std::string& groupName, const std::string& key, const Vector2& value){
@@ -138,76 +167,36 @@ void Elysia::GlobalVariables::AddItem(const std::string& groupName, const std::s
 }
 
 int32_t Elysia::GlobalVariables::GetIntValue(const std::string& groupName, const std::string& key) {
-    //グループを検索
-    std::map<std::string, Group>::iterator itGroup = datas_.find(groupName);
-
-    //無かったら止める
-    assert(itGroup != datas_.end());
-    //参照
-    Group& group = datas_.at(groupName);
-    //キーを検索
-    std::map<std::string, Item>::const_iterator itKey = group.items.find(key);
-    //無かったら止める
-    assert(itKey != group.items.end());
-    //SaveFileより
-    return std::get<int32_t>(itKey->second.value);
-
-
-
+    //項目を探して値を返す
+    return std::get<int32_t>(FindItem(groupName, key).value);
 }
 
 float Elysia::GlobalVariables::GetFloatValue(const std::string& groupName, const std::string& key) {
-    //グループを検索
-    std::map<std::string, Group>::iterator itGroup = datas_.find(groupName);
-
-    //無かったら止める
-    assert(itGroup != datas_.end());
-    //参照
-    Group& group = datas_.at(groupName);
-    //キーを検索
-    std::map<std::string, Item>::const_iterator itKey = group.items.find(key);
-    //無かったら止める
-    assert(itKey != group.items.end());
-    //SaveFileより
-    return std::get<float>(itKey->second.value);
-
+    //項目を探して値を返す
+    return std::get<float>(FindItem(groupName, key).value);
 }
 
 Vector2 Elysia::GlobalVariables::GetVector2Value(const std::string& groupName, const std::string& key){
-
-    //グループを検索
-    std::map<std::string, Group>::iterator itGroup = datas_.find(groupName);
-
-    //無かったら止める
-    assert(itGroup != datas_.end());
-    //参照
-    Group& group = datas_.at(groupName);
-    //キーを検索
-    std::map<std::string, Item>::const_iterator itKey = group.items.find(key);
-    //無かったら止める
-    assert(itKey != group.items.end());
-    //SaveFileより
-    return std::get<Vector2>(itKey->second.value);
-
-
+    //項目を探して値を返す
+    return std::get<Vector2>(FindItem(groupName, key).value);
 }
 
 Vector3 Elysia::GlobalVariables::GetVector3Value(const std::string& groupName, const std::string& key) {
+    //項目を探して値を返す
+    return std::get<Vector3>(FindItem(groupName, key).value);
+}
+
+Elysia::GlobalVariables::Item& Elysia::GlobalVariables::FindItem(const std::string& groupName, const std::string& key){
     //グループを検索
     std::map<std::string, Group>::iterator itGroup = datas_.find(groupName);
-    
     //無かったら止める
     assert(itGroup != datas_.end());
-    //参照
-    Group& group = datas_.at(groupName);
+
     //キーを検索
-    std::map<std::string, Item>::const_iterator itKey = group.items.find(key);
+    std::map<std::string, Item>::iterator itItem = itGroup->second.items.find(key);
     //無かったら止める
-    assert(itKey != group.items.end());
-    //SaveFileより
-    return std::get<Vector3>(itKey->second.value);
-
-
+    assert(itItem != itGroup->second.items.end());
+    return itItem->second;
 }
 
 void Elysia::GlobalVariables::SaveFile(const std::string& groupName){
@@ -217,6 +206,31 @@ void Elysia::GlobalVariables::SaveFile(const std::string& groupName){
     //無かったら止める
     assert(itGroup!=datas_.end());
 
+    //前に保存してから変わっていなければ書かなくて良い
+    //敵が消える度に呼ばれても同じ内容を何度も書かない
+    Group& group = itGroup->second;
+    if (group.revision == group.savedRevision) {
+        return;
+    }
+    group.savedRevision = group.revision;
+
+    //スレッドが無い時はここで書く
+    if (saveThread_.joinable() == false) {
+        WriteFile(groupName, group.items);
+        return;
+    }
+
+    //今の値を写して裏のスレッドに渡す
+    //書く前にまた頼まれたら新しい方だけを書く
+    {
+        std::lock_guard<std::mutex> lock(saveMutex_);
+        pendingSaves_[groupName] = group.items;
+    }
+    saveCondition_.notify_one();
+}
+
+void Elysia::GlobalVariables::WriteFile(const std::string& groupName, const std::map<std::string, Item>& items) const{
+    ELYSIA_PROFILE_SCOPE("GlobalVariables::WriteFile");
     nlohmann::json root;
     //json::objectはstd::mapみたいなもの
     root = nlohmann::json::object();
@@ -225,12 +239,12 @@ void Elysia::GlobalVariables::SaveFile(const std::string& groupName){
     root[groupName] = nlohmann::json::object();
 
     //各項目について
-    for (std::map<std::string, Item>::iterator itItem = itGroup->second.items.begin();
-        itItem != itGroup->second.items.end(); ++itItem) {
+    for (std::map<std::string, Item>::const_iterator itItem = items.begin();
+        itItem != items.end(); ++itItem) {
         //項目名を取得
         const std::string& itemName = itItem->first;
         //項目の参照を取得
-        Item& item = itItem->second;
+        const Item& item = itItem->second;
 
 
         //int32_tの場合
@@ -267,10 +281,12 @@ void Elysia::GlobalVariables::SaveFile(const std::string& groupName){
 
     //書き込むJSONファイルのフルパスを合成する
     std::string filePath = DIRECTORY_PATH_ + groupName + ".json";
+    //先に一時ファイルに書く
+    std::string temporaryFilePath = filePath + ".tmp";
     //書き込む用ファイルストリーム
     std::ofstream ofs;
     //ファイルを書き込み用に開く
-    ofs.open(filePath);
+    ofs.open(temporaryFilePath);
 
     //ファイルを開くのに失敗した場合
     if (ofs.fail()) {
@@ -291,10 +307,47 @@ void Elysia::GlobalVariables::SaveFile(const std::string& groupName){
     //書き込み用に開いたファイルを閉じる。
     ofs.close();
 
+    //書き終わってから置き換える
+    //途中で止まっても前のファイルが壊れずに残る
+    std::error_code errorCode = {};
+    std::filesystem::rename(temporaryFilePath, filePath, errorCode);
+    if (errorCode) {
+        std::string message = "Failed replace data file.";
+        MessageBoxA(nullptr, message.c_str(), "AdjustmentItems", 0u);
+        assert(0);
+    }
+
 
 }
 
+void Elysia::GlobalVariables::RunSaveThread(){
+    ELYSIA_PROFILE_THREAD("調整項目の保存");
+    std::unique_lock<std::mutex> lock(saveMutex_);
+    while (true) {
+        saveCondition_.wait(lock, [this]() {
+            return pendingSaves_.empty() == false || isSaveThreadExit_ == true;
+        });
+        //止める時も頼まれている分は全部書く
+        if (pendingSaves_.empty() == true) {
+            break;
+        }
+
+        //まとめて取り出して、書いている間も頼めるようにロックを外す
+        std::map<std::string, std::map<std::string, Item>> saves;
+        saves.swap(pendingSaves_);
+        isWriting_ = true;
+        lock.unlock();
+        for (const auto& [groupName, items] : saves) {
+            WriteFile(groupName, items);
+        }
+        lock.lock();
+        isWriting_ = false;
+        flushCondition_.notify_all();
+    }
+}
+
 void Elysia::GlobalVariables::LoadAllFile(){
+    ELYSIA_PROFILE_SCOPE("GlobalVariables::LoadAllFile");
     //保存先ディレクトリのパスをローカル変数で宣言する
     std::filesystem::path directory(DIRECTORY_PATH_);
 
@@ -369,12 +422,18 @@ void Elysia::GlobalVariables::LoadFile(const std::string& groupName){
         //アイテム名(キー)を取得
         const std::string& itemName = itItem.key();
     
-        if(itItem->is_number_integer()){
+        //floatの項目に小数点無しで書かれていた場合もfloatとして読む
+        //型が変わるとBindしたハンドルが読めなくなるので
+        std::map<std::string, Item>& items = datas_[groupName].items;
+        std::map<std::string, Item>::iterator itExisting = items.find(itemName);
+        bool isFloatItem = itExisting != items.end() && std::holds_alternative<float>(itExisting->second.value) == true;
+    
+        if(itItem->is_number_integer() && isFloatItem == false){
             //int型の値を登録
             int32_t value = itItem->get<int32_t>();
             SetValue(groupName, itemName, value);
         }
-        else if (itItem->is_number_float()) {
+        else if (itItem->is_number()) {
             //float型の値を登録
             //floatは無いのでその代わりdoubleで
             double value = itItem->get<double>();
@@ -393,6 +452,10 @@ void Elysia::GlobalVariables::LoadFile(const std::string& groupName){
             SetValue(groupName, itemName, value);
         }
     }
+
+    //ファイルと同じ内容なので保存しなくて良い
+    Group& group = datas_[groupName];
+    group.savedRevision = group.revision;
 }
 
 void Elysia::GlobalVariables::Update(){
@@ -437,13 +500,17 @@ void Elysia::GlobalVariables::Update(){
                 //「get」で値を取得
                 //「get_if」でポインタを取得
                 int32_t* ptr = std::get_if<int32_t>(&item.value);
-                ImGui::InputInt(itItemName.c_str(), ptr, 0, 100);
+                if (ImGui::InputInt(itItemName.c_str(), ptr, 0, 100) == true) {
+                    ++group.revision;
+                }
             }
             //float型を持っている場合
             else if (std::holds_alternative<float>(item.value) == true) {
                 //ポインタの取得
                 float* ptr = std::get_if<float>(&item.value);
-                ImGui::InputFloat(itItemName.c_str(), ptr);
+                if (ImGui::InputFloat(itItemName.c_str(), ptr) == true) {
+                    ++group.revision;
+                }
 
             }
             //Vector2型を持っている場合
@@ -451,14 +518,18 @@ void Elysia::GlobalVariables::Update(){
                 //ポインタの取得
                 Vector2* ptr = std::get_if<Vector2>(&item.value);
                 //ここではVector3をfloatの配列ということにする
-                ImGui::InputFloat2(itItemName.c_str(), reinterpret_cast<float*>(ptr));
+                if (ImGui::InputFloat2(itItemName.c_str(), reinterpret_cast<float*>(ptr)) == true) {
+                    ++group.revision;
+                }
             }
             //Vector3型を持っている場合
             else if (std::holds_alternative<Vector3>(item.value)==true) {
                 //ポインタの取得
                 Vector3* ptr = std::get_if<Vector3>(&item.value);
                 //ここではVector3をfloatの配列ということにする
-                ImGui::InputFloat3(itItemName.c_str(), reinterpret_cast<float*>(ptr));
+                if (ImGui::InputFloat3(itItemName.c_str(), reinterpret_cast<float*>(ptr)) == true) {
+                    ++group.revision;
+                }
             }
         }
 
@@ -466,6 +537,8 @@ void Elysia::GlobalVariables::Update(){
         ImGui::Text("\n");
         if (ImGui::Button("Save")==true) {
             SaveFile(groupName);
+            //書き終わってから知らせる
+            Flush();
             std::string message = std::format("{}, json saved.", groupName);
             MessageBoxA(nullptr, message.c_str(), "AdjustmentItems", 0u);
         }
@@ -11,11 +11,15 @@
 #include <string>
 #include <map>
 #include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <json.hpp>
 
 
 #include "Vector3.h"
 #include "Vector2.h"
+#include "GlobalVariableHandle.h"
 
 /// <summary>
 /// ElysiaEngine
@@ -35,7 +39,7 @@ namespace Elysia {
 		/// <summary>
 		/// デストラクタ
 		/// </summary>
-		~GlobalVariables() = default;
+		~GlobalVariables();
 
 
 
@@ -63,6 +67,24 @@ namespace Elysia {
 
 
 	public:
+		/// <summary>
+		/// 初期化
+		/// ファイルを書くスレッドを立てる
+		/// </summary>
+		void Initialize();
+
+		/// <summary>
+		/// 解放
+		/// 頼まれている保存を全部書いてからスレッドを止める
+		/// これより後のSaveFileはその場で書く
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// 頼まれている保存を全部書き終わるまで待つ
+		/// </summary>
+		void Flush();
+
 		/// <summary>
 		/// グループの作成
 		/// </summary>
@@ -189,10 +211,23 @@ namespace Elysia {
 
 #pragma endregion
 
+		/// <summary>
+		/// 項目を直接読むハンドルを作る
+		/// 毎フレーム読む値はGet~Valueで探さずにこれを使ってね
+		/// 項目はAddItemで先に追加しておく
+		/// </summary>
+		/// <typeparam name="T">値の型</typeparam>
+		/// <param name="groupName">グループ名</param>
+		/// <param name="key">キー</param>
+		/// <returns>ハンドル</returns>
+		template<typename T>
+		GlobalVariableHandle<T> Bind(const std::string& groupName, const std::string& key);
 
 
 		/// <summary>
 		/// ファイルに書き出し
+		/// 前に保存してから変わっていなければ何もしない
+		/// 裏のスレッドで書くので、書き終わるのを待つ時はFlushを呼んでね
 		/// </summary>
 		/// <param name="groupName">グループ名</param>
 		void SaveFile(const std::string& groupName);
@@ -232,8 +267,34 @@ namespace Elysia {
 		struct Group {
 			//<キー,値>
 			std::map<std::string, Item>items;
+			//値が変わる度に増やす
+			uint64_t revision = 0u;
+			//保存した時(読み込んだ時)のrevision
+			uint64_t savedRevision = 0u;
 		};
 
+		/// <summary>
+		/// 項目を探す
+		/// 無かったら止める
+		/// </summary>
+		/// <param name="groupName">グループ名</param>
+		/// <param name="key">キー</param>
+		/// <returns>項目</returns>
+		Item& FindItem(const std::string& groupName, const std::string& key);
+
+		/// <summary>
+		/// ファイルに書く
+		/// 一時ファイルに書いてから置き換えるので、途中で止まっても前のファイルが残る
+		/// </summary>
+		/// <param name="groupName">グループ名</param>
+		/// <param name="items">項目</param>
+		void WriteFile(const std::string& groupName, const std::map<std::string, Item>& items) const;
+
+		/// <summary>
+		/// ファイルを書くスレッドで回す
+		/// </summary>
+		void RunSaveThread();
+
 
 	private:
 		//グローバル変数の保存先ファイルパス
@@ -243,8 +304,32 @@ namespace Elysia {
 		//全データ
 		std::map<std::string, Group>datas_;
 
+		//ファイルを書くスレッド
+		std::thread saveThread_;
+		//保存を頼む時
+		std::mutex saveMutex_;
+		//保存を頼んだ
+		std::condition_variable saveCondition_;
+		//書き終わった
+		std::condition_variable flushCondition_;
+		//書く前の保存(同じグループは新しい方だけ残す)
+		std::map<std::string, std::map<std::string, Item>> pendingSaves_;
+		//書いている途中
+		bool isWriting_ = false;
+		//止める
+		bool isSaveThreadExit_ = false;
+
 
 
 	};
 
-};
\ No newline at end of file
+	template<typename T>
+	inline GlobalVariableHandle<T> GlobalVariables::Bind(const std::string& groupName, const std::string& key) {
+		//値のある場所を渡す
+		//型が違ったら止める
+		const T* value = std::get_if<T>(&FindItem(groupName, key).value);
+		assert(value != nullptr);
+		return GlobalVariableHandle<T>(value);
+	}
+
+};
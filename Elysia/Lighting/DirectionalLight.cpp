@@ -2,7 +2,7 @@
 
 void DirectionalLight::Initialize(){
 	//リソースの生成
-	resource = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(DirectionalLightData)).Get();
+	resource.Initialize(sizeof(DirectionalLightData));
 
 	//初期値
 	//ライトの色
@@ -15,15 +15,15 @@ void DirectionalLight::Initialize(){
 }
 
 void DirectionalLight::Update(){
-	//書き込み
-	resource->Map(0u, nullptr, reinterpret_cast<void**>(&directionalLightData_));
+	//書き込みデータ
+	DirectionalLightData directionalLightData = {};
 	//色
-	directionalLightData_->color = color;
+	directionalLightData.color = color;
 	//方向
-	directionalLightData_->direction = direction;
+	directionalLightData.direction = direction;
 	//輝度
-	directionalLightData_->intensity = intensity;
-	//書き込み終了
-	resource->Unmap(0u, nullptr);
+	directionalLightData.intensity = intensity;
+	//書き込み
+	resource.Write(directionalLightData);
 }
 
@@ -8,6 +8,7 @@
 #include "Vector4.h" 
 #include "Vector3.h"
 #include "DirectXSetup.h"
+#include "RingConstantBuffer.h"
 
 /// <summary>
 /// 平行光源データ
@@ -47,12 +48,6 @@ public:
 	float_t intensity=5.0f;
 
 	//定数バッファ
-	ComPtr<ID3D12Resource> resource = nullptr;
-
-
-private:
-
-	//書き込みデータ
-	DirectionalLightData* directionalLightData_ = nullptr;
+	Elysia::RingConstantBuffer resource = {};
 
 };
@@ -2,7 +2,7 @@
 
 void PointLight::Initialize(){
 	//Resource作成
-	resource = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(PointLightData)).Get();
+	resource.Initialize(sizeof(PointLightData));
 
 	//初期値
 	//色
@@ -19,18 +19,18 @@ void PointLight::Initialize(){
 }
 
 void PointLight::Update(){
-	//書き込み
-	resource->Map(0u, nullptr, reinterpret_cast<void**>(&pointLightdata_));
+	//書き込みデータ
+	PointLightData pointLightdata = {};
 	//色
-	pointLightdata_->color = color_;
+	pointLightdata.color = color_;
 	//座標
-	pointLightdata_->position= position_;
+	pointLightdata.position= position_;
 	//輝度
-	pointLightdata_->intensity = intensity_;
+	pointLightdata.intensity = intensity_;
 	//ライトに届く最大距離
-	pointLightdata_->radius = radius_;
+	pointLightdata.radius = radius_;
 	//減衰率
-	pointLightdata_->decay = decay_;
-	//書き込み終了
-	resource->Unmap(0u, nullptr);
+	pointLightdata.decay = decay_;
+	//書き込み
+	resource.Write(pointLightdata);
 }
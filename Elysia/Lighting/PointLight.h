@@ -8,6 +8,7 @@
 #include <Vector4.h>
 #include <Vector3.h>
 #include "DirectXSetup.h"
+#include "RingConstantBuffer.h"
 
 /// <summary>
 /// 点光源のデータ
@@ -60,9 +61,7 @@ public:
 	float_t decay_=5.0f;
 
 	//定数バッファ
-	ComPtr<ID3D12Resource> resource=nullptr;
-	//書き込みデータ
-	PointLightData* pointLightdata_ = nullptr;
+	Elysia::RingConstantBuffer resource = {};
 
 
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 
 void SpotLight::Initialize(){
 	//Resource作成
-	resource = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(SpotLightData)).Get();
+	resource.Initialize(sizeof(SpotLightData));
 
 	//初期値
 	//色
@@ -28,27 +28,27 @@ void SpotLight::Initialize(){
 }
 
 void SpotLight::Update(){
-	//書き込み
-	resource->Map(0u, nullptr, reinterpret_cast<void**>(&data_));
+	//書き込みデータ
+	SpotLightData data = {};
 	//色
-	data_->color = color;
+	data.color = color;
 	//座標
-	data_->position = position;
+	data.position = position;
 	//輝度
-	data_->intensity = intensity;
+	data.intensity = intensity;
 	//方向
-	data_->direction = direction;
+	data.direction = direction;
 	//届く最大距離
-	data_->distance = distance;
+	data.distance = distance;
 	//減衰率
-	data_->decay = decay;
+	data.decay = decay;
 	//Fallowoffを制御する
-	data_->cosFallowoffStart = cosFallowoffStart;
+	data.cosFallowoffStart = cosFallowoffStart;
 	//余弦
-	data_->cosAngle = cosAngle;
+	data.cosAngle = cosAngle;
 	//ライトに当たっていないところの明るさ
-	data_->aroundOffset = aroundOffset;
-	//書き込み終了
-	resource->Unmap(0u, nullptr);
+	data.aroundOffset = aroundOffset;
+	//書き込み
+	resource.Write(data);
 
 }
@@ -8,6 +8,7 @@
 #include "Vector4.h"
 #include "Vector3.h"
 #include "DirectXSetup.h"
+#include "RingConstantBuffer.h"
 
 
  /// <summary>
@@ -77,9 +78,7 @@ public:
 	float_t aroundOffset;
 
 	//定数バッファ
-	ComPtr<ID3D12Resource> resource = nullptr;
-	//書き込みデータ
-	SpotLightData* data_ = nullptr;
+	Elysia::RingConstantBuffer resource = {};
 
 
 };
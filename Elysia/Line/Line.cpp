@@ -11,6 +11,13 @@ Elysia::Line::Line(){
 	pipelineManager_ = Elysia::PipelineManager::GetInstance();
 }
 
+Elysia::Line::~Line() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(vertexResouce_));
+	directXSetup_->DeferRelease(std::move(materialResource_));
+	directXSetup_->DeferRelease(std::move(wvpResource_));
+}
+
 void Elysia::Line::Initialize() {
 
 	//ここでBufferResourceを作る
@@ -87,7 +94,7 @@ void Elysia::Line::Draw(const Vector3& start, const Vector3& end, const Camera&
 	//今回はRootParameter[1]に対してCBVの設定を行っている
 	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, wvpResource_->GetGPUVirtualAddress());
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, camera.GetGPUVirtualAddress());
 	//マテリア
 	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(2u, materialResource_->GetGPUVirtualAddress());
 
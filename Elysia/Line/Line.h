@@ -62,7 +62,7 @@ namespace Elysia {
 		/// <summary>
 		/// デストラクタ
 		/// </summary>
-		~Line() = default;
+		~Line();
 
 	public:
 
@@ -5,9 +5,8 @@
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
-#include <VectorCalculation.h>
-#include "ModelManager.h"
-#include <Calculation/QuaternionCalculation.h>
+#include <cmath>
+#include "Profiler.h"
 
 
 
@@ -17,56 +16,6 @@ AnimationManager* AnimationManager::GetInstance(){
     return &instance;
 }
 
-Vector3 AnimationManager::CalculationValue(const std::vector<KeyFrameVector3>& keyFrames, float time) {
-    //特殊なケースを除外
-    //キーが無いものは✕
-    assert(!keyFrames.empty());
-    //キーが1つか、時刻がキーフレーム前なら最初の値とする
-    if (keyFrames.size() == 1 || time <= keyFrames[0].time) {
-        return keyFrames[0].value;
-    }
-
-    for (size_t index = 0; index < keyFrames.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        //indexとnextIndexの2つのkeyFrameを取得して範囲内に時刻があるかを判定
-        if (keyFrames[index].time <= time && time <= keyFrames[nextIndex].time) {
-            //範囲内を補間する
-            float t = (time - keyFrames[index].time) / (keyFrames[nextIndex].time - keyFrames[index].time);
-            //Vector3 だと線形補間
-            return VectorCalculation::Lerp(keyFrames[index].value, keyFrames[nextIndex].value, t);
-        }
-    }
-
-    //ここまで来た場合は一番後ろの時刻よりも後ろなので最後の値を返すことにする
-    return (*keyFrames.rbegin()).value;
-
-}
-
-Quaternion AnimationManager::CalculationValue(const std::vector<KeyFrameQuaternion>& keyFrames, float time) {
-    //特殊なケースを除外
-    //キーが無いものは✕
-    assert(!keyFrames.empty());
-    //キーが1つか、時刻がキーフレーム前なら最初の値とする
-    if (keyFrames.size() == 1 || time <= keyFrames[0].time) {
-        return keyFrames[0].value;
-    }
-
-    for (size_t index = 0; index < keyFrames.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        //indexとnextIndexの2つのkeyFrameを取得して範囲内に時刻があるかを判定
-        if (keyFrames[index].time <= time && time <= keyFrames[nextIndex].time) {
-            //範囲内を補間する
-            float t = (time - keyFrames[index].time) / (keyFrames[nextIndex].time - keyFrames[index].time);
-            //QuaternionだとSlerp
-            return QuaternionCalculation::QuaternionSlerp(keyFrames[index].value, keyFrames[nextIndex].value, t);
-        }
-    }
-    //ここまで来た場合は一番後ろの時刻よりも後ろなので最後の値を返すことにする
-    return (*keyFrames.rbegin()).value;
-}
-
-
-
 Animation AnimationManager::LoadAnimationFile(const std::string& directoryPath, const std::string& fileName) {
     Animation animation = {};
     Assimp::Importer importer;
@@ -134,6 +83,7 @@ Animation AnimationManager::LoadAnimationFile(const std::string& directoryPath,
 }
 
 uint32_t AnimationManager::LoadFile(const std::string& directoryPath, const std::string& fileName){
+    ELYSIA_PROFILE_SCOPE("AnimationManager::LoadFile");
 
     for (uint32_t i = 0; i < ANIMATION_MAX_AMOUNT_; ++i) {
         if (AnimationManager::GetInstance()->animationInfromtion_[i].directoryPath == directoryPath &&
@@ -162,22 +112,14 @@ uint32_t AnimationManager::LoadFile(const std::string& directoryPath, const std:
 }
 
 void AnimationManager::ApplyAnimation(Skeleton& skeleton, uint32_t animationHandle, uint32_t modelHandle, float animationTime){
-
-
-    Animation animationData = AnimationManager::GetInstance()->animationInfromtion_[animationHandle].animationData;
-    ModelData modelData = Elysia::ModelManager::GetInstance()->GetModelData(modelHandle);
-    for (Joint& joint : skeleton.joints) {
-        //対象のJointのAnimationがあれば、値の適用を行う。下記のif文はC++17から可能になった
-
-        if (auto it = animationData.nodeAnimations.find(joint.name); it != animationData.nodeAnimations.end()) {
-            animationTime = std::fmodf(animationTime, animationData.duration);
-            const NodeAnimation& rootNodeAnimation = (*it).second;
-            joint.transform.translate = CalculationValue(rootNodeAnimation.translate.keyFrames, animationTime);
-            joint.transform.rotate = CalculationValue(rootNodeAnimation.rotate.keyFrames, animationTime);
-            joint.transform.scale = CalculationValue(rootNodeAnimation.scale.keyFrames, animationTime);
-        }
-
-    }
+    ELYSIA_PROFILE_SCOPE("AnimationManager::ApplyAnimation");
+    //モデルの情報は使わない
+    modelHandle;
+
+    //毎回コピーしないように参照で受け取る
+    const Animation& animationData = AnimationManager::GetInstance()->animationInfromtion_[animationHandle].animationData;
+    //ループさせる
+    animationTime = std::fmodf(animationTime, animationData.duration);
+    //計算はAnimationCalculation.cppの方に任せる
+    ::ApplyAnimation(skeleton, animationData, animationTime);
 }
-
-
@@ -62,22 +62,6 @@ private:
 	/// <returns></returns>
 	static Animation LoadAnimationFile(const std::string& directoryPath, const std::string& fileName);
 
-	/// <summary>
-	/// 任意の時刻の値を取得(Vector3版)
-	/// </summary>
-	/// <param name="keyFrames"></param>
-	/// <param name="time"></param>
-	/// <returns></returns>
-	static Vector3 CalculationValue(const std::vector<KeyFrameVector3>& keyFrames, float time);
-
-	/// <summary>
-	///  任意の時刻の値を取得(Quaternion版)
-	/// </summary>
-	/// <param name="keyFrames"></param>
-	/// <param name="time"></param>
-	/// <returns></returns>
-	static Quaternion CalculationValue(const std::vector<KeyFrameQuaternion>& keyFrames, float time);
-
 
 
 public:
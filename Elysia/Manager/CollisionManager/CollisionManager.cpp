@@ -3,6 +3,7 @@
 
 #include "AABB.h"
 #include <CollisionCalculation.h>
+#include "Profiler.h"
 
 void Elysia::CollisionManager::RegisterList(Collider* collider) {
 	//引数から登録
@@ -149,6 +150,7 @@ void Elysia::CollisionManager::CheckPlaneAndPoint(Collider* colliderA, Collider*
 
 
 void Elysia::CollisionManager::CheckAllCollision() {
+	ELYSIA_PROFILE_SCOPE("CollisionManager::CheckAllCollision");
 	//総当たりの判定
 	for (std::list<Collider*>::iterator itrA = colliders_.begin(); itrA != colliders_.end(); ++itrA) {
 
@@ -0,0 +1,146 @@
+#include "ConstantBufferManager.h"
+
+#include <algorithm>
+
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
+
+Elysia::ConstantBufferManager* Elysia::ConstantBufferManager::GetInstance() {
+	static ConstantBufferManager instance;
+	return &instance;
+}
+
+void Elysia::ConstantBufferManager::Initialize() {
+	//DirectXクラスの取得
+	directXSetup_ = DirectXSetup::GetInstance();
+
+	//リングのバッファ
+	CreateRing(FRAME_REGION_SIZE_);
+}
+
+void Elysia::ConstantBufferManager::CreateRing(const size_t& regionSize) {
+	//位置とフェンスの管理
+	//GPUと同時に進めるフレームの数だけ領域を用意する
+	allocator_.Initialize(regionSize, DirectXSetup::FRAME_COUNT_);
+
+	//全フレーム分をまとめて1つのバッファにする
+	resource_ = directXSetup_->CreateBufferResource(allocator_.GetTotalSize());
+	//アップロードバッファなのでずっとMapしたままで良い
+	resource_->Map(0u, nullptr, reinterpret_cast<void**>(&mappedData_));
+	gpuAddress_ = resource_->GetGPUVirtualAddress();
+}
+
+void Elysia::ConstantBufferManager::BeginFrame() {
+	//前のフレームで足りなかったら大きくする
+	//前のバッファはGPUがまだ読んでいるかもしれないので解放待ちに渡す
+	if (requiredRegionSize_ > allocator_.GetRegionSize()) {
+		size_t regionSize = allocator_.GetRegionSize();
+		while (regionSize < requiredRegionSize_) {
+			regionSize *= 2u;
+		}
+		resource_->Unmap(0u, nullptr);
+		directXSetup_->DeferRelease(std::move(resource_));
+		CreateRing(regionSize);
+	}
+	requiredRegionSize_ = 0u;
+	++frameNumber_;
+
+	//次の領域をGPUがまだ読んでいたら終わるまで待つ
+	if (allocator_.BeginFrame(directXSetup_->GetCompletedFenceValue()) == false) {
+		directXSetup_->WaitForFenceValue(directXSetup_->GetFenceValue());
+		if (allocator_.BeginFrame(directXSetup_->GetCompletedFenceValue()) == false) {
+			assert(0);
+		}
+	}
+}
+
+Elysia::ConstantBufferAllocation Elysia::ConstantBufferManager::Allocate(const size_t& size) {
+	size_t offset = allocator_.Allocate(size);
+
+	//足りなかったらこのフレームだけ別のバッファから確保する
+	if (offset == LinearRingAllocator::INVALID_OFFSET_) {
+		return AllocateOverflow(size);
+	}
+
+	ConstantBufferAllocation allocation = {
+		.cpuAddress = mappedData_ + offset,
+		.gpuAddress = gpuAddress_ + offset,
+	};
+	return allocation;
+}
+
+Elysia::ConstantBufferAllocation Elysia::ConstantBufferManager::AllocateOverflow(const size_t& size) {
+	const size_t ALIGNMENT = LinearRingAllocator::CONSTANT_BUFFER_ALIGNMENT_;
+	size_t alignedSize = (size + ALIGNMENT - 1u) & ~(ALIGNMENT - 1u);
+
+	//今のバッファに入らなければ新しく作る
+	if (overflowData_ == nullptr || alignedSize > overflowSize_ - overflowOffset_) {
+		overflowSize_ = std::max(allocator_.GetRegionSize(), alignedSize);
+		ComPtr<ID3D12Resource> resource = directXSetup_->CreateBufferResource(overflowSize_);
+		resource->Map(0u, nullptr, reinterpret_cast<void**>(&overflowData_));
+		overflowGpuAddress_ = resource->GetGPUVirtualAddress();
+		overflowOffset_ = 0u;
+		overflowResources_.push_back(std::move(resource));
+	}
+
+	ConstantBufferAllocation allocation = {
+		.cpuAddress = overflowData_ + overflowOffset_,
+		.gpuAddress = overflowGpuAddress_ + overflowOffset_,
+	};
+	overflowOffset_ += alignedSize;
+	overflowBytes_ += alignedSize;
+	++overflowCount_;
+	return allocation;
+}
+
+void Elysia::ConstantBufferManager::EndFrame() {
+	//足りなかった分を次のフレームで足す
+	if (overflowBytes_ > 0u) {
+		requiredRegionSize_ = allocator_.GetCurrentStatistics().usedBytes + overflowBytes_;
+	}
+
+	//このフレームでSignalした値を記録する
+	allocator_.EndFrame(directXSetup_->GetFenceValue());
+
+	//別のバッファはこのフレームを描画し終わったら解放する
+	for (ComPtr<ID3D12Resource>& resource : overflowResources_) {
+		resource->Unmap(0u, nullptr);
+		directXSetup_->DeferRelease(std::move(resource));
+	}
+	overflowResources_.clear();
+	overflowData_ = nullptr;
+	overflowGpuAddress_ = 0u;
+	overflowOffset_ = 0u;
+	overflowSize_ = 0u;
+	overflowBytes_ = 0u;
+}
+
+void Elysia::ConstantBufferManager::DisplayImGui() {
+#ifdef _DEBUG
+	const LinearRingAllocator::Statistics& statistics = allocator_.GetPreviousStatistics();
+
+	ImGui::Begin("定数バッファ");
+	ImGui::Text("確保数 : %u", statistics.allocationCount);
+	ImGui::Text("使用量 : %zu / %zu バイト", statistics.usedBytes, allocator_.GetRegionSize());
+	ImGui::Text("要求量 : %zu バイト", statistics.requestedBytes);
+	ImGui::Text("最大使用量 : %zu バイト", allocator_.GetPeakUsedBytes());
+	ImGui::Text("失敗数 : %u", statistics.failedCount);
+	ImGui::Text("別のバッファから確保した数 : %u", overflowCount_);
+	ImGui::End();
+#endif
+}
+
+void Elysia::ConstantBufferManager::Finalize() {
+	//Unmapしてから解放
+	if (resource_ != nullptr) {
+		resource_->Unmap(0u, nullptr);
+		resource_.Reset();
+	}
+	mappedData_ = nullptr;
+	for (ComPtr<ID3D12Resource>& resource : overflowResources_) {
+		resource->Unmap(0u, nullptr);
+	}
+	overflowResources_.clear();
+	overflowData_ = nullptr;
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+/**
+ * @file ConstantBufferManager.h
+ * @brief フレームごとに使い捨てる定数バッファの管理クラス
+ * @author 茂木翼
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "DirectXSetup.h"
+#include "LinearRingAllocator.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 確保した定数バッファ
+	/// </summary>
+	struct ConstantBufferAllocation {
+		//書き込み先
+		void* cpuAddress = nullptr;
+		//GPUのアドレス
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0u;
+	};
+
+	/// <summary>
+	/// フレームごとに使い捨てる定数バッファの管理クラス
+	/// 1つのアップロードバッファをMapしたままにしておき、フレームごとの領域から先頭にずらしながら確保する
+	/// 描画のたびに中身が変わる定数はここに書き込む
+	/// 領域が足りない時はそのフレームだけ別のバッファから確保し、次のフレームで領域を大きくする
+	/// </summary>
+	class ConstantBufferManager final {
+	private:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		ConstantBufferManager() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~ConstantBufferManager() = default;
+
+	public:
+		/// <summary>
+		/// インスタンスの取得
+		/// </summary>
+		/// <returns>インスタンス</returns>
+		static ConstantBufferManager* GetInstance();
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// </summary>
+		/// <param name="constantBufferManager"></param>
+		ConstantBufferManager(const ConstantBufferManager& constantBufferManager) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="constantBufferManager"></param>
+		/// <returns></returns>
+		ConstantBufferManager& operator=(const ConstantBufferManager& constantBufferManager) = delete;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		void Initialize();
+
+		/// <summary>
+		/// フレームの開始
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// 確保
+		/// 領域が足りなくても必ず書き込める場所を返す
+		/// </summary>
+		/// <param name="size">大きさ</param>
+		/// <returns>確保した定数バッファ</returns>
+		ConstantBufferAllocation Allocate(const size_t& size);
+
+		/// <summary>
+		/// 確保して書き込む
+		/// </summary>
+		/// <typeparam name="T">定数の型</typeparam>
+		/// <param name="data">定数</param>
+		/// <returns>GPUのアドレス</returns>
+		template<typename T>
+		D3D12_GPU_VIRTUAL_ADDRESS Push(const T& data);
+
+		/// <summary>
+		/// フレームの終了
+		/// DirectXSetupのEndDrawの後に呼ぶ
+		/// </summary>
+		void EndFrame();
+
+		/// <summary>
+		/// ImGui表示用
+		/// </summary>
+		void DisplayImGui();
+
+		/// <summary>
+		/// 解放
+		/// </summary>
+		void Finalize();
+
+	public:
+		/// <summary>
+		/// アロケータの取得
+		/// </summary>
+		/// <returns>アロケータ</returns>
+		inline const LinearRingAllocator& GetAllocator()const {
+			return allocator_;
+		}
+
+		/// <summary>
+		/// 今のフレームの番号を取得
+		/// BeginFrameのたびに1つ増える
+		/// </summary>
+		/// <returns>番号</returns>
+		inline uint64_t GetFrameNumber()const {
+			return frameNumber_;
+		}
+
+		/// <summary>
+		/// 領域が足りずに別のバッファから確保した回数を取得
+		/// </summary>
+		/// <returns>回数</returns>
+		inline uint32_t GetOverflowCount()const {
+			return overflowCount_;
+		}
+
+	private:
+		/// <summary>
+		/// リングのバッファを作る
+		/// </summary>
+		/// <param name="regionSize">1フレーム分の大きさ</param>
+		void CreateRing(const size_t& regionSize);
+
+		/// <summary>
+		/// 領域が足りない時に別のバッファから確保
+		/// </summary>
+		/// <param name="size">大きさ</param>
+		/// <returns>確保した定数バッファ</returns>
+		ConstantBufferAllocation AllocateOverflow(const size_t& size);
+
+	private:
+		//1フレーム分の最初の大きさ(256バイトの定数が4096個)
+		static constexpr size_t FRAME_REGION_SIZE_ = 1024u * 1024u;
+
+	private:
+		//DirectXクラス
+		DirectXSetup* directXSetup_ = nullptr;
+
+		//アップロードバッファ
+		ComPtr<ID3D12Resource> resource_ = nullptr;
+		//Mapしたままの先頭
+		uint8_t* mappedData_ = nullptr;
+		//GPUの先頭
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress_ = 0u;
+
+		//位置とフェンスの管理
+		LinearRingAllocator allocator_ = {};
+		//フレームの番号
+		uint64_t frameNumber_ = 0u;
+
+		//領域が足りなかったフレームで使うバッファ
+		//フレームの終わりに解放待ちに渡す
+		std::vector<ComPtr<ID3D12Resource>> overflowResources_;
+		//今のバッファのMapした先頭
+		uint8_t* overflowData_ = nullptr;
+		//今のバッファのGPUの先頭
+		D3D12_GPU_VIRTUAL_ADDRESS overflowGpuAddress_ = 0u;
+		//今のバッファの中の位置
+		size_t overflowOffset_ = 0u;
+		//今のバッファの大きさ
+		size_t overflowSize_ = 0u;
+		//このフレームで別のバッファから確保したバイト数
+		size_t overflowBytes_ = 0u;
+		//次のフレームで必要な1フレーム分の大きさ
+		size_t requiredRegionSize_ = 0u;
+		//別のバッファから確保した回数
+		uint32_t overflowCount_ = 0u;
+
+	};
+
+}
+
+template<typename T>
+inline D3D12_GPU_VIRTUAL_ADDRESS Elysia::ConstantBufferManager::Push(const T& data){
+	//Mapしたままなのでコピーするだけ
+	ConstantBufferAllocation allocation = Allocate(sizeof(T));
+	std::memcpy(allocation.cpuAddress, &data, sizeof(T));
+	return allocation.gpuAddress;
+}
@@ -0,0 +1,77 @@
+#include "LinearRingAllocator.h"
+
+#include <cassert>
+#include <algorithm>
+
+void Elysia::LinearRingAllocator::Initialize(const size_t& regionSize, const uint32_t& regionCount) {
+	assert(regionCount > 0u);
+	//どの領域の先頭もアライメントが揃うようにする
+	assert(regionSize % CONSTANT_BUFFER_ALIGNMENT_ == 0u);
+
+	regionSize_ = regionSize;
+	regionFenceValues_.assign(regionCount, 0u);
+	currentRegion_ = 0u;
+	offset_ = 0u;
+	isInFrame_ = false;
+	isFirstFrame_ = true;
+	currentStatistics_ = {};
+	previousStatistics_ = {};
+	peakUsedBytes_ = 0u;
+}
+
+bool Elysia::LinearRingAllocator::BeginFrame(const uint64_t& completedFenceValue) {
+	assert(isInFrame_ == false);
+
+	//次の領域
+	uint32_t nextRegion = (isFirstFrame_ == true) ? 0u : (currentRegion_ + 1u) % static_cast<uint32_t>(regionFenceValues_.size());
+
+	//GPUがまだ読んでいる
+	if (regionFenceValues_[nextRegion] > completedFenceValue) {
+		return false;
+	}
+
+	currentRegion_ = nextRegion;
+	offset_ = 0u;
+	isInFrame_ = true;
+	isFirstFrame_ = false;
+	currentStatistics_ = {};
+	return true;
+}
+
+size_t Elysia::LinearRingAllocator::Allocate(const size_t& size, const size_t& alignment) {
+	assert(isInFrame_ == true);
+	//2の累乗であること
+	assert(alignment != 0u && (alignment & (alignment - 1u)) == 0u);
+
+	//位置を揃える
+	size_t alignedOffset = (offset_ + alignment - 1u) & ~(alignment - 1u);
+	//大きさも揃えておくと次の確保で隙間を計算しなくて済む
+	size_t alignedSize = (size + alignment - 1u) & ~(alignment - 1u);
+
+	//入りきらない
+	if (alignedSize > regionSize_ || alignedOffset > regionSize_ - alignedSize) {
+		++currentStatistics_.failedCount;
+		return INVALID_OFFSET_;
+	}
+
+	offset_ = alignedOffset + alignedSize;
+
+	//統計
+	++currentStatistics_.allocationCount;
+	currentStatistics_.usedBytes = offset_;
+	currentStatistics_.requestedBytes += size;
+
+	return static_cast<size_t>(currentRegion_) * regionSize_ + alignedOffset;
+}
+
+void Elysia::LinearRingAllocator::EndFrame(const uint64_t& fenceValue) {
+	assert(isInFrame_ == true);
+
+	//このフェンスをGPUが越えるまで今の領域は使わない
+	regionFenceValues_[currentRegion_] = fenceValue;
+	isInFrame_ = false;
+
+	//統計
+	previousStatistics_ = currentStatistics_;
+	peakUsedBytes_ = std::max(peakUsedBytes_, currentStatistics_.usedBytes);
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file LinearRingAllocator.h
+ * @brief フレームごとの領域を順番に使い回す線形アロケータ
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// フレームごとの領域を順番に使い回す線形アロケータ
+	/// 確保は先頭からずらしていくだけで、解放はフレームの領域ごとまとめて行う
+	/// 位置の計算とフェンスの管理だけを行い、GPUのリソースは持たない
+	/// </summary>
+	class LinearRingAllocator final {
+	public:
+		/// <summary>
+		/// 1フレーム分の統計
+		/// </summary>
+		struct Statistics {
+			//確保した回数
+			uint32_t allocationCount = 0u;
+			//使ったバイト数(アライメントの隙間を含む)
+			size_t usedBytes = 0u;
+			//要求されたバイト数
+			size_t requestedBytes = 0u;
+			//入りきらなかった回数
+			uint32_t failedCount = 0u;
+		};
+
+		//定数バッファのアライメント
+		static constexpr size_t CONSTANT_BUFFER_ALIGNMENT_ = 256u;
+		//確保に失敗した時の値
+		static constexpr size_t INVALID_OFFSET_ = SIZE_MAX;
+
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		LinearRingAllocator() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~LinearRingAllocator() = default;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="regionSize">1フレーム分の大きさ</param>
+		/// <param name="regionCount">フレームの数</param>
+		void Initialize(const size_t& regionSize, const uint32_t& regionCount);
+
+		/// <summary>
+		/// フレームの開始
+		/// 次の領域に切り替える。その領域をまだGPUが使っていたら切り替えずにfalseを返す
+		/// </summary>
+		/// <param name="completedFenceValue">GPUが終わったフェンスの値</param>
+		/// <returns>使い始められたかどうか</returns>
+		bool BeginFrame(const uint64_t& completedFenceValue);
+
+		/// <summary>
+		/// 確保
+		/// </summary>
+		/// <param name="size">大きさ</param>
+		/// <param name="alignment">アライメント(2の累乗)</param>
+		/// <returns>先頭からの位置。入りきらない場合はINVALID_OFFSET_</returns>
+		size_t Allocate(const size_t& size, const size_t& alignment = CONSTANT_BUFFER_ALIGNMENT_);
+
+		/// <summary>
+		/// フレームの終了
+		/// このフェンスの値にGPUがたどり着くまで今の領域は使わない
+		/// </summary>
+		/// <param name="fenceValue">このフレームのフェンスの値</param>
+		void EndFrame(const uint64_t& fenceValue);
+
+	public:
+		/// <summary>
+		/// 今のフレームの領域の番号を取得
+		/// </summary>
+		/// <returns>番号</returns>
+		inline uint32_t GetCurrentRegion()const {
+			return currentRegion_;
+		}
+
+		/// <summary>
+		/// 1フレーム分の大きさを取得
+		/// </summary>
+		/// <returns>大きさ</returns>
+		inline size_t GetRegionSize()const {
+			return regionSize_;
+		}
+
+		/// <summary>
+		/// 全体の大きさを取得
+		/// </summary>
+		/// <returns>大きさ</returns>
+		inline size_t GetTotalSize()const {
+			return regionSize_ * regionFenceValues_.size();
+		}
+
+		/// <summary>
+		/// 今のフレームの統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		inline const Statistics& GetCurrentStatistics()const {
+			return currentStatistics_;
+		}
+
+		/// <summary>
+		/// 前のフレームの統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		inline const Statistics& GetPreviousStatistics()const {
+			return previousStatistics_;
+		}
+
+		/// <summary>
+		/// 1フレームで使った最大のバイト数を取得
+		/// </summary>
+		/// <returns>バイト数</returns>
+		inline size_t GetPeakUsedBytes()const {
+			return peakUsedBytes_;
+		}
+
+		/// <summary>
+		/// フレームの途中かどうか
+		/// </summary>
+		/// <returns>途中かどうか</returns>
+		inline bool GetIsInFrame()const {
+			return isInFrame_;
+		}
+
+	private:
+		//1フレーム分の大きさ
+		size_t regionSize_ = 0u;
+		//領域ごとに最後に使ったフレームのフェンスの値
+		std::vector<uint64_t> regionFenceValues_;
+		//今の領域
+		uint32_t currentRegion_ = 0u;
+		//今の領域の中の位置
+		size_t offset_ = 0u;
+		//フレームの途中かどうか
+		bool isInFrame_ = false;
+		//まだ一度もフレームを始めていないかどうか
+		bool isFirstFrame_ = true;
+
+		//統計
+		Statistics currentStatistics_ = {};
+		Statistics previousStatistics_ = {};
+		size_t peakUsedBytes_ = 0u;
+
+	};
+
+};
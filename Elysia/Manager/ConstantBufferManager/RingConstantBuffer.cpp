@@ -0,0 +1,37 @@
+#include "RingConstantBuffer.h"
+
+#include "ConstantBufferManager.h"
+
+void Elysia::RingConstantBuffer::Initialize(const size_t& sizeInBytes) {
+	latestData_.assign(sizeInBytes, 0u);
+	pushedFrameNumber_ = UINT64_MAX;
+	pushedAddress_ = 0u;
+	isChanged_ = true;
+}
+
+void Elysia::RingConstantBuffer::Write(const void* data, const size_t& sizeInBytes) {
+	assert(sizeInBytes <= latestData_.size());
+	//最新の値を覚えておく
+	//リングへの書き込みは使う時に行う
+	std::memcpy(latestData_.data(), data, sizeInBytes);
+	isChanged_ = true;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS Elysia::RingConstantBuffer::GetGPUVirtualAddress() const {
+	ConstantBufferManager* constantBufferManager = ConstantBufferManager::GetInstance();
+
+	//このフレームで書き込んだ値がそのまま使える
+	uint64_t frameNumber = constantBufferManager->GetFrameNumber();
+	if (pushedFrameNumber_ == frameNumber && isChanged_ == false) {
+		return pushedAddress_;
+	}
+
+	//今のフレームの領域に書き込む
+	//同じフレームで値を変えて描画し直した場合も前の描画の値は残る
+	ConstantBufferAllocation allocation = constantBufferManager->Allocate(latestData_.size());
+	std::memcpy(allocation.cpuAddress, latestData_.data(), latestData_.size());
+	pushedFrameNumber_ = frameNumber;
+	pushedAddress_ = allocation.gpuAddress;
+	isChanged_ = false;
+	return pushedAddress_;
+}
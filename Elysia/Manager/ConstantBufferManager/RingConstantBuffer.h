@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file RingConstantBuffer.h
+ * @brief 使う時にフレームごとの領域へ書き込む定数バッファ
+ * @author 茂木翼
+ */
+
+#include <cstring>
+#include <cstdint>
+#include <vector>
+
+#include "DirectXSetup.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 使う時にフレームごとの領域へ書き込む定数バッファ
+	/// 自分ではGPUのリソースを持たず、最新の値だけを覚えておく
+	/// GPUのアドレスを取得した時にConstantBufferManagerの今のフレームの領域へ書き込むので、
+	/// GPUが前のフレームで読んでいる値を書き換えることは無い
+	/// 同じフレームで値が変わらなければ2回目からは同じアドレスを返す
+	/// </summary>
+	class RingConstantBuffer final {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		RingConstantBuffer() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~RingConstantBuffer() = default;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="sizeInBytes">大きさ</param>
+		void Initialize(const size_t& sizeInBytes);
+
+		/// <summary>
+		/// 書き込み
+		/// </summary>
+		/// <param name="data">データ</param>
+		/// <param name="sizeInBytes">大きさ</param>
+		void Write(const void* data, const size_t& sizeInBytes);
+
+		/// <summary>
+		/// 書き込み
+		/// </summary>
+		/// <typeparam name="T">データの型</typeparam>
+		/// <param name="data">データ</param>
+		template<typename T>
+		inline void Write(const T& data) {
+			Write(&data, sizeof(T));
+		}
+
+		/// <summary>
+		/// 今のフレームで使うGPUのアドレスを取得
+		/// このフレームでまだ書き込んでいなければ領域を確保して書き込む
+		/// </summary>
+		/// <returns>アドレス</returns>
+		D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const;
+
+	public:
+		/// <summary>
+		/// 初期化済みかどうか
+		/// </summary>
+		/// <returns>初期化済みかどうか</returns>
+		inline bool GetIsInitialized()const {
+			return latestData_.empty() == false;
+		}
+
+	private:
+		//最新の値
+		std::vector<uint8_t> latestData_ = {};
+		//最後に書き込んだフレームの番号
+		mutable uint64_t pushedFrameNumber_ = UINT64_MAX;
+		//最後に書き込んだアドレス
+		mutable D3D12_GPU_VIRTUAL_ADDRESS pushedAddress_ = 0u;
+		//書き込んだ後に値が変わったかどうか
+		mutable bool isChanged_ = true;
+
+	};
+}
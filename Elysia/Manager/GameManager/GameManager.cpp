@@ -4,6 +4,7 @@
 
 #include "GameSceneFactory.h"
 #include <vector>
+#include "Profiler.h"
 
 
 void Elysia::GameManager::Initialize() {
@@ -82,11 +83,13 @@ void Elysia::GameManager::Update() {
 }
 
 void Elysia::GameManager::DrawObject3D() {
+	ELYSIA_PROFILE_SCOPE("GameManager::DrawObject3D");
 	//3Dオブジェクトの描画
 	currentGamaScene_->DrawObject3D();
 }
 
 void Elysia::GameManager::DrawSprite(){
+	ELYSIA_PROFILE_SCOPE("GameManager::DrawSprite");
 	//スプライトの描画
 	currentGamaScene_->DrawSprite();
 }
@@ -98,6 +101,7 @@ void Elysia::GameManager::PreDrawPostEffectFirst(){
 
 
 void Elysia::GameManager::DrawPostEffect(){
+	ELYSIA_PROFILE_SCOPE("GameManager::DrawPostEffect");
 	//ポストエフェクト描画前
 	currentGamaScene_->DrawPostEffect();
 }
@@ -47,15 +47,27 @@ void Elysia::ImGuiManager::BeginFrame() {
 	ImGui_ImplDX12_NewFrame();
 	ImGui_ImplWin32_NewFrame();
 	ImGui::NewFrame();
+	isFrameBegun_ = true;
 
 }
 
+void Elysia::ImGuiManager::RestartFrame() {
+	assert(isFrameBegun_ == true);
+	//描画せずに閉じて始め直す
+	ImGui::EndFrame();
+	ImGui::NewFrame();
+}
+
 
 
 
 void Elysia::ImGuiManager::Draw() {
 	//描画
-	ImGui::Render();
+	//始めていないフレームは前のものをそのまま使う
+	if (isFrameBegun_ == true) {
+		ImGui::Render();
+		isFrameBegun_ = false;
+	}
 
 	//描画用のDescriptorの設定
 	ID3D12DescriptorHeap* descriptorHeaps[] = { SrvManager::GetInstance()->GetSrvDescriptorHeap().Get() };
@@ -66,7 +78,10 @@ void Elysia::ImGuiManager::Draw() {
 void Elysia::ImGuiManager::EndDraw() {
 	//コマンドを積む
 	//実際のcommandListのImGuiの描画コマンドを積む
-	ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), DirectXSetup::GetInstance()->GetCommandList().Get());
+	ImDrawData* drawData = ImGui::GetDrawData();
+	if (drawData != nullptr) {
+		ImGui_ImplDX12_RenderDrawData(drawData, DirectXSetup::GetInstance()->GetCommandList().Get());
+	}
 }
 
 
@@ -57,9 +57,16 @@ namespace Elysia {
 
 		/// <summary>
 		/// フレーム開始
+		/// 呼ばなかったフレームは前に作った表示をそのまま描画する
 		/// </summary>
 		void BeginFrame();
 
+		/// <summary>
+		/// フレームをやり直す
+		/// 1フレームでゲームを何回か進める時、最後の回の表示だけを残す
+		/// </summary>
+		void RestartFrame();
+
 		/// <summary>
 		/// 描画
 		/// </summary>
@@ -75,6 +82,10 @@ namespace Elysia {
 		/// </summary>
 		void Finalize();
 
+	private:
+		//このフレームでBeginFrameを呼んだか
+		bool isFrameBegun_ = false;
+
 	};
 
 };
@@ -0,0 +1,310 @@
+#include "LevelDataBinary.h"
+
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+
+#include "MappedFile.h"
+#include "LevelDataParser.h"
+
+namespace {
+
+	/// <summary>
+	/// 書き出し用の文字列の表
+	/// 同じ文字列は1つにまとめる
+	/// </summary>
+	class StringTableBuilder {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// 0番は空文字にしておく
+		/// </summary>
+		StringTableBuilder() {
+			Add({});
+		}
+
+		/// <summary>
+		/// 追加
+		/// </summary>
+		/// <param name="text">文字列</param>
+		/// <returns>番号</returns>
+		uint32_t Add(const std::string_view& text) {
+			auto it = indices_.find(std::string(text));
+			if (it != indices_.end()) {
+				return it->second;
+			}
+
+			uint32_t index = static_cast<uint32_t>(strings_.size());
+			strings_.push_back({ .offset = static_cast<uint32_t>(data_.size()),.length = static_cast<uint32_t>(text.size()) });
+			data_.append(text);
+			indices_.emplace(std::string(text), index);
+			return index;
+		}
+
+		/// <summary>
+		/// 文字列の表の取得
+		/// </summary>
+		/// <returns>表</returns>
+		inline const std::vector<LevelDataBinary::FileString>& GetStrings()const {
+			return strings_;
+		}
+
+		/// <summary>
+		/// 文字列本体の取得
+		/// </summary>
+		/// <returns>文字列本体</returns>
+		inline const std::string& GetData()const {
+			return data_;
+		}
+
+	private:
+		//文字列の表
+		std::vector<LevelDataBinary::FileString> strings_;
+		//文字列本体
+		std::string data_;
+		//文字列から番号を引く
+		std::unordered_map<std::string, uint32_t> indices_;
+	};
+
+	/// <summary>
+	/// 8バイト境界に揃える
+	/// </summary>
+	/// <param name="value">値</param>
+	/// <returns>揃えた値</returns>
+	inline uint32_t AlignTo8(const uint32_t& value) {
+		return (value + 7u) & ~7u;
+	}
+}
+
+std::string LevelDataBinary::GetCookedFilePath(const std::string& jsonFilePath) {
+	std::filesystem::path path = jsonFilePath;
+	path.replace_extension(EXTENSION);
+	return path.string();
+}
+
+bool LevelDataBinary::IsCookedFileUpToDate(const std::string& jsonFilePath, const std::string& cookedFilePath) {
+	std::error_code errorCode;
+
+	//クックしたファイルが無い
+	if (std::filesystem::exists(cookedFilePath, errorCode) == false) {
+		return false;
+	}
+
+	//JSONの方が新しい
+	auto jsonWriteTime = std::filesystem::last_write_time(jsonFilePath, errorCode);
+	if (errorCode) {
+		return false;
+	}
+	auto cookedWriteTime = std::filesystem::last_write_time(cookedFilePath, errorCode);
+	if (errorCode || cookedWriteTime < jsonWriteTime) {
+		return false;
+	}
+
+	//JSONのサイズが違う
+	//チェックアウトなどで更新日時が当てにならない場合の保険
+	uintmax_t jsonFileSize = std::filesystem::file_size(jsonFilePath, errorCode);
+	if (errorCode) {
+		return false;
+	}
+	std::ifstream file(cookedFilePath, std::ios::binary);
+	FileHeader header = {};
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader))) {
+		return false;
+	}
+	return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+		header.version == VERSION &&
+		header.sourceFileSize == static_cast<uint64_t>(jsonFileSize);
+}
+
+bool LevelDataBinary::Write(const std::string& cookedFilePath, const std::vector<Elysia::LevelObjectData>& objectDatas, const uint64_t& sourceFileSize) {
+
+	//オブジェクトの表を作る
+	StringTableBuilder stringTable;
+	std::vector<FileObject> fileObjects;
+	fileObjects.reserve(objectDatas.size());
+	for (const Elysia::LevelObjectData& objectData : objectDatas) {
+		//フラグ
+		uint32_t flags = 0u;
+		if (objectData.isHavingCollider == true) {
+			flags |= HavingCollider;
+		}
+		if (objectData.isInvisible == true) {
+			flags |= Invisible;
+		}
+		if (objectData.levelAudioData.isLoop == true) {
+			flags |= AudioLoop;
+		}
+		if (objectData.levelAudioData.isOnArea == true) {
+			flags |= AudioOnArea;
+		}
+
+		fileObjects.push_back({
+			.nameIndex = stringTable.Add(objectData.name),
+			.modelFileNameIndex = stringTable.Add(objectData.modelFileName),
+			.typeIndex = stringTable.Add(objectData.type),
+			.colliderTypeIndex = stringTable.Add(objectData.colliderType),
+			.audioTypeIndex = stringTable.Add(objectData.levelAudioData.type),
+			.audioFileNameIndex = stringTable.Add(objectData.levelAudioData.fileName),
+			.flags = flags,
+			.scale = objectData.transform.scale,
+			.rotate = objectData.transform.rotate,
+			.translate = objectData.transform.translate,
+			.center = objectData.center,
+			.size = objectData.size,
+			.upSize = objectData.upSize,
+			.downSize = objectData.downSize,
+		});
+	}
+
+	//配置を決める
+	//[ヘッダー][オブジェクトの表][文字列の表][文字列本体]
+	FileHeader header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.sourceFileSize = sourceFileSize;
+	header.objectCount = static_cast<uint32_t>(fileObjects.size());
+	header.stringCount = static_cast<uint32_t>(stringTable.GetStrings().size());
+	header.objectTableOffset = AlignTo8(static_cast<uint32_t>(sizeof(FileHeader)));
+	header.stringTableOffset = AlignTo8(header.objectTableOffset + header.objectCount * static_cast<uint32_t>(sizeof(FileObject)));
+	header.stringDataOffset = AlignTo8(header.stringTableOffset + header.stringCount * static_cast<uint32_t>(sizeof(FileString)));
+	header.stringDataSize = static_cast<uint32_t>(stringTable.GetData().size());
+
+	//まとめて書き出す
+	std::vector<char> buffer(static_cast<size_t>(header.stringDataOffset) + header.stringDataSize, 0);
+	std::memcpy(buffer.data(), &header, sizeof(FileHeader));
+	if (fileObjects.empty() == false) {
+		std::memcpy(buffer.data() + header.objectTableOffset, fileObjects.data(), fileObjects.size() * sizeof(FileObject));
+	}
+	std::memcpy(buffer.data() + header.stringTableOffset, stringTable.GetStrings().data(), stringTable.GetStrings().size() * sizeof(FileString));
+	if (header.stringDataSize > 0u) {
+		std::memcpy(buffer.data() + header.stringDataOffset, stringTable.GetData().data(), header.stringDataSize);
+	}
+
+	//途中で読まれても壊れないように一時ファイルに書いてから置き換える
+	std::string temporaryFilePath = cookedFilePath + ".tmp";
+	{
+		std::ofstream file(temporaryFilePath, std::ios::binary | std::ios::trunc);
+		if (!file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+			return false;
+		}
+	}
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryFilePath, cookedFilePath, errorCode);
+	return !errorCode;
+}
+
+bool LevelDataBinary::Read(const std::string& cookedFilePath, std::vector<Elysia::LevelObjectData>& objectDatas, Elysia::StringInterner& stringInterner) {
+
+	//メモリマップで開く
+	Elysia::MappedFile mappedFile;
+	if (mappedFile.Open(cookedFilePath) == false) {
+		return false;
+	}
+	const uint8_t* data = mappedFile.GetData();
+	const size_t fileSize = mappedFile.GetSize();
+
+	//ヘッダーの確認
+	if (fileSize < sizeof(FileHeader)) {
+		return false;
+	}
+	FileHeader header = {};
+	std::memcpy(&header, data, sizeof(FileHeader));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+		return false;
+	}
+
+	//範囲外を読まないように確認
+	const uint64_t objectTableEnd = static_cast<uint64_t>(header.objectTableOffset) + static_cast<uint64_t>(header.objectCount) * sizeof(FileObject);
+	const uint64_t stringTableEnd = static_cast<uint64_t>(header.stringTableOffset) + static_cast<uint64_t>(header.stringCount) * sizeof(FileString);
+	const uint64_t stringDataEnd = static_cast<uint64_t>(header.stringDataOffset) + header.stringDataSize;
+	if (objectTableEnd > fileSize || stringTableEnd > fileSize || stringDataEnd > fileSize ||
+		header.objectTableOffset % alignof(FileObject) != 0u || header.stringTableOffset % alignof(FileString) != 0u) {
+		return false;
+	}
+
+	//そのまま表として使う
+	const FileObject* fileObjects = reinterpret_cast<const FileObject*>(data + header.objectTableOffset);
+	const FileString* fileStrings = reinterpret_cast<const FileString*>(data + header.stringTableOffset);
+	const char* stringData = reinterpret_cast<const char*>(data + header.stringDataOffset);
+
+	//文字列の範囲も確認
+	for (uint32_t i = 0u; i < header.stringCount; ++i) {
+		if (static_cast<uint64_t>(fileStrings[i].offset) + fileStrings[i].length > header.stringDataSize) {
+			return false;
+		}
+	}
+
+	//番号から文字列を取得
+	auto getString = [&](const uint32_t& index, std::string_view& result) {
+		if (index >= header.stringCount) {
+			return false;
+		}
+		result = std::string_view(stringData + fileStrings[index].offset, fileStrings[index].length);
+		return true;
+	};
+
+	objectDatas.clear();
+	objectDatas.reserve(header.objectCount);
+	for (uint32_t i = 0u; i < header.objectCount; ++i) {
+		const FileObject& fileObject = fileObjects[i];
+
+		std::string_view name = {};
+		std::string_view modelFileName = {};
+		std::string_view type = {};
+		std::string_view colliderType = {};
+		std::string_view audioType = {};
+		std::string_view audioFileName = {};
+		if (getString(fileObject.nameIndex, name) == false ||
+			getString(fileObject.modelFileNameIndex, modelFileName) == false ||
+			getString(fileObject.typeIndex, type) == false ||
+			getString(fileObject.colliderTypeIndex, colliderType) == false ||
+			getString(fileObject.audioTypeIndex, audioType) == false ||
+			getString(fileObject.audioFileNameIndex, audioFileName) == false) {
+			objectDatas.clear();
+			return false;
+		}
+
+		objectDatas.emplace_back(Elysia::LevelObjectData{});
+		Elysia::LevelObjectData& objectData = objectDatas.back();
+		objectData.name = name;
+		objectData.modelFileName = modelFileName;
+		objectData.type = stringInterner.Intern(type);
+		objectData.colliderType = stringInterner.Intern(colliderType);
+		objectData.transform = {
+			.scale = fileObject.scale,
+			.rotate = fileObject.rotate,
+			.translate = fileObject.translate,
+		};
+		objectData.initialTransform = objectData.transform;
+		objectData.isHavingCollider = (fileObject.flags & HavingCollider) != 0u;
+		objectData.isInvisible = (fileObject.flags & Invisible) != 0u;
+		objectData.center = fileObject.center;
+		objectData.size = fileObject.size;
+		objectData.upSize = fileObject.upSize;
+		objectData.downSize = fileObject.downSize;
+		objectData.levelAudioData.type = audioType;
+		objectData.levelAudioData.fileName = audioFileName;
+		objectData.levelAudioData.isLoop = (fileObject.flags & AudioLoop) != 0u;
+		objectData.levelAudioData.isOnArea = (fileObject.flags & AudioOnArea) != 0u;
+	}
+
+	return true;
+}
+
+bool LevelDataBinary::Cook(const std::string& jsonFilePath) {
+	//JSONを読み込む
+	Elysia::StringInterner stringInterner;
+	std::vector<Elysia::LevelObjectData> objectDatas;
+	if (LevelDataParser::ParseWithSax(jsonFilePath, objectDatas, stringInterner) == false) {
+		return false;
+	}
+
+	//書き出し
+	std::error_code errorCode;
+	uintmax_t jsonFileSize = std::filesystem::file_size(jsonFilePath, errorCode);
+	if (errorCode) {
+		return false;
+	}
+	return Write(GetCookedFilePath(jsonFilePath), objectDatas, static_cast<uint64_t>(jsonFileSize));
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+/**
+ * @file LevelDataBinary.h
+ * @brief レベルデータのバイナリ形式(.lvl)
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Vector3.h"
+#include "LevelObjectData.h"
+#include "StringInterner.h"
+
+/// <summary>
+/// レベルデータのバイナリ形式(.lvl)
+/// JSONを事前に変換(クック)しておき、読み込み時は解析せずにそのまま使う
+/// </summary>
+namespace LevelDataBinary {
+
+	//ファイルの識別子
+	const char MAGIC[4] = { 'E','L','V','L' };
+	//バージョン
+	//形式を変えたら上げてね
+	const uint32_t VERSION = 1u;
+	//拡張子
+	const char EXTENSION[] = ".lvl";
+
+	/// <summary>
+	/// フラグ
+	/// </summary>
+	enum ObjectFlag : uint32_t {
+		//コライダーを持っている
+		HavingCollider = 1u << 0u,
+		//非表示
+		Invisible = 1u << 1u,
+		//オーディオのループ
+		AudioLoop = 1u << 2u,
+		//オーディオがエリア上
+		AudioOnArea = 1u << 3u,
+	};
+
+	/// <summary>
+	/// ヘッダー
+	/// </summary>
+	struct FileHeader {
+		//識別子
+		char magic[4];
+		//バージョン
+		uint32_t version;
+		//元のJSONのサイズ
+		//クックした後にJSONが変わっていないかの確認に使う
+		uint64_t sourceFileSize;
+		//オブジェクト数
+		uint32_t objectCount;
+		//文字列の数
+		uint32_t stringCount;
+		//オブジェクトの表の位置
+		uint32_t objectTableOffset;
+		//文字列の表の位置
+		uint32_t stringTableOffset;
+		//文字列本体の位置
+		uint32_t stringDataOffset;
+		//文字列本体のサイズ
+		uint32_t stringDataSize;
+	};
+
+	/// <summary>
+	/// オブジェクト1つ分
+	/// 文字列は全て文字列の表の番号で持つ
+	/// </summary>
+	struct FileObject {
+		//名前
+		uint32_t nameIndex;
+		//モデルのファイル名
+		uint32_t modelFileNameIndex;
+		//オブジェクトのタイプ
+		uint32_t typeIndex;
+		//コライダーの種類
+		uint32_t colliderTypeIndex;
+		//オーディオの種類
+		uint32_t audioTypeIndex;
+		//オーディオのファイル名
+		uint32_t audioFileNameIndex;
+		//フラグ
+		uint32_t flags;
+
+		//トランスフォーム
+		Vector3 scale;
+		Vector3 rotate;
+		Vector3 translate;
+
+		//コライダー
+		Vector3 center;
+		Vector3 size;
+		Vector3 upSize;
+		Vector3 downSize;
+	};
+
+	/// <summary>
+	/// 文字列の表の1要素
+	/// </summary>
+	struct FileString {
+		//文字列本体の先頭からの位置
+		uint32_t offset;
+		//長さ
+		uint32_t length;
+	};
+
+	static_assert(sizeof(FileHeader) == 40u, "FileHeaderのサイズが変わっています");
+	static_assert(sizeof(FileObject) == 112u, "FileObjectのサイズが変わっています");
+	static_assert(sizeof(FileString) == 8u, "FileStringのサイズが変わっています");
+
+	/// <summary>
+	/// JSONのパスからクックしたファイルのパスを作る
+	/// </summary>
+	/// <param name="jsonFilePath">JSONのパス</param>
+	/// <returns>クックしたファイルのパス</returns>
+	std::string GetCookedFilePath(const std::string& jsonFilePath);
+
+	/// <summary>
+	/// クックしたファイルを使えるかどうか
+	/// JSONより新しく、JSONのサイズが一致している場合だけ使う
+	/// </summary>
+	/// <param name="jsonFilePath">JSONのパス</param>
+	/// <param name="cookedFilePath">クックしたファイルのパス</param>
+	/// <returns>使えるかどうか</returns>
+	bool IsCookedFileUpToDate(const std::string& jsonFilePath, const std::string& cookedFilePath);
+
+	/// <summary>
+	/// 書き出し
+	/// </summary>
+	/// <param name="cookedFilePath">書き出し先</param>
+	/// <param name="objectDatas">オブジェクトデータ</param>
+	/// <param name="sourceFileSize">元のJSONのサイズ</param>
+	/// <returns>書き出せたかどうか</returns>
+	bool Write(const std::string& cookedFilePath, const std::vector<Elysia::LevelObjectData>& objectDatas, const uint64_t& sourceFileSize);
+
+	/// <summary>
+	/// 読み込み
+	/// メモリマップしてそのまま読むので解析はしない
+	/// </summary>
+	/// <param name="cookedFilePath">クックしたファイルのパス</param>
+	/// <param name="objectDatas">オブジェクトデータ</param>
+	/// <param name="stringInterner">タイプ名の登録先</param>
+	/// <returns>読み込めたかどうか</returns>
+	bool Read(const std::string& cookedFilePath, std::vector<Elysia::LevelObjectData>& objectDatas, Elysia::StringInterner& stringInterner);
+
+	/// <summary>
+	/// クック
+	/// JSONを読み込んでバイナリで書き出す
+	/// </summary>
+	/// <param name="jsonFilePath">JSONのパス</param>
+	/// <returns>書き出せたかどうか</returns>
+	bool Cook(const std::string& jsonFilePath);
+
+};
@@ -1,9 +1,9 @@
 #include "LevelDataManager.h"
 
 #include <cassert>
-#include <numbers>
 #include <filesystem>
 #include <iostream>
+#include <algorithm>
 
 #include "ModelManager.h"
 #include "Camera.h"
@@ -12,12 +12,29 @@
 #include "PointLight.h"
 #include "SpotLight.h"
 #include "Audio.h"
+#include "ConstantBufferManager.h"
+#include "LevelDataParser.h"
+#include "LevelDataBinary.h"
+#include "LevelObjectDiff.h"
 
 #include "Model/AudioObjectForLevelEditor.h"
 #include "Model/StageObjectForLevelEditor.h"
 #include <StringOption.h>
+#include "Profiler.h"
+
+namespace {
+
+	/// <summary>
+	/// 同じかどうか
+	/// </summary>
+	/// <param name="v1">ベクトル1</param>
+	/// <param name="v2">ベクトル2</param>
+	/// <returns>同じかどうか</returns>
+	bool IsSame(const Vector3& v1, const Vector3& v2) {
+		return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z;
+	}
 
-
+}
 
 Elysia::LevelDataManager::LevelDataManager() {
 	//オーディオのインスタンスを取得
@@ -30,192 +47,30 @@ Elysia::LevelDataManager* Elysia::LevelDataManager::GetInstance() {
 	return &instance;
 }
 
-void Elysia::LevelDataManager::Place(nlohmann::json& objects, LevelData& levelData) {
-
-	//"objects"の全オブジェクトを走査
-	for (nlohmann::json& object : objects) {
-		//各オブジェクトに必ずtypeが入っているよ
-		assert(object.contains("type"));
-
-		//種別を取得
-		std::string type = object["type"].get<std::string>();
-
-		//種類ごとの処理
-		//MESHの場合
-		if (type.compare("MESH") == 0) {
-			//要素追加
-			levelData.objectDatas.emplace_back(ObjectData{});
-			//今追加した要素の参照を得る
-			ObjectData& objectData = levelData.objectDatas.back();
-
-
-			if (object.contains("name")) {
-				objectData.name = object["name"];
-			}
-
-			//ここでのファイルネームはオブジェクトの名前
-			if (object.contains("file_name")) {
-				//ファイル名
-				objectData.modelFileName = object["file_name"];
-			}
-
-			//トランスフォームのパラメータ読み込み
-			nlohmann::json& transform = object["transform"];
-
-			//スケール
-			objectData.transform.scale.x = static_cast<float>(transform["scaling"][0]);
-			objectData.transform.scale.y = static_cast<float>(transform["scaling"][2]);
-			objectData.transform.scale.z = static_cast<float>(transform["scaling"][1]);
-			//初期スケール
-			objectData.initialTransform.scale.x = static_cast<float>(transform["scaling"][0]);
-			objectData.initialTransform.scale.y = static_cast<float>(transform["scaling"][2]);
-			objectData.initialTransform.scale.z = static_cast<float>(transform["scaling"][1]);
-
-
-
-			//回転角
-			//そういえばBlenderは度数法だったね
-			//弧度法に直そう
-			const float DEREES_TO_RADIUS_ = static_cast<float>(std::numbers::pi) / 180.0f;
-			objectData.transform.rotate.x = -static_cast<float>(transform["rotation"][0]) * DEREES_TO_RADIUS_;
-			objectData.transform.rotate.y = -static_cast<float>(transform["rotation"][2]) * DEREES_TO_RADIUS_;
-			objectData.transform.rotate.z = -static_cast<float>(transform["rotation"][1]) * DEREES_TO_RADIUS_;
-			//初期回転
-			objectData.initialTransform.rotate.x = -static_cast<float>(transform["rotation"][0]) * DEREES_TO_RADIUS_;
-			objectData.initialTransform.rotate.y = -static_cast<float>(transform["rotation"][2]) * DEREES_TO_RADIUS_;
-			objectData.initialTransform.rotate.z = -static_cast<float>(transform["rotation"][1]) * DEREES_TO_RADIUS_;
-
-
-
-			//Blenderと軸の方向が違うので注意！
-			//座標
-			objectData.transform.translate.x = static_cast<float>(transform["translation"][0]);
-			objectData.transform.translate.y = static_cast<float>(transform["translation"][2]);
-			objectData.transform.translate.z = static_cast<float>(transform["translation"][1]);
-			//初期座標
-			objectData.initialTransform.translate.x = static_cast<float>(transform["translation"][0]);
-			objectData.initialTransform.translate.y = static_cast<float>(transform["translation"][2]);
-			objectData.initialTransform.translate.z = static_cast<float>(transform["translation"][1]);
-
+bool Elysia::LevelDataManager::Place(const std::string& fullPath, std::vector<ObjectData>& objectDatas) {
 
+	//クックしたファイルがJSONより新しければそちらを使う
+	//メモリマップしてそのまま読むので解析しなくて済む
+	std::string cookedFilePath = LevelDataBinary::GetCookedFilePath(fullPath);
+	if (LevelDataBinary::IsCookedFileUpToDate(fullPath, cookedFilePath) == true &&
+		LevelDataBinary::Read(cookedFilePath, objectDatas, stringInterner_) == true) {
+		return true;
+	}
 
-			//オブジェクトのタイプを取得
-			if (object.contains("object_type")) {
-				objectData.type = object["object_type"];
-			}
-
-
-			//コライダーの読み込み
-			//まずあるかどうか
-			if (object.contains("collider")) {
-				nlohmann::json& collider = object["collider"];
-
-				objectData.isHavingCollider = true;
-
-				// コライダーの種別を取得
-				if (collider.contains("type")) {
-					objectData.colliderType = collider["type"];
-				}
-
-
-				//BOX
-				if (objectData.colliderType == "BOX") {
-					//中心座標
-					objectData.center.x = static_cast<float>(collider["center"][0]) + objectData.transform.translate.x;
-					objectData.center.y = static_cast<float>(collider["center"][2]) + objectData.transform.translate.y;
-					objectData.center.z = static_cast<float>(collider["center"][1]) + objectData.transform.translate.z;
-					//サイズ
-					objectData.size.x = static_cast<float>(collider["size"][0]);
-					objectData.size.y = static_cast<float>(collider["size"][2]);
-					objectData.size.z = static_cast<float>(collider["size"][1]);
-
-				}
-				//AABB
-				else if (objectData.colliderType == "AABB") {
-
-					Vector3 center = {};
-					center.x = static_cast<float>(collider["center"][0]);
-					center.y = static_cast<float>(collider["center"][2]);
-					center.z = static_cast<float>(collider["center"][1]);
-
-
-					//中心座標
-					objectData.center.x = static_cast<float>(collider["center"][0]) + objectData.transform.translate.x;
-					objectData.center.y = static_cast<float>(collider["center"][2]) + objectData.transform.translate.y;
-					objectData.center.z = static_cast<float>(collider["center"][1]) + objectData.transform.translate.z;
-					//サイズ
-					objectData.size.x = static_cast<float>(collider["size"][0])/2.0f;
-					objectData.size.y = static_cast<float>(collider["size"][2])/2.0f;
-					objectData.size.z = static_cast<float>(collider["size"][1])/2.0f;
-
-					//右上奥
-					objectData.upSize.x = objectData.center.x + objectData.size.x;
-					objectData.upSize.y = objectData.center.y + objectData.size.y;
-					objectData.upSize.z = objectData.center.z + objectData.size.z;
-					//左下手前
-					objectData.downSize.x = objectData.center.x - objectData.size.x;
-					objectData.downSize.y = objectData.center.y - objectData.size.y;
-					objectData.downSize.z = objectData.center.z - objectData.size.z;
-				}
-				else if (objectData.colliderType == "Plane") {
-					//中心座標
-					objectData.center.x = static_cast<float>(collider["center"][0]) + objectData.transform.translate.x;
-					objectData.center.y = static_cast<float>(collider["center"][2]) + objectData.transform.translate.y;
-					objectData.center.z = static_cast<float>(collider["center"][1]) + objectData.transform.translate.z;
-					//サイズ
-					objectData.size.x = static_cast<float>(collider["size"][0]);
-					objectData.size.y = static_cast<float>(collider["size"][2]);
-					objectData.size.z = static_cast<float>(collider["size"][1]);
-
-				}
-
-
-			}
-			else {
-				objectData.isHavingCollider = false;
-			}
-
-			//非表示設定
-			if (object.contains("is_invisible")) {
-				objectData.isInvisible = object["is_invisible"];
-			}
-
-
-			//オーディオの読み込み
-			//まずあるかどうか
-			if (objectData.type == "Audio") {
-				if (object.contains("audio")) {
-					nlohmann::json& audio = object["audio"];
-
-
-					//種類を記録
-					if (audio.contains("type")) {
-						objectData.levelAudioData.type = audio["type"];
-					}
-
-					//ファイル名を記録
-					objectData.levelAudioData.fileName = audio["file_name"];
-
-					//ループをするかどうか
-					objectData.levelAudioData.isLoop = audio["loop"];
-
-					//エリア上かどうか
-					//trueの場合エリア上でした音が鳴らない
-					//falseの場合リスナーと距離が離れると音が小さくなっていく
-					//この時コライダーいらない
-					if (objectData.isHavingCollider == true) {
-						objectData.levelAudioData.isOnArea = audio["on_area"];
-
-					}
-					else {
-						objectData.levelAudioData.isOnArea = false;
-					}
-				}
-			}
-
-		}
+	//JSONから読み込む
+	//DOMを作らずにSAXで直接objectDatasへ読み込む
+	if (LevelDataParser::ParseWithSax(fullPath, objectDatas, stringInterner_) == false) {
+		return false;
 	}
 
+	//クックしていない(VSのビルドでCookLevelDataが動かなかった)時はここで書き出し、次からはバイナリを読む
+	//書き出せなくても読み込みは出来ているので続ける
+	std::error_code errorCode;
+	uintmax_t jsonFileSize = std::filesystem::file_size(fullPath, errorCode);
+	if (!errorCode) {
+		LevelDataBinary::Write(cookedFilePath, objectDatas, static_cast<uint64_t>(jsonFileSize));
+	}
+	return true;
 }
 
 void Elysia::LevelDataManager::Ganarate(LevelData& levelData) {
@@ -224,130 +79,166 @@ void Elysia::LevelDataManager::Ganarate(LevelData& levelData) {
 	std::string levelEditorDirectoryPath = LEVEL_DATA_PATH_ + levelData.folderName;
 
 	for (ObjectData& objectData : levelData.objectDatas) {
+		GenerateObject(levelData.transformHierarchy, levelEditorDirectoryPath, objectData);
+	}
+}
 
-		//ステージ
-		if (objectData.type == "Stage") {
-
-			//オブジェクトの生成
-			StageObjectForLevelEditor* stageObject = new StageObjectForLevelEditor();
+void Elysia::LevelDataManager::GenerateObject(TransformHierarchy& transformHierarchy, const std::string& levelEditorDirectoryPath, ObjectData& objectData) {
 
-			//モデルの読み込み
-			uint32_t modelHandle = ModelManager::GetInstance()->LoadModelFileForLevelData(levelEditorDirectoryPath, objectData.modelFileName);
+	//ステージ
+	if (objectData.type == "Stage") {
 
-			//オブジェクトの生成
-			stageObject->SetSize(objectData.size);
-			stageObject->Initialize(modelHandle, objectData.transform);
-			objectData.objectForLeveEditor = stageObject;
-			objectData.isModelGenerate = true;
+		//オブジェクトの生成
+		StageObjectForLevelEditor* stageObject = new StageObjectForLevelEditor();
 
-			//コライダーがある場合
-			if (objectData.isHavingCollider == true) {
-				//生成
-				StageObjectForLevelEditorCollider* collider = new StageObjectForLevelEditorCollider();
-				collider->SetSize(objectData.size);
-				collider->Initialize();
+		//モデルの読み込み
+		uint32_t modelHandle = ModelManager::GetInstance()->LoadModelFileForLevelData(levelEditorDirectoryPath, objectData.modelFileName);
 
-				//代入
-				objectData.levelDataObjectCollider = collider;
-			}
-		}
-		//オーディオ
-		else if (objectData.type == "Audio") {
-
-			//Audioフォルダの中で読み込み
-			std::string audioDir = levelEditorDirectoryPath + "/" + objectData.modelFileName + "/";
-			std::string extension = StringOption::FindExtension(audioDir, objectData.levelAudioData.fileName);
-			std::string fullPath = audioDir + objectData.levelAudioData.fileName + extension;
-
-			//オーディオデータ
-			AudioDataForLevelEditor audioDataForLevelEditor = {
-				//ファイル名を記録
-				.fileName = objectData.levelAudioData.fileName,
-				//種類を記録
-				.type = objectData.levelAudioData.type,
-				//ハンドルは後で入力する
-				.handle = audio_->Load(fullPath),
-				//エリア上かどうか
-				.isOnArea = objectData.levelAudioData.isOnArea,
-				//ループをするかどうか
-				.isLoop = objectData.levelAudioData.isLoop,
-			};
-
-
-			//オーディオオブジェクトの生成
-			AudioObjectForLevelEditor* audioObject = new AudioObjectForLevelEditor();
-			audioObject->SetLevelDataAudioData(audioDataForLevelEditor);
-
-			//モデルの読み込み
-			uint32_t modelHandle = ModelManager::GetInstance()->LoadModelFileForLevelData(levelEditorDirectoryPath, objectData.modelFileName);
-
-			//初期化
-			audioObject->Initialize(modelHandle, objectData.transform);
-			//オブジェクトの生成
-			objectData.objectForLeveEditor = audioObject;
-			objectData.isModelGenerate = true;
-
-			//コライダーがある場合
-			if (objectData.isHavingCollider == true) {
-
-				//生成
-				AudioObjectForLevelEditorCollider* collider = new AudioObjectForLevelEditorCollider();
-				collider->SetSize(objectData.size);
-				collider->Initialize();
-
-				//代入
-				objectData.levelDataObjectCollider = collider;
+		//オブジェクトの生成
+		stageObject->SetSize(objectData.size);
+		stageObject->SetTransformHierarchy(&transformHierarchy);
+		stageObject->Initialize(modelHandle, objectData.transform);
+		objectData.objectForLeveEditor = stageObject;
+		objectData.isModelGenerate = true;
+	}
+	//オーディオ
+	else if (objectData.type == "Audio") {
+
+		//Audioフォルダの中で読み込み
+		std::string audioDir = levelEditorDirectoryPath + "/" + objectData.modelFileName + "/";
+		std::string extension = StringOption::FindExtension(audioDir, objectData.levelAudioData.fileName);
+		std::string fullPath = audioDir + objectData.levelAudioData.fileName + extension;
+
+		//オーディオデータ
+		AudioDataForLevelEditor audioDataForLevelEditor = {
+			//ファイル名を記録
+			.fileName = objectData.levelAudioData.fileName,
+			//種類を記録
+			.type = objectData.levelAudioData.type,
+			//ハンドルは後で入力する
+			.handle = audio_->Load(fullPath),
+			//エリア上かどうか
+			.isOnArea = objectData.levelAudioData.isOnArea,
+			//ループをするかどうか
+			.isLoop = objectData.levelAudioData.isLoop,
+		};
+
+
+		//オーディオオブジェクトの生成
+		AudioObjectForLevelEditor* audioObject = new AudioObjectForLevelEditor();
+		audioObject->SetLevelDataAudioData(audioDataForLevelEditor);
+
+		//モデルの読み込み
+		uint32_t modelHandle = ModelManager::GetInstance()->LoadModelFileForLevelData(levelEditorDirectoryPath, objectData.modelFileName);
+
+		//初期化
+		audioObject->SetTransformHierarchy(&transformHierarchy);
+		audioObject->Initialize(modelHandle, objectData.transform);
+		//オブジェクトの生成
+		objectData.objectForLeveEditor = audioObject;
+		objectData.isModelGenerate = true;
+	}
+	//モデルは生成しない
+	else {
+		objectData.isModelGenerate = false;
+		return;
+	}
 
-			}
-		}
-		//モデルは生成しない
-		else {
-			objectData.isModelGenerate = false;
-		}
+	//コライダーがある場合
+	if (objectData.isHavingCollider == true) {
+		GenerateCollider(objectData);
 	}
 }
 
-nlohmann::json Elysia::LevelDataManager::Deserialize(const std::string& fullFilePath) {
-	std::ifstream file;
-	//ファイルを開ける
-	file.open(fullFilePath);
+void Elysia::LevelDataManager::GenerateCollider(ObjectData& objectData) {
 
-	//読み込めないなら止める
-	if (file.fail()) {
-		assert(0);
+	//ステージ
+	if (objectData.type == "Stage") {
+		//生成
+		StageObjectForLevelEditorCollider* collider = new StageObjectForLevelEditorCollider();
+		collider->SetSize(objectData.size);
+		collider->Initialize();
+
+		//代入
+		objectData.levelDataObjectCollider = collider;
+	}
+	//オーディオ
+	else if (objectData.type == "Audio") {
+		//生成
+		AudioObjectForLevelEditorCollider* collider = new AudioObjectForLevelEditorCollider();
+		collider->SetSize(objectData.size);
+		collider->Initialize();
+
+		//代入
+		objectData.levelDataObjectCollider = collider;
 	}
+}
+
+void Elysia::LevelDataManager::DeleteObject(ObjectData& objectData) {
+	//オブジェクトの解放
+	if (objectData.objectForLeveEditor != nullptr) {
+		delete objectData.objectForLeveEditor;
+		objectData.objectForLeveEditor = nullptr;
+	}
+	//コライダーの解放
+	if (objectData.levelDataObjectCollider != nullptr) {
+		delete objectData.levelDataObjectCollider;
+		objectData.levelDataObjectCollider = nullptr;
+	}
+	objectData.isModelGenerate = false;
+}
 
-	//JSON文字列から解凍したデータ
-	nlohmann::json data;
-	file >> data;
+void Elysia::LevelDataManager::Patch(ObjectData& previous, ObjectData& current) {
 
-	//正しいレベルデータファイルかチェック
-	//objectかどうか
-	assert(data.is_object());
-	//namaeのキーワードがあるかどうか
-	assert(data.contains("name"));
-	//nameはstring型かどうか
-	assert(data["name"].is_string());
+	//生成済みのものを引き継ぐ
+	current.objectForLeveEditor = previous.objectForLeveEditor;
+	current.levelDataObjectCollider = previous.levelDataObjectCollider;
+	current.isModelGenerate = previous.isModelGenerate;
+	previous.objectForLeveEditor = nullptr;
+	previous.levelDataObjectCollider = nullptr;
 
-	//"name"を文字列として取得
-	std::string name = data["name"].get<std::string>();
-	//正しいレベルデータファイルはチェック
-	assert(name.compare("scene") == 0);
+	//モデルが無いものはデータの差し替えだけで良い
+	if (current.isModelGenerate == false) {
+		return;
+	}
 
+	//Blender側で動かした時だけ反映する
+	//ゲーム側で動かしている扉などを毎回初期位置に戻さないようにするため
+	if (IsSame(previous.initialTransform.scale, current.initialTransform.scale) == false) {
+		current.objectForLeveEditor->SetScale(current.transform.scale);
+	}
+	if (IsSame(previous.initialTransform.rotate, current.initialTransform.rotate) == false) {
+		current.objectForLeveEditor->SetRotate(current.transform.rotate);
+	}
+	if (IsSame(previous.initialTransform.translate, current.initialTransform.translate) == false) {
+		current.objectForLeveEditor->SetPositione(current.transform.translate);
+	}
 
-	//値を返す
-	return data;
+	//大きさ
+	if (IsSame(previous.size, current.size) == false && current.type == "Stage") {
+		static_cast<StageObjectForLevelEditor*>(current.objectForLeveEditor)->SetSize(current.size);
+	}
 
+	//コライダー
+	//中心座標は毎フレームobjectDataから渡しているので何もしなくて良い
+	if (current.isHavingCollider == true && current.levelDataObjectCollider == nullptr) {
+		GenerateCollider(current);
+	}
+	else if (current.isHavingCollider == false && current.levelDataObjectCollider != nullptr) {
+		delete current.levelDataObjectCollider;
+		current.levelDataObjectCollider = nullptr;
+	}
+	else if (current.levelDataObjectCollider != nullptr && IsSame(previous.size, current.size) == false) {
+		current.levelDataObjectCollider->SetSize(current.size);
+	}
 }
 
 uint32_t Elysia::LevelDataManager::Load(const std::string& filePath) {
+	ELYSIA_PROFILE_SCOPE("LevelDataManager::Load");
 
 	//パスの結合
 	std::string fullFilePath = LEVEL_DATA_PATH_ + filePath;
 
-	//JSON文字列から解凍したデータ
-	nlohmann::json deserialized = Deserialize(fullFilePath);
-
 	//ファイルパスの分解
 	std::string folderName = {};
 	std::string fileName = {};
@@ -361,6 +252,16 @@ uint32_t Elysia::LevelDataManager::Load(const std::string& filePath) {
 	}
 
 
+	//同じファイルを読み直す場合は前のハンドルを無効にする
+	std::map<std::string, std::unique_ptr<LevelData>>::iterator it = levelDatas_.find(fullFilePath);
+	if (it != levelDatas_.end()) {
+		levelDataHandles_[it->second->handle] = nullptr;
+		//トランスフォームは前のレベルデータが持っているので一緒に消す
+		for (ObjectData& object : it->second->objectDatas) {
+			DeleteObject(object);
+		}
+	}
+
 	//インスタンスを生成
 	levelDatas_[fullFilePath] = std::make_unique<LevelData>();
 
@@ -376,13 +277,26 @@ uint32_t Elysia::LevelDataManager::Load(const std::string& filePath) {
 	//指定したファイルパスのレベルデータを持ってくる
 	LevelData& levelData = *levelDatas_[fullFilePath];
 
+	//ハンドルから直接引けるようにする
+	if (levelDataHandles_.size() <= levelData.handle) {
+		levelDataHandles_.resize(static_cast<size_t>(levelData.handle) + 1u, nullptr);
+	}
+	levelDataHandles_[levelData.handle] = &levelData;
+
 	//配置
-	Place(deserialized["objects"], levelData);
+	//読み込めないなら止める
+	if (Place(levelData.fullPath, levelData.objectDatas) == false) {
+		assert(0);
+	}
+
+	//索引を作る
+	levelData.objectIndex.Build(levelData.objectDatas, stringInterner_);
 
 	//生成
 	Ganarate(levelData);
 
-
+	//更新の監視を始める
+	levelData.fileWatcher.Initialize(fullFilePath);
 
 	//番号を返す
 	return levelDatas_[fullFilePath]->handle;
@@ -390,158 +304,158 @@ uint32_t Elysia::LevelDataManager::Load(const std::string& filePath) {
 }
 
 void Elysia::LevelDataManager::Reload(const uint32_t& levelDataHandle) {
+	LevelData* levelData = GetLevelData(levelDataHandle);
+	if (levelData != nullptr) {
+		Reload(*levelData);
+	}
+}
 
+bool Elysia::LevelDataManager::Reload(LevelData& levelData) {
+	ELYSIA_PROFILE_SCOPE("LevelDataManager::Reload");
 
-	//一度全てのオブジェクトのデータを消す
-	for (auto& [key, levelDataPtr] : levelDatas_) {
-		if (levelDataPtr->handle == levelDataHandle) {
-
-			//モデルを消す
-			for (auto& object : levelDataPtr->objectDatas) {
-				// Modelの解放
-				if (object.objectForLeveEditor != nullptr) {
-					delete object.objectForLeveEditor;
-				}
-				if (object.levelDataObjectCollider != nullptr) {
-					delete object.levelDataObjectCollider;
-				}
+	//新しいデータを別に読み込む
+	//書き出し途中などで読めなかった場合は今のままにしておく
+	std::vector<ObjectData> objectDatas;
+	if (Place(levelData.fullPath, objectDatas) == false) {
+		return false;
+	}
 
-			}
+	//名前で前回のオブジェクトと対応させる
+	LevelObjectDiff::Result diff = LevelObjectDiff::Make(levelData.objectDatas, objectDatas);
 
+	//ディレクトリパス
+	std::string levelEditorDirectoryPath = LEVEL_DATA_PATH_ + levelData.folderName;
 
-			//listにある情報を全て消す
-			levelDataPtr->objectDatas.clear();
+	for (size_t i = 0u; i < objectDatas.size(); ++i) {
+		ObjectData& objectData = objectDatas[i];
+		const LevelObjectDiff::Entry& entry = diff.entries[i];
 
-			//無駄なループ処理をしないようにする
-			break;
+		//新しく追加された
+		if (entry.action == LevelObjectDiff::Action::Add) {
+			GenerateObject(levelData.transformHierarchy, levelEditorDirectoryPath, objectData);
+			continue;
 		}
-	}
-
-
 
-	//引数から探す
-	std::string fullFilePath = {};
-	for (std::map<std::string, std::unique_ptr<LevelData>>::iterator it = levelDatas_.begin(); it != levelDatas_.end(); ++it) {
-		LevelData* levelData = it->second.get();
-
-		//見つけたらfullFilePathに入れる
-		if (levelData->handle == levelDataHandle) {
-			fullFilePath = levelData->fullPath;
-			break;
+		ObjectData& previous = levelData.objectDatas[entry.previousIndex];
+		//作り直す
+		if (entry.action == LevelObjectDiff::Action::Regenerate) {
+			DeleteObject(previous);
+			GenerateObject(levelData.transformHierarchy, levelEditorDirectoryPath, objectData);
+		}
+		//変わった所だけ反映
+		else {
+			Patch(previous, objectData);
 		}
 	}
 
+	//対応しなかったものは消されたもの
+	//同じ名前が複数あっても全部消す
+	for (const uint32_t& index : diff.removedIndices) {
+		DeleteObject(levelData.objectDatas[index]);
+	}
 
+	//差し替え
+	//名前の枠はそのまま使うので、取得済みのハンドルは同じ名前のオブジェクトを指し続ける
+	levelData.objectDatas = std::move(objectDatas);
+	levelData.objectIndex.Build(levelData.objectDatas, stringInterner_);
+	return true;
+}
 
-	//JSON文字列から解凍したデータ
-	nlohmann::json deserialized = Deserialize(fullFilePath);
-
-
-
-	//元々あったデータを取得する
-	//オブジェクトは全部消したけどここにファイルパスの情報が残っているよ
-	LevelData& levelData = *levelDatas_[fullFilePath];
-
-	//読み込み
-	Place(deserialized["objects"], levelData);
-
-	//生成
-	Ganarate(levelData);
+Elysia::LevelObjectHandle Elysia::LevelDataManager::GetObjectHandle(const uint32_t& handle, const std::string& name) {
+	LevelData* levelData = GetLevelData(handle);
+	if (levelData == nullptr) {
+		return {};
+	}
 
+	//名前から枠を引く
+	//まだ無い名前でも枠だけ作っておく
+	return { .levelDataHandle = handle,.slot = levelData->objectIndex.GetSlot(name, stringInterner_) };
 }
 
 void Elysia::LevelDataManager::Update(const uint32_t& levelDataHandle) {
 
-	//この書き方はC++17からの構造化束縛というものらしい
-	//イテレータではなくこっちでやった方が良いかな
-	//ファイル名とかで指定したい時はkeyを使ったら楽だね。今回はハンドルだけどね。
-	for (auto& [key, levelData] : levelDatas_) {
-		if (levelData->handle == levelDataHandle) {
+	//ハンドルから直接引く
+	LevelData* levelData = GetLevelData(levelDataHandle);
+	if (levelData == nullptr) {
+		return;
+	}
 
-			//リスナーが動いているかどうか
-			bool isListenerMove = false;
+#ifdef _DEBUG
+	//Blenderで保存されたら差分を反映する
+	if (levelData->fileWatcher.IsChanged() == true) {
+		Reload(*levelData);
+	}
+#endif // _DEBUG
 
-			//動いていなかった場合
-			if (levelData->listener.move.x == 0.0f &&
-				levelData->listener.move.y == 0.0f &&
-				levelData->listener.move.z == 0.0f) {
-				isListenerMove = false;
-			}
-			else {
-				isListenerMove = true;
-			}
+	//リスナーが動いているかどうか
+	bool isListenerMove = false;
 
-			for (const auto& object : levelData->objectDatas) {
-				//モデルを生成した時
-				if (object.isModelGenerate == true) {
-					//更新
-					object.objectForLeveEditor->SetIsListenerMove(isListenerMove);
-					object.objectForLeveEditor->Update();
-					Vector3 objectWorldPosition = object.objectForLeveEditor->GetWorldPosition();
-
-					//衝突判定の設定
-					if (object.isHavingCollider == true) {
-						bool isTouch = object.levelDataObjectCollider->GetIsTouch();
-						object.objectForLeveEditor->SetIsTouch(isTouch);
-						object.levelDataObjectCollider->SetObjectPosition(objectWorldPosition);
-						object.levelDataObjectCollider->SetCenterPosition(object.center);
-						object.levelDataObjectCollider->Update();
-					}
-				}
+	//動いていなかった場合
+	if (levelData->listener.move.x == 0.0f &&
+		levelData->listener.move.y == 0.0f &&
+		levelData->listener.move.z == 0.0f) {
+		isListenerMove = false;
+	}
+	else {
+		isListenerMove = true;
+	}
+
+	//トランスフォームをまとめて更新
+	//オブジェクトの更新でワールド座標を使うので先にやる
+	levelData->transformHierarchy.Update();
+
+	for (const auto& object : levelData->objectDatas) {
+		//モデルを生成した時
+		if (object.isModelGenerate == true) {
+			//更新
+			object.objectForLeveEditor->SetIsListenerMove(isListenerMove);
+			object.objectForLeveEditor->Update();
+			Vector3 objectWorldPosition = object.objectForLeveEditor->GetWorldPosition();
+
+			//衝突判定の設定
+			if (object.isHavingCollider == true) {
+				bool isTouch = object.levelDataObjectCollider->GetIsTouch();
+				object.objectForLeveEditor->SetIsTouch(isTouch);
+				object.levelDataObjectCollider->SetObjectPosition(objectWorldPosition);
+				object.levelDataObjectCollider->SetCenterPosition(object.center);
+				object.levelDataObjectCollider->Update();
 			}
-			break;
 		}
 	}
 }
 
 void Elysia::LevelDataManager::Delete(const uint32_t& levelDataHandle) {
 
+	LevelData* levelData = GetLevelData(levelDataHandle);
+	if (levelData == nullptr) {
+		return;
+	}
 
-	//一度全てのオブジェクトのデータを消す
-	for (auto& [key, levelDataPtr] : levelDatas_) {
-		if (levelDataPtr->handle == levelDataHandle) {
-
-			//モデルを消す
-			for (auto& object : levelDataPtr->objectDatas) {
-				// Modelの解放
-				if (object.objectForLeveEditor != nullptr) {
-					delete object.objectForLeveEditor;
-				}
-				if (object.levelDataObjectCollider != nullptr) {
-					delete object.levelDataObjectCollider;
-				}
-
-			}
-
-
-			//listにある情報を全て消す
-			levelDataPtr->objectDatas.clear();
-
-			//無駄なループ処理をしないようにする
-			break;
-		}
+	//モデルを消す
+	for (auto& object : levelData->objectDatas) {
+		DeleteObject(object);
 	}
+
+	//listにある情報を全て消す
+	levelData->objectDatas.clear();
+	levelData->objectIndex.Build(levelData->objectDatas, stringInterner_);
 }
 
 #pragma region 描画
 
 void Elysia::LevelDataManager::Draw(const uint32_t& levelDataHandle, const Camera& camera) {
 	//指定したハンドルのデータだけを描画
-	for (auto& [key, levelData] : levelDatas_) {
-		if (levelData->handle == levelDataHandle) {
-
-			//描画
-			for (const auto& object : levelData->objectDatas) {
-				if (object.isInvisible == false && object.isModelGenerate == true) {
-					object.objectForLeveEditor->Draw(camera);
-				}
-			}
-
-			//無駄なループ処理を防ぐよ
-			break;
+	LevelData* levelData = GetLevelData(levelDataHandle);
+	if (levelData == nullptr) {
+		return;
+	}
+	WriteTransformConstants(*levelData);
 
+	//描画
+	for (const auto& object : levelData->objectDatas) {
+		if (object.isInvisible == false && object.isModelGenerate == true) {
+			object.objectForLeveEditor->Draw(camera);
 		}
-
 	}
 }
 
@@ -549,63 +463,73 @@ void Elysia::LevelDataManager::Draw(const uint32_t& levelDataHandle, const Camer
 void Elysia::LevelDataManager::Draw(const uint32_t& levelDataHandle, const Camera& camera, const DirectionalLight& directionalLight) {
 
 	//指定したハンドルのデータだけを描画
-	for (auto& [key, levelData] : levelDatas_) {
-		if (levelData->handle == levelDataHandle) {
-
-			//描画
-			for (const auto& object : levelData->objectDatas) {
-				if (object.isInvisible == false && object.isModelGenerate == true) {
-					object.objectForLeveEditor->Draw(camera, directionalLight);
-				}
-			}
-
-			//無駄なループ処理を防ぐよ
-			break;
+	LevelData* levelData = GetLevelData(levelDataHandle);
+	if (levelData == nullptr) {
+		return;
+	}
+	WriteTransformConstants(*levelData);
 
+	//描画
+	for (const auto& object : levelData->objectDatas) {
+		if (object.isInvisible == false && object.isModelGenerate == true) {
+			object.objectForLeveEditor->Draw(camera, directionalLight);
 		}
-
 	}
 }
 
 void Elysia::LevelDataManager::Draw(const uint32_t& levelDataHandle, const Camera& camera, const PointLight& pointLight) {
 	//指定したハンドルのデータだけを描画
-	for (auto& [key, levelData] : levelDatas_) {
-		if (levelData->handle == levelDataHandle) {
-
-			//描画
-			for (const auto& object : levelData->objectDatas) {
-				if (object.isInvisible == false && object.isModelGenerate == true) {
-					object.objectForLeveEditor->Draw(camera, pointLight);
-				}
-			}
-
-			//無駄なループ処理を防ぐよ
-			break;
+	LevelData* levelData = GetLevelData(levelDataHandle);
+	if (levelData == nullptr) {
+		return;
+	}
+	WriteTransformConstants(*levelData);
 
+	//描画
+	for (const auto& object : levelData->objectDatas) {
+		if (object.isInvisible == false && object.isModelGenerate == true) {
+			object.objectForLeveEditor->Draw(camera, pointLight);
 		}
-
 	}
 }
 
 void Elysia::LevelDataManager::Draw(const uint32_t& levelDataHandle, const Camera& camera, const SpotLight& spotLight) {
 
 	//指定したハンドルのデータだけを描画
-	for (auto& [key, levelData] : levelDatas_) {
-		if (levelData->handle == levelDataHandle) {
-
-			//描画
-			for (const auto& object : levelData->objectDatas) {
-				//描画
-				if (object.isInvisible == false && object.isModelGenerate == true) {
-					object.objectForLeveEditor->Draw(camera, spotLight);
-				}
-			}
-			//無駄なループ処理を防ぐよ
-			break;
+	LevelData* levelData = GetLevelData(levelDataHandle);
+	if (levelData == nullptr) {
+		return;
+	}
+	WriteTransformConstants(*levelData);
+
+	//描画
+	for (const auto& object : levelData->objectDatas) {
+		if (object.isInvisible == false && object.isModelGenerate == true) {
+			object.objectForLeveEditor->Draw(camera, spotLight);
 		}
 	}
 }
 
+void Elysia::LevelDataManager::WriteTransformConstants(LevelData& levelData) {
+	ConstantBufferManager* constantBufferManager = ConstantBufferManager::GetInstance();
+	uint64_t frameNumber = constantBufferManager->GetFrameNumber();
+	if (levelData.transformWrittenFrameNumber == frameNumber) {
+		return;
+	}
+	levelData.transformWrittenFrameNumber = frameNumber;
+
+	TransformHierarchy& transformHierarchy = levelData.transformHierarchy;
+	if (transformHierarchy.GetCount() == 0u) {
+		return;
+	}
+
+	//リングから全部の分をまとめて確保して、生きているもの全部を書く
+	//変わっていないものも書かないと前のフレームの内容が残っていない
+	ConstantBufferAllocation allocation = constantBufferManager->Allocate(static_cast<size_t>(transformHierarchy.GetCount()) * TransformHierarchy::CONSTANT_STRIDE_);
+	transformHierarchy.WriteConstants(static_cast<uint8_t*>(allocation.cpuAddress));
+	transformHierarchy.SetConstantBaseAddress(allocation.gpuAddress);
+}
+
 #pragma endregion
 
 
@@ -614,18 +538,12 @@ void Elysia::LevelDataManager::Finalize() {
 	//全て解放
 	for (auto& [key, levelData] : levelDatas_) {
 		for (auto& object : levelData->objectDatas) {
-			//オブジェクトの解放
-			if (object.objectForLeveEditor != nullptr) {
-				delete object.objectForLeveEditor;
-			}
-			//コライダーの解放
-			if (object.levelDataObjectCollider != nullptr) {
-				delete object.levelDataObjectCollider;
-			}
+			DeleteObject(object);
 		}
 	}
 	//クリア
 	levelDatas_.clear();
+	levelDataHandles_.clear();
 }
 
 
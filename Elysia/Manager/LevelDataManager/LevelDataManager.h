@@ -10,17 +10,25 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <vector>
+#include <unordered_map>
+#include <string_view>
 #include <fstream>
-#include <json.hpp>
 
 #include "Vector3.h"
 #include "Model.h"
 #include "WorldTransform.h"
+#include "TransformHierarchy.h"
 #include "Collider.h"
 #include "Transform.h"
 #include "Model/BaseObjectForLevelEditor.h"
 #include "Model/AudioObjectForLevelEditor.h"
 #include "Listener.h"
+#include "LevelObjectData.h"
+#include "StringInterner.h"
+#include "FileWatcher.h"
+#include "LevelObjectHandle.h"
+#include "LevelObjectIndex.h"
 
 #pragma region 前方宣言
 
@@ -98,6 +106,7 @@ namespace Elysia {
 
 		/// <summary>
 		/// 再読み込み
+		/// 前回との差分だけを反映する
 		/// </summary>
 		/// <param name="levelDataHandle">ハンドル</param>
 		void Reload(const uint32_t& levelDataHandle);
@@ -154,6 +163,16 @@ namespace Elysia {
 
 	public:
 
+		/// <summary>
+		/// オブジェクトのハンドルを取得
+		/// 名前の検索はここで1度だけにして、毎フレームの処理ではハンドルを使ってね
+		/// まだ無い名前でも取得でき、再読み込みで追加されたら有効になる
+		/// </summary>
+		/// <param name="handle">レベルデータのハンドル</param>
+		/// <param name="name">名前</param>
+		/// <returns>オブジェクトのハンドル</returns>
+		LevelObjectHandle GetObjectHandle(const uint32_t& handle, const std::string& name);
+
 		/// <summary>
 		/// 指定したオブジェクトタイプのコライダーを取得する
 		/// </summary>
@@ -163,20 +182,14 @@ namespace Elysia {
 		inline std::vector<BaseObjectForLevelEditorCollider*> GetCollider(const uint32_t& handle,const std::string& objectType) {
 			std::vector<BaseObjectForLevelEditorCollider*> colliders = {};
 
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
+			//該当するタイプのオブジェクトだけを見る
+			LevelData* levelData = GetLevelData(handle);
+			for (const uint32_t& index : GetTypeIndices(levelData, objectType)) {
+				ObjectData& objectData = levelData->objectDatas[index];
 
-						//コライダーを持っている場合、リストに追加
-						if (objectData.levelDataObjectCollider != nullptr&& objectData.type == objectType) {
-							colliders.push_back(objectData.levelDataObjectCollider);
-						}
-					}
-
-					//無駄なループを防ぐ
-					break;
+				//コライダーを持っている場合、リストに追加
+				if (objectData.levelDataObjectCollider != nullptr) {
+					colliders.push_back(objectData.levelDataObjectCollider);
 				}
 			}
 
@@ -191,28 +204,19 @@ namespace Elysia {
 		/// <returns></returns>
 		inline std::vector<Vector3> GetObjectPositions(const uint32_t& handle, const std::string& objectType) {
 			std::vector<Vector3> positions = {};
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						
-						//指定されたオブジェクトだったら追加
-						if (objectData.type == objectType) {
-							if (objectData.isModelGenerate == true) {
-								positions.push_back(objectData.objectForLeveEditor->GetWorldPosition());
-							}
-							else {
-								//モデルを生成しない場合は初期座標を入れる
-								positions.push_back(objectData.initialTransform.translate);
-							}
-							
-						}
-
-					}
-
-					//無駄なループを防ぐ
-					break;
+
+			//該当するタイプのオブジェクトだけを見る
+			LevelData* levelData = GetLevelData(handle);
+			const std::vector<uint32_t>& indices = GetTypeIndices(levelData, objectType);
+			positions.reserve(indices.size());
+			for (const uint32_t& index : indices) {
+				const ObjectData& objectData = levelData->objectDatas[index];
+				if (objectData.isModelGenerate == true) {
+					positions.push_back(objectData.objectForLeveEditor->GetWorldPosition());
+				}
+				else {
+					//モデルを生成しない場合は初期座標を入れる
+					positions.push_back(objectData.initialTransform.translate);
 				}
 			}
 
@@ -230,24 +234,12 @@ namespace Elysia {
 		inline std::vector<AABB>GetObjectAABBs(const uint32_t& handle, const std::string& objectType) {
 			std::vector<AABB> aabbs = {};
 
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-
-						//指定したオブジェクトタイプだったら追加
-						if (objectData.type == objectType) {
-							aabbs.push_back(objectData.objectForLeveEditor->GetAABB());
-						}
-
-
-					}
-
-					//無駄なループを防ぐ
-					break;
-				}
+			//該当するタイプのオブジェクトだけを見る
+			LevelData* levelData = GetLevelData(handle);
+			const std::vector<uint32_t>& indices = GetTypeIndices(levelData, objectType);
+			aabbs.reserve(indices.size());
+			for (const uint32_t& index : indices) {
+				aabbs.push_back(levelData->objectDatas[index].objectForLeveEditor->GetAABB());
 			}
 
 			return aabbs;
@@ -262,20 +254,13 @@ namespace Elysia {
 		inline std::vector<bool> GetIsHavingColliders(const uint32_t& handle,const std::string& objectType) {
 			std::vector<bool> colliders = {};
 
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//コライダーを持っているかどうかのフラグを挿入
-						if (objectData.type == objectType) {
-							colliders.push_back(objectData.isHavingCollider);
-						}
-					}
-
-					//無駄なループを防ぐ
-					break;
-				}
+			//該当するタイプのオブジェクトだけを見る
+			LevelData* levelData = GetLevelData(handle);
+			const std::vector<uint32_t>& indices = GetTypeIndices(levelData, objectType);
+			colliders.reserve(indices.size());
+			for (const uint32_t& index : indices) {
+				//コライダーを持っているかどうかのフラグを挿入
+				colliders.push_back(levelData->objectDatas[index].isHavingCollider);
 			}
 
 			return colliders;
@@ -286,55 +271,7 @@ namespace Elysia {
 		/// <summary>
 		/// オブジェクトデータ
 		/// </summary>
-		struct ObjectData {
-			//オブジェクトのタイプ
-			//今はステージかオーディオのどちらか
-			std::string type;
-
-			//個別の名前
-			std::string name;
-
-			//ファイル名
-			std::string modelFileName;
-
-			//トランスフォーム
-			Transform transform;
-			//初期トランスフォーム
-			Transform initialTransform;
-
-			//コライダーを持っているかどうか
-			bool isHavingCollider = false;
-
-			//Colliderの種類
-			std::string colliderType;
-
-			//Sphere,Box
-			Vector3 center;
-			Vector3 size;
-
-			//AABB
-			AABB aabb;
-			Vector3 upSize;
-			Vector3 downSize;
-
-
-			//非表示設定
-			bool isInvisible = false;
-
-			//レベルデータのオーディオ
-			AudioDataForLevelEditor levelAudioData;
-
-			//オブジェクト(ステージかオーディオ)
-			BaseObjectForLevelEditor* objectForLeveEditor;
-
-			//モデルを生成するかどうか
-			bool isModelGenerate = false;
-
-			//コライダー
-			BaseObjectForLevelEditorCollider* levelDataObjectCollider;
-
-
-		};
+		using ObjectData = LevelObjectData;
 
 
 		/// <summary>
@@ -346,7 +283,18 @@ namespace Elysia {
 			uint32_t handle = 0u;
 
 			//オブジェクトのリスト
-			std::list<ObjectData> objectDatas;
+			//読み込み時にまとめて確保する
+			std::vector<ObjectData> objectDatas;
+
+			//名前とタイプの索引
+			LevelObjectIndex objectIndex;
+
+			//オブジェクトのトランスフォーム
+			//まとめて計算し、定数バッファにもフレームごとに1回で書き込む
+			TransformHierarchy transformHierarchy;
+			//定数バッファに書き込んだフレーム
+			//同じフレームで何回描画しても1回だけ書き込む
+			uint64_t transformWrittenFrameNumber = UINT64_MAX;
 
 			//リスナー
 			//プレイヤーなどを設定してね
@@ -359,6 +307,10 @@ namespace Elysia {
 			//フルパス
 			std::string fullPath;
 
+			//ファイルの更新監視
+			//デバッグ時はBlenderで保存したらその場で再読み込みする
+			FileWatcher fileWatcher;
+
 		};
 
 
@@ -369,14 +321,21 @@ namespace Elysia {
 		/// <param name="handle">ハンドル</param>
 		/// <param name="listener">リスナー</param>
 		inline void SetListener(const uint32_t& handle, const Listener& listener) {
-			for (const auto& [key, levelData] : levelDatas_) {
+			LevelData* levelData = GetLevelData(handle);
+			if (levelData != nullptr) {
+				levelData->listener = listener;
+			}
+		}
 
-				//一致したら設定
-				if (levelData->handle == handle) {
-					levelData->listener = listener;
-					//無駄なループを防ぐ
-					break;
-				}
+		/// <summary>
+		/// 個別のスケールの変更
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <param name="scale">スケール</param>
+		inline void SetScale(const LevelObjectHandle& objectHandle, const Vector3& scale) {
+			ObjectData* objectData = GetObjectData(objectHandle);
+			if (objectData != nullptr && objectData->objectForLeveEditor != nullptr) {
+				objectData->objectForLeveEditor->SetScale(scale);
 			}
 		}
 
@@ -387,27 +346,19 @@ namespace Elysia {
 		/// <param name="name"></param>
 		/// <param name="scale"></param>
 		inline void SetScale(const uint32_t& handle, const std::string& name, const Vector3& scale) {
+			SetScale(GetObjectHandle(handle, name), scale);
+		}
 
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//名前が一致したらスケールの変更
-						if (objectData.name == name) {
-							objectData.objectForLeveEditor->SetScale(scale);
-							//無駄なループを防ぐ
-							break;
-						}
-
-
-					}
-
-					//無駄なループを防ぐ
-					break;
-				}
+		/// <summary>
+		/// 個別の回転を変える
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <param name="rotate">回転</param>
+		inline void SetRotate(const LevelObjectHandle& objectHandle, const Vector3& rotate) {
+			ObjectData* objectData = GetObjectData(objectHandle);
+			if (objectData != nullptr && objectData->objectForLeveEditor != nullptr) {
+				objectData->objectForLeveEditor->SetRotate(rotate);
 			}
-
 		}
 
 		/// <summary>
@@ -417,27 +368,19 @@ namespace Elysia {
 		/// <param name="name"></param>
 		/// <param name="rotate"></param>
 		inline void SetRotate(const uint32_t& handle, const std::string& name, const Vector3& rotate) {
+			SetRotate(GetObjectHandle(handle, name), rotate);
+		}
 
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//名前が一致したらスケールの変更
-						if (objectData.name == name) {
-							objectData.objectForLeveEditor->SetRotate(rotate);
-							//無駄なループを防ぐ
-							break;
-						}
-
-
-					}
-
-					//無駄なループを防ぐ
-					break;
-				}
+		/// <summary>
+		/// 個別の座標を変更
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <param name="translate">座標</param>
+		inline void SetTranslate(const LevelObjectHandle& objectHandle, const Vector3& translate) {
+			ObjectData* objectData = GetObjectData(objectHandle);
+			if (objectData != nullptr && objectData->objectForLeveEditor != nullptr) {
+				objectData->objectForLeveEditor->SetPositione(translate);
 			}
-
 		}
 
 		/// <summary>
@@ -446,26 +389,19 @@ namespace Elysia {
 		/// <param name="handle"></param>
 		/// <param name="name"></param>
 		inline void SetTranslate(const uint32_t& handle, const std::string& name, const Vector3& translate) {
+			SetTranslate(GetObjectHandle(handle, name), translate);
+		}
 
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//一致したら座標の変更
-						if (objectData.name == name) {
-							objectData.objectForLeveEditor->SetPositione(translate);
-							//無駄なループを防ぐ
-							break;
-						}
-
-					}
-
-					//無駄なループを防ぐ
-					break;
-				}
+		/// <summary>
+		/// 色の設定
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <param name="color">色</param>
+		inline void SetColor(const LevelObjectHandle& objectHandle, const Vector4& color) {
+			ObjectData* objectData = GetObjectData(objectHandle);
+			if (objectData != nullptr && objectData->objectForLeveEditor != nullptr) {
+				objectData->objectForLeveEditor->SetColor(color);
 			}
-
 		}
 
 		/// <summary>
@@ -475,21 +411,18 @@ namespace Elysia {
 		/// <param name="name"></param>
 		/// <param name="color"></param>
 		inline void SetColor(const uint32_t& handle, const std::string& name, const Vector4& color) {
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//一致したら座標の変更
-						if (objectData.name == name) {
-							objectData.objectForLeveEditor->SetColor(color);
-							//無駄なループを防ぐ
-							break;
-						}
-					}
-					//無駄なループを防ぐ
-					break;
-				}
+			SetColor(GetObjectHandle(handle, name), color);
+		}
+
+		/// <summary>
+		/// 透明度の設定
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <param name="transparency">透明度</param>
+		inline void SetTransparency(const LevelObjectHandle& objectHandle, const float& transparency) {
+			ObjectData* objectData = GetObjectData(objectHandle);
+			if (objectData != nullptr && objectData->objectForLeveEditor != nullptr) {
+				objectData->objectForLeveEditor->SetTransparency(transparency);
 			}
 		}
 
@@ -500,22 +433,17 @@ namespace Elysia {
 		/// <param name="name"></param>
 		/// <param name="transparency"></param>
 		inline void SetTransparency(const uint32_t& handle, const std::string& name, const float& transparency) {
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//一致したら座標の変更
-						if (objectData.name == name) {
-							objectData.objectForLeveEditor->SetTransparency(transparency);
-							//無駄なループを防ぐ
-							break;
-						}
-					}
-					//無駄なループを防ぐ
-					break;
-				}
-			}
+			SetTransparency(GetObjectHandle(handle, name), transparency);
+		}
+
+		/// <summary>
+		/// 初期スケールを取得
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <returns>スケール</returns>
+		inline Vector3 GetInitiaScale(const LevelObjectHandle& objectHandle) {
+			const ObjectData* objectData = GetObjectData(objectHandle);
+			return (objectData != nullptr) ? objectData->initialTransform.scale : Vector3{};
 		}
 
 		/// <summary>
@@ -525,24 +453,17 @@ namespace Elysia {
 		/// <param name="name">名前</param>
 		/// <returns>スケール</returns>
 		inline Vector3 GetInitiaScale(const uint32_t& handle, const std::string& name) {
-			Vector3 result = {};
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//一致したら座標の変更
-						if (objectData.name == name) {
-							result = objectData.initialTransform.scale;
-							//無駄なループを防ぐ
-							break;
-						}
-					}
-					//無駄なループを防ぐ
-					break;
-				}
-			}
-			return result;
+			return GetInitiaScale(GetObjectHandle(handle, name));
+		}
+
+		/// <summary>
+		/// 初期回転を取得
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <returns>回転</returns>
+		inline Vector3 GetInitialRotate(const LevelObjectHandle& objectHandle) {
+			const ObjectData* objectData = GetObjectData(objectHandle);
+			return (objectData != nullptr) ? objectData->initialTransform.rotate : Vector3{};
 		}
 
 		/// <summary>
@@ -552,24 +473,17 @@ namespace Elysia {
 		/// <param name="name">名前</param>
 		/// <returns>回転</returns>
 		inline Vector3 GetInitialRotate(const uint32_t& handle, const std::string& name) {
-			Vector3 result = {};
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//一致したら座標の変更
-						if (objectData.name == name) {
-							result = objectData.initialTransform.rotate;
-							//無駄なループを防ぐ
-							break;
-						}
-					}
-					//無駄なループを防ぐ
-					break;
-				}
-			}
-			return result;
+			return GetInitialRotate(GetObjectHandle(handle, name));
+		}
+
+		/// <summary>
+		/// 初期座標を取得
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <returns>座標</returns>
+		inline Vector3 GetInitialTranslate(const LevelObjectHandle& objectHandle) {
+			const ObjectData* objectData = GetObjectData(objectHandle);
+			return (objectData != nullptr) ? objectData->initialTransform.translate : Vector3{};
 		}
 
 		/// <summary>
@@ -579,24 +493,19 @@ namespace Elysia {
 		/// <param name="name">名前</param>
 		/// <returns>座標</returns>
 		inline Vector3 GetInitialTranslate(const uint32_t& handle, const std::string& name) {
-			Vector3 result = {};
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//一致したら座標の変更
-						if (objectData.name == name) {
-							result = objectData.initialTransform.translate;
-							//無駄なループを防ぐ
-							break;
-						}
-					}
-					//無駄なループを防ぐ
-					break;
-				}
+			return GetInitialTranslate(GetObjectHandle(handle, name));
+		}
+
+		/// <summary>
+		/// 非表示設定
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <param name="isInvisible">非表示にするかどうか</param>
+		inline void SetInvisible(const LevelObjectHandle& objectHandle, const bool& isInvisible) {
+			ObjectData* objectData = GetObjectData(objectHandle);
+			if (objectData != nullptr) {
+				objectData->isInvisible = isInvisible;
 			}
-			return result;
 		}
 
 		/// <summary>
@@ -606,32 +515,66 @@ namespace Elysia {
 		/// <param name="name">名前</param>
 		/// <param name="isInvisible">非表示にするかどうか</param>
 		inline void SetInvisible(const uint32_t& handle, const std::string& name, const bool& isInvisible) {
-			for (const auto& [key, levelData] : levelDatas_) {
-				if (levelData->handle == handle) {
-					//該当するLevelDataのobjectDatasを検索
-					for (auto& objectData : levelData->objectDatas) {
-						//一致したら非表示設定
-						if (objectData.name == name) {
-							objectData.isInvisible = isInvisible;
-							//無駄なループを防ぐ
-							break;
-						}
-					}
-					//無駄なループを防ぐ
-					break;
-				}
+			SetInvisible(GetObjectHandle(handle, name), isInvisible);
+		}
+
+
+	private:
+
+		/// <summary>
+		/// レベルデータを取得
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns>レベルデータ。無ければnullptr</returns>
+		inline LevelData* GetLevelData(const uint32_t& handle)const {
+			if (handle >= levelDataHandles_.size()) {
+				return nullptr;
 			}
+			return levelDataHandles_[handle];
 		}
 
+		/// <summary>
+		/// オブジェクトデータを取得
+		/// </summary>
+		/// <param name="objectHandle">オブジェクトのハンドル</param>
+		/// <returns>オブジェクトデータ。無ければnullptr</returns>
+		inline ObjectData* GetObjectData(const LevelObjectHandle& objectHandle)const {
+			LevelData* levelData = GetLevelData(objectHandle.levelDataHandle);
+			if (levelData == nullptr) {
+				return nullptr;
+			}
+			uint32_t index = levelData->objectIndex.GetIndex(objectHandle.slot);
+			if (index == LevelObjectHandle::INVALID_) {
+				return nullptr;
+			}
+			return &levelData->objectDatas[index];
+		}
+
+		/// <summary>
+		/// 指定したタイプのオブジェクトの番号を取得
+		/// </summary>
+		/// <param name="levelData">レベルデータ</param>
+		/// <param name="objectType">タイプ</param>
+		/// <returns>objectDatasの番号</returns>
+		inline const std::vector<uint32_t>& GetTypeIndices(const LevelData* levelData, const std::string& objectType)const {
+			//無い場合に返す空のリスト
+			static const std::vector<uint32_t> EMPTY_INDICES = {};
+			if (levelData == nullptr) {
+				return EMPTY_INDICES;
+			}
+			return levelData->objectIndex.GetTypeIndices(objectType);
+		}
 
 	private:
 
 		/// <summary>
 		/// 配置
+		/// クックしたバイナリが新しければそれを、無ければJSONを読み込む
 		/// </summary>
-		/// <param name="objects">オブジェクト</param>
-		/// <param name="levelData">レベルデータ</param>
-		void Place(nlohmann::json& objects, LevelData& levelData);
+		/// <param name="fullPath">JSONのフルパス</param>
+		/// <param name="objectDatas">オブジェクトデータ</param>
+		/// <returns>読み込めたかどうか</returns>
+		bool Place(const std::string& fullPath, std::vector<ObjectData>& objectDatas);
 
 		/// <summary>
 		/// 生成
@@ -639,13 +582,48 @@ namespace Elysia {
 		/// <param name="levelData"></param>
 		void Ganarate(LevelData& levelData);
 
+		/// <summary>
+		/// オブジェクトを1つ生成
+		/// </summary>
+		/// <param name="transformHierarchy">トランスフォームを持つ先</param>
+		/// <param name="levelEditorDirectoryPath">レベルデータのディレクトリパス</param>
+		/// <param name="objectData">オブジェクトデータ</param>
+		void GenerateObject(TransformHierarchy& transformHierarchy, const std::string& levelEditorDirectoryPath, ObjectData& objectData);
 
 		/// <summary>
-		/// JSONファイルを解凍
+		/// コライダーを生成
 		/// </summary>
-		/// <param name="fullFilePath"></param>
-		/// <returns></returns>
-		nlohmann::json Deserialize(const std::string& fullFilePath);
+		/// <param name="objectData">オブジェクトデータ</param>
+		void GenerateCollider(ObjectData& objectData);
+
+		/// <summary>
+		/// オブジェクトを1つ消す
+		/// </summary>
+		/// <param name="objectData">オブジェクトデータ</param>
+		void DeleteObject(ObjectData& objectData);
+
+		/// <summary>
+		/// 再読み込み
+		/// 名前で前回のオブジェクトと対応させ、変わった所だけ反映する
+		/// </summary>
+		/// <param name="levelData">レベルデータ</param>
+		/// <returns>読み込めたかどうか</returns>
+		bool Reload(LevelData& levelData);
+
+		/// <summary>
+		/// 生成済みのオブジェクトを引き継いで変わった所だけ反映
+		/// </summary>
+		/// <param name="previous">前回のデータ</param>
+		/// <param name="current">今回のデータ</param>
+		void Patch(ObjectData& previous, ObjectData& current);
+
+		/// <summary>
+		/// トランスフォームを定数バッファに書き込む
+		/// フレームごとのリングなので、そのフレームの最初の描画で全部書く
+		/// </summary>
+		/// <param name="levelData">レベルデータ</param>
+		void WriteTransformConstants(LevelData& levelData);
+
 
 	private:
 		//オーディオ
@@ -658,8 +636,12 @@ namespace Elysia {
 	private:
 		//ここにデータを入れていく
 		std::map<std::string, std::unique_ptr<LevelData>> levelDatas_;
+		//ハンドルからレベルデータを直接引く
+		std::vector<LevelData*> levelDataHandles_;
 		//ハンドル
 		uint32_t handle_ = 0u;
+		//オブジェクトのタイプ名などを1つにまとめておく
+		StringInterner stringInterner_;
 
 
 
@@ -0,0 +1,251 @@
+#include "LevelDataParser.h"
+
+#include <cassert>
+#include <numbers>
+#include <fstream>
+#include <filesystem>
+
+#include "LevelDataSaxHandler.h"
+
+namespace {
+	//1オブジェクトあたりのおおよそのバイト数
+	//Blenderから出力したJSONはコライダー無しで500バイト前後
+	const size_t APPROXIMATE_BYTES_PER_OBJECT_ = 512u;
+
+	/// <summary>
+	/// JSONの3要素の配列をベクトルにする
+	/// </summary>
+	/// <param name="array">配列</param>
+	/// <returns>ベクトル</returns>
+	Vector3 ToVector3(const nlohmann::json& array) {
+		return {
+			.x = static_cast<float>(array[0]),
+			.y = static_cast<float>(array[1]),
+			.z = static_cast<float>(array[2]),
+		};
+	}
+}
+
+void LevelDataParser::BuildObjectData(const RawObjectData& rawObjectData, Elysia::LevelObjectData& objectData, Elysia::StringInterner& stringInterner) {
+
+	//名前
+	objectData.name = rawObjectData.name;
+	//ここでのファイルネームはオブジェクトの名前
+	objectData.modelFileName = rawObjectData.fileName;
+
+	//Blenderと軸の方向が違うので注意！
+	//スケール
+	objectData.transform.scale = {
+		.x = rawObjectData.scaling.x,
+		.y = rawObjectData.scaling.z,
+		.z = rawObjectData.scaling.y,
+	};
+
+	//回転角
+	//そういえばBlenderは度数法だったね
+	//弧度法に直そう
+	const float DEREES_TO_RADIUS_ = static_cast<float>(std::numbers::pi) / 180.0f;
+	objectData.transform.rotate = {
+		.x = -rawObjectData.rotation.x * DEREES_TO_RADIUS_,
+		.y = -rawObjectData.rotation.z * DEREES_TO_RADIUS_,
+		.z = -rawObjectData.rotation.y * DEREES_TO_RADIUS_,
+	};
+
+	//座標
+	objectData.transform.translate = {
+		.x = rawObjectData.translation.x,
+		.y = rawObjectData.translation.z,
+		.z = rawObjectData.translation.y,
+	};
+
+	//初期トランスフォーム
+	objectData.initialTransform = objectData.transform;
+
+	//オブジェクトのタイプ
+	objectData.type = stringInterner.Intern(rawObjectData.objectType);
+
+	//コライダー
+	objectData.isHavingCollider = rawObjectData.isHavingCollider;
+	if (objectData.isHavingCollider == true) {
+		objectData.colliderType = stringInterner.Intern(rawObjectData.colliderType);
+
+		//中心座標
+		objectData.center.x = rawObjectData.colliderCenter.x + objectData.transform.translate.x;
+		objectData.center.y = rawObjectData.colliderCenter.z + objectData.transform.translate.y;
+		objectData.center.z = rawObjectData.colliderCenter.y + objectData.transform.translate.z;
+
+		//BOX,Plane
+		if (objectData.colliderType == "BOX" || objectData.colliderType == "Plane") {
+			//サイズ
+			objectData.size.x = rawObjectData.colliderSize.x;
+			objectData.size.y = rawObjectData.colliderSize.z;
+			objectData.size.z = rawObjectData.colliderSize.y;
+		}
+		//AABB
+		else if (objectData.colliderType == "AABB") {
+			//サイズ
+			objectData.size.x = rawObjectData.colliderSize.x / 2.0f;
+			objectData.size.y = rawObjectData.colliderSize.z / 2.0f;
+			objectData.size.z = rawObjectData.colliderSize.y / 2.0f;
+
+			//右上奥
+			objectData.upSize.x = objectData.center.x + objectData.size.x;
+			objectData.upSize.y = objectData.center.y + objectData.size.y;
+			objectData.upSize.z = objectData.center.z + objectData.size.z;
+			//左下手前
+			objectData.downSize.x = objectData.center.x - objectData.size.x;
+			objectData.downSize.y = objectData.center.y - objectData.size.y;
+			objectData.downSize.z = objectData.center.z - objectData.size.z;
+		}
+		//それ以外の種別は中心座標を記録しない
+		else {
+			objectData.center = {};
+		}
+	}
+
+	//非表示設定
+	objectData.isInvisible = rawObjectData.isInvisible;
+
+	//オーディオ
+	if (objectData.type == "Audio" && rawObjectData.isHavingAudio == true) {
+		objectData.levelAudioData.type = rawObjectData.audioType;
+		objectData.levelAudioData.fileName = rawObjectData.audioFileName;
+		objectData.levelAudioData.isLoop = rawObjectData.isAudioLoop;
+
+		//エリア上かどうか
+		//trueの場合エリア上でした音が鳴らない
+		//falseの場合リスナーと距離が離れると音が小さくなっていく
+		//この時コライダーいらない
+		objectData.levelAudioData.isOnArea = (objectData.isHavingCollider == true) ? rawObjectData.isAudioOnArea : false;
+	}
+}
+
+bool LevelDataParser::ParseWithSax(const std::string& fullFilePath, std::vector<Elysia::LevelObjectData>& objectDatas, Elysia::StringInterner& stringInterner) {
+	std::ifstream file;
+	//ファイルを開ける
+	file.open(fullFilePath);
+
+	//読み込めない
+	if (file.fail()) {
+		return false;
+	}
+
+	//再確保が起きないように先に確保しておく
+	objectDatas.clear();
+	objectDatas.reserve(EstimateObjectCount(fullFilePath));
+
+	//読み込み
+	//DOMは作らずに1オブジェクトずつ変換していく
+	Elysia::LevelDataSaxHandler handler(objectDatas, stringInterner);
+	bool isSucceeded = nlohmann::json::sax_parse(file, &handler);
+
+	//正しく読めなかった
+	//正しいレベルデータファイルかもチェック
+	if (isSucceeded == false || handler.GetIsValidScene() == false) {
+		objectDatas.clear();
+		return false;
+	}
+	return true;
+}
+
+bool LevelDataParser::ParseWithDom(const std::string& fullFilePath, std::vector<Elysia::LevelObjectData>& objectDatas, Elysia::StringInterner& stringInterner) {
+	std::ifstream file;
+	//ファイルを開ける
+	file.open(fullFilePath);
+
+	//読み込めない
+	if (file.fail()) {
+		return false;
+	}
+
+	//JSON文字列から解凍したデータ
+	nlohmann::json data;
+	file >> data;
+
+	//正しいレベルデータファイルかチェック
+	assert(data.is_object());
+	assert(data.contains("name"));
+	assert(data["name"].is_string());
+	assert(data["name"].get<std::string>().compare("scene") == 0);
+
+	objectDatas.clear();
+
+	//"objects"の全オブジェクトを走査
+	for (nlohmann::json& object : data["objects"]) {
+		//各オブジェクトに必ずtypeが入っているよ
+		assert(object.contains("type"));
+
+		//MESHの場合だけ
+		RawObjectData rawObjectData = {};
+		rawObjectData.type = object["type"].get<std::string>();
+		if (rawObjectData.type.compare("MESH") != 0) {
+			continue;
+		}
+
+		if (object.contains("name")) {
+			rawObjectData.name = object["name"];
+		}
+		if (object.contains("file_name")) {
+			rawObjectData.fileName = object["file_name"];
+		}
+		if (object.contains("object_type")) {
+			rawObjectData.objectType = object["object_type"];
+		}
+
+		//トランスフォームのパラメータ読み込み
+		nlohmann::json& transform = object["transform"];
+		rawObjectData.scaling = ToVector3(transform["scaling"]);
+		rawObjectData.rotation = ToVector3(transform["rotation"]);
+		rawObjectData.translation = ToVector3(transform["translation"]);
+
+		//コライダーの読み込み
+		if (object.contains("collider")) {
+			nlohmann::json& collider = object["collider"];
+			rawObjectData.isHavingCollider = true;
+			if (collider.contains("type")) {
+				rawObjectData.colliderType = collider["type"];
+			}
+			if (collider.contains("center")) {
+				rawObjectData.colliderCenter = ToVector3(collider["center"]);
+			}
+			if (collider.contains("size")) {
+				rawObjectData.colliderSize = ToVector3(collider["size"]);
+			}
+		}
+
+		//非表示設定
+		if (object.contains("is_invisible")) {
+			rawObjectData.isInvisible = object["is_invisible"];
+		}
+
+		//オーディオの読み込み
+		if (object.contains("audio")) {
+			nlohmann::json& audio = object["audio"];
+			rawObjectData.isHavingAudio = true;
+			if (audio.contains("type")) {
+				rawObjectData.audioType = audio["type"];
+			}
+			rawObjectData.audioFileName = audio["file_name"];
+			rawObjectData.isAudioLoop = audio["loop"];
+			if (audio.contains("on_area")) {
+				rawObjectData.isAudioOnArea = audio["on_area"];
+			}
+		}
+
+		//変換
+		objectDatas.emplace_back(Elysia::LevelObjectData{});
+		BuildObjectData(rawObjectData, objectDatas.back(), stringInterner);
+	}
+
+	return true;
+}
+
+size_t LevelDataParser::EstimateObjectCount(const std::string& fullFilePath) {
+	std::error_code errorCode;
+	uintmax_t fileSize = std::filesystem::file_size(fullFilePath, errorCode);
+	//取得出来なかったら確保しない
+	if (errorCode) {
+		return 0u;
+	}
+	return static_cast<size_t>(fileSize / APPROXIMATE_BYTES_PER_OBJECT_) + 1u;
+}
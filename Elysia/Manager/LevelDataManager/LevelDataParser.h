@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file LevelDataParser.h
+ * @brief レベルデータ(JSON)の読み込み
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+#include "Vector3.h"
+#include "LevelObjectData.h"
+#include "StringInterner.h"
+
+/// <summary>
+/// レベルデータ(JSON)の読み込み
+/// </summary>
+namespace LevelDataParser {
+
+	/// <summary>
+	/// JSONから読み込んだままのオブジェクトデータ
+	/// 軸の入れ替えや度数法の変換はまだしていない
+	/// </summary>
+	struct RawObjectData {
+		//種別(MESH,EMPTY,LIGHT,CAMERA)
+		std::string type;
+		//個別の名前
+		std::string name;
+		//ファイル名
+		std::string fileName;
+		//オブジェクトのタイプ
+		std::string objectType;
+
+		//トランスフォーム(Blenderの座標系のまま)
+		Vector3 scaling;
+		Vector3 rotation;
+		Vector3 translation;
+
+		//コライダー
+		bool isHavingCollider = false;
+		std::string colliderType;
+		Vector3 colliderCenter;
+		Vector3 colliderSize;
+
+		//非表示設定
+		bool isInvisible = false;
+
+		//オーディオ
+		bool isHavingAudio = false;
+		std::string audioType;
+		std::string audioFileName;
+		bool isAudioLoop = false;
+		bool isAudioOnArea = false;
+	};
+
+	/// <summary>
+	/// 生データからオブジェクトデータを作る
+	/// </summary>
+	/// <param name="rawObjectData">生データ</param>
+	/// <param name="objectData">オブジェクトデータ</param>
+	/// <param name="stringInterner">タイプ名の登録先</param>
+	void BuildObjectData(const RawObjectData& rawObjectData, Elysia::LevelObjectData& objectData, Elysia::StringInterner& stringInterner);
+
+	/// <summary>
+	/// SAXで読み込む
+	/// DOMを作らずにobjectDatasへ直接入れていく
+	/// 書き出し途中のファイルなど読み込めなかった場合はfalseを返す
+	/// </summary>
+	/// <param name="fullFilePath">フルパス</param>
+	/// <param name="objectDatas">オブジェクトデータ</param>
+	/// <param name="stringInterner">タイプ名の登録先</param>
+	/// <returns>読み込めたかどうか</returns>
+	bool ParseWithSax(const std::string& fullFilePath, std::vector<Elysia::LevelObjectData>& objectDatas, Elysia::StringInterner& stringInterner);
+
+	/// <summary>
+	/// DOM(nlohmann::json)で読み込む
+	/// 以前の読み込み方法。比較用に残している
+	/// </summary>
+	/// <param name="fullFilePath">フルパス</param>
+	/// <param name="objectDatas">オブジェクトデータ</param>
+	/// <param name="stringInterner">タイプ名の登録先</param>
+	/// <returns>読み込めたかどうか</returns>
+	bool ParseWithDom(const std::string& fullFilePath, std::vector<Elysia::LevelObjectData>& objectDatas, Elysia::StringInterner& stringInterner);
+
+	/// <summary>
+	/// ファイルサイズからオブジェクト数を見積もる
+	/// vectorのreserveに使う
+	/// </summary>
+	/// <param name="fullFilePath">フルパス</param>
+	/// <returns>見積もったオブジェクト数</returns>
+	size_t EstimateObjectCount(const std::string& fullFilePath);
+
+};
@@ -0,0 +1,303 @@
+#include "LevelDataSaxHandler.h"
+
+#include <cassert>
+
+Elysia::LevelDataSaxHandler::LevelDataSaxHandler(std::vector<LevelObjectData>& objectDatas, StringInterner& stringInterner)
+	:objectDatas_(objectDatas), stringInterner_(stringInterner) {
+	//深さはそこまで無いので先に確保しておく
+	scopes_.reserve(8u);
+}
+
+bool Elysia::LevelDataSaxHandler::null() {
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::boolean(bool value) {
+	//読み飛ばし中
+	if (skipDepth_ > 0u || scopes_.empty()) {
+		return true;
+	}
+
+	switch (GetCurrentScope()) {
+	case Scope::Object:
+		//非表示設定
+		if (currentKey_ == "is_invisible") {
+			rawObjectData_.isInvisible = value;
+		}
+		break;
+
+	case Scope::Audio:
+		//ループをするかどうか
+		if (currentKey_ == "loop") {
+			rawObjectData_.isAudioLoop = value;
+		}
+		//エリア上かどうか
+		else if (currentKey_ == "on_area") {
+			rawObjectData_.isAudioOnArea = value;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::number_integer(number_integer_t value) {
+	return WriteNumber(static_cast<double>(value));
+}
+
+bool Elysia::LevelDataSaxHandler::number_unsigned(number_unsigned_t value) {
+	return WriteNumber(static_cast<double>(value));
+}
+
+bool Elysia::LevelDataSaxHandler::number_float(number_float_t value, const string_t&) {
+	return WriteNumber(static_cast<double>(value));
+}
+
+bool Elysia::LevelDataSaxHandler::string(string_t& value) {
+	//読み飛ばし中
+	if (skipDepth_ > 0u || scopes_.empty()) {
+		return true;
+	}
+
+	switch (GetCurrentScope()) {
+	case Scope::Root:
+		//正しいレベルデータファイルかチェック
+		if (currentKey_ == "name") {
+			isValidScene_ = (value == "scene");
+		}
+		break;
+
+	case Scope::Object:
+		//種別
+		if (currentKey_ == "type") {
+			rawObjectData_.type = std::move(value);
+		}
+		//名前
+		else if (currentKey_ == "name") {
+			rawObjectData_.name = std::move(value);
+		}
+		//ファイル名
+		else if (currentKey_ == "file_name") {
+			rawObjectData_.fileName = std::move(value);
+		}
+		//オブジェクトのタイプ
+		else if (currentKey_ == "object_type") {
+			rawObjectData_.objectType = std::move(value);
+		}
+		break;
+
+	case Scope::Collider:
+		//コライダーの種別
+		if (currentKey_ == "type") {
+			rawObjectData_.colliderType = std::move(value);
+		}
+		break;
+
+	case Scope::Audio:
+		//種類
+		if (currentKey_ == "type") {
+			rawObjectData_.audioType = std::move(value);
+		}
+		//ファイル名
+		else if (currentKey_ == "file_name") {
+			rawObjectData_.audioFileName = std::move(value);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::binary(binary_t&) {
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::start_object(std::size_t) {
+	//読み飛ばし中
+	if (skipDepth_ > 0u) {
+		++skipDepth_;
+		return true;
+	}
+
+	//一番外側
+	if (scopes_.empty()) {
+		scopes_.push_back(Scope::Root);
+		return true;
+	}
+
+	switch (GetCurrentScope()) {
+	case Scope::Objects:
+		//新しいオブジェクト
+		rawObjectData_ = {};
+		scopes_.push_back(Scope::Object);
+		return true;
+
+	case Scope::Object:
+		//トランスフォーム
+		if (currentKey_ == "transform") {
+			scopes_.push_back(Scope::Transform);
+			return true;
+		}
+		//コライダー
+		if (currentKey_ == "collider") {
+			rawObjectData_.isHavingCollider = true;
+			scopes_.push_back(Scope::Collider);
+			return true;
+		}
+		//オーディオ
+		if (currentKey_ == "audio") {
+			rawObjectData_.isHavingAudio = true;
+			scopes_.push_back(Scope::Audio);
+			return true;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	//使わないので読み飛ばす
+	skipDepth_ = 1u;
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::key(string_t& value) {
+	//読み飛ばし中は記録しない
+	if (skipDepth_ == 0u) {
+		currentKey_.assign(value);
+	}
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::end_object() {
+	//読み飛ばし中
+	if (skipDepth_ > 0u) {
+		--skipDepth_;
+		return true;
+	}
+
+	//オブジェクト1つ分を読み終えたらここで変換する
+	//MESHだけが対象
+	if (GetCurrentScope() == Scope::Object && rawObjectData_.type == "MESH") {
+		objectDatas_.emplace_back(LevelObjectData{});
+		LevelDataParser::BuildObjectData(rawObjectData_, objectDatas_.back(), stringInterner_);
+	}
+
+	scopes_.pop_back();
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::start_array(std::size_t) {
+	//読み飛ばし中
+	if (skipDepth_ > 0u) {
+		++skipDepth_;
+		return true;
+	}
+
+	if (scopes_.empty()) {
+		return false;
+	}
+
+	switch (GetCurrentScope()) {
+	case Scope::Root:
+		//オブジェクトの配列
+		if (currentKey_ == "objects") {
+			scopes_.push_back(Scope::Objects);
+			return true;
+		}
+		break;
+
+	case Scope::Transform:
+		if (currentKey_ == "scaling") {
+			currentVector_ = &rawObjectData_.scaling;
+		}
+		else if (currentKey_ == "rotation") {
+			currentVector_ = &rawObjectData_.rotation;
+		}
+		else if (currentKey_ == "translation") {
+			currentVector_ = &rawObjectData_.translation;
+		}
+		else {
+			currentVector_ = nullptr;
+		}
+		break;
+
+	case Scope::Collider:
+		if (currentKey_ == "center") {
+			currentVector_ = &rawObjectData_.colliderCenter;
+		}
+		else if (currentKey_ == "size") {
+			currentVector_ = &rawObjectData_.colliderSize;
+		}
+		else {
+			currentVector_ = nullptr;
+		}
+		break;
+
+	default:
+		currentVector_ = nullptr;
+		break;
+	}
+
+	//3要素の配列
+	if (currentVector_ != nullptr) {
+		currentVectorIndex_ = 0u;
+		scopes_.push_back(Scope::Vector);
+		return true;
+	}
+
+	//"children"など使わない配列は読み飛ばす
+	skipDepth_ = 1u;
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::end_array() {
+	//読み飛ばし中
+	if (skipDepth_ > 0u) {
+		--skipDepth_;
+		return true;
+	}
+
+	if (GetCurrentScope() == Scope::Vector) {
+		currentVector_ = nullptr;
+	}
+	scopes_.pop_back();
+	return true;
+}
+
+bool Elysia::LevelDataSaxHandler::parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) {
+	//読み込みを止める
+	return false;
+}
+
+bool Elysia::LevelDataSaxHandler::WriteNumber(const double& value) {
+	//ベクトル以外の数値は使わない
+	if (skipDepth_ > 0u || scopes_.empty() || GetCurrentScope() != Scope::Vector) {
+		return true;
+	}
+
+	//DOMの時と同じくfloatに変換して入れる
+	const float_t floatValue = static_cast<float_t>(value);
+	switch (currentVectorIndex_) {
+	case 0u:
+		currentVector_->x = floatValue;
+		break;
+	case 1u:
+		currentVector_->y = floatValue;
+		break;
+	case 2u:
+		currentVector_->z = floatValue;
+		break;
+	default:
+		//4要素目以降は無視
+		break;
+	}
+	++currentVectorIndex_;
+	return true;
+}
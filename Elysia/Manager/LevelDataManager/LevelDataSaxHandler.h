@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * @file LevelDataSaxHandler.h
+ * @brief レベルデータ(JSON)をSAXで読み込むためのハンドラ
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+#include "LevelDataParser.h"
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// レベルデータ(JSON)をSAXで読み込むためのハンドラ
+	/// DOMを作らずに1オブジェクトずつLevelObjectDataへ変換する
+	/// </summary>
+	class LevelDataSaxHandler final : public nlohmann::json_sax<nlohmann::json> {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="objectDatas">書き込み先</param>
+		/// <param name="stringInterner">タイプ名の登録先</param>
+		LevelDataSaxHandler(std::vector<LevelObjectData>& objectDatas, StringInterner& stringInterner);
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~LevelDataSaxHandler() override = default;
+
+	public:
+		//nlohmann::json_saxの実装
+		bool null() override;
+		bool boolean(bool value) override;
+		bool number_integer(number_integer_t value) override;
+		bool number_unsigned(number_unsigned_t value) override;
+		bool number_float(number_float_t value, const string_t&) override;
+		bool string(string_t& value) override;
+		bool binary(binary_t&) override;
+		bool start_object(std::size_t) override;
+		bool key(string_t& value) override;
+		bool end_object() override;
+		bool start_array(std::size_t) override;
+		bool end_array() override;
+		bool parse_error(std::size_t position, const std::string& lastToken, const nlohmann::detail::exception& exception) override;
+
+	public:
+		/// <summary>
+		/// 正しいレベルデータだったかどうか
+		/// "name"が"scene"になっているか
+		/// </summary>
+		/// <returns>正しいかどうか</returns>
+		inline bool GetIsValidScene()const {
+			return isValidScene_;
+		}
+
+	private:
+		/// <summary>
+		/// 今いる階層
+		/// </summary>
+		enum class Scope {
+			//一番外側
+			Root,
+			//"objects"の配列
+			Objects,
+			//オブジェクト1つ分
+			Object,
+			//"transform"
+			Transform,
+			//"collider"
+			Collider,
+			//"audio"
+			Audio,
+			//3要素の配列
+			Vector,
+		};
+
+	private:
+		/// <summary>
+		/// 数値の書き込み
+		/// </summary>
+		/// <param name="value">値</param>
+		/// <returns>続けるかどうか</returns>
+		bool WriteNumber(const double& value);
+
+		/// <summary>
+		/// 今の階層の取得
+		/// </summary>
+		/// <returns>階層</returns>
+		inline Scope GetCurrentScope()const {
+			return scopes_.back();
+		}
+
+	private:
+		//書き込み先
+		std::vector<LevelObjectData>& objectDatas_;
+		//タイプ名の登録先
+		StringInterner& stringInterner_;
+
+		//階層
+		std::vector<Scope> scopes_;
+		//読み飛ばしている深さ
+		//"children"など使わない要素は丸ごと飛ばす
+		uint32_t skipDepth_ = 0u;
+		//直前のキー
+		std::string currentKey_;
+
+		//読み込み中のオブジェクト
+		LevelDataParser::RawObjectData rawObjectData_ = {};
+		//書き込み中のベクトル
+		Vector3* currentVector_ = nullptr;
+		//書き込み中のベクトルの要素番号
+		uint32_t currentVectorIndex_ = 0u;
+
+		//正しいレベルデータかどうか
+		bool isValidScene_ = false;
+
+	};
+
+};
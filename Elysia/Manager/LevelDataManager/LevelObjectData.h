@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file LevelObjectData.h
+ * @brief レベルデータのオブジェクト1つ分のデータ
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <string_view>
+
+#include "Vector3.h"
+#include "Transform.h"
+#include "AABB.h"
+#include "Model/AudioDataForLevelEditor.h"
+
+#pragma region 前方宣言
+
+/// <summary>
+/// レベルエディタ用のオブジェクト(基底クラス)
+/// </summary>
+class BaseObjectForLevelEditor;
+
+/// <summary>
+/// レベルエディタ用のコライダー(基底クラス)
+/// </summary>
+class BaseObjectForLevelEditorCollider;
+
+#pragma endregion
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// オブジェクトデータ
+	/// </summary>
+	struct LevelObjectData {
+		//オブジェクトのタイプ
+		//今はステージかオーディオのどちらか
+		//StringInternerに登録された文字列を指す
+		std::string_view type;
+
+		//個別の名前
+		std::string name;
+
+		//ファイル名
+		std::string modelFileName;
+
+		//トランスフォーム
+		Transform transform;
+		//初期トランスフォーム
+		Transform initialTransform;
+
+		//コライダーを持っているかどうか
+		bool isHavingCollider = false;
+
+		//Colliderの種類
+		//StringInternerに登録された文字列を指す
+		std::string_view colliderType;
+
+		//Sphere,Box
+		Vector3 center;
+		Vector3 size;
+
+		//AABB
+		AABB aabb;
+		Vector3 upSize;
+		Vector3 downSize;
+
+
+		//非表示設定
+		bool isInvisible = false;
+
+		//レベルデータのオーディオ
+		AudioDataForLevelEditor levelAudioData;
+
+		//オブジェクト(ステージかオーディオ)
+		BaseObjectForLevelEditor* objectForLeveEditor = nullptr;
+
+		//モデルを生成するかどうか
+		bool isModelGenerate = false;
+
+		//コライダー
+		BaseObjectForLevelEditorCollider* levelDataObjectCollider = nullptr;
+
+	};
+
+};
@@ -0,0 +1,68 @@
+#include "LevelObjectDiff.h"
+
+#include <string_view>
+#include <unordered_map>
+
+bool LevelObjectDiff::IsNeedRegenerate(const Elysia::LevelObjectData& previous, const Elysia::LevelObjectData& current) {
+	//種類かモデルが変わった
+	if (previous.type != current.type || previous.modelFileName != current.modelFileName) {
+		return true;
+	}
+
+	//音源の設定は生成時に渡しているので作り直す
+	if (previous.levelAudioData.fileName != current.levelAudioData.fileName ||
+		previous.levelAudioData.type != current.levelAudioData.type ||
+		previous.levelAudioData.isOnArea != current.levelAudioData.isOnArea ||
+		previous.levelAudioData.isLoop != current.levelAudioData.isLoop) {
+		return true;
+	}
+	return false;
+}
+
+LevelObjectDiff::Result LevelObjectDiff::Make(const std::vector<Elysia::LevelObjectData>& previousObjectDatas, const std::vector<Elysia::LevelObjectData>& currentObjectDatas) {
+
+	//名前から前回のオブジェクトを引けるようにする
+	//同じ名前が複数あるので全部の番号を前から順に持つ
+	//キーは前回のobjectDatasの名前を指すのでこの関数の中だけで使う
+	std::unordered_map<std::string_view, std::vector<uint32_t>> previousIndices;
+	previousIndices.reserve(previousObjectDatas.size());
+	for (uint32_t i = 0u; i < static_cast<uint32_t>(previousObjectDatas.size()); ++i) {
+		previousIndices[previousObjectDatas[i].name].push_back(i);
+	}
+	//同じ名前の中でいくつ目まで対応させたか
+	std::unordered_map<std::string_view, size_t> matchedCounts;
+	matchedCounts.reserve(previousIndices.size());
+
+	Result result = {};
+	result.entries.reserve(currentObjectDatas.size());
+	std::vector<bool> isMatched(previousObjectDatas.size(), false);
+	for (const Elysia::LevelObjectData& current : currentObjectDatas) {
+		//新しく追加された
+		std::unordered_map<std::string_view, std::vector<uint32_t>>::const_iterator it = previousIndices.find(current.name);
+		if (it == previousIndices.end()) {
+			result.entries.push_back({ .action = Action::Add,.previousIndex = 0u });
+			continue;
+		}
+		//同じ名前でも前回より数が増えた分は追加になる
+		size_t& matchedCount = matchedCounts[it->first];
+		if (matchedCount >= it->second.size()) {
+			result.entries.push_back({ .action = Action::Add,.previousIndex = 0u });
+			continue;
+		}
+
+		uint32_t previousIndex = it->second[matchedCount];
+		++matchedCount;
+		isMatched[previousIndex] = true;
+
+		Action action = (IsNeedRegenerate(previousObjectDatas[previousIndex], current) == true) ? Action::Regenerate : Action::Patch;
+		result.entries.push_back({ .action = action,.previousIndex = previousIndex });
+	}
+
+	//残ったものは消されたもの
+	for (uint32_t i = 0u; i < static_cast<uint32_t>(previousObjectDatas.size()); ++i) {
+		if (isMatched[i] == false) {
+			result.removedIndices.push_back(i);
+		}
+	}
+	return result;
+}
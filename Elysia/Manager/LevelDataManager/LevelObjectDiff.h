@@ -0,0 +1,72 @@
+#pragma once
+
+/**
+ * @file LevelObjectDiff.h
+ * @brief 再読み込みの前後でオブジェクトを名前で対応させる
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "LevelObjectData.h"
+
+/// <summary>
+/// 再読み込みの前後でオブジェクトを名前で対応させる
+/// 生成や削除はせず、何をするかだけを決める
+/// </summary>
+namespace LevelObjectDiff {
+
+	/// <summary>
+	/// 今回のオブジェクトに対してすること
+	/// </summary>
+	enum class Action {
+		//新しく追加されたので生成する
+		Add,
+		//生成時にしか決まらないものが変わったので作り直す
+		Regenerate,
+		//生成済みのものを引き継いで変わった所だけ反映する
+		Patch,
+	};
+
+	/// <summary>
+	/// 今回のオブジェクト1つ分の結果
+	/// </summary>
+	struct Entry {
+		//すること
+		Action action;
+		//対応する前回のオブジェクトの番号(Addの時は使わない)
+		uint32_t previousIndex;
+	};
+
+	/// <summary>
+	/// 結果
+	/// </summary>
+	struct Result {
+		//今回のオブジェクトと同じ並び
+		std::vector<Entry> entries;
+		//どれとも対応しなかった前回のオブジェクトの番号
+		//消されたものなので削除する
+		std::vector<uint32_t> removedIndices;
+	};
+
+	/// <summary>
+	/// 作り直す必要があるかどうか
+	/// モデルや音源など生成時にしか決まらないものが変わっていたら作り直す
+	/// </summary>
+	/// <param name="previous">前回のデータ</param>
+	/// <param name="current">今回のデータ</param>
+	/// <returns>作り直す必要があるかどうか</returns>
+	bool IsNeedRegenerate(const Elysia::LevelObjectData& previous, const Elysia::LevelObjectData& current);
+
+	/// <summary>
+	/// 前回と今回のオブジェクトを名前で対応させる
+	/// 同じ名前が複数ある場合は前から順に1つずつ対応させる
+	/// 前回のオブジェクトは必ずどれか1つの対応先かremovedIndicesのどちらかに入る
+	/// </summary>
+	/// <param name="previousObjectDatas">前回のオブジェクトデータ</param>
+	/// <param name="currentObjectDatas">今回のオブジェクトデータ</param>
+	/// <returns>結果</returns>
+	Result Make(const std::vector<Elysia::LevelObjectData>& previousObjectDatas, const std::vector<Elysia::LevelObjectData>& currentObjectDatas);
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * @file LevelObjectHandle.h
+ * @brief レベルデータのオブジェクトのハンドル
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// レベルデータのオブジェクトのハンドル
+	/// 名前から1度だけ引いておけば、以降は名前の比較無しで直接アクセスできる
+	/// 再読み込みしても同じ名前のオブジェクトを指し続ける
+	/// </summary>
+	struct LevelObjectHandle {
+
+		//無効な値
+		static constexpr uint32_t INVALID_ = UINT32_MAX;
+
+		//レベルデータのハンドル
+		uint32_t levelDataHandle = INVALID_;
+		//レベルデータ内の枠番号
+		uint32_t slot = INVALID_;
+
+		/// <summary>
+		/// 有効かどうか
+		/// </summary>
+		/// <returns>有効かどうか</returns>
+		inline bool GetIsValid()const {
+			return levelDataHandle != INVALID_ && slot != INVALID_;
+		}
+	};
+
+};
@@ -0,0 +1,45 @@
+#include "LevelObjectIndex.h"
+
+#include <algorithm>
+
+uint32_t Elysia::LevelObjectIndex::GetSlot(const std::string_view& name, StringInterner& stringInterner) {
+	//既にある枠を探す
+	std::unordered_map<std::string_view, uint32_t>::iterator it = slots_.find(name);
+	if (it != slots_.end()) {
+		return it->second;
+	}
+
+	//まだ無い名前でも枠だけ作っておく
+	uint32_t slot = static_cast<uint32_t>(indices_.size());
+	slots_.emplace(stringInterner.Intern(name), slot);
+	indices_.push_back(LevelObjectHandle::INVALID_);
+	return slot;
+}
+
+void Elysia::LevelObjectIndex::Build(const std::vector<LevelObjectData>& objectDatas, StringInterner& stringInterner) {
+
+	//一度全て無効にする
+	//枠自体は消さないので取得済みのハンドルはそのまま使える
+	std::fill(indices_.begin(), indices_.end(), LevelObjectHandle::INVALID_);
+	typeIndices_.clear();
+
+	for (uint32_t i = 0u; i < static_cast<uint32_t>(objectDatas.size()); ++i) {
+		const LevelObjectData& objectData = objectDatas[i];
+
+		//名前
+		//新しい枠のキーは文字列プールに入れる
+		std::unordered_map<std::string_view, uint32_t>::iterator it = slots_.find(objectData.name);
+		if (it == slots_.end()) {
+			it = slots_.emplace(stringInterner.Intern(objectData.name), static_cast<uint32_t>(indices_.size())).first;
+			indices_.push_back(LevelObjectHandle::INVALID_);
+		}
+		//同じ名前が複数ある場合は今まで通り先にある方を使う
+		uint32_t& index = indices_[it->second];
+		if (index == LevelObjectHandle::INVALID_) {
+			index = i;
+		}
+
+		//タイプ
+		typeIndices_[objectData.type].push_back(i);
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * @file LevelObjectIndex.h
+ * @brief レベルデータのオブジェクトを名前とタイプから引く索引
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "LevelObjectData.h"
+#include "LevelObjectHandle.h"
+#include "StringInterner.h"
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// レベルデータのオブジェクトの索引
+	/// 名前から枠番号、枠番号からobjectDatasの番号を引く
+	/// 枠は再読み込みしても変わらないのでハンドルに持たせられる
+	/// </summary>
+	class LevelObjectIndex final {
+	public:
+		/// <summary>
+		/// 名前から枠番号を取得
+		/// まだ無い名前でも枠だけ作っておく
+		/// </summary>
+		/// <param name="name">名前</param>
+		/// <param name="stringInterner">キーの登録先</param>
+		/// <returns>枠番号</returns>
+		uint32_t GetSlot(const std::string_view& name, StringInterner& stringInterner);
+
+		/// <summary>
+		/// 作り直す
+		/// objectDatasを入れ替えた後に呼ぶ
+		/// </summary>
+		/// <param name="objectDatas">オブジェクトデータ</param>
+		/// <param name="stringInterner">キーの登録先</param>
+		void Build(const std::vector<LevelObjectData>& objectDatas, StringInterner& stringInterner);
+
+	public:
+		/// <summary>
+		/// 枠番号からobjectDatasの番号を取得
+		/// </summary>
+		/// <param name="slot">枠番号</param>
+		/// <returns>objectDatasの番号。消されている場合はLevelObjectHandle::INVALID_</returns>
+		inline uint32_t GetIndex(const uint32_t& slot)const {
+			if (slot >= indices_.size()) {
+				return LevelObjectHandle::INVALID_;
+			}
+			return indices_[slot];
+		}
+
+		/// <summary>
+		/// 指定したタイプのobjectDatasの番号を取得
+		/// </summary>
+		/// <param name="type">タイプ</param>
+		/// <returns>objectDatasの番号</returns>
+		inline const std::vector<uint32_t>& GetTypeIndices(const std::string_view& type)const {
+			//無い場合に返す空のリスト
+			static const std::vector<uint32_t> EMPTY_INDICES = {};
+			std::unordered_map<std::string_view, std::vector<uint32_t>>::const_iterator it = typeIndices_.find(type);
+			return (it != typeIndices_.end()) ? it->second : EMPTY_INDICES;
+		}
+
+	private:
+		//名前から枠番号を引く
+		//キーはobjectDatasの名前ではなく文字列プールの中を指す
+		//objectDatasは再読み込みや削除で消えるため
+		std::unordered_map<std::string_view, uint32_t> slots_;
+		//枠番号から今のobjectDatasの番号を引く
+		//消されたオブジェクトの枠は無効な値になる
+		std::vector<uint32_t> indices_;
+		//タイプごとのobjectDatasの番号
+		//タイプは読み込み時に文字列プールに入れてある
+		std::unordered_map<std::string_view, std::vector<uint32_t>> typeIndices_;
+	};
+}
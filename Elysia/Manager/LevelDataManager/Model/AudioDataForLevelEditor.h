@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @file AudioDataForLevelEditor.h
+ * @brief レベルエディタで設定したオーディオのデータ
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <cstdint>
+
+/// <summary>
+/// オーディオオブジェクトのデータ
+/// </summary>
+struct AudioDataForLevelEditor {
+
+	//ファイル名
+	std::string fileName;
+
+	//種類(BGMかSE)
+	std::string type;
+
+	//ハンドル
+	uint32_t handle;
+
+	//エリア上かどうか
+	bool isOnArea;
+
+	//ループ
+	bool isLoop;
+};
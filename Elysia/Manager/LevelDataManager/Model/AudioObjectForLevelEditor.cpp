@@ -16,11 +16,8 @@ void AudioObjectForLevelEditor::Initialize(const uint32_t& modelhandle, const Tr
 	//モデルの生成
 	model_.reset(Elysia::Model::Create(modelhandle));
 
-	//ワールドトランスフォームの初期化
-	worldTransform_.Initialize();
-	worldTransform_.scale = transform.scale;
-	worldTransform_.rotate = transform.rotate;
-	worldTransform_.translate = transform.translate;
+	//トランスフォームの生成
+	CreateTransform(transform);
 
 	//マテリアルの初期化
 	material_.Initialize();
@@ -38,8 +35,7 @@ void AudioObjectForLevelEditor::Initialize(const uint32_t& modelhandle, const Tr
 
 void AudioObjectForLevelEditor::Update(){
 
-	//ワールドトランスフォームの更新
-	worldTransform_.Update();
+	//トランスフォームはLevelDataManagerでまとめて更新している
 	//マテリアルはDrawでやっているのでここには無いよ
 
 	switch (audioType_) {
@@ -58,7 +54,7 @@ void AudioObjectForLevelEditor::Update(){
 	
 #ifdef _DEBUG
 
-	Vector3 position = worldTransform_.GetWorldPosition();
+	Vector3 position = GetWorldPosition();
 	int32_t handleInt = static_cast<int32_t>(audioDataForLevelEditor_.handle);
 	ImGui::Begin("オーディオオブジェクト"); 
 	ImGui::InputFloat3("位置", &position.x);
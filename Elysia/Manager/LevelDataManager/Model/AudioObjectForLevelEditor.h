@@ -14,6 +14,7 @@
 #include "BaseObjectForLevelEditor.h"
 #include "AudioObjectForLevelEditorCollider.h"
 #include "Audio.h"
+#include "AudioDataForLevelEditor.h"
 
 #pragma region 前方宣言
 /// <summary>
@@ -52,27 +53,6 @@ enum AudioObjectType {
 	ActionType,
 };
 
-/// <summary>
-/// オーディオオブジェクトのデータ
-/// </summary>
-struct AudioDataForLevelEditor {
-
-	//ファイル名
-	std::string fileName;
-
-	//種類(BGMかSE)
-	std::string type;
-
-	//ハンドル
-	uint32_t handle;
-
-	//エリア上かどうか
-	bool isOnArea;
-
-	//ループ
-	bool isLoop;
-};
-
 /// <summary>
 /// オーディオ用のオブジェクト
 /// </summary>
@@ -1,12 +1,29 @@
 #include "BaseObjectForLevelEditor.h"
 
+#include <cassert>
+
+BaseObjectForLevelEditor::~BaseObjectForLevelEditor(){
+	//番号を返して次に生成するもので使い回す
+	if (transformHierarchy_ != nullptr) {
+		transformHierarchy_->Destroy(transformNode_);
+	}
+}
+
+void BaseObjectForLevelEditor::CreateTransform(const Transform& transform){
+	assert(transformHierarchy_ != nullptr);
+	transformNode_ = transformHierarchy_->Create();
+	transformHierarchy_->SetScale(transformNode_, transform.scale);
+	transformHierarchy_->SetRotate(transformNode_, transform.rotate);
+	transformHierarchy_->SetTranslate(transformNode_, transform.translate);
+}
+
 void BaseObjectForLevelEditor::Draw(const Camera& camera){
 	//ライティング無しに設定
 	material_.lightingKinds = LightingType::NoneLighting;
 	//変更したのでここで更新させる
 	material_.Update();
 	//モデルの描画
-	model_->Draw(worldTransform_, camera, material_);
+	model_->Draw(*transformHierarchy_, transformNode_, camera, material_);
 }
 
 void BaseObjectForLevelEditor::Draw(const Camera& camera, const DirectionalLight& directionalLight){
@@ -15,7 +32,7 @@ void BaseObjectForLevelEditor::Draw(const Camera& camera, const DirectionalLight
 	//変更したのでここで更新させる
 	material_.Update();
 	//モデルの描画
-	model_->Draw(worldTransform_, camera, material_, directionalLight);
+	model_->Draw(*transformHierarchy_, transformNode_, camera, material_, directionalLight);
 }
 
 void BaseObjectForLevelEditor::Draw(const Camera& camera, const PointLight& pointLight){
@@ -24,7 +41,7 @@ void BaseObjectForLevelEditor::Draw(const Camera& camera, const PointLight& poin
 	//変更したのでここで更新させる
 	material_.Update();
 	//モデルの描画
-	model_->Draw(worldTransform_, camera, material_, pointLight);
+	model_->Draw(*transformHierarchy_, transformNode_, camera, material_, pointLight);
 }
 
 void BaseObjectForLevelEditor::Draw(const Camera& camera, const SpotLight& spotLight){
@@ -33,5 +50,5 @@ void BaseObjectForLevelEditor::Draw(const Camera& camera, const SpotLight& spotL
 	//変更したのでここで更新させる
 	material_.Update();
 	//モデルの描画
-	model_->Draw(worldTransform_, camera, material_, spotLight);
+	model_->Draw(*transformHierarchy_, transformNode_, camera, material_, spotLight);
 }
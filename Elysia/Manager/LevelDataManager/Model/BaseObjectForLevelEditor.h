@@ -7,7 +7,7 @@
  */
 
 #include "Model.h"
-#include "WorldTransform.h"
+#include "TransformHierarchy.h"
 #include "Vector3.h"
 #include "Material.h"
 #include "AABB.h"
@@ -74,8 +74,9 @@ public:
 
 	/// <summary>
 	/// デストラクタ
+	/// トランスフォームの番号を返す
 	/// </summary>
-	virtual ~BaseObjectForLevelEditor() = default;
+	virtual ~BaseObjectForLevelEditor();
 
 
 public:
@@ -84,7 +85,7 @@ public:
 	/// </summary>
 	/// <returns></returns>
 	virtual Vector3 GetWorldPosition()const {
-		return worldTransform_.GetWorldPosition();
+		return transformHierarchy_->GetWorldPosition(transformNode_);
 	};
 
 	/// <summary>
@@ -97,6 +98,15 @@ public:
 
 
 public:
+	/// <summary>
+	/// トランスフォームをまとめて持つ先の設定
+	/// Initializeより前に設定する
+	/// </summary>
+	/// <param name="transformHierarchy">レベルデータごとのトランスフォーム</param>
+	inline void SetTransformHierarchy(Elysia::TransformHierarchy* transformHierarchy) {
+		this->transformHierarchy_ = transformHierarchy;
+	}
+
 	/// <summary>
 	/// 衝突したかどうかの設定
 	/// Colliderから持ってくる
@@ -121,7 +131,7 @@ public:
 	/// </summary>
 	/// <param name="scale"></param>
 	inline void SetScale(const Vector3& scale) {
-		this->worldTransform_.scale = scale;
+		transformHierarchy_->SetScale(transformNode_, scale);
 	}
 
 	/// <summary>
@@ -129,7 +139,7 @@ public:
 	/// </summary>
 	/// <param name="rotate"></param>
 	inline void SetRotate(const Vector3& rotate) {
-		this->worldTransform_.rotate = rotate;
+		transformHierarchy_->SetRotate(transformNode_, rotate);
 	}
 
 	/// <summary>
@@ -137,7 +147,7 @@ public:
 	/// </summary>
 	/// <param name="position"></param>
 	inline void SetPositione(const Vector3& position) {
-		this->worldTransform_.translate = position;
+		transformHierarchy_->SetTranslate(transformNode_, position);
 	}
 
 	/// <summary>
@@ -157,12 +167,22 @@ public:
 	}
 
 
+protected:
+	/// <summary>
+	/// トランスフォームの生成
+	/// </summary>
+	/// <param name="transform">初期値</param>
+	void CreateTransform(const Transform& transform);
+
 protected:
 	//モデル
 	std::unique_ptr<Elysia::Model> model_ = nullptr;
 
-	//ワールドトランスフォーム
-	WorldTransform worldTransform_ = {};
+	//トランスフォーム
+	//レベルデータごとにまとめて計算し、定数バッファにも1回で書き込む
+	Elysia::TransformHierarchy* transformHierarchy_ = nullptr;
+	//トランスフォームの番号
+	uint32_t transformNode_ = Elysia::TransformHierarchy::NO_PARENT_;
 	//マテリアル
 	Material material_ = {};
 
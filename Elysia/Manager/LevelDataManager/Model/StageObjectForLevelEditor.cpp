@@ -12,11 +12,8 @@ void StageObjectForLevelEditor::Initialize(const uint32_t& modelhandle, const Tr
 	//モデルの生成
 	model_.reset(Elysia::Model::Create(modelhandle));
 
-	//ワールドトランスフォームの初期化
-	worldTransform_.Initialize();
-	worldTransform_.scale = transform.scale;
-	worldTransform_.rotate = transform.rotate;
-	worldTransform_.translate = transform.translate;
+	//トランスフォームの生成
+	CreateTransform(transform);
 
 	//マテリアルの初期化
 	material_.Initialize();
@@ -25,19 +22,18 @@ void StageObjectForLevelEditor::Initialize(const uint32_t& modelhandle, const Tr
 
 void StageObjectForLevelEditor::Update(){
 
-	//ワールドトランスフォームの更新
-	worldTransform_.Update();
+	//トランスフォームはLevelDataManagerでまとめて更新している
 	//マテリアルはDrawでやっているのでここには無いよ
 
 	//AABBの設定
 	aabb_ = {
-		.min = VectorCalculation::Subtract(worldTransform_.GetWorldPosition(),size_),
-		.max = VectorCalculation::Add(worldTransform_.GetWorldPosition(),size_)
+		.min = VectorCalculation::Subtract(GetWorldPosition(),size_),
+		.max = VectorCalculation::Add(GetWorldPosition(),size_)
 	};
 
 #ifdef _DEBUG
 	ImGui::Begin("ステージオブジェクト"); 
-	Vector3 position = worldTransform_.GetWorldPosition();
+	Vector3 position = GetWorldPosition();
 	ImGui::InputFloat3("座標", &position.x);
 	ImGui::InputFloat3("AABB_Max", &aabb_.max.x);
 	ImGui::InputFloat3("AABB_Min", &aabb_.min.x);
@@ -4,8 +4,6 @@
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
-#include <VectorCalculation.h>
-#include <Calculation/QuaternionCalculation.h>
 
 Animation LoadAnimationFile(const std::string& directoryPath, const std::string& fileName){
     Animation animation = {};
@@ -72,69 +70,3 @@ Animation LoadAnimationFile(const std::string& directoryPath, const std::string&
 
     return animation;
 }
-
-Vector3 CalculationValue(const std::vector<KeyFrameVector3>& keyFrames, float time){
-    //特殊なケースを除外
-    //キーが無いものは✕
-    assert(!keyFrames.empty());
-    //キーが1つか、時刻がキーフレーム前なら最初の値とする
-    if (keyFrames.size() == 1 || time<=keyFrames[0].time) {
-        return keyFrames[0].value;
-    }
-
-    for (size_t index = 0; index < keyFrames.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        //indexとnextIndexの2つのkeyFrameを取得して範囲内に時刻があるかを判定
-        if (keyFrames[index].time <= time && time <= keyFrames[nextIndex].time) {
-            //範囲内を補間する
-            float t = (time - keyFrames[index].time) / (keyFrames[nextIndex].time - keyFrames[index].time);
-            //Vector3 だと線形補間
-            return VectorCalculation::Lerp(keyFrames[index].value, keyFrames[nextIndex].value, t);
-        }
-    }
-
-    //ここまで来た場合は一番後ろの時刻よりも後ろなので最後の値を返すことにする
-    return (*keyFrames.rbegin()).value;
-
-}
-
-Quaternion CalculationValue(const std::vector<KeyFrameQuaternion>& keyFrames, float time) {
-    //特殊なケースを除外
-    //キーが無いものは✕
-    assert(!keyFrames.empty());
-    //キーが1つか、時刻がキーフレーム前なら最初の値とする
-    if (keyFrames.size() == 1 || time<=keyFrames[0].time) {
-        return keyFrames[0].value;
-    }
-
-    for (size_t index = 0; index < keyFrames.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        //indexとnextIndexの2つのkeyFrameを取得して範囲内に時刻があるかを判定
-        if (keyFrames[index].time <= time && time <= keyFrames[nextIndex].time) {
-            //範囲内を補間する
-            float t = (time - keyFrames[index].time) / (keyFrames[nextIndex].time - keyFrames[index].time);
-            //QuaternionだとSlerp
-            return QuaternionCalculation::QuaternionSlerp(keyFrames[index].value, keyFrames[nextIndex].value, t);
-        }
-    }
-    //ここまで来た場合は一番後ろの時刻よりも後ろなので最後の値を返すことにする
-    return (*keyFrames.rbegin()).value;
-}
-
-void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime){
-
-    for (Joint& joint : skeleton.joints) {
-        //対象のJointのAnimation
-        //対象のJointのAnimationがあれば、値の適用を行う。下記のif文はC++17から可能になった
-        
-        if (auto it = animation.nodeAnimations.find(joint.name); it != animation.nodeAnimations.end()) {
-            //NodeAnimation& rootNodeAnimation=std::fmodf(animation.nodeAnimations[])
-            const NodeAnimation& rootNodeAnimation = (*it).second;
-            joint.transform.translate = CalculationValue(rootNodeAnimation.translate.keyFrames, animationTime);
-            joint.transform.rotate = CalculationValue(rootNodeAnimation.rotate.keyFrames, animationTime);
-            joint.transform.scale = CalculationValue(rootNodeAnimation.scale.keyFrames, animationTime);
-        }
-
-    }
-}
-
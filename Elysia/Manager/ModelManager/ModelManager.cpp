@@ -10,6 +10,7 @@
 #include "Matrix4x4Calculation.h"
 #include <Calculation/QuaternionCalculation.h>
 #include <StringOption.h>
+#include "Profiler.h"
 
 static uint32_t modelhandle;
 
@@ -130,6 +131,7 @@ ModelData Elysia::ModelManager::LoadFileForLeveldata(const std::string& fileName
 }
 
 uint32_t Elysia::ModelManager::LoadModelFileForLevelData(const std::string& directoryPath, const std::string& fileName) {
+	ELYSIA_PROFILE_SCOPE("ModelManager::LoadModelFileForLevelData");
 
 
 	//一度読み込んだものはその値を返す
@@ -278,6 +280,7 @@ ModelData Elysia::ModelManager::LoadFile(const std::string& directoryPath, const
 }
 
 uint32_t Elysia::ModelManager::LoadModelFile(const std::string& directoryPath, const std::string& fileName) {
+	ELYSIA_PROFILE_SCOPE("ModelManager::LoadModelFile");
 
 	//一度読み込んだものはその値を返す
 	//新規は勿論読み込みをする
@@ -314,6 +317,7 @@ uint32_t Elysia::ModelManager::LoadModelFile(const std::string& directoryPath, c
 }
 
 uint32_t Elysia::ModelManager::LoadModelFile(const std::string& directoryPath, const std::string& fileName, bool isAnimationLoad) {
+	ELYSIA_PROFILE_SCOPE("ModelManager::LoadModelFile");
 	//一度読み込んだものはその値を返す
 	//新規は勿論読み込みをする
 	std::string filePath = directoryPath + "/" + fileName;
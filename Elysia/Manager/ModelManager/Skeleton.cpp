@@ -1,6 +1,6 @@
 #include "Skeleton.h"
 #include <Matrix4x4Calculation.h>
-#include <Calculation/QuaternionCalculation.h>
+#include "Profiler.h"
 
 void Skeleton::Create(const Node& rootNode){
     root = CreateJoint(rootNode, {}, joints);
@@ -14,15 +14,12 @@ void Skeleton::Create(const Node& rootNode){
 }
 
 void Skeleton::Update(){
+    ELYSIA_PROFILE_SCOPE("Skeleton::Update");
     //全てのJointを更新。親が若いので通常ループで処理可能になっている。
     for (Joint& joint : joints) {
 
-        Matrix4x4 scaleMatrix = Matrix4x4Calculation::MakeScaleMatrix(joint.transform.scale);
-        Matrix4x4 rotateMatrix = QuaternionCalculation::MakeRotateMatrix(joint.transform.rotate);
-        Matrix4x4 translateMatrix = Matrix4x4Calculation::MakeTranslateMatrix(joint.transform.translate);
-        
-
-        joint.localMatrix = Matrix4x4Calculation::Multiply(scaleMatrix,Matrix4x4Calculation::Multiply(rotateMatrix, translateMatrix));
+        //SRTを直接合成
+        joint.localMatrix = Matrix4x4Calculation::MakeQuaternionAffineMatrix(joint.transform.scale, joint.transform.rotate, joint.transform.translate);
 
         //親がいれば親の行列を掛ける
         if (joint.parent) {
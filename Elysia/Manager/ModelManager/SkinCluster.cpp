@@ -5,29 +5,23 @@
 #include <PipelineManager.h>
 #include "ModelManager.h"
 #include <cassert>
+#include "Profiler.h"
+
+SkinCluster::~SkinCluster(){
+    Release();
+}
 
 void  SkinCluster::Create(const Skeleton& newSkeleton, const ModelData& modelData){
     skeleton = newSkeleton;
 
     //DirectXクラスを取得
     Elysia::DirectXSetup* directXSetup = Elysia::DirectXSetup::GetInstance();
-    //SRV管理クラスを取得
-    Elysia::SrvManager* srvManager = Elysia::SrvManager::GetInstance();
-
 
-    //palette用のリソースを生成
-    paletteResource = directXSetup->CreateBufferResource(sizeof(WellForGPU) * skeleton.joints.size());
-    WellForGPU* wellForGPU = nullptr;
-    paletteResource->Map(0u, nullptr, reinterpret_cast<void**>(&wellForGPU));
-    //spanを使ってアクセスするようにする
-    mappedPalette = { wellForGPU,skeleton.joints.size() };
-    srvIndex = srvManager->Allocate();
-    paletteSrvHandle.first = srvManager->GetCPUDescriptorHandle(srvIndex);
-    paletteSrvHandle.second = srvManager->GetGPUDescriptorHandle(srvIndex);
-    paletteResource->Unmap(0u, nullptr);
 
-    //Palette用のSRVの生成
-    srvManager->CreateSRVForPalette(static_cast<UINT>(skeleton.joints.size()), sizeof(WellForGPU), paletteResource.Get(), srvIndex);
+    //palette用のバッファを生成
+    //フレームの数だけリソースとSRVが作られる
+    palette.resize(skeleton.joints.size());
+    paletteBuffer.Initialize(static_cast<uint32_t>(skeleton.joints.size()), sizeof(WellForGPU));
 
 
 
@@ -44,7 +38,6 @@ void  SkinCluster::Create(const Skeleton& newSkeleton, const ModelData& modelDat
     influenceBufferView.BufferLocation = influenceResource->GetGPUVirtualAddress();
     influenceBufferView.SizeInBytes = UINT(sizeof(VertexInfluence) * modelData.vertices.size());
     influenceBufferView.StrideInBytes = sizeof(VertexInfluence);
-    influenceResource->Unmap(0u, nullptr);
 
     //InfluenceBindPoseMatrixの保存領域を作成
     inverseBindPoseMatrices.resize(skeleton.joints.size());
@@ -86,17 +79,37 @@ void  SkinCluster::Create(const Skeleton& newSkeleton, const ModelData& modelDat
             }
         }
     }
+
+    //書き終わったのでUnmapする
+    //Unmapした後のアドレスには書き込まない
+    influenceResource->Unmap(0u, nullptr);
+    mappedInfluence = {};
 }
 
 void SkinCluster::Update(const Skeleton& newSkeleton){
+    ELYSIA_PROFILE_SCOPE("SkinCluster::Update");
     for (size_t jointIndex = 0; jointIndex < newSkeleton.joints.size(); ++jointIndex) {
         assert(jointIndex < inverseBindPoseMatrices.size());
         //それぞれの行列を計算
-        mappedPalette[jointIndex].skeletonSpaceMatrix =
+        palette[jointIndex].skeletonSpaceMatrix =
             Matrix4x4Calculation::Multiply(inverseBindPoseMatrices[jointIndex], newSkeleton.joints[jointIndex].skeletonSpaceMatrix);
-        mappedPalette[jointIndex].skeletonSpaceIncerseTransposeMatrix = 
-            Matrix4x4Calculation::MakeTransposeMatrix(Matrix4x4Calculation::Inverse(mappedPalette[jointIndex].skeletonSpaceMatrix));
+        palette[jointIndex].skeletonSpaceIncerseTransposeMatrix = 
+            Matrix4x4Calculation::MakeTransposeMatrix(Matrix4x4Calculation::InverseAffine(palette[jointIndex].skeletonSpaceMatrix));
     }
 
+    //今のフレームのバッファに書き込む
+    paletteBuffer.Write(palette.data(), sizeof(WellForGPU) * palette.size());
+
+}
 
+void SkinCluster::Release(){
+    //SRVを解放
+    //GPUが今のフレームを使い終わってから使い回される
+    paletteBuffer.Release();
+
+    //Influenceのリソースも同じく解放する
+    if (influenceResource != nullptr) {
+        Elysia::DirectXSetup::GetInstance()->DeferRelease(std::move(influenceResource));
+        influenceBufferView = {};
+    }
 }
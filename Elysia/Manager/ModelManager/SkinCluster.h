@@ -17,11 +17,38 @@
 #include "ModelData.h"
 #include "WorldTransform.h"
 #include "Camera.h"
+#include "FrameBufferedStructuredBuffer.h"
 
 /// <summary>
 /// スキンクラスター
 /// </summary>
 struct SkinCluster {
+public:
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	SkinCluster() = default;
+
+	/// <summary>
+	/// デストラクタ
+	/// 解放し忘れてもSRVとリソースを返す
+	/// </summary>
+	~SkinCluster();
+
+	/// <summary>
+	/// コピーコンストラクタ禁止
+	/// SRVを2回解放してしまうため
+	/// </summary>
+	/// <param name="skinCluster"></param>
+	SkinCluster(const SkinCluster& skinCluster) = delete;
+
+	/// <summary>
+	/// 代入演算子を無効にする
+	/// </summary>
+	/// <param name="skinCluster"></param>
+	/// <returns></returns>
+	SkinCluster& operator=(const SkinCluster& skinCluster) = delete;
+
 public:
 	/// <summary>
 	/// SkinClusterを作る
@@ -36,6 +63,13 @@ public:
 	/// <param name="newSkeleton"></param>
 	void Update(const Skeleton& newSkeleton);
 
+	/// <summary>
+	/// 解放
+	/// 使わなくなったらSRVとリソースを返す
+	/// 何度呼んでも良い。デストラクタでも呼ばれる
+	/// </summary>
+	void Release();
+
 	
 public:
 	//逆転置行列
@@ -49,12 +83,10 @@ public:
 
 	//MatrixPalette
 	//Skinningを行う際に必要な行列をSkeletonの全Jointの数だけ格納した配列
-	ComPtr<ID3D12Resource>paletteResource = nullptr;
-	std::span<WellForGPU> mappedPalette = {};
-	std::pair<D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE> paletteSrvHandle = {};
-	
-	//SRV
-	uint32_t srvIndex = 0u;
+	//更新の最後にpaletteBufferへまとめて書き込む
+	std::vector<WellForGPU> palette = {};
+	//GPUが前のフレームで読んでいる間に書き換えないようにフレームの数だけ持つ
+	Elysia::FrameBufferedStructuredBuffer paletteBuffer;
 	
 	//スケルトン
 	Skeleton skeleton = {};
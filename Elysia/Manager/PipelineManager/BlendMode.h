@@ -33,6 +33,7 @@ enum BlemdMode {
 	//Src*(1-Dest)+Dest*1
 	BlendModeScreen,
 
-
+	//数
+	BlendModeCount,
 
 };
@@ -1,6 +1,7 @@
 #include "PipelineManager.h"
 
 #include <vector>
+#include <utility>
 
 #include "WindowsSetup.h"
 #include "BlendMode.h"
@@ -76,6 +77,9 @@ void Elysia::PipelineManager::Initialize(){
 	// スプライト用のPSOを生成
 	GenerateSpritePSO();
 
+	// まとめて描くスプライト用のPSOを生成
+	GenerateSpriteBatchPSO();
+
 	// モデル用のPSOを生成
 	GenerateModelPSO();
 
@@ -626,6 +630,163 @@ void Elysia::PipelineManager::GenerateSpritePSO() {
 
 
 
+}
+
+void Elysia::PipelineManager::GenerateSpriteBatchPSO() {
+
+	PSOInformation& spriteBatchPSO = PipelineManager::GetInstance()->spriteBatchPSO_;
+
+	////RootSignatureを作成
+	//座標変換と色は頂点に入れてあるのでCBVはいらない
+	D3D12_ROOT_SIGNATURE_DESC descriptionRootSignature{};
+	descriptionRootSignature.Flags =
+		D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+
+	//テクスチャ
+	D3D12_DESCRIPTOR_RANGE descriptorRange[1] = {};
+	descriptorRange[0].BaseShaderRegister = 0;
+	descriptorRange[0].NumDescriptors = 1;
+	descriptorRange[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+	descriptorRange[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+	D3D12_ROOT_PARAMETER rootParameters[1] = {};
+	rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+	rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+	rootParameters[0].DescriptorTable.pDescriptorRanges = descriptorRange;
+	rootParameters[0].DescriptorTable.NumDescriptorRanges = _countof(descriptorRange);
+	descriptionRootSignature.pParameters = rootParameters;
+	descriptionRootSignature.NumParameters = _countof(rootParameters);
+
+	//サンプラーは普通のスプライトと同じ
+	D3D12_STATIC_SAMPLER_DESC staticSamplers[1] = {};
+	staticSamplers[0].Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+	staticSamplers[0].AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	staticSamplers[0].AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	staticSamplers[0].AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	staticSamplers[0].ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+	staticSamplers[0].MaxLOD = D3D12_FLOAT32_MAX;
+	staticSamplers[0].ShaderRegister = 0;
+	staticSamplers[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+	descriptionRootSignature.pStaticSamplers = staticSamplers;
+	descriptionRootSignature.NumStaticSamplers = _countof(staticSamplers);
+
+	//シリアライズしてバイナリにする
+	ComPtr<ID3DBlob> errorBlob = nullptr;
+	HRESULT hResult = D3D12SerializeRootSignature(&descriptionRootSignature,
+		D3D_ROOT_SIGNATURE_VERSION_1, &spriteBatchPSO.signatureBlob_, &errorBlob);
+	if (FAILED(hResult)) {
+		Elysia::WindowsSetup::GetInstance()->OutPutStringA(reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
+		assert(false);
+	}
+
+	//バイナリを元に生成
+	hResult = DirectXSetup::GetInstance()->GetDevice()->CreateRootSignature(0, spriteBatchPSO.signatureBlob_->GetBufferPointer(),
+		spriteBatchPSO.signatureBlob_->GetBufferSize(), IID_PPV_ARGS(&spriteBatchPSO.rootSignature_));
+	assert(SUCCEEDED(hResult));
+
+
+	////InputLayout
+	//SpriteBatchVertexと同じ並び
+	D3D12_INPUT_ELEMENT_DESC inputElementDescs[3] = {};
+	inputElementDescs[0].SemanticName = "POSITION";
+	inputElementDescs[0].SemanticIndex = 0;
+	inputElementDescs[0].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	inputElementDescs[0].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+
+	inputElementDescs[1].SemanticName = "TEXCOORD";
+	inputElementDescs[1].SemanticIndex = 0;
+	inputElementDescs[1].Format = DXGI_FORMAT_R32G32_FLOAT;
+	inputElementDescs[1].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+
+	inputElementDescs[2].SemanticName = "COLOR";
+	inputElementDescs[2].SemanticIndex = 0;
+	inputElementDescs[2].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	inputElementDescs[2].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+
+	D3D12_INPUT_LAYOUT_DESC inputLayoutDesc{};
+	inputLayoutDesc.pInputElementDescs = inputElementDescs;
+	inputLayoutDesc.NumElements = _countof(inputElementDescs);
+
+
+	////RasterizerState
+	D3D12_RASTERIZER_DESC rasterizerDesc{};
+	//裏面(時計回り)を表示しない
+	rasterizerDesc.CullMode = D3D12_CULL_MODE_BACK;
+	//三角形の中を塗りつぶす
+	rasterizerDesc.FillMode = D3D12_FILL_MODE_SOLID;
+
+
+	//ShaderをCompileする
+	spriteBatchPSO.vertexShaderBlob_ = DirectXSetup::GetInstance()->CompileShader(L"Resources/Shader/SpriteBatch/SpriteBatch.VS.hlsl", L"vs_6_0");
+	assert(spriteBatchPSO.vertexShaderBlob_ != nullptr);
+
+	spriteBatchPSO.pixelShaderBlob_ = DirectXSetup::GetInstance()->CompileShader(L"Resources/Shader/SpriteBatch/SpriteBatch.PS.hlsl", L"ps_6_0");
+	assert(spriteBatchPSO.pixelShaderBlob_ != nullptr);
+
+
+	//ブレンドモードごとにPSOを作る
+	//中身はGenerateSpritePSOと同じ
+	for (uint32_t blendMode = 0u; blendMode < BlendModeCount; ++blendMode) {
+		D3D12_BLEND_DESC blendDesc{};
+		blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+		blendDesc.RenderTarget[0].SrcBlendAlpha = D3D12_BLEND_ONE;
+		blendDesc.RenderTarget[0].BlendOpAlpha = D3D12_BLEND_OP_ADD;
+		blendDesc.RenderTarget[0].DestBlendAlpha = D3D12_BLEND_ZERO;
+
+		switch (blendMode) {
+		case BlendModeNone:
+			//ブレンド無し
+			blendDesc.RenderTarget[0].BlendEnable = false;
+			break;
+
+		case BlendModeNormal:
+			//通常ブレンド
+			blendDesc.RenderTarget[0].BlendEnable = TRUE;
+			blendDesc.RenderTarget[0].SrcBlend = D3D12_BLEND_SRC_ALPHA;
+			blendDesc.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;
+			blendDesc.RenderTarget[0].DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+			break;
+
+		case BlendModeAdd:
+			//加算ブレンド
+			blendDesc.RenderTarget[0].BlendEnable = TRUE;
+			blendDesc.RenderTarget[0].SrcBlend = D3D12_BLEND_SRC_ALPHA;
+			blendDesc.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;
+			blendDesc.RenderTarget[0].DestBlend = D3D12_BLEND_ONE;
+			break;
+
+		case BlendModeSubtract:
+			//減算ブレンド
+			blendDesc.RenderTarget[0].BlendEnable = TRUE;
+			blendDesc.RenderTarget[0].SrcBlend = D3D12_BLEND_SRC_ALPHA;
+			blendDesc.RenderTarget[0].BlendOp = D3D12_BLEND_OP_REV_SUBTRACT;
+			blendDesc.RenderTarget[0].DestBlend = D3D12_BLEND_ONE;
+			break;
+
+		case BlendModeMultiply:
+			//乗算ブレンド
+			blendDesc.RenderTarget[0].BlendEnable = TRUE;
+			blendDesc.RenderTarget[0].SrcBlend = D3D12_BLEND_ZERO;
+			blendDesc.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;
+			blendDesc.RenderTarget[0].DestBlend = D3D12_BLEND_SRC_COLOR;
+			break;
+
+		case BlendModeScreen:
+			//スクリーンブレンド
+			blendDesc.RenderTarget[0].BlendEnable = TRUE;
+			blendDesc.RenderTarget[0].SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+			blendDesc.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;
+			blendDesc.RenderTarget[0].DestBlend = D3D12_BLEND_ONE;
+			break;
+		}
+
+		GenaratePSO(spriteBatchPSO, inputLayoutDesc, blendDesc, rasterizerDesc);
+		PipelineManager::GetInstance()->spriteBatchGraphicsPipelineStates_[blendMode] = std::move(spriteBatchPSO.graphicsPipelineState_);
+	}
+
+	//通常ブレンドを代表にしておく
+	spriteBatchPSO.graphicsPipelineState_ = PipelineManager::GetInstance()->spriteBatchGraphicsPipelineStates_[BlendModeNormal];
+
 }
 
 void Elysia::PipelineManager::GenerateModelPSO() {
@@ -10,6 +10,7 @@
 #include <cassert>
 
 #include "DirectXSetup.h"
+#include "BlendMode.h"
 
 /// <summary>
 /// ElysiaEngine
@@ -70,6 +71,15 @@ namespace Elysia {
 			return spritePSO_.graphicsPipelineState_;
 		}
 
+		//コマンドに積むためのGetter(SpriteBatch)
+		ComPtr<ID3D12RootSignature> GetSpriteBatchRootSignature() {
+			return spriteBatchPSO_.rootSignature_;
+		}
+		ComPtr<ID3D12PipelineState> GetSpriteBatchGraphicsPipelineState(const uint32_t& blendMode) {
+			assert(blendMode < BlendModeCount);
+			return spriteBatchGraphicsPipelineStates_[blendMode];
+		}
+
 		//コマンドに積むためのGetter(Model)
 		ComPtr<ID3D12RootSignature> GetModelRootSignature() {
 			return modelPSO_.rootSignature_;
@@ -256,6 +266,12 @@ namespace Elysia {
 		/// </summary>
 		static void GenerateSpritePSO();
 
+		/// <summary>
+		/// まとめて描くスプライト用のPSOを生成
+		/// ブレンドモードごとに作る
+		/// </summary>
+		static void GenerateSpriteBatchPSO();
+
 		/// <summary>
 		/// モデル用のPSOを生成
 		/// </summary>
@@ -338,6 +354,9 @@ namespace Elysia {
 		PSOInformation linePSO_ = {};
 		//スプライト用
 		PSOInformation spritePSO_ = {};
+		//まとめて描くスプライト用
+		PSOInformation spriteBatchPSO_ = {};
+		ComPtr<ID3D12PipelineState> spriteBatchGraphicsPipelineStates_[BlendModeCount] = {};
 		//モデル用の変数
 		PSOInformation modelPSO_ = {};
 		//モデル用の変数
@@ -0,0 +1,119 @@
+#include "DescriptorAllocator.h"
+
+#include <cassert>
+#include <algorithm>
+
+void Elysia::DescriptorAllocator::Initialize(const uint32_t& firstIndex, const uint32_t& persistentCount, const uint32_t& transientCountPerFrame, const uint32_t& frameCount) {
+	assert(frameCount > 0u);
+
+	firstIndex_ = firstIndex;
+	persistentCount_ = persistentCount;
+	//世代は1から始める(0は無効なハンドル)
+	generations_.assign(persistentCount, 1u);
+	isUsed_.assign(persistentCount, false);
+	freeIndices_.clear();
+	unusedBegin_ = 0u;
+	pendingFrees_.clear();
+	usedCount_ = 0u;
+	highWater_ = 0u;
+
+	transientCountPerFrame_ = transientCountPerFrame;
+	frameCount_ = frameCount;
+	transientBegin_ = firstIndex_ + persistentCount_;
+	transientUsedCount_ = 0u;
+	transientHighWater_ = 0u;
+}
+
+Elysia::DescriptorHandle Elysia::DescriptorAllocator::Allocate() {
+	uint32_t slot = 0u;
+	//解放されたものを先に使う
+	if (freeIndices_.empty() == false) {
+		slot = freeIndices_.back();
+		freeIndices_.pop_back();
+	}
+	else {
+		//上限だったらassert
+		//解放待ちが残っている時はGPUが追いつけば空く
+		assert(unusedBegin_ < persistentCount_);
+		slot = unusedBegin_;
+		++unusedBegin_;
+	}
+
+	isUsed_[slot] = true;
+	++usedCount_;
+	highWater_ = std::max<uint32_t>(highWater_, usedCount_);
+
+	DescriptorHandle handle = {
+		.index = firstIndex_ + slot,
+		.generation = generations_[slot],
+	};
+	return handle;
+}
+
+void Elysia::DescriptorAllocator::Free(const DescriptorHandle& handle, const uint64_t& fenceValue) {
+	//二重解放や古いハンドル
+	assert(IsValid(handle) == true);
+
+	uint32_t slot = handle.index - firstIndex_;
+	isUsed_[slot] = false;
+	--usedCount_;
+	//ハンドルはここで無効にする
+	++generations_[slot];
+	if (generations_[slot] == 0u) {
+		generations_[slot] = 1u;
+	}
+
+	//GPUがまだ読むかもしれないので番号はすぐには使い回さない
+	assert(pendingFrees_.empty() == true || pendingFrees_.back().fenceValue <= fenceValue);
+	pendingFrees_.push_back({ .fenceValue = fenceValue, .index = slot });
+}
+
+uint32_t Elysia::DescriptorAllocator::Collect(const uint64_t& completedFenceValue) {
+	uint32_t count = 0u;
+	while (pendingFrees_.empty() == false && pendingFrees_.front().fenceValue <= completedFenceValue) {
+		freeIndices_.push_back(pendingFrees_.front().index);
+		pendingFrees_.pop_front();
+		++count;
+	}
+	return count;
+}
+
+bool Elysia::DescriptorAllocator::IsValid(const DescriptorHandle& handle)const {
+	if (handle.generation == 0u || handle.index < firstIndex_ || handle.index >= firstIndex_ + persistentCount_) {
+		return false;
+	}
+	uint32_t slot = handle.index - firstIndex_;
+	return isUsed_[slot] == true && generations_[slot] == handle.generation;
+}
+
+void Elysia::DescriptorAllocator::BeginFrame(const uint32_t& frameIndex) {
+	assert(frameIndex < frameCount_);
+
+	//フレームのコンテキストごとに領域を分けているので、
+	//このコンテキストを前に使ったフレームが終わっていれば頭から使い直せる
+	transientBegin_ = firstIndex_ + persistentCount_ + transientCountPerFrame_ * frameIndex;
+	transientUsedCount_ = 0u;
+}
+
+uint32_t Elysia::DescriptorAllocator::AllocateTransient(const uint32_t& count) {
+	//上限だったらassert
+	assert(transientUsedCount_ + count <= transientCountPerFrame_);
+
+	uint32_t index = transientBegin_ + transientUsedCount_;
+	transientUsedCount_ += count;
+	transientHighWater_ = std::max<uint32_t>(transientHighWater_, transientUsedCount_);
+	return index;
+}
+
+Elysia::DescriptorAllocator::Statistics Elysia::DescriptorAllocator::GetStatistics()const {
+	Statistics statistics = {
+		.persistentCapacity = persistentCount_,
+		.persistentUsedCount = usedCount_,
+		.persistentHighWater = highWater_,
+		.pendingFreeCount = static_cast<uint32_t>(pendingFrees_.size()),
+		.transientCapacity = transientCountPerFrame_,
+		.transientUsedCount = transientUsedCount_,
+		.transientHighWater = transientHighWater_,
+	};
+	return statistics;
+}
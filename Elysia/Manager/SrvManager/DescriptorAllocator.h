@@ -0,0 +1,160 @@
+#pragma once
+
+/**
+ * @file DescriptorAllocator.h
+ * @brief ディスクリプタの番号を管理するクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// ディスクリプタのハンドル
+	/// 解放した後に同じ番号が別のものに使われても、世代が違うので古いハンドルだと分かる
+	/// </summary>
+	struct DescriptorHandle {
+		//ヒープの中の番号
+		uint32_t index;
+		//世代(0は無効)
+		uint32_t generation;
+	};
+
+	/// <summary>
+	/// ディスクリプタの番号を管理するクラス
+	/// ヒープの中身には触らず番号だけを扱うのでDirectXが無くても動く
+	/// [最初の番号, +persistentCount)が解放できる領域、その後ろがフレームごとの一時的な領域
+	/// </summary>
+	class DescriptorAllocator final {
+	public:
+		/// <summary>
+		/// 統計
+		/// </summary>
+		struct Statistics {
+			//解放できる領域の数
+			uint32_t persistentCapacity;
+			//使っている数
+			uint32_t persistentUsedCount;
+			//使っている数の最大
+			uint32_t persistentHighWater;
+			//GPUが使い終わるのを待っている数
+			uint32_t pendingFreeCount;
+			//1フレームあたりの一時的な領域の数
+			uint32_t transientCapacity;
+			//今のフレームで使った一時的な数
+			uint32_t transientUsedCount;
+			//1フレームで使った一時的な数の最大
+			uint32_t transientHighWater;
+		};
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="firstIndex">最初の番号(それより前はImGuiなどが使う)</param>
+		/// <param name="persistentCount">解放できる領域の数</param>
+		/// <param name="transientCountPerFrame">1フレームあたりの一時的な領域の数</param>
+		/// <param name="frameCount">同時に処理するフレームの数</param>
+		void Initialize(const uint32_t& firstIndex, const uint32_t& persistentCount, const uint32_t& transientCountPerFrame, const uint32_t& frameCount);
+
+		/// <summary>
+		/// 確保
+		/// </summary>
+		/// <returns>ハンドル</returns>
+		DescriptorHandle Allocate();
+
+		/// <summary>
+		/// 解放
+		/// ハンドルはすぐ無効になるが、番号はGPUがフェンスの値を越えるまで使い回さない
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <param name="fenceValue">このフェンスの値をGPUが越えたら使い回して良い</param>
+		void Free(const DescriptorHandle& handle, const uint64_t& fenceValue);
+
+		/// <summary>
+		/// GPUが使い終わった番号を使い回せるようにする
+		/// </summary>
+		/// <param name="completedFenceValue">GPUが終わったフェンスの値</param>
+		/// <returns>使い回せるようになった数</returns>
+		uint32_t Collect(const uint64_t& completedFenceValue);
+
+		/// <summary>
+		/// ハンドルが有効かどうか
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns>有効かどうか</returns>
+		bool IsValid(const DescriptorHandle& handle)const;
+
+		/// <summary>
+		/// フレームの開始
+		/// このコンテキストを前に使ったフレームをGPUが終えてから呼ぶ
+		/// </summary>
+		/// <param name="frameIndex">フレームのコンテキストの番号</param>
+		void BeginFrame(const uint32_t& frameIndex);
+
+		/// <summary>
+		/// 今のフレームだけ使う番号を確保
+		/// 解放はいらない
+		/// </summary>
+		/// <param name="count">連続した数</param>
+		/// <returns>最初の番号</returns>
+		uint32_t AllocateTransient(const uint32_t& count);
+
+	public:
+		/// <summary>
+		/// 統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		Statistics GetStatistics()const;
+
+	private:
+		/// <summary>
+		/// 使い回し待ち
+		/// </summary>
+		struct PendingFree {
+			//使い回して良くなるフェンスの値
+			uint64_t fenceValue;
+			//番号
+			uint32_t index;
+		};
+
+		//最初の番号
+		uint32_t firstIndex_ = 0u;
+		//解放できる領域の数
+		uint32_t persistentCount_ = 0u;
+		//番号ごとの今の世代
+		//解放した時に進めるので古いハンドルは一致しなくなる
+		std::vector<uint32_t> generations_;
+		//番号ごとに使っているかどうか
+		std::vector<bool> isUsed_;
+		//使い回せる番号
+		std::vector<uint32_t> freeIndices_;
+		//まだ一度も使っていない最初の番号
+		uint32_t unusedBegin_ = 0u;
+		//フェンスの値が小さい順に並ぶ
+		std::deque<PendingFree> pendingFrees_;
+		//使っている数
+		uint32_t usedCount_ = 0u;
+		//使っている数の最大
+		uint32_t highWater_ = 0u;
+
+		//1フレームあたりの一時的な領域の数
+		uint32_t transientCountPerFrame_ = 0u;
+		//同時に処理するフレームの数
+		uint32_t frameCount_ = 0u;
+		//今のフレームの一時的な領域の最初の番号
+		uint32_t transientBegin_ = 0u;
+		//今のフレームで使った一時的な数
+		uint32_t transientUsedCount_ = 0u;
+		//1フレームで使った一時的な数の最大
+		uint32_t transientHighWater_ = 0u;
+
+	};
+
+}
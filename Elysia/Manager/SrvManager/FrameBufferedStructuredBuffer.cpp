@@ -0,0 +1,75 @@
+#include "FrameBufferedStructuredBuffer.h"
+
+#include <cstring>
+
+#include "SrvManager.h"
+
+Elysia::FrameBufferedStructuredBuffer::~FrameBufferedStructuredBuffer() {
+	Release();
+}
+
+void Elysia::FrameBufferedStructuredBuffer::Initialize(const uint32_t& elementCount, const uint32_t& elementSize) {
+	//作り直す場合は前のものを返す
+	Release();
+
+	DirectXSetup* directXSetup = DirectXSetup::GetInstance();
+	SrvManager* srvManager = SrvManager::GetInstance();
+	size_t sizeInBytes = size_t(elementCount) * elementSize;
+
+	//フレームの数だけリソースとSRVを作る
+	for (uint32_t i = 0u; i < DirectXSetup::FRAME_COUNT_; ++i) {
+		resources_[i] = directXSetup->CreateBufferResource(sizeInBytes);
+		//アップロードバッファなのでずっとMapしたままで良い
+		resources_[i]->Map(0u, nullptr, reinterpret_cast<void**>(&mappedDatas_[i]));
+		std::memset(mappedDatas_[i], 0, sizeInBytes);
+		srvHandles_[i] = srvManager->AllocateDescriptor();
+		srvManager->CreateSRVForStructuredBuffer(srvHandles_[i].index, resources_[i].Get(), elementCount, elementSize);
+	}
+	latestData_.assign(sizeInBytes, 0u);
+	latestSize_ = 0u;
+	version_ = 0u;
+	copiedVersions_.fill(0u);
+}
+
+void Elysia::FrameBufferedStructuredBuffer::Write(const void* data, const size_t& sizeInBytes) {
+	assert(sizeInBytes <= latestData_.size());
+	//最新の値を覚えておく
+	std::memcpy(latestData_.data(), data, sizeInBytes);
+	latestSize_ = sizeInBytes;
+	++version_;
+
+	//今のフレームの複製はGPUが使っていないのですぐ書き込む
+	uint32_t frameIndex = DirectXSetup::GetInstance()->GetFrameIndex();
+	std::memcpy(mappedDatas_[frameIndex], latestData_.data(), latestSize_);
+	copiedVersions_[frameIndex] = version_;
+}
+
+uint32_t Elysia::FrameBufferedStructuredBuffer::GetSrvIndex() const {
+	uint32_t frameIndex = DirectXSetup::GetInstance()->GetFrameIndex();
+	//前のフレームで書き換えた値がまだ写っていない
+	if (copiedVersions_[frameIndex] != version_) {
+		std::memcpy(mappedDatas_[frameIndex], latestData_.data(), latestSize_);
+		copiedVersions_[frameIndex] = version_;
+	}
+	return srvHandles_[frameIndex].index;
+}
+
+void Elysia::FrameBufferedStructuredBuffer::Release() {
+	if (latestData_.empty() == true) {
+		return;
+	}
+
+	//GPUが今のフレームを使い終わってから解放する
+	DirectXSetup* directXSetup = DirectXSetup::GetInstance();
+	SrvManager* srvManager = SrvManager::GetInstance();
+	for (uint32_t i = 0u; i < DirectXSetup::FRAME_COUNT_; ++i) {
+		if (srvManager->IsValid(srvHandles_[i]) == true) {
+			srvManager->Free(srvHandles_[i]);
+		}
+		srvHandles_[i] = {};
+		directXSetup->DeferRelease(std::move(resources_[i]));
+		mappedDatas_[i] = nullptr;
+	}
+	latestData_.clear();
+	latestSize_ = 0u;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * @file FrameBufferedStructuredBuffer.h
+ * @brief フレームの数だけ複製を持つStructuredBuffer
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <array>
+#include <vector>
+
+#include "DirectXSetup.h"
+#include "DescriptorAllocator.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// フレームの数だけ複製を持つStructuredBuffer
+	/// GPUが前のフレームで読んでいる間に書き換えないよう、今のフレームの複製にだけ書き込む
+	/// 書き換えなかったフレームの複製は、SRVを取得する時に最新の値を写す
+	/// 破棄する時にSRVとリソースをGPUが使い終わってから解放するように渡す
+	/// </summary>
+	class FrameBufferedStructuredBuffer final {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		FrameBufferedStructuredBuffer() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~FrameBufferedStructuredBuffer();
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// SRVを2回解放してしまうため
+		/// </summary>
+		/// <param name="buffer"></param>
+		FrameBufferedStructuredBuffer(const FrameBufferedStructuredBuffer& buffer) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="buffer"></param>
+		/// <returns></returns>
+		FrameBufferedStructuredBuffer& operator=(const FrameBufferedStructuredBuffer& buffer) = delete;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="elementCount">要素の数</param>
+		/// <param name="elementSize">1要素の大きさ</param>
+		void Initialize(const uint32_t& elementCount, const uint32_t& elementSize);
+
+		/// <summary>
+		/// 書き込み
+		/// 先頭から指定した大きさだけ書き換える
+		/// </summary>
+		/// <param name="data">データ</param>
+		/// <param name="sizeInBytes">大きさ</param>
+		void Write(const void* data, const size_t& sizeInBytes);
+
+		/// <summary>
+		/// 今のフレームで使うSRVのインデックスを取得
+		/// </summary>
+		/// <returns>インデックス</returns>
+		uint32_t GetSrvIndex() const;
+
+		/// <summary>
+		/// 解放
+		/// SRVとリソースはGPUが今のフレームを使い終わってから使い回される
+		/// </summary>
+		void Release();
+
+	public:
+		/// <summary>
+		/// 初期化済みかどうか
+		/// </summary>
+		/// <returns>初期化済みかどうか</returns>
+		inline bool GetIsInitialized()const {
+			return latestData_.empty() == false;
+		}
+
+	private:
+		//リソース
+		std::array<ComPtr<ID3D12Resource>, DirectXSetup::FRAME_COUNT_> resources_ = {};
+		//Mapしたままの先頭
+		std::array<uint8_t*, DirectXSetup::FRAME_COUNT_> mappedDatas_ = {};
+		//SRV
+		std::array<DescriptorHandle, DirectXSetup::FRAME_COUNT_> srvHandles_ = {};
+		//最新の値
+		std::vector<uint8_t> latestData_ = {};
+		//最新の値のうち書き込んだ大きさ
+		size_t latestSize_ = 0u;
+		//最新の値の番号
+		uint64_t version_ = 0u;
+		//複製ごとに写した値の番号
+		mutable std::array<uint64_t, DirectXSetup::FRAME_COUNT_> copiedVersions_ = {};
+
+	};
+}
@@ -1,5 +1,8 @@
 #include "SrvManager.h"
 
+#include <cassert>
+#include <numeric>
+
 
 Elysia::SrvManager* Elysia::SrvManager::GetInstance(){
 	static SrvManager instance;
@@ -19,22 +22,39 @@ void Elysia::SrvManager::Initialize(){
 	descriptorSize_ = DirectXSetup::GetInstance()->GetDevice()->
 		GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
+	//後ろをフレームごとの一時的な領域にする
+	uint32_t transientCount = TRANSIENT_SRV_COUNT_PER_FRAME_ * DirectXSetup::FRAME_COUNT_;
+	descriptorAllocator_.Initialize(FIRST_INDEX_, MAX_SRV_COUNT_ - FIRST_INDEX_ - transientCount, TRANSIENT_SRV_COUNT_PER_FRAME_, DirectXSetup::FRAME_COUNT_);
+
+	//最初はどれも自分自身を使う
+	redirectIndices_.resize(MAX_SRV_COUNT_);
+	std::iota(redirectIndices_.begin(), redirectIndices_.end(), 0u);
 
 }
 
 uint32_t Elysia::SrvManager::Allocate(){
+	//解放しないのでハンドルの世代は使わない
+	return descriptorAllocator_.Allocate().index;
+}
+
+Elysia::DescriptorHandle Elysia::SrvManager::AllocateDescriptor() {
+	return descriptorAllocator_.Allocate();
+}
 
-	//上限だったらasset
-	assert(useIndex_ < MAX_SRV_COUNT_);
+void Elysia::SrvManager::Free(const DescriptorHandle& handle) {
+	//今のフレームでSignalする値を越えたら使い回す
+	descriptorAllocator_.Free(handle, DirectXSetup::GetInstance()->GetFenceValue() + 1u);
+}
 
-	//return する番号を一旦記録しておく
-	int index = useIndex_;
+uint32_t Elysia::SrvManager::AllocateTransient(const uint32_t& count) {
+	return descriptorAllocator_.AllocateTransient(count);
+}
 
-	//次のために番号を1進める
-	useIndex_++;
-	
-	//上で記録した番号をreturn
-	return index;;
+void Elysia::SrvManager::BeginFrame() {
+	DirectXSetup* directXSetup = DirectXSetup::GetInstance();
+	descriptorAllocator_.Collect(directXSetup->GetCompletedFenceValue());
+	//このコンテキストを前に使ったフレームはGPUが終えている
+	descriptorAllocator_.BeginFrame(directXSetup->GetFrameIndex());
 }
 
 
@@ -166,5 +186,10 @@ void Elysia::SrvManager::PreDraw() {
 void Elysia::SrvManager::SetGraphicsRootDescriptorTable(const UINT& rootParameterIndex,const uint32_t& srvIndex){
 	DirectXSetup::GetInstance()->GetCommandList()->SetGraphicsRootDescriptorTable(
 		rootParameterIndex,
-		GetGPUDescriptorHandle(srvIndex));
+		GetGPUDescriptorHandle(redirectIndices_[srvIndex]));
+}
+
+void Elysia::SrvManager::Redirect(const uint32_t& srvIndex, const uint32_t& targetIndex) {
+	assert(srvIndex < MAX_SRV_COUNT_ && targetIndex < MAX_SRV_COUNT_);
+	redirectIndices_[srvIndex] = targetIndex;
 }
@@ -7,6 +7,7 @@
  */
 
 #include "DirectXSetup.h"
+#include "DescriptorAllocator.h"
 
 /// <summary>
 /// ElysiaEngine
@@ -55,11 +56,38 @@ namespace Elysia {
 		void Initialize();
 
 		/// <summary>
-		/// 加算していく
+		/// 解放しないもの(テクスチャなど)の確保
 		/// </summary>
-		/// <returns></returns>
+		/// <returns>インデックス</returns>
 		uint32_t Allocate();
 
+		/// <summary>
+		/// 解放するものの確保
+		/// </summary>
+		/// <returns>ハンドル</returns>
+		DescriptorHandle AllocateDescriptor();
+
+		/// <summary>
+		/// 解放
+		/// GPUが今のフレームを使い終わってから使い回す
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		void Free(const DescriptorHandle& handle);
+
+		/// <summary>
+		/// 今のフレームだけ使うものの確保
+		/// 解放はいらない
+		/// </summary>
+		/// <param name="count">連続した数</param>
+		/// <returns>最初のインデックス</returns>
+		uint32_t AllocateTransient(const uint32_t& count);
+
+		/// <summary>
+		/// フレームの開始
+		/// 使い終わったものを使い回せるようにする
+		/// </summary>
+		void BeginFrame();
+
 		/// <summary>
 		/// 描画前処理
 		/// </summary>
@@ -114,6 +142,15 @@ namespace Elysia {
 		/// <param name="srvIndex"></param>
 		void SetGraphicsRootDescriptorTable(const UINT& rootParameterIndex, const uint32_t& srvIndex);
 
+		/// <summary>
+		/// ディスクリプタテーブルを設定する時に別のSRVを使うようにする
+		/// 描画中のフレームが使っているSRVは書き換えられないので、
+		/// 新しいSRVを作ってから元のインデックスをそちらに向ける(テクスチャのストリーミング用)
+		/// 記録を始める前にメインスレッドで呼んでね
+		/// </summary>
+		/// <param name="srvIndex">元のインデックス</param>
+		/// <param name="targetIndex">実際に使うインデックス</param>
+		void Redirect(const uint32_t& srvIndex, const uint32_t& targetIndex);
 
 	public:
 		/// <summary>
@@ -147,6 +184,23 @@ namespace Elysia {
 			return  descriptorHeap_;
 		}
 
+		/// <summary>
+		/// ハンドルが有効かどうか
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns>有効かどうか</returns>
+		inline bool IsValid(const DescriptorHandle& handle) const {
+			return descriptorAllocator_.IsValid(handle);
+		}
+
+		/// <summary>
+		/// 統計の取得
+		/// </summary>
+		/// <returns>統計</returns>
+		inline DescriptorAllocator::Statistics GetStatistics() const {
+			return descriptorAllocator_.GetStatistics();
+		}
+
 	private:
 		//最大SRV数
 		const uint32_t MAX_SRV_COUNT_ = 2024u;
@@ -161,8 +215,16 @@ namespace Elysia {
 		D3D12_CPU_DESCRIPTOR_HANDLE handleCPU_ = {};
 		D3D12_GPU_DESCRIPTOR_HANDLE handleGPU_ = {};
 
-		//次に使用するSRVインデックス
-		uint32_t useIndex_ = 1u;
+		//0番はImGuiが使う
+		const uint32_t FIRST_INDEX_ = 1u;
+		//1フレームあたりの一時的なSRV数
+		const uint32_t TRANSIENT_SRV_COUNT_PER_FRAME_ = 128u;
+
+		//インデックスの管理
+		DescriptorAllocator descriptorAllocator_;
+
+		//実際に使うインデックス(向け先を変えていなければ同じ)
+		std::vector<uint32_t> redirectIndices_;
 
 
 
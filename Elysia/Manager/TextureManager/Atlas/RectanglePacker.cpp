@@ -0,0 +1,125 @@
+#include "RectanglePacker.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+	/// <summary>
+	/// 倍数に切り上げる
+	/// </summary>
+	/// <param name="value">値</param>
+	/// <param name="alignment">倍数</param>
+	/// <returns>切り上げた値</returns>
+	uint32_t AlignUp(const uint32_t& value, const uint32_t& alignment) {
+		return (value + alignment - 1u) / alignment * alignment;
+	}
+}
+
+uint32_t Elysia::RectanglePacker::Pack(const std::vector<uint32_t>& widths, const std::vector<uint32_t>& heights, const uint32_t& maxWidth, const uint32_t& alignment, std::vector<PackedRectangle>& rectangles) {
+	size_t count = widths.size();
+	rectangles.assign(count, {});
+	skyline_.clear();
+	skyline_.push_back({ .x = 0u,.y = 0u,.width = maxWidth });
+
+	//高いものから置くと隙間が少ない
+	//同じ高さなら幅が広い方、それも同じなら入力の順
+	std::vector<size_t> order(count);
+	std::iota(order.begin(), order.end(), size_t(0u));
+	std::stable_sort(order.begin(), order.end(), [&heights, &widths](const size_t& a, const size_t& b) {
+		if (heights[a] != heights[b]) {
+			return heights[a] > heights[b];
+		}
+		return widths[a] > widths[b];
+	});
+
+	uint32_t usedHeight = 0u;
+	for (size_t index : order) {
+		uint32_t width = AlignUp(widths[index], alignment);
+		uint32_t height = AlignUp(heights[index], alignment);
+
+		//一番低く置ける所を探す
+		//同じ高さなら左
+		size_t bestNode = SIZE_MAX;
+		uint32_t bestBottom = UINT32_MAX;
+		uint32_t bestY = 0u;
+		for (size_t node = 0u; node < skyline_.size(); ++node) {
+			uint32_t y = 0u;
+			if (Fit(node, width, maxWidth, y) == false) {
+				continue;
+			}
+			if (y + height < bestBottom) {
+				bestNode = node;
+				bestBottom = y + height;
+				bestY = y;
+			}
+		}
+
+		//幅が足りない
+		if (bestNode == SIZE_MAX) {
+			rectangles.clear();
+			return 0u;
+		}
+
+		PackedRectangle rectangle = {
+			.x = skyline_[bestNode].x,
+			.y = bestY,
+			.width = width,
+			.height = height,
+		};
+		Place(bestNode, rectangle);
+		rectangles[index] = rectangle;
+		usedHeight = std::max<uint32_t>(usedHeight, bestBottom);
+	}
+
+	return usedHeight;
+}
+
+bool Elysia::RectanglePacker::Fit(const size_t& nodeIndex, const uint32_t& width, const uint32_t& maxWidth, uint32_t& y) const {
+	uint32_t x = skyline_[nodeIndex].x;
+	if (x + width > maxWidth) {
+		return false;
+	}
+
+	//幅の分だけ右の区間を見て一番高い所に置く
+	y = 0u;
+	uint32_t remainingWidth = width;
+	for (size_t node = nodeIndex; remainingWidth > 0u; ++node) {
+		y = std::max<uint32_t>(y, skyline_[node].y);
+		remainingWidth -= std::min<uint32_t>(remainingWidth, skyline_[node].width);
+	}
+	return true;
+}
+
+void Elysia::RectanglePacker::Place(const size_t& nodeIndex, const PackedRectangle& rectangle) {
+	//置いた所を新しい区間にする
+	SkylineNode newNode = {
+		.x = rectangle.x,
+		.y = rectangle.y + rectangle.height,
+		.width = rectangle.width,
+	};
+	skyline_.insert(skyline_.begin() + nodeIndex, newNode);
+
+	//隠れた区間を削る
+	uint32_t right = rectangle.x + rectangle.width;
+	size_t node = nodeIndex + 1u;
+	while (node < skyline_.size() && skyline_[node].x < right) {
+		uint32_t nodeRight = skyline_[node].x + skyline_[node].width;
+		if (nodeRight <= right) {
+			skyline_.erase(skyline_.begin() + node);
+			continue;
+		}
+		skyline_[node].width = nodeRight - right;
+		skyline_[node].x = right;
+		break;
+	}
+
+	//同じ高さの隣同士をまとめる
+	for (size_t i = 0u; i + 1u < skyline_.size();) {
+		if (skyline_[i].y == skyline_[i + 1u].y) {
+			skyline_[i].width += skyline_[i + 1u].width;
+			skyline_.erase(skyline_.begin() + i + 1u);
+			continue;
+		}
+		++i;
+	}
+}
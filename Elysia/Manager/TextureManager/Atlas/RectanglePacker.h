@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file RectanglePacker.h
+ * @brief 矩形を詰めるクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 詰めた矩形
+	/// </summary>
+	struct PackedRectangle {
+		//左上
+		uint32_t x;
+		uint32_t y;
+		//大きさ
+		uint32_t width;
+		uint32_t height;
+	};
+
+	/// <summary>
+	/// 矩形を詰めるクラス
+	/// 幅を決めて下から積んでいくスカイライン法
+	/// 同じ入力なら必ず同じ結果になる
+	/// </summary>
+	class RectanglePacker final {
+	public:
+		/// <summary>
+		/// 詰める
+		/// </summary>
+		/// <param name="widths">幅</param>
+		/// <param name="heights">高さ</param>
+		/// <param name="maxWidth">全体の幅</param>
+		/// <param name="alignment">座標と大きさをこの倍数に揃える</param>
+		/// <param name="rectangles">結果(入力と同じ順)</param>
+		/// <returns>使った高さ。入りきらない時は0</returns>
+		uint32_t Pack(const std::vector<uint32_t>& widths, const std::vector<uint32_t>& heights, const uint32_t& maxWidth, const uint32_t& alignment, std::vector<PackedRectangle>& rectangles);
+
+	private:
+		/// <summary>
+		/// 今積んである高さの区間
+		/// </summary>
+		struct SkylineNode {
+			uint32_t x;
+			uint32_t y;
+			uint32_t width;
+		};
+
+		/// <summary>
+		/// この区間から置いた時の高さ
+		/// </summary>
+		/// <param name="nodeIndex">区間の番号</param>
+		/// <param name="width">幅</param>
+		/// <param name="maxWidth">全体の幅</param>
+		/// <param name="y">置ける高さ</param>
+		/// <returns>置けるかどうか</returns>
+		bool Fit(const size_t& nodeIndex, const uint32_t& width, const uint32_t& maxWidth, uint32_t& y)const;
+
+		/// <summary>
+		/// 置いた所を更新する
+		/// </summary>
+		/// <param name="nodeIndex">区間の番号</param>
+		/// <param name="rectangle">置いた矩形</param>
+		void Place(const size_t& nodeIndex, const PackedRectangle& rectangle);
+
+	private:
+		//スカイライン
+		std::vector<SkylineNode> skyline_;
+
+	};
+
+}
@@ -0,0 +1,101 @@
+#include "TextureAtlasBuilder.h"
+
+#include <algorithm>
+#include <cstring>
+
+Elysia::TextureAtlasBuilder::Settings Elysia::TextureAtlasBuilder::MakeMipSafeSettings(const uint32_t& width, const uint32_t& maxHeight, const uint32_t& mipLevels) {
+	//一番小さいミップの1画素は元の2^(mipLevels-1)画素分
+	//位置をその倍数に揃えて同じ幅のガターを付ければ、その画素に隣の画像は入らない
+	uint32_t blockSize = 1u << (std::max<uint32_t>(mipLevels, 1u) - 1u);
+	Settings settings = {
+		.width = width,
+		.maxHeight = maxHeight,
+		.gutter = blockSize,
+		.padding = 0u,
+		.alignment = blockSize,
+	};
+	return settings;
+}
+
+void Elysia::TextureAtlasBuilder::Add(const std::string& name, const uint32_t& width, const uint32_t& height, const uint8_t* pixels, const size_t& rowPitch) {
+	SourceImage image = {
+		.name = name,
+		.width = width,
+		.height = height,
+		.pixels = std::vector<uint8_t>(size_t(width) * height * BYTES_PER_PIXEL_),
+	};
+	size_t packedRowPitch = size_t(width) * BYTES_PER_PIXEL_;
+	for (uint32_t row = 0u; row < height; ++row) {
+		std::memcpy(image.pixels.data() + row * packedRowPitch, pixels + row * rowPitch, packedRowPitch);
+	}
+	images_.push_back(std::move(image));
+}
+
+bool Elysia::TextureAtlasBuilder::Build(const Settings& settings) {
+	//ガターと隙間を含めた大きさで詰める
+	std::vector<uint32_t> widths(images_.size());
+	std::vector<uint32_t> heights(images_.size());
+	uint32_t border = settings.gutter * 2u + settings.padding;
+	for (size_t i = 0u; i < images_.size(); ++i) {
+		widths[i] = images_[i].width + border;
+		heights[i] = images_[i].height + border;
+	}
+	std::vector<PackedRectangle> rectangles;
+	uint32_t usedHeight = packer_.Pack(widths, heights, settings.width, std::max<uint32_t>(settings.alignment, 1u), rectangles);
+	if (usedHeight == 0u || usedHeight > settings.maxHeight) {
+		width_ = 0u;
+		height_ = 0u;
+		pixels_.clear();
+		regions_.clear();
+		return false;
+	}
+
+	//隙間は透明
+	width_ = settings.width;
+	height_ = usedHeight;
+	pixels_.assign(size_t(width_) * height_ * BYTES_PER_PIXEL_, 0u);
+	regions_.resize(images_.size());
+
+	float inverseWidth = 1.0f / float(width_);
+	float inverseHeight = 1.0f / float(height_);
+	for (size_t i = 0u; i < images_.size(); ++i) {
+		const SourceImage& image = images_[i];
+		uint32_t x = rectangles[i].x + settings.gutter;
+		uint32_t y = rectangles[i].y + settings.gutter;
+		Blit(image, x, y, settings.gutter);
+
+		//画素の端にUVを合わせるので、バイリニアでもガターの同じ色しか混ざらない
+		regions_[i] = {
+			.name = image.name,
+			.x = x,
+			.y = y,
+			.width = image.width,
+			.height = image.height,
+			.texLeftTop = {.x = float(x) * inverseWidth,.y = float(y) * inverseHeight },
+			.texRightBottom = {.x = float(x + image.width) * inverseWidth,.y = float(y + image.height) * inverseHeight },
+		};
+	}
+	return true;
+}
+
+void Elysia::TextureAtlasBuilder::Blit(const SourceImage& image, const uint32_t& x, const uint32_t& y, const uint32_t& gutter) {
+	size_t atlasRowPitch = size_t(width_) * BYTES_PER_PIXEL_;
+	size_t imageRowPitch = size_t(image.width) * BYTES_PER_PIXEL_;
+
+	//ガターの行は上下の端の行をそのまま伸ばす
+	int64_t rowBegin = int64_t(y) - int64_t(gutter);
+	int64_t rowEnd = int64_t(y) + int64_t(image.height) + int64_t(gutter);
+	for (int64_t row = rowBegin; row < rowEnd; ++row) {
+		int64_t sourceRow = std::clamp<int64_t>(row - int64_t(y), 0, int64_t(image.height) - 1);
+		const uint8_t* source = image.pixels.data() + size_t(sourceRow) * imageRowPitch;
+		uint8_t* destination = pixels_.data() + size_t(row) * atlasRowPitch + size_t(x) * BYTES_PER_PIXEL_;
+
+		std::memcpy(destination, source, imageRowPitch);
+		//左右のガターは端の画素を伸ばす
+		const uint8_t* right = source + imageRowPitch - BYTES_PER_PIXEL_;
+		for (uint32_t column = 1u; column <= gutter; ++column) {
+			std::memcpy(destination - column * BYTES_PER_PIXEL_, source, BYTES_PER_PIXEL_);
+			std::memcpy(destination + imageRowPitch + (column - 1u) * BYTES_PER_PIXEL_, right, BYTES_PER_PIXEL_);
+		}
+	}
+}
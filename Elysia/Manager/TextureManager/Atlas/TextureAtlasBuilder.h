@@ -0,0 +1,165 @@
+#pragma once
+
+/**
+ * @file TextureAtlasBuilder.h
+ * @brief 小さい画像を1枚のアトラスにまとめるクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Vector2.h"
+#include "RectanglePacker.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// アトラスの中の1枚分
+	/// </summary>
+	struct AtlasRegion {
+		//元の画像の名前(ファイルパス)
+		std::string name;
+		//アトラスの中の位置(ピクセル、ガターを除く)
+		uint32_t x;
+		uint32_t y;
+		//元の画像の大きさ
+		uint32_t width;
+		uint32_t height;
+		//UV
+		Vector2 texLeftTop;
+		Vector2 texRightBottom;
+	};
+
+	/// <summary>
+	/// 小さい画像を1枚のアトラスにまとめるクラス
+	/// 画素はRGBA8だけを扱い、DirectXに触らないのでCPUだけで確かめられる
+	/// </summary>
+	class TextureAtlasBuilder final {
+	public:
+		/// <summary>
+		/// 設定
+		/// </summary>
+		struct Settings {
+			//アトラスの幅
+			uint32_t width;
+			//アトラスの高さの上限
+			uint32_t maxHeight;
+			//画像の周りに端の画素を伸ばす幅
+			//バイリニアやミップマップで隣の画像が混ざらないようにする
+			uint32_t gutter;
+			//ガターの外の透明な隙間
+			uint32_t padding;
+			//位置と大きさをこの倍数に揃える
+			uint32_t alignment;
+		};
+
+		/// <summary>
+		/// ミップマップを作っても隣の画像が混ざらない設定
+		/// 一番小さいミップの1画素がガターの中に収まるようにする
+		/// </summary>
+		/// <param name="width">アトラスの幅</param>
+		/// <param name="maxHeight">アトラスの高さの上限</param>
+		/// <param name="mipLevels">ミップマップの数</param>
+		/// <returns>設定</returns>
+		static Settings MakeMipSafeSettings(const uint32_t& width, const uint32_t& maxHeight, const uint32_t& mipLevels);
+
+	public:
+		/// <summary>
+		/// 画像を追加
+		/// 画素はコピーするので呼んだ後は解放して良い
+		/// </summary>
+		/// <param name="name">名前</param>
+		/// <param name="width">幅</param>
+		/// <param name="height">高さ</param>
+		/// <param name="pixels">RGBA8の画素</param>
+		/// <param name="rowPitch">1行のバイト数</param>
+		void Add(const std::string& name, const uint32_t& width, const uint32_t& height, const uint8_t* pixels, const size_t& rowPitch);
+
+		/// <summary>
+		/// アトラスを作る
+		/// </summary>
+		/// <param name="settings">設定</param>
+		/// <returns>入りきったかどうか</returns>
+		bool Build(const Settings& settings);
+
+	public:
+		/// <summary>
+		/// 幅を取得
+		/// </summary>
+		/// <returns>幅</returns>
+		inline uint32_t GetWidth()const {
+			return width_;
+		}
+
+		/// <summary>
+		/// 高さを取得
+		/// </summary>
+		/// <returns>高さ</returns>
+		inline uint32_t GetHeight()const {
+			return height_;
+		}
+
+		/// <summary>
+		/// 画素を取得
+		/// 1行は幅*4バイト
+		/// </summary>
+		/// <returns>RGBA8の画素</returns>
+		inline const std::vector<uint8_t>& GetPixels()const {
+			return pixels_;
+		}
+
+		/// <summary>
+		/// 画像ごとの位置とUVを取得
+		/// 追加した順に並ぶ
+		/// </summary>
+		/// <returns>位置とUV</returns>
+		inline const std::vector<AtlasRegion>& GetRegions()const {
+			return regions_;
+		}
+
+	public:
+		//1画素のバイト数
+		static constexpr uint32_t BYTES_PER_PIXEL_ = 4u;
+
+	private:
+		/// <summary>
+		/// 追加した画像
+		/// </summary>
+		struct SourceImage {
+			std::string name;
+			uint32_t width;
+			uint32_t height;
+			std::vector<uint8_t> pixels;
+		};
+
+		/// <summary>
+		/// ガターを付けて書き込む
+		/// </summary>
+		/// <param name="image">画像</param>
+		/// <param name="x">書き込む位置(ガターを除く)</param>
+		/// <param name="y">書き込む位置(ガターを除く)</param>
+		/// <param name="gutter">ガターの幅</param>
+		void Blit(const SourceImage& image, const uint32_t& x, const uint32_t& y, const uint32_t& gutter);
+
+	private:
+		//矩形を詰める
+		RectanglePacker packer_;
+		//追加した画像
+		std::vector<SourceImage> images_;
+		//幅
+		uint32_t width_ = 0u;
+		//高さ
+		uint32_t height_ = 0u;
+		//画素
+		std::vector<uint8_t> pixels_;
+		//画像ごとの位置とUV
+		std::vector<AtlasRegion> regions_;
+
+	};
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * @file TextureRegion.h
+ * @brief テクスチャの一部分
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+#include "Vector2.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// テクスチャの一部分
+	/// アトラスにまとめた画像を元の1枚として使う時に渡す
+	/// </summary>
+	struct TextureRegion {
+		//テクスチャハンドル(アトラス)
+		uint32_t textureHandle;
+		//UV
+		Vector2 texLeftTop;
+		Vector2 texRightBottom;
+		//元の画像の大きさ
+		Vector2 size;
+	};
+
+}
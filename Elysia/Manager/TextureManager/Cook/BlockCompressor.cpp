@@ -0,0 +1,541 @@
+#include "BlockCompressor.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+	//BC1のパレットの番号ごとの重み(端点1の割合、3分の)
+	const int32_t BC1_WEIGHTS[4] = { 0,3,1,2 };
+	const int32_t BC1_WEIGHT_DENOMINATOR = 3;
+	//BC7の4bitの番号ごとの重み(端点1の割合、64分の)
+	const int32_t BC7_WEIGHTS[16] = { 0,4,9,13,17,21,26,30,34,38,43,47,51,55,60,64 };
+	const int32_t BC7_WEIGHT_DENOMINATOR = 64;
+	//BC7のモード6
+	const uint32_t BC7_MODE6 = 6u;
+
+	/// <summary>
+	/// 四捨五入の割り算(負の数も対応)
+	/// </summary>
+	/// <param name="numerator">分子</param>
+	/// <param name="denominator">分母(正)</param>
+	/// <returns>商</returns>
+	inline int64_t DivideRound(const int64_t& numerator, const int64_t& denominator) {
+		return (numerator >= 0) ? (numerator + denominator / 2) / denominator : -((-numerator + denominator / 2) / denominator);
+	}
+
+	/// <summary>
+	/// 主軸の向きに合わせて両端を決める
+	/// 一番幅の広いチャンネルを軸にして、他のチャンネルは共分散の符号で向きを揃える
+	/// </summary>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	/// <param name="channelCount">使うチャンネル数</param>
+	/// <param name="endpoint0">端点0</param>
+	/// <param name="endpoint1">端点1</param>
+	void FindEndpoints(const uint8_t* rgba, const uint32_t& channelCount, int32_t* endpoint0, int32_t* endpoint1) {
+		int32_t minimum[4] = { 255,255,255,255 };
+		int32_t maximum[4] = {};
+		int32_t sum[4] = {};
+		for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+			for (uint32_t c = 0u; c < channelCount; ++c) {
+				int32_t value = rgba[i * 4u + c];
+				minimum[c] = std::min<int32_t>(minimum[c], value);
+				maximum[c] = std::max<int32_t>(maximum[c], value);
+				sum[c] += value;
+			}
+		}
+
+		uint32_t axis = 0u;
+		for (uint32_t c = 1u; c < channelCount; ++c) {
+			if (maximum[c] - minimum[c] > maximum[axis] - minimum[axis]) {
+				axis = c;
+			}
+		}
+
+		for (uint32_t c = 0u; c < channelCount; ++c) {
+			int64_t covariance = 0;
+			for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+				covariance += int64_t(int32_t(rgba[i * 4u + c]) * 16 - sum[c]) * int64_t(int32_t(rgba[i * 4u + axis]) * 16 - sum[axis]);
+			}
+			//両端は少し内側に寄せた方が誤差が小さい
+			int32_t inset = (maximum[c] - minimum[c]) / 16;
+			if (covariance >= 0) {
+				endpoint0[c] = maximum[c] - inset;
+				endpoint1[c] = minimum[c] + inset;
+			}
+			else {
+				endpoint0[c] = minimum[c] + inset;
+				endpoint1[c] = maximum[c] - inset;
+			}
+		}
+	}
+
+	/// <summary>
+	/// 一番近いパレットの番号を選ぶ
+	/// </summary>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	/// <param name="channelCount">使うチャンネル数</param>
+	/// <param name="palette">パレット</param>
+	/// <param name="paletteCount">パレットの数</param>
+	/// <param name="indices">番号</param>
+	/// <returns>二乗誤差の合計</returns>
+	int64_t PickIndices(const uint8_t* rgba, const uint32_t& channelCount, const int32_t(*palette)[4], const uint32_t& paletteCount, uint8_t* indices) {
+		int64_t totalError = 0;
+		for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+			int32_t bestError = INT32_MAX;
+			for (uint32_t p = 0u; p < paletteCount; ++p) {
+				int32_t error = 0;
+				for (uint32_t c = 0u; c < channelCount; ++c) {
+					int32_t difference = int32_t(rgba[i * 4u + c]) - palette[p][c];
+					error += difference * difference;
+				}
+				if (error < bestError) {
+					bestError = error;
+					indices[i] = uint8_t(p);
+				}
+			}
+			totalError += bestError;
+		}
+		return totalError;
+	}
+
+	/// <summary>
+	/// 選んだ番号のまま最小二乗で両端を求め直す
+	/// </summary>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	/// <param name="channelCount">使うチャンネル数</param>
+	/// <param name="indices">番号</param>
+	/// <param name="weights">番号ごとの重み</param>
+	/// <param name="denominator">重みの分母</param>
+	/// <param name="endpoint0">端点0</param>
+	/// <param name="endpoint1">端点1</param>
+	/// <returns>求められたかどうか(全部同じ番号だと解けない)</returns>
+	bool RefineEndpoints(const uint8_t* rgba, const uint32_t& channelCount, const uint8_t* indices, const int32_t* weights, const int32_t& denominator, int32_t* endpoint0, int32_t* endpoint1) {
+		//denominator*p = a*e0 + b*e1 に合わせる
+		int64_t aa = 0;
+		int64_t ab = 0;
+		int64_t bb = 0;
+		int64_t ap[4] = {};
+		int64_t bp[4] = {};
+		for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+			int64_t b = weights[indices[i]];
+			int64_t a = denominator - b;
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (uint32_t c = 0u; c < channelCount; ++c) {
+				ap[c] += a * rgba[i * 4u + c];
+				bp[c] += b * rgba[i * 4u + c];
+			}
+		}
+		int64_t determinant = aa * bb - ab * ab;
+		if (determinant == 0) {
+			return false;
+		}
+		for (uint32_t c = 0u; c < channelCount; ++c) {
+			endpoint0[c] = int32_t(std::clamp<int64_t>(DivideRound(denominator * (bb * ap[c] - ab * bp[c]), determinant), 0, 255));
+			endpoint1[c] = int32_t(std::clamp<int64_t>(DivideRound(denominator * (aa * bp[c] - ab * ap[c]), determinant), 0, 255));
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// RGB565にする
+	/// </summary>
+	/// <param name="color">RGB8</param>
+	/// <returns>RGB565</returns>
+	inline uint16_t To565(const int32_t* color) {
+		uint32_t r = uint32_t(color[0] * 31 + 127) / 255u;
+		uint32_t g = uint32_t(color[1] * 63 + 127) / 255u;
+		uint32_t b = uint32_t(color[2] * 31 + 127) / 255u;
+		return uint16_t((r << 11u) | (g << 5u) | b);
+	}
+
+	/// <summary>
+	/// RGB565から戻す
+	/// </summary>
+	/// <param name="value">RGB565</param>
+	/// <param name="color">RGB8</param>
+	inline void From565(const uint16_t& value, int32_t* color) {
+		int32_t r = (value >> 11) & 31;
+		int32_t g = (value >> 5) & 63;
+		int32_t b = value & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+		color[3] = 255;
+	}
+
+	/// <summary>
+	/// BC1の4色のパレット
+	/// </summary>
+	/// <param name="color0">端点0</param>
+	/// <param name="color1">端点1</param>
+	/// <param name="palette">パレット</param>
+	void MakeBC1Palette(const uint16_t& color0, const uint16_t& color1, int32_t(*palette)[4]) {
+		From565(color0, palette[0]);
+		From565(color1, palette[1]);
+		for (uint32_t c = 0u; c < 4u; ++c) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+	}
+
+	/// <summary>
+	/// BC1の色のブロック(BC3と共通)
+	/// </summary>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	/// <param name="block">書き込み先(8バイト)</param>
+	void EncodeColorBlock(const uint8_t* rgba, uint8_t* block) {
+		int32_t endpoint0[4] = {};
+		int32_t endpoint1[4] = {};
+		FindEndpoints(rgba, 3u, endpoint0, endpoint1);
+
+		int32_t palette[4][4] = {};
+		uint16_t color0 = To565(endpoint0);
+		uint16_t color1 = To565(endpoint1);
+		uint8_t indices[BlockCompressor::BLOCK_PIXEL_COUNT] = {};
+		MakeBC1Palette(color0, color1, palette);
+		int64_t error = PickIndices(rgba, 3u, palette, 4u, indices);
+
+		//1回だけ詰め直して、良くなった方を使う
+		if (RefineEndpoints(rgba, 3u, indices, BC1_WEIGHTS, BC1_WEIGHT_DENOMINATOR, endpoint0, endpoint1)) {
+			uint16_t refinedColor0 = To565(endpoint0);
+			uint16_t refinedColor1 = To565(endpoint1);
+			uint8_t refinedIndices[BlockCompressor::BLOCK_PIXEL_COUNT] = {};
+			MakeBC1Palette(refinedColor0, refinedColor1, palette);
+			int64_t refinedError = PickIndices(rgba, 3u, palette, 4u, refinedIndices);
+			if (refinedError < error) {
+				color0 = refinedColor0;
+				color1 = refinedColor1;
+				std::memcpy(indices, refinedIndices, sizeof(indices));
+			}
+		}
+
+		//4色のモードにするには color0 > color1 が必要
+		if (color0 == color1) {
+			std::memset(indices, 0, sizeof(indices));
+		}
+		else if (color0 < color1) {
+			std::swap(color0, color1);
+			for (uint8_t& index : indices) {
+				index = uint8_t(index ^ 1u);
+			}
+		}
+
+		uint32_t packedIndices = 0u;
+		for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+			packedIndices |= uint32_t(indices[i]) << (i * 2u);
+		}
+		block[0] = uint8_t(color0 & 0xFFu);
+		block[1] = uint8_t(color0 >> 8u);
+		block[2] = uint8_t(color1 & 0xFFu);
+		block[3] = uint8_t(color1 >> 8u);
+		for (uint32_t i = 0u; i < 4u; ++i) {
+			block[4u + i] = uint8_t(packedIndices >> (i * 8u));
+		}
+	}
+
+	/// <summary>
+	/// BC4の8値のパレット
+	/// </summary>
+	/// <param name="value0">端点0</param>
+	/// <param name="value1">端点1</param>
+	/// <param name="palette">パレット</param>
+	void MakeBC4Palette(const int32_t& value0, const int32_t& value1, int32_t* palette) {
+		palette[0] = value0;
+		palette[1] = value1;
+		//value0 > value1 なら8値、そうでなければ6値+0と255
+		if (value0 > value1) {
+			for (int32_t i = 2; i < 8; ++i) {
+				palette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+			}
+			return;
+		}
+		for (int32_t i = 2; i < 6; ++i) {
+			palette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	/// <summary>
+	/// 下位ビットから書く
+	/// </summary>
+	class BitWriter {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="block">書き込み先(16バイト、0で埋める)</param>
+		BitWriter(uint8_t* block) :block_(block) {
+			std::memset(block_, 0, 16u);
+		}
+
+		/// <summary>
+		/// 書く
+		/// </summary>
+		/// <param name="value">値</param>
+		/// <param name="count">ビット数</param>
+		void Write(const uint32_t& value, const uint32_t& count) {
+			for (uint32_t i = 0u; i < count; ++i) {
+				if ((value >> i) & 1u) {
+					block_[position_ / 8u] |= uint8_t(1u << (position_ % 8u));
+				}
+				++position_;
+			}
+		}
+
+	private:
+		uint8_t* block_ = nullptr;
+		uint32_t position_ = 0u;
+	};
+
+	/// <summary>
+	/// 下位ビットから読む
+	/// </summary>
+	class BitReader {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="block">ブロック(16バイト)</param>
+		BitReader(const uint8_t* block) :block_(block) {}
+
+		/// <summary>
+		/// 読む
+		/// </summary>
+		/// <param name="count">ビット数</param>
+		/// <returns>値</returns>
+		uint32_t Read(const uint32_t& count) {
+			uint32_t value = 0u;
+			for (uint32_t i = 0u; i < count; ++i) {
+				value |= uint32_t((block_[position_ / 8u] >> (position_ % 8u)) & 1u) << i;
+				++position_;
+			}
+			return value;
+		}
+
+	private:
+		const uint8_t* block_ = nullptr;
+		uint32_t position_ = 0u;
+	};
+
+	/// <summary>
+	/// BC7の端点を7bit+共有の1bitにする
+	/// pの0と1で誤差が小さい方を選ぶ
+	/// </summary>
+	/// <param name="endpoint">端点(RGBA8)</param>
+	/// <param name="quantized">7bitの値</param>
+	/// <returns>pビット</returns>
+	uint32_t QuantizeBC7Endpoint(const int32_t* endpoint, int32_t* quantized) {
+		uint32_t bestP = 0u;
+		int32_t bestError = INT32_MAX;
+		for (uint32_t p = 0u; p < 2u; ++p) {
+			int32_t error = 0;
+			int32_t candidate[4] = {};
+			for (uint32_t c = 0u; c < 4u; ++c) {
+				candidate[c] = std::clamp<int32_t>((endpoint[c] - int32_t(p) + 1) >> 1, 0, 127);
+				int32_t difference = endpoint[c] - ((candidate[c] << 1) | int32_t(p));
+				error += difference * difference;
+			}
+			if (error < bestError) {
+				bestError = error;
+				bestP = p;
+				std::memcpy(quantized, candidate, sizeof(candidate));
+			}
+		}
+		return bestP;
+	}
+
+	/// <summary>
+	/// BC7のモード6の16値のパレット
+	/// </summary>
+	/// <param name="quantized0">端点0の7bitの値</param>
+	/// <param name="p0">端点0のpビット</param>
+	/// <param name="quantized1">端点1の7bitの値</param>
+	/// <param name="p1">端点1のpビット</param>
+	/// <param name="palette">パレット</param>
+	void MakeBC7Palette(const int32_t* quantized0, const uint32_t& p0, const int32_t* quantized1, const uint32_t& p1, int32_t(*palette)[4]) {
+		for (uint32_t c = 0u; c < 4u; ++c) {
+			int32_t value0 = (quantized0[c] << 1) | int32_t(p0);
+			int32_t value1 = (quantized1[c] << 1) | int32_t(p1);
+			for (uint32_t i = 0u; i < 16u; ++i) {
+				palette[i][c] = (value0 * (BC7_WEIGHT_DENOMINATOR - BC7_WEIGHTS[i]) + value1 * BC7_WEIGHTS[i] + 32) >> 6;
+			}
+		}
+	}
+
+}
+
+void BlockCompressor::EncodeBC1(const uint8_t* rgba, uint8_t* block) {
+	EncodeColorBlock(rgba, block);
+}
+
+void BlockCompressor::EncodeBC3(const uint8_t* rgba, uint8_t* block) {
+	EncodeBC4(rgba + 3u, 4u, block);
+	EncodeColorBlock(rgba, block + 8u);
+}
+
+void BlockCompressor::EncodeBC4(const uint8_t* values, const uint32_t& stride, uint8_t* block) {
+	int32_t minimum = 255;
+	int32_t maximum = 0;
+	for (uint32_t i = 0u; i < BLOCK_PIXEL_COUNT; ++i) {
+		minimum = std::min<int32_t>(minimum, values[i * stride]);
+		maximum = std::max<int32_t>(maximum, values[i * stride]);
+	}
+
+	//両端は最大と最小そのままにすると、0と255だけの切り抜きのアルファも崩れない
+	int32_t palette[8] = {};
+	MakeBC4Palette(maximum, minimum, palette);
+	uint64_t packedIndices = 0u;
+	for (uint32_t i = 0u; i < BLOCK_PIXEL_COUNT; ++i) {
+		uint32_t bestIndex = 0u;
+		int32_t bestError = INT32_MAX;
+		for (uint32_t p = 0u; p < 8u; ++p) {
+			int32_t error = std::abs(int32_t(values[i * stride]) - palette[p]);
+			if (error < bestError) {
+				bestError = error;
+				bestIndex = p;
+			}
+		}
+		packedIndices |= uint64_t(bestIndex) << (i * 3u);
+	}
+
+	block[0] = uint8_t(maximum);
+	block[1] = uint8_t(minimum);
+	for (uint32_t i = 0u; i < 6u; ++i) {
+		block[2u + i] = uint8_t(packedIndices >> (i * 8u));
+	}
+}
+
+void BlockCompressor::EncodeBC7(const uint8_t* rgba, uint8_t* block) {
+	int32_t endpoint0[4] = {};
+	int32_t endpoint1[4] = {};
+	FindEndpoints(rgba, 4u, endpoint0, endpoint1);
+
+	int32_t quantized0[4] = {};
+	int32_t quantized1[4] = {};
+	uint32_t p0 = QuantizeBC7Endpoint(endpoint0, quantized0);
+	uint32_t p1 = QuantizeBC7Endpoint(endpoint1, quantized1);
+	int32_t palette[16][4] = {};
+	uint8_t indices[BLOCK_PIXEL_COUNT] = {};
+	MakeBC7Palette(quantized0, p0, quantized1, p1, palette);
+	int64_t error = PickIndices(rgba, 4u, palette, 16u, indices);
+
+	//1回だけ詰め直して、良くなった方を使う
+	if (RefineEndpoints(rgba, 4u, indices, BC7_WEIGHTS, BC7_WEIGHT_DENOMINATOR, endpoint0, endpoint1)) {
+		int32_t refinedQuantized0[4] = {};
+		int32_t refinedQuantized1[4] = {};
+		uint32_t refinedP0 = QuantizeBC7Endpoint(endpoint0, refinedQuantized0);
+		uint32_t refinedP1 = QuantizeBC7Endpoint(endpoint1, refinedQuantized1);
+		uint8_t refinedIndices[BLOCK_PIXEL_COUNT] = {};
+		MakeBC7Palette(refinedQuantized0, refinedP0, refinedQuantized1, refinedP1, palette);
+		int64_t refinedError = PickIndices(rgba, 4u, palette, 16u, refinedIndices);
+		if (refinedError < error) {
+			std::memcpy(quantized0, refinedQuantized0, sizeof(quantized0));
+			std::memcpy(quantized1, refinedQuantized1, sizeof(quantized1));
+			p0 = refinedP0;
+			p1 = refinedP1;
+			std::memcpy(indices, refinedIndices, sizeof(indices));
+		}
+	}
+
+	//先頭の画素の番号は最上位ビットを省くので、立っていたら両端を入れ替える
+	if ((indices[0] & 8u) != 0u) {
+		std::swap(quantized0, quantized1);
+		std::swap(p0, p1);
+		for (uint8_t& index : indices) {
+			index = uint8_t(15u - index);
+		}
+	}
+
+	BitWriter writer(block);
+	writer.Write(1u << BC7_MODE6, BC7_MODE6 + 1u);
+	for (uint32_t c = 0u; c < 4u; ++c) {
+		writer.Write(uint32_t(quantized0[c]), 7u);
+		writer.Write(uint32_t(quantized1[c]), 7u);
+	}
+	writer.Write(p0, 1u);
+	writer.Write(p1, 1u);
+	writer.Write(indices[0], 3u);
+	for (uint32_t i = 1u; i < BLOCK_PIXEL_COUNT; ++i) {
+		writer.Write(indices[i], 4u);
+	}
+}
+
+void BlockCompressor::DecodeBC1(const uint8_t* block, uint8_t* rgba) {
+	uint16_t color0 = uint16_t(block[0] | (block[1] << 8u));
+	uint16_t color1 = uint16_t(block[2] | (block[3] << 8u));
+	int32_t palette[4][4] = {};
+	MakeBC1Palette(color0, color1, palette);
+	//color0 <= color1 は3色+透明
+	if (color0 <= color1) {
+		for (uint32_t c = 0u; c < 3u; ++c) {
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+		palette[3][3] = 0;
+	}
+	uint32_t packedIndices = uint32_t(block[4]) | (uint32_t(block[5]) << 8u) | (uint32_t(block[6]) << 16u) | (uint32_t(block[7]) << 24u);
+	for (uint32_t i = 0u; i < BLOCK_PIXEL_COUNT; ++i) {
+		const int32_t* color = palette[(packedIndices >> (i * 2u)) & 3u];
+		for (uint32_t c = 0u; c < 4u; ++c) {
+			rgba[i * 4u + c] = uint8_t(color[c]);
+		}
+	}
+}
+
+void BlockCompressor::DecodeBC3(const uint8_t* block, uint8_t* rgba) {
+	//BC3の色は常に4色
+	uint16_t color0 = uint16_t(block[8] | (block[9] << 8u));
+	uint16_t color1 = uint16_t(block[10] | (block[11] << 8u));
+	int32_t palette[4][4] = {};
+	MakeBC1Palette(color0, color1, palette);
+	uint32_t packedIndices = uint32_t(block[12]) | (uint32_t(block[13]) << 8u) | (uint32_t(block[14]) << 16u) | (uint32_t(block[15]) << 24u);
+	for (uint32_t i = 0u; i < BLOCK_PIXEL_COUNT; ++i) {
+		const int32_t* color = palette[(packedIndices >> (i * 2u)) & 3u];
+		for (uint32_t c = 0u; c < 3u; ++c) {
+			rgba[i * 4u + c] = uint8_t(color[c]);
+		}
+	}
+	DecodeBC4(block, rgba + 3u, 4u);
+}
+
+void BlockCompressor::DecodeBC4(const uint8_t* block, uint8_t* values, const uint32_t& stride) {
+	int32_t palette[8] = {};
+	MakeBC4Palette(block[0], block[1], palette);
+	uint64_t packedIndices = 0u;
+	for (uint32_t i = 0u; i < 6u; ++i) {
+		packedIndices |= uint64_t(block[2u + i]) << (i * 8u);
+	}
+	for (uint32_t i = 0u; i < BLOCK_PIXEL_COUNT; ++i) {
+		values[i * stride] = uint8_t(palette[(packedIndices >> (i * 3u)) & 7u]);
+	}
+}
+
+bool BlockCompressor::DecodeBC7(const uint8_t* block, uint8_t* rgba) {
+	BitReader reader(block);
+	if (reader.Read(BC7_MODE6 + 1u) != (1u << BC7_MODE6)) {
+		return false;
+	}
+
+	int32_t quantized0[4] = {};
+	int32_t quantized1[4] = {};
+	for (uint32_t c = 0u; c < 4u; ++c) {
+		quantized0[c] = int32_t(reader.Read(7u));
+		quantized1[c] = int32_t(reader.Read(7u));
+	}
+	uint32_t p0 = reader.Read(1u);
+	uint32_t p1 = reader.Read(1u);
+	int32_t palette[16][4] = {};
+	MakeBC7Palette(quantized0, p0, quantized1, p1, palette);
+	for (uint32_t i = 0u; i < BLOCK_PIXEL_COUNT; ++i) {
+		const int32_t* color = palette[reader.Read((i == 0u) ? 3u : 4u)];
+		for (uint32_t c = 0u; c < 4u; ++c) {
+			rgba[i * 4u + c] = uint8_t(color[c]);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * @file BlockCompressor.h
+ * @brief BC形式の4x4ブロック圧縮(クック用)
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+/// <summary>
+/// BC形式の4x4ブロック圧縮(クック用)
+/// 整数だけで計算するので、どの環境で圧縮しても同じバイト列になる
+/// </summary>
+namespace BlockCompressor {
+
+	//1ブロックの幅と高さ
+	const uint32_t BLOCK_SIZE = 4u;
+	//1ブロックの画素数
+	const uint32_t BLOCK_PIXEL_COUNT = BLOCK_SIZE * BLOCK_SIZE;
+
+	/// <summary>
+	/// BC1(不透明のRGB、8バイト)
+	/// </summary>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	/// <param name="block">書き込み先</param>
+	void EncodeBC1(const uint8_t* rgba, uint8_t* block);
+
+	/// <summary>
+	/// BC3(BC1の色+BC4のアルファ、16バイト)
+	/// </summary>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	/// <param name="block">書き込み先</param>
+	void EncodeBC3(const uint8_t* rgba, uint8_t* block);
+
+	/// <summary>
+	/// BC4(1チャンネル、8バイト)
+	/// </summary>
+	/// <param name="values">16画素分の値</param>
+	/// <param name="stride">1画素のバイト数</param>
+	/// <param name="block">書き込み先</param>
+	void EncodeBC4(const uint8_t* values, const uint32_t& stride, uint8_t* block);
+
+	/// <summary>
+	/// BC7(RGBA、16バイト)
+	/// 色とアルファを一緒に補間するモード6だけを使う
+	/// </summary>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	/// <param name="block">書き込み先</param>
+	void EncodeBC7(const uint8_t* rgba, uint8_t* block);
+
+	/// <summary>
+	/// BC1を戻す
+	/// </summary>
+	/// <param name="block">ブロック</param>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	void DecodeBC1(const uint8_t* block, uint8_t* rgba);
+
+	/// <summary>
+	/// BC3を戻す
+	/// </summary>
+	/// <param name="block">ブロック</param>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	void DecodeBC3(const uint8_t* block, uint8_t* rgba);
+
+	/// <summary>
+	/// BC4を戻す
+	/// </summary>
+	/// <param name="block">ブロック</param>
+	/// <param name="values">書き込み先</param>
+	/// <param name="stride">1画素のバイト数</param>
+	void DecodeBC4(const uint8_t* block, uint8_t* values, const uint32_t& stride);
+
+	/// <summary>
+	/// BC7を戻す
+	/// </summary>
+	/// <param name="block">ブロック</param>
+	/// <param name="rgba">16画素分のRGBA8</param>
+	/// <returns>戻せたかどうか(モード6以外は扱わない)</returns>
+	bool DecodeBC7(const uint8_t* block, uint8_t* rgba);
+
+};
@@ -0,0 +1,568 @@
+#include "PngDecoder.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+	//ハフマン符号の最大の長さ
+	const uint32_t MAX_CODE_LENGTH = 15u;
+
+	//長さの基準値と追加ビット数(257番から)
+	const uint16_t LENGTH_BASES[29] = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258 };
+	const uint8_t LENGTH_EXTRA_BITS[29] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+	//距離の基準値と追加ビット数
+	const uint16_t DISTANCE_BASES[30] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+	const uint8_t DISTANCE_EXTRA_BITS[30] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+	//符号長の符号長が並ぶ順番
+	const uint8_t CODE_LENGTH_ORDER[19] = { 16,17,18,0,8,7,9,6,10,5,11,4,12,3,13,2,14,1,15 };
+
+	/// <summary>
+	/// 下位ビットから読む
+	/// </summary>
+	class BitReader {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="data">データ</param>
+		/// <param name="size">サイズ</param>
+		BitReader(const uint8_t* data, const size_t& size) :data_(data), size_(size) {}
+
+		/// <summary>
+		/// 読む
+		/// 終わりを超えたら0を返してfailed_を立てる
+		/// </summary>
+		/// <param name="count">ビット数(最大16)</param>
+		/// <returns>値</returns>
+		uint32_t Read(const uint32_t& count) {
+			while (bitCount_ < count) {
+				if (position_ >= size_) {
+					failed_ = true;
+					return 0u;
+				}
+				bitBuffer_ |= uint32_t(data_[position_++]) << bitCount_;
+				bitCount_ += 8u;
+			}
+			uint32_t value = bitBuffer_ & ((1u << count) - 1u);
+			bitBuffer_ >>= count;
+			bitCount_ -= count;
+			return value;
+		}
+
+		/// <summary>
+		/// バイト境界まで捨てる
+		/// </summary>
+		void AlignToByte() {
+			bitBuffer_ = 0u;
+			bitCount_ = 0u;
+		}
+
+		/// <summary>
+		/// バイト単位でコピー
+		/// </summary>
+		/// <param name="count">バイト数</param>
+		/// <param name="output">書き込み先</param>
+		/// <returns>コピー出来たかどうか</returns>
+		bool Copy(const size_t& count, std::vector<uint8_t>& output) {
+			if (position_ + count > size_) {
+				failed_ = true;
+				return false;
+			}
+			output.insert(output.end(), data_ + position_, data_ + position_ + count);
+			position_ += count;
+			return true;
+		}
+
+		/// <summary>
+		/// 失敗したかどうか
+		/// </summary>
+		/// <returns>失敗したかどうか</returns>
+		inline bool GetIsFailed()const {
+			return failed_;
+		}
+
+	private:
+		const uint8_t* data_ = nullptr;
+		size_t size_ = 0u;
+		size_t position_ = 0u;
+		uint32_t bitBuffer_ = 0u;
+		uint32_t bitCount_ = 0u;
+		bool failed_ = false;
+	};
+
+	/// <summary>
+	/// 正準ハフマン符号
+	/// </summary>
+	struct Huffman {
+		//長さごとの符号の数
+		uint16_t counts[MAX_CODE_LENGTH + 1u];
+		//長さ順に並べた記号
+		uint16_t symbols[288];
+	};
+
+	/// <summary>
+	/// 符号長からハフマン符号を作る
+	/// </summary>
+	/// <param name="huffman">ハフマン符号</param>
+	/// <param name="lengths">記号ごとの符号長</param>
+	/// <param name="count">記号の数</param>
+	void BuildHuffman(Huffman& huffman, const uint8_t* lengths, const uint32_t& count) {
+		std::memset(huffman.counts, 0, sizeof(huffman.counts));
+		for (uint32_t symbol = 0u; symbol < count; ++symbol) {
+			++huffman.counts[lengths[symbol]];
+		}
+		huffman.counts[0] = 0u;
+
+		uint16_t offsets[MAX_CODE_LENGTH + 1u] = {};
+		for (uint32_t length = 1u; length < MAX_CODE_LENGTH; ++length) {
+			offsets[length + 1u] = uint16_t(offsets[length] + huffman.counts[length]);
+		}
+		for (uint32_t symbol = 0u; symbol < count; ++symbol) {
+			if (lengths[symbol] != 0u) {
+				huffman.symbols[offsets[lengths[symbol]]++] = uint16_t(symbol);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 記号を1つ読む
+	/// </summary>
+	/// <param name="reader">読み込み</param>
+	/// <param name="huffman">ハフマン符号</param>
+	/// <returns>記号(失敗したら-1)</returns>
+	int32_t DecodeSymbol(BitReader& reader, const Huffman& huffman) {
+		//同じ長さの符号は連続しているので、長さごとに範囲に入るかを見る
+		int32_t code = 0;
+		int32_t first = 0;
+		int32_t index = 0;
+		for (uint32_t length = 1u; length <= MAX_CODE_LENGTH; ++length) {
+			code |= int32_t(reader.Read(1u));
+			int32_t count = huffman.counts[length];
+			if (code - count < first) {
+				return huffman.symbols[index + (code - first)];
+			}
+			index += count;
+			first = (first + count) << 1;
+			code <<= 1;
+		}
+		return -1;
+	}
+
+	/// <summary>
+	/// 圧縮されたブロックを展開
+	/// </summary>
+	/// <param name="reader">読み込み</param>
+	/// <param name="literalLength">リテラルと長さの符号</param>
+	/// <param name="distance">距離の符号</param>
+	/// <param name="output">書き込み先</param>
+	/// <returns>展開出来たかどうか</returns>
+	bool InflateBlock(BitReader& reader, const Huffman& literalLength, const Huffman& distance, std::vector<uint8_t>& output) {
+		while (reader.GetIsFailed() == false) {
+			int32_t symbol = DecodeSymbol(reader, literalLength);
+			if (symbol < 0) {
+				return false;
+			}
+			//リテラル
+			if (symbol < 256) {
+				output.push_back(uint8_t(symbol));
+				continue;
+			}
+			//ブロックの終わり
+			if (symbol == 256) {
+				return true;
+			}
+
+			//長さと距離で前のデータをコピー
+			symbol -= 257;
+			if (symbol >= 29) {
+				return false;
+			}
+			size_t length = LENGTH_BASES[symbol] + reader.Read(LENGTH_EXTRA_BITS[symbol]);
+			int32_t distanceSymbol = DecodeSymbol(reader, distance);
+			if (distanceSymbol < 0 || distanceSymbol >= 30) {
+				return false;
+			}
+			size_t distanceValue = DISTANCE_BASES[distanceSymbol] + reader.Read(DISTANCE_EXTRA_BITS[distanceSymbol]);
+			if (distanceValue > output.size()) {
+				return false;
+			}
+			//重なる場合があるので1バイトずつ
+			size_t from = output.size() - distanceValue;
+			for (size_t i = 0u; i < length; ++i) {
+				output.push_back(output[from + i]);
+			}
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// zlibの展開
+	/// </summary>
+	/// <param name="data">zlibのデータ</param>
+	/// <param name="size">サイズ</param>
+	/// <param name="output">書き込み先</param>
+	/// <returns>展開出来たかどうか</returns>
+	bool Inflate(const uint8_t* data, const size_t& size, std::vector<uint8_t>& output) {
+		//zlibのヘッダー(deflateで辞書無し)
+		if (size < 2u || (data[0] & 0x0Fu) != 8u || ((uint32_t(data[0]) << 8u) | data[1]) % 31u != 0u || (data[1] & 0x20u) != 0u) {
+			return false;
+		}
+
+		BitReader reader(data + 2u, size - 2u);
+		bool isFinal = false;
+		while (isFinal == false) {
+			isFinal = reader.Read(1u) == 1u;
+			uint32_t type = reader.Read(2u);
+
+			//無圧縮
+			if (type == 0u) {
+				reader.AlignToByte();
+				uint32_t length = reader.Read(16u);
+				uint32_t inverseLength = reader.Read(16u);
+				if ((length ^ 0xFFFFu) != inverseLength || reader.Copy(length, output) == false) {
+					return false;
+				}
+				continue;
+			}
+
+			Huffman literalLength = {};
+			Huffman distance = {};
+			uint8_t lengths[288 + 32] = {};
+			//固定ハフマン
+			if (type == 1u) {
+				for (uint32_t symbol = 0u; symbol < 288u; ++symbol) {
+					lengths[symbol] = uint8_t((symbol < 144u) ? 8u : (symbol < 256u) ? 9u : (symbol < 280u) ? 7u : 8u);
+				}
+				BuildHuffman(literalLength, lengths, 288u);
+				std::memset(lengths, 5, 30u);
+				BuildHuffman(distance, lengths, 30u);
+			}
+			//動的ハフマン
+			else if (type == 2u) {
+				uint32_t literalCount = reader.Read(5u) + 257u;
+				uint32_t distanceCount = reader.Read(5u) + 1u;
+				uint32_t codeLengthCount = reader.Read(4u) + 4u;
+				if (literalCount > 286u || distanceCount > 30u) {
+					return false;
+				}
+
+				uint8_t codeLengthLengths[19] = {};
+				for (uint32_t i = 0u; i < codeLengthCount; ++i) {
+					codeLengthLengths[CODE_LENGTH_ORDER[i]] = uint8_t(reader.Read(3u));
+				}
+				Huffman codeLength = {};
+				BuildHuffman(codeLength, codeLengthLengths, 19u);
+
+				//リテラルと距離の符号長は続けて並んでいる
+				uint32_t index = 0u;
+				while (index < literalCount + distanceCount) {
+					int32_t symbol = DecodeSymbol(reader, codeLength);
+					if (symbol < 0) {
+						return false;
+					}
+					if (symbol < 16) {
+						lengths[index++] = uint8_t(symbol);
+						continue;
+					}
+					uint8_t repeatLength = 0u;
+					uint32_t repeatCount = 0u;
+					if (symbol == 16) {
+						if (index == 0u) {
+							return false;
+						}
+						repeatLength = lengths[index - 1u];
+						repeatCount = 3u + reader.Read(2u);
+					}
+					else if (symbol == 17) {
+						repeatCount = 3u + reader.Read(3u);
+					}
+					else {
+						repeatCount = 11u + reader.Read(7u);
+					}
+					if (index + repeatCount > literalCount + distanceCount) {
+						return false;
+					}
+					std::memset(lengths + index, repeatLength, repeatCount);
+					index += repeatCount;
+				}
+				BuildHuffman(literalLength, lengths, literalCount);
+				BuildHuffman(distance, lengths + literalCount, distanceCount);
+			}
+			else {
+				return false;
+			}
+
+			if (InflateBlock(reader, literalLength, distance, output) == false) {
+				return false;
+			}
+		}
+		return reader.GetIsFailed() == false;
+	}
+
+	/// <summary>
+	/// ビッグエンディアンの32bit
+	/// </summary>
+	/// <param name="data">データ</param>
+	/// <returns>値</returns>
+	inline uint32_t ReadBigEndian32(const uint8_t* data) {
+		return (uint32_t(data[0]) << 24u) | (uint32_t(data[1]) << 16u) | (uint32_t(data[2]) << 8u) | uint32_t(data[3]);
+	}
+
+	/// <summary>
+	/// Paeth予測
+	/// </summary>
+	/// <param name="left">左</param>
+	/// <param name="up">上</param>
+	/// <param name="upLeft">左上</param>
+	/// <returns>予測値</returns>
+	inline uint8_t Paeth(const int32_t& left, const int32_t& up, const int32_t& upLeft) {
+		int32_t base = left + up - upLeft;
+		int32_t distanceLeft = std::abs(base - left);
+		int32_t distanceUp = std::abs(base - up);
+		int32_t distanceUpLeft = std::abs(base - upLeft);
+		if (distanceLeft <= distanceUp && distanceLeft <= distanceUpLeft) {
+			return uint8_t(left);
+		}
+		if (distanceUp <= distanceUpLeft) {
+			return uint8_t(up);
+		}
+		return uint8_t(upLeft);
+	}
+
+	/// <summary>
+	/// フィルタを戻す
+	/// </summary>
+	/// <param name="data">フィルタ種類付きの行が並んだデータ</param>
+	/// <param name="height">行数</param>
+	/// <param name="rowSize">1行のバイト数(フィルタ種類を除く)</param>
+	/// <param name="bytesPerPixel">1画素のバイト数(1未満は1)</param>
+	/// <param name="rows">戻した行</param>
+	/// <returns>戻せたかどうか</returns>
+	bool Unfilter(const std::vector<uint8_t>& data, const uint32_t& height, const size_t& rowSize, const size_t& bytesPerPixel, std::vector<uint8_t>& rows) {
+		if (data.size() < (rowSize + 1u) * height) {
+			return false;
+		}
+		rows.assign(rowSize * height, 0u);
+		for (uint32_t y = 0u; y < height; ++y) {
+			uint8_t filter = data[y * (rowSize + 1u)];
+			const uint8_t* source = data.data() + y * (rowSize + 1u) + 1u;
+			uint8_t* row = rows.data() + y * rowSize;
+			const uint8_t* previous = (y > 0u) ? row - rowSize : nullptr;
+			for (size_t x = 0u; x < rowSize; ++x) {
+				int32_t left = (x >= bytesPerPixel) ? row[x - bytesPerPixel] : 0;
+				int32_t up = (previous != nullptr) ? previous[x] : 0;
+				int32_t upLeft = (previous != nullptr && x >= bytesPerPixel) ? previous[x - bytesPerPixel] : 0;
+				int32_t predicted = 0;
+				switch (filter) {
+				case 0:
+					break;
+				case 1:
+					predicted = left;
+					break;
+				case 2:
+					predicted = up;
+					break;
+				case 3:
+					predicted = (left + up) / 2;
+					break;
+				case 4:
+					predicted = Paeth(left, up, upLeft);
+					break;
+				default:
+					return false;
+				}
+				row[x] = uint8_t(source[x] + predicted);
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 1画素の中の1サンプルを取り出す
+	/// </summary>
+	/// <param name="row">行</param>
+	/// <param name="index">行の中のサンプルの番号</param>
+	/// <param name="bitDepth">ビット深度(8以下)</param>
+	/// <returns>サンプル</returns>
+	inline uint32_t ReadSample(const uint8_t* row, const size_t& index, const uint32_t& bitDepth) {
+		if (bitDepth == 8u) {
+			return row[index];
+		}
+		//8bit未満は上位ビットから詰まっている
+		size_t bitPosition = index * bitDepth;
+		uint32_t shift = 8u - bitDepth - uint32_t(bitPosition % 8u);
+		return (row[bitPosition / 8u] >> shift) & ((1u << bitDepth) - 1u);
+	}
+
+}
+
+bool PngDecoder::Decode(const uint8_t* data, const size_t& size, Image& image) {
+	const uint8_t SIGNATURE[8] = { 0x89,'P','N','G','\r','\n',0x1A,'\n' };
+	if (size < 8u || std::memcmp(data, SIGNATURE, 8u) != 0) {
+		return false;
+	}
+
+	uint32_t width = 0u;
+	uint32_t height = 0u;
+	uint32_t bitDepth = 0u;
+	uint32_t colorType = 0u;
+	uint8_t palette[256][4] = {};
+	uint32_t paletteCount = 0u;
+	bool hasTransparency = false;
+	//グレースケールとRGBの透明色(tRNS)
+	uint32_t transparentColor[3] = {};
+	std::vector<uint8_t> compressed;
+
+	//チャンクを読む
+	//CRCは確認しない
+	size_t position = 8u;
+	while (position + 12u <= size) {
+		uint32_t length = ReadBigEndian32(data + position);
+		const uint8_t* type = data + position + 4u;
+		const uint8_t* chunk = data + position + 8u;
+		if (position + 12u + length > size) {
+			return false;
+		}
+		position += 12u + length;
+
+		if (std::memcmp(type, "IHDR", 4u) == 0 && length >= 13u) {
+			width = ReadBigEndian32(chunk);
+			height = ReadBigEndian32(chunk + 4u);
+			bitDepth = chunk[8];
+			colorType = chunk[9];
+			//16bitとインターレースは扱わない
+			if (bitDepth > 8u || chunk[12] != 0u) {
+				return false;
+			}
+		}
+		else if (std::memcmp(type, "PLTE", 4u) == 0) {
+			paletteCount = std::min<uint32_t>(length / 3u, 256u);
+			for (uint32_t i = 0u; i < paletteCount; ++i) {
+				palette[i][0] = chunk[i * 3u + 0u];
+				palette[i][1] = chunk[i * 3u + 1u];
+				palette[i][2] = chunk[i * 3u + 2u];
+				palette[i][3] = 255u;
+			}
+		}
+		else if (std::memcmp(type, "tRNS", 4u) == 0) {
+			hasTransparency = true;
+			if (colorType == 3u) {
+				for (uint32_t i = 0u; i < std::min<uint32_t>(length, 256u); ++i) {
+					palette[i][3] = chunk[i];
+				}
+			}
+			else {
+				for (uint32_t i = 0u; i < std::min<uint32_t>(length / 2u, 3u); ++i) {
+					transparentColor[i] = (uint32_t(chunk[i * 2u]) << 8u) | chunk[i * 2u + 1u];
+				}
+			}
+		}
+		else if (std::memcmp(type, "IDAT", 4u) == 0) {
+			compressed.insert(compressed.end(), chunk, chunk + length);
+		}
+		else if (std::memcmp(type, "IEND", 4u) == 0) {
+			break;
+		}
+	}
+	if (width == 0u || height == 0u || compressed.empty()) {
+		return false;
+	}
+
+	//色の種類ごとのサンプル数
+	uint32_t samplesPerPixel = 0u;
+	switch (colorType) {
+	case 0:
+	case 3:
+		samplesPerPixel = 1u;
+		break;
+	case 2:
+		samplesPerPixel = 3u;
+		break;
+	case 4:
+		samplesPerPixel = 2u;
+		break;
+	case 6:
+		samplesPerPixel = 4u;
+		break;
+	default:
+		return false;
+	}
+	if (colorType == 3u && paletteCount == 0u) {
+		return false;
+	}
+
+	//展開してフィルタを戻す
+	std::vector<uint8_t> filtered;
+	filtered.reserve(size_t(width) * height * samplesPerPixel + height);
+	if (Inflate(compressed.data(), compressed.size(), filtered) == false) {
+		return false;
+	}
+	size_t rowSize = (size_t(width) * samplesPerPixel * bitDepth + 7u) / 8u;
+	size_t bytesPerPixel = std::max<size_t>(samplesPerPixel * bitDepth / 8u, 1u);
+	std::vector<uint8_t> rows;
+	if (Unfilter(filtered, height, rowSize, bytesPerPixel, rows) == false) {
+		return false;
+	}
+
+	//透明色の無いグレースケールはWICと同じくR8のまま
+	//それ以外はRGBA8に揃える
+	uint32_t maxSample = (1u << bitDepth) - 1u;
+	image.width = width;
+	image.height = height;
+	image.channelCount = (colorType == 0u && hasTransparency == false) ? 1u : 4u;
+	image.pixels.assign(size_t(width) * height * image.channelCount, 0u);
+	for (uint32_t y = 0u; y < height; ++y) {
+		const uint8_t* row = rows.data() + y * rowSize;
+		uint8_t* destination = image.pixels.data() + size_t(y) * width * image.channelCount;
+		for (uint32_t x = 0u; x < width; ++x) {
+			uint32_t samples[4] = {};
+			for (uint32_t s = 0u; s < samplesPerPixel; ++s) {
+				samples[s] = ReadSample(row, size_t(x) * samplesPerPixel + s, bitDepth);
+			}
+
+			uint8_t* pixel = destination + size_t(x) * image.channelCount;
+			switch (colorType) {
+			case 0:
+			{
+				uint8_t gray = uint8_t(samples[0] * 255u / maxSample);
+				if (image.channelCount == 1u) {
+					pixel[0] = gray;
+					break;
+				}
+				pixel[0] = gray;
+				pixel[1] = gray;
+				pixel[2] = gray;
+				pixel[3] = uint8_t((samples[0] == transparentColor[0]) ? 0u : 255u);
+				break;
+			}
+			case 2:
+				pixel[0] = uint8_t(samples[0]);
+				pixel[1] = uint8_t(samples[1]);
+				pixel[2] = uint8_t(samples[2]);
+				pixel[3] = uint8_t((hasTransparency && samples[0] == transparentColor[0] && samples[1] == transparentColor[1] && samples[2] == transparentColor[2]) ? 0u : 255u);
+				break;
+			case 3:
+				if (samples[0] >= paletteCount) {
+					return false;
+				}
+				std::memcpy(pixel, palette[samples[0]], 4u);
+				break;
+			case 4:
+				pixel[0] = uint8_t(samples[0]);
+				pixel[1] = uint8_t(samples[0]);
+				pixel[2] = uint8_t(samples[0]);
+				pixel[3] = uint8_t(samples[1]);
+				break;
+			default:
+				pixel[0] = uint8_t(samples[0]);
+				pixel[1] = uint8_t(samples[1]);
+				pixel[2] = uint8_t(samples[2]);
+				pixel[3] = uint8_t(samples[3]);
+				break;
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file PngDecoder.h
+ * @brief PNGの読み込み(クック用)
+ * @author 茂木翼
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// PNGの読み込み(クック用)
+/// WICを使わないのでWindows以外のツールでもクック出来る
+/// 8bit以下でインターレース無しのものだけ扱う
+/// </summary>
+namespace PngDecoder {
+
+	/// <summary>
+	/// 読み込んだ画像
+	/// </summary>
+	struct Image {
+		//幅
+		uint32_t width;
+		//高さ
+		uint32_t height;
+		//1画素のチャンネル数
+		//グレースケールは1(R8)、それ以外はRGBA8に揃えて4
+		uint32_t channelCount;
+		//画素
+		std::vector<uint8_t> pixels;
+	};
+
+	/// <summary>
+	/// 読み込み
+	/// </summary>
+	/// <param name="data">PNGファイルの中身</param>
+	/// <param name="size">サイズ</param>
+	/// <param name="image">画像</param>
+	/// <returns>読み込めたかどうか(16bitやインターレースは失敗にする)</returns>
+	bool Decode(const uint8_t* data, const size_t& size, Image& image);
+
+};
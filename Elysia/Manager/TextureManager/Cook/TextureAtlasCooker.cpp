@@ -0,0 +1,251 @@
+#include "TextureAtlasCooker.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+#include "MappedFile.h"
+#include "PngDecoder.h"
+#include "TextureCooker.h"
+
+namespace {
+
+	//FNV-1aの定数
+	const uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+	const uint64_t FNV_PRIME = 0x100000001B3ull;
+
+	/// <summary>
+	/// ハッシュに混ぜる
+	/// </summary>
+	/// <param name="hash">ハッシュ</param>
+	/// <param name="bytes">混ぜるもの</param>
+	/// <param name="count">バイト数</param>
+	void Mix(uint64_t& hash, const void* bytes, const size_t& count) {
+		const uint8_t* data = static_cast<const uint8_t*>(bytes);
+		for (size_t i = 0u; i < count; ++i) {
+			hash ^= data[i];
+			hash *= FNV_PRIME;
+		}
+	}
+
+	/// <summary>
+	/// 途中で読まれても壊れないように一時ファイルに書いてから置き換える
+	/// </summary>
+	/// <param name="filePath">書き出し先</param>
+	/// <param name="buffer">中身</param>
+	/// <returns>書き出せたかどうか</returns>
+	bool WriteFile(const std::string& filePath, const std::vector<uint8_t>& buffer) {
+		std::string temporaryFilePath = filePath + ".tmp";
+		{
+			std::ofstream file(temporaryFilePath, std::ios::binary | std::ios::trunc);
+			if (!file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+				return false;
+			}
+		}
+		std::error_code errorCode;
+		std::filesystem::rename(temporaryFilePath, filePath, errorCode);
+		return !errorCode;
+	}
+
+	/// <summary>
+	/// ハッシュからファイル名を作る
+	/// </summary>
+	/// <param name="cookedDirectory">置き場所</param>
+	/// <param name="contentHash">ハッシュ</param>
+	/// <param name="extension">拡張子</param>
+	/// <returns>パス</returns>
+	std::string MakeCookedFilePath(const std::string& cookedDirectory, const uint64_t& contentHash, const char* extension) {
+		char name[17] = {};
+		std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(contentHash));
+		return cookedDirectory + name + extension;
+	}
+
+}
+
+bool TextureAtlasCooker::ComputeContentHash(const std::vector<std::string>& filePaths, const Elysia::TextureAtlasBuilder::Settings& settings, const uint32_t& mipLevels, uint64_t& contentHash) {
+	uint64_t hash = FNV_OFFSET_BASIS;
+
+	//設定が変わったら別のファイルになるようにする
+	//ミップマップはTextureCookerで作るのでそちらのバージョンも混ぜる
+	const uint32_t values[] = {
+		VERSION, TextureCooker::VERSION, mipLevels,
+		settings.width, settings.maxHeight, settings.gutter, settings.padding, settings.alignment,
+		static_cast<uint32_t>(filePaths.size()),
+	};
+	Mix(hash, values, sizeof(values));
+
+	//それぞれの画像はパスと中身のハッシュを混ぜる
+	for (const std::string& filePath : filePaths) {
+		Elysia::MappedFile mappedFile;
+		if (mappedFile.Open(filePath) == false) {
+			return false;
+		}
+		uint64_t fileHash = TextureCooker::ComputeContentHash(mappedFile.GetData(), mappedFile.GetSize());
+		Mix(hash, filePath.data(), filePath.size() + 1u);
+		Mix(hash, &fileHash, sizeof(fileHash));
+	}
+
+	contentHash = hash;
+	return true;
+}
+
+std::string TextureAtlasCooker::GetCookedTexturePath(const std::string& cookedDirectory, const uint64_t& contentHash) {
+	return MakeCookedFilePath(cookedDirectory, contentHash, TextureCooker::EXTENSION);
+}
+
+std::string TextureAtlasCooker::GetCookedTablePath(const std::string& cookedDirectory, const uint64_t& contentHash) {
+	return MakeCookedFilePath(cookedDirectory, contentHash, TABLE_EXTENSION);
+}
+
+std::vector<uint8_t> TextureAtlasCooker::MakeTable(const uint32_t& width, const uint32_t& height, const std::vector<Elysia::AtlasRegion>& regions) {
+	TableHeader header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.width = width;
+	header.height = height;
+	header.regionCount = static_cast<uint32_t>(regions.size());
+
+	std::vector<uint8_t> buffer(sizeof(TableHeader));
+	std::memcpy(buffer.data(), &header, sizeof(TableHeader));
+	for (const Elysia::AtlasRegion& region : regions) {
+		TableRegion tableRegion = {
+			.nameLength = static_cast<uint32_t>(region.name.size()),
+			.x = region.x,
+			.y = region.y,
+			.width = region.width,
+			.height = region.height,
+			.texLeftTop = { region.texLeftTop.x, region.texLeftTop.y },
+			.texRightBottom = { region.texRightBottom.x, region.texRightBottom.y },
+		};
+		size_t offset = buffer.size();
+		buffer.resize(offset + sizeof(TableRegion) + region.name.size());
+		std::memcpy(buffer.data() + offset, &tableRegion, sizeof(TableRegion));
+		std::memcpy(buffer.data() + offset + sizeof(TableRegion), region.name.data(), region.name.size());
+	}
+	return buffer;
+}
+
+bool TextureAtlasCooker::ParseTable(const uint8_t* data, const size_t& size, std::vector<Elysia::AtlasRegion>& regions) {
+	TableHeader header = {};
+	if (size < sizeof(TableHeader)) {
+		return false;
+	}
+	std::memcpy(&header, data, sizeof(TableHeader));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+		return false;
+	}
+
+	regions.clear();
+	regions.reserve(header.regionCount);
+	size_t offset = sizeof(TableHeader);
+	for (uint32_t i = 0u; i < header.regionCount; ++i) {
+		TableRegion tableRegion = {};
+		if (size - offset < sizeof(TableRegion)) {
+			return false;
+		}
+		std::memcpy(&tableRegion, data + offset, sizeof(TableRegion));
+		offset += sizeof(TableRegion);
+		if (size - offset < tableRegion.nameLength) {
+			return false;
+		}
+
+		Elysia::AtlasRegion region = {
+			.name = std::string(reinterpret_cast<const char*>(data + offset), tableRegion.nameLength),
+			.x = tableRegion.x,
+			.y = tableRegion.y,
+			.width = tableRegion.width,
+			.height = tableRegion.height,
+			.texLeftTop = {.x = tableRegion.texLeftTop[0],.y = tableRegion.texLeftTop[1] },
+			.texRightBottom = {.x = tableRegion.texRightBottom[0],.y = tableRegion.texRightBottom[1] },
+		};
+		offset += tableRegion.nameLength;
+		regions.push_back(std::move(region));
+	}
+	return offset == size;
+}
+
+bool TextureAtlasCooker::FindCookedFiles(const std::vector<std::string>& filePaths, const Elysia::TextureAtlasBuilder::Settings& settings, const uint32_t& mipLevels, const std::string& cookedDirectory,
+	std::string& cookedTexturePath, std::vector<Elysia::AtlasRegion>& regions) {
+	//中身を読むだけなので展開よりずっと軽い
+	uint64_t contentHash = 0u;
+	if (ComputeContentHash(filePaths, settings, mipLevels, contentHash) == false) {
+		return false;
+	}
+
+	Elysia::MappedFile tableFile;
+	if (tableFile.Open(GetCookedTablePath(cookedDirectory, contentHash)) == false ||
+		ParseTable(tableFile.GetData(), tableFile.GetSize(), regions) == false) {
+		return false;
+	}
+
+	//表は元の画像のパスの順に並んでいる
+	if (regions.size() != filePaths.size()) {
+		return false;
+	}
+	for (size_t i = 0u; i < regions.size(); ++i) {
+		if (regions[i].name != filePaths[i]) {
+			return false;
+		}
+	}
+
+	std::string texturePath = GetCookedTexturePath(cookedDirectory, contentHash);
+	std::error_code errorCode;
+	if (std::filesystem::exists(texturePath, errorCode) == false) {
+		return false;
+	}
+	cookedTexturePath = texturePath;
+	return true;
+}
+
+bool TextureAtlasCooker::Cook(const std::vector<std::string>& filePaths, const Elysia::TextureAtlasBuilder::Settings& settings, const uint32_t& mipLevels, const std::string& cookedDirectory) {
+	uint64_t contentHash = 0u;
+	if (ComputeContentHash(filePaths, settings, mipLevels, contentHash) == false) {
+		return false;
+	}
+
+	//それぞれの画像を読み込んでまとめる
+	Elysia::TextureAtlasBuilder atlasBuilder;
+	std::vector<uint8_t> pixels;
+	for (const std::string& filePath : filePaths) {
+		Elysia::MappedFile mappedFile;
+		PngDecoder::Image image = {};
+		if (mappedFile.Open(filePath) == false || PngDecoder::Decode(mappedFile.GetData(), mappedFile.GetSize(), image) == false) {
+			return false;
+		}
+
+		//グレースケールはWICで読んだ時と同じようにRGBA8に広げる
+		const uint8_t* source = image.pixels.data();
+		if (image.channelCount == 1u) {
+			pixels.resize(size_t(image.width) * image.height * Elysia::TextureAtlasBuilder::BYTES_PER_PIXEL_);
+			for (size_t i = 0u; i < image.pixels.size(); ++i) {
+				pixels[i * 4u + 0u] = image.pixels[i];
+				pixels[i * 4u + 1u] = image.pixels[i];
+				pixels[i * 4u + 2u] = image.pixels[i];
+				pixels[i * 4u + 3u] = 255u;
+			}
+			source = pixels.data();
+		}
+		atlasBuilder.Add(filePath, image.width, image.height, source, size_t(image.width) * Elysia::TextureAtlasBuilder::BYTES_PER_PIXEL_);
+	}
+	if (atlasBuilder.Build(settings) == false) {
+		return false;
+	}
+
+	//ミップマップはTextureCookerと同じく線形で平均する
+	PngDecoder::Image atlasImage = {
+		.width = atlasBuilder.GetWidth(),
+		.height = atlasBuilder.GetHeight(),
+		.channelCount = Elysia::TextureAtlasBuilder::BYTES_PER_PIXEL_,
+		.pixels = atlasBuilder.GetPixels(),
+	};
+	std::vector<uint8_t> texture = TextureCooker::MakeDDS(TextureCooker::Compress(atlasImage, TextureCooker::R8G8B8A8UnormSrgb, mipLevels));
+	std::vector<uint8_t> table = MakeTable(atlasBuilder.GetWidth(), atlasBuilder.GetHeight(), atlasBuilder.GetRegions());
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(cookedDirectory, errorCode);
+
+	//表を後に書いて、表があればテクスチャも揃っているようにする
+	return WriteFile(GetCookedTexturePath(cookedDirectory, contentHash), texture) &&
+		WriteFile(GetCookedTablePath(cookedDirectory, contentHash), table);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @file TextureAtlasCooker.h
+ * @brief アトラスのクック(PNG→ミップマップ付きのDDSと範囲の表)
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "TextureAtlasBuilder.h"
+
+/// <summary>
+/// アトラスのクック(PNG→ミップマップ付きのDDSと範囲の表)
+/// 起動の度に全部の画像を展開して詰め、ミップマップを作っていたのを1回だけにする
+/// 元の画像全部の中身と設定のハッシュで名前を付けるので、どれか1枚でも変われば作り直す
+/// </summary>
+namespace TextureAtlasCooker {
+
+	//バージョン
+	//出力が変わる修正をしたら上げてね(ハッシュに混ぜるので古いものは使われなくなる)
+	const uint32_t VERSION = 1u;
+	//クックしたファイルの置き場所(実行時の作業ディレクトリから)
+	//Tools/TextureCookerはResources/Cooked/Texture/の使っていないものを消すので分けておく
+	const char COOKED_DIRECTORY[] = "Resources/Cooked/Atlas/";
+	//範囲の表の拡張子
+	const char TABLE_EXTENSION[] = ".atlas";
+	//範囲の表の識別子
+	const char MAGIC[4] = { 'E','A','T','L' };
+
+	/// <summary>
+	/// 範囲の表のヘッダー
+	/// 後ろに画像の数だけTableRegionと名前が続く
+	/// </summary>
+	struct TableHeader {
+		//識別子
+		char magic[4];
+		//バージョン
+		uint32_t version;
+		//アトラスの大きさ
+		uint32_t width;
+		uint32_t height;
+		//画像の数
+		uint32_t regionCount;
+	};
+
+	/// <summary>
+	/// 範囲の表の1枚分
+	/// </summary>
+	struct TableRegion {
+		//名前の長さ(名前はこの後ろに続く)
+		uint32_t nameLength;
+		//アトラスの中の位置(ピクセル、ガターを除く)
+		uint32_t x;
+		uint32_t y;
+		//元の画像の大きさ
+		uint32_t width;
+		uint32_t height;
+		//UV
+		float texLeftTop[2];
+		float texRightBottom[2];
+	};
+
+	static_assert(sizeof(TableHeader) == 20u, "TableHeaderのサイズが変わっています");
+	static_assert(sizeof(TableRegion) == 36u, "TableRegionのサイズが変わっています");
+
+	/// <summary>
+	/// 元の画像全部の中身と設定のハッシュ(64bitのFNV-1a)
+	/// 並びやファイルパスが変わっても別のものになる
+	/// </summary>
+	/// <param name="filePaths">元の画像のパス</param>
+	/// <param name="settings">詰める設定</param>
+	/// <param name="mipLevels">ミップマップの数</param>
+	/// <param name="contentHash">ハッシュ</param>
+	/// <returns>全部読めたかどうか</returns>
+	bool ComputeContentHash(const std::vector<std::string>& filePaths, const Elysia::TextureAtlasBuilder::Settings& settings, const uint32_t& mipLevels, uint64_t& contentHash);
+
+	/// <summary>
+	/// ハッシュからクックしたテクスチャ(DDS)のパスを作る
+	/// </summary>
+	/// <param name="cookedDirectory">置き場所</param>
+	/// <param name="contentHash">ハッシュ</param>
+	/// <returns>クックしたテクスチャのパス</returns>
+	std::string GetCookedTexturePath(const std::string& cookedDirectory, const uint64_t& contentHash);
+
+	/// <summary>
+	/// ハッシュから範囲の表のパスを作る
+	/// </summary>
+	/// <param name="cookedDirectory">置き場所</param>
+	/// <param name="contentHash">ハッシュ</param>
+	/// <returns>範囲の表のパス</returns>
+	std::string GetCookedTablePath(const std::string& cookedDirectory, const uint64_t& contentHash);
+
+	/// <summary>
+	/// 範囲の表のバイト列にする
+	/// </summary>
+	/// <param name="width">アトラスの幅</param>
+	/// <param name="height">アトラスの高さ</param>
+	/// <param name="regions">画像ごとの位置とUV</param>
+	/// <returns>範囲の表の中身</returns>
+	std::vector<uint8_t> MakeTable(const uint32_t& width, const uint32_t& height, const std::vector<Elysia::AtlasRegion>& regions);
+
+	/// <summary>
+	/// 範囲の表を読む
+	/// </summary>
+	/// <param name="data">範囲の表の中身</param>
+	/// <param name="size">サイズ</param>
+	/// <param name="regions">画像ごとの位置とUV</param>
+	/// <returns>読めたかどうか(壊れている、バージョンが違うものは失敗にする)</returns>
+	bool ParseTable(const uint8_t* data, const size_t& size, std::vector<Elysia::AtlasRegion>& regions);
+
+	/// <summary>
+	/// 元の画像に対応するクックしたアトラスを探す
+	/// 範囲の表は最後に書くので、表が読めればテクスチャも書き終わっている
+	/// </summary>
+	/// <param name="filePaths">元の画像のパス</param>
+	/// <param name="settings">詰める設定</param>
+	/// <param name="mipLevels">ミップマップの数</param>
+	/// <param name="cookedDirectory">置き場所</param>
+	/// <param name="cookedTexturePath">クックしたテクスチャのパス</param>
+	/// <param name="regions">画像ごとの位置とUV(元の画像のパスの順)</param>
+	/// <returns>見つかったかどうか</returns>
+	bool FindCookedFiles(const std::vector<std::string>& filePaths, const Elysia::TextureAtlasBuilder::Settings& settings, const uint32_t& mipLevels, const std::string& cookedDirectory,
+		std::string& cookedTexturePath, std::vector<Elysia::AtlasRegion>& regions);
+
+	/// <summary>
+	/// クック
+	/// 元の画像を読み込んで詰め、ミップマップ付きのDDSと範囲の表を書き出す
+	/// ミップマップを作る時にブロックで隣の画像が混ざらないよう、圧縮せずRGBA8のままにする
+	/// </summary>
+	/// <param name="filePaths">元の画像のパス</param>
+	/// <param name="settings">詰める設定</param>
+	/// <param name="mipLevels">ミップマップの数</param>
+	/// <param name="cookedDirectory">置き場所</param>
+	/// <returns>書き出せたかどうか(扱えない画像や入りきらない時も失敗にする)</returns>
+	bool Cook(const std::vector<std::string>& filePaths, const Elysia::TextureAtlasBuilder::Settings& settings, const uint32_t& mipLevels, const std::string& cookedDirectory);
+
+};
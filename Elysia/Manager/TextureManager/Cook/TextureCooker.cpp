@@ -0,0 +1,357 @@
+#include "TextureCooker.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+#include "MappedFile.h"
+#include "BlockCompressor.h"
+
+namespace {
+
+	//sRGBの値から線形の値(0～65535)
+	//powの結果は環境で最後の桁がずれることがあるので表にしておく
+	const uint16_t SRGB_TO_LINEAR[256] = {
+		    0,    20,    40,    60,    80,    99,   119,   139,   159,   179,   199,   219,   241,   264,   288,   313,
+		  340,   367,   396,   427,   458,   491,   526,   562,   599,   637,   677,   718,   761,   805,   851,   898,
+		  947,   997,  1048,  1101,  1156,  1212,  1270,  1330,  1391,  1453,  1517,  1583,  1651,  1720,  1790,  1863,
+		 1937,  2013,  2090,  2170,  2250,  2333,  2418,  2504,  2592,  2681,  2773,  2866,  2961,  3058,  3157,  3258,
+		 3360,  3464,  3570,  3678,  3788,  3900,  4014,  4129,  4247,  4366,  4488,  4611,  4736,  4864,  4993,  5124,
+		 5257,  5392,  5530,  5669,  5810,  5953,  6099,  6246,  6395,  6547,  6700,  6856,  7014,  7174,  7335,  7500,
+		 7666,  7834,  8004,  8177,  8352,  8528,  8708,  8889,  9072,  9258,  9445,  9635,  9828, 10022, 10219, 10417,
+		10619, 10822, 11028, 11235, 11446, 11658, 11873, 12090, 12309, 12530, 12754, 12980, 13209, 13440, 13673, 13909,
+		14146, 14387, 14629, 14874, 15122, 15371, 15623, 15878, 16135, 16394, 16656, 16920, 17187, 17456, 17727, 18001,
+		18277, 18556, 18837, 19121, 19407, 19696, 19987, 20281, 20577, 20876, 21177, 21481, 21787, 22096, 22407, 22721,
+		23038, 23357, 23678, 24002, 24329, 24658, 24990, 25325, 25662, 26001, 26344, 26688, 27036, 27386, 27739, 28094,
+		28452, 28813, 29176, 29542, 29911, 30282, 30656, 31033, 31412, 31794, 32179, 32567, 32957, 33350, 33745, 34143,
+		34544, 34948, 35355, 35764, 36176, 36591, 37008, 37429, 37852, 38278, 38706, 39138, 39572, 40009, 40449, 40891,
+		41337, 41785, 42236, 42690, 43147, 43606, 44069, 44534, 45002, 45473, 45947, 46423, 46903, 47385, 47871, 48359,
+		48850, 49344, 49841, 50341, 50844, 51349, 51858, 52369, 52884, 53401, 53921, 54445, 54971, 55500, 56032, 56567,
+		57105, 57646, 58190, 58737, 59287, 59840, 60396, 60955, 61517, 62082, 62650, 63221, 63795, 64372, 64952, 65535,
+	};
+
+	//DDSの定数
+	const uint32_t DDS_MAGIC = 0x20534444u;
+	const uint32_t DDS_FOURCC_DX10 = 0x30315844u;
+	const uint32_t DDSD_CAPS = 0x1u;
+	const uint32_t DDSD_HEIGHT = 0x2u;
+	const uint32_t DDSD_WIDTH = 0x4u;
+	const uint32_t DDSD_PITCH = 0x8u;
+	const uint32_t DDSD_PIXELFORMAT = 0x1000u;
+	const uint32_t DDSD_MIPMAPCOUNT = 0x20000u;
+	const uint32_t DDSD_LINEARSIZE = 0x80000u;
+	const uint32_t DDPF_FOURCC = 0x4u;
+	const uint32_t DDSCAPS_COMPLEX = 0x8u;
+	const uint32_t DDSCAPS_TEXTURE = 0x1000u;
+	const uint32_t DDSCAPS_MIPMAP = 0x400000u;
+	const uint32_t DDS_DIMENSION_TEXTURE2D = 3u;
+
+	//FNV-1aの定数
+	const uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+	const uint64_t FNV_PRIME = 0x100000001B3ull;
+
+	/// <summary>
+	/// 線形の値からsRGBの値
+	/// 表を二分探索して一番近いものにする
+	/// </summary>
+	/// <param name="linear">線形の値(0～65535)</param>
+	/// <returns>sRGBの値</returns>
+	uint8_t LinearToSrgb(const uint32_t& linear) {
+		const uint16_t* upper = std::lower_bound(SRGB_TO_LINEAR, SRGB_TO_LINEAR + 256, linear);
+		if (upper == SRGB_TO_LINEAR) {
+			return 0u;
+		}
+		if (upper == SRGB_TO_LINEAR + 256) {
+			return 255u;
+		}
+		const uint16_t* lower = upper - 1;
+		return uint8_t(((linear - *lower) < (*upper - linear)) ? (lower - SRGB_TO_LINEAR) : (upper - SRGB_TO_LINEAR));
+	}
+
+	/// <summary>
+	/// 形式が色かどうか(sRGBで平均する)
+	/// </summary>
+	/// <param name="format">形式</param>
+	/// <returns>色かどうか</returns>
+	inline bool IsSrgb(const TextureCooker::Format& format) {
+		return format != TextureCooker::R8Unorm && format != TextureCooker::BC4Unorm;
+	}
+
+	/// <summary>
+	/// ブロック圧縮の形式かどうか
+	/// </summary>
+	/// <param name="format">形式</param>
+	/// <returns>ブロック圧縮かどうか</returns>
+	inline bool IsBlockCompressed(const TextureCooker::Format& format) {
+		return format != TextureCooker::R8Unorm && format != TextureCooker::R8G8B8A8UnormSrgb;
+	}
+
+	/// <summary>
+	/// 1ブロック(ブロック圧縮でなければ1画素)のバイト数
+	/// </summary>
+	/// <param name="format">形式</param>
+	/// <returns>バイト数</returns>
+	uint32_t GetBytesPerBlock(const TextureCooker::Format& format) {
+		switch (format) {
+		case TextureCooker::R8Unorm:
+			return 1u;
+		case TextureCooker::R8G8B8A8UnormSrgb:
+			return 4u;
+		case TextureCooker::BC1UnormSrgb:
+		case TextureCooker::BC4Unorm:
+			return 8u;
+		default:
+			return 16u;
+		}
+	}
+
+	/// <summary>
+	/// 半分の大きさにする(2x2の平均)
+	/// 色はsRGBのまま平均すると暗くなるので線形にしてから平均する
+	/// </summary>
+	/// <param name="source">元の画像</param>
+	/// <param name="isSrgb">色かどうか</param>
+	/// <returns>半分の大きさの画像</returns>
+	PngDecoder::Image Downsample(const PngDecoder::Image& source, const bool& isSrgb) {
+		PngDecoder::Image result = {
+			.width = std::max<uint32_t>(source.width / 2u, 1u),
+			.height = std::max<uint32_t>(source.height / 2u, 1u),
+			.channelCount = source.channelCount,
+			.pixels = {},
+		};
+		uint32_t channelCount = source.channelCount;
+		result.pixels.resize(size_t(result.width) * result.height * channelCount);
+		for (uint32_t y = 0u; y < result.height; ++y) {
+			uint32_t sourceYs[2] = { std::min<uint32_t>(y * 2u, source.height - 1u), std::min<uint32_t>(y * 2u + 1u, source.height - 1u) };
+			for (uint32_t x = 0u; x < result.width; ++x) {
+				uint32_t sourceXs[2] = { std::min<uint32_t>(x * 2u, source.width - 1u), std::min<uint32_t>(x * 2u + 1u, source.width - 1u) };
+				uint8_t* destination = result.pixels.data() + (size_t(y) * result.width + x) * channelCount;
+				for (uint32_t c = 0u; c < channelCount; ++c) {
+					//アルファとグレースケールはそのまま平均する
+					bool isLinear = isSrgb == false || c == 3u;
+					uint32_t sum = 0u;
+					for (uint32_t sy : sourceYs) {
+						for (uint32_t sx : sourceXs) {
+							uint8_t value = source.pixels[(size_t(sy) * source.width + sx) * channelCount + c];
+							sum += isLinear ? value : SRGB_TO_LINEAR[value];
+						}
+					}
+					destination[c] = isLinear ? uint8_t((sum + 2u) / 4u) : LinearToSrgb((sum + 2u) / 4u);
+				}
+			}
+		}
+		return result;
+	}
+
+	/// <summary>
+	/// 1つのミップを書き込む
+	/// </summary>
+	/// <param name="image">画像</param>
+	/// <param name="format">形式</param>
+	/// <param name="output">書き込み先(後ろに足す)</param>
+	void EncodeLevel(const PngDecoder::Image& image, const TextureCooker::Format& format, std::vector<uint8_t>& output) {
+		//ブロック圧縮でなければそのまま
+		if (IsBlockCompressed(format) == false) {
+			output.insert(output.end(), image.pixels.begin(), image.pixels.end());
+			return;
+		}
+
+		uint32_t blockWidth = (image.width + 3u) / 4u;
+		uint32_t blockHeight = (image.height + 3u) / 4u;
+		uint32_t bytesPerBlock = GetBytesPerBlock(format);
+		size_t offset = output.size();
+		output.resize(offset + size_t(blockWidth) * blockHeight * bytesPerBlock);
+
+		uint8_t pixels[BlockCompressor::BLOCK_PIXEL_COUNT * 4u] = {};
+		for (uint32_t by = 0u; by < blockHeight; ++by) {
+			for (uint32_t bx = 0u; bx < blockWidth; ++bx) {
+				//はみ出した所は端の画素で埋める
+				for (uint32_t i = 0u; i < BlockCompressor::BLOCK_PIXEL_COUNT; ++i) {
+					uint32_t x = std::min<uint32_t>(bx * 4u + i % 4u, image.width - 1u);
+					uint32_t y = std::min<uint32_t>(by * 4u + i / 4u, image.height - 1u);
+					std::memcpy(pixels + i * 4u, image.pixels.data() + (size_t(y) * image.width + x) * image.channelCount, image.channelCount);
+				}
+
+				uint8_t* block = output.data() + offset + (size_t(by) * blockWidth + bx) * bytesPerBlock;
+				switch (format) {
+				case TextureCooker::BC1UnormSrgb:
+					BlockCompressor::EncodeBC1(pixels, block);
+					break;
+				case TextureCooker::BC3UnormSrgb:
+					BlockCompressor::EncodeBC3(pixels, block);
+					break;
+				case TextureCooker::BC4Unorm:
+					BlockCompressor::EncodeBC4(pixels, 4u, block);
+					break;
+				default:
+					BlockCompressor::EncodeBC7(pixels, block);
+					break;
+				}
+			}
+		}
+	}
+}
+
+uint64_t TextureCooker::ComputeContentHash(const uint8_t* data, const size_t& size) {
+	uint64_t hash = FNV_OFFSET_BASIS;
+	auto mix = [&hash](const uint8_t* bytes, const size_t& count) {
+		for (size_t i = 0u; i < count; ++i) {
+			hash ^= bytes[i];
+			hash *= FNV_PRIME;
+		}
+	};
+
+	//設定が変わったら別のファイルになるようにする
+	const uint8_t settings[8] = {
+		uint8_t(VERSION), uint8_t(VERSION >> 8u), uint8_t(VERSION >> 16u), uint8_t(VERSION >> 24u),
+		uint8_t(MIP_LEVELS), uint8_t(MIP_LEVELS >> 8u), uint8_t(MIP_LEVELS >> 16u), uint8_t(MIP_LEVELS >> 24u),
+	};
+	mix(settings, sizeof(settings));
+	mix(data, size);
+	return hash;
+}
+
+std::string TextureCooker::GetCookedFilePath(const std::string& cookedDirectory, const uint64_t& contentHash) {
+	char name[17] = {};
+	std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(contentHash));
+	return cookedDirectory + name + EXTENSION;
+}
+
+std::string TextureCooker::FindCookedFile(const std::string& sourceFilePath, const std::string& cookedDirectory) {
+	//中身を読むだけなので展開よりずっと軽い
+	Elysia::MappedFile mappedFile;
+	if (mappedFile.Open(sourceFilePath) == false) {
+		return {};
+	}
+	std::string cookedFilePath = GetCookedFilePath(cookedDirectory, ComputeContentHash(mappedFile.GetData(), mappedFile.GetSize()));
+
+	std::error_code errorCode;
+	if (std::filesystem::exists(cookedFilePath, errorCode) == false) {
+		return {};
+	}
+	return cookedFilePath;
+}
+
+TextureCooker::Format TextureCooker::ChooseFormat(const PngDecoder::Image& image) {
+	//BCの一番大きいミップは4の倍数でないといけない
+	bool isBlockAligned = (image.width % 4u == 0u) && (image.height % 4u == 0u);
+	if (image.channelCount == 1u) {
+		return isBlockAligned ? BC4Unorm : R8Unorm;
+	}
+	if (isBlockAligned == false) {
+		return R8G8B8A8UnormSrgb;
+	}
+
+	bool isOpaque = true;
+	bool isCutout = true;
+	for (size_t i = 3u; i < image.pixels.size(); i += 4u) {
+		uint8_t alpha = image.pixels[i];
+		isOpaque = isOpaque && alpha == 255u;
+		isCutout = isCutout && (alpha == 0u || alpha == 255u);
+	}
+	//BC7(モード6)は色とアルファで補間の番号を共有するので、
+	//0と255だけのアルファは別々に持つBC3の方が色がきれいに残る
+	if (isOpaque == true) {
+		return BC1UnormSrgb;
+	}
+	if (isCutout == true) {
+		return BC3UnormSrgb;
+	}
+	return BC7UnormSrgb;
+}
+
+TextureCooker::CookedTexture TextureCooker::Compress(const PngDecoder::Image& image, const Format& format, const uint32_t& mipLevels) {
+	//1x1まで作れる数に抑える
+	uint32_t maxMipLevels = 1u;
+	for (uint32_t size = std::max<uint32_t>(image.width, image.height); size > 1u; size /= 2u) {
+		++maxMipLevels;
+	}
+
+	CookedTexture texture = {
+		.format = format,
+		.width = image.width,
+		.height = image.height,
+		.mipLevels = std::clamp<uint32_t>(mipLevels, 1u, maxMipLevels),
+		.data = {},
+	};
+	EncodeLevel(image, format, texture.data);
+	PngDecoder::Image level = {};
+	const PngDecoder::Image* previous = &image;
+	for (uint32_t mip = 1u; mip < texture.mipLevels; ++mip) {
+		level = Downsample(*previous, IsSrgb(format));
+		EncodeLevel(level, format, texture.data);
+		previous = &level;
+	}
+	return texture;
+}
+
+std::vector<uint8_t> TextureCooker::MakeDDS(const CookedTexture& texture) {
+	bool isBlockCompressed = IsBlockCompressed(texture.format);
+	uint32_t bytesPerBlock = GetBytesPerBlock(texture.format);
+	//ブロック圧縮は一番大きいミップの全体のサイズ、それ以外は1行のサイズ
+	uint32_t pitchOrLinearSize = isBlockCompressed ?
+		((texture.width + 3u) / 4u) * ((texture.height + 3u) / 4u) * bytesPerBlock :
+		texture.width * bytesPerBlock;
+
+	DDSHeader header = {};
+	header.magic = DDS_MAGIC;
+	header.size = 124u;
+	header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | (isBlockCompressed ? DDSD_LINEARSIZE : DDSD_PITCH);
+	header.height = texture.height;
+	header.width = texture.width;
+	header.pitchOrLinearSize = pitchOrLinearSize;
+	header.mipMapCount = texture.mipLevels;
+	header.pixelFormatSize = 32u;
+	header.pixelFormatFlags = DDPF_FOURCC;
+	header.fourCC = DDS_FOURCC_DX10;
+	header.caps[0] = DDSCAPS_TEXTURE | ((texture.mipLevels > 1u) ? (DDSCAPS_COMPLEX | DDSCAPS_MIPMAP) : 0u);
+	header.dxgiFormat = texture.format;
+	header.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+	header.arraySize = 1u;
+
+	std::vector<uint8_t> buffer(sizeof(DDSHeader) + texture.data.size());
+	std::memcpy(buffer.data(), &header, sizeof(DDSHeader));
+	std::memcpy(buffer.data() + sizeof(DDSHeader), texture.data.data(), texture.data.size());
+	return buffer;
+}
+
+bool TextureCooker::Cook(const uint8_t* data, const size_t& size, const std::string& cookedFilePath) {
+	PngDecoder::Image image = {};
+	if (PngDecoder::Decode(data, size, image) == false) {
+		return false;
+	}
+	std::vector<uint8_t> buffer = MakeDDS(Compress(image, ChooseFormat(image), MIP_LEVELS));
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(std::filesystem::path(cookedFilePath).parent_path(), errorCode);
+
+	//途中で読まれても壊れないように一時ファイルに書いてから置き換える
+	std::string temporaryFilePath = cookedFilePath + ".tmp";
+	{
+		std::ofstream file(temporaryFilePath, std::ios::binary | std::ios::trunc);
+		if (!file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+			return false;
+		}
+	}
+	std::filesystem::rename(temporaryFilePath, cookedFilePath, errorCode);
+	return !errorCode;
+}
+
+std::string TextureCooker::CookFile(const std::string& sourceFilePath, const std::string& cookedDirectory) {
+	//jpgなどはWICのまま読む
+	if (std::filesystem::path(sourceFilePath).extension() != ".png") {
+		return {};
+	}
+
+	Elysia::MappedFile mappedFile;
+	if (mappedFile.Open(sourceFilePath) == false) {
+		return {};
+	}
+	std::string cookedFilePath = GetCookedFilePath(cookedDirectory, ComputeContentHash(mappedFile.GetData(), mappedFile.GetSize()));
+	if (Cook(mappedFile.GetData(), mappedFile.GetSize(), cookedFilePath) == false) {
+		return {};
+	}
+	return cookedFilePath;
+}
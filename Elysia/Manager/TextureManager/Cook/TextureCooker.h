@@ -0,0 +1,165 @@
+#pragma once
+
+/**
+ * @file TextureCooker.h
+ * @brief テクスチャのクック(PNG→ミップマップ付きのBC圧縮DDS)
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "PngDecoder.h"
+
+/// <summary>
+/// テクスチャのクック(PNG→ミップマップ付きのBC圧縮DDS)
+/// 起動の度にWICで展開してミップマップを作っていたのを、事前に1回だけやっておく
+/// クックしたファイルは元の画像の中身のハッシュで名前を付けるので、画像が変われば自然に使われなくなる
+/// </summary>
+namespace TextureCooker {
+
+	//バージョン
+	//出力が変わる修正をしたら上げてね(ハッシュに混ぜるので古いものは使われなくなる)
+	const uint32_t VERSION = 1u;
+	//クックしたファイルの置き場所(実行時の作業ディレクトリから)
+	const char COOKED_DIRECTORY[] = "Resources/Cooked/Texture/";
+	//拡張子
+	const char EXTENSION[] = ".dds";
+	//ミップマップの数
+	//TextureManager::LoadTextureDataのGenerateMipMapsと同じ
+	const uint32_t MIP_LEVELS = 4u;
+
+	/// <summary>
+	/// 書き出す形式(値はDXGI_FORMATと同じ)
+	/// </summary>
+	enum Format : uint32_t {
+		//ブロックに割り切れない大きさの時
+		R8G8B8A8UnormSrgb = 29u,
+		R8Unorm = 61u,
+		//不透明
+		BC1UnormSrgb = 72u,
+		//アルファが0と255だけ(切り抜き)
+		BC3UnormSrgb = 78u,
+		//グレースケール
+		BC4Unorm = 80u,
+		//なめらかなアルファ
+		BC7UnormSrgb = 99u,
+	};
+
+	/// <summary>
+	/// DDSのヘッダー(DX10拡張付き)
+	/// </summary>
+	struct DDSHeader {
+		//"DDS "
+		uint32_t magic;
+		//DDS_HEADER
+		uint32_t size;
+		uint32_t flags;
+		uint32_t height;
+		uint32_t width;
+		uint32_t pitchOrLinearSize;
+		uint32_t depth;
+		uint32_t mipMapCount;
+		uint32_t reserved1[11];
+		//DDS_PIXELFORMAT
+		uint32_t pixelFormatSize;
+		uint32_t pixelFormatFlags;
+		uint32_t fourCC;
+		uint32_t rgbBitCount;
+		uint32_t bitMasks[4];
+		uint32_t caps[4];
+		uint32_t reserved2;
+		//DDS_HEADER_DXT10
+		uint32_t dxgiFormat;
+		uint32_t resourceDimension;
+		uint32_t miscFlag;
+		uint32_t arraySize;
+		uint32_t miscFlags2;
+	};
+
+	static_assert(sizeof(DDSHeader) == 148u, "DDSHeaderのサイズが変わっています");
+
+	/// <summary>
+	/// クックしたテクスチャ
+	/// </summary>
+	struct CookedTexture {
+		//形式
+		Format format;
+		//一番大きいミップの大きさ
+		uint32_t width;
+		uint32_t height;
+		//ミップマップの数
+		uint32_t mipLevels;
+		//全部のミップを大きい順に並べたもの
+		std::vector<uint8_t> data;
+	};
+
+	/// <summary>
+	/// 元の画像の中身のハッシュ(64bitのFNV-1a)
+	/// バージョンとミップマップの数も混ぜる
+	/// </summary>
+	/// <param name="data">元の画像ファイルの中身</param>
+	/// <param name="size">サイズ</param>
+	/// <returns>ハッシュ</returns>
+	uint64_t ComputeContentHash(const uint8_t* data, const size_t& size);
+
+	/// <summary>
+	/// ハッシュからクックしたファイルのパスを作る
+	/// </summary>
+	/// <param name="cookedDirectory">置き場所</param>
+	/// <param name="contentHash">ハッシュ</param>
+	/// <returns>クックしたファイルのパス</returns>
+	std::string GetCookedFilePath(const std::string& cookedDirectory, const uint64_t& contentHash);
+
+	/// <summary>
+	/// 元の画像に対応するクックしたファイルを探す
+	/// </summary>
+	/// <param name="sourceFilePath">元の画像のパス</param>
+	/// <param name="cookedDirectory">置き場所</param>
+	/// <returns>クックしたファイルのパス(無ければ空)</returns>
+	std::string FindCookedFile(const std::string& sourceFilePath, const std::string& cookedDirectory);
+
+	/// <summary>
+	/// 形式を選ぶ
+	/// </summary>
+	/// <param name="image">画像</param>
+	/// <returns>形式</returns>
+	Format ChooseFormat(const PngDecoder::Image& image);
+
+	/// <summary>
+	/// ミップマップを作って圧縮する
+	/// </summary>
+	/// <param name="image">画像</param>
+	/// <param name="format">形式</param>
+	/// <param name="mipLevels">ミップマップの数(作れる数より多ければ減らす)</param>
+	/// <returns>クックしたテクスチャ</returns>
+	CookedTexture Compress(const PngDecoder::Image& image, const Format& format, const uint32_t& mipLevels);
+
+	/// <summary>
+	/// DDSのバイト列にする
+	/// </summary>
+	/// <param name="texture">クックしたテクスチャ</param>
+	/// <returns>DDSファイルの中身</returns>
+	std::vector<uint8_t> MakeDDS(const CookedTexture& texture);
+
+	/// <summary>
+	/// クック
+	/// 元の画像を読み込んでDDSで書き出す
+	/// </summary>
+	/// <param name="data">元の画像ファイルの中身</param>
+	/// <param name="size">サイズ</param>
+	/// <param name="cookedFilePath">書き出し先</param>
+	/// <returns>書き出せたかどうか(扱えない画像も失敗にする)</returns>
+	bool Cook(const uint8_t* data, const size_t& size, const std::string& cookedFilePath);
+
+	/// <summary>
+	/// 元の画像をクックしてクックしたファイルのパスを返す
+	/// Tools/TextureCookerを動かしていない時に、最初に読み込んだ所でクックしておくのに使う
+	/// </summary>
+	/// <param name="sourceFilePath">元の画像のパス</param>
+	/// <param name="cookedDirectory">置き場所</param>
+	/// <returns>クックしたファイルのパス(PNGでない、扱えない画像の時は空)</returns>
+	std::string CookFile(const std::string& sourceFilePath, const std::string& cookedDirectory);
+
+};
@@ -0,0 +1,282 @@
+#include "TextureResidencyPolicy.h"
+
+#include <cassert>
+#include <cmath>
+#include <queue>
+#include <algorithm>
+
+void Elysia::TextureResidencyPolicy::Initialize(const Settings& settings, const uint32_t& maxTextureCount) {
+	settings_ = settings;
+	//使われたことは他のスレッドから書くので、後から増やせないように先に確保しておく
+	maxTextureCount_ = maxTextureCount;
+	usages_ = std::make_unique<Usage[]>(maxTextureCount_);
+	textures_.clear();
+	textures_.reserve(maxTextureCount_);
+	frameChanges_.clear();
+	changes_.clear();
+	frame_ = 0u;
+	residentBytes_ = 0u;
+	statistics_ = {};
+}
+
+uint32_t Elysia::TextureResidencyPolicy::Register(const std::vector<uint64_t>& mipBytes) {
+	//最大数を超えないようにしてね
+	assert(textures_.size() < maxTextureCount_);
+	assert(mipBytes.empty() == false);
+
+	//常に載せておく小さいミップを決める
+	//一番小さいミップから順に、収まるところまで
+	uint32_t mipLevels = uint32_t(mipBytes.size());
+	uint32_t alwaysResidentMip = mipLevels - 1u;
+	uint64_t alwaysResidentBytes = mipBytes[alwaysResidentMip];
+	while (alwaysResidentMip > 0u && alwaysResidentBytes + mipBytes[alwaysResidentMip - 1u] <= settings_.alwaysResidentBytes) {
+		--alwaysResidentMip;
+		alwaysResidentBytes += mipBytes[alwaysResidentMip];
+	}
+
+	uint32_t id = uint32_t(textures_.size());
+	TextureState texture = {
+		.mipBytes = mipBytes,
+		.alwaysResidentMip = alwaysResidentMip,
+		.residentMip = alwaysResidentMip,
+		.desiredMip = alwaysResidentMip,
+		.lastUsedFrame = 0u,
+	};
+	textures_.push_back(std::move(texture));
+	frameChanges_.push_back(None);
+	usages_[id].isUsed.store(false, std::memory_order_relaxed);
+	usages_[id].requestedMip.store(NO_REQUEST_, std::memory_order_relaxed);
+
+	residentBytes_ += alwaysResidentBytes;
+	for (const uint64_t& bytes : mipBytes) {
+		statistics_.fullBytes += bytes;
+	}
+	statistics_.residentBytes = residentBytes_;
+	return id;
+}
+
+void Elysia::TextureResidencyPolicy::MarkUsed(const uint32_t& id) {
+	assert(id < maxTextureCount_);
+	usages_[id].isUsed.store(true, std::memory_order_relaxed);
+}
+
+void Elysia::TextureResidencyPolicy::RequestMip(const uint32_t& id, const uint32_t& mip) {
+	assert(id < maxTextureCount_);
+	Usage& usage = usages_[id];
+	usage.isUsed.store(true, std::memory_order_relaxed);
+
+	//一番細かいものを残す
+	uint32_t current = usage.requestedMip.load(std::memory_order_relaxed);
+	while (mip < current && usage.requestedMip.compare_exchange_weak(current, mip, std::memory_order_relaxed) == false) {
+	}
+}
+
+uint32_t Elysia::TextureResidencyPolicy::ComputeMipFromDistance(const float& distance) const {
+	if (distance <= settings_.fullDetailDistance || settings_.fullDetailDistance <= 0.0f) {
+		return 0u;
+	}
+	//距離が2倍になるごとに画面上の大きさは半分になるので、1段粗くて良い
+	float mip = std::floor(std::log2(distance / settings_.fullDetailDistance));
+	return uint32_t(std::min(mip, 31.0f));
+}
+
+const std::vector<Elysia::TextureResidencyPolicy::ResidencyChange>& Elysia::TextureResidencyPolicy::Update() {
+	++frame_;
+	changes_.clear();
+	std::fill(frameChanges_.begin(), frameChanges_.end(), None);
+	statistics_.uploadedBytes = 0u;
+	statistics_.evictedBytes = 0u;
+
+	//前のフレームの使われ方から欲しいミップを決める
+	uint32_t textureCount = uint32_t(textures_.size());
+	for (uint32_t id = 0u; id < textureCount; ++id) {
+		TextureState& texture = textures_[id];
+		Usage& usage = usages_[id];
+		bool isUsed = usage.isUsed.exchange(false, std::memory_order_relaxed);
+		uint32_t requestedMip = usage.requestedMip.exchange(NO_REQUEST_, std::memory_order_relaxed);
+		if (isUsed == true) {
+			texture.lastUsedFrame = frame_;
+			//距離が分からなければ一番細かいミップ
+			texture.desiredMip = (requestedMip == NO_REQUEST_) ? 0u : std::min(requestedMip, texture.alwaysResidentMip);
+		}
+		else if (frame_ - texture.lastUsedFrame >= settings_.unusedFrameCount) {
+			//しばらく使われていないので要らない
+			//予算が足りなくなるまでは降ろさずに残しておく
+			texture.desiredMip = texture.alwaysResidentMip;
+		}
+	}
+
+	//予算が減っていたら収まるまで降ろす
+	if (residentBytes_ > settings_.budgetBytes) {
+		Evict(residentBytes_ - settings_.budgetBytes, NO_REQUEST_);
+	}
+
+	//優先度の高い順に1段ずつ細かくする
+	auto isLowerPriority = [this](const uint32_t& a, const uint32_t& b) {
+		return IsHigherPriority(b, a);
+	};
+	std::priority_queue<uint32_t, std::vector<uint32_t>, decltype(isLowerPriority)> upgradeQueue(isLowerPriority);
+	for (uint32_t id = 0u; id < textureCount; ++id) {
+		if (textures_[id].residentMip > textures_[id].desiredMip && frameChanges_[id] != Evicted) {
+			upgradeQueue.push(id);
+		}
+	}
+
+	while (upgradeQueue.empty() == false) {
+		uint32_t id = upgradeQueue.top();
+		upgradeQueue.pop();
+		TextureState& texture = textures_[id];
+		//降ろされた
+		if (frameChanges_[id] == Evicted) {
+			continue;
+		}
+
+		uint32_t nextMip = texture.residentMip - 1u;
+		uint64_t bytes = texture.mipBytes[nextMip];
+
+		//1フレームで載せる量を超えるなら次のフレームに回す
+		//上限より大きいミップは他と一緒に載せないだけで、1枚なら載せる
+		if (statistics_.uploadedBytes > 0u && statistics_.uploadedBytes + bytes > settings_.uploadBytesPerFrame) {
+			break;
+		}
+
+		//予算を超えるなら優先度の低いものを降ろす
+		//降ろせなければこのテクスチャは諦める
+		if (residentBytes_ + bytes > settings_.budgetBytes) {
+			if (Evict(residentBytes_ + bytes - settings_.budgetBytes, id) == false) {
+				continue;
+			}
+		}
+
+		SetResidentMip(id, nextMip);
+		frameChanges_[id] = Upgraded;
+		statistics_.uploadedBytes += bytes;
+		if (texture.residentMip > texture.desiredMip) {
+			upgradeQueue.push(id);
+		}
+	}
+
+	//変わったものを返す
+	//同じフレームで行って戻ることはしないので、変化があれば必ず前と違う
+	statistics_.pendingCount = 0u;
+	for (uint32_t id = 0u; id < textureCount; ++id) {
+		if (frameChanges_[id] != None) {
+			changes_.push_back({ .id = id, .residentMip = textures_[id].residentMip });
+		}
+		if (textures_[id].residentMip > textures_[id].desiredMip) {
+			++statistics_.pendingCount;
+		}
+	}
+	statistics_.residentBytes = residentBytes_;
+	return changes_;
+}
+
+bool Elysia::TextureResidencyPolicy::IsHigherPriority(const uint32_t& a, const uint32_t& b) const {
+	const TextureState& textureA = textures_[a];
+	const TextureState& textureB = textures_[b];
+	//最近使われた方
+	if (textureA.lastUsedFrame != textureB.lastUsedFrame) {
+		return textureA.lastUsedFrame > textureB.lastUsedFrame;
+	}
+	//近い方
+	if (textureA.desiredMip != textureB.desiredMip) {
+		return textureA.desiredMip < textureB.desiredMip;
+	}
+	//決まらなければ先に登録された方
+	return a < b;
+}
+
+bool Elysia::TextureResidencyPolicy::IsBetterVictim(const uint32_t& a, const uint32_t& b) const {
+	const TextureState& textureA = textures_[a];
+	const TextureState& textureB = textures_[b];
+	//欲しい以上に載っている方
+	bool isExcessA = textureA.residentMip < textureA.desiredMip;
+	bool isExcessB = textureB.residentMip < textureB.desiredMip;
+	if (isExcessA != isExcessB) {
+		return isExcessA;
+	}
+	//長く使われていない方
+	if (textureA.lastUsedFrame != textureB.lastUsedFrame) {
+		return textureA.lastUsedFrame < textureB.lastUsedFrame;
+	}
+	//遠い方
+	if (textureA.desiredMip != textureB.desiredMip) {
+		return textureA.desiredMip > textureB.desiredMip;
+	}
+	//細かいミップが載っている方(空く量が多い)
+	if (textureA.residentMip != textureB.residentMip) {
+		return textureA.residentMip < textureB.residentMip;
+	}
+	//決まらなければ後に登録された方
+	return a > b;
+}
+
+uint32_t Elysia::TextureResidencyPolicy::GetEvictableMip(const uint32_t& victimId, const uint32_t& requesterId) const {
+	const TextureState& victim = textures_[victimId];
+	//このフレームで載せたものは降ろさない
+	if (victimId == requesterId || frameChanges_[victimId] == Upgraded) {
+		return victim.residentMip;
+	}
+	//載せたいものより優先度が低ければ、常に載せておくミップまで
+	if (requesterId == NO_REQUEST_ || IsHigherPriority(requesterId, victimId) == true) {
+		return victim.alwaysResidentMip;
+	}
+	//欲しい以上に載っている分だけ
+	return std::max(victim.residentMip, victim.desiredMip);
+}
+
+bool Elysia::TextureResidencyPolicy::Evict(const uint64_t& requiredBytes, const uint32_t& requesterId) {
+	//先に足りるかどうかを確かめる
+	//足りないのに降ろすと、載せられない上に他のテクスチャが粗くなるだけになる
+	std::vector<uint32_t> victims;
+	uint64_t evictableBytes = 0u;
+	uint32_t textureCount = uint32_t(textures_.size());
+	for (uint32_t id = 0u; id < textureCount; ++id) {
+		const TextureState& texture = textures_[id];
+		uint32_t evictableMip = GetEvictableMip(id, requesterId);
+		if (evictableMip <= texture.residentMip) {
+			continue;
+		}
+		for (uint32_t mip = texture.residentMip; mip < evictableMip; ++mip) {
+			evictableBytes += texture.mipBytes[mip];
+		}
+		victims.push_back(id);
+	}
+	if (evictableBytes < requiredBytes) {
+		return false;
+	}
+
+	//降ろす候補の順に1段ずつ降ろす
+	auto isWorseVictim = [this](const uint32_t& a, const uint32_t& b) {
+		return IsBetterVictim(b, a);
+	};
+	std::priority_queue<uint32_t, std::vector<uint32_t>, decltype(isWorseVictim)> victimQueue(isWorseVictim, std::move(victims));
+	uint64_t evictedBytes = 0u;
+	while (evictedBytes < requiredBytes) {
+		assert(victimQueue.empty() == false);
+		uint32_t id = victimQueue.top();
+		victimQueue.pop();
+		TextureState& texture = textures_[id];
+		evictedBytes += texture.mipBytes[texture.residentMip];
+		SetResidentMip(id, texture.residentMip + 1u);
+		frameChanges_[id] = Evicted;
+		if (GetEvictableMip(id, requesterId) > texture.residentMip) {
+			victimQueue.push(id);
+		}
+	}
+	statistics_.evictedBytes += evictedBytes;
+	return true;
+}
+
+void Elysia::TextureResidencyPolicy::SetResidentMip(const uint32_t& id, const uint32_t& residentMip) {
+	TextureState& texture = textures_[id];
+	assert(residentMip <= texture.alwaysResidentMip);
+	//増えた分と減った分
+	for (uint32_t mip = residentMip; mip < texture.residentMip; ++mip) {
+		residentBytes_ += texture.mipBytes[mip];
+	}
+	for (uint32_t mip = texture.residentMip; mip < residentMip; ++mip) {
+		residentBytes_ -= texture.mipBytes[mip];
+	}
+	texture.residentMip = residentMip;
+}
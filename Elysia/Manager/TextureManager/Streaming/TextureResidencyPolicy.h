@@ -0,0 +1,273 @@
+#pragma once
+
+/**
+ * @file TextureResidencyPolicy.h
+ * @brief テクスチャのミップをどこまで載せておくかを決めるクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <memory>
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// テクスチャのミップをどこまで載せておくかを決めるクラス
+	/// 使われ方(画面に出たか、どれくらい遠いか)から欲しいミップを決めて、
+	/// 予算の中で優先度の高い順に細かいミップを載せ、足りなければ優先度の低いものから降ろす
+	/// GPUには触らないので、シミュレーションだけで確かめられる
+	/// </summary>
+	class TextureResidencyPolicy final {
+	public:
+		/// <summary>
+		/// 設定
+		/// </summary>
+		struct Settings {
+			//載せておけるバイト数
+			uint64_t budgetBytes;
+			//1フレームで載せるバイト数の上限
+			uint64_t uploadBytesPerFrame;
+			//常に載せておく小さいミップのバイト数
+			//この中に収まる分は最初から載せて、降ろさない(最低でも一番小さいミップ1枚)
+			uint64_t alwaysResidentBytes;
+			//このフレーム数使われなければ、欲しいミップを一番粗いものにする
+			uint32_t unusedFrameCount;
+			//この距離までは一番細かいミップが欲しい
+			//距離が2倍になるごとに1段粗くする
+			float fullDetailDistance;
+		};
+
+		/// <summary>
+		/// 載せるミップが変わったテクスチャ
+		/// </summary>
+		struct ResidencyChange {
+			//番号
+			uint32_t id;
+			//載せておく一番細かいミップ(これより粗いミップは全部載せる)
+			uint32_t residentMip;
+		};
+
+		/// <summary>
+		/// 統計
+		/// </summary>
+		struct Statistics {
+			//載せているバイト数
+			uint64_t residentBytes;
+			//全部のミップを載せた時のバイト数
+			uint64_t fullBytes;
+			//このフレームで載せたバイト数
+			uint64_t uploadedBytes;
+			//このフレームで降ろしたバイト数
+			uint64_t evictedBytes;
+			//欲しいミップまで載っていないテクスチャの数
+			uint32_t pendingCount;
+		};
+
+		//まだ要求されていない
+		static constexpr uint32_t NO_REQUEST_ = UINT32_MAX;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="settings">設定</param>
+		/// <param name="maxTextureCount">テクスチャの最大数(使われたことを他のスレッドから書くので先に確保する)</param>
+		void Initialize(const Settings& settings, const uint32_t& maxTextureCount);
+
+		/// <summary>
+		/// 登録
+		/// 常に載せておく小さいミップだけが載っている状態から始める
+		/// </summary>
+		/// <param name="mipBytes">ミップごとのバイト数(細かい順)</param>
+		/// <returns>番号</returns>
+		uint32_t Register(const std::vector<uint64_t>& mipBytes);
+
+		/// <summary>
+		/// 使われたことを伝える
+		/// 描画を記録するスレッドから呼んで良い
+		/// 距離を伝えていなければ一番細かいミップが欲しいことになる
+		/// </summary>
+		/// <param name="id">番号</param>
+		void MarkUsed(const uint32_t& id);
+
+		/// <summary>
+		/// 欲しいミップを伝える
+		/// 同じフレームで何度も呼ばれたら一番細かいものにする(スレッドから呼んで良い)
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <param name="mip">欲しいミップ</param>
+		void RequestMip(const uint32_t& id, const uint32_t& mip);
+
+		/// <summary>
+		/// 距離から欲しいミップを計算
+		/// </summary>
+		/// <param name="distance">カメラからの距離</param>
+		/// <returns>欲しいミップ</returns>
+		uint32_t ComputeMipFromDistance(const float& distance) const;
+
+		/// <summary>
+		/// 1フレーム分の更新
+		/// 前のフレームで使われたものから欲しいミップを決めて、載せるものと降ろすものを決める
+		/// </summary>
+		/// <returns>載せるミップが変わったテクスチャ</returns>
+		const std::vector<ResidencyChange>& Update();
+
+		/// <summary>
+		/// 予算を変える
+		/// 超えていたら次のUpdateで降ろす
+		/// </summary>
+		/// <param name="budgetBytes">予算</param>
+		inline void SetBudgetBytes(const uint64_t& budgetBytes) {
+			settings_.budgetBytes = budgetBytes;
+		}
+
+	public:
+		/// <summary>
+		/// 載せている一番細かいミップを取得
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <returns>ミップ</returns>
+		inline uint32_t GetResidentMip(const uint32_t& id) const {
+			return textures_[id].residentMip;
+		}
+
+		/// <summary>
+		/// 欲しいミップを取得
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <returns>ミップ</returns>
+		inline uint32_t GetDesiredMip(const uint32_t& id) const {
+			return textures_[id].desiredMip;
+		}
+
+		/// <summary>
+		/// テクスチャの数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		inline uint32_t GetTextureCount() const {
+			return uint32_t(textures_.size());
+		}
+
+		/// <summary>
+		/// 設定を取得
+		/// </summary>
+		/// <returns>設定</returns>
+		inline const Settings& GetSettings() const {
+			return settings_;
+		}
+
+		/// <summary>
+		/// 統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		inline const Statistics& GetStatistics() const {
+			return statistics_;
+		}
+
+	private:
+		/// <summary>
+		/// テクスチャの状態
+		/// </summary>
+		struct TextureState {
+			//ミップごとのバイト数
+			std::vector<uint64_t> mipBytes;
+			//常に載せておく一番細かいミップ
+			uint32_t alwaysResidentMip;
+			//載せている一番細かいミップ
+			uint32_t residentMip;
+			//欲しいミップ
+			uint32_t desiredMip;
+			//最後に使われたフレーム
+			uint64_t lastUsedFrame;
+		};
+
+		/// <summary>
+		/// 他のスレッドから書く使われ方
+		/// </summary>
+		struct Usage {
+			std::atomic<bool> isUsed = false;
+			std::atomic<uint32_t> requestedMip = NO_REQUEST_;
+		};
+
+		/// <summary>
+		/// このフレームでの変化
+		/// 同じフレームで上げてから下げる(下げてから上げる)ことはしない
+		/// </summary>
+		enum FrameChange : uint8_t {
+			None,
+			Upgraded,
+			Evicted,
+		};
+
+		/// <summary>
+		/// 載せる優先度が a の方が高いか
+		/// 最近使われた、近い(欲しいミップが細かい)、の順
+		/// </summary>
+		/// <param name="a">番号</param>
+		/// <param name="b">番号</param>
+		/// <returns>a の方が高いか</returns>
+		bool IsHigherPriority(const uint32_t& a, const uint32_t& b) const;
+
+		/// <summary>
+		/// 降ろす候補として a の方が先か
+		/// 欲しい以上に載っている、長く使われていない、遠い、細かいミップが載っている、の順
+		/// </summary>
+		/// <param name="a">番号</param>
+		/// <param name="b">番号</param>
+		/// <returns>a の方が先か</returns>
+		bool IsBetterVictim(const uint32_t& a, const uint32_t& b) const;
+
+		/// <summary>
+		/// どこまで降ろして良いか
+		/// 欲しい以上に載っている分はいつでも降ろせる
+		/// 載せたいテクスチャより優先度が低ければ、常に載せておくミップまで降ろせる
+		/// </summary>
+		/// <param name="victimId">降ろす候補</param>
+		/// <param name="requesterId">載せたいテクスチャ(無ければNO_REQUEST_)</param>
+		/// <returns>ここまで降ろして良いミップ</returns>
+		uint32_t GetEvictableMip(const uint32_t& victimId, const uint32_t& requesterId) const;
+
+		/// <summary>
+		/// 予算に収まるまで降ろす
+		/// 足りない時は何も降ろさない
+		/// </summary>
+		/// <param name="requiredBytes">空けたいバイト数</param>
+		/// <param name="requesterId">載せたいテクスチャ(これより優先度の高いものは降ろさない、無ければNO_REQUEST_)</param>
+		/// <returns>空けられたかどうか</returns>
+		bool Evict(const uint64_t& requiredBytes, const uint32_t& requesterId);
+
+		/// <summary>
+		/// 載せるミップを変える
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <param name="residentMip">載せる一番細かいミップ</param>
+		void SetResidentMip(const uint32_t& id, const uint32_t& residentMip);
+
+	private:
+		//設定
+		Settings settings_ = {};
+		//テクスチャの状態
+		std::vector<TextureState> textures_;
+		//他のスレッドから書く使われ方
+		std::unique_ptr<Usage[]> usages_;
+		//使われ方の数
+		uint32_t maxTextureCount_ = 0u;
+		//フレーム
+		uint64_t frame_ = 0u;
+		//載せているバイト数
+		uint64_t residentBytes_ = 0u;
+		//載せるミップが変わったテクスチャ
+		std::vector<ResidencyChange> changes_;
+		//このフレームでの変化
+		std::vector<FrameChange> frameChanges_;
+		//統計
+		Statistics statistics_ = {};
+
+	};
+
+}
@@ -2,8 +2,17 @@
 #include "SrvManager.h"
 
 #include <vector>
+#include <cstring>
+
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
 
 #include "Convert.h"
+#include "TextureAtlasBuilder.h"
+#include "TextureAtlasCooker.h"
+#include "TextureCooker.h"
+#include "Profiler.h"
 
 Elysia::TextureManager* Elysia::TextureManager::GetInstance() {
 	static Elysia::TextureManager instance;
@@ -19,7 +28,13 @@ const D3D12_RESOURCE_DESC Elysia::TextureManager::GetResourceDesc(const uint32_t
 	auto it = handleToFilePathMap_.find(textureHandle);
 	if (it != handleToFilePathMap_.end()) {
 		const std::string& filePath = it->second;
-		return textureInformation_[filePath].resource->GetDesc();
+		D3D12_RESOURCE_DESC resourceDesc = textureInformation_[filePath].resource->GetDesc();
+		//細かいミップを降ろしている時もテクスチャ本来の大きさを返す
+		const DirectX::TexMetadata& metadata = textureInformation_[filePath].mipImages.GetMetadata();
+		resourceDesc.Width = UINT64(metadata.width);
+		resourceDesc.Height = UINT(metadata.height);
+		resourceDesc.MipLevels = UINT16(metadata.mipLevels);
+		return resourceDesc;
 	}
 
 	//見つからなかった場合
@@ -32,7 +47,7 @@ uint64_t Elysia::TextureManager::GetTextureWidth(const uint32_t& textureHandle){
 	auto it = handleToFilePathMap_.find(textureHandle);
 	if (it != handleToFilePathMap_.end()) {
 		const std::string& filePath = it->second;
-		return textureInformation_[filePath].resource->GetDesc().Width;		
+		return uint64_t(textureInformation_[filePath].mipImages.GetMetadata().width);
 	}
 	//見つからなかった場合は0uを返す
 	return 0u;
@@ -44,7 +59,7 @@ uint64_t Elysia::TextureManager::GetTextureHeight(const uint32_t& textureHandle)
 	auto it = handleToFilePathMap_.find(textureHandle);
 	if (it != handleToFilePathMap_.end()) {
 		const std::string& filePath = it->second;
-		return textureInformation_[filePath].resource->GetDesc().Height;
+		return uint64_t(textureInformation_[filePath].mipImages.GetMetadata().height);
 	}
 	//見つからなかった場合は0uを返す
 	return 0u;
@@ -55,8 +70,7 @@ uint64_t Elysia::TextureManager::GetTextureHeight(const uint32_t& textureHandle)
 
 //統合させた関数
 uint32_t Elysia::TextureManager::Load(const std::string& filePath) {
-
-	Elysia::TextureManager* textureManager = TextureManager::GetInstance();
+	ELYSIA_PROFILE_SCOPE("TextureManager::Load");
 
 	//一度読み込んだものはその値を返す
 	//新規は勿論読み込みをする
@@ -65,34 +79,247 @@ uint32_t Elysia::TextureManager::Load(const std::string& filePath) {
 		return it->second.handle;
 	}
 
+	//クックしたDDSがあればそちらを読む
+	//ミップマップも圧縮も済んでいるのでWICもGenerateMipMapsも通らない
+	std::string cookedFilePath = TextureCooker::FindCookedFile(filePath, TextureCooker::COOKED_DIRECTORY);
+	//無ければ(VSのビルドでCookTexturesが動かなかった時)ここでクックし、次の起動からはそれを読む
+	if (cookedFilePath.empty() == true) {
+		cookedFilePath = TextureCooker::CookFile(filePath, TextureCooker::COOKED_DIRECTORY);
+	}
+	if (cookedFilePath.empty() == false) {
+		return Register(filePath, LoadTextureData(cookedFilePath));
+	}
+
+	//読み込んで登録
+	return Register(filePath, LoadTextureData(filePath));
+}
+
+uint32_t Elysia::TextureManager::LoadAtlas(const std::string& atlasName, const std::vector<std::string>& filePaths) {
+	ELYSIA_PROFILE_SCOPE("TextureManager::LoadAtlas");
+
+	//一度読み込んだものはその値を返す
+	auto it = TextureManager::GetInstance()->textureInformation_.find(atlasName);
+	if (it != TextureManager::GetInstance()->textureInformation_.end()) {
+		return it->second.handle;
+	}
+
+	//ミップマップを作っても隣の画像が混ざらないように詰める
+	const TextureAtlasBuilder::Settings settings = TextureAtlasBuilder::MakeMipSafeSettings(ATLAS_WIDTH_, ATLAS_MAX_HEIGHT_, ATLAS_MIP_LEVELS_);
+
+	//クックしたアトラスがあればそちらを読む
+	//無ければ最初の起動の時にクックしておき、次からは展開も詰めるのもミップマップも通らない
+	std::string cookedTexturePath;
+	std::vector<AtlasRegion> cookedRegions;
+	bool isCooked = TextureAtlasCooker::FindCookedFiles(filePaths, settings, ATLAS_MIP_LEVELS_, TextureAtlasCooker::COOKED_DIRECTORY, cookedTexturePath, cookedRegions);
+	if (isCooked == false && TextureAtlasCooker::Cook(filePaths, settings, ATLAS_MIP_LEVELS_, TextureAtlasCooker::COOKED_DIRECTORY) == true) {
+		isCooked = TextureAtlasCooker::FindCookedFiles(filePaths, settings, ATLAS_MIP_LEVELS_, TextureAtlasCooker::COOKED_DIRECTORY, cookedTexturePath, cookedRegions);
+	}
+	if (isCooked == true) {
+		uint32_t atlasHandle = Register(atlasName, LoadTextureData(cookedTexturePath));
+		RegisterAtlasRegions(atlasHandle, cookedRegions);
+		return atlasHandle;
+	}
+
+	//16bitやインターレースなどクック出来ない画像が入っている時は今まで通りWICで読む
+	TextureAtlasBuilder atlasBuilder;
+	for (const std::string& filePath : filePaths) {
+		DirectX::ScratchImage image{};
+		std::wstring filePathW = Convert::Text::ToWString(filePath);
+		HRESULT hResult = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+		assert(SUCCEEDED(hResult));
+
+		//RGBA8に揃える
+		if (image.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) {
+			DirectX::ScratchImage convertedImage{};
+			hResult = DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, convertedImage);
+			assert(SUCCEEDED(hResult));
+			image = std::move(convertedImage);
+		}
+
+		const DirectX::Image* source = image.GetImage(0, 0, 0);
+		atlasBuilder.Add(filePath, uint32_t(source->width), uint32_t(source->height), source->pixels, source->rowPitch);
+	}
+
+	bool isBuilt = atlasBuilder.Build(settings);
+	assert(isBuilt == true);
+
+	//アトラスの画像を作る
+	DirectX::ScratchImage atlasImage{};
+	HRESULT hResult = atlasImage.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, atlasBuilder.GetWidth(), atlasBuilder.GetHeight(), 1u, 1u);
+	assert(SUCCEEDED(hResult));
+	const DirectX::Image* destination = atlasImage.GetImage(0, 0, 0);
+	size_t atlasRowPitch = size_t(atlasBuilder.GetWidth()) * TextureAtlasBuilder::BYTES_PER_PIXEL_;
+	for (uint32_t row = 0u; row < atlasBuilder.GetHeight(); ++row) {
+		std::memcpy(destination->pixels + row * destination->rowPitch, atlasBuilder.GetPixels().data() + row * atlasRowPitch, atlasRowPitch);
+	}
+
+	//ミップマップの作成
+	DirectX::ScratchImage mipImages{};
+	hResult = DirectX::GenerateMipMaps(atlasImage.GetImages(), atlasImage.GetImageCount(), atlasImage.GetMetadata(), DirectX::TEX_FILTER_SRGB, ATLAS_MIP_LEVELS_, mipImages);
+	assert(SUCCEEDED(hResult));
+
+	//登録
+	uint32_t atlasHandle = Register(atlasName, std::move(mipImages));
+	RegisterAtlasRegions(atlasHandle, atlasBuilder.GetRegions());
+	return atlasHandle;
+}
+
+void Elysia::TextureManager::RegisterAtlasRegions(const uint32_t& atlasHandle, const std::vector<AtlasRegion>& regions) {
+	//それぞれの画像の範囲を登録
+	for (const AtlasRegion& region : regions) {
+		TextureRegion textureRegion = {
+			.textureHandle = atlasHandle,
+			.texLeftTop = region.texLeftTop,
+			.texRightBottom = region.texRightBottom,
+			.size = {.x = float(region.width),.y = float(region.height) },
+		};
+		TextureManager::GetInstance()->textureRegions_[region.name] = textureRegion;
+	}
+}
+
+Elysia::TextureRegion Elysia::TextureManager::GetTextureRegion(const std::string& filePath) {
+	auto it = textureRegions_.find(filePath);
+	//アトラスに入っていない
+	assert(it != textureRegions_.end());
+	return it->second;
+}
+
+uint32_t Elysia::TextureManager::Register(const std::string& name, DirectX::ScratchImage&& mipImages) {
+
+	Elysia::TextureManager* textureManager = TextureManager::GetInstance();
+
 	//読み込むたびにインデックスを増やし重複を防ごう
 	textureManager->index_ = Elysia::SrvManager::GetInstance()->Allocate();
 
 	//読み込んだデータを保存
 	TextureInformation textureInfo;
 	textureInfo.handle = textureManager->index_;
-	textureInfo.name = filePath;
-	textureInfo.mipImages = LoadTextureData(filePath);
+	textureInfo.name = name;
+	textureInfo.mipImages = std::move(mipImages);
 
 	//メタデータの取得
 	const DirectX::TexMetadata& metadata = textureInfo.mipImages.GetMetadata();
+
+	//ストリーミングするものは小さいミップだけを載せて始める
+	//細かいミップは使われてからUpdateStreamingで載せる
+	if (IsStreamable(metadata) == true) {
+		textureManager->InitializeStreaming();
+		std::vector<uint64_t> mipBytes(metadata.mipLevels);
+		for (size_t mip = 0u; mip < metadata.mipLevels; ++mip) {
+			mipBytes[mip] = uint64_t(textureInfo.mipImages.GetImage(mip, 0u, 0u)->slicePitch);
+		}
+		textureInfo.streamingId = textureManager->residencyPolicy_.Register(mipBytes);
+		textureInfo.residentMip = textureManager->residencyPolicy_.GetResidentMip(textureInfo.streamingId);
+	}
+
 	//リソースの設定
-	textureInfo.resource = CreateTextureResource(metadata);
-	textureInfo.internegiateResource = TransferTextureData(
-		textureInfo.resource.Get(), textureInfo.mipImages).Get();
+	CreateResidentResource(textureInfo);
 
 	//SRVの生成
 	Elysia::SrvManager::GetInstance()->CreateSRVForTexture2D(
 		textureInfo.handle,
 		textureInfo.resource.Get(),
-		metadata.format, UINT(metadata.mipLevels), metadata.IsCubemap());
-
+		metadata.format, UINT(metadata.mipLevels - textureInfo.residentMip), metadata.IsCubemap());
 
 	// 読み込んだデータをmapに保存
-	textureManager->GetTextureInformation().try_emplace(filePath, std::move(textureInfo));
-	TextureManager::GetInstance()->handleToFilePathMap_[textureManager->index_] = filePath;
+	uint32_t handle = textureInfo.handle;
+	uint32_t streamingId = textureInfo.streamingId;
+	auto emplaced = textureManager->GetTextureInformation().try_emplace(name, std::move(textureInfo));
+	textureManager->handleToFilePathMap_[handle] = name;
+	if (streamingId != TextureResidencyPolicy::NO_REQUEST_) {
+		//mapの要素は動かないのでポインタで持っておける
+		textureManager->streamingTextures_.push_back(&emplaced.first->second);
+		textureManager->handleToStreamingId_[handle] = streamingId;
+	}
+
+	return handle;
+}
 
-	return textureInfo.handle;
+bool Elysia::TextureManager::IsStreamable(const DirectX::TexMetadata& metadata) {
+	//キューブマップや配列は丸ごと載せる
+	return metadata.mipLevels > 1u && metadata.arraySize == 1u &&
+		metadata.IsCubemap() == false && metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE2D;
+}
+
+void Elysia::TextureManager::InitializeStreaming() {
+	if (isStreamingInitialized_ == true) {
+		return;
+	}
+	residencyPolicy_.Initialize(STREAMING_SETTINGS_, STREAMING_MAX_TEXTURE_COUNT_);
+	handleToStreamingId_.assign(STREAMING_MAX_TEXTURE_COUNT_, TextureResidencyPolicy::NO_REQUEST_);
+	isStreamingInitialized_ = true;
+}
+
+void Elysia::TextureManager::CreateResidentResource(TextureInformation& textureInformation) {
+	//載せているミップだけのメタデータ
+	DirectX::TexMetadata metadata = textureInformation.mipImages.GetMetadata();
+	const DirectX::Image* firstImage = textureInformation.mipImages.GetImage(textureInformation.residentMip, 0u, 0u);
+	metadata.width = firstImage->width;
+	metadata.height = firstImage->height;
+	metadata.mipLevels -= textureInformation.residentMip;
+
+	//配列が1つならミップは細かい順に並んでいる
+	textureInformation.resource = CreateTextureResource(metadata);
+	textureInformation.internegiateResource = TransferTextureData(
+		textureInformation.resource.Get(), firstImage, textureInformation.mipImages.GetImageCount() - textureInformation.residentMip, metadata);
+}
+
+void Elysia::TextureManager::RequestMipFromDistance(const uint32_t& textureHandle, const float& distance) {
+	if (textureHandle >= handleToStreamingId_.size() || handleToStreamingId_[textureHandle] == TextureResidencyPolicy::NO_REQUEST_) {
+		return;
+	}
+	residencyPolicy_.RequestMip(handleToStreamingId_[textureHandle], residencyPolicy_.ComputeMipFromDistance(distance));
+}
+
+void Elysia::TextureManager::UpdateStreaming() {
+	ELYSIA_PROFILE_SCOPE("TextureManager::UpdateStreaming");
+	if (isStreamingInitialized_ == false) {
+		return;
+	}
+
+	Elysia::DirectXSetup* directXSetup = Elysia::DirectXSetup::GetInstance();
+	Elysia::SrvManager* srvManager = Elysia::SrvManager::GetInstance();
+	for (const TextureResidencyPolicy::ResidencyChange& change : residencyPolicy_.Update()) {
+		TextureInformation& textureInformation = *streamingTextures_[change.id];
+
+		//前のフレームがまだ使っているかもしれないので、GPUが使い終わってから解放する
+		directXSetup->DeferRelease(textureInformation.resource);
+		directXSetup->DeferRelease(textureInformation.internegiateResource);
+		if (textureInformation.isRedirected == true) {
+			srvManager->Free(textureInformation.streamingSrvHandle);
+		}
+
+		//載せるミップだけで作り直す
+		//残っている粗いミップも送り直すが、1段細かいミップの1/3程度なので気にしない
+		textureInformation.residentMip = change.residentMip;
+		CreateResidentResource(textureInformation);
+
+		//SRVも書き換えずに新しく作って、ハンドルをそちらに向ける
+		const DirectX::TexMetadata& metadata = textureInformation.mipImages.GetMetadata();
+		textureInformation.streamingSrvHandle = srvManager->AllocateDescriptor();
+		srvManager->CreateSRVForTexture2D(
+			textureInformation.streamingSrvHandle.index,
+			textureInformation.resource.Get(),
+			metadata.format, UINT(metadata.mipLevels - textureInformation.residentMip), false);
+		srvManager->Redirect(textureInformation.handle, textureInformation.streamingSrvHandle.index);
+		textureInformation.isRedirected = true;
+	}
+}
+
+void Elysia::TextureManager::DisplayStreamingImGui() {
+#ifdef _DEBUG
+	const TextureResidencyPolicy::Statistics& statistics = residencyPolicy_.GetStatistics();
+	const double MEGA_BYTES = 1024.0 * 1024.0;
+
+	ImGui::Begin("テクスチャのストリーミング");
+	ImGui::Text("テクスチャ数 : %u", residencyPolicy_.GetTextureCount());
+	ImGui::Text("使用量 : %.1f / %.1f MB", double(statistics.residentBytes) / MEGA_BYTES, double(residencyPolicy_.GetSettings().budgetBytes) / MEGA_BYTES);
+	ImGui::Text("全部載せた時 : %.1f MB", double(statistics.fullBytes) / MEGA_BYTES);
+	ImGui::Text("載せた量 : %.2f MB", double(statistics.uploadedBytes) / MEGA_BYTES);
+	ImGui::Text("降ろした量 : %.2f MB", double(statistics.evictedBytes) / MEGA_BYTES);
+	ImGui::Text("待ち : %u", statistics.pendingCount);
+	ImGui::End();
+#endif
 }
 
 
@@ -147,7 +374,8 @@ DirectX::ScratchImage Elysia::TextureManager::LoadTextureData(const std::string&
 	//ミップマップ...元画像より小さなテクスチャ群
 	DirectX::ScratchImage mipImages{};
 	//圧縮フォーマットかどうかを調べる
-	if (DirectX::IsCompressed(image.GetMetadata().format)) {
+	//ミップマップが入っている場合(クックしたDDSなど)も作り直さない
+	if (DirectX::IsCompressed(image.GetMetadata().format) || image.GetMetadata().mipLevels > 1u) {
 		//圧縮フォーマットならそのまま使う
 		mipImages = std::move(image);
 	}
@@ -214,10 +442,10 @@ ComPtr<ID3D12Resource> Elysia::TextureManager::CreateTextureResource(const Direc
 //書き換え
 
 [[nodiscard]]
-ComPtr<ID3D12Resource> Elysia::TextureManager::TransferTextureData(ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages) {
+ComPtr<ID3D12Resource> Elysia::TextureManager::TransferTextureData(ComPtr<ID3D12Resource> texture, const DirectX::Image* images, const size_t& imageCount, const DirectX::TexMetadata& metadata) {
 
 	std::vector<D3D12_SUBRESOURCE_DATA> subresources;
-	DirectX::PrepareUpload(Elysia::DirectXSetup::GetInstance()->GetDevice().Get(), mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(), subresources);
+	DirectX::PrepareUpload(Elysia::DirectXSetup::GetInstance()->GetDevice().Get(), images, imageCount, metadata, subresources);
 	uint64_t intermidiateSize = GetRequiredIntermediateSize(texture.Get(), 0, UINT(subresources.size()));
 	ComPtr<ID3D12Resource> intermediateSizeResource = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(intermidiateSize);
 	UpdateSubresources(Elysia::DirectXSetup::GetInstance()->GetCommandList().Get(), texture.Get(), intermediateSizeResource.Get(), 0, 0, UINT(subresources.size()), subresources.data());
@@ -247,6 +475,11 @@ ComPtr<ID3D12Resource> Elysia::TextureManager::TransferTextureData(ComPtr<ID3D12
 
 
 void Elysia::TextureManager::GraphicsCommand(const uint32_t& rootParameter, const uint32_t& textureHandle) {
+	//使われたことを伝える
+	//次のフレームの始めに細かいミップを載せる
+	if (textureHandle < handleToStreamingId_.size() && handleToStreamingId_[textureHandle] != TextureResidencyPolicy::NO_REQUEST_) {
+		residencyPolicy_.MarkUsed(handleToStreamingId_[textureHandle]);
+	}
 	Elysia::SrvManager::GetInstance()->SetGraphicsRootDescriptorTable(rootParameter, textureHandle);
 }
 
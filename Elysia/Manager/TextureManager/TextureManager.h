@@ -12,15 +12,24 @@
 #include <DirectXTex.h>
 #include <d3dx12.h>
 #include <map>
+#include <vector>
 
 #include "DirectXSetup.h"
 #include "Vector2.h"
+#include "TextureRegion.h"
+#include "DescriptorAllocator.h"
+#include "TextureResidencyPolicy.h"
 
 /// <summary>
 /// ElysiaEngine
 /// </summary>
 namespace Elysia {
 
+	/// <summary>
+	/// アトラスの中の1枚分
+	/// </summary>
+	struct AtlasRegion;
+
 	/// <summary>
 	/// テクスチャ管理クラス
 	/// </summary>
@@ -68,6 +77,24 @@ namespace Elysia {
 		/// <returns></returns>
 		static uint32_t Load(const std::string& filePath);
 
+		/// <summary>
+		/// 小さい画像をまとめてアトラスとして読み込む
+		/// 一度読み込んだものはそのハンドルを返す
+		/// それぞれの画像はGetTextureRegionで元のファイルパスから取り出す
+		/// Resources/Cooked/Atlas/にクックしたものがあればそれを読み、無ければクックしてから読む
+		/// </summary>
+		/// <param name="atlasName">アトラスの名前</param>
+		/// <param name="filePaths">まとめる画像</param>
+		/// <returns>アトラスのハンドル</returns>
+		static uint32_t LoadAtlas(const std::string& atlasName, const std::vector<std::string>& filePaths);
+
+		/// <summary>
+		/// アトラスにまとめた画像の範囲を取得
+		/// </summary>
+		/// <param name="filePath">元の画像のファイルパス</param>
+		/// <returns>範囲</returns>
+		TextureRegion GetTextureRegion(const std::string& filePath);
+
 		/// <summary>
 		/// コマンドを送る
 		/// </summary>
@@ -75,6 +102,27 @@ namespace Elysia {
 		/// <param name="textureHandle"></param>
 		void GraphicsCommand(const uint32_t& rootParameter, const uint32_t& textureHandle);
 
+		/// <summary>
+		/// カメラからの距離を伝える
+		/// 遠いテクスチャは細かいミップを載せない
+		/// 描画を記録するスレッドから呼んで良い
+		/// </summary>
+		/// <param name="textureHandle">ハンドル</param>
+		/// <param name="distance">カメラからの距離</param>
+		void RequestMipFromDistance(const uint32_t& textureHandle, const float& distance);
+
+		/// <summary>
+		/// ストリーミングの更新
+		/// 前のフレームで使われたテクスチャのミップを予算の中で載せて、足りなければ使われていないものから降ろす
+		/// 描画の記録を始める前に呼んでね
+		/// </summary>
+		void UpdateStreaming();
+
+		/// <summary>
+		/// ImGui表示用
+		/// </summary>
+		void DisplayStreamingImGui();
+
 		/// <summary>
 		/// DESCの取得
 		/// </summary>
@@ -124,13 +172,44 @@ namespace Elysia {
 		/// データの転送
 		/// </summary>
 		/// <param name="texture"></param>
-		/// <param name="mipImages"></param>
+		/// <param name="images">送る画像</param>
+		/// <param name="imageCount">画像の数</param>
+		/// <param name="metadata">送る画像のメタデータ</param>
 		/// <returns></returns>
-		static ComPtr<ID3D12Resource> TransferTextureData(ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages);
+		static ComPtr<ID3D12Resource> TransferTextureData(ComPtr<ID3D12Resource> texture, const DirectX::Image* images, const size_t& imageCount, const DirectX::TexMetadata& metadata);
 
 
 #pragma endregion
 
+		/// <summary>
+		/// ミップマップ付きの画像からリソースとSRVを作って登録する
+		/// </summary>
+		/// <param name="name">名前</param>
+		/// <param name="mipImages">ミップマップ付きの画像</param>
+		/// <returns>ハンドル</returns>
+		static uint32_t Register(const std::string& name, DirectX::ScratchImage&& mipImages);
+
+		/// <summary>
+		/// アトラスにまとめた画像の範囲を登録する
+		/// </summary>
+		/// <param name="atlasHandle">アトラスのハンドル</param>
+		/// <param name="regions">画像ごとの位置とUV</param>
+		static void RegisterAtlasRegions(const uint32_t& atlasHandle, const std::vector<AtlasRegion>& regions);
+
+		/// <summary>
+		/// ストリーミングするかどうか
+		/// ミップマップのある普通の2Dテクスチャだけ
+		/// </summary>
+		/// <param name="metadata">メタデータ</param>
+		/// <returns>ストリーミングするかどうか</returns>
+		static bool IsStreamable(const DirectX::TexMetadata& metadata);
+
+		/// <summary>
+		/// ストリーミングの初期化
+		/// 最初にストリーミングするテクスチャを登録する時に呼ぶ
+		/// </summary>
+		void InitializeStreaming();
+
 
 	private:
 
@@ -152,8 +231,22 @@ namespace Elysia {
 
 			//テクスチャハンドル
 			uint32_t handle=0u;
+
+			//ストリーミングの番号(ストリーミングしなければNO_REQUEST_)
+			uint32_t streamingId = TextureResidencyPolicy::NO_REQUEST_;
+			//載せている一番細かいミップ
+			uint32_t residentMip = 0u;
+			//ミップを変えた時に作ったSRV(handleはこちらに向ける)
+			DescriptorHandle streamingSrvHandle = {};
+			bool isRedirected = false;
 		};
 
+		/// <summary>
+		/// 載せているミップだけのリソースを作ってデータを送る
+		/// </summary>
+		/// <param name="textureInformation">テクスチャ情報</param>
+		static void CreateResidentResource(TextureInformation& textureInformation);
+
 	public:
 
 		/// <summary>
@@ -173,6 +266,42 @@ namespace Elysia {
 
 		// handleからfilePathへのマッピングを保持する
 		std::map<uint32_t, std::string> handleToFilePathMap_={};
+		//アトラスにまとめた画像の範囲
+		std::map<std::string, TextureRegion> textureRegions_ = {};
+
+		//アトラスの幅
+		static constexpr uint32_t ATLAS_WIDTH_ = 4096u;
+		//アトラスの高さの上限
+		static constexpr uint32_t ATLAS_MAX_HEIGHT_ = 16384u;
+		//アトラスのミップマップの数
+		//普通のテクスチャと同じ
+		static constexpr uint32_t ATLAS_MIP_LEVELS_ = 4u;
+
+		//ストリーミングの設定
+		static constexpr TextureResidencyPolicy::Settings STREAMING_SETTINGS_ = {
+			//載せておけるバイト数
+			.budgetBytes = 256u * 1024u * 1024u,
+			//1フレームで載せるバイト数
+			.uploadBytesPerFrame = 8u * 1024u * 1024u,
+			//常に載せておく小さいミップのバイト数
+			.alwaysResidentBytes = 64u * 1024u,
+			//2秒使われなければ要らない
+			.unusedFrameCount = 120u,
+			//この距離までは一番細かいミップ
+			.fullDetailDistance = 10.0f,
+		};
+		//ストリーミングするテクスチャの最大数(SRVの数より多くはならない)
+		static constexpr uint32_t STREAMING_MAX_TEXTURE_COUNT_ = 2048u;
+
+		//ミップをどこまで載せるかを決めるクラス
+		TextureResidencyPolicy residencyPolicy_;
+		//ストリーミングを初期化したかどうか
+		bool isStreamingInitialized_ = false;
+		//ストリーミングの番号からテクスチャ情報
+		std::vector<TextureInformation*> streamingTextures_;
+		//ハンドルからストリーミングの番号
+		//描画を記録するスレッドから読むので大きさは最初に決めておく
+		std::vector<uint32_t> handleToStreamingId_;
 
 	};
 }
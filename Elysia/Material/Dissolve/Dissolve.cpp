@@ -3,7 +3,7 @@
 void Dissolve::Initialize(){
 	//初期化
 	//リソースの生成
-	resource = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(DissolveData));
+	resource.Initialize(sizeof(DissolveData));
 	//エッジを使うかどうか
 	isUseEdge = true;
 	//厚さ
@@ -15,16 +15,16 @@ void Dissolve::Initialize(){
 }
 
 void Dissolve::Update(){
-	//書き込み
-	resource->Map(0u, nullptr, reinterpret_cast<void**>(&dissolveData));
+	//書き込みデータ
+	DissolveData dissolveData = {};
 	//エッジを使うかどうか
-	dissolveData->isUseEdge = isUseEdge;
+	dissolveData.isUseEdge = isUseEdge;
 	//エッジの厚さ
-	dissolveData->edgeThinkness = edgeThinkness;
+	dissolveData.edgeThinkness = edgeThinkness;
 	//エッジの色
-	dissolveData->edgeColor = edgeColor;
+	dissolveData.edgeColor = edgeColor;
 	//閾値
-	dissolveData->threshold = threshold;
-	//書き込み終了
-	resource->Unmap(0u, nullptr);
+	dissolveData.threshold = threshold;
+	//書き込み
+	resource.Write(dissolveData);
 }
@@ -2,6 +2,7 @@
 
 #include "Vector3.h"
 #include "DirectXSetup.h"
+#include "RingConstantBuffer.h"
 
 
 /// <summary>
@@ -35,12 +36,9 @@ private:
 		float_t threshold;
 	};
 
-	//データ
-	DissolveData* dissolveData = nullptr;
-
 public:
 	//リソース
-	ComPtr<ID3D12Resource> resource = nullptr;
+	Elysia::RingConstantBuffer resource = {};
 
 	//Edgeを使うかどうか
 	bool isUseEdge;
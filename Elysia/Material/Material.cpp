@@ -15,27 +15,27 @@ void Material::Initialize(){
 	//環境マップ
 	isEnviromentMap = false;
 	//リソースを生成
-	resource = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(MaterialData));
+	resource.Initialize(sizeof(MaterialData));
 
 }
 
 void Material::Update(){
 
-	//書き込み
-	resource->Map(0u, nullptr, reinterpret_cast<void**>(&materialData_));
+	//書き込みデータ
+	MaterialData materialData = {};
 	//色
-	materialData_->color = color;
+	materialData.color = color;
 	//ライティングの種類
-	materialData_->lightingKinds = lightingKinds;
+	materialData.lightingKinds = lightingKinds;
 	//UVトランスフォーム
-	materialData_->uvTransform = uvTransform;
+	materialData.uvTransform = uvTransform;
 	//輝度
-	materialData_->shininess = shininess;
+	materialData.shininess = shininess;
 	//環境光
-	materialData_->ambientIntensity = ambientIntensity;
+	materialData.ambientIntensity = ambientIntensity;
 
 	//環境マップ
-	materialData_->isEnviromentMap = isEnviromentMap;
-	//書き込み終了
-	resource->Unmap(0u, nullptr);
+	materialData.isEnviromentMap = isEnviromentMap;
+	//書き込み
+	resource.Write(materialData);
 }
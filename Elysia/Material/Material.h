@@ -13,6 +13,7 @@
 #include "Vector4.h"
 #include "Matrix4x4.h"
 #include "DirectXSetup.h"
+#include "RingConstantBuffer.h"
 #include "LightingType.h"
 
  /// <summary>
@@ -66,16 +67,6 @@ public:
 	bool isEnviromentMap = false;
 
 	//定数バッファ
-	ComPtr<ID3D12Resource> resource = nullptr;
-
-
-
-
-private:
-
-	
-
-	//書き込みのデータ
-	MaterialData* materialData_ = nullptr;
+	Elysia::RingConstantBuffer resource = {};
 
 };
@@ -0,0 +1,349 @@
+#include "BatchCalculation.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include <Matrix4x4Calculation.h>
+#include <VectorCalculation.h>
+#include <Calculation/QuaternionCalculation.h>
+#include <SimdCalculation.h>
+
+namespace {
+
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	using SimdCalculation::Float4;
+
+	//floatの配列として読み書きするので、詰め物が無いことを確かめておく
+	static_assert(sizeof(Vector3) == sizeof(float) * 3u);
+	static_assert(sizeof(Quaternion) == sizeof(float) * 4u);
+	static_assert(sizeof(Matrix4x4) == sizeof(float) * 16u);
+
+	//一度に計算する数
+	const size_t LANE_COUNT_ = 4u;
+
+	/// <summary>
+	/// 成分ごとに並んだ4つ分の3x3と座標を、4つのアフィン行列にして書き込む
+	/// </summary>
+	/// <param name="linear">3x3の各要素(4つ分)</param>
+	/// <param name="translateX">座標X(4つ分)</param>
+	/// <param name="translateY">座標Y(4つ分)</param>
+	/// <param name="translateZ">座標Z(4つ分)</param>
+	/// <param name="results">書き込み先(4つ)</param>
+	inline void StoreAffineMatrix4(const Float4 (&linear)[3][3], const Float4& translateX, const Float4& translateY, const Float4& translateZ, Matrix4x4* results) {
+		using namespace SimdCalculation;
+		//転置すると1つの行列の1行になる(4列目は0)
+		for (uint32_t row = 0u; row < 3u; ++row) {
+			Float4 row0 = linear[row][0];
+			Float4 row1 = linear[row][1];
+			Float4 row2 = linear[row][2];
+			Float4 row3 = Zero();
+			Transpose(row0, row1, row2, row3);
+			Store(results[0].m[row], row0);
+			Store(results[1].m[row], row1);
+			Store(results[2].m[row], row2);
+			Store(results[3].m[row], row3);
+		}
+
+		Float4 x = translateX;
+		Float4 y = translateY;
+		Float4 z = translateZ;
+		Float4 w = Splat(1.0f);
+		Transpose(x, y, z, w);
+		Store(results[0].m[3], x);
+		Store(results[1].m[3], y);
+		Store(results[2].m[3], z);
+		Store(results[3].m[3], w);
+	}
+
+	/// <summary>
+	/// 4つのクォータニオンとスケールと座標から4つのアフィン行列を作る
+	/// </summary>
+	/// <param name="quaternions">クォータニオン(4つ)</param>
+	/// <param name="scaleX">スケールX(4つ分)</param>
+	/// <param name="scaleY">スケールY(4つ分)</param>
+	/// <param name="scaleZ">スケールZ(4つ分)</param>
+	/// <param name="translateX">座標X(4つ分)</param>
+	/// <param name="translateY">座標Y(4つ分)</param>
+	/// <param name="translateZ">座標Z(4つ分)</param>
+	/// <param name="results">書き込み先(4つ)</param>
+	inline void ComposeQuaternionAffineMatrix4(const Quaternion* quaternions,
+		const Float4& scaleX, const Float4& scaleY, const Float4& scaleZ,
+		const Float4& translateX, const Float4& translateY, const Float4& translateZ, Matrix4x4* results) {
+		using namespace SimdCalculation;
+		//成分ごとに並べ替える
+		Float4 x = Load(&quaternions[0].x);
+		Float4 y = Load(&quaternions[1].x);
+		Float4 z = Load(&quaternions[2].x);
+		Float4 w = Load(&quaternions[3].x);
+		Transpose(x, y, z, w);
+
+		const Float4 TWO = Splat(2.0f);
+		Float4 xx = Multiply(x, x);
+		Float4 yy = Multiply(y, y);
+		Float4 zz = Multiply(z, z);
+		Float4 ww = Multiply(w, w);
+		Float4 xy = Multiply(x, y);
+		Float4 xz = Multiply(x, z);
+		Float4 yz = Multiply(y, z);
+		Float4 wx = Multiply(w, x);
+		Float4 wy = Multiply(w, y);
+		Float4 wz = Multiply(w, z);
+
+		//QuaternionCalculation::MakeRotateMatrixと同じ式
+		Float4 linear[3][3] = {};
+		linear[0][0] = Multiply(scaleX, Subtract(Subtract(Add(ww, xx), yy), zz));
+		linear[0][1] = Multiply(scaleX, Multiply(TWO, Add(xy, wz)));
+		linear[0][2] = Multiply(scaleX, Multiply(TWO, Subtract(xz, wy)));
+
+		linear[1][0] = Multiply(scaleY, Multiply(TWO, Subtract(xy, wz)));
+		linear[1][1] = Multiply(scaleY, Subtract(Add(Subtract(ww, xx), yy), zz));
+		linear[1][2] = Multiply(scaleY, Multiply(TWO, Add(yz, wx)));
+
+		linear[2][0] = Multiply(scaleZ, Multiply(TWO, Add(xz, wy)));
+		linear[2][1] = Multiply(scaleZ, Multiply(TWO, Subtract(yz, wx)));
+		linear[2][2] = Multiply(scaleZ, Add(Subtract(Subtract(ww, xx), yy), zz));
+
+		StoreAffineMatrix4(linear, translateX, translateY, translateZ, results);
+	}
+#endif
+}
+
+void BatchCalculation::TransformPoints(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> results){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	using namespace SimdCalculation;
+	assert(points.size() == results.size());
+	const Float4 M00 = Splat(m.m[0][0]), M01 = Splat(m.m[0][1]), M02 = Splat(m.m[0][2]), M03 = Splat(m.m[0][3]);
+	const Float4 M10 = Splat(m.m[1][0]), M11 = Splat(m.m[1][1]), M12 = Splat(m.m[1][2]), M13 = Splat(m.m[1][3]);
+	const Float4 M20 = Splat(m.m[2][0]), M21 = Splat(m.m[2][1]), M22 = Splat(m.m[2][2]), M23 = Splat(m.m[2][3]);
+	const Float4 M30 = Splat(m.m[3][0]), M31 = Splat(m.m[3][1]), M32 = Splat(m.m[3][2]), M33 = Splat(m.m[3][3]);
+	const Float4 ONE = Splat(1.0f);
+
+	size_t i = 0u;
+	for (; i + LANE_COUNT_ <= points.size(); i += LANE_COUNT_) {
+		Float4 x = {}, y = {}, z = {};
+		LoadVector3x4(&points[i].x, x, y, z);
+		Float4 resultX = MultiplyAdd(z, M20, MultiplyAdd(y, M10, MultiplyAdd(x, M00, M30)));
+		Float4 resultY = MultiplyAdd(z, M21, MultiplyAdd(y, M11, MultiplyAdd(x, M01, M31)));
+		Float4 resultZ = MultiplyAdd(z, M22, MultiplyAdd(y, M12, MultiplyAdd(x, M02, M32)));
+		Float4 resultW = MultiplyAdd(z, M23, MultiplyAdd(y, M13, MultiplyAdd(x, M03, M33)));
+
+		//0除算を避ける
+		resultW = Select(Equal(resultW, Zero()), ONE, resultW);
+		StoreVector3x4(&results[i].x, Divide(resultX, resultW), Divide(resultY, resultW), Divide(resultZ, resultW));
+	}
+	//残り
+	for (; i < points.size(); ++i) {
+		results[i] = VectorCalculation::TransformCalculation(points[i], m);
+	}
+#else
+	Scalar::TransformPoints(points, m, results);
+#endif
+}
+
+void BatchCalculation::Scalar::TransformPoints(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> results){
+	assert(points.size() == results.size());
+	for (size_t i = 0u; i < points.size(); ++i) {
+		results[i] = VectorCalculation::TransformCalculation(points[i], m);
+	}
+}
+
+void BatchCalculation::TransformNormals(std::span<const Vector3> normals, const Matrix4x4& m, std::span<Vector3> results){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	using namespace SimdCalculation;
+	assert(normals.size() == results.size());
+	const Float4 M00 = Splat(m.m[0][0]), M01 = Splat(m.m[0][1]), M02 = Splat(m.m[0][2]);
+	const Float4 M10 = Splat(m.m[1][0]), M11 = Splat(m.m[1][1]), M12 = Splat(m.m[1][2]);
+	const Float4 M20 = Splat(m.m[2][0]), M21 = Splat(m.m[2][1]), M22 = Splat(m.m[2][2]);
+
+	size_t i = 0u;
+	for (; i + LANE_COUNT_ <= normals.size(); i += LANE_COUNT_) {
+		Float4 x = {}, y = {}, z = {};
+		LoadVector3x4(&normals[i].x, x, y, z);
+		Float4 resultX = MultiplyAdd(z, M20, MultiplyAdd(y, M10, Multiply(x, M00)));
+		Float4 resultY = MultiplyAdd(z, M21, MultiplyAdd(y, M11, Multiply(x, M01)));
+		Float4 resultZ = MultiplyAdd(z, M22, MultiplyAdd(y, M12, Multiply(x, M02)));
+		StoreVector3x4(&results[i].x, resultX, resultY, resultZ);
+	}
+	//残り
+	Scalar::TransformNormals(normals.subspan(i), m, results.subspan(i));
+#else
+	Scalar::TransformNormals(normals, m, results);
+#endif
+}
+
+void BatchCalculation::Scalar::TransformNormals(std::span<const Vector3> normals, const Matrix4x4& m, std::span<Vector3> results){
+	assert(normals.size() == results.size());
+	for (size_t i = 0u; i < normals.size(); ++i) {
+		const Vector3 NORMAL = normals[i];
+		results[i] = {
+			.x = (NORMAL.x * m.m[0][0]) + (NORMAL.y * m.m[1][0]) + (NORMAL.z * m.m[2][0]),
+			.y = (NORMAL.x * m.m[0][1]) + (NORMAL.y * m.m[1][1]) + (NORMAL.z * m.m[2][1]),
+			.z = (NORMAL.x * m.m[0][2]) + (NORMAL.y * m.m[1][2]) + (NORMAL.z * m.m[2][2]),
+		};
+	}
+}
+
+void BatchCalculation::MultiplyMany(std::span<const Matrix4x4> m1, std::span<const Matrix4x4> m2, std::span<Matrix4x4> results){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	assert(m1.size() == m2.size());
+	assert(m1.size() == results.size());
+	for (size_t i = 0u; i < m1.size(); ++i) {
+		SimdCalculation::MultiplyMatrix4x4(m1[i].m, m2[i].m, results[i].m);
+	}
+#else
+	Scalar::MultiplyMany(m1, m2, results);
+#endif
+}
+
+void BatchCalculation::Scalar::MultiplyMany(std::span<const Matrix4x4> m1, std::span<const Matrix4x4> m2, std::span<Matrix4x4> results){
+	assert(m1.size() == m2.size());
+	assert(m1.size() == results.size());
+	for (size_t i = 0u; i < m1.size(); ++i) {
+		results[i] = Matrix4x4Calculation::Scalar::Multiply(m1[i], m2[i]);
+	}
+}
+
+void BatchCalculation::MultiplyMany(std::span<const Matrix4x4> m1, const Matrix4x4& m2, std::span<Matrix4x4> results){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	using namespace SimdCalculation;
+	assert(m1.size() == results.size());
+	//右の行列は最初に1回だけ読む
+	const Float4 ROWS[4] = { Load(m2.m[0]), Load(m2.m[1]), Load(m2.m[2]), Load(m2.m[3]) };
+	for (size_t i = 0u; i < m1.size(); ++i) {
+		Float4 row0 = TransformRow(Load(m1[i].m[0]), ROWS);
+		Float4 row1 = TransformRow(Load(m1[i].m[1]), ROWS);
+		Float4 row2 = TransformRow(Load(m1[i].m[2]), ROWS);
+		Float4 row3 = TransformRow(Load(m1[i].m[3]), ROWS);
+		Store(results[i].m[0], row0);
+		Store(results[i].m[1], row1);
+		Store(results[i].m[2], row2);
+		Store(results[i].m[3], row3);
+	}
+#else
+	Scalar::MultiplyMany(m1, m2, results);
+#endif
+}
+
+void BatchCalculation::Scalar::MultiplyMany(std::span<const Matrix4x4> m1, const Matrix4x4& m2, std::span<Matrix4x4> results){
+	assert(m1.size() == results.size());
+	for (size_t i = 0u; i < m1.size(); ++i) {
+		results[i] = Matrix4x4Calculation::Scalar::Multiply(m1[i], m2);
+	}
+}
+
+void BatchCalculation::MakeAffineMany(std::span<const Vector3> scales, std::span<const Vector3> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	using namespace SimdCalculation;
+	assert(scales.size() == rotates.size());
+	assert(scales.size() == translates.size());
+	assert(scales.size() == results.size());
+
+	size_t i = 0u;
+	for (; i + LANE_COUNT_ <= scales.size(); i += LANE_COUNT_) {
+		Float4 scaleX = {}, scaleY = {}, scaleZ = {};
+		Float4 rotateX = {}, rotateY = {}, rotateZ = {};
+		Float4 translateX = {}, translateY = {}, translateZ = {};
+		LoadVector3x4(&scales[i].x, scaleX, scaleY, scaleZ);
+		LoadVector3x4(&rotates[i].x, rotateX, rotateY, rotateZ);
+		LoadVector3x4(&translates[i].x, translateX, translateY, translateZ);
+
+		//4つ分のsinとcosを軸ごとに求める
+		Float4 sinX = {}, cosX = {}, sinY = {}, cosY = {}, sinZ = {}, cosZ = {};
+		SinCos(rotateX, sinX, cosX);
+		SinCos(rotateY, sinY, cosY);
+		SinCos(rotateZ, sinZ, cosZ);
+
+		//Matrix4x4Calculation::MakeAffineMatrixと同じ式
+		Float4 sinXsinY = Multiply(sinX, sinY);
+		Float4 cosXsinY = Multiply(cosX, sinY);
+		Float4 linear[3][3] = {};
+		linear[0][0] = Multiply(scaleX, Multiply(cosY, cosZ));
+		linear[0][1] = Multiply(scaleX, Multiply(cosY, sinZ));
+		linear[0][2] = Multiply(scaleX, Subtract(Zero(), sinY));
+
+		linear[1][0] = Multiply(scaleY, MultiplySubtract(cosX, sinZ, Multiply(sinXsinY, cosZ)));
+		linear[1][1] = Multiply(scaleY, MultiplyAdd(cosX, cosZ, Multiply(sinXsinY, sinZ)));
+		linear[1][2] = Multiply(scaleY, Multiply(sinX, cosY));
+
+		linear[2][0] = Multiply(scaleZ, MultiplyAdd(sinX, sinZ, Multiply(cosXsinY, cosZ)));
+		linear[2][1] = Multiply(scaleZ, MultiplySubtract(sinX, cosZ, Multiply(cosXsinY, sinZ)));
+		linear[2][2] = Multiply(scaleZ, Multiply(cosX, cosY));
+
+		StoreAffineMatrix4(linear, translateX, translateY, translateZ, &results[i]);
+	}
+	//残り
+	for (; i < scales.size(); ++i) {
+		results[i] = Matrix4x4Calculation::MakeAffineMatrix(scales[i], rotates[i], translates[i]);
+	}
+#else
+	Scalar::MakeAffineMany(scales, rotates, translates, results);
+#endif
+}
+
+void BatchCalculation::Scalar::MakeAffineMany(std::span<const Vector3> scales, std::span<const Vector3> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results){
+	assert(scales.size() == rotates.size());
+	assert(scales.size() == translates.size());
+	assert(scales.size() == results.size());
+	for (size_t i = 0u; i < scales.size(); ++i) {
+		results[i] = Matrix4x4Calculation::Scalar::MakeAffineMatrix(scales[i], rotates[i], translates[i]);
+	}
+}
+
+void BatchCalculation::MakeQuaternionAffineMany(std::span<const Vector3> scales, std::span<const Quaternion> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	using namespace SimdCalculation;
+	assert(scales.size() == rotates.size());
+	assert(scales.size() == translates.size());
+	assert(scales.size() == results.size());
+
+	size_t i = 0u;
+	for (; i + LANE_COUNT_ <= scales.size(); i += LANE_COUNT_) {
+		Float4 scaleX = {}, scaleY = {}, scaleZ = {};
+		Float4 translateX = {}, translateY = {}, translateZ = {};
+		LoadVector3x4(&scales[i].x, scaleX, scaleY, scaleZ);
+		LoadVector3x4(&translates[i].x, translateX, translateY, translateZ);
+		ComposeQuaternionAffineMatrix4(&rotates[i], scaleX, scaleY, scaleZ, translateX, translateY, translateZ, &results[i]);
+	}
+	//残り
+	for (; i < scales.size(); ++i) {
+		results[i] = Matrix4x4Calculation::MakeQuaternionAffineMatrix(scales[i], rotates[i], translates[i]);
+	}
+#else
+	Scalar::MakeQuaternionAffineMany(scales, rotates, translates, results);
+#endif
+}
+
+void BatchCalculation::Scalar::MakeQuaternionAffineMany(std::span<const Vector3> scales, std::span<const Quaternion> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results){
+	assert(scales.size() == rotates.size());
+	assert(scales.size() == translates.size());
+	assert(scales.size() == results.size());
+	for (size_t i = 0u; i < scales.size(); ++i) {
+		results[i] = Matrix4x4Calculation::Scalar::MakeQuaternionAffineMatrix(scales[i], rotates[i], translates[i]);
+	}
+}
+
+void BatchCalculation::MakeRotateMatrixMany(std::span<const Quaternion> quaternions, std::span<Matrix4x4> results){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	using namespace SimdCalculation;
+	assert(quaternions.size() == results.size());
+	//スケール1、座標0のアフィン行列と同じ
+	const Float4 ONE = Splat(1.0f);
+	const Float4 ZERO = Zero();
+
+	size_t i = 0u;
+	for (; i + LANE_COUNT_ <= quaternions.size(); i += LANE_COUNT_) {
+		ComposeQuaternionAffineMatrix4(&quaternions[i], ONE, ONE, ONE, ZERO, ZERO, ZERO, &results[i]);
+	}
+	//残り
+	Scalar::MakeRotateMatrixMany(quaternions.subspan(i), results.subspan(i));
+#else
+	Scalar::MakeRotateMatrixMany(quaternions, results);
+#endif
+}
+
+void BatchCalculation::Scalar::MakeRotateMatrixMany(std::span<const Quaternion> quaternions, std::span<Matrix4x4> results){
+	assert(quaternions.size() == results.size());
+	for (size_t i = 0u; i < quaternions.size(); ++i) {
+		results[i] = QuaternionCalculation::MakeRotateMatrix(quaternions[i]);
+	}
+}
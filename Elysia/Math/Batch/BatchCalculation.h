@@ -0,0 +1,147 @@
+#pragma once
+
+/**
+ * @file BatchCalculation.h
+ * @brief 配列をまとめて計算する
+ * @author 茂木翼
+ */
+
+#include <span>
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include "Quaternion.h"
+
+/// <summary>
+/// 配列をまとめて計算する
+/// 1つずつ関数を呼ぶより速い。SIMDが使える時は4つずつ計算する
+/// 結果の配列は入力と同じ数にしておくこと
+/// </summary>
+namespace BatchCalculation {
+
+	/// <summary>
+	/// 座標を行列で変換する(VectorCalculation::TransformCalculationをまとめて行う)
+	/// resultsはpointsと同じ配列でも良い
+	/// </summary>
+	/// <param name="points">座標</param>
+	/// <param name="m">行列</param>
+	/// <param name="results">結果</param>
+	void TransformPoints(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> results);
+
+	/// <summary>
+	/// 法線(方向)を行列で変換する
+	/// 平行移動は無視する。正規化はしない
+	/// resultsはnormalsと同じ配列でも良い
+	/// </summary>
+	/// <param name="normals">法線</param>
+	/// <param name="m">行列</param>
+	/// <param name="results">結果</param>
+	void TransformNormals(std::span<const Vector3> normals, const Matrix4x4& m, std::span<Vector3> results);
+
+	/// <summary>
+	/// 掛け算(m1[i] * m2[i])
+	/// </summary>
+	/// <param name="m1">左の行列</param>
+	/// <param name="m2">右の行列</param>
+	/// <param name="results">結果</param>
+	void MultiplyMany(std::span<const Matrix4x4> m1, std::span<const Matrix4x4> m2, std::span<Matrix4x4> results);
+
+	/// <summary>
+	/// 全部に同じ行列を掛ける(m1[i] * m2)
+	/// 親やビュープロジェクションを掛ける時に使う
+	/// </summary>
+	/// <param name="m1">左の行列</param>
+	/// <param name="m2">右の行列</param>
+	/// <param name="results">結果</param>
+	void MultiplyMany(std::span<const Matrix4x4> m1, const Matrix4x4& m2, std::span<Matrix4x4> results);
+
+	/// <summary>
+	/// アフィン行列(Matrix4x4Calculation::MakeAffineMatrixをまとめて行う)
+	/// </summary>
+	/// <param name="scales">スケール</param>
+	/// <param name="rotates">回転(オイラー角)</param>
+	/// <param name="translates">座標</param>
+	/// <param name="results">結果</param>
+	void MakeAffineMany(std::span<const Vector3> scales, std::span<const Vector3> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results);
+
+	/// <summary>
+	/// クォータニオンからアフィン行列(Matrix4x4Calculation::MakeQuaternionAffineMatrixをまとめて行う)
+	/// </summary>
+	/// <param name="scales">スケール</param>
+	/// <param name="rotates">回転</param>
+	/// <param name="translates">座標</param>
+	/// <param name="results">結果</param>
+	void MakeQuaternionAffineMany(std::span<const Vector3> scales, std::span<const Quaternion> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results);
+
+	/// <summary>
+	/// クォータニオンから回転行列(QuaternionCalculation::MakeRotateMatrixをまとめて行う)
+	/// </summary>
+	/// <param name="quaternions">クォータニオン</param>
+	/// <param name="results">結果</param>
+	void MakeRotateMatrixMany(std::span<const Quaternion> quaternions, std::span<Matrix4x4> results);
+
+	/// <summary>
+	/// SIMDを使わない計算
+	/// SIMDが使えない環境ではこちらが呼ばれる。SIMD版の誤差の確認にも使う
+	/// </summary>
+	namespace Scalar {
+
+		/// <summary>
+		/// 座標を行列で変換する
+		/// </summary>
+		/// <param name="points">座標</param>
+		/// <param name="m">行列</param>
+		/// <param name="results">結果</param>
+		void TransformPoints(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> results);
+
+		/// <summary>
+		/// 法線(方向)を行列で変換する
+		/// </summary>
+		/// <param name="normals">法線</param>
+		/// <param name="m">行列</param>
+		/// <param name="results">結果</param>
+		void TransformNormals(std::span<const Vector3> normals, const Matrix4x4& m, std::span<Vector3> results);
+
+		/// <summary>
+		/// 掛け算(m1[i] * m2[i])
+		/// </summary>
+		/// <param name="m1">左の行列</param>
+		/// <param name="m2">右の行列</param>
+		/// <param name="results">結果</param>
+		void MultiplyMany(std::span<const Matrix4x4> m1, std::span<const Matrix4x4> m2, std::span<Matrix4x4> results);
+
+		/// <summary>
+		/// 全部に同じ行列を掛ける(m1[i] * m2)
+		/// </summary>
+		/// <param name="m1">左の行列</param>
+		/// <param name="m2">右の行列</param>
+		/// <param name="results">結果</param>
+		void MultiplyMany(std::span<const Matrix4x4> m1, const Matrix4x4& m2, std::span<Matrix4x4> results);
+
+		/// <summary>
+		/// アフィン行列
+		/// </summary>
+		/// <param name="scales">スケール</param>
+		/// <param name="rotates">回転(オイラー角)</param>
+		/// <param name="translates">座標</param>
+		/// <param name="results">結果</param>
+		void MakeAffineMany(std::span<const Vector3> scales, std::span<const Vector3> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results);
+
+		/// <summary>
+		/// クォータニオンからアフィン行列
+		/// </summary>
+		/// <param name="scales">スケール</param>
+		/// <param name="rotates">回転</param>
+		/// <param name="translates">座標</param>
+		/// <param name="results">結果</param>
+		void MakeQuaternionAffineMany(std::span<const Vector3> scales, std::span<const Quaternion> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results);
+
+		/// <summary>
+		/// クォータニオンから回転行列
+		/// </summary>
+		/// <param name="quaternions">クォータニオン</param>
+		/// <param name="results">結果</param>
+		void MakeRotateMatrixMany(std::span<const Quaternion> quaternions, std::span<Matrix4x4> results);
+
+	}
+}
@@ -1,6 +1,171 @@
 #include "Matrix4x4Calculation.h"
 #include <VectorCalculation.h>
 #include <SingleCalculation.h>
+#include <SimdCalculation.h>
+#include <cstdint>
+
+namespace {
+
+	/// <summary>
+	/// sinとcosからアフィン行列を作る
+	/// X,Y,Zの回転行列を掛けた結果を展開してあるので、途中の行列の掛け算が要らない
+	/// </summary>
+	/// <param name="scale">スケール</param>
+	/// <param name="sines">X,Y,Zのsin</param>
+	/// <param name="cosines">X,Y,Zのcos</param>
+	/// <param name="translate">座標</param>
+	/// <returns>アフィン行列</returns>
+	inline Matrix4x4 ComposeAffineMatrix(const Vector3& scale, const float* sines, const float* cosines, const Vector3& translate) {
+		const float SIN_X = sines[0], SIN_Y = sines[1], SIN_Z = sines[2];
+		const float COS_X = cosines[0], COS_Y = cosines[1], COS_Z = cosines[2];
+
+		Matrix4x4 result = {};
+		result.m[0][0] = scale.x * (COS_Y * COS_Z);
+		result.m[0][1] = scale.x * (COS_Y * SIN_Z);
+		result.m[0][2] = scale.x * (-SIN_Y);
+		result.m[0][3] = 0.0f;
+
+		result.m[1][0] = scale.y * (-COS_X * SIN_Z + SIN_X * SIN_Y * COS_Z);
+		result.m[1][1] = scale.y * (COS_X * COS_Z + SIN_X * SIN_Y * SIN_Z);
+		result.m[1][2] = scale.y * (SIN_X * COS_Y);
+		result.m[1][3] = 0.0f;
+
+		result.m[2][0] = scale.z * (SIN_X * SIN_Z + COS_X * SIN_Y * COS_Z);
+		result.m[2][1] = scale.z * (-SIN_X * COS_Z + COS_X * SIN_Y * SIN_Z);
+		result.m[2][2] = scale.z * (COS_X * COS_Y);
+		result.m[2][3] = 0.0f;
+
+		result.m[3][0] = translate.x;
+		result.m[3][1] = translate.y;
+		result.m[3][2] = translate.z;
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	using SimdCalculation::Float4;
+
+	/// <summary>
+	/// 2x2行列(x,y,z,wに行の順で入っている)の積 A * B
+	/// </summary>
+	inline Float4 Multiply2x2(const Float4& a, const Float4& b) {
+		using namespace SimdCalculation;
+		return MultiplyAdd(a, Shuffle<0, 3, 0, 3>(b, b), Multiply(Shuffle<1, 0, 3, 2>(a, a), Shuffle<2, 1, 2, 1>(b, b)));
+	}
+
+	/// <summary>
+	/// 2x2行列の余因子行列との積 adj(A) * B
+	/// </summary>
+	inline Float4 AdjointMultiply2x2(const Float4& a, const Float4& b) {
+		using namespace SimdCalculation;
+		return Subtract(Multiply(Shuffle<3, 3, 0, 0>(a, a), b), Multiply(Shuffle<1, 1, 2, 2>(a, a), Shuffle<2, 3, 0, 1>(b, b)));
+	}
+
+	/// <summary>
+	/// 2x2行列の余因子行列との積 A * adj(B)
+	/// </summary>
+	inline Float4 MultiplyAdjoint2x2(const Float4& a, const Float4& b) {
+		using namespace SimdCalculation;
+		return Subtract(Multiply(a, Shuffle<3, 0, 3, 0>(b, b)), Multiply(Shuffle<1, 0, 3, 2>(a, a), Shuffle<2, 1, 2, 1>(b, b)));
+	}
+
+	/// <summary>
+	/// 逆行列(SIMD)
+	/// 2x2の小行列に分けて余因子から求める
+	/// </summary>
+	inline Matrix4x4 InverseSimd(const Matrix4x4& m) {
+		using namespace SimdCalculation;
+		const Float4 ROW0 = Load(m.m[0]);
+		const Float4 ROW1 = Load(m.m[1]);
+		const Float4 ROW2 = Load(m.m[2]);
+		const Float4 ROW3 = Load(m.m[3]);
+
+		//| A B |
+		//| C D |
+		Float4 a = Shuffle<0, 1, 0, 1>(ROW0, ROW1);
+		Float4 b = Shuffle<2, 3, 2, 3>(ROW0, ROW1);
+		Float4 c = Shuffle<0, 1, 0, 1>(ROW2, ROW3);
+		Float4 d = Shuffle<2, 3, 2, 3>(ROW2, ROW3);
+
+		//小行列の行列式(|A|,|B|,|C|,|D|)
+		Float4 subDeterminant = Subtract(
+			Multiply(Shuffle<0, 2, 0, 2>(ROW0, ROW2), Shuffle<1, 3, 1, 3>(ROW1, ROW3)),
+			Multiply(Shuffle<1, 3, 1, 3>(ROW0, ROW2), Shuffle<0, 2, 0, 2>(ROW1, ROW3)));
+		Float4 determinantA = SplatLane<0>(subDeterminant);
+		Float4 determinantB = SplatLane<1>(subDeterminant);
+		Float4 determinantC = SplatLane<2>(subDeterminant);
+		Float4 determinantD = SplatLane<3>(subDeterminant);
+
+		//adj(D)C,adj(A)B
+		Float4 adjointDC = AdjointMultiply2x2(d, c);
+		Float4 adjointAB = AdjointMultiply2x2(a, b);
+
+		//逆行列の各ブロック(行列式で割る前)
+		Float4 x = Subtract(Multiply(determinantD, a), Multiply2x2(b, adjointDC));
+		Float4 w = Subtract(Multiply(determinantA, d), Multiply2x2(c, adjointAB));
+		Float4 y = Subtract(Multiply(determinantB, c), MultiplyAdjoint2x2(d, adjointAB));
+		Float4 z = Subtract(Multiply(determinantC, b), MultiplyAdjoint2x2(a, adjointDC));
+
+		//|M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		Float4 determinant = Add(Multiply(determinantA, determinantD), Multiply(determinantB, determinantC));
+		determinant = Subtract(determinant, HorizontalSum(Multiply(adjointAB, Shuffle<0, 2, 1, 3>(adjointDC, adjointDC))));
+
+		//余因子の符号と一緒に割る
+		Float4 inverseDeterminant = Divide(Set(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+		x = Multiply(x, inverseDeterminant);
+		y = Multiply(y, inverseDeterminant);
+		z = Multiply(z, inverseDeterminant);
+		w = Multiply(w, inverseDeterminant);
+
+		//余因子の転置と並べ直しをまとめて行う
+		Matrix4x4 result;
+		Store(result.m[0], Shuffle<3, 1, 3, 1>(x, y));
+		Store(result.m[1], Shuffle<2, 0, 2, 0>(x, y));
+		Store(result.m[2], Shuffle<3, 1, 3, 1>(z, w));
+		Store(result.m[3], Shuffle<2, 0, 2, 0>(z, w));
+		return result;
+	}
+
+	/// <summary>
+	/// アフィン行列の逆行列(SIMD)
+	/// </summary>
+	inline Matrix4x4 InverseAffineSimd(const Matrix4x4& m) {
+		using namespace SimdCalculation;
+		const Float4 ROW0 = Load(m.m[0]);
+		const Float4 ROW1 = Load(m.m[1]);
+		const Float4 ROW2 = Load(m.m[2]);
+		const Float4 TRANSLATE = Load(m.m[3]);
+
+		//3x3の逆行列の列は外積で求まる
+		Float4 column0 = Cross3(ROW1, ROW2);
+		Float4 column1 = Cross3(ROW2, ROW0);
+		Float4 column2 = Cross3(ROW0, ROW1);
+		Float4 inverseDeterminant = Divide(Splat(1.0f), Dot3(ROW0, column0));
+
+		//列を行に並べ替える(4列目は0になる)
+		Float4 column3 = Zero();
+		Transpose(column0, column1, column2, column3);
+		Float4 inverseRows[4] = {
+			Multiply(column0, inverseDeterminant),
+			Multiply(column1, inverseDeterminant),
+			Multiply(column2, inverseDeterminant),
+			Set(0.0f, 0.0f, 0.0f, 1.0f),
+		};
+
+		//平行移動は-t * L^-1
+		Float4 translate = Multiply(SplatLane<0>(TRANSLATE), inverseRows[0]);
+		translate = MultiplyAdd(SplatLane<1>(TRANSLATE), inverseRows[1], translate);
+		translate = MultiplyAdd(SplatLane<2>(TRANSLATE), inverseRows[2], translate);
+
+		Matrix4x4 result;
+		Store(result.m[0], inverseRows[0]);
+		Store(result.m[1], inverseRows[1]);
+		Store(result.m[2], inverseRows[2]);
+		Store(result.m[3], Subtract(inverseRows[3], translate));
+		return result;
+	}
+#endif
+}
 
 
 Matrix4x4 Matrix4x4Calculation::MakeIdentity4x4(){
@@ -30,6 +195,16 @@ Matrix4x4 Matrix4x4Calculation::MakeIdentity4x4(){
 }
 
 Matrix4x4 Matrix4x4Calculation::Multiply(const Matrix4x4& m1, const Matrix4x4& m2){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	Matrix4x4 result;
+	SimdCalculation::MultiplyMatrix4x4(m1.m, m2.m, result.m);
+	return result;
+#else
+	return Scalar::Multiply(m1, m2);
+#endif
+}
+
+Matrix4x4 Matrix4x4Calculation::Scalar::Multiply(const Matrix4x4& m1, const Matrix4x4& m2){
 	Matrix4x4 result = {
 		result.m[0][0] = (m1.m[0][0] * m2.m[0][0]) + (m1.m[0][1] * m2.m[1][0]) + (m1.m[0][2] * m2.m[2][0]) + (m1.m[0][3] * m2.m[3][0]),
 		result.m[0][1] = (m1.m[0][0] * m2.m[0][1]) + (m1.m[0][1] * m2.m[1][1]) + (m1.m[0][2] * m2.m[2][1]) + (m1.m[0][3] * m2.m[3][1]),
@@ -209,23 +384,72 @@ Matrix4x4 Matrix4x4Calculation::MakeTranslateMatrix(const Vector3& translate){
 }
 
 Matrix4x4 Matrix4x4Calculation::MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate){
-	
-	//Scale
-	Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	//XYZのsinとcosを一度に求める
+	SimdCalculation::Float4 sinValue = {};
+	SimdCalculation::Float4 cosValue = {};
+	SimdCalculation::SinCos(SimdCalculation::Set(rotate.x, rotate.y, rotate.z, 0.0f), sinValue, cosValue);
+	float sines[4] = {};
+	float cosines[4] = {};
+	SimdCalculation::Store(sines, sinValue);
+	SimdCalculation::Store(cosines, cosValue);
+	return ComposeAffineMatrix(scale, sines, cosines, translate);
+#else
+	return Scalar::MakeAffineMatrix(scale, rotate, translate);
+#endif
+}
 
-	//Rotate
-	Matrix4x4 rotateMatrix = MakeRotateXYZMatrix(rotate.x, rotate.y, rotate.z);
+Matrix4x4 Matrix4x4Calculation::Scalar::MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate){
+	//sinとcosは軸ごとに1回ずつで済む
+	const float SINES[3] = { std::sin(rotate.x), std::sin(rotate.y), std::sin(rotate.z) };
+	const float COSINES[3] = { std::cos(rotate.x), std::cos(rotate.y), std::cos(rotate.z) };
+	return ComposeAffineMatrix(scale, SINES, COSINES, translate);
+}
 
-	//Translate
-	Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
+Matrix4x4 Matrix4x4Calculation::MakeQuaternionAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate){
+	//1つだけだとSIMDにしても読み書きの分で速くならないのでそのまま計算する
+	return Scalar::MakeQuaternionAffineMatrix(scale, rotate, translate);
+}
 
-	//Affine
-	Matrix4x4 result = Multiply(scaleMatrix, Multiply(rotateMatrix, translateMatrix));
+Matrix4x4 Matrix4x4Calculation::Scalar::MakeQuaternionAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate){
+	float w = rotate.w;
+	float x = rotate.x;
+	float y = rotate.y;
+	float z = rotate.z;
 
+	//QuaternionCalculation::MakeRotateMatrixの各行にスケールを掛けて、4行目に座標を入れる
+	Matrix4x4 result = {};
+	result.m[0][0] = scale.x * ((w * w) + (x * x) - (y * y) - (z * z));
+	result.m[0][1] = scale.x * (2.0f * (x * y + w * z));
+	result.m[0][2] = scale.x * (2.0f * (x * z - w * y));
+	result.m[0][3] = 0.0f;
+
+	result.m[1][0] = scale.y * (2.0f * (x * y - w * z));
+	result.m[1][1] = scale.y * ((w * w) - (x * x) + (y * y) - (z * z));
+	result.m[1][2] = scale.y * (2.0f * (y * z + w * x));
+	result.m[1][3] = 0.0f;
+
+	result.m[2][0] = scale.z * (2.0f * (x * z + w * y));
+	result.m[2][1] = scale.z * (2.0f * (y * z - w * x));
+	result.m[2][2] = scale.z * ((w * w) - (x * x) - (y * y) + (z * z));
+	result.m[2][3] = 0.0f;
+
+	result.m[3][0] = translate.x;
+	result.m[3][1] = translate.y;
+	result.m[3][2] = translate.z;
+	result.m[3][3] = 1.0f;
 	return result;
 }
 
 Matrix4x4 Matrix4x4Calculation::Inverse(const Matrix4x4& m){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	return InverseSimd(m);
+#else
+	return Scalar::Inverse(m);
+#endif
+}
+
+Matrix4x4 Matrix4x4Calculation::Scalar::Inverse(const Matrix4x4& m){
 	float MatrixFormula =
 		+(m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3])
 		+ (m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1])
@@ -400,6 +624,51 @@ Matrix4x4 Matrix4x4Calculation::Inverse(const Matrix4x4& m){
 	return result;
 }
 
+Matrix4x4 Matrix4x4Calculation::InverseAffine(const Matrix4x4& m){
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+	return InverseAffineSimd(m);
+#else
+	return Scalar::InverseAffine(m);
+#endif
+}
+
+Matrix4x4 Matrix4x4Calculation::Scalar::InverseAffine(const Matrix4x4& m){
+	//左上の3x3の行
+	Vector3 row0 = { .x = m.m[0][0],.y = m.m[0][1],.z = m.m[0][2] };
+	Vector3 row1 = { .x = m.m[1][0],.y = m.m[1][1],.z = m.m[1][2] };
+	Vector3 row2 = { .x = m.m[2][0],.y = m.m[2][1],.z = m.m[2][2] };
+
+	//3x3の逆行列の列は外積で求まる
+	Vector3 column0 = VectorCalculation::Cross(row1, row2);
+	Vector3 column1 = VectorCalculation::Cross(row2, row0);
+	Vector3 column2 = VectorCalculation::Cross(row0, row1);
+	float inverseDeterminant = 1.0f / SingleCalculation::Dot(row0, column0);
+
+	Matrix4x4 result = {};
+	result.m[0][0] = column0.x * inverseDeterminant;
+	result.m[0][1] = column1.x * inverseDeterminant;
+	result.m[0][2] = column2.x * inverseDeterminant;
+	result.m[0][3] = 0.0f;
+
+	result.m[1][0] = column0.y * inverseDeterminant;
+	result.m[1][1] = column1.y * inverseDeterminant;
+	result.m[1][2] = column2.y * inverseDeterminant;
+	result.m[1][3] = 0.0f;
+
+	result.m[2][0] = column0.z * inverseDeterminant;
+	result.m[2][1] = column1.z * inverseDeterminant;
+	result.m[2][2] = column2.z * inverseDeterminant;
+	result.m[2][3] = 0.0f;
+
+	//平行移動は-t * L^-1
+	for (uint32_t i = 0u; i < 3u; ++i) {
+		result.m[3][i] = -(m.m[3][0] * result.m[0][i] + m.m[3][1] * result.m[1][i] + m.m[3][2] * result.m[2][i]);
+	}
+	result.m[3][3] = 1.0f;
+
+	return result;
+}
+
 Matrix4x4 Matrix4x4Calculation::MakePerspectiveFovMatrix(const float_t& fovY, const float_t& aspectRatio, const float_t& nearClip, const float_t& farClip){
 	float theta = fovY / 2.0f;
 
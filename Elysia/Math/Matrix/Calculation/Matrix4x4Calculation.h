@@ -13,6 +13,7 @@
 
 #include "Matrix4x4.h"
 #include "Vector3.h"
+#include "Quaternion.h"
 
 /// <summary>
 /// 4x4行列の計算
@@ -94,6 +95,16 @@ namespace Matrix4x4Calculation {
 	/// <returns></returns>
 	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
 
+	/// <summary>
+	/// クォータニオンからアフィン行列を作る
+	/// 回転行列を作って掛けずに、直接まとめて作る
+	/// </summary>
+	/// <param name="scale"></param>
+	/// <param name="rotate"></param>
+	/// <param name="translate"></param>
+	/// <returns></returns>
+	Matrix4x4 MakeQuaternionAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+
 	/// <summary>
 	/// 逆行列
 	/// </summary>
@@ -101,6 +112,14 @@ namespace Matrix4x4Calculation {
 	/// <returns></returns>
 	Matrix4x4 Inverse(const Matrix4x4& m);
 
+	/// <summary>
+	/// アフィン行列の逆行列
+	/// 4列目が(0,0,0,1)の行列(ワールド行列やカメラ)だけに使える。Inverseより速い
+	/// </summary>
+	/// <param name="m"></param>
+	/// <returns></returns>
+	Matrix4x4 InverseAffine(const Matrix4x4& m);
+
 
 	/// <summary>
 	/// 遠視投影行列
@@ -130,15 +149,52 @@ namespace Matrix4x4Calculation {
 	/// <param name="m"></param>
 	/// <returns></returns>
 	Matrix4x4 MakeTransposeMatrix(const Matrix4x4& m);
-}
-
-
-
-
-
-
-
-
-
-
 
+	/// <summary>
+	/// SIMDを使わない計算
+	/// SIMDが使えない環境ではこちらが呼ばれる。SIMD版の誤差の確認にも使う
+	/// </summary>
+	namespace Scalar {
+
+		/// <summary>
+		/// 掛け算
+		/// </summary>
+		/// <param name="m1"></param>
+		/// <param name="m2"></param>
+		/// <returns></returns>
+		Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
+
+		/// <summary>
+		/// アフィン行列
+		/// </summary>
+		/// <param name="scale"></param>
+		/// <param name="rotate"></param>
+		/// <param name="translate"></param>
+		/// <returns></returns>
+		Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+
+		/// <summary>
+		/// クォータニオンからアフィン行列を作る
+		/// </summary>
+		/// <param name="scale"></param>
+		/// <param name="rotate"></param>
+		/// <param name="translate"></param>
+		/// <returns></returns>
+		Matrix4x4 MakeQuaternionAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+
+		/// <summary>
+		/// 逆行列
+		/// </summary>
+		/// <param name="m"></param>
+		/// <returns></returns>
+		Matrix4x4 Inverse(const Matrix4x4& m);
+
+		/// <summary>
+		/// アフィン行列の逆行列
+		/// </summary>
+		/// <param name="m"></param>
+		/// <returns></returns>
+		Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+	}
+}
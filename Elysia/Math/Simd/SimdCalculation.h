@@ -0,0 +1,490 @@
+#pragma once
+
+/**
+ * @file SimdCalculation.h
+ * @brief 4つのfloatをまとめて計算する(SIMD)
+ * @author 茂木翼
+ */
+
+//使う命令
+#define ELYSIA_MATH_SIMD_NONE 0
+#define ELYSIA_MATH_SIMD_SSE 1
+#define ELYSIA_MATH_SIMD_NEON 2
+
+//プロジェクトの設定でELYSIA_MATH_SIMD=0にするとSIMDを使わずに計算する
+//何も設定しない時は使える命令を自動で選ぶ
+#ifndef ELYSIA_MATH_SIMD
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define ELYSIA_MATH_SIMD ELYSIA_MATH_SIMD_SSE
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+#define ELYSIA_MATH_SIMD ELYSIA_MATH_SIMD_NEON
+#else
+#define ELYSIA_MATH_SIMD ELYSIA_MATH_SIMD_NONE
+#endif
+#endif
+
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+#include <immintrin.h>
+//AVX(/arch:AVX以上)の時は2行ずつ計算する
+#if defined(__AVX__)
+#define ELYSIA_MATH_AVX
+#endif
+//FMA(/arch:AVX2以上)の時は掛けて足すを1回で行う
+#if defined(__FMA__) || defined(__AVX2__)
+#define ELYSIA_MATH_FMA
+#endif
+#elif ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if ELYSIA_MATH_SIMD != ELYSIA_MATH_SIMD_NONE
+
+#include <cstdint>
+
+/// <summary>
+/// 4つのfloatをまとめて計算する
+/// 命令ごとの違いはここで吸収して、使う側は同じ書き方で済むようにする
+/// </summary>
+namespace SimdCalculation {
+
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+	using Float4 = __m128;
+#else
+	using Float4 = float32x4_t;
+#endif
+
+	/// <summary>
+	/// 読み込む(アライメントは要らない)
+	/// </summary>
+	/// <param name="source">4つのfloat</param>
+	/// <returns>値</returns>
+	inline Float4 Load(const float* source) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_loadu_ps(source);
+#else
+		return vld1q_f32(source);
+#endif
+	}
+
+	/// <summary>
+	/// 書き込む(アライメントは要らない)
+	/// </summary>
+	/// <param name="destination">4つのfloat</param>
+	/// <param name="value">値</param>
+	inline void Store(float* destination, const Float4& value) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		_mm_storeu_ps(destination, value);
+#else
+		vst1q_f32(destination, value);
+#endif
+	}
+
+	/// <summary>
+	/// 4つを指定して作る
+	/// </summary>
+	inline Float4 Set(const float& x, const float& y, const float& z, const float& w) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_setr_ps(x, y, z, w);
+#else
+		const float values[4] = { x, y, z, w };
+		return vld1q_f32(values);
+#endif
+	}
+
+	/// <summary>
+	/// 全部同じ値にする
+	/// </summary>
+	inline Float4 Splat(const float& value) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_set1_ps(value);
+#else
+		return vdupq_n_f32(value);
+#endif
+	}
+
+	/// <summary>
+	/// 全部0にする
+	/// </summary>
+	inline Float4 Zero() {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_setzero_ps();
+#else
+		return vdupq_n_f32(0.0f);
+#endif
+	}
+
+	/// <summary>
+	/// 足す
+	/// </summary>
+	inline Float4 Add(const Float4& a, const Float4& b) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_add_ps(a, b);
+#else
+		return vaddq_f32(a, b);
+#endif
+	}
+
+	/// <summary>
+	/// 引く
+	/// </summary>
+	inline Float4 Subtract(const Float4& a, const Float4& b) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_sub_ps(a, b);
+#else
+		return vsubq_f32(a, b);
+#endif
+	}
+
+	/// <summary>
+	/// 掛ける
+	/// </summary>
+	inline Float4 Multiply(const Float4& a, const Float4& b) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_mul_ps(a, b);
+#else
+		return vmulq_f32(a, b);
+#endif
+	}
+
+	/// <summary>
+	/// 割る
+	/// </summary>
+	inline Float4 Divide(const Float4& a, const Float4& b) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_div_ps(a, b);
+#elif defined(__aarch64__) || defined(_M_ARM64)
+		return vdivq_f32(a, b);
+#else
+		//32bitのNEONには割り算が無いので逆数をニュートン法で2回詰める
+		float32x4_t reciprocal = vrecpeq_f32(b);
+		reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+		reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+		return vmulq_f32(a, reciprocal);
+#endif
+	}
+
+	/// <summary>
+	/// a * b + c
+	/// </summary>
+	inline Float4 MultiplyAdd(const Float4& a, const Float4& b, const Float4& c) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+#ifdef ELYSIA_MATH_FMA
+		return _mm_fmadd_ps(a, b, c);
+#else
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+#else
+		return vmlaq_f32(c, a, b);
+#endif
+	}
+
+	/// <summary>
+	/// c - a * b
+	/// </summary>
+	inline Float4 MultiplySubtract(const Float4& a, const Float4& b, const Float4& c) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+#ifdef ELYSIA_MATH_FMA
+		return _mm_fnmadd_ps(a, b, c);
+#else
+		return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
+#else
+		return vmlsq_f32(c, a, b);
+#endif
+	}
+
+	/// <summary>
+	/// 並べ替え
+	/// 結果は{ a[X], a[Y], b[Z], b[W] }
+	/// </summary>
+	template<int X, int Y, int Z, int W>
+	inline Float4 Shuffle(const Float4& a, const Float4& b) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+#else
+		float32x4_t result = vdupq_n_f32(vgetq_lane_f32(a, X));
+		result = vsetq_lane_f32(vgetq_lane_f32(a, Y), result, 1);
+		result = vsetq_lane_f32(vgetq_lane_f32(b, Z), result, 2);
+		result = vsetq_lane_f32(vgetq_lane_f32(b, W), result, 3);
+		return result;
+#endif
+	}
+
+	/// <summary>
+	/// 1つの要素を全部に広げる
+	/// </summary>
+	template<int LANE>
+	inline Float4 SplatLane(const Float4& value) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_shuffle_ps(value, value, _MM_SHUFFLE(LANE, LANE, LANE, LANE));
+#else
+		return vdupq_n_f32(vgetq_lane_f32(value, LANE));
+#endif
+	}
+
+	/// <summary>
+	/// 1つ目の要素を取得
+	/// </summary>
+	inline float GetX(const Float4& value) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_cvtss_f32(value);
+#else
+		return vgetq_lane_f32(value, 0);
+#endif
+	}
+
+	/// <summary>
+	/// 4つの合計を全部に入れる
+	/// </summary>
+	inline Float4 HorizontalSum(const Float4& value) {
+		Float4 sum = Add(value, Shuffle<1, 0, 3, 2>(value, value));
+		return Add(sum, Shuffle<2, 3, 0, 1>(sum, sum));
+	}
+
+	/// <summary>
+	/// 3つの要素の内積を全部に入れる(wは無視する)
+	/// </summary>
+	inline Float4 Dot3(const Float4& a, const Float4& b) {
+		Float4 product = Multiply(a, b);
+		Float4 sum = Add(SplatLane<0>(product), SplatLane<1>(product));
+		return Add(sum, SplatLane<2>(product));
+	}
+
+	/// <summary>
+	/// 外積(wは0になる)
+	/// </summary>
+	inline Float4 Cross3(const Float4& a, const Float4& b) {
+		//(a * b.yzx - a.yzx * b)の並びはzxyになっているのでyzxに戻す
+		Float4 aYZX = Shuffle<1, 2, 0, 3>(a, a);
+		Float4 bYZX = Shuffle<1, 2, 0, 3>(b, b);
+		Float4 crossZXY = Subtract(Multiply(a, bYZX), Multiply(aYZX, b));
+		return Shuffle<1, 2, 0, 3>(crossZXY, crossZXY);
+	}
+
+	/// <summary>
+	/// 4x4を転置する
+	/// </summary>
+	inline void Transpose(Float4& row0, Float4& row1, Float4& row2, Float4& row3) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+#else
+		float32x4x2_t row01 = vtrnq_f32(row0, row1);
+		float32x4x2_t row23 = vtrnq_f32(row2, row3);
+		row0 = vcombine_f32(vget_low_f32(row01.val[0]), vget_low_f32(row23.val[0]));
+		row1 = vcombine_f32(vget_low_f32(row01.val[1]), vget_low_f32(row23.val[1]));
+		row2 = vcombine_f32(vget_high_f32(row01.val[0]), vget_high_f32(row23.val[0]));
+		row3 = vcombine_f32(vget_high_f32(row01.val[1]), vget_high_f32(row23.val[1]));
+#endif
+	}
+
+	/// <summary>
+	/// 要素ごとに等しいか(等しい所は全てのビットが1になる)
+	/// </summary>
+	inline Float4 Equal(const Float4& a, const Float4& b) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_cmpeq_ps(a, b);
+#else
+		return vreinterpretq_f32_u32(vceqq_f32(a, b));
+#endif
+	}
+
+	/// <summary>
+	/// maskのビットが1の所はa、0の所はbを選ぶ
+	/// </summary>
+	inline Float4 Select(const Float4& mask, const Float4& a, const Float4& b) {
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#else
+		return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+#endif
+	}
+
+	/// <summary>
+	/// 行ベクトルに4x4行列を掛ける
+	/// </summary>
+	/// <param name="row">行ベクトル</param>
+	/// <param name="rows">行列の行</param>
+	/// <returns>結果</returns>
+	inline Float4 TransformRow(const Float4& row, const Float4 (&rows)[4]) {
+		Float4 result = Multiply(SplatLane<0>(row), rows[0]);
+		result = MultiplyAdd(SplatLane<1>(row), rows[1], result);
+		result = MultiplyAdd(SplatLane<2>(row), rows[2], result);
+		return MultiplyAdd(SplatLane<3>(row), rows[3], result);
+	}
+
+	/// <summary>
+	/// 4x4行列の積
+	/// resultはm1,m2と同じでも良い
+	/// </summary>
+	/// <param name="m1">左の行列</param>
+	/// <param name="m2">右の行列</param>
+	/// <param name="result">結果</param>
+	inline void MultiplyMatrix4x4(const float (&m1)[4][4], const float (&m2)[4][4], float (&result)[4][4]) {
+#ifdef ELYSIA_MATH_AVX
+		//右の行列の各行を上下に並べておいて、2行ずつ計算する
+		__m256 rows[4] = {};
+		for (uint32_t i = 0u; i < 4u; ++i) {
+			Float4 row = Load(m2[i]);
+			rows[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(row), row, 1);
+		}
+		for (uint32_t i = 0u; i < 4u; i += 2u) {
+			__m256 left = _mm256_loadu_ps(m1[i]);
+#ifdef ELYSIA_MATH_FMA
+			__m256 product = _mm256_mul_ps(_mm256_shuffle_ps(left, left, 0x00), rows[0]);
+			product = _mm256_fmadd_ps(_mm256_shuffle_ps(left, left, 0x55), rows[1], product);
+			product = _mm256_fmadd_ps(_mm256_shuffle_ps(left, left, 0xAA), rows[2], product);
+			product = _mm256_fmadd_ps(_mm256_shuffle_ps(left, left, 0xFF), rows[3], product);
+#else
+			__m256 product = _mm256_mul_ps(_mm256_shuffle_ps(left, left, 0x00), rows[0]);
+			product = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(left, left, 0x55), rows[1]), product);
+			product = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(left, left, 0xAA), rows[2]), product);
+			product = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(left, left, 0xFF), rows[3]), product);
+#endif
+			_mm256_storeu_ps(result[i], product);
+		}
+#else
+		const Float4 ROWS[4] = { Load(m2[0]), Load(m2[1]), Load(m2[2]), Load(m2[3]) };
+		for (uint32_t i = 0u; i < 4u; ++i) {
+			Store(result[i], TransformRow(Load(m1[i]), ROWS));
+		}
+#endif
+	}
+
+	/// <summary>
+	/// (x,y,z)が4つ並んだfloat12個を成分ごとに読み込む
+	/// </summary>
+	/// <param name="source">float12個</param>
+	/// <param name="x">4つのx</param>
+	/// <param name="y">4つのy</param>
+	/// <param name="z">4つのz</param>
+	inline void LoadVector3x4(const float* source, Float4& x, Float4& y, Float4& z) {
+		//a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+		Float4 a = Load(source);
+		Float4 b = Load(source + 4);
+		Float4 c = Load(source + 8);
+		x = Shuffle<0, 3, 0, 2>(a, Shuffle<2, 2, 1, 1>(b, c));
+		y = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 0, 0>(a, b), Shuffle<3, 3, 2, 2>(b, c));
+		z = Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 1, 1>(a, b), Shuffle<0, 0, 3, 3>(c, c));
+	}
+
+	/// <summary>
+	/// 成分ごとの4つを(x,y,z)が4つ並んだfloat12個にして書き込む
+	/// </summary>
+	/// <param name="destination">float12個</param>
+	/// <param name="x">4つのx</param>
+	/// <param name="y">4つのy</param>
+	/// <param name="z">4つのz</param>
+	inline void StoreVector3x4(float* destination, const Float4& x, const Float4& y, const Float4& z) {
+		Store(destination, Shuffle<0, 2, 0, 2>(Shuffle<0, 0, 0, 0>(x, y), Shuffle<0, 0, 1, 1>(z, x)));
+		Store(destination + 4, Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 1, 1>(y, z), Shuffle<2, 2, 2, 2>(x, y)));
+		Store(destination + 8, Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 3, 3>(z, x), Shuffle<3, 3, 3, 3>(y, z)));
+	}
+
+	/// <summary>
+	/// sinとcosを4つずつまとめて求める
+	/// 範囲をπ/4ごとに折り返して多項式で近似する(Cephesのsinf,cosfと同じ方法)
+	/// 誤差は±1000ラジアンで1e-7程度
+	/// </summary>
+	/// <param name="radian">角度(ラジアン)</param>
+	/// <param name="sinValue">sin</param>
+	/// <param name="cosValue">cos</param>
+	inline void SinCos(const Float4& radian, Float4& sinValue, Float4& cosValue) {
+		//π/4を3つに分けて引くことで折り返しの誤差を減らす
+		const float FOUR_OVER_PI = 1.27323954473516f;
+		const float PI_OVER_FOUR_1 = 0.78515625f;
+		const float PI_OVER_FOUR_2 = 2.4187564849853515625e-4f;
+		const float PI_OVER_FOUR_3 = 3.77489497744594108e-8f;
+		//多項式の係数
+		const float SIN_1 = -1.9515295891e-4f;
+		const float SIN_2 = 8.3321608736e-3f;
+		const float SIN_3 = -1.6666654611e-1f;
+		const float COS_1 = 2.443315711809948e-5f;
+		const float COS_2 = -1.388731625493765e-3f;
+		const float COS_3 = 4.166664568298827e-2f;
+
+#if ELYSIA_MATH_SIMD == ELYSIA_MATH_SIMD_SSE
+		const __m128 SIGN_MASK = _mm_castsi128_ps(_mm_set1_epi32(int32_t(0x80000000u)));
+		//符号を外して絶対値で計算する
+		__m128 x = _mm_andnot_ps(SIGN_MASK, radian);
+		__m128 sinSign = _mm_and_ps(radian, SIGN_MASK);
+
+		//何個目のπ/4か(偶数に揃える)
+		__m128i octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(FOUR_OVER_PI)));
+		octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+		__m128 octantFloat = _mm_cvtepi32_ps(octant);
+
+		//象限で符号と多項式を選ぶ
+		__m128 sinSwapSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29));
+		__m128 cosSwapSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+		__m128 isSinPolynomial = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+		sinSign = _mm_xor_ps(sinSign, sinSwapSign);
+
+		//折り返す
+		x = MultiplySubtract(octantFloat, _mm_set1_ps(PI_OVER_FOUR_1), x);
+		x = MultiplySubtract(octantFloat, _mm_set1_ps(PI_OVER_FOUR_2), x);
+		x = MultiplySubtract(octantFloat, _mm_set1_ps(PI_OVER_FOUR_3), x);
+		__m128 z = _mm_mul_ps(x, x);
+
+		//cosの多項式
+		__m128 cosPolynomial = MultiplyAdd(_mm_set1_ps(COS_1), z, _mm_set1_ps(COS_2));
+		cosPolynomial = MultiplyAdd(cosPolynomial, z, _mm_set1_ps(COS_3));
+		cosPolynomial = _mm_mul_ps(_mm_mul_ps(cosPolynomial, z), z);
+		cosPolynomial = MultiplySubtract(z, _mm_set1_ps(0.5f), cosPolynomial);
+		cosPolynomial = _mm_add_ps(cosPolynomial, _mm_set1_ps(1.0f));
+
+		//sinの多項式
+		__m128 sinPolynomial = MultiplyAdd(_mm_set1_ps(SIN_1), z, _mm_set1_ps(SIN_2));
+		sinPolynomial = MultiplyAdd(sinPolynomial, z, _mm_set1_ps(SIN_3));
+		sinPolynomial = MultiplyAdd(_mm_mul_ps(sinPolynomial, z), x, x);
+
+		//選ぶ
+		__m128 sinResult = _mm_or_ps(_mm_and_ps(isSinPolynomial, sinPolynomial), _mm_andnot_ps(isSinPolynomial, cosPolynomial));
+		__m128 cosResult = _mm_or_ps(_mm_and_ps(isSinPolynomial, cosPolynomial), _mm_andnot_ps(isSinPolynomial, sinPolynomial));
+		sinValue = _mm_xor_ps(sinResult, sinSign);
+		cosValue = _mm_xor_ps(cosResult, cosSwapSign);
+#else
+		const uint32x4_t SIGN_MASK = vdupq_n_u32(0x80000000u);
+		//符号を外して絶対値で計算する
+		float32x4_t x = vabsq_f32(radian);
+		uint32x4_t sinSign = vandq_u32(vreinterpretq_u32_f32(radian), SIGN_MASK);
+
+		//何個目のπ/4か(偶数に揃える)
+		int32x4_t octant = vcvtq_s32_f32(vmulq_n_f32(x, FOUR_OVER_PI));
+		octant = vandq_s32(vaddq_s32(octant, vdupq_n_s32(1)), vdupq_n_s32(~1));
+		float32x4_t octantFloat = vcvtq_f32_s32(octant);
+
+		//象限で符号と多項式を選ぶ
+		uint32x4_t sinSwapSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(octant, vdupq_n_s32(4))), 29);
+		uint32x4_t cosSwapSign = vshlq_n_u32(vreinterpretq_u32_s32(vbicq_s32(vdupq_n_s32(4), vsubq_s32(octant, vdupq_n_s32(2)))), 29);
+		uint32x4_t isSinPolynomial = vceqq_s32(vandq_s32(octant, vdupq_n_s32(2)), vdupq_n_s32(0));
+		sinSign = veorq_u32(sinSign, sinSwapSign);
+
+		//折り返す
+		x = vmlsq_n_f32(x, octantFloat, PI_OVER_FOUR_1);
+		x = vmlsq_n_f32(x, octantFloat, PI_OVER_FOUR_2);
+		x = vmlsq_n_f32(x, octantFloat, PI_OVER_FOUR_3);
+		float32x4_t z = vmulq_f32(x, x);
+
+		//cosの多項式
+		float32x4_t cosPolynomial = vmlaq_f32(vdupq_n_f32(COS_2), vdupq_n_f32(COS_1), z);
+		cosPolynomial = vmlaq_f32(vdupq_n_f32(COS_3), cosPolynomial, z);
+		cosPolynomial = vmulq_f32(vmulq_f32(cosPolynomial, z), z);
+		cosPolynomial = vmlsq_n_f32(cosPolynomial, z, 0.5f);
+		cosPolynomial = vaddq_f32(cosPolynomial, vdupq_n_f32(1.0f));
+
+		//sinの多項式
+		float32x4_t sinPolynomial = vmlaq_f32(vdupq_n_f32(SIN_2), vdupq_n_f32(SIN_1), z);
+		sinPolynomial = vmlaq_f32(vdupq_n_f32(SIN_3), sinPolynomial, z);
+		sinPolynomial = vmlaq_f32(x, vmulq_f32(sinPolynomial, z), x);
+
+		//選ぶ
+		float32x4_t sinResult = vbslq_f32(isSinPolynomial, sinPolynomial, cosPolynomial);
+		float32x4_t cosResult = vbslq_f32(isSinPolynomial, cosPolynomial, sinPolynomial);
+		sinValue = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sinResult), sinSign));
+		cosValue = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosResult), cosSwapSign));
+#endif
+	}
+
+}
+
+#endif
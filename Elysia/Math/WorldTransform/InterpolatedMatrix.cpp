@@ -0,0 +1,111 @@
+#include "InterpolatedMatrix.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Matrix4x4Calculation.h"
+#include "QuaternionCalculation.h"
+#include "VectorCalculation.h"
+
+void Elysia::InterpolatedMatrix::Reset(const Matrix4x4& matrix) {
+	previous_ = matrix;
+	current_ = matrix;
+	isMoved_ = false;
+}
+
+void Elysia::InterpolatedMatrix::Step(const Matrix4x4& matrix, const uint64_t& stepTotalCount) {
+	previous_ = current_;
+	current_ = matrix;
+	stepTotalCount_ = stepTotalCount;
+	//動いていなければ補間しなくて良い
+	isMoved_ = std::memcmp(&previous_, &current_, sizeof(Matrix4x4)) != 0;
+}
+
+Matrix4x4 Elysia::InterpolatedMatrix::Get(const float& alpha, const uint64_t& stepTotalCount) const {
+	if (IsInterpolating(stepTotalCount) == false) {
+		return current_;
+	}
+	return Interpolate(previous_, current_, alpha);
+}
+
+Matrix4x4 Elysia::InterpolatedMatrix::Interpolate(const Matrix4x4& previous, const Matrix4x4& current, const float& alpha) {
+	if (alpha >= 1.0f) {
+		return current;
+	}
+
+	//行列のまま混ぜると回転の途中で縮むので、分けてから混ぜる
+	QuaternionTransform previousTransform = Decompose(previous);
+	QuaternionTransform currentTransform = Decompose(current);
+	Vector3 scale = VectorCalculation::Lerp(previousTransform.scale, currentTransform.scale, alpha);
+	Quaternion rotate = QuaternionCalculation::QuaternionSlerp(previousTransform.rotate, currentTransform.rotate, alpha);
+	Vector3 translate = VectorCalculation::Lerp(previousTransform.translate, currentTransform.translate, alpha);
+	return Matrix4x4Calculation::MakeQuaternionAffineMatrix(scale, rotate, translate);
+}
+
+QuaternionTransform Elysia::InterpolatedMatrix::Decompose(const Matrix4x4& matrix) {
+	//各行の長さがスケール
+	Vector3 scale = {
+		.x = std::sqrt(matrix.m[0][0] * matrix.m[0][0] + matrix.m[0][1] * matrix.m[0][1] + matrix.m[0][2] * matrix.m[0][2]),
+		.y = std::sqrt(matrix.m[1][0] * matrix.m[1][0] + matrix.m[1][1] * matrix.m[1][1] + matrix.m[1][2] * matrix.m[1][2]),
+		.z = std::sqrt(matrix.m[2][0] * matrix.m[2][0] + matrix.m[2][1] * matrix.m[2][1] + matrix.m[2][2] * matrix.m[2][2]),
+	};
+
+	//反転している場合はXのスケールを負にする
+	float determinant =
+		matrix.m[0][0] * (matrix.m[1][1] * matrix.m[2][2] - matrix.m[1][2] * matrix.m[2][1]) -
+		matrix.m[0][1] * (matrix.m[1][0] * matrix.m[2][2] - matrix.m[1][2] * matrix.m[2][0]) +
+		matrix.m[0][2] * (matrix.m[1][0] * matrix.m[2][1] - matrix.m[1][1] * matrix.m[2][0]);
+	if (determinant < 0.0f) {
+		scale.x = -scale.x;
+	}
+
+	//スケールで割って回転だけにする
+	//スケール0の軸は回転が分からないので単位行列の軸にする
+	float rotateMatrix[3][3] = {};
+	const float scales[3] = { scale.x, scale.y, scale.z };
+	for (uint32_t row = 0u; row < 3u; ++row) {
+		for (uint32_t column = 0u; column < 3u; ++column) {
+			rotateMatrix[row][column] = (scales[row] != 0.0f) ? matrix.m[row][column] / scales[row] : ((row == column) ? 1.0f : 0.0f);
+		}
+	}
+
+	//QuaternionCalculation::MakeRotateMatrixの逆
+	//対角成分の大きいものから求めて誤差を小さくする
+	Quaternion rotate = {};
+	float trace = rotateMatrix[0][0] + rotateMatrix[1][1] + rotateMatrix[2][2];
+	if (trace > 0.0f) {
+		float s = std::sqrt(trace + 1.0f) * 2.0f;
+		rotate.w = 0.25f * s;
+		rotate.x = (rotateMatrix[1][2] - rotateMatrix[2][1]) / s;
+		rotate.y = (rotateMatrix[2][0] - rotateMatrix[0][2]) / s;
+		rotate.z = (rotateMatrix[0][1] - rotateMatrix[1][0]) / s;
+	}
+	else if (rotateMatrix[0][0] > rotateMatrix[1][1] && rotateMatrix[0][0] > rotateMatrix[2][2]) {
+		float s = std::sqrt(1.0f + rotateMatrix[0][0] - rotateMatrix[1][1] - rotateMatrix[2][2]) * 2.0f;
+		rotate.w = (rotateMatrix[1][2] - rotateMatrix[2][1]) / s;
+		rotate.x = 0.25f * s;
+		rotate.y = (rotateMatrix[0][1] + rotateMatrix[1][0]) / s;
+		rotate.z = (rotateMatrix[0][2] + rotateMatrix[2][0]) / s;
+	}
+	else if (rotateMatrix[1][1] > rotateMatrix[2][2]) {
+		float s = std::sqrt(1.0f - rotateMatrix[0][0] + rotateMatrix[1][1] - rotateMatrix[2][2]) * 2.0f;
+		rotate.w = (rotateMatrix[2][0] - rotateMatrix[0][2]) / s;
+		rotate.x = (rotateMatrix[0][1] + rotateMatrix[1][0]) / s;
+		rotate.y = 0.25f * s;
+		rotate.z = (rotateMatrix[1][2] + rotateMatrix[2][1]) / s;
+	}
+	else {
+		float s = std::sqrt(1.0f - rotateMatrix[0][0] - rotateMatrix[1][1] + rotateMatrix[2][2]) * 2.0f;
+		rotate.w = (rotateMatrix[0][1] - rotateMatrix[1][0]) / s;
+		rotate.x = (rotateMatrix[0][2] + rotateMatrix[2][0]) / s;
+		rotate.y = (rotateMatrix[1][2] + rotateMatrix[2][1]) / s;
+		rotate.z = 0.25f * s;
+	}
+
+	QuaternionTransform result = {
+		.scale = scale,
+		.rotate = QuaternionCalculation::Normalize(rotate),
+		.translate = {.x = matrix.m[3][0],.y = matrix.m[3][1],.z = matrix.m[3][2] },
+	};
+	return result;
+}
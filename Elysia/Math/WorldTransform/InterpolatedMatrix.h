@@ -0,0 +1,97 @@
+#pragma once
+/**
+ * @file InterpolatedMatrix.h
+ * @brief 固定の間隔で進めた前と後の行列を補間するクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+
+#include "Matrix4x4.h"
+#include "QuaternionTransform.h"
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 固定の間隔で進めた前と後の行列を補間するクラス
+	/// ゲームの処理は固定の間隔でしか進まないので、それより速い画面ではそのまま描くと同じ状態が続いてガタつく
+	/// 前に進めた時と今の行列を持っておき、描画の時にGameClockの補間の割合で混ぜる
+	/// </summary>
+	class InterpolatedMatrix final {
+	public:
+		/// <summary>
+		/// 補間せずに置く
+		/// 初期化や瞬間移動の時に使う
+		/// </summary>
+		/// <param name="matrix">行列</param>
+		void Reset(const Matrix4x4& matrix);
+
+		/// <summary>
+		/// 固定の間隔で1回進めた
+		/// 今の行列を前の行列にして、新しい行列を今の行列にする
+		/// </summary>
+		/// <param name="matrix">進めた後の行列</param>
+		/// <param name="stepTotalCount">GameClockで進めた回数の合計</param>
+		void Step(const Matrix4x4& matrix, const uint64_t& stepTotalCount);
+
+		/// <summary>
+		/// 描画する行列を取得
+		/// </summary>
+		/// <param name="alpha">補間の割合</param>
+		/// <param name="stepTotalCount">GameClockで進めた回数の合計</param>
+		/// <returns>行列</returns>
+		Matrix4x4 Get(const float& alpha, const uint64_t& stepTotalCount) const;
+
+	public:
+		/// <summary>
+		/// 補間するかどうか
+		/// 最後に進めた時に動いていて、その後にGameClockが進んでいない時だけ補間する
+		/// 止まったものや、更新を呼ばなくなったものは今の行列をそのまま使う
+		/// </summary>
+		/// <param name="stepTotalCount">GameClockで進めた回数の合計</param>
+		/// <returns>補間するかどうか</returns>
+		inline bool IsInterpolating(const uint64_t& stepTotalCount) const {
+			return isMoved_ == true && stepTotalCount_ == stepTotalCount;
+		}
+
+		/// <summary>
+		/// 今の行列を取得
+		/// </summary>
+		/// <returns>行列</returns>
+		inline const Matrix4x4& GetCurrent() const {
+			return current_;
+		}
+
+	public:
+		/// <summary>
+		/// 2つのアフィン行列を補間する
+		/// スケールと座標は線形補間、回転は球面線形補間にして、回転が潰れないようにする
+		/// </summary>
+		/// <param name="previous">前の行列</param>
+		/// <param name="current">今の行列</param>
+		/// <param name="alpha">割合(0で前、1で今)</param>
+		/// <returns>補間した行列</returns>
+		static Matrix4x4 Interpolate(const Matrix4x4& previous, const Matrix4x4& current, const float& alpha);
+
+		/// <summary>
+		/// アフィン行列をスケール、回転、座標に分ける
+		/// </summary>
+		/// <param name="matrix">行列</param>
+		/// <returns>スケール、回転、座標</returns>
+		static QuaternionTransform Decompose(const Matrix4x4& matrix);
+
+	private:
+		//前に進めた時の行列
+		Matrix4x4 previous_ = {};
+		//今の行列
+		Matrix4x4 current_ = {};
+		//最後に進めた時のGameClockで進めた回数の合計
+		uint64_t stepTotalCount_ = 0u;
+		//最後に進めた時に動いたかどうか
+		bool isMoved_ = false;
+	};
+
+};
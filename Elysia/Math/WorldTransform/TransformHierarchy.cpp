@@ -0,0 +1,252 @@
+#include "TransformHierarchy.h"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#include "Matrix4x4Calculation.h"
+#include "BatchCalculation.h"
+
+uint32_t Elysia::TransformHierarchy::Create(const uint32_t& parent) {
+	uint32_t node = 0u;
+
+	//消したものがあれば使い回す
+	if (freeNodes_.empty() == false) {
+		node = freeNodes_.back();
+		freeNodes_.pop_back();
+		scales_[node] = { .x = 1.0f,.y = 1.0f,.z = 1.0f };
+		rotates_[node] = { .x = 0.0f,.y = 0.0f,.z = 0.0f };
+		quaternions_[node] = { .x = 0.0f,.y = 0.0f,.z = 0.0f,.w = 1.0f };
+		translates_[node] = { .x = 0.0f,.y = 0.0f,.z = 0.0f };
+		parents_[node] = NO_PARENT_;
+		flags_[node] = DIRTY_ | ALIVE_;
+		localMatrices_[node] = Matrix4x4Calculation::MakeIdentity4x4();
+		worldMatrices_[node] = Matrix4x4Calculation::MakeIdentity4x4();
+		worldInverseTransposeMatrices_[node] = Matrix4x4Calculation::MakeIdentity4x4();
+		//空いていた場所に入るので並べ直す
+		isOrderDirty_ = true;
+	}
+	else {
+		node = GetCount();
+
+		//初期値
+		scales_.push_back({ .x = 1.0f,.y = 1.0f,.z = 1.0f });
+		rotates_.push_back({ .x = 0.0f,.y = 0.0f,.z = 0.0f });
+		quaternions_.push_back({ .x = 0.0f,.y = 0.0f,.z = 0.0f,.w = 1.0f });
+		translates_.push_back({ .x = 0.0f,.y = 0.0f,.z = 0.0f });
+		parents_.push_back(NO_PARENT_);
+		flags_.push_back(DIRTY_ | ALIVE_);
+		localMatrices_.push_back(Matrix4x4Calculation::MakeIdentity4x4());
+		worldMatrices_.push_back(Matrix4x4Calculation::MakeIdentity4x4());
+		worldInverseTransposeMatrices_.push_back(Matrix4x4Calculation::MakeIdentity4x4());
+
+		//親が無いので後ろに足せば順番は保たれる
+		order_.push_back(node);
+	}
+
+	if (parent != NO_PARENT_) {
+		SetParent(node, parent);
+	}
+	return node;
+}
+
+void Elysia::TransformHierarchy::Destroy(const uint32_t& node) {
+	if (IsAlive(node) == false) {
+		return;
+	}
+
+	//子は親が無い状態にする
+	for (uint32_t child = 0u; child < GetCount(); ++child) {
+		if (parents_[child] == node) {
+			parents_[child] = NO_PARENT_;
+			flags_[child] |= DIRTY_;
+		}
+	}
+
+	parents_[node] = NO_PARENT_;
+	flags_[node] = 0u;
+	freeNodes_.push_back(node);
+	isOrderDirty_ = true;
+}
+
+void Elysia::TransformHierarchy::Clear() {
+	scales_.clear();
+	rotates_.clear();
+	quaternions_.clear();
+	translates_.clear();
+	parents_.clear();
+	flags_.clear();
+	localMatrices_.clear();
+	worldMatrices_.clear();
+	worldInverseTransposeMatrices_.clear();
+	order_.clear();
+	updatedNodes_.clear();
+	freeNodes_.clear();
+	isOrderDirty_ = false;
+}
+
+bool Elysia::TransformHierarchy::SetParent(const uint32_t& node, const uint32_t& parent) {
+	if (IsAlive(node) == false || (parent != NO_PARENT_ && IsAlive(parent) == false)) {
+		return false;
+	}
+	if (parents_[node] == parent) {
+		return true;
+	}
+
+	//親を辿って自分に着いたら循環する
+	//Releaseでも無限ループしないよう必ず確かめる
+	for (uint32_t ancestor = parent; ancestor != NO_PARENT_; ancestor = parents_[ancestor]) {
+		if (ancestor == node) {
+			return false;
+		}
+	}
+
+	parents_[node] = parent;
+	flags_[node] |= DIRTY_;
+
+	//並べ直した後は番号の大小と順番が一致しないので、親が変わったら必ず並べ直す
+	isOrderDirty_ = true;
+	return true;
+}
+
+void Elysia::TransformHierarchy::SetScale(const uint32_t& node, const Vector3& scale) {
+	Vector3& current = scales_[node];
+	if (current.x != scale.x || current.y != scale.y || current.z != scale.z) {
+		current = scale;
+		flags_[node] |= DIRTY_;
+	}
+}
+
+void Elysia::TransformHierarchy::SetRotate(const uint32_t& node, const Vector3& rotate) {
+	Vector3& current = rotates_[node];
+	if (current.x != rotate.x || current.y != rotate.y || current.z != rotate.z || (flags_[node] & USE_QUATERNION_) != 0u) {
+		current = rotate;
+		flags_[node] = static_cast<uint8_t>((flags_[node] & ~USE_QUATERNION_) | DIRTY_);
+	}
+}
+
+void Elysia::TransformHierarchy::SetQuaternion(const uint32_t& node, const Quaternion& quaternion) {
+	Quaternion& current = quaternions_[node];
+	if (current.x != quaternion.x || current.y != quaternion.y || current.z != quaternion.z || current.w != quaternion.w || (flags_[node] & USE_QUATERNION_) == 0u) {
+		current = quaternion;
+		flags_[node] |= USE_QUATERNION_ | DIRTY_;
+	}
+}
+
+void Elysia::TransformHierarchy::SetTranslate(const uint32_t& node, const Vector3& translate) {
+	Vector3& current = translates_[node];
+	if (current.x != translate.x || current.y != translate.y || current.z != translate.z) {
+		current = translate;
+		flags_[node] |= DIRTY_;
+	}
+}
+
+void Elysia::TransformHierarchy::Sort() {
+	//根からの深さを求める
+	//SetParentで循環は弾いているので必ず根に着く
+	std::vector<uint32_t> depths(GetCount(), 0u);
+	order_.clear();
+	for (uint32_t node = 0u; node < GetCount(); ++node) {
+		if ((flags_[node] & ALIVE_) == 0u) {
+			continue;
+		}
+		uint32_t depth = 0u;
+		for (uint32_t parent = parents_[node]; parent != NO_PARENT_; parent = parents_[parent]) {
+			++depth;
+		}
+		depths[node] = depth;
+		order_.push_back(node);
+	}
+
+	//浅い順に並べれば親が必ず先に来る
+	std::stable_sort(order_.begin(), order_.end(), [&depths](const uint32_t& a, const uint32_t& b) {
+		return depths[a] < depths[b];
+	});
+	isOrderDirty_ = false;
+}
+
+void Elysia::TransformHierarchy::CalculateLocalMatrices() {
+	//クォータニオンとオイラー角で計算が違うので分けてまとめる
+	for (const bool isUseQuaternion : { true, false }) {
+		batchNodes_.clear();
+		batchScales_.clear();
+		batchRotates_.clear();
+		batchQuaternions_.clear();
+		batchTranslates_.clear();
+		for (const uint32_t& node : order_) {
+			const uint8_t flag = flags_[node];
+			if ((flag & DIRTY_) == 0u || ((flag & USE_QUATERNION_) != 0u) != isUseQuaternion) {
+				continue;
+			}
+			batchNodes_.push_back(node);
+			batchScales_.push_back(scales_[node]);
+			batchTranslates_.push_back(translates_[node]);
+			if (isUseQuaternion == true) {
+				batchQuaternions_.push_back(quaternions_[node]);
+			}
+			else {
+				batchRotates_.push_back(rotates_[node]);
+			}
+		}
+		if (batchNodes_.empty() == true) {
+			continue;
+		}
+
+		//連続した配列にまとめてSIMDで計算する
+		batchResults_.resize(batchNodes_.size());
+		if (isUseQuaternion == true) {
+			BatchCalculation::MakeQuaternionAffineMany(batchScales_, batchQuaternions_, batchTranslates_, batchResults_);
+		}
+		else {
+			BatchCalculation::MakeAffineMany(batchScales_, batchRotates_, batchTranslates_, batchResults_);
+		}
+		for (size_t i = 0u; i < batchNodes_.size(); ++i) {
+			localMatrices_[batchNodes_[i]] = batchResults_[i];
+		}
+	}
+}
+
+void Elysia::TransformHierarchy::Update() {
+	if (isOrderDirty_ == true) {
+		Sort();
+	}
+
+	//変わったもののローカル行列
+	CalculateLocalMatrices();
+
+	updatedNodes_.clear();
+	for (const uint32_t& node : order_) {
+		uint8_t& flag = flags_[node];
+		const uint32_t parent = parents_[node];
+
+		//親の行列が変わったら子も作り直す
+		//親は必ず先に処理されている
+		bool isParentUpdated = (parent != NO_PARENT_) && ((flags_[parent] & UPDATED_) != 0u);
+		if ((flag & DIRTY_) == 0u && isParentUpdated == false) {
+			flag &= ~UPDATED_;
+			continue;
+		}
+
+		//親の行列を掛ける
+		Matrix4x4& worldMatrix = worldMatrices_[node];
+		worldMatrix = (parent != NO_PARENT_) ? Matrix4x4Calculation::Multiply(localMatrices_[node], worldMatrices_[parent]) : localMatrices_[node];
+		worldInverseTransposeMatrices_[node] = Matrix4x4Calculation::MakeTransposeMatrix(Matrix4x4Calculation::InverseAffine(worldMatrix));
+
+		flag = static_cast<uint8_t>((flag & ~DIRTY_) | UPDATED_);
+		updatedNodes_.push_back(node);
+	}
+}
+
+void Elysia::TransformHierarchy::WriteConstants(uint8_t* frameData)const {
+	assert(frameData != nullptr);
+
+	static const Matrix4x4 IDENTITY = Matrix4x4Calculation::MakeIdentity4x4();
+	for (const uint32_t& node : order_) {
+		ConstantData data = {
+			.world = worldMatrices_[node],
+			.normal = IDENTITY,
+			.worldInverseTranspose = worldInverseTransposeMatrices_[node],
+		};
+		std::memcpy(frameData + static_cast<size_t>(node) * CONSTANT_STRIDE_, &data, sizeof(ConstantData));
+	}
+}
@@ -0,0 +1,298 @@
+#pragma once
+/**
+ * @file TransformHierarchy.h
+ * @brief 親子関係のあるトランスフォームをまとめて更新するクラス
+ * @author 茂木翼
+ */
+
+#include <vector>
+#include <cstdint>
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include "Quaternion.h"
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 親子関係のあるトランスフォームをまとめて更新するクラス
+	/// 値は種類ごとに連続した配列で持ち、変わったものとその子だけを親から順に計算する
+	/// 定数は毎フレーム生きているもの全部をフレームごとのリングに書く
+	/// </summary>
+	class TransformHierarchy final {
+	public:
+		/// <summary>
+		/// シェーダーに送るデータ
+		/// WorldTransformと同じ並び
+		/// </summary>
+		struct ConstantData {
+			//ワールド
+			Matrix4x4 world;
+			//ノーマル
+			Matrix4x4 normal;
+			//逆転置
+			Matrix4x4 worldInverseTranspose;
+		};
+
+		//親が無い
+		static constexpr uint32_t NO_PARENT_ = UINT32_MAX;
+		//定数バッファの1つ分の間隔
+		static constexpr size_t CONSTANT_STRIDE_ = 256u;
+
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		TransformHierarchy() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~TransformHierarchy() = default;
+
+	public:
+		/// <summary>
+		/// 生成
+		/// 消したものの番号があれば使い回す
+		/// </summary>
+		/// <param name="parent">親の番号</param>
+		/// <returns>番号</returns>
+		uint32_t Create(const uint32_t& parent = NO_PARENT_);
+
+		/// <summary>
+		/// 削除
+		/// 子は親が無い状態になる
+		/// </summary>
+		/// <param name="node">番号</param>
+		void Destroy(const uint32_t& node);
+
+		/// <summary>
+		/// 全て消す
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// 更新
+		/// 変わったもののローカル行列をまとめて作り、その子孫も含めてワールド行列を作り直す
+		/// </summary>
+		void Update();
+
+		/// <summary>
+		/// 生きているもの全部を定数バッファに書き込む
+		/// 番号 * CONSTANT_STRIDE_ の位置に書く
+		/// フレームごとのリングは前のフレームの内容が残っていないので、変わっていないものも書く
+		/// </summary>
+		/// <param name="frameData">今回のフレームで確保した先頭のアドレス</param>
+		void WriteConstants(uint8_t* frameData)const;
+
+	public:
+		/// <summary>
+		/// 親の設定
+		/// 自分や自分の子孫を親にすると循環するので設定しない
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <param name="parent">親の番号</param>
+		/// <returns>設定できたかどうか</returns>
+		bool SetParent(const uint32_t& node, const uint32_t& parent);
+
+		/// <summary>
+		/// 定数バッファの先頭のGPUアドレスの設定
+		/// WriteConstantsで書いた先のアドレスを毎フレーム設定する
+		/// </summary>
+		/// <param name="address">アドレス</param>
+		inline void SetConstantBaseAddress(const uint64_t& address) {
+			constantBaseAddress_ = address;
+		}
+
+		/// <summary>
+		/// スケールの設定
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <param name="scale">スケール</param>
+		void SetScale(const uint32_t& node, const Vector3& scale);
+
+		/// <summary>
+		/// 回転の設定
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <param name="rotate">回転</param>
+		void SetRotate(const uint32_t& node, const Vector3& rotate);
+
+		/// <summary>
+		/// クォータニオンの設定
+		/// 設定するとオイラー角の代わりにこちらを使う
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <param name="quaternion">クォータニオン</param>
+		void SetQuaternion(const uint32_t& node, const Quaternion& quaternion);
+
+		/// <summary>
+		/// 座標の設定
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <param name="translate">座標</param>
+		void SetTranslate(const uint32_t& node, const Vector3& translate);
+
+	public:
+		/// <summary>
+		/// スケールを取得
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <returns>スケール</returns>
+		inline const Vector3& GetScale(const uint32_t& node)const {
+			return scales_[node];
+		}
+
+		/// <summary>
+		/// ワールド行列を取得
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <returns>ワールド行列</returns>
+		inline const Matrix4x4& GetWorldMatrix(const uint32_t& node)const {
+			return worldMatrices_[node];
+		}
+
+		/// <summary>
+		/// 逆転置行列を取得
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <returns>逆転置行列</returns>
+		inline const Matrix4x4& GetWorldInverseTransposeMatrix(const uint32_t& node)const {
+			return worldInverseTransposeMatrices_[node];
+		}
+
+		/// <summary>
+		/// ワールド座標を取得
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <returns>ワールド座標</returns>
+		inline Vector3 GetWorldPosition(const uint32_t& node)const {
+			const Matrix4x4& worldMatrix = worldMatrices_[node];
+			return { .x = worldMatrix.m[3][0],.y = worldMatrix.m[3][1],.z = worldMatrix.m[3][2] };
+		}
+
+		/// <summary>
+		/// 今回の更新で変わった番号を取得
+		/// </summary>
+		/// <returns>番号</returns>
+		inline const std::vector<uint32_t>& GetUpdatedNodes()const {
+			return updatedNodes_;
+		}
+
+		/// <summary>
+		/// 定数バッファのGPUアドレスを取得
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <returns>アドレス</returns>
+		inline uint64_t GetConstantAddress(const uint32_t& node)const {
+			return constantBaseAddress_ + static_cast<uint64_t>(node) * CONSTANT_STRIDE_;
+		}
+
+		/// <summary>
+		/// 親の番号を取得
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <returns>親の番号</returns>
+		inline uint32_t GetParent(const uint32_t& node)const {
+			return parents_[node];
+		}
+
+		/// <summary>
+		/// 生きているかどうか
+		/// </summary>
+		/// <param name="node">番号</param>
+		/// <returns>生きているかどうか</returns>
+		inline bool IsAlive(const uint32_t& node)const {
+			return node < GetCount() && (flags_[node] & ALIVE_) != 0u;
+		}
+
+		/// <summary>
+		/// 更新する順番を取得
+		/// 生きているものだけが親から順に並んでいる
+		/// </summary>
+		/// <returns>順番</returns>
+		inline const std::vector<uint32_t>& GetOrder()const {
+			return order_;
+		}
+
+		/// <summary>
+		/// 数を取得
+		/// 消したものも含むので、定数バッファはこの数だけ確保する
+		/// </summary>
+		/// <returns>数</returns>
+		inline uint32_t GetCount()const {
+			return static_cast<uint32_t>(parents_.size());
+		}
+
+	private:
+		/// <summary>
+		/// 親が必ず子より先に来るように並べ直す
+		/// 生きているものを根からの深さ順に並べる
+		/// </summary>
+		void Sort();
+
+		/// <summary>
+		/// 変わったもののローカル行列をまとめて作る
+		/// </summary>
+		void CalculateLocalMatrices();
+
+	private:
+		//状態のビット
+		//値が変わった
+		static constexpr uint8_t DIRTY_ = 1u << 0u;
+		//今回の更新で行列が変わった
+		static constexpr uint8_t UPDATED_ = 1u << 1u;
+		//クォータニオンを使う
+		static constexpr uint8_t USE_QUATERNION_ = 1u << 2u;
+		//生きている
+		static constexpr uint8_t ALIVE_ = 1u << 3u;
+
+	private:
+		//スケール
+		std::vector<Vector3> scales_;
+		//回転
+		std::vector<Vector3> rotates_;
+		//クォータニオン
+		std::vector<Quaternion> quaternions_;
+		//座標
+		std::vector<Vector3> translates_;
+		//親の番号
+		std::vector<uint32_t> parents_;
+		//状態
+		std::vector<uint8_t> flags_;
+
+		//ローカル行列
+		std::vector<Matrix4x4> localMatrices_;
+		//ワールド行列
+		std::vector<Matrix4x4> worldMatrices_;
+		//逆転置行列
+		std::vector<Matrix4x4> worldInverseTransposeMatrices_;
+
+		//更新する順番
+		std::vector<uint32_t> order_;
+		//並べ直す必要があるかどうか
+		bool isOrderDirty_ = false;
+
+		//今回の更新で変わった番号
+		std::vector<uint32_t> updatedNodes_;
+		//消したものの番号
+		std::vector<uint32_t> freeNodes_;
+
+		//まとめて計算する時の作業用
+		//毎回確保しないように持っておく
+		std::vector<uint32_t> batchNodes_;
+		std::vector<Vector3> batchScales_;
+		std::vector<Vector3> batchRotates_;
+		std::vector<Quaternion> batchQuaternions_;
+		std::vector<Vector3> batchTranslates_;
+		std::vector<Matrix4x4> batchResults_;
+
+		//定数バッファの先頭のGPUアドレス
+		uint64_t constantBaseAddress_ = 0u;
+
+	};
+
+};
@@ -3,11 +3,13 @@
 
 #include "DirectXSetup.h"
 #include "Camera.h"
-#include "Calculation/QuaternionCalculation.h"
+#include "GameClock.h"
 
 void WorldTransform::Initialize() {
 	//リソースの作成
-	resource = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(WorldTransformData)).Get();
+	//アップロード用なので中で開きっぱなしにしている
+	//毎回Map/Unmapしなくて良くなる
+	resource.Initialize(sizeof(WorldTransformData));
 
 	//初期値
 	//スケール
@@ -16,22 +18,64 @@ void WorldTransform::Initialize() {
 	rotate = { .x = 0.0f,.y = 0.0f,.z = 0.0f };
 	//座標
 	translate = { .x = 0.0f,.y = 0.0f,.z = 0.0f };
+
+	//次の更新で必ず計算する
+	isFirstUpdate_ = true;
+}
+
+bool WorldTransform::IsDirty()const {
+	//初回
+	if (isFirstUpdate_ == true) {
+		return true;
+	}
+
+	//親が変わった、または親の行列が変わった
+	if (parent != previousParent_ || (parent != nullptr && parent->GetVersion() != previousParentVersion_)) {
+		return true;
+	}
+
+	//SRTのどれかが変わった
+	if (scale.x != previousScale_.x || scale.y != previousScale_.y || scale.z != previousScale_.z ||
+		translate.x != previousTranslate_.x || translate.y != previousTranslate_.y || translate.z != previousTranslate_.z ||
+		isUseQuarternion_ != previousIsUseQuarternion_) {
+		return true;
+	}
+
+	//回転
+	if (isUseQuarternion_ == true) {
+		return quaternion_.x != previousQuaternion_.x || quaternion_.y != previousQuaternion_.y ||
+			quaternion_.z != previousQuaternion_.z || quaternion_.w != previousQuaternion_.w;
+	}
+	return rotate.x != previousRotate_.x || rotate.y != previousRotate_.y || rotate.z != previousRotate_.z;
 }
 
 
 void WorldTransform::Update() {
+	uint64_t stepTotalCount = Elysia::GameClock::GetInstance()->GetFixedStepTotalCount();
+
+	//何も変わっていなければ前回の行列がそのまま使える
+	//動かない背景などはここで終わる
+	if (IsDirty() == false) {
+		//止まったので次の描画から補間しない
+		interpolatedWorldMatrix_.Step(worldMatrix, stepTotalCount);
+		return;
+	}
+	bool isFirstUpdate = isFirstUpdate_;
+
+	//今回の値を記録
+	previousScale_ = scale;
+	previousRotate_ = rotate;
+	previousTranslate_ = translate;
+	previousQuaternion_ = quaternion_;
+	previousIsUseQuarternion_ = isUseQuarternion_;
+	previousParent_ = parent;
+	previousParentVersion_ = (parent != nullptr) ? parent->GetVersion() : 0u;
+	isFirstUpdate_ = false;
 
 	//クォータニオンを使う場合
 	if (isUseQuarternion_==true) {
-		//Scale
-		Matrix4x4 scaleMatrix = Matrix4x4Calculation::MakeScaleMatrix(scale);
-		//Rotate。行列へ変換
-		Matrix4x4 rotateMatrix = QuaternionCalculation::MakeRotateMatrix(quaternion_);
-		//Translate
-		Matrix4x4 translateMatrix = Matrix4x4Calculation::MakeTranslateMatrix(translate);
-
-		//合成
-		worldMatrix = Matrix4x4Calculation::Multiply(scaleMatrix, Matrix4x4Calculation::Multiply(rotateMatrix, translateMatrix));
+		//SRTを直接合成
+		worldMatrix = Matrix4x4Calculation::MakeQuaternionAffineMatrix(scale, quaternion_, translate);
 	}
 	//使わない場合
 	else {
@@ -42,7 +86,7 @@ void WorldTransform::Update() {
 
 	//逆転置行列
 	//ワールド行列を逆転置にする
-	Matrix4x4 worldInverseMatrix = Matrix4x4Calculation::Inverse(worldMatrix);
+	Matrix4x4 worldInverseMatrix = Matrix4x4Calculation::InverseAffine(worldMatrix);
 	
 	//転置にした
 	worldInverseTransposeMatrix = Matrix4x4Calculation::MakeTransposeMatrix(worldInverseMatrix);
@@ -52,21 +96,70 @@ void WorldTransform::Update() {
 		worldMatrix = Matrix4x4Calculation::Multiply(worldMatrix, parent->worldMatrix);
 	}
 
+	//行列が変わったことを子に伝える
+	++version_;
+
+	//描画で補間する為に前の行列と一緒に持っておく
+	//初回は前の行列が無いので補間しない
+	if (isFirstUpdate == true) {
+		interpolatedWorldMatrix_.Reset(worldMatrix);
+	}
+	else {
+		interpolatedWorldMatrix_.Step(worldMatrix, stepTotalCount);
+	}
+
 	//転送
 	Transfer();
 }
 
 
 void WorldTransform::Transfer() {
+	//Initializeで開いたままなのでそのまま書き込む
+	WriteConstants(worldMatrix, worldInverseTransposeMatrix);
+	isInterpolatedWritten_ = false;
+	interpolatedFrameCount_ = UINT64_MAX;
+}
 
-	//書き込み書き込む
-	resource->Map(0u, nullptr, reinterpret_cast<void**>(&tranceformationData));
-	//ワールド
-	tranceformationData->world = worldMatrix;
-	//ノーマル
-	tranceformationData->normal = Matrix4x4Calculation::MakeIdentity4x4();
-	//ワールド逆転置
-	tranceformationData->worldInverseTranspose = worldInverseTransposeMatrix;
-	//書き込み終了
-	resource->Unmap(0u, nullptr);
+void WorldTransform::WriteConstants(const Matrix4x4& world, const Matrix4x4& worldInverseTranspose) const {
+	WorldTransformData tranceformationData = {
+		//ワールド
+		.world = world,
+		//ノーマル
+		.normal = Matrix4x4Calculation::MakeIdentity4x4(),
+		//ワールド逆転置
+		.worldInverseTranspose = worldInverseTranspose,
+	};
+	resource.Write(tranceformationData);
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS WorldTransform::GetGPUVirtualAddress() const {
+	Elysia::GameClock* gameClock = Elysia::GameClock::GetInstance();
+	uint64_t stepTotalCount = gameClock->GetFixedStepTotalCount();
+
+	//動いていなければ更新で書いた値をそのまま使う
+	//前のフレームで補間した値が残っていたら今の値に戻す
+	if (interpolatedWorldMatrix_.IsInterpolating(stepTotalCount) == false) {
+		if (isInterpolatedWritten_ == true) {
+			WriteConstants(worldMatrix, worldInverseTransposeMatrix);
+			isInterpolatedWritten_ = false;
+			interpolatedFrameCount_ = UINT64_MAX;
+		}
+		return resource.GetGPUVirtualAddress();
+	}
+
+	//前に更新した時と今の間を描く
+	//同じフレームで何回描画しても補間は1回だけ
+	uint64_t frameCount = gameClock->GetFrameCount();
+	if (interpolatedFrameCount_ != frameCount) {
+		Matrix4x4 interpolatedWorldMatrix = interpolatedWorldMatrix_.Get(gameClock->GetInterpolationAlpha(), stepTotalCount);
+		//逆転置は親の無い時はワールド行列から作り直す
+		//親がある場合は更新と同じく自分の行列から作ったものを使う
+		Matrix4x4 interpolatedWorldInverseTransposeMatrix = (parent == nullptr) ?
+			Matrix4x4Calculation::MakeTransposeMatrix(Matrix4x4Calculation::InverseAffine(interpolatedWorldMatrix)) :
+			worldInverseTransposeMatrix;
+		WriteConstants(interpolatedWorldMatrix, interpolatedWorldInverseTransposeMatrix);
+		isInterpolatedWritten_ = true;
+		interpolatedFrameCount_ = frameCount;
+	}
+	return resource.GetGPUVirtualAddress();
 }
@@ -9,6 +9,8 @@
 #include "Vector3.h"
 #include "Quaternion.h"
 #include "DirectXSetup.h"
+#include "RingConstantBuffer.h"
+#include "InterpolatedMatrix.h"
 
 
 
@@ -24,9 +26,18 @@ public:
 
 	/// <summary>
 	/// 更新
+	/// 値も親も変わっていない場合は行列の計算と転送を省く
+	/// 固定の間隔で進める時に1回だけ呼ぶ
 	/// </summary>
 	void Update();
 
+	/// <summary>
+	/// 描画に使うGPUのアドレスを取得
+	/// 前に更新した時と今の行列をGameClockの補間の割合で混ぜてから書き込む
+	/// </summary>
+	/// <returns>アドレス</returns>
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const;
+
 	/// <summary>
 	/// ペアレントの設定
 	/// </summary>
@@ -49,6 +60,15 @@ public:
 		return position;
 	}
 
+	/// <summary>
+	/// 版数を取得
+	/// ワールド行列が変わる度に増える。子が親の変化を知るのに使う
+	/// </summary>
+	/// <returns>版数</returns>
+	inline uint64_t GetVersion()const {
+		return version_;
+	}
+
 
 private:
 	/// <summary>
@@ -56,6 +76,19 @@ private:
 	/// </summary>
 	void Transfer();
 
+	/// <summary>
+	/// 定数バッファに書き込む
+	/// </summary>
+	/// <param name="world">ワールド行列</param>
+	/// <param name="worldInverseTranspose">逆転置行列</param>
+	void WriteConstants(const Matrix4x4& world, const Matrix4x4& worldInverseTranspose) const;
+
+	/// <summary>
+	/// 前回の更新から変わったかどうか
+	/// </summary>
+	/// <returns>変わったかどうか</returns>
+	bool IsDirty()const;
+
 private:
 	/// <summary>
 	/// シェーダーに送るデータ
@@ -86,9 +119,9 @@ public:
 
 
 	//定数バッファ
-	ComPtr<ID3D12Resource> resource = nullptr;
-	//送るデータ
-	WorldTransformData* tranceformationData = nullptr;
+	//GPUが前のフレームを読んでいる間に書き換えないようフレームごとに持つ
+	//描画の時に補間した値を書き込むのでconstでも書き換えられるようにする
+	mutable Elysia::RingConstantBuffer resource = {};
 
 	//ワールド行列
 	Matrix4x4 worldMatrix = {};
@@ -98,6 +131,29 @@ public:
 	//親となるワールド変換へのポインタ
 	const WorldTransform* parent = nullptr;
 
+private:
+	//前回の更新で使った値
+	//変わっていなければ再計算しない
+	Vector3 previousScale_ = {};
+	Vector3 previousRotate_ = {};
+	Vector3 previousTranslate_ = {};
+	Quaternion previousQuaternion_ = {};
+	bool previousIsUseQuarternion_ = false;
+	const WorldTransform* previousParent_ = nullptr;
+	//前回の更新で見た親の版数
+	uint64_t previousParentVersion_ = 0u;
+	//まだ一度も更新していないかどうか
+	bool isFirstUpdate_ = true;
+	//版数
+	uint64_t version_ = 0u;
+
+	//前に更新した時と今のワールド行列
+	Elysia::InterpolatedMatrix interpolatedWorldMatrix_ = {};
+	//補間した値を書き込んだフレーム
+	mutable uint64_t interpolatedFrameCount_ = UINT64_MAX;
+	//定数バッファに補間した値が入っているかどうか
+	mutable bool isInterpolatedWritten_ = false;
+
 
 };
 
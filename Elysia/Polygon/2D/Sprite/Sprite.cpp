@@ -4,6 +4,8 @@
 #include "WindowsSetup.h"
 #include "TextureManager.h"
 #include "PipelineManager.h"
+#include "ConstantBufferManager.h"
+#include "SpriteBatch.h"
 #include "Matrix4x4.h"
 #include "Matrix4x4Calculation.h"
 
@@ -15,9 +17,16 @@ Elysia::Sprite::Sprite() {
 
 	//パイプライン管理クラスを取得
 	pipelineManager_ = Elysia::PipelineManager::GetInstance();
+	//定数バッファ管理クラスを取得
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 
 }
 
+Elysia::Sprite::~Sprite() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(indexResource_));
+}
+
 
 void Elysia::Sprite::Initialize(const uint32_t& textureHandle, const Vector2& position) {
 	this->textureHandle_ = textureHandle;
@@ -29,14 +38,11 @@ void Elysia::Sprite::Initialize(const uint32_t& textureHandle, const Vector2& po
 	size_ = {.x = static_cast<float>(resourceDesc_.Width),.y = static_cast<float>(resourceDesc_.Height) };
 
 
-	//頂点リソースを作る
-	vertexResource_ = directXSetup_->CreateBufferResource(sizeof(VertexData) * 6);
 	//index用のリソースを作る
 	indexResource_ = directXSetup_->CreateBufferResource(sizeof(uint32_t) * 6);
 	
 	//頂点バッファビューを作成する
-	//リソースの先頭のアドレスから使う
-	vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
+	//場所は描画ごとにフレームごとの定数バッファから確保する
 	//使用するリソースのサイズは頂点３つ分のサイズ
 	vertexBufferView_.SizeInBytes = sizeof(VertexData) * 4;
 	//１頂点あたりのサイズ
@@ -51,12 +57,20 @@ void Elysia::Sprite::Initialize(const uint32_t& textureHandle, const Vector2& po
 	//インデックスはuint32_tとする
 	indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
 
+	//IndexResourceにデータを書き込む
+	//変わらないので最初に1回だけ書き込む
+	uint32_t* indexData = nullptr;
+	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&indexData));
+	indexData[0] = 0u;
+	indexData[1] = 1u;
+	indexData[2] = 2u;
+	indexData[3] = 1u;
+	indexData[4] = 3u;
+	indexData[5] = 2u;
+	indexResource_->Unmap(0u, nullptr);
+
 
 
-	//マテリアル用のリソースを作る。今回はcolor1つ分のサイズを用意する
-	materialResource_ = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(MaterialData));
-	//TransformationMatrix用のリソースを作る。
-	transformationMatrixResource_ = Elysia::DirectXSetup::GetInstance()->CreateBufferResource(sizeof(TransformationMatrix));
 
 
 	//UVトランスフォームの初期化
@@ -86,6 +100,21 @@ Elysia::Sprite* Elysia::Sprite::Create(const uint32_t& textureHandle, const Vect
 	return sprite;
 
 }
+Elysia::Sprite* Elysia::Sprite::Create(const TextureRegion& textureRegion, const Vector2& position) {
+	//生成
+	Elysia::Sprite* sprite = new Elysia::Sprite();
+
+	//初期化
+	//サイズはアトラスではなく元の画像の大きさにする
+	sprite->Initialize(textureRegion.textureHandle, position);
+	sprite->size_ = textureRegion.size;
+	sprite->regionLeftTop_ = textureRegion.texLeftTop;
+	sprite->regionRightBottom_ = textureRegion.texRightBottom;
+
+	//返す
+	return sprite;
+}
+
 //描画
 void Elysia::Sprite::Draw() {
 
@@ -99,6 +128,12 @@ void Elysia::Sprite::Draw() {
 	if (color_.w <= 0.0f) {
 		return;
 	}
+
+	//まとめて描画している時は溜めるだけ
+	if (SpriteBatch::GetInstance()->GetIsInBatch() == true) {
+		SpriteBatch::GetInstance()->Add(MakeSpriteQuad(textureHandle_));
+		return;
+	}
 	
 
 	//TextureCoordinate(テクスチャ座標系)
@@ -123,7 +158,9 @@ void Elysia::Sprite::Draw() {
 
 
 	//書き込むためのアドレスを取得
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData_));
+	//描画ごとに変わるのでフレームごとの定数バッファから確保する
+	ConstantBufferAllocation vertexAllocation = constantBufferManager_->Allocate(sizeof(VertexData) * 4);
+	VertexData* vertexData = static_cast<VertexData*>(vertexAllocation.cpuAddress);
 
 	float left = (0.0f-anchorPoint_.x) * size_.x;
 	float right = (1.0f-anchorPoint_.x) * size_.x;
@@ -148,6 +185,14 @@ void Elysia::Sprite::Draw() {
 
 
 
+	//アトラスの中の範囲に合わせる
+	Vector2 texLeftTop = ToRegionTexCoord({ .x = texLeft,.y = texTop });
+	Vector2 texRightBottom = ToRegionTexCoord({ .x = texRight,.y = texBottom });
+	texLeft = texLeftTop.x;
+	texTop = texLeftTop.y;
+	texRight = texRightBottom.x;
+	texBottom = texRightBottom.y;
+
 	//左右反転
 	if (isFlipX_ == true) {
 		left = -left;
@@ -160,32 +205,23 @@ void Elysia::Sprite::Draw() {
 	}
 
 	//左下
-	vertexData_[LeftBottom].position = {left,bottom,0.0f,1.0f};
-	vertexData_[LeftBottom].texCoord = { texLeft,texBottom };
+	vertexData[LeftBottom].position = {left,bottom,0.0f,1.0f};
+	vertexData[LeftBottom].texCoord = { texLeft,texBottom };
 	//左上
-	vertexData_[LeftTop].position = {left,top,0.0f,1.0f};
-	vertexData_[LeftTop].texCoord = { texLeft,texTop };
+	vertexData[LeftTop].position = {left,top,0.0f,1.0f};
+	vertexData[LeftTop].texCoord = { texLeft,texTop };
 	//右下
-	vertexData_[RightBottom].position = {right,bottom,0.0f,1.0f} ;
-	vertexData_[RightBottom].texCoord = { texRight,texBottom };
+	vertexData[RightBottom].position = {right,bottom,0.0f,1.0f} ;
+	vertexData[RightBottom].texCoord = { texRight,texBottom };
 	//右上
-	vertexData_[RightTop].position = { right,top,0.0f,1.0f };
-	vertexData_[RightTop].texCoord = { texRight,texTop };
-	vertexResource_->Unmap(0u, nullptr);
+	vertexData[RightTop].position = { right,top,0.0f,1.0f };
+	vertexData[RightTop].texCoord = { texRight,texTop };
+	vertexBufferView_.BufferLocation = vertexAllocation.gpuAddress;
 
-	//IndexResourceにデータを書き込む
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&indexData_));
-	indexData_[0] = 0u;
-	indexData_[1] = 1u;
-	indexData_[2] = 2u;
-	indexData_[3] = 1u;
-	indexData_[4] = 3u;
-	indexData_[5] = 2u;
-	indexResource_->Unmap(0u, nullptr);
 
 
 	//トランスフォームデータに書き込み
-	transformationMatrixResource_->Map(0u, nullptr, reinterpret_cast<void**>(&transformationMatrixData_));
+	TransformationMatrix transformationMatrixData = {};
 	
 	//座標の再設定
 	Vector3 newPosition = {};
@@ -206,54 +242,34 @@ void Elysia::Sprite::Draw() {
 	
 	//WVP行列を作成
 	Matrix4x4 worldViewProjectionMatrixSprite = Matrix4x4Calculation::Multiply(affineMatrix, Matrix4x4Calculation::Multiply(viewMatrix, projectionMatrix));
-	transformationMatrixData_->WVP = worldViewProjectionMatrixSprite;
-	transformationMatrixData_->World = Matrix4x4Calculation::MakeIdentity4x4();
+	transformationMatrixData.WVP = worldViewProjectionMatrixSprite;
+	transformationMatrixData.World = Matrix4x4Calculation::MakeIdentity4x4();
 
-	transformationMatrixResource_->Unmap(0u, nullptr);
+	D3D12_GPU_VIRTUAL_ADDRESS transformationMatrixAddress = constantBufferManager_->Push(transformationMatrixData);
 
 
 	//マテリアルにデータを書き込む
-	//書き込むためのアドレスを取得
-	//reinterpret_cast...char* から int* へ、One_class* から Unrelated_class* へなどの変換に使用
-	materialResource_->Map(0u, nullptr, reinterpret_cast<void**>(&materialData_));
-	materialData_->color = color_;
+	MaterialData materialData = {};
+	materialData.color = color_;
 	//ライティングしない
-	materialData_->lightingKinds = NoneLighting;
-	materialData_->shininess = 0.0f;
+	materialData.lightingKinds = NoneLighting;
+	materialData.shininess = 0.0f;
 
 	Matrix4x4 uvTransformMatrix = Matrix4x4Calculation::MakeScaleMatrix(uvTransform_.scale);
 	uvTransformMatrix = Matrix4x4Calculation::Multiply(uvTransformMatrix, Matrix4x4Calculation::MakeRotateZMatrix(uvTransform_.rotate.z));
 	uvTransformMatrix = Matrix4x4Calculation::Multiply(uvTransformMatrix, Matrix4x4Calculation::MakeTranslateMatrix(uvTransform_.translate));
-	materialData_->uvTransform = uvTransformMatrix;
-	materialResource_->Unmap(0u, nullptr);
+	materialData.uvTransform = uvTransformMatrix;
+	D3D12_GPU_VIRTUAL_ADDRESS materialAddress = constantBufferManager_->Push(materialData);
 
 
-	//コマンドを積む
-	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetSpriteRootSignature().Get());
-	directXSetup_->GetCommandList()->SetPipelineState(pipelineManager_->GetSpriteGraphicsPipelineState().Get());
-
-
-	//RootSignatureを設定。PSOに設定しているけど別途設定が必要
-	directXSetup_->GetCommandList()->IASetVertexBuffers(0u, 1u, &vertexBufferView_);
-	//IBVを設定
-	directXSetup_->GetCommandList()->IASetIndexBuffer(&indexBufferView_);
-	
-	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
-	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	
-	//CBVを設定する
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, materialResource_->GetGPUVirtualAddress());
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, transformationMatrixResource_->GetGPUVirtualAddress());
-	
-	
-	if (textureHandle_ != 0u) {
-		Elysia::TextureManager::GetInstance()->GraphicsCommand(2u,textureHandle_);
-
-	}
-	
-	//今度はこっちでドローコールをするよ
-	//描画(DrawCall)6個のインデックスを使用し1つのインスタンスを描画。
-	directXSetup_->GetCommandList()->DrawIndexedInstanced(6u, 1u, 0u, 0u, 0u);
+	//描画を出す
+	DrawCommand drawCommand = {
+		.vertexBufferView = vertexBufferView_,
+		.materialAddress = materialAddress,
+		.transformationMatrixAddress = transformationMatrixAddress,
+		.textureHandle = textureHandle_,
+	};
+	SubmitDrawCommand(drawCommand);
 
 
 }
@@ -270,6 +286,12 @@ void Elysia::Sprite::Draw(const uint32_t& texturehandle){
 		return;
 	}
 
+	//まとめて描画している時は溜めるだけ
+	if (SpriteBatch::GetInstance()->GetIsInBatch() == true) {
+		SpriteBatch::GetInstance()->Add(MakeSpriteQuad(texturehandle));
+		return;
+	}
+
 
 	//TextureCoordinate(テクスチャ座標系)
 	//TexCoord,UV座標系とも呼ばれている
@@ -293,7 +315,9 @@ void Elysia::Sprite::Draw(const uint32_t& texturehandle){
 
 
 	//書き込むためのアドレスを取得
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData_));
+	//描画ごとに変わるのでフレームごとの定数バッファから確保する
+	ConstantBufferAllocation vertexAllocation = constantBufferManager_->Allocate(sizeof(VertexData) * 4);
+	VertexData* vertexData = static_cast<VertexData*>(vertexAllocation.cpuAddress);
 
 	float left = (0.0f - anchorPoint_.x) * size_.x;
 	float right = (1.0f - anchorPoint_.x) * size_.x;
@@ -318,6 +342,14 @@ void Elysia::Sprite::Draw(const uint32_t& texturehandle){
 
 
 
+	//アトラスの中の範囲に合わせる
+	Vector2 texLeftTop = ToRegionTexCoord({ .x = texLeft,.y = texTop });
+	Vector2 texRightBottom = ToRegionTexCoord({ .x = texRight,.y = texBottom });
+	texLeft = texLeftTop.x;
+	texTop = texLeftTop.y;
+	texRight = texRightBottom.x;
+	texBottom = texRightBottom.y;
+
 	//左右反転
 	if (isFlipX_ == true) {
 		left = -left;
@@ -331,35 +363,25 @@ void Elysia::Sprite::Draw(const uint32_t& texturehandle){
 
 
 	//左下
-	vertexData_[LeftBottom].position = { left,bottom,0.0f,1.0f };
-	vertexData_[LeftBottom].texCoord = { texLeft,texBottom };
+	vertexData[LeftBottom].position = { left,bottom,0.0f,1.0f };
+	vertexData[LeftBottom].texCoord = { texLeft,texBottom };
 	//左上
-	vertexData_[LeftTop].position = { left,top,0.0f,1.0f };
-	vertexData_[LeftTop].texCoord = { texLeft,texTop };
+	vertexData[LeftTop].position = { left,top,0.0f,1.0f };
+	vertexData[LeftTop].texCoord = { texLeft,texTop };
 	//右下
-	vertexData_[RightBottom].position = { right,bottom,0.0f,1.0f };
-	vertexData_[RightBottom].texCoord = { texRight,texBottom };
+	vertexData[RightBottom].position = { right,bottom,0.0f,1.0f };
+	vertexData[RightBottom].texCoord = { texRight,texBottom };
 	//右上
-	vertexData_[RightTop].position = { right,top,0.0f,1.0f };
-	vertexData_[RightTop].texCoord = { texRight,texTop };
-	vertexResource_->Unmap(0u, nullptr);
+	vertexData[RightTop].position = { right,top,0.0f,1.0f };
+	vertexData[RightTop].texCoord = { texRight,texTop };
+	vertexBufferView_.BufferLocation = vertexAllocation.gpuAddress;
 
 
-	//IndexResourceにデータを書き込む
-	//インデックスデータにデータを書き込む
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&indexData_));
-	indexData_[0] = 0u;
-	indexData_[1] = 1u;
-	indexData_[2] = 2u;
-	indexData_[3] = 1u;
-	indexData_[4] = 3u;
-	indexData_[5] = 2u;
-	indexResource_->Unmap(0u, nullptr);
 
 
 
 	//トランスフォームデータに書き込み
-	transformationMatrixResource_->Map(0u, nullptr, reinterpret_cast<void**>(&transformationMatrixData_));
+	TransformationMatrix transformationMatrixData = {};
 
 	//座標の再設定
 	Vector3 newPosition = {};
@@ -381,53 +403,116 @@ void Elysia::Sprite::Draw(const uint32_t& texturehandle){
 	//WVP行列を作成
 	Matrix4x4 worldViewProjectionMatrixSprite = Matrix4x4Calculation::Multiply(affineMatrix, Matrix4x4Calculation::Multiply(viewMatrix, projectionMatrix));
 
-	transformationMatrixData_->WVP = worldViewProjectionMatrixSprite;
-	transformationMatrixData_->World = Matrix4x4Calculation::MakeIdentity4x4();
+	transformationMatrixData.WVP = worldViewProjectionMatrixSprite;
+	transformationMatrixData.World = Matrix4x4Calculation::MakeIdentity4x4();
 
-	transformationMatrixResource_->Unmap(0u, nullptr);
+	D3D12_GPU_VIRTUAL_ADDRESS transformationMatrixAddress = constantBufferManager_->Push(transformationMatrixData);
 
 
 	//マテリアルにデータを書き込む
-	//書き込むためのアドレスを取得
-	//reinterpret_cast...char* から int* へ、One_class* から Unrelated_class* へなどの変換に使用
-	materialResource_->Map(0u, nullptr, reinterpret_cast<void**>(&materialData_));
-	materialData_->color = color_;
+	MaterialData materialData = {};
+	materialData.color = color_;
 	//ライティングしない
-	materialData_->lightingKinds = NoneLighting;
-	materialData_->shininess = 0.0f;
+	materialData.lightingKinds = NoneLighting;
+	materialData.shininess = 0.0f;
 
 	Matrix4x4 uvTransformMatrix = Matrix4x4Calculation::MakeScaleMatrix(uvTransform_.scale);
 	uvTransformMatrix = Matrix4x4Calculation::Multiply(uvTransformMatrix, Matrix4x4Calculation::MakeRotateZMatrix(uvTransform_.rotate.z));
 	uvTransformMatrix = Matrix4x4Calculation::Multiply(uvTransformMatrix, Matrix4x4Calculation::MakeTranslateMatrix(uvTransform_.translate));
-	materialData_->uvTransform = uvTransformMatrix;
-	materialResource_->Unmap(0u, nullptr);
+	materialData.uvTransform = uvTransformMatrix;
+	D3D12_GPU_VIRTUAL_ADDRESS materialAddress = constantBufferManager_->Push(materialData);
+
+	//描画を出す
+	DrawCommand drawCommand = {
+		.vertexBufferView = vertexBufferView_,
+		.materialAddress = materialAddress,
+		.transformationMatrixAddress = transformationMatrixAddress,
+		.textureHandle = texturehandle,
+	};
+	SubmitDrawCommand(drawCommand);
 
-	//コマンドを積む
-	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetSpriteRootSignature().Get());
-	directXSetup_->GetCommandList()->SetPipelineState(pipelineManager_->GetSpriteGraphicsPipelineState().Get());
 
+}
+
+Vector2 Elysia::Sprite::ToRegionTexCoord(const Vector2& texCoord) const {
+	return {
+		.x = regionLeftTop_.x + texCoord.x * (regionRightBottom_.x - regionLeftTop_.x),
+		.y = regionLeftTop_.y + texCoord.y * (regionRightBottom_.y - regionLeftTop_.y),
+	};
+}
+
+Elysia::SpriteQuad Elysia::Sprite::MakeSpriteQuad(const uint32_t& textureHandle) const {
+	//テクスチャの範囲はDrawと同じ計算
+	Vector2 texLeftTop = { .x = 0.0f,.y = 0.0f };
+	Vector2 texRightBottom = { .x = 1.0f,.y = 1.0f };
+	if (isUVSetting_ == true) {
+		texLeftTop = { .x = textureLeftTop_.x / size_.x,.y = textureLeftTop_.y / size_.y };
+		texRightBottom = { .x = (textureLeftTop_.x + textureSize_.x) / size_.x,.y = (textureLeftTop_.y + textureSize_.y) / size_.y };
+	}
+
+	//アトラスの中の範囲に合わせる
+	texLeftTop = ToRegionTexCoord(texLeftTop);
+	texRightBottom = ToRegionTexCoord(texRightBottom);
+
+	SpriteQuad quad = {
+		.position = position_,
+		.size = size_,
+		.scale = scale_,
+		.rotate = rotate_,
+		.anchorPoint = anchorPoint_,
+		.isFlipX = isFlipX_,
+		.isFlipY = isFlipY_,
+		.depth = (isBack_ == true) ? 1.0f : 0.0f,
+		.texLeftTop = texLeftTop,
+		.texRightBottom = texRightBottom,
+		.uvScale = {.x = uvTransform_.scale.x,.y = uvTransform_.scale.y },
+		.uvRotate = uvTransform_.rotate.z,
+		.uvTranslate = {.x = uvTransform_.translate.x,.y = uvTransform_.translate.y },
+		.color = color_,
+		.textureHandle = textureHandle,
+		.blendMode = blendMode_,
+	};
+	return quad;
+}
+
+void Elysia::Sprite::SubmitDrawCommand(const DrawCommand& drawCommand) {
+	//パスの途中であれば後で他のスレッドで積む
+	ParallelCommandRecorder* parallelCommandRecorder = directXSetup_->GetParallelCommandRecorder();
+	if (parallelCommandRecorder->GetIsInPass() == true) {
+		parallelCommandRecorder->Push([this, drawCommand]() {
+			RecordDrawCommand(drawCommand);
+		});
+		return;
+	}
+
+	RecordDrawCommand(drawCommand);
+}
+
+void Elysia::Sprite::RecordDrawCommand(const DrawCommand& drawCommand) const {
+	//記録するスレッドのコマンドリスト
+	ComPtr<ID3D12GraphicsCommandList> commandList = directXSetup_->GetCommandList();
+
+	//コマンドを積む
+	commandList->SetGraphicsRootSignature(pipelineManager_->GetSpriteRootSignature().Get());
+	commandList->SetPipelineState(pipelineManager_->GetSpriteGraphicsPipelineState().Get());
 
 	//RootSignatureを設定。PSOに設定しているけど別途設定が必要
-	directXSetup_->GetCommandList()->IASetVertexBuffers(0u, 1u, &vertexBufferView_);
+	commandList->IASetVertexBuffers(0u, 1u, &drawCommand.vertexBufferView);
 	//IBVを設定
-	directXSetup_->GetCommandList()->IASetIndexBuffer(&indexBufferView_);
+	commandList->IASetIndexBuffer(&indexBufferView_);
 
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
-	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	//CBVを設定する
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, materialResource_->GetGPUVirtualAddress());
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, transformationMatrixResource_->GetGPUVirtualAddress());
-
-
-	if (texturehandle != 0u) {
-		Elysia::TextureManager::GetInstance()->GraphicsCommand(2u, texturehandle);
+	commandList->SetGraphicsRootConstantBufferView(0u, drawCommand.materialAddress);
+	commandList->SetGraphicsRootConstantBufferView(1u, drawCommand.transformationMatrixAddress);
 
+	if (drawCommand.textureHandle != 0u) {
+		Elysia::TextureManager::GetInstance()->GraphicsCommand(2u, drawCommand.textureHandle);
 	}
 
 	//今度はこっちでドローコールをするよ
 	//描画(DrawCall)6個のインデックスを使用し1つのインスタンスを描画。
-	directXSetup_->GetCommandList()->DrawIndexedInstanced(6u, 1u, 0u, 0u, 0u);
-
-
+	commandList->DrawIndexedInstanced(6u, 1u, 0u, 0u, 0u);
 }
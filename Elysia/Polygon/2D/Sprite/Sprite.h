@@ -16,6 +16,9 @@
 #include "VertexData.h"
 #include "Material.h"
 #include "TransformationMatrix.h"
+#include "BlendMode.h"
+#include "SpriteBatchBuilder.h"
+#include "TextureRegion.h"
 
 /// <summary>
 /// ElysiaEngine
@@ -36,6 +39,11 @@ namespace Elysia {
 	/// </summary>
 	class PipelineManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 	/// <summary>
 	/// スプライト
 	/// </summary>
@@ -55,6 +63,15 @@ namespace Elysia {
 		/// <returns>スプライト</returns>
 		static Sprite* Create(const uint32_t& textureHandle, const Vector2& position);
 
+		/// <summary>
+		/// 生成
+		/// アトラスにまとめた画像を元の1枚と同じように使う
+		/// </summary>
+		/// <param name="textureRegion">アトラスの中の範囲</param>
+		/// <param name="position">座標</param>
+		/// <returns>スプライト</returns>
+		static Sprite* Create(const TextureRegion& textureRegion, const Vector2& position);
+
 		/// <summary>
 		/// 描画
 		/// </summary>
@@ -69,7 +86,7 @@ namespace Elysia {
 		/// <summary>
 		/// デストラクタ
 		/// </summary>
-		~Sprite() = default;
+		~Sprite();
 
 	public:
 		/// <summary>
@@ -193,6 +210,15 @@ namespace Elysia {
 			this->isUVSetting_ = isUVMode;
 		}
 
+		/// <summary>
+		/// ブレンドモードの設定
+		/// まとめて描画している時だけ使われる
+		/// </summary>
+		/// <param name="blendMode">ブレンドモード</param>
+		inline void SetBlendMode(const uint32_t& blendMode) {
+			this->blendMode_ = blendMode;
+		}
+
 	private:
 		/// <summary>
 		/// 初期化
@@ -201,6 +227,48 @@ namespace Elysia {
 		/// <param name="position">座標</param>
 		void Initialize(const uint32_t& textureHandle, const Vector2& position);
 
+		/// <summary>
+		/// UVをアトラスの中の範囲に合わせる
+		/// </summary>
+		/// <param name="texCoord">画像の中のUV</param>
+		/// <returns>アトラスのUV</returns>
+		Vector2 ToRegionTexCoord(const Vector2& texCoord) const;
+
+		/// <summary>
+		/// まとめて描画する時のスプライト1枚分を作る
+		/// </summary>
+		/// <param name="textureHandle">ハンドル</param>
+		/// <returns>スプライト1枚分</returns>
+		SpriteQuad MakeSpriteQuad(const uint32_t& textureHandle) const;
+
+		/// <summary>
+		/// 描画に使うもの
+		/// メインスレッドで集めて、コマンドはどのスレッドからでも積めるようにする
+		/// </summary>
+		struct DrawCommand {
+			//頂点のバッファビュー
+			D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
+			//マテリアル
+			D3D12_GPU_VIRTUAL_ADDRESS materialAddress;
+			//TransformationMatrix
+			D3D12_GPU_VIRTUAL_ADDRESS transformationMatrixAddress;
+			//テクスチャ
+			uint32_t textureHandle;
+		};
+
+		/// <summary>
+		/// 描画を出す
+		/// パスの途中であれば並列記録に回す
+		/// </summary>
+		/// <param name="drawCommand">描画に使うもの</param>
+		void SubmitDrawCommand(const DrawCommand& drawCommand);
+
+		/// <summary>
+		/// コマンドを積む
+		/// </summary>
+		/// <param name="drawCommand">描画に使うもの</param>
+		void RecordDrawCommand(const DrawCommand& drawCommand) const;
+
 
 	private:
 		//ウィンドウクラス
@@ -209,35 +277,20 @@ namespace Elysia {
 		Elysia::DirectXSetup* directXSetup_ = nullptr;
 		//パイプライン管理クラス
 		Elysia::PipelineManager* pipelineManager_ = nullptr;
+		//定数バッファ管理クラス
+		Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 
 	private:
 
 		//頂点
-		//リソース
-		ComPtr<ID3D12Resource> vertexResource_ = nullptr;
-		//データ
-		VertexData* vertexData_ = nullptr;
+		//頂点とマテリアル、TransformationMatrixは描画ごとにフレームごとの定数バッファから確保する
 		//バッファビュー
 		D3D12_VERTEX_BUFFER_VIEW vertexBufferView_ = {};
 
-		//マテリアル
-		//リソース
-		ComPtr<ID3D12Resource> materialResource_ = nullptr;
-		//データ
-		MaterialData* materialData_ = nullptr;
-
-		//TransformationMatrix
-		//リソース
-		ComPtr<ID3D12Resource> transformationMatrixResource_ = nullptr;
-		//データ
-		TransformationMatrix* transformationMatrixData_ = nullptr;
-
 		//Index用
 		ComPtr<ID3D12Resource> indexResource_ = nullptr;
 		//バッファビュー
 		D3D12_INDEX_BUFFER_VIEW indexBufferView_ = {};
-		//インデックスデータ
-		uint32_t* indexData_ = nullptr;
 
 	private:
 
@@ -297,6 +350,14 @@ namespace Elysia {
 		//テクスチャハンドル
 		uint32_t textureHandle_ = 0u;
 
+		//ブレンドモード
+		uint32_t blendMode_ = BlendModeNormal;
+
+		//アトラスの中の範囲(UV)
+		//アトラスでなければテクスチャ全体
+		Vector2 regionLeftTop_ = { .x = 0.0f,.y = 0.0f };
+		Vector2 regionRightBottom_ = { .x = 1.0f,.y = 1.0f };
+
 	};
 }
 
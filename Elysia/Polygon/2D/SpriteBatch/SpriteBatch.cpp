@@ -0,0 +1,151 @@
+#include "SpriteBatch.h"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include "WindowsSetup.h"
+#include "PipelineManager.h"
+#include "ConstantBufferManager.h"
+#include "TextureManager.h"
+
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
+
+Elysia::SpriteBatch* Elysia::SpriteBatch::GetInstance() {
+	static SpriteBatch instance;
+	return &instance;
+}
+
+void Elysia::SpriteBatch::Initialize() {
+	//DirectXクラス
+	directXSetup_ = DirectXSetup::GetInstance();
+	//パイプライン管理クラス
+	pipelineManager_ = PipelineManager::GetInstance();
+	//定数バッファ管理クラス
+	constantBufferManager_ = ConstantBufferManager::GetInstance();
+
+	//インデックスを作る
+	//Spriteと同じく1枚あたり0,1,2,1,3,2
+	const uint32_t INDEX_COUNT = MAX_QUAD_COUNT_ * SpriteBatchBuilder::INDEX_COUNT_PER_QUAD_;
+	indexResource_ = directXSetup_->CreateBufferResource(sizeof(uint32_t) * INDEX_COUNT);
+	indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
+	indexBufferView_.SizeInBytes = sizeof(uint32_t) * INDEX_COUNT;
+	indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+
+	//変わらないので最初に1回だけ書き込む
+	uint32_t* indexData = nullptr;
+	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&indexData));
+	for (uint32_t i = 0u; i < MAX_QUAD_COUNT_; ++i) {
+		uint32_t firstVertex = i * SpriteBatchBuilder::VERTEX_COUNT_PER_QUAD_;
+		uint32_t* quadIndex = indexData + i * SpriteBatchBuilder::INDEX_COUNT_PER_QUAD_;
+		quadIndex[0] = firstVertex + 0u;
+		quadIndex[1] = firstVertex + 1u;
+		quadIndex[2] = firstVertex + 2u;
+		quadIndex[3] = firstVertex + 1u;
+		quadIndex[4] = firstVertex + 3u;
+		quadIndex[5] = firstVertex + 2u;
+	}
+	indexResource_->Unmap(0u, nullptr);
+}
+
+void Elysia::SpriteBatch::Begin() {
+	assert(isInBatch_ == false);
+
+	isInBatch_ = true;
+	builder_.Reset();
+	previousStatistics_ = statistics_;
+	statistics_ = {};
+}
+
+void Elysia::SpriteBatch::Add(const SpriteQuad& quad) {
+	assert(isInBatch_ == true);
+
+	//入りきらない時はそこまでを先に描画する
+	if (builder_.GetQuadCount() >= MAX_QUAD_COUNT_) {
+		Flush();
+	}
+	builder_.Add(quad);
+}
+
+void Elysia::SpriteBatch::Flush() {
+	if (builder_.GetQuadCount() == 0u) {
+		return;
+	}
+
+	//頂点とグループを作る
+	WindowsSetup* windowsSetup = WindowsSetup::GetInstance();
+	builder_.Build(float(windowsSetup->GetClientWidth()), float(windowsSetup->GetClientHeight()));
+	const std::vector<SpriteBatchVertex>& vertices = builder_.GetVertices();
+	const std::vector<SpriteBatchGroup>& groups = builder_.GetGroups();
+
+	//フレームごとの定数バッファに頂点を書き込む
+	size_t vertexSize = sizeof(SpriteBatchVertex) * vertices.size();
+	ConstantBufferAllocation vertexAllocation = constantBufferManager_->Allocate(vertexSize);
+	std::memcpy(vertexAllocation.cpuAddress, vertices.data(), vertexSize);
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView = {
+		.BufferLocation = vertexAllocation.gpuAddress,
+		.SizeInBytes = static_cast<UINT>(vertexSize),
+		.StrideInBytes = sizeof(SpriteBatchVertex),
+	};
+
+	//パスの途中であれば後で他のスレッドで積む
+	ParallelCommandRecorder* parallelCommandRecorder = directXSetup_->GetParallelCommandRecorder();
+	if (parallelCommandRecorder->GetIsInPass() == true) {
+		parallelCommandRecorder->Push([this, vertexBufferView, groups]() {
+			RecordDrawCommand(vertexBufferView, groups);
+		});
+	}
+	else {
+		RecordDrawCommand(vertexBufferView, groups);
+	}
+
+	statistics_.quadCount += builder_.GetQuadCount();
+	statistics_.drawCallCount += static_cast<uint32_t>(groups.size());
+	builder_.Reset();
+}
+
+void Elysia::SpriteBatch::RecordDrawCommand(const D3D12_VERTEX_BUFFER_VIEW& vertexBufferView, const std::vector<SpriteBatchGroup>& groups) const {
+	//記録するスレッドのコマンドリスト
+	ComPtr<ID3D12GraphicsCommandList> commandList = directXSetup_->GetCommandList();
+
+	//コマンドを積む
+	commandList->SetGraphicsRootSignature(pipelineManager_->GetSpriteBatchRootSignature().Get());
+	commandList->IASetVertexBuffers(0u, 1u, &vertexBufferView);
+	commandList->IASetIndexBuffer(&indexBufferView_);
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	//グループごとに1回描画
+	uint32_t currentBlendMode = UINT32_MAX;
+	for (const SpriteBatchGroup& group : groups) {
+		//ブレンドモードが変わった時だけPSOを切り替える
+		if (group.blendMode != currentBlendMode) {
+			commandList->SetPipelineState(pipelineManager_->GetSpriteBatchGraphicsPipelineState(group.blendMode).Get());
+			currentBlendMode = group.blendMode;
+		}
+		if (group.textureHandle != 0u) {
+			TextureManager::GetInstance()->GraphicsCommand(0u, group.textureHandle);
+		}
+		//インデックスは0から使い、頂点の位置をずらす
+		commandList->DrawIndexedInstanced(
+			group.quadCount * SpriteBatchBuilder::INDEX_COUNT_PER_QUAD_, 1u, 0u,
+			static_cast<INT>(group.firstQuad * SpriteBatchBuilder::VERTEX_COUNT_PER_QUAD_), 0u);
+	}
+}
+
+void Elysia::SpriteBatch::End() {
+	assert(isInBatch_ == true);
+
+	Flush();
+	isInBatch_ = false;
+}
+
+void Elysia::SpriteBatch::DisplayImGui() {
+#ifdef _DEBUG
+	ImGui::Begin("スプライト");
+	ImGui::Text("スプライトの数 : %u", previousStatistics_.quadCount);
+	ImGui::Text("描画の回数 : %u", previousStatistics_.drawCallCount);
+	ImGui::End();
+#endif
+}
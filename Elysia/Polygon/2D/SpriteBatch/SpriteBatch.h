@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file SpriteBatch.h
+ * @brief スプライトをまとめて描画するクラス
+ * @author 茂木翼
+ */
+
+#include <vector>
+
+#include "DirectXSetup.h"
+#include "SpriteBatchBuilder.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// パイプライン管理クラス
+	/// </summary>
+	class PipelineManager;
+
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
+	/// <summary>
+	/// スプライトをまとめて描画するクラス
+	/// BeginからEndまでのSprite::Drawは溜めておき、
+	/// Endでフレームごとの頂点バッファに書き込んでグループごとに1回だけ描画する
+	/// </summary>
+	class SpriteBatch final {
+	public:
+		/// <summary>
+		/// 統計
+		/// </summary>
+		struct Statistics {
+			//スプライトの数
+			uint32_t quadCount;
+			//描画の回数
+			uint32_t drawCallCount;
+		};
+
+	private:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		SpriteBatch() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~SpriteBatch() = default;
+
+	public:
+		/// <summary>
+		/// インスタンスの取得
+		/// </summary>
+		/// <returns>インスタンス</returns>
+		static SpriteBatch* GetInstance();
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// </summary>
+		/// <param name="spriteBatch"></param>
+		SpriteBatch(const SpriteBatch& spriteBatch) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="spriteBatch"></param>
+		/// <returns></returns>
+		SpriteBatch& operator=(const SpriteBatch& spriteBatch) = delete;
+
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		void Initialize();
+
+		/// <summary>
+		/// 溜め始める
+		/// </summary>
+		void Begin();
+
+		/// <summary>
+		/// 追加
+		/// </summary>
+		/// <param name="quad">スプライト</param>
+		void Add(const SpriteQuad& quad);
+
+		/// <summary>
+		/// 溜めたものを描画する
+		/// スプライト以外のものを間に描画する時は先に呼ぶ
+		/// </summary>
+		void Flush();
+
+		/// <summary>
+		/// 溜め終わり
+		/// </summary>
+		void End();
+
+		/// <summary>
+		/// ImGui表示用
+		/// </summary>
+		void DisplayImGui();
+
+	public:
+		/// <summary>
+		/// 溜めている途中かどうか
+		/// </summary>
+		/// <returns></returns>
+		inline bool GetIsInBatch()const {
+			return isInBatch_;
+		}
+
+		/// <summary>
+		/// 前のフレームの統計を取得
+		/// </summary>
+		/// <returns>統計</returns>
+		inline const Statistics& GetStatistics()const {
+			return previousStatistics_;
+		}
+
+	private:
+		/// <summary>
+		/// コマンドを積む
+		/// </summary>
+		/// <param name="vertexBufferView">頂点のバッファビュー</param>
+		/// <param name="groups">グループ</param>
+		void RecordDrawCommand(const D3D12_VERTEX_BUFFER_VIEW& vertexBufferView, const std::vector<SpriteBatchGroup>& groups) const;
+
+	private:
+		//DirectXクラス
+		DirectXSetup* directXSetup_ = nullptr;
+		//パイプライン管理クラス
+		PipelineManager* pipelineManager_ = nullptr;
+		//定数バッファ管理クラス
+		ConstantBufferManager* constantBufferManager_ = nullptr;
+
+	private:
+		//1回のFlushで描けるスプライトの数
+		//頂点はフレームごとの定数バッファから確保するので、その大きさに収まるようにする
+		static constexpr uint32_t MAX_QUAD_COUNT_ = 1024u;
+
+		//インデックス
+		//どのスプライトも同じ並びなので最初に作っておく
+		ComPtr<ID3D12Resource> indexResource_ = nullptr;
+		D3D12_INDEX_BUFFER_VIEW indexBufferView_ = {};
+
+		//頂点とグループを作る
+		SpriteBatchBuilder builder_;
+		//溜めている途中かどうか
+		bool isInBatch_ = false;
+
+		//統計
+		Statistics statistics_ = {};
+		Statistics previousStatistics_ = {};
+
+	};
+
+}
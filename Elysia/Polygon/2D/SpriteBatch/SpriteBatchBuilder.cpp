@@ -0,0 +1,186 @@
+#include "SpriteBatchBuilder.h"
+
+#include <cmath>
+#include <algorithm>
+
+//SSEが使える時は4頂点をまとめて計算する
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define ELYSIA_SPRITE_BATCH_SSE
+#endif
+
+namespace {
+	//Sprite::Drawの正射影行列と同じ奥行き
+	const float ORTHOGRAPHIC_FAR_ = 100.0f;
+}
+
+void Elysia::SpriteBatchBuilder::Reset() {
+	quads_.clear();
+}
+
+void Elysia::SpriteBatchBuilder::Add(const SpriteQuad& quad) {
+	quads_.push_back(quad);
+}
+
+void Elysia::SpriteBatchBuilder::Build(const float& screenWidth, const float& screenHeight) {
+	size_t quadCount = quads_.size();
+	transformedVertices_.resize(quadCount * VERTEX_COUNT_PER_QUAD_);
+	quadGroups_.resize(quadCount);
+	pendingGroups_.clear();
+
+	for (size_t i = 0u; i < quadCount; ++i) {
+		const SpriteQuad& quad = quads_[i];
+		Bounds bounds = TransformQuad(quad, screenWidth, screenHeight, &transformedVertices_[i * VERTEX_COUNT_PER_QUAD_]);
+
+		//後ろのグループから遡って同じテクスチャとブレンドモードのグループを探す
+		//間に重なるスプライトがあると描く順番が変わってしまうのでそこで止める
+		uint32_t target = UINT32_MAX;
+		uint32_t lookbackCount = 0u;
+		for (size_t group = pendingGroups_.size(); group > 0u && lookbackCount < MERGE_LOOKBACK_COUNT_; --group, ++lookbackCount) {
+			const PendingGroup& pendingGroup = pendingGroups_[group - 1u];
+			if (pendingGroup.textureHandle == quad.textureHandle && pendingGroup.blendMode == quad.blendMode) {
+				target = static_cast<uint32_t>(group - 1u);
+				break;
+			}
+			if (IsOverlapped(pendingGroup.bounds, bounds) == true) {
+				break;
+			}
+		}
+
+		//見つからなければ新しいグループ
+		if (target == UINT32_MAX) {
+			PendingGroup pendingGroup = {
+				.textureHandle = quad.textureHandle,
+				.blendMode = quad.blendMode,
+				.bounds = bounds,
+				.quadCount = 0u,
+			};
+			pendingGroups_.push_back(pendingGroup);
+			target = static_cast<uint32_t>(pendingGroups_.size() - 1u);
+		}
+
+		PendingGroup& pendingGroup = pendingGroups_[target];
+		pendingGroup.bounds.minX = std::min<float>(pendingGroup.bounds.minX, bounds.minX);
+		pendingGroup.bounds.minY = std::min<float>(pendingGroup.bounds.minY, bounds.minY);
+		pendingGroup.bounds.maxX = std::max<float>(pendingGroup.bounds.maxX, bounds.maxX);
+		pendingGroup.bounds.maxY = std::max<float>(pendingGroup.bounds.maxY, bounds.maxY);
+		++pendingGroup.quadCount;
+		quadGroups_[i] = target;
+	}
+
+	//グループごとに連続するように並べ直す
+	groups_.resize(pendingGroups_.size());
+	writeQuads_.resize(pendingGroups_.size());
+	uint32_t firstQuad = 0u;
+	for (size_t group = 0u; group < pendingGroups_.size(); ++group) {
+		groups_[group] = {
+			.textureHandle = pendingGroups_[group].textureHandle,
+			.blendMode = pendingGroups_[group].blendMode,
+			.firstQuad = firstQuad,
+			.quadCount = pendingGroups_[group].quadCount,
+		};
+		writeQuads_[group] = firstQuad;
+		firstQuad += pendingGroups_[group].quadCount;
+	}
+
+	vertices_.resize(quadCount * VERTEX_COUNT_PER_QUAD_);
+	for (size_t i = 0u; i < quadCount; ++i) {
+		uint32_t writeQuad = writeQuads_[quadGroups_[i]]++;
+		std::copy_n(&transformedVertices_[i * VERTEX_COUNT_PER_QUAD_], VERTEX_COUNT_PER_QUAD_, &vertices_[writeQuad * VERTEX_COUNT_PER_QUAD_]);
+	}
+}
+
+Elysia::SpriteBatchBuilder::Bounds Elysia::SpriteBatchBuilder::TransformQuad(const SpriteQuad& quad, const float& screenWidth, const float& screenHeight, SpriteBatchVertex* vertices) {
+	//Sprite::Drawと同じ頂点
+	float left = (0.0f - quad.anchorPoint.x) * quad.size.x;
+	float right = (1.0f - quad.anchorPoint.x) * quad.size.x;
+	float top = (0.0f - quad.anchorPoint.y) * quad.size.y;
+	float bottom = (1.0f - quad.anchorPoint.y) * quad.size.y;
+	//左右反転
+	if (quad.isFlipX == true) {
+		left = -left;
+		right = -right;
+	}
+	//上下反転
+	if (quad.isFlipY == true) {
+		top = -top;
+		bottom = -bottom;
+	}
+
+	float sinRotate = std::sin(quad.rotate);
+	float cosRotate = std::cos(quad.rotate);
+	float sinUVRotate = std::sin(quad.uvRotate);
+	float cosUVRotate = std::cos(quad.uvRotate);
+	//正射影行列の分
+	float clipScaleX = 2.0f / screenWidth;
+	float clipScaleY = -2.0f / screenHeight;
+
+	//左下,左上,右下,右上の順
+	float screenX[VERTEX_COUNT_PER_QUAD_] = {};
+	float screenY[VERTEX_COUNT_PER_QUAD_] = {};
+	float clipX[VERTEX_COUNT_PER_QUAD_] = {};
+	float clipY[VERTEX_COUNT_PER_QUAD_] = {};
+	float u[VERTEX_COUNT_PER_QUAD_] = {};
+	float v[VERTEX_COUNT_PER_QUAD_] = {};
+
+#ifdef ELYSIA_SPRITE_BATCH_SSE
+	//SRTをかけて画面の座標にする
+	__m128 localX = _mm_mul_ps(_mm_setr_ps(left, left, right, right), _mm_set1_ps(quad.scale.x));
+	__m128 localY = _mm_mul_ps(_mm_setr_ps(bottom, top, bottom, top), _mm_set1_ps(quad.scale.y));
+	__m128 sinValue = _mm_set1_ps(sinRotate);
+	__m128 cosValue = _mm_set1_ps(cosRotate);
+	__m128 worldX = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(localX, cosValue), _mm_mul_ps(localY, sinValue)), _mm_set1_ps(quad.position.x));
+	__m128 worldY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(localX, sinValue), _mm_mul_ps(localY, cosValue)), _mm_set1_ps(quad.position.y));
+	_mm_storeu_ps(screenX, worldX);
+	_mm_storeu_ps(screenY, worldY);
+	//クリップ空間にする
+	_mm_storeu_ps(clipX, _mm_sub_ps(_mm_mul_ps(worldX, _mm_set1_ps(clipScaleX)), _mm_set1_ps(1.0f)));
+	_mm_storeu_ps(clipY, _mm_add_ps(_mm_mul_ps(worldY, _mm_set1_ps(clipScaleY)), _mm_set1_ps(1.0f)));
+
+	//UVトランスフォーム
+	__m128 texU = _mm_mul_ps(_mm_setr_ps(quad.texLeftTop.x, quad.texLeftTop.x, quad.texRightBottom.x, quad.texRightBottom.x), _mm_set1_ps(quad.uvScale.x));
+	__m128 texV = _mm_mul_ps(_mm_setr_ps(quad.texRightBottom.y, quad.texLeftTop.y, quad.texRightBottom.y, quad.texLeftTop.y), _mm_set1_ps(quad.uvScale.y));
+	__m128 sinUV = _mm_set1_ps(sinUVRotate);
+	__m128 cosUV = _mm_set1_ps(cosUVRotate);
+	_mm_storeu_ps(u, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(texU, cosUV), _mm_mul_ps(texV, sinUV)), _mm_set1_ps(quad.uvTranslate.x)));
+	_mm_storeu_ps(v, _mm_add_ps(_mm_add_ps(_mm_mul_ps(texU, sinUV), _mm_mul_ps(texV, cosUV)), _mm_set1_ps(quad.uvTranslate.y)));
+#else
+	const float LOCAL_X[VERTEX_COUNT_PER_QUAD_] = { left, left, right, right };
+	const float LOCAL_Y[VERTEX_COUNT_PER_QUAD_] = { bottom, top, bottom, top };
+	const float TEX_U[VERTEX_COUNT_PER_QUAD_] = { quad.texLeftTop.x, quad.texLeftTop.x, quad.texRightBottom.x, quad.texRightBottom.x };
+	const float TEX_V[VERTEX_COUNT_PER_QUAD_] = { quad.texRightBottom.y, quad.texLeftTop.y, quad.texRightBottom.y, quad.texLeftTop.y };
+	for (uint32_t i = 0u; i < VERTEX_COUNT_PER_QUAD_; ++i) {
+		float localX = LOCAL_X[i] * quad.scale.x;
+		float localY = LOCAL_Y[i] * quad.scale.y;
+		screenX[i] = localX * cosRotate - localY * sinRotate + quad.position.x;
+		screenY[i] = localX * sinRotate + localY * cosRotate + quad.position.y;
+		clipX[i] = screenX[i] * clipScaleX - 1.0f;
+		clipY[i] = screenY[i] * clipScaleY + 1.0f;
+
+		float texU = TEX_U[i] * quad.uvScale.x;
+		float texV = TEX_V[i] * quad.uvScale.y;
+		u[i] = texU * cosUVRotate - texV * sinUVRotate + quad.uvTranslate.x;
+		v[i] = texU * sinUVRotate + texV * cosUVRotate + quad.uvTranslate.y;
+	}
+#endif
+
+	float clipZ = quad.depth / ORTHOGRAPHIC_FAR_;
+	Bounds bounds = { .minX = screenX[0], .minY = screenY[0], .maxX = screenX[0], .maxY = screenY[0] };
+	for (uint32_t i = 0u; i < VERTEX_COUNT_PER_QUAD_; ++i) {
+		vertices[i] = {
+			.position = {.x = clipX[i], .y = clipY[i], .z = clipZ, .w = 1.0f },
+			.texCoord = {.x = u[i], .y = v[i] },
+			.color = quad.color,
+		};
+		bounds.minX = std::min<float>(bounds.minX, screenX[i]);
+		bounds.minY = std::min<float>(bounds.minY, screenY[i]);
+		bounds.maxX = std::max<float>(bounds.maxX, screenX[i]);
+		bounds.maxY = std::max<float>(bounds.maxY, screenY[i]);
+	}
+	return bounds;
+}
+
+bool Elysia::SpriteBatchBuilder::IsOverlapped(const Bounds& a, const Bounds& b) {
+	//辺が接しているだけなら同じピクセルは塗らない
+	return a.minX < b.maxX && b.minX < a.maxX && a.minY < b.maxY && b.minY < a.maxY;
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+/**
+ * @file SpriteBatchBuilder.h
+ * @brief スプライトの頂点をまとめて作るクラス
+ * @author 茂木翼
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "Vector2.h"
+#include "Vector4.h"
+
+/// <summary>
+/// ElysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// まとめて描画する時の頂点
+	/// 座標はクリップ空間まで計算済み、色とUVトランスフォームも頂点に入れる
+	/// </summary>
+	struct SpriteBatchVertex {
+		Vector4 position;
+		Vector2 texCoord;
+		Vector4 color;
+	};
+
+	/// <summary>
+	/// スプライト1枚分
+	/// Sprite::Drawで計算していたものをそのまま持つ
+	/// </summary>
+	struct SpriteQuad {
+		//座標
+		Vector2 position;
+		//サイズ
+		Vector2 size;
+		//スケール
+		Vector2 scale;
+		//回転
+		float rotate;
+		//アンカーポイント
+		Vector2 anchorPoint;
+		//左右フリップ
+		bool isFlipX;
+		//上下フリップ
+		bool isFlipY;
+		//奥行き(手前が0、後ろが1)
+		float depth;
+		//テクスチャの範囲(UV)
+		Vector2 texLeftTop;
+		Vector2 texRightBottom;
+		//UVトランスフォーム
+		Vector2 uvScale;
+		float uvRotate;
+		Vector2 uvTranslate;
+		//色
+		Vector4 color;
+		//テクスチャ
+		uint32_t textureHandle;
+		//ブレンドモード
+		uint32_t blendMode;
+	};
+
+	/// <summary>
+	/// 1回の描画でまとめて描くスプライト
+	/// </summary>
+	struct SpriteBatchGroup {
+		//テクスチャ
+		uint32_t textureHandle;
+		//ブレンドモード
+		uint32_t blendMode;
+		//最初のスプライトの番号
+		uint32_t firstQuad;
+		//スプライトの数
+		uint32_t quadCount;
+	};
+
+	/// <summary>
+	/// スプライトの頂点をまとめて作るクラス
+	/// DirectXに触らないのでCPUだけで確かめられる
+	/// テクスチャとブレンドモードが同じで、間に重なるスプライトが無い時だけ前のグループにまとめるので、
+	/// 描いた結果は1枚ずつ描いた時と変わらない
+	/// </summary>
+	class SpriteBatchBuilder final {
+	public:
+		/// <summary>
+		/// 溜めたスプライトを消す
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// 追加
+		/// </summary>
+		/// <param name="quad">スプライト</param>
+		void Add(const SpriteQuad& quad);
+
+		/// <summary>
+		/// 頂点とグループを作る
+		/// </summary>
+		/// <param name="screenWidth">画面の幅</param>
+		/// <param name="screenHeight">画面の高さ</param>
+		void Build(const float& screenWidth, const float& screenHeight);
+
+	public:
+		/// <summary>
+		/// 溜めたスプライトの数を取得
+		/// </summary>
+		/// <returns>数</returns>
+		inline uint32_t GetQuadCount()const {
+			return static_cast<uint32_t>(quads_.size());
+		}
+
+		/// <summary>
+		/// 頂点を取得
+		/// グループの順に4頂点ずつ並ぶ
+		/// </summary>
+		/// <returns>頂点</returns>
+		inline const std::vector<SpriteBatchVertex>& GetVertices()const {
+			return vertices_;
+		}
+
+		/// <summary>
+		/// グループを取得
+		/// </summary>
+		/// <returns>グループ</returns>
+		inline const std::vector<SpriteBatchGroup>& GetGroups()const {
+			return groups_;
+		}
+
+	public:
+		//1スプライトあたりの頂点の数
+		static constexpr uint32_t VERTEX_COUNT_PER_QUAD_ = 4u;
+		//1スプライトあたりのインデックスの数
+		static constexpr uint32_t INDEX_COUNT_PER_QUAD_ = 6u;
+		//まとめる先を探す時に遡るグループの数
+		static constexpr uint32_t MERGE_LOOKBACK_COUNT_ = 16u;
+
+	private:
+		/// <summary>
+		/// 画面上の範囲
+		/// </summary>
+		struct Bounds {
+			float minX;
+			float minY;
+			float maxX;
+			float maxY;
+		};
+
+		/// <summary>
+		/// まとめる途中のグループ
+		/// </summary>
+		struct PendingGroup {
+			//テクスチャ
+			uint32_t textureHandle;
+			//ブレンドモード
+			uint32_t blendMode;
+			//中のスプライト全部を囲む範囲
+			Bounds bounds;
+			//スプライトの数
+			uint32_t quadCount;
+		};
+
+		/// <summary>
+		/// 4頂点を計算
+		/// </summary>
+		/// <param name="quad">スプライト</param>
+		/// <param name="screenWidth">画面の幅</param>
+		/// <param name="screenHeight">画面の高さ</param>
+		/// <param name="vertices">書き込み先(4頂点)</param>
+		/// <returns>画面上の範囲</returns>
+		static Bounds TransformQuad(const SpriteQuad& quad, const float& screenWidth, const float& screenHeight, SpriteBatchVertex* vertices);
+
+		/// <summary>
+		/// 重なっているかどうか
+		/// </summary>
+		/// <param name="a">範囲</param>
+		/// <param name="b">範囲</param>
+		/// <returns>重なっているかどうか</returns>
+		static bool IsOverlapped(const Bounds& a, const Bounds& b);
+
+	private:
+		//溜めたスプライト
+		std::vector<SpriteQuad> quads_;
+		//追加した順の頂点
+		std::vector<SpriteBatchVertex> transformedVertices_;
+		//スプライトごとのグループ
+		std::vector<uint32_t> quadGroups_;
+		//まとめる途中のグループ
+		std::vector<PendingGroup> pendingGroups_;
+		//グループごとの次に書き込むスプライトの番号
+		std::vector<uint32_t> writeQuads_;
+		//グループの順の頂点
+		std::vector<SpriteBatchVertex> vertices_;
+		//グループ
+		std::vector<SpriteBatchGroup> groups_;
+
+	};
+
+}
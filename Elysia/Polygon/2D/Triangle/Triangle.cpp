@@ -19,6 +19,13 @@ Triangle::Triangle(){
 
 }
 
+Triangle::~Triangle() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(vertexResouce_));
+	directXSetup_->DeferRelease(std::move(materialResource_));
+	directXSetup_->DeferRelease(std::move(wvpResource_));
+}
+
 void Triangle::Initialize() {
 
 	//ここでBufferResourceを作る
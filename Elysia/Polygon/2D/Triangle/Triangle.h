@@ -61,7 +61,7 @@ public:
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
-	~Triangle()=default;
+	~Triangle();
 
 private:
 	//ウィンドウクラス
@@ -7,6 +7,7 @@
 #include "TextureManager.h"
 #include "ModelManager.h"
 #include "PipelineManager.h"
+#include "ConstantBufferManager.h"
 
 #include "WorldTransform.h"
 #include "Material.h"
@@ -29,9 +30,17 @@ AnimationModel::AnimationModel(){
 	textureManager_ = Elysia::TextureManager::GetInstance();
 	//モデル管理クラスを取得
 	modelManager_ = Elysia::ModelManager::GetInstance();
+	//定数バッファ管理クラスを取得
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 
 }
 
+AnimationModel::~AnimationModel() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(vertexResource_));
+	directXSetup_->DeferRelease(std::move(indexResource_));
+}
+
 AnimationModel* AnimationModel::Create(const uint32_t& modelHandle){
 	//新たなModel型のインスタンスのメモリを確保
 	AnimationModel* model = new AnimationModel();
@@ -64,8 +73,19 @@ AnimationModel* AnimationModel::Create(const uint32_t& modelHandle){
 	//フォーマット
 	model->indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
 
-	//カメラ
-	model->cameraResource_ = model->directXSetup_->CreateBufferResource(sizeof(CameraForGPU)).Get();
+	//頂点バッファにデータを書き込む
+	//頂点とインデックスは変化しないので生成時に一度だけ書き込む
+	//描画のたびに書き込むと前のフレームでGPUが読んでいる最中のデータを上書きしてしまう
+	VertexData* vertexData = nullptr;
+	model->vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));
+	std::memcpy(vertexData, model->modelData_.vertices.data(), sizeof(VertexData) * model->modelData_.vertices.size());
+	model->vertexResource_->Unmap(0u, nullptr);
+
+	//インデックス
+	uint32_t* index = nullptr;
+	model->indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&index));
+	std::memcpy(index, model->modelData_.indices.data(), sizeof(uint32_t) * model->modelData_.indices.size());
+	model->indexResource_->Unmap(0u, nullptr);
 
 	return model;
 
@@ -76,26 +96,12 @@ void AnimationModel::Draw(const WorldTransform& worldTransform, const Camera& ca
 	//Materialのライティングの設定が平行光源ではない場合止める
 	assert(material.lightingKinds == DirectionalLighting);
 
-	//資料にはなかったけどUnMapはあった方がいいらしい
-	//Unmapを行うことで、リソースの変更が完了し、GPUとの同期が取られる。
-	//プログラムが安定するとのこと
-#pragma region 頂点バッファ
-	//頂点バッファにデータを書き込む
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
-
-	//Index
-	uint32_t* mappedIndex = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&mappedIndex));
-	std::memcpy(mappedIndex, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
-
 	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	//描画ごとに変わるのでフレームごとの定数バッファに書き込む
+	CameraForGPU cameraForGPU = {
+		.worldPosition = camera.GetWorldPosition(),
+	};
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(cameraForGPU);
 
 
 	//コマンドを積む
@@ -117,21 +123,21 @@ void AnimationModel::Draw(const WorldTransform& worldTransform, const Camera& ca
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//ワールドトランスフォーム
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.GetGPUVirtualAddress());
 	//SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である
 	if (textureHandle_ != 0u) {
 		textureManager_->GetInstance()->GraphicsCommand(2u,textureHandle_);
 	}
 	//DirectionalLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, directionalLight.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, directionalLight.resource.GetGPUVirtualAddress());
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.GetGPUVirtualAddress());
 	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
-	//paletteSrvHandle
-	directXSetup_->GetCommandList()->SetGraphicsRootDescriptorTable(8u, skinCluster.paletteSrvHandle.second);
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
+	//パレット
+	srvManager_->SetGraphicsRootDescriptorTable(8u, skinCluster.paletteBuffer.GetSrvIndex());
 	//環境マップを使う場合
 	if (material.isEnviromentMap==true && eviromentTextureHandle_ != 0u) {
 		srvManager_->SetGraphicsRootDescriptorTable(9u, eviromentTextureHandle_);
@@ -146,27 +152,12 @@ void AnimationModel::Draw(const WorldTransform& worldTransform, const Camera& ca
 	//Materialのライティングの設定が点光源ではない場合止める
 	assert(material.lightingKinds == PointLighting);
 
-	//資料にはなかったけどUnMapはあった方がいいらしい
-	//Unmapを行うことで、リソースの変更が完了し、GPUとの同期が取られる。
-	//プログラムが安定するとのこと
-	
-	//頂点
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
-
-	//Index
-	uint32_t* mappedIndex = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&mappedIndex));
-	std::memcpy(mappedIndex, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
-
-
 	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	//描画ごとに変わるのでフレームごとの定数バッファに書き込む
+	CameraForGPU cameraForGPU = {
+		.worldPosition = camera.GetWorldPosition(),
+	};
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(cameraForGPU);
 
 	//コマンドを積む
 	//パイプラインの設定
@@ -188,23 +179,23 @@ void AnimationModel::Draw(const WorldTransform& worldTransform, const Camera& ca
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//資料見返してみたがhlsl(GPU)に計算を任せているわけだった
 	//コマンド送ってGPUで計算
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.GetGPUVirtualAddress());
 	//SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である
 	if (textureHandle_ != 0u) {
 		textureManager_->GetInstance()->GraphicsCommand(2u, textureHandle_);
 	}
 
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.GetGPUVirtualAddress());
 	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 	//PointLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(6u, pointLight.resource->GetGPUVirtualAddress());
-	//paletteSrvHandle
-	directXSetup_->GetCommandList()->SetGraphicsRootDescriptorTable(8u, skinCluster.paletteSrvHandle.second);
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(6u, pointLight.resource.GetGPUVirtualAddress());
+	//パレット
+	srvManager_->SetGraphicsRootDescriptorTable(8u, skinCluster.paletteBuffer.GetSrvIndex());
 	//環境マップを使う場合
 	if (material.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
 		srvManager_->SetGraphicsRootDescriptorTable(9u, eviromentTextureHandle_);
@@ -219,27 +210,12 @@ void AnimationModel::Draw(const WorldTransform& worldTransform, const Camera& ca
 	//Materialのライティングの設定がスポットライトではない場合止める
 	assert(material.lightingKinds == SpotLighting);
 	
-	// 資料にはなかったけどUnMapはあった方がいいらしい
-	//Unmapを行うことで、リソースの変更が完了し、GPUとの同期が取られる。
-	//プログラムが安定するとのこと
-	
-	//頂点
-	VertexData * vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
-
-	
-	//Index
-	uint32_t* mappedIndex = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&mappedIndex));
-	std::memcpy(mappedIndex, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
-
 	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	//描画ごとに変わるのでフレームごとの定数バッファに書き込む
+	CameraForGPU cameraForGPU = {
+		.worldPosition = camera.GetWorldPosition(),
+	};
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(cameraForGPU);
 
 
 	//コマンドを積む
@@ -262,22 +238,22 @@ void AnimationModel::Draw(const WorldTransform& worldTransform, const Camera& ca
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//資料見返してみたがhlsl(GPU)に計算を任せているわけだった
 	//コマンド送ってGPUで計算
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.GetGPUVirtualAddress());
 	//SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.GetGPUVirtualAddress());
 	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 	//SpotLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(7u, spotLight.resource->GetGPUVirtualAddress());
-	//paletteSrvHandle
-	directXSetup_->GetCommandList()->SetGraphicsRootDescriptorTable(8u, skinCluster.paletteSrvHandle.second);
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(7u, spotLight.resource.GetGPUVirtualAddress());
+	//パレット
+	srvManager_->SetGraphicsRootDescriptorTable(8u, skinCluster.paletteBuffer.GetSrvIndex());
 	if (material.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
 		srvManager_->SetGraphicsRootDescriptorTable(9u, eviromentTextureHandle_);
 	}
@@ -68,6 +68,11 @@ namespace Elysia {
 	/// パイプライン管理クラス
 	/// </summary>
 	class PipelineManager;
+
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
 	
 	/// <summary>
 	/// SRV管理クラス
@@ -144,7 +149,7 @@ public:
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
-	~AnimationModel()=default;
+	~AnimationModel();
 
 
 public:
@@ -169,6 +174,8 @@ private:
 	Elysia::TextureManager* textureManager_ = nullptr;
 	//モデル管理クラス
 	Elysia::ModelManager* modelManager_ = nullptr;
+	//定数バッファ管理クラス
+	Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 
 
 
@@ -184,11 +191,6 @@ private:
 	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
 
 
-	//PixelShaderにカメラの座標を送る為の変数
-	ComPtr<ID3D12Resource> cameraResource_ = nullptr;
-	CameraForGPU* cameraForGPU_ = {};
-
-
 	//アニメーションを再生するときに使う時間
 	float_t animationTime_ = 0.0f;
 
@@ -9,6 +9,7 @@
 #include "PipelineManager.h"
 
 #include "SrvManager.h"
+#include "ConstantBufferManager.h"
 #include "WorldTransform.h"
 #include "Camera.h"
 #include "Material.h"
@@ -27,9 +28,17 @@ InstancingModel::InstancingModel() {
 	pipelineManager_ = Elysia::PipelineManager::GetInstance();
 	//SRV管理クラスの取得
 	srvManager_ = Elysia::SrvManager::GetInstance();
+	//定数バッファ管理クラスの取得
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 
 }
 
+InstancingModel::~InstancingModel() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(vertexResource_));
+	directXSetup_->DeferRelease(std::move(indexResource_));
+}
+
 InstancingModel* InstancingModel::Create(const uint32_t& modelHandle) {
 
 	//新たなModel型のインスタンスのメモリを確保
@@ -61,10 +70,16 @@ InstancingModel* InstancingModel::Create(const uint32_t& modelHandle) {
 	//フォーマット
 	model->indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
 
-
-
-	//カメラ
-	model->cameraResource_ = model->directXSetup_->CreateBufferResource(sizeof(CameraForGPU)).Get();
+	//頂点とインデックスは変わらないので作った時に1度だけ書き込む
+	//描画中に書き換えるとGPUが前のフレームで読んでいる所を壊してしまう
+	VertexData* vertexData = nullptr;
+	model->vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));
+	std::memcpy(vertexData, model->modelData_.vertices.data(), sizeof(VertexData) * model->modelData_.vertices.size());
+	model->vertexResource_->Unmap(0u, nullptr);
+	uint32_t* mappedIndex = nullptr;
+	model->indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&mappedIndex));
+	std::memcpy(mappedIndex, model->modelData_.indices.data(), sizeof(uint32_t) * model->modelData_.indices.size());
+	model->indexResource_->Unmap(0u, nullptr);
 
 	return model;
 
@@ -72,22 +87,12 @@ InstancingModel* InstancingModel::Create(const uint32_t& modelHandle) {
 
 //描画
 void InstancingModel::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material, const DirectionalLight& directionalLight) {
-	//頂点
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
-
-	//Index
-	uint32_t* mappedIndex = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&mappedIndex));
-	std::memcpy(mappedIndex, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
-
 	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	//描画ごとに変わるのでフレームごとの定数バッファに書き込む
+	CameraForGPU cameraForGPU = {
+		.worldPosition = camera.GetWorldPosition(),
+	};
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(cameraForGPU);
 
 
 	//コマンドを積む
@@ -101,19 +106,19 @@ void InstancingModel::Draw(const WorldTransform& worldTransform, const Camera& c
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//ワールドトランスフォーム
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.GetGPUVirtualAddress());
 	//テクスチャ
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
 	//DirectionalLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, directionalLight.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, directionalLight.resource.GetGPUVirtualAddress());
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.GetGPUVirtualAddress());
 	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 	//環境マップ
 	if (material.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
 		srvManager_->SetGraphicsRootDescriptorTable(8u, eviromentTextureHandle_);
@@ -124,23 +129,12 @@ void InstancingModel::Draw(const WorldTransform& worldTransform, const Camera& c
 }
 
 void InstancingModel::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material, const PointLight& pointLight) {
-	//頂点
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
-
-	//Index
-	uint32_t* mappedIndex = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&mappedIndex));
-	std::memcpy(mappedIndex, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
-
-
-    //PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	//PixelShaderに送る方のカメラ
+	//描画ごとに変わるのでフレームごとの定数バッファに書き込む
+	CameraForGPU cameraForGPU = {
+		.worldPosition = camera.GetWorldPosition(),
+	};
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(cameraForGPU);
 
 
 	//コマンドを積む
@@ -153,19 +147,19 @@ void InstancingModel::Draw(const WorldTransform& worldTransform, const Camera& c
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//ワールドトランスフォーム
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.GetGPUVirtualAddress());
 	//テクスチャ
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.GetGPUVirtualAddress());
 	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 	//PointLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(6u, pointLight.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(6u, pointLight.resource.GetGPUVirtualAddress());
 	if (material.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
 		srvManager_->SetGraphicsRootDescriptorTable(8, eviromentTextureHandle_);
 	}
@@ -175,23 +169,12 @@ void InstancingModel::Draw(const WorldTransform& worldTransform, const Camera& c
 }
 
 void InstancingModel::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material, const SpotLight& spotLight) {
-
-	//頂点
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
-
-	//Index
-	uint32_t* mappedIndex = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&mappedIndex));
-	std::memcpy(mappedIndex, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
-
 	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	//描画ごとに変わるのでフレームごとの定数バッファに書き込む
+	CameraForGPU cameraForGPU = {
+		.worldPosition = camera.GetWorldPosition(),
+	};
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(cameraForGPU);
 
 
 	//コマンドを積む
@@ -205,19 +188,19 @@ void InstancingModel::Draw(const WorldTransform& worldTransform, const Camera& c
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//ワールドトランスフォーム
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.GetGPUVirtualAddress());
 	//テクスチャ
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.GetGPUVirtualAddress());
 	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 	//SpotLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(7u, spotLight.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(7u, spotLight.resource.GetGPUVirtualAddress());
 	//環境マッピングの設定
 	if (material.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
 		srvManager_->SetGraphicsRootDescriptorTable(8, eviromentTextureHandle_);
@@ -82,6 +82,11 @@ namespace Elysia {
 	/// モデル管理クラス
 	/// </summary>
 	class ModelManager;
+
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
 };
 
 
@@ -137,7 +142,7 @@ public:
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
-	~InstancingModel() = default;
+	~InstancingModel();
 
 
 public:
@@ -164,6 +169,8 @@ private:
 	Elysia::PipelineManager* pipelineManager_ = nullptr;
 	//SRV管理クラス
 	Elysia::SrvManager* srvManager_ = nullptr;
+	//定数バッファ管理クラス
+	Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 
 private:
 	//頂点
@@ -179,12 +186,6 @@ private:
 	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
 
 
-	//カメラリソース
-	ComPtr<ID3D12Resource> cameraResource_ = nullptr;
-	//PixelShaderにカメラの座標を送る為の変数
-	CameraForGPU* cameraForGPU_ = {};
-
-
 	//テクスチャハンドル
 	uint32_t textureHandle_ = 0u;
 
@@ -7,14 +7,18 @@
 #include "TextureManager.h"
 #include "ModelManager.h"
 #include "PipelineManager.h"
+#include "ConstantBufferManager.h"
 
 #include "SrvManager.h"
 #include "WorldTransform.h"
+#include "TransformHierarchy.h"
 #include "Camera.h"
 #include "Material.h"
 #include "DirectionalLight.h"
 #include "PointLight.h"
 #include "SpotLight.h"
+#include "SingleCalculation.h"
+#include "VectorCalculation.h"
 
 Elysia::Model::Model() {
 	//テクスチャ管理クラスの取得
@@ -27,6 +31,14 @@ Elysia::Model::Model() {
 	pipelineManager_ = Elysia::PipelineManager::GetInstance();
 	//SRV管理クラスも取得
 	srvManager_ = Elysia::SrvManager::GetInstance();
+	//定数バッファ管理クラスの取得
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
+}
+
+Elysia::Model::~Model() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(vertexResource_));
+	directXSetup_->DeferRelease(std::move(indexResource_));
 }
 
 Elysia::Model* Elysia::Model::Create(const uint32_t& modelHandle) {
@@ -59,257 +71,194 @@ Elysia::Model* Elysia::Model::Create(const uint32_t& modelHandle) {
 	//フォーマット
 	model->indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
 
-
-
-	//カメラ
-	model->cameraResource_ = model->directXSetup_->CreateBufferResource(sizeof(CameraForGPU)).Get();
-
-	return model;
-
-}
-
-void Elysia::Model::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material){
-	//資料にはなかったけどUnMapはあった方がいいらしい
-	//Unmapを行うことで、リソースの変更が完了し、GPUとの同期が取られる。
-	//プログラムが安定するらしいとのこと
-
-
 	//頂点バッファにデータを書き込む
+	//頂点とインデックスは変化しないので生成時に一度だけ書き込む
+	//描画のたびに書き込むと前のフレームでGPUが読んでいる最中のデータを上書きしてしまう
 	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
+	model->vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));
+	std::memcpy(vertexData, model->modelData_.vertices.data(), sizeof(VertexData) * model->modelData_.vertices.size());
+	model->vertexResource_->Unmap(0u, nullptr);
 
 	//インデックス
 	uint32_t* index = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&index));
-	std::memcpy(index, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
+	model->indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&index));
+	std::memcpy(index, model->modelData_.indices.data(), sizeof(uint32_t) * model->modelData_.indices.size());
+	model->indexResource_->Unmap(0u, nullptr);
 
-	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	return model;
 
-	//コマンドを積む
-	//パイプラインの設定
-	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetModelRootSignature().Get());
-	directXSetup_->GetCommandList()->SetPipelineState(pipelineManager_->GetModelGraphicsPipelineState().Get());
-	//RootSignatureを設定。PSOに設定しているけど別途設定が必要
-	directXSetup_->GetCommandList()->IASetVertexBuffers(0u, 1u, &vertexBufferView_);
-	//IBVを設定
-	directXSetup_->GetCommandList()->IASetIndexBuffer(&indexBufferView_);
-	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
-	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
-	//資料見返してみたがhlsl(GPU)に計算を任せているわけだった
-	//コマンド送ってGPUで計算
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
-	//テクスチャ
-	if (textureHandle_ != 0u) {
-		textureManager_->GraphicsCommand(2u, textureHandle_);
-	}
-	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
-	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
-	//DrawCall
-	directXSetup_->GetCommandList()->DrawIndexedInstanced(UINT(modelData_.indices.size()), 1u, 0u, 0u, 0u);
+}
 
+void Elysia::Model::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material){
+	Draw(MakeDrawTransform(worldTransform), camera, material);
 }
 
 //描画
 void Elysia::Model::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material, const DirectionalLight& directionalLight) {
-	//資料にはなかったけどUnMapはあった方がいいらしい
-	//Unmapを行うことで、リソースの変更が完了し、GPUとの同期が取られる。
-	//プログラムが安定するらしいとのこと
-
-
-	//頂点バッファにデータを書き込む
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
-
-	//インデックス
-	uint32_t* index = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&index));
-	std::memcpy(index, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
-
-	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
-
-	//コマンドを積む
-	//パイプラインの設定
-	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetModelRootSignature().Get());
-	directXSetup_->GetCommandList()->SetPipelineState(pipelineManager_->GetModelGraphicsPipelineState().Get());
-	//RootSignatureを設定。PSOに設定しているけど別途設定が必要
-	directXSetup_->GetCommandList()->IASetVertexBuffers(0u, 1u, &vertexBufferView_);
-	//IBVを設定
-	directXSetup_->GetCommandList()->IASetIndexBuffer(&indexBufferView_);
-	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
-	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
-	//資料見返してみたがhlsl(GPU)に計算を任せているわけだった
-	//コマンド送ってGPUで計算
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
-	//SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である
-	if (textureHandle_ != 0u) {
-		textureManager_->GraphicsCommand(2u, textureHandle_);
-	}
-	//DirectionalLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, directionalLight.resource->GetGPUVirtualAddress());
-	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
-	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
-	//環境マップ用のテクスチャ
-	if (material.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
-		srvManager_->SetGraphicsRootDescriptorTable(8u, eviromentTextureHandle_);
-	}
-	//DrawCall
-	directXSetup_->GetCommandList()->DrawIndexedInstanced(UINT(modelData_.indices.size()), 1u, 0u, 0u, 0u);
-
+	Draw(MakeDrawTransform(worldTransform), camera, material, directionalLight);
 }
 
 void Elysia::Model::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material, const PointLight& pointLight) {
-	//点光源だけ
-	assert(material.lightingKinds == PointLighting);
+	Draw(MakeDrawTransform(worldTransform), camera, material, pointLight);
+}
 
-	//頂点バッファにデータを書き込む
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
+void Elysia::Model::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material, const SpotLight& spotLight) {
+	Draw(MakeDrawTransform(worldTransform), camera, material, spotLight);
+}
 
-	//インデックス
-	uint32_t* index = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&index));
-	std::memcpy(index, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
+void Elysia::Model::Draw(const TransformHierarchy& transformHierarchy, const uint32_t& node, const Camera& camera, const Material& material) {
+	Draw(MakeDrawTransform(transformHierarchy, node), camera, material);
+}
 
+void Elysia::Model::Draw(const TransformHierarchy& transformHierarchy, const uint32_t& node, const Camera& camera, const Material& material, const DirectionalLight& directionalLight) {
+	Draw(MakeDrawTransform(transformHierarchy, node), camera, material, directionalLight);
+}
 
-	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+void Elysia::Model::Draw(const TransformHierarchy& transformHierarchy, const uint32_t& node, const Camera& camera, const Material& material, const PointLight& pointLight) {
+	Draw(MakeDrawTransform(transformHierarchy, node), camera, material, pointLight);
+}
 
-	//コマンドを積む
-	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetModelRootSignature().Get());
-	directXSetup_->GetCommandList()->SetPipelineState(pipelineManager_->GetModelGraphicsPipelineState().Get());
-	//RootSignatureを設定。PSOに設定しているけど別途設定が必要
-	directXSetup_->GetCommandList()->IASetVertexBuffers(0u, 1u, &vertexBufferView_);
-	//IBVを設定
-	directXSetup_->GetCommandList()->IASetIndexBuffer(&indexBufferView_);
-	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
-	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
-	//資料見返してみたがhlsl(GPU)に計算を任せているわけだった
-	//コマンド送ってGPUで計算
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
-	//SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である
-	if (textureHandle_ != 0u) {
-		textureManager_->GraphicsCommand(2u, textureHandle_);
-	}
-	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
+void Elysia::Model::Draw(const TransformHierarchy& transformHierarchy, const uint32_t& node, const Camera& camera, const Material& material, const SpotLight& spotLight) {
+	Draw(MakeDrawTransform(transformHierarchy, node), camera, material, spotLight);
+}
 
-	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
-	//PointLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(6u, pointLight.resource->GetGPUVirtualAddress());
+void Elysia::Model::Draw(const DrawTransform& drawTransform, const Camera& camera, const Material& material) {
+	DrawCommand drawCommand = CreateDrawCommand(drawTransform, camera, material);
+	//ライトを使わない描画は環境マップも使わない
+	drawCommand.isEnviromentMap = false;
+	SubmitDrawCommand(drawCommand);
+}
 
-	if (material.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
-		srvManager_->SetGraphicsRootDescriptorTable(8u, eviromentTextureHandle_);
-	}
+void Elysia::Model::Draw(const DrawTransform& drawTransform, const Camera& camera, const Material& material, const DirectionalLight& directionalLight) {
+	DrawCommand drawCommand = CreateDrawCommand(drawTransform, camera, material);
+	//DirectionalLight
+	drawCommand.lightRootParameterIndex = 3u;
+	drawCommand.lightAddress = directionalLight.resource.GetGPUVirtualAddress();
+	SubmitDrawCommand(drawCommand);
+}
 
-	//DrawCall
-	directXSetup_->GetCommandList()->DrawIndexedInstanced(UINT(modelData_.indices.size()), 1u, 0u, 0u, 0u);
+void Elysia::Model::Draw(const DrawTransform& drawTransform, const Camera& camera, const Material& material, const PointLight& pointLight) {
+	//点光源だけ
+	assert(material.lightingKinds == PointLighting);
 
+	DrawCommand drawCommand = CreateDrawCommand(drawTransform, camera, material);
+	//PointLight
+	drawCommand.lightRootParameterIndex = 6u;
+	drawCommand.lightAddress = pointLight.resource.GetGPUVirtualAddress();
+	SubmitDrawCommand(drawCommand);
 }
 
-void Elysia::Model::Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material, const SpotLight& spotLight) {
+void Elysia::Model::Draw(const DrawTransform& drawTransform, const Camera& camera, const Material& material, const SpotLight& spotLight) {
 	
 	//スケール0の時は見えないので早期リターンさせたい
-	if (worldTransform.scale.x == 0.0f && 
-		worldTransform.scale.y == 0.0f && 
-		worldTransform.scale.z == 0.0f) {
+	if (drawTransform.scale.x == 0.0f && 
+		drawTransform.scale.y == 0.0f && 
+		drawTransform.scale.z == 0.0f) {
 		return;
 	}
 
+	DrawCommand drawCommand = CreateDrawCommand(drawTransform, camera, material);
+	//SpotLight
+	drawCommand.lightRootParameterIndex = 7u;
+	drawCommand.lightAddress = spotLight.resource.GetGPUVirtualAddress();
+	SubmitDrawCommand(drawCommand);
+}
 
-	//頂点バッファ
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vertexData));//書き込むためのアドレスを取得
-	std::memcpy(vertexData, modelData_.vertices.data(), sizeof(VertexData) * modelData_.vertices.size());
-	vertexResource_->Unmap(0u, nullptr);
-
-	//インデックス
-	uint32_t* index = nullptr;
-	indexResource_->Map(0u, nullptr, reinterpret_cast<void**>(&index));
-	std::memcpy(index, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
-	indexResource_->Unmap(0u, nullptr);
+Elysia::Model::DrawTransform Elysia::Model::MakeDrawTransform(const WorldTransform& worldTransform) {
+	//スケール0で描画しない時は定数バッファに書き込まない
+	bool isInvisible = (worldTransform.scale.x == 0.0f && worldTransform.scale.y == 0.0f && worldTransform.scale.z == 0.0f);
+	DrawTransform drawTransform = {
+		.address = (isInvisible == true) ? 0u : worldTransform.GetGPUVirtualAddress(),
+		.worldPosition = worldTransform.GetWorldPosition(),
+		.scale = worldTransform.scale,
+	};
+	return drawTransform;
+}
 
+Elysia::Model::DrawTransform Elysia::Model::MakeDrawTransform(const TransformHierarchy& transformHierarchy, const uint32_t& node) {
+	//フレームの初めにまとめて書き込んだ領域のアドレス
+	DrawTransform drawTransform = {
+		.address = transformHierarchy.GetConstantAddress(node),
+		.worldPosition = transformHierarchy.GetWorldPosition(node),
+		.scale = transformHierarchy.GetScale(node),
+	};
+	return drawTransform;
+}
 
+Elysia::Model::DrawCommand Elysia::Model::CreateDrawCommand(const DrawTransform& drawTransform, const Camera& camera, const Material& material) {
 	//PixelShaderに送る方のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraForGPU_));
-	cameraForGPU_->worldPosition = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	//描画ごとに変わるのでフレームごとの定数バッファに書き込む
+	CameraForGPU cameraForGPU = {
+		.worldPosition = camera.GetWorldPosition(),
+	};
+
+	//遠ければ細かいミップは要らない
+	float distance = SingleCalculation::Length(VectorCalculation::Subtract(drawTransform.worldPosition, camera.GetWorldPosition()));
+	textureManager_->RequestMipFromDistance(textureHandle_, distance);
+
+	//定数バッファのアドレスはメインスレッドで決めておく
+	//(GetGPUVirtualAddressで今のフレームの領域に書き込まれる為)
+	DrawCommand drawCommand = {
+		.materialAddress = material.resource.GetGPUVirtualAddress(),
+		.worldTransformAddress = drawTransform.address,
+		.cameraAddress = camera.GetGPUVirtualAddress(),
+		.cameraPositionAddress = constantBufferManager_->Push(cameraForGPU),
+		.lightRootParameterIndex = 0u,
+		.lightAddress = 0u,
+		.isEnviromentMap = material.isEnviromentMap,
+	};
+	return drawCommand;
+}
 
+void Elysia::Model::SubmitDrawCommand(const DrawCommand& drawCommand) {
+	//パスの途中であれば後で他のスレッドで積む
+	ParallelCommandRecorder* parallelCommandRecorder = directXSetup_->GetParallelCommandRecorder();
+	if (parallelCommandRecorder->GetIsInPass() == true) {
+		parallelCommandRecorder->Push([this, drawCommand]() {
+			RecordDrawCommand(drawCommand);
+		});
+		return;
+	}
 
+	RecordDrawCommand(drawCommand);
+}
 
+void Elysia::Model::RecordDrawCommand(const DrawCommand& drawCommand) const {
+	//記録するスレッドのコマンドリスト
+	ComPtr<ID3D12GraphicsCommandList> commandList = directXSetup_->GetCommandList();
 
 	//コマンドを積む
-	//PSOの設定
-	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetModelRootSignature().Get());
-	directXSetup_->GetCommandList()->SetPipelineState(pipelineManager_->GetModelGraphicsPipelineState().Get());
-
+	//パイプラインの設定
+	commandList->SetGraphicsRootSignature(pipelineManager_->GetModelRootSignature().Get());
+	commandList->SetPipelineState(pipelineManager_->GetModelGraphicsPipelineState().Get());
 	//RootSignatureを設定。PSOに設定しているけど別途設定が必要
-	directXSetup_->GetCommandList()->IASetVertexBuffers(0u, 1u, &vertexBufferView_);
+	commandList->IASetVertexBuffers(0u, 1u, &vertexBufferView_);
 	//IBVを設定
-	directXSetup_->GetCommandList()->IASetIndexBuffer(&indexBufferView_);
-
+	commandList->IASetIndexBuffer(&indexBufferView_);
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
-	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-
-
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//Material
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
-
-
+	commandList->SetGraphicsRootConstantBufferView(0u, drawCommand.materialAddress);
 	//資料見返してみたがhlsl(GPU)に計算を任せているわけだった
 	//コマンド送ってGPUで計算
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, worldTransform.resource->GetGPUVirtualAddress());
-
-
+	commandList->SetGraphicsRootConstantBufferView(1u, drawCommand.worldTransformAddress);
 	//SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
-
+	//ライト
+	if (drawCommand.lightRootParameterIndex != 0u) {
+		commandList->SetGraphicsRootConstantBufferView(drawCommand.lightRootParameterIndex, drawCommand.lightAddress);
+	}
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, camera.resource->GetGPUVirtualAddress());
-
+	commandList->SetGraphicsRootConstantBufferView(4u, drawCommand.cameraAddress);
 	//PixelShaderに送る方のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
-
-	//SpotLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(7u, spotLight.resource->GetGPUVirtualAddress());
-
-	//環境マッピングの設定
-	if (material.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
+	commandList->SetGraphicsRootConstantBufferView(5u, drawCommand.cameraPositionAddress);
+	//環境マップ用のテクスチャ
+	if (drawCommand.isEnviromentMap == true && eviromentTextureHandle_ != 0u) {
 		srvManager_->SetGraphicsRootDescriptorTable(8u, eviromentTextureHandle_);
 	}
-
-
 	//DrawCall
-	directXSetup_->GetCommandList()->DrawIndexedInstanced(UINT(modelData_.indices.size()), 1u, 0u, 0u, 0u);
+	commandList->DrawIndexedInstanced(UINT(modelData_.indices.size()), 1u, 0u, 0u, 0u);
 
-}
\ No newline at end of file
+}
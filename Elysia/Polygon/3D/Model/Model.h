@@ -8,6 +8,7 @@
 #include "DirectXSetup.h"
 
 #include "Matrix4x4.h"
+#include "Vector3.h"
 #include "Vector4.h"
 #include "TransformationMatrix.h"
 #include "Matrix4x4Calculation.h"
@@ -72,6 +73,11 @@ namespace Elysia {
 	/// </summary>
 	class PipelineManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 	/// <summary>
 	/// SRV管理クラス
 	/// </summary>
@@ -87,6 +93,11 @@ namespace Elysia {
 	/// </summary>
 	class ModelManager;
 
+	/// <summary>
+	/// 親子関係のあるトランスフォームをまとめて更新するクラス
+	/// </summary>
+	class TransformHierarchy;
+
 
 	/// <summary>
 	/// モデル
@@ -139,11 +150,51 @@ namespace Elysia {
 		/// <param name="spotLight"></param>
 		void Draw(const WorldTransform& worldTransform, const Camera& camera, const Material& material, const SpotLight& spotLight);
 
+		/// <summary>
+		/// 描画
+		/// 定数はTransformHierarchyがフレームごとにまとめて書き込んだものを使う
+		/// </summary>
+		/// <param name="transformHierarchy">トランスフォーム</param>
+		/// <param name="node">番号</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		void Draw(const TransformHierarchy& transformHierarchy, const uint32_t& node, const Camera& camera, const Material& material);
+
+		/// <summary>
+		/// 描画
+		/// </summary>
+		/// <param name="transformHierarchy">トランスフォーム</param>
+		/// <param name="node">番号</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		/// <param name="directionalLight">平行光源</param>
+		void Draw(const TransformHierarchy& transformHierarchy, const uint32_t& node, const Camera& camera, const Material& material, const DirectionalLight& directionalLight);
+
+		/// <summary>
+		/// 描画
+		/// </summary>
+		/// <param name="transformHierarchy">トランスフォーム</param>
+		/// <param name="node">番号</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		/// <param name="pointLight">点光源</param>
+		void Draw(const TransformHierarchy& transformHierarchy, const uint32_t& node, const Camera& camera, const Material& material, const PointLight& pointLight);
+
+		/// <summary>
+		/// 描画
+		/// </summary>
+		/// <param name="transformHierarchy">トランスフォーム</param>
+		/// <param name="node">番号</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		/// <param name="spotLight">スポットライト</param>
+		void Draw(const TransformHierarchy& transformHierarchy, const uint32_t& node, const Camera& camera, const Material& material, const SpotLight& spotLight);
+
 
 		/// <summary>
 		/// デストラクタ
 		/// </summary>
-		~Model() = default;
+		~Model();
 
 
 	public:
@@ -157,6 +208,113 @@ namespace Elysia {
 			this->eviromentTextureHandle_ = textureHandle;
 		}
 
+	private:
+		/// <summary>
+		/// 描画に使うもの
+		/// メインスレッドで集めて、コマンドはどのスレッドからでも積めるようにする
+		/// </summary>
+		struct DrawCommand {
+			//マテリアル
+			D3D12_GPU_VIRTUAL_ADDRESS materialAddress;
+			//ワールドトランスフォーム
+			D3D12_GPU_VIRTUAL_ADDRESS worldTransformAddress;
+			//カメラ
+			D3D12_GPU_VIRTUAL_ADDRESS cameraAddress;
+			//PixelShaderに送る方のカメラ
+			D3D12_GPU_VIRTUAL_ADDRESS cameraPositionAddress;
+			//ライトのルートパラメータの番号(0だと設定しない)
+			UINT lightRootParameterIndex;
+			//ライト
+			D3D12_GPU_VIRTUAL_ADDRESS lightAddress;
+			//環境マップを使うかどうか
+			bool isEnviromentMap;
+		};
+
+		/// <summary>
+		/// 描画する物のトランスフォーム
+		/// WorldTransformとTransformHierarchyのどちらからでも作れるようにする
+		/// </summary>
+		struct DrawTransform {
+			//定数バッファ
+			D3D12_GPU_VIRTUAL_ADDRESS address;
+			//ワールド座標
+			Vector3 worldPosition;
+			//スケール
+			Vector3 scale;
+		};
+
+		/// <summary>
+		/// 描画
+		/// </summary>
+		/// <param name="drawTransform">トランスフォーム</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		void Draw(const DrawTransform& drawTransform, const Camera& camera, const Material& material);
+
+		/// <summary>
+		/// 描画(平行光源)
+		/// </summary>
+		/// <param name="drawTransform">トランスフォーム</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		/// <param name="directionalLight">平行光源</param>
+		void Draw(const DrawTransform& drawTransform, const Camera& camera, const Material& material, const DirectionalLight& directionalLight);
+
+		/// <summary>
+		/// 描画(点光源)
+		/// </summary>
+		/// <param name="drawTransform">トランスフォーム</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		/// <param name="pointLight">点光源</param>
+		void Draw(const DrawTransform& drawTransform, const Camera& camera, const Material& material, const PointLight& pointLight);
+
+		/// <summary>
+		/// 描画(スポットライト)
+		/// </summary>
+		/// <param name="drawTransform">トランスフォーム</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		/// <param name="spotLight">スポットライト</param>
+		void Draw(const DrawTransform& drawTransform, const Camera& camera, const Material& material, const SpotLight& spotLight);
+
+		/// <summary>
+		/// WorldTransformから作る
+		/// </summary>
+		/// <param name="worldTransform">ワールドトランスフォーム</param>
+		/// <returns>トランスフォーム</returns>
+		static DrawTransform MakeDrawTransform(const WorldTransform& worldTransform);
+
+		/// <summary>
+		/// TransformHierarchyから作る
+		/// </summary>
+		/// <param name="transformHierarchy">トランスフォーム</param>
+		/// <param name="node">番号</param>
+		/// <returns>トランスフォーム</returns>
+		static DrawTransform MakeDrawTransform(const TransformHierarchy& transformHierarchy, const uint32_t& node);
+
+		/// <summary>
+		/// 描画に使うものを集める
+		/// </summary>
+		/// <param name="drawTransform">トランスフォーム</param>
+		/// <param name="camera">カメラ</param>
+		/// <param name="material">マテリアル</param>
+		/// <returns>描画に使うもの</returns>
+		DrawCommand CreateDrawCommand(const DrawTransform& drawTransform, const Camera& camera, const Material& material);
+
+		/// <summary>
+		/// 描画を出す
+		/// パスの途中であれば並列記録に回す
+		/// </summary>
+		/// <param name="drawCommand">描画に使うもの</param>
+		void SubmitDrawCommand(const DrawCommand& drawCommand);
+
+		/// <summary>
+		/// コマンドを積む
+		/// </summary>
+		/// <param name="drawCommand">描画に使うもの</param>
+		void RecordDrawCommand(const DrawCommand& drawCommand) const;
+
 
 
 	private:
@@ -170,6 +328,8 @@ namespace Elysia {
 		Elysia::PipelineManager* pipelineManager_ = nullptr;
 		//SRV管理クラス
 		Elysia::SrvManager* srvManager_ = nullptr;
+		//定数バッファ管理クラス
+		Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 
 	private:
 		//頂点リソース
@@ -183,12 +343,6 @@ namespace Elysia {
 		D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
 
 
-		//カメラリソース
-		ComPtr<ID3D12Resource> cameraResource_ = nullptr;
-		//PixelShaderにカメラの座標を送る為の変数
-		CameraForGPU* cameraForGPU_ = {};
-
-
 		//テクスチャハンドル
 		uint32_t textureHandle_ = 0u;
 
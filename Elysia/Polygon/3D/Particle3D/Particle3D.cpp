@@ -9,16 +9,15 @@
 #include "PipelineManager.h"
 #include "ModelManager.h"
 #include "SrvManager.h"
+#include "ConstantBufferManager.h"
+#include "GameClock.h"
 
 #include "Material.h"
 #include "DirectionalLight.h"
 #include "PointLight.h"
 #include "SpotLight.h"
 #include "VectorCalculation.h"
-
-
-//静的メンバ変数の初期化
-std::map<uint32_t, Elysia::Particle3D::InstancingData> Elysia::Particle3D::instancingManegimentMap_ = {};
+#include "Profiler.h"
 
 
 Elysia::Particle3D::Particle3D() {
@@ -31,6 +30,8 @@ Elysia::Particle3D::Particle3D() {
 	directXSetup_ = Elysia::DirectXSetup::GetInstance();
 	//SRV管理クラス
 	srvManager_ = Elysia::SrvManager::GetInstance();
+	//定数バッファ管理クラス
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 	//パイプライン管理クラス
 	pipelineManager_ = Elysia::PipelineManager::GetInstance();
 
@@ -64,23 +65,10 @@ std::unique_ptr<Elysia::Particle3D> Elysia::Particle3D::Create(const uint32_t& m
 	particle3D->vertexResource_->Unmap(0u, nullptr);
 
 	//インスタンシング
-	particle3D->instancingResource_ = particle3D->directXSetup_->CreateBufferResource(sizeof(ParticleForGPU) * particle3D->MAX_INSTANCE_NUMBER_);
-	//SRVを作る
-	//すでに作られているものだったらそこから取り出しSRVの上限突破を防ぐ
-	auto it = instancingManegimentMap_.find(modelHandle);
-	if (it != instancingManegimentMap_.end()) {
-		particle3D->instancingIndex_= it->second.srvIndex;
-	}
-	else {
-		particle3D->instancingIndex_ = particle3D->srvManager_->Allocate();
-		particle3D->srvManager_->CreateSRVForStructuredBuffer(particle3D->instancingIndex_, particle3D->instancingResource_.Get(), particle3D->MAX_INSTANCE_NUMBER_, sizeof(ParticleForGPU));
-		instancingManegimentMap_.try_emplace(modelHandle, particle3D->instancingIndex_);
-	}
-	//書き込み
-	particle3D->instancingResource_->Map(0u, nullptr, reinterpret_cast<void**>(&particle3D->particleForGpuData_));
+	//破棄する時に解放するので作り続けても上限には届かない
+	particle3D->particleForGpuData_.resize(particle3D->MAX_INSTANCE_NUMBER_);
+	particle3D->instancingBuffer_.Initialize(particle3D->MAX_INSTANCE_NUMBER_, sizeof(ParticleForGPU));
 
-	//カメラ
-	particle3D->cameraResource_ = particle3D->directXSetup_->CreateBufferResource(sizeof(Vector3));
 
 
 	return particle3D;
@@ -124,34 +112,22 @@ std::unique_ptr<Elysia::Particle3D> Elysia::Particle3D::Create(const uint32_t& m
 
 
 	//インスタンシング
-	particle3D->instancingResource_ = particle3D->directXSetup_->CreateBufferResource(sizeof(ParticleForGPU) * particle3D->MAX_INSTANCE_NUMBER_);
-	//SRVを作る
-	//すでに作られているものだったらそこから取り出しSRVの上限突破を防ぐ
-	auto it = instancingManegimentMap_.find(modelHandle);
-	if (it != instancingManegimentMap_.end()) {
-		//particle3D->instancingResource_ = it->second.resource;
-		particle3D->instancingIndex_ = it->second.srvIndex;
-	}
-	else {
-		particle3D->instancingResource_ = particle3D->directXSetup_->CreateBufferResource(sizeof(ParticleForGPU) * particle3D->MAX_INSTANCE_NUMBER_);
-		particle3D->instancingIndex_ = particle3D->srvManager_->Allocate();
-		particle3D->srvManager_->CreateSRVForStructuredBuffer(particle3D->instancingIndex_, particle3D->instancingResource_.Get(), particle3D->MAX_INSTANCE_NUMBER_, sizeof(ParticleForGPU));
-		//新しいデータ
-		//ComPtr<ID3D12Resource> resource = particle3D->instancingResource_;
-		//InstancingData instancingData = { .resource = resource ,.srvIndex = particle3D->instancingIndex_ };
-		//挿入
-		//instancingManegimentMap_.try_emplace(modelHandle, instancingData);
-	}
-	//書き込み
-	particle3D->instancingResource_->Map(0u, nullptr, reinterpret_cast<void**>(&particle3D->particleForGpuData_));
-	//カメラ
-	particle3D->cameraResource_ = particle3D->directXSetup_->CreateBufferResource(sizeof(Vector3));
+	//破棄する時に解放するので作り続けても上限には届かない
+	particle3D->particleForGpuData_.resize(particle3D->MAX_INSTANCE_NUMBER_);
+	particle3D->instancingBuffer_.Initialize(particle3D->MAX_INSTANCE_NUMBER_, sizeof(ParticleForGPU));
 
 
 	return particle3D;
 
 }
 
+Elysia::Particle3D::~Particle3D() {
+	//インスタンシング用のバッファは自分で解放する
+	//GPUが今のフレームを使い終わってから使い回される
+	instancingBuffer_.Release();
+	directXSetup_->DeferRelease(std::move(vertexResource_));
+}
+
 ParticleInformation Elysia::Particle3D::MakeNewParticle(std::mt19937& randomEngine) {
 
 	//ランダムの値で位置を決める
@@ -203,6 +179,15 @@ std::list<ParticleInformation> Elysia::Particle3D::Emission(const Emitter& emmit
 }
 
 void Elysia::Particle3D::Update(const Camera& camera) {
+	ELYSIA_PROFILE_SCOPE("Particle3D::Update");
+
+	//このフレームの時間
+	//描画から呼ばれるので、固定の間隔ではなく描画するフレームの時間で進める
+	const GameClock* gameClock = GameClock::GetInstance();
+	float deltaTime = gameClock->GetDeltaTime();
+	//固定の間隔(60FPSの1フレーム)を1とした進み具合
+	//移動量は1フレーム分で決めているので、これを掛けてフレームレートに依らないようにする
+	float frameRatio = deltaTime / gameClock->GetFixedDeltaTime();
 
 	//ランダムエンジン
 	std::random_device seedGenerator;
@@ -218,7 +203,7 @@ void Elysia::Particle3D::Update(const Camera& camera) {
 	}
 	else {
 		//時間経過
-		emitter_.frequencyTime += DELTA_TIME;
+		emitter_.frequencyTime += deltaTime;
 		//頻度より大きいなら
 		if (emitter_.frequency <= emitter_.frequencyTime) {
 			//パーティクルを作る
@@ -245,7 +230,7 @@ void Elysia::Particle3D::Update(const Camera& camera) {
 
 		//加速
 		float accel = -0.001f;
-		particleIterator->currentTime += DELTA_TIME;
+		particleIterator->currentTime += deltaTime;
 
 		switch (moveType_) {
 		case ParticleMoveType::NormalRelease:
@@ -259,7 +244,7 @@ void Elysia::Particle3D::Update(const Camera& camera) {
 			}
 
 			
-			particleIterator->transform.translate.y += 0.0001f;
+			particleIterator->transform.translate.y += 0.0001f * frameRatio;
 			
 			//Y軸でπ/2回転
 			backToFrontMatrix = Matrix4x4Calculation::MakeRotateYMatrix(std::numbers::pi_v<float>);
@@ -312,12 +297,12 @@ void Elysia::Particle3D::Update(const Camera& camera) {
 			//強制的にビルボードにするよ
 
 			
-			velocityY_ += accel;
+			velocityY_ += accel * frameRatio;
 
 			//加速を踏まえた位置計算
-			particleIterator->transform.translate.x += particleIterator->velocity.x / 3.0f;
-			particleIterator->transform.translate.y += velocityY_;
-			particleIterator->transform.translate.z += particleIterator->velocity.z / 3.0f;
+			particleIterator->transform.translate.x += particleIterator->velocity.x / 3.0f * frameRatio;
+			particleIterator->transform.translate.y += velocityY_ * frameRatio;
+			particleIterator->transform.translate.z += particleIterator->velocity.z / 3.0f * frameRatio;
 
 			//Y軸でπ/2回転
 			backToFrontMatrix = Matrix4x4Calculation::MakeRotateYMatrix(std::numbers::pi_v<float>);
@@ -479,6 +464,9 @@ void Elysia::Particle3D::Update(const Camera& camera) {
 			return particle.isInvisible == true;
 		});
 	}
+
+	//今のフレームのバッファに書き込む
+	instancingBuffer_.Write(particleForGpuData_.data(), sizeof(ParticleForGPU) * numInstance_);
 }
 
 void Elysia::Particle3D::Draw(const Camera& camera,const Material& material){
@@ -488,9 +476,7 @@ void Elysia::Particle3D::Draw(const Camera& camera,const Material& material){
 	Update(camera);
 
 	//PS用のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraPositionData_));
-	*cameraPositionData_ = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(camera.GetWorldPosition());
 
 	//コマンドを積む
 	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetParticle3DRootSignature().Get());
@@ -501,17 +487,17 @@ void Elysia::Particle3D::Draw(const Camera& camera,const Material& material){
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//CBVを設定する
 	//マテリアル
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//インスタンシング
-	srvManager_->SetGraphicsRootDescriptorTable(1u, instancingIndex_);
+	srvManager_->SetGraphicsRootDescriptorTable(1u, instancingBuffer_.GetSrvIndex());
 	//テクスチャ
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, camera.GetGPUVirtualAddress());
 	//PS用のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 	//DrawCall
 	directXSetup_->GetCommandList()->DrawInstanced(UINT(vertices_.size()), numInstance_, 0u, 0u);
 }
@@ -527,9 +513,7 @@ void Elysia::Particle3D::Draw(const Camera& camera,const  Material& material,con
 	Update(camera);
 
 	//PS用のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraPositionData_));
-	*cameraPositionData_ = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(camera.GetWorldPosition());
 
 	//コマンドを積む
 	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetParticle3DRootSignature().Get());
@@ -540,19 +524,19 @@ void Elysia::Particle3D::Draw(const Camera& camera,const  Material& material,con
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//CBVを設定する
 	//マテリアル
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//インスタンシング
-	srvManager_->SetGraphicsRootDescriptorTable(1u, instancingIndex_);
+	srvManager_->SetGraphicsRootDescriptorTable(1u, instancingBuffer_.GetSrvIndex());
 	//テクスチャ
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, camera.GetGPUVirtualAddress());
 	//平行光源
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, directionalLight.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(4u, directionalLight.resource.GetGPUVirtualAddress());
 	//PS用のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 
 	//DrawCall
 	directXSetup_->GetCommandList()->DrawInstanced(UINT(vertices_.size()), numInstance_, 0u, 0u);
@@ -569,9 +553,7 @@ void Elysia::Particle3D::Draw(const Camera& camera, const Material& material, co
 	Update(camera);
 
 	//PS用のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraPositionData_));
-	*cameraPositionData_ = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(camera.GetWorldPosition());
 	//コマンドを積む
 	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetParticle3DRootSignature().Get());
 	directXSetup_->GetCommandList()->SetPipelineState(pipelineManager_->GetParticle3DGraphicsPipelineState().Get());
@@ -583,20 +565,20 @@ void Elysia::Particle3D::Draw(const Camera& camera, const Material& material, co
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//CBVを設定する
 	//マテリアル
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//インスタンシング
-	srvManager_->SetGraphicsRootDescriptorTable(1u, instancingIndex_);
+	srvManager_->SetGraphicsRootDescriptorTable(1u, instancingBuffer_.GetSrvIndex());
 	//テクスチャ
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
 
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, camera.GetGPUVirtualAddress());
 	//PS用のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 	//点光源
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(6u, pointLight.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(6u, pointLight.resource.GetGPUVirtualAddress());
 	//DrawCall
 	directXSetup_->GetCommandList()->DrawInstanced(UINT(vertices_.size()), numInstance_, 0u, 0u);
 
@@ -612,9 +594,7 @@ void Elysia::Particle3D::Draw(const Camera& camera, const Material& material, co
 	Update(camera);
 
 	//PS用のカメラ
-	cameraResource_->Map(0u, nullptr, reinterpret_cast<void**>(&cameraPositionData_));
-	*cameraPositionData_ = camera.GetWorldPosition();
-	cameraResource_->Unmap(0u, nullptr);
+	D3D12_GPU_VIRTUAL_ADDRESS cameraAddress = constantBufferManager_->Push(camera.GetWorldPosition());
 
 
 	//コマンドを積む
@@ -626,19 +606,19 @@ void Elysia::Particle3D::Draw(const Camera& camera, const Material& material, co
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//CBVを設定する
 	//マテリアル
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, material.resource.GetGPUVirtualAddress());
 	//インスタンシング
-	srvManager_->SetGraphicsRootDescriptorTable(1u, instancingIndex_);
+	srvManager_->SetGraphicsRootDescriptorTable(1u, instancingBuffer_.GetSrvIndex());
 	//テクスチャ
 	if (textureHandle_ != 0u) {
 		textureManager_->GraphicsCommand(2u, textureHandle_);
 	}
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(3u, camera.GetGPUVirtualAddress());
 	//PS用のカメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(5u, cameraAddress);
 	//SpotLight
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(7u, spotLight.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(7u, spotLight.resource.GetGPUVirtualAddress());
 	//DrawCall
 	directXSetup_->GetCommandList()->DrawInstanced(UINT(vertices_.size()), numInstance_, 0u, 0u);
 
@@ -21,6 +21,7 @@
 #include "DirectXSetup.h"
 #include "Emitter.h"
 #include "ParticleMoveType.h"
+#include "FrameBufferedStructuredBuffer.h"
 
 #pragma region 前方宣言
 
@@ -62,6 +63,11 @@ namespace Elysia {
 	/// </summary>
 	class SrvManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 	/// <summary>
 	/// パイプライン管理クラス
 	/// </summary>
@@ -164,7 +170,7 @@ namespace Elysia {
 		/// <summary>
 		/// デストラクタ
 		/// </summary>
-		~Particle3D() = default;
+		~Particle3D();
 
 	public:
 		/// <summary>
@@ -288,25 +294,12 @@ namespace Elysia {
 		Elysia::DirectXSetup* directXSetup_ = nullptr;
 		//SRV管理クラス
 		Elysia::SrvManager* srvManager_ = nullptr;
+		//定数バッファ管理クラス
+		Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 		//パイプライン管理クラス
 		Elysia::PipelineManager* pipelineManager_ = nullptr;
 
 
-	private:
-		/// <summary>
-		/// インスタンシングの情報
-		/// </summary>
-		struct InstancingData {
-			//ComPtr<ID3D12Resource> resource;
-			//SRV用のインデックス
-			int srvIndex;
-		};
-
-	private:
-		//時間変化
-		const float DELTA_TIME = 1.0f / 60.0f;
-
-
 	private:
 
 		//頂点リソースを作る
@@ -317,10 +310,6 @@ namespace Elysia {
 		std::vector<VertexData> vertices_={};
 
 		//カメラ
-		//リソース
-		ComPtr<ID3D12Resource>cameraResource_ = nullptr;
-		//カメラデータ
-		Vector3* cameraPositionData_ = {};
 		//座標
 		Vector3 cameraPosition_ = {};
 
@@ -329,17 +318,15 @@ namespace Elysia {
 		const uint32_t MAX_INSTANCE_NUMBER_ = 1000u;
 		//描画すべきインスタンス数
 		uint32_t numInstance_ = 0u;
-		//インスタンスのインデックス
-		int instancingIndex_ = 0;
-		//インスタンスリソース
-		ComPtr<ID3D12Resource> instancingResource_ = nullptr;
-		//インスタンシング用のSRV管理変数
-		static std::map<uint32_t, InstancingData> instancingManegimentMap_;
+		//インスタンシング用のバッファ
+		//GPUが前のフレームで読んでいる間に書き換えないようにフレームの数だけ持ち、破棄する時に解放する
+		FrameBufferedStructuredBuffer instancingBuffer_;
 		
 		//パーティクル
 		std::list<ParticleInformation>particles_;
 		//パーティクルデータ
-		ParticleForGPU* particleForGpuData_ = nullptr;
+		//更新の最後にinstancingBuffer_へまとめて書き込む
+		std::vector<ParticleForGPU> particleForGpuData_ = {};
 
 		//エミッタの設定
 		Emitter emitter_ = {};
@@ -20,7 +20,7 @@ void ParticleEmitter::Initialize(){
 
 void ParticleEmitter::Update(){
 	///時間経過
-	//newEmitter_.frequencyTime += DELTA_TIME;
+	//newEmitter_.frequencyTime += Elysia::GameClock::GetInstance()->GetFixedDeltaTime();
 	//頻度より大きいなら
 	//if (newEmitter_.frequency <= newEmitter_.frequencyTime) {
 		
@@ -41,7 +41,6 @@ public:
 private:
 	//エミッタの設定
 	//Emitter newEmitter_ = {};
-	const float DELTA_TIME = 1.0f / 60.0f;
 
 	Vector3 transform_ = {};
 	std::string name_ = {};
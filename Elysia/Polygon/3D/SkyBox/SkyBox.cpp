@@ -16,6 +16,13 @@ Elysia::SkyBox::SkyBox(){
 	pipelineManager_ = Elysia::PipelineManager::GetInstance();
 }
 
+Elysia::SkyBox::~SkyBox() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(vertexResource_));
+	directXSetup_->DeferRelease(std::move(indexResource_));
+	directXSetup_->DeferRelease(std::move(materialResource_));
+}
+
 //初期化
 void Elysia::SkyBox::Create() {
 
@@ -86,6 +93,12 @@ void Elysia::SkyBox::Create() {
 
 	////マテリアル用のリソースを作る。今回はcolor1つ分のサイズを用意する
 	materialResource_= DirectXSetup::GetInstance()->CreateBufferResource(sizeof(SkyBoxMaterial));
+	//マテリアルにデータを書き込む
+	//値は変化しないので初期化時に一度だけ書き込む
+	materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
+	materialData_->color = {.x = 1.0f,.y = 1.0f,.z = 1.0f,.w = 1.0f};
+	materialData_->uvTransform = Matrix4x4Calculation::MakeIdentity4x4();
+	materialResource_->Unmap(0u, nullptr);
 
 }
 
@@ -93,14 +106,6 @@ void Elysia::SkyBox::Create() {
 
 void Elysia::SkyBox::Draw(const uint32_t& texturehandle, const WorldTransform& worldTransform, const Camera& camera) {
 
-	//マテリアルにデータを書き込む
-	//書き込むためのアドレスを取得
-	//reinterpret_cast...char* から int* へ、One_class* から Unrelated_class* へなどの変換に使用
-	materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
-	materialData_->color = {.x = 1.0f,.y = 1.0f,.z = 1.0f,.w = 1.0f};
-	materialData_->uvTransform = Matrix4x4Calculation::MakeIdentity4x4();
-	materialResource_->Unmap(0u, nullptr);
-	
 	//パイプラインの設定
 	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetSkyBoxRootSignature().Get());
 	directXSetup_->GetCommandList()->SetPipelineState(pipelineManager_->GetSkyBoxGraphicsPipelineState().Get());
@@ -110,9 +115,9 @@ void Elysia::SkyBox::Draw(const uint32_t& texturehandle, const WorldTransform& w
 	//RootSignatureを設定。PSOに設定しているけど別途設定が必要
 	directXSetup_->GetCommandList()->IASetVertexBuffers(0u, 1u, &vertexBufferView_);
 	//ワールドトランスフォーム
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, worldTransform.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, worldTransform.GetGPUVirtualAddress());
 	//カメラ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, camera.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, camera.GetGPUVirtualAddress());
 	//テクスチャ
 	if (texturehandle != 0u) {
 		TextureManager::GetInstance()->GraphicsCommand(2u, texturehandle);
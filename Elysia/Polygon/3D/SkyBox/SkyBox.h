@@ -74,7 +74,7 @@ namespace Elysia {
 		/// <summary>
 		/// デストラクタ
 		/// </summary>
-		~SkyBox() = default;
+		~SkyBox();
 
 	private:
 
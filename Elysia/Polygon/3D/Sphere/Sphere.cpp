@@ -18,6 +18,14 @@ Elysia::Sphere::Sphere(){
 	directXSetup_ = Elysia::DirectXSetup::GetInstance();
 }
 
+Elysia::Sphere::~Sphere() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(vertexResourceSphere_));
+	directXSetup_->DeferRelease(std::move(materialResourceSphere_));
+	directXSetup_->DeferRelease(std::move(transformationMatrixResourceSphere_));
+	directXSetup_->DeferRelease(std::move(directionalLightResource_));
+}
+
 //初期化
 void Elysia::Sphere::Initialize() {
 	
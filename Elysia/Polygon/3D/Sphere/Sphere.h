@@ -64,7 +64,7 @@ namespace Elysia {
 		/// <summary>
 		/// デストラクタ
 		/// </summary>
-		~Sphere() = default;
+		~Sphere();
 
 
 	private:
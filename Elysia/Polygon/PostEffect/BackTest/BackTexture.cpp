@@ -6,6 +6,7 @@
 #include "TextureManager.h"
 #include "SrvManager.h"
 #include "RtvManager.h"
+#include "ConstantBufferManager.h"
 
 Elysia::BackTexture::BackTexture() {
 	//ウィンドウクラスの取得
@@ -16,17 +17,23 @@ Elysia::BackTexture::BackTexture() {
 	rtvManager_ = Elysia::RtvManager::GetInstance();
 	//SRV管理クラスの取得
 	srvManager_ = Elysia::SrvManager::GetInstance();
+	//定数バッファ管理クラス
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 	//パイプライン管理クラスの取得
 	pipelineManager_ = Elysia::PipelineManager::GetInstance();
 }
 
+Elysia::BackTexture::~BackTexture() {
+	//GPUが今のフレームを使い終わってから解放する
+	directXSetup_->DeferRelease(std::move(vignetteResource_));
+	directXSetup_->DeferRelease(std::move(gaussianFilterResource_));
+	directXSetup_->DeferRelease(std::move(rtvResource_));
+}
+
 void Elysia::BackTexture::Initialize(){
 
 	//エフェクトの種類を設定
 	effectType_ = NoneEffect;
-	//Effect
-	effectResource_ = directXSetup_->CreateBufferResource(sizeof(int32_t));
-	
 	//Vignette
 	vignetteResource_ = directXSetup_->CreateBufferResource(sizeof(VignetteInformation));
 	vignetteInformation_.pow = 0.8f;
@@ -55,8 +62,7 @@ void Elysia::BackTexture::PreDraw(){
 	
 	//RTの設定
 	const float RENDER_TARGET_CLEAR_VALUE[] = { color_.x,color_.y,color_.z,color_.w };
-	directXSetup_->GetCommandList()->OMSetRenderTargets(
-		1, &rtvManager_->GetRtvHandle(rtvHandle_), false, &directXSetup_->GetDsvHandle());
+	directXSetup_->SetRenderTarget(rtvManager_->GetRtvHandle(rtvHandle_));
 
 	//RTVのクリア
 	directXSetup_->GetCommandList()->ClearRenderTargetView(
@@ -92,12 +98,9 @@ void Elysia::BackTexture::Draw(){
 	ImGui::End();
 #endif
 
-	//書き込むためのアドレスを取得
-	//reinterpret_cast...char* から int* へ、One_class* から Unrelated_class* へなどの変換に使用
-	effectResource_->Map(0u, nullptr, reinterpret_cast<void**>(&effectTypeData_));
 	//選択したEffectTypeを書き込み
-	*effectTypeData_ = effectType_;
-	effectResource_->Unmap(0u, nullptr);
+	int32_t effectType = effectType_;
+	D3D12_GPU_VIRTUAL_ADDRESS effectTypeAddress = constantBufferManager_->Push(effectType);
 
 	//パイプラインの設定
 	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetFullScreenRootSignature().Get());
@@ -105,7 +108,7 @@ void Elysia::BackTexture::Draw(){
 	//形状を設定。PSOに設定しているものとはまた別。同じものを設定すると考えよう
 	directXSetup_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	//Effect
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, effectResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(0u, effectTypeAddress);
 	//Vignette
 	if (effectType_ == VignetteEffect) {
 		directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, vignetteResource_->GetGPUVirtualAddress());
@@ -35,6 +35,11 @@ namespace Elysia {
 	/// </summary>
 	class SrvManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 	/// <summary>
 	/// パイプライン管理クラス
 	/// </summary>
@@ -69,7 +74,7 @@ namespace Elysia {
 		/// <summary>
 		/// デストラクタ
 		/// </summary>
-		~BackTexture() = default;
+		~BackTexture();
 
 	private:
 		/// <summary>
@@ -129,15 +134,14 @@ namespace Elysia {
 		RtvManager* rtvManager_ = nullptr;;
 		//SRV管理クラス
 		SrvManager* srvManager_ = nullptr;
+		//定数バッファ管理クラス
+		ConstantBufferManager* constantBufferManager_ = nullptr;
 		//パイプライン管理クラス
 		PipelineManager* pipelineManager_ = nullptr;
 
 	private:
-		//リソース
-		ComPtr<ID3D12Resource> effectResource_ = nullptr;
-
+		//エフェクトの種類
 		int32_t effectType_ = NoneEffect;
-		int32_t* effectTypeData_ = nullptr;
 
 		//Vignette
 		ComPtr<ID3D12Resource> vignetteResource_ = nullptr;
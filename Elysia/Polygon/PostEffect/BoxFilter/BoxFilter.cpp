@@ -6,6 +6,7 @@
 #include "PipelineManager.h"
 #include "SrvManager.h"
 #include "RtvManager.h"
+#include "ConstantBufferManager.h"
 
 Elysia::BoxFilter::BoxFilter(){
 	//ウィンドウクラスの取得
@@ -18,12 +19,12 @@ Elysia::BoxFilter::BoxFilter(){
 	rtvManager_ = Elysia::RtvManager::GetInstance();
 	//SRV管理クラスの取得
 	srvManager_ = Elysia::SrvManager::GetInstance();
+	//定数バッファ管理クラス
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 }
 
 void Elysia::BoxFilter::Initialize(){
 
-	//リソース
-	boxFilterTypeResource_ = directXSetup_->CreateBufferResource(sizeof(BoxFilterType));
 	//型の設定
 	boxFilterType_ = BoxFilter3x3;
 	
@@ -47,8 +48,7 @@ void Elysia::BoxFilter::PreDraw(){
 	
 	//RT
 	const float RENDER_TARGET_CLEAR_VALUE[] = {color_.x, color_.y, color_.z, color_.w};
-	directXSetup_->GetCommandList()->OMSetRenderTargets(
-		1, &rtvManager_->GetRtvHandle(rtvHandle_), false, &directXSetup_->GetDsvHandle());
+	directXSetup_->SetRenderTarget(rtvManager_->GetRtvHandle(rtvHandle_));
 	//クリア
 	directXSetup_->GetCommandList()->ClearRenderTargetView(
 		rtvManager_->GetRtvHandle(rtvHandle_), RENDER_TARGET_CLEAR_VALUE, 0u, nullptr);
@@ -75,9 +75,9 @@ void Elysia::BoxFilter::Draw(){
 		D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
 	//BoxFilterの設定
-	boxFilterTypeResource_->Map(0u, nullptr, reinterpret_cast<void**>(&boxFilterTypeData_));
-	boxFilterTypeData_->type=boxFilterType_;
-	boxFilterTypeResource_->Unmap(0u, nullptr);
+	BoxFilterType boxFilterTypeData = {};
+	boxFilterTypeData.type=boxFilterType_;
+	D3D12_GPU_VIRTUAL_ADDRESS boxFilterTypeDataAddress = constantBufferManager_->Push(boxFilterTypeData);
 
 
 	//パイプラインの設定
@@ -88,7 +88,7 @@ void Elysia::BoxFilter::Draw(){
 	//SRV
 	srvManager_->SetGraphicsRootDescriptorTable(0u, srvHandle_);
 	//Type
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, boxFilterTypeResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, boxFilterTypeDataAddress);
 	//描画(DrawCall)３頂点で１つのインスタンス。
 	directXSetup_->GetCommandList()->DrawInstanced(3u, 1u, 0u, 0u);
 
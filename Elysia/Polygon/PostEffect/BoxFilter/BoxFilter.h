@@ -60,6 +60,11 @@ namespace Elysia {
 	/// </summary>
 	class SrvManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 
 	/// <summary>
 	/// ボックスフィルタ
@@ -112,12 +117,10 @@ namespace Elysia {
 		Elysia::RtvManager* rtvManager_ = nullptr;
 		//SRV管理クラス
 		Elysia::SrvManager* srvManager_ = nullptr;
+		//定数バッファ管理クラス
+		Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 
 	private:
-		//リソース
-		ComPtr<ID3D12Resource> boxFilterTypeResource_ = nullptr;
-		//データ
-		BoxFilterType* boxFilterTypeData_ = nullptr;
 		//型
 		uint32_t boxFilterType_ = BoxFilter3x3;
 
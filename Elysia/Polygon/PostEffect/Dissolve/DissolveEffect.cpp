@@ -43,8 +43,7 @@ void Elysia::DissolvePostEffect::PreDraw(){
 	
 	const float CLEAR_COLOR[] = { renderTargetClearColor_.x,renderTargetClearColor_.y,renderTargetClearColor_.z,renderTargetClearColor_.w };
 	//RT
-	directXSetup_->GetCommandList()->OMSetRenderTargets(
-		1u, &rtvManager_->GetRtvHandle(rtvHandle_), false, &directXSetup_->GetDsvHandle());
+	directXSetup_->SetRenderTarget(rtvManager_->GetRtvHandle(rtvHandle_));
 	//クリア
 	directXSetup_->GetCommandList()->ClearRenderTargetView(
 		rtvManager_->GetRtvHandle(rtvHandle_), CLEAR_COLOR, 0u, nullptr);
@@ -82,7 +81,7 @@ void Elysia::DissolvePostEffect::Draw(const Dissolve& dissolve){
 	//マスクテクスチャ
 	srvManager_->SetGraphicsRootDescriptorTable(1u, dissolve.maskTextureHandle);
 	//ディゾルブ
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(2u, dissolve.resource->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(2u, dissolve.resource.GetGPUVirtualAddress());
 	//描画(DrawCall)３頂点で１つのインスタンス。
 	directXSetup_->GetCommandList()->DrawInstanced(3u, 1u, 0u, 0u);
 	
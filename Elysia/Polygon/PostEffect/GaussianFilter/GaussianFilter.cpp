@@ -7,6 +7,7 @@
 #include "TextureManager.h"
 #include "SrvManager.h"
 #include "RtvManager.h"
+#include "ConstantBufferManager.h"
 
 
 
@@ -21,13 +22,13 @@ Elysia::GaussianFilter::GaussianFilter(){
 	rtvManager_ = Elysia::RtvManager::GetInstance();
 	//SRV管理クラスの取得
 	srvManager_ = Elysia::SrvManager::GetInstance();
+	//定数バッファ管理クラス
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 }
 
 void Elysia::GaussianFilter::Initialize(){
 
 	//Effect
-	//リソースの生成
-	boxFilterTypeResource_ = directXSetup_->CreateBufferResource(sizeof(GaussianFilterData));
 	sigma_ = 2.0f;
 	boxFilterType_ = GaussianFilter3x3;
 
@@ -52,8 +53,7 @@ void Elysia::GaussianFilter::Initialize(){
 void Elysia::GaussianFilter::PreDraw(){
 	
 	const float RENDER_TARGET_CLEAR_VALUE[] = { 1.0f,0.0f,0.0f,1.0f };
-	directXSetup_->GetCommandList()->OMSetRenderTargets(
-		1, &rtvManager_->GetRtvHandle(rtvHandle_), false, &directXSetup_->GetDsvHandle());
+	directXSetup_->SetRenderTarget(rtvManager_->GetRtvHandle(rtvHandle_));
 
 	directXSetup_->GetCommandList()->ClearRenderTargetView(
 		rtvManager_->GetRtvHandle(rtvHandle_), RENDER_TARGET_CLEAR_VALUE, 0, nullptr);
@@ -81,10 +81,10 @@ void Elysia::GaussianFilter::Draw(){
 		D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
 
-	boxFilterTypeResource_->Map(0u, nullptr, reinterpret_cast<void**>(&boxFilterTypeData_));
-	boxFilterTypeData_->sigma = sigma_;
-	boxFilterTypeData_->type = boxFilterType_;
-	boxFilterTypeResource_->Unmap(0u, nullptr);
+	GaussianFilterData gaussianFilterData = {};
+	gaussianFilterData.sigma = sigma_;
+	gaussianFilterData.type = boxFilterType_;
+	D3D12_GPU_VIRTUAL_ADDRESS gaussianFilterDataAddress = constantBufferManager_->Push(gaussianFilterData);
 
 	//パイプラインの設定
 	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelineManager_->GetGaussianFilterRootSignature().Get());
@@ -95,7 +95,7 @@ void Elysia::GaussianFilter::Draw(){
 	//SRV
 	srvManager_->SetGraphicsRootDescriptorTable(0u, srvHandle_);
 	//Effect
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, boxFilterTypeResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, gaussianFilterDataAddress);
 	//描画(DrawCall)３頂点で１つのインスタンス。
 	directXSetup_->GetCommandList()->DrawInstanced(3u, 1u, 0u, 0u);
 
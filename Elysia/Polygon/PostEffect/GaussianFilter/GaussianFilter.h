@@ -67,6 +67,11 @@ namespace Elysia {
 	/// </summary>
 	class SrvManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 
 	/// <summary>
 	/// ガウシアンフィルタ
@@ -111,11 +116,11 @@ namespace Elysia {
 		Elysia::RtvManager* rtvManager_ = nullptr;
 		//SRV管理クラス
 		Elysia::SrvManager* srvManager_ = nullptr;
+		//定数バッファ管理クラス
+		Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 
 	private:
-		//リソース
-		ComPtr<ID3D12Resource> boxFilterTypeResource_ = nullptr;
-		GaussianFilterData* boxFilterTypeData_ = nullptr;
+		//種類
 		int32_t boxFilterType_ = GaussianFilter3x3;
 		float sigma_ = 0.0f;
 
@@ -45,8 +45,7 @@ void Elysia::GrayScale::PreDraw() {
 
 	const float RENDER_TARGET_CLEAR_VALUE[] = { 1.0f,0.0f,0.0f,1.0f };
 	//RT
-	directXSetup_->GetCommandList()->OMSetRenderTargets(
-		1u, &rtvManager_->GetRtvHandle(rtvHandle_), false, &directXSetup_->GetDsvHandle());
+	directXSetup_->SetRenderTarget(rtvManager_->GetRtvHandle(rtvHandle_));
 	//クリア
 	directXSetup_->GetCommandList()->ClearRenderTargetView(
 		rtvManager_->GetRtvHandle(rtvHandle_), RENDER_TARGET_CLEAR_VALUE, 0u, nullptr);
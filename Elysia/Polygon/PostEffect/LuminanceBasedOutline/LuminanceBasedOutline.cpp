@@ -41,8 +41,7 @@ void Elysia::LuminanceBasedOutline::PreDraw(){
 	
 	const float RENDER_TARGET_CLEAR_VALUE[] = { 0.1f,0.1f,0.7f,1.0f };
 	//RT
-	directXSetup_->GetCommandList()->OMSetRenderTargets(
-		1u, &rtvManager_->GetRtvHandle(rtvHandle_), false, &directXSetup_->GetDsvHandle());
+	directXSetup_->SetRenderTarget(rtvManager_->GetRtvHandle(rtvHandle_));
 	//クリア
 	directXSetup_->GetCommandList()->ClearRenderTargetView(
 		rtvManager_->GetRtvHandle(rtvHandle_), RENDER_TARGET_CLEAR_VALUE, 0u, nullptr);
@@ -8,6 +8,7 @@
 #include "TextureManager.h"
 #include "SrvManager.h"
 #include "RtvManager.h"
+#include "ConstantBufferManager.h"
 
 
 Elysia::RandomEffect::RandomEffect(){
@@ -21,6 +22,8 @@ Elysia::RandomEffect::RandomEffect(){
 	rtvManager_ = Elysia::RtvManager::GetInstance();
 	//SRV管理クラスの取得
 	srvManager_ = Elysia::SrvManager::GetInstance();
+	//定数バッファ管理クラス
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 }
 
 void Elysia::RandomEffect::Initialize() {
@@ -47,8 +50,6 @@ void Elysia::RandomEffect::Initialize() {
 	randomEngine_ = randomEngine;
 
 	//ランダム
-	//リソース
-	randomValueResource_ = directXSetup_->CreateBufferResource(sizeof(RandomValue));
 	std::uniform_real_distribution<float> distribute(0.0f, 1.0f);
 	//値の生成
 	randomValue_.value = distribute(randomEngine_);
@@ -59,8 +60,7 @@ void Elysia::RandomEffect::PreDraw() {
 	
 	//RTの設定
 	const float RENDER_TARGET_CLEAR_VALUE[] = { 0.0f,0.0f,0.0f,1.0f };
-	directXSetup_->GetCommandList()->OMSetRenderTargets(
-		1u, &rtvManager_->GetRtvHandle(rtvHandle_), false, &directXSetup_->GetDsvHandle());
+	directXSetup_->SetRenderTarget(rtvManager_->GetRtvHandle(rtvHandle_));
 	//クリア
 	directXSetup_->GetCommandList()->ClearRenderTargetView(
 		rtvManager_->GetRtvHandle(rtvHandle_), {RENDER_TARGET_CLEAR_VALUE}, 0u, nullptr);
@@ -92,12 +92,12 @@ void Elysia::RandomEffect::Draw() {
 	ImGui::Checkbox("UseTexture", &randomValue_.isUseTexture);
 	ImGui::End();
 #endif
-	randomValueResource_->Map(0u,nullptr,reinterpret_cast<void**>(&randomValueData_));
+	RandomValue randomValueData = {};
 	std::uniform_real_distribution<float> distribute(0.0f, 1.0f);
 	randomValue_.value = distribute(randomEngine_);
-	randomValueData_->value = randomValue_.value;
-	randomValueData_->isUseTexture = randomValue_.isUseTexture;
-	randomValueResource_->Unmap(0u, nullptr);
+	randomValueData.value = randomValue_.value;
+	randomValueData.isUseTexture = randomValue_.isUseTexture;
+	D3D12_GPU_VIRTUAL_ADDRESS randomValueDataAddress = constantBufferManager_->Push(randomValueData);
 #pragma endregion
 
 	//パイプラインの設定
@@ -108,7 +108,7 @@ void Elysia::RandomEffect::Draw() {
 	//SRV
 	srvManager_->SetGraphicsRootDescriptorTable(0u, srvHandle_);
 	//ランダム
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, randomValueResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, randomValueDataAddress);
 	//描画(DrawCall)３頂点で１つのインスタンス。
 	directXSetup_->GetCommandList()->DrawInstanced(3u, 1u, 0u, 0u);
 	
@@ -45,6 +45,11 @@ namespace Elysia {
 	/// </summary>
 	class SrvManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 
 
 	/// <summary>
@@ -88,6 +93,8 @@ namespace Elysia {
 		Elysia::RtvManager* rtvManager_ = nullptr;
 		//SRV管理クラス
 		Elysia::SrvManager* srvManager_ = nullptr;
+		//定数バッファ管理クラス
+		Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 
 
 	private:
@@ -103,12 +110,8 @@ namespace Elysia {
 
 	private:
 		//ランダム
-		//リソース
-		ComPtr<ID3D12Resource> randomValueResource_ = nullptr;
 		//値
 		RandomValue randomValue_ = {};
-		//データ
-		RandomValue* randomValueData_ = nullptr;
 		//エンジン
 		std::mt19937 randomEngine_ = {};
 
@@ -7,6 +7,7 @@
 #include "TextureManager.h"
 #include "SrvManager.h"
 #include "RtvManager.h"
+#include "ConstantBufferManager.h"
 
 Elysia::Vignette::Vignette(){
 	//ウィンドウクラスの取得
@@ -19,6 +20,8 @@ Elysia::Vignette::Vignette(){
 	rtvManager_ = Elysia::RtvManager::GetInstance();
 	//SRV管理クラスの取得
 	srvManager_ = Elysia::SrvManager::GetInstance();;
+	//定数バッファ管理クラス
+	constantBufferManager_ = Elysia::ConstantBufferManager::GetInstance();
 }
 
 void Elysia::Vignette::Initialize() {
@@ -38,8 +41,6 @@ void Elysia::Vignette::Initialize() {
 	srvManager_->CreateSRVForRenderTexture(rtvResource_.Get(), srvHandle_);
 
 	
-	//リソースの生成
-	valueResource_ = directXSetup_->CreateBufferResource(sizeof(VignetteData));
 	//初期化
 	vignetteValue_.scale = 16.0f;
 	vignetteValue_.pow = 0.8f;
@@ -49,8 +50,7 @@ void Elysia::Vignette::Initialize() {
 void Elysia::Vignette::PreDraw() {
 	//RT
 	const float RENDER_TARGET_CLEAR_VALUE[] = {0.0f, 0.0f,0.0f,1.0f };
-	directXSetup_->GetCommandList()->OMSetRenderTargets(
-		1u, &rtvManager_->GetRtvHandle(rtvHandle_), false, &directXSetup_->GetDsvHandle());
+	directXSetup_->SetRenderTarget(rtvManager_->GetRtvHandle(rtvHandle_));
 	//クリア
 	directXSetup_->GetCommandList()->ClearRenderTargetView(
 		rtvManager_->GetRtvHandle(rtvHandle_), RENDER_TARGET_CLEAR_VALUE, 0u, nullptr);
@@ -76,11 +76,11 @@ void Elysia::Vignette::Draw() {
 		D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
 	//数値の書き込み
-	valueResource_->Map(0u, nullptr, reinterpret_cast<void**>(&vignetteData_));
-	vignetteData_->scale = vignetteValue_.scale;
-	vignetteData_->pow = vignetteValue_.pow;
-	vignetteData_->color = vignetteValue_.color;
-	valueResource_->Unmap(0u, nullptr);
+	VignetteData vignetteData = {};
+	vignetteData.scale = vignetteValue_.scale;
+	vignetteData.pow = vignetteValue_.pow;
+	vignetteData.color = vignetteValue_.color;
+	D3D12_GPU_VIRTUAL_ADDRESS vignetteDataAddress = constantBufferManager_->Push(vignetteData);
 
 	//PSOの設定
 	directXSetup_->GetCommandList()->SetGraphicsRootSignature(pipelinemanager_->GetVignetteRootSignature().Get());
@@ -91,7 +91,7 @@ void Elysia::Vignette::Draw() {
 	//SRV
 	srvManager_->SetGraphicsRootDescriptorTable(0u, srvHandle_);
 	//数値をGPUへ送る
-	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, valueResource_->GetGPUVirtualAddress());
+	directXSetup_->GetCommandList()->SetGraphicsRootConstantBufferView(1u, vignetteDataAddress);
 	//描画(DrawCall)３頂点で１つのインスタンス。
 	directXSetup_->GetCommandList()->DrawInstanced(3u, 1u, 0u, 0u);
 	//ResourceBarrierを張る
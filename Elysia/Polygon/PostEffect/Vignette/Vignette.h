@@ -42,6 +42,11 @@ namespace Elysia {
 	/// </summary>
 	class SrvManager;
 
+	/// <summary>
+	/// 定数バッファ管理クラス
+	/// </summary>
+	class ConstantBufferManager;
+
 
 
 	/// <summary>
@@ -129,6 +134,8 @@ namespace Elysia {
 		Elysia::RtvManager* rtvManager_ = nullptr;
 		//SRV管理クラス
 		Elysia::SrvManager* srvManager_ = nullptr;
+		//定数バッファ管理クラス
+		Elysia::ConstantBufferManager* constantBufferManager_ = nullptr;
 
 	private:
 		//ハンドル
@@ -138,10 +145,6 @@ namespace Elysia {
 		//SRV
 		uint32_t srvHandle_ = 0;
 
-		//リソース
-		ComPtr<ID3D12Resource> valueResource_ = nullptr;
-		//送るデータ
-		VignetteData* vignetteData_ = nullptr;
 		//値
 		VignetteData vignetteValue_ = {};
 
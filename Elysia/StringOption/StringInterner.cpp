@@ -0,0 +1,16 @@
+#include "StringInterner.h"
+
+std::string_view Elysia::StringInterner::Intern(const std::string_view& text) {
+	//既にあればそれを返す
+	auto it = strings_.find(text);
+	if (it != strings_.end()) {
+		return *it;
+	}
+
+	//無ければ追加
+	return *strings_.emplace(text).first;
+}
+
+void Elysia::StringInterner::Clear() {
+	strings_.clear();
+}
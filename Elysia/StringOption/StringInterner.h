@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file StringInterner.h
+ * @brief 文字列のインターン(同じ文字列を1つにまとめる)クラス
+ * @author 茂木翼
+ */
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <cstdint>
+
+/// <summary>
+/// EllysiaEngine
+/// </summary>
+namespace Elysia {
+
+	/// <summary>
+	/// 文字列のインターン
+	/// 同じ内容の文字列は1度だけ保持し、以降は同じstring_viewを返す
+	/// </summary>
+	class StringInterner final {
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		StringInterner() = default;
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~StringInterner() = default;
+
+		/// <summary>
+		/// コピーコンストラクタ禁止
+		/// 返したstring_viewが無効になるため
+		/// </summary>
+		/// <param name="stringInterner"></param>
+		StringInterner(const StringInterner& stringInterner) = delete;
+
+		/// <summary>
+		/// 代入演算子を無効にする
+		/// </summary>
+		/// <param name="stringInterner"></param>
+		/// <returns></returns>
+		StringInterner& operator=(const StringInterner& stringInterner) = delete;
+
+	public:
+		/// <summary>
+		/// 文字列の登録
+		/// 既に登録済みの場合はそれを返す
+		/// </summary>
+		/// <param name="text">文字列</param>
+		/// <returns>登録した文字列</returns>
+		std::string_view Intern(const std::string_view& text);
+
+		/// <summary>
+		/// 全て消す
+		/// これまで返したstring_viewは全て無効になるので注意
+		/// </summary>
+		void Clear();
+
+	public:
+		/// <summary>
+		/// 登録数の取得
+		/// </summary>
+		/// <returns>登録数</returns>
+		inline size_t GetCount()const {
+			return strings_.size();
+		}
+
+	private:
+		/// <summary>
+		/// string_viewのまま検索できるようにするハッシュ
+		/// </summary>
+		struct TransparentHash {
+			using is_transparent = void;
+			inline size_t operator()(const std::string_view& text)const {
+				return std::hash<std::string_view>{}(text);
+			}
+		};
+
+	private:
+		//文字列
+		//ノードベースなので再ハッシュしてもアドレスは変わらない
+		std::unordered_set<std::string, TransparentHash, std::equal_to<>> strings_;
+	};
+
+};
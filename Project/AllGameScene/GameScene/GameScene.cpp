@@ -13,6 +13,10 @@
 #include "ModelManager.h"
 #include "LevelDataManager.h"
 #include "GlobalVariables.h"
+#include "Audio.h"
+#include "UserInterface/UserInterfaceAtlas.h"
+#include "GameClock.h"
+#include "Profiler.h"
 
 
 GameScene::GameScene() {
@@ -81,15 +85,21 @@ void GameScene::Initialize() {
 	gate_->Initialize(gateModelhandle);
 
 	//「脱出せよ」の画像読み込み
-	uint32_t escapeTextureHandle = texturemanager_->Load("Resources/Sprite/Escape/EscapeText.png");
+	Elysia::TextureRegion escapeTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Escape/EscapeText.png");
 	//生成
-	escapeText_.reset(Elysia::Sprite::Create(escapeTextureHandle, { .x = 0.0f,.y = 0.0f }));
+	escapeText_.reset(Elysia::Sprite::Create(escapeTextureRegion, { .x = 0.0f,.y = 0.0f }));
 	//最初は非表示にする
 	escapeText_->SetInvisible(true);
 #pragma endregion
 
 	//ハンドルの取得
 	levelHandle_ = levelDataManager_->Load("GameStage/GameStage.json");
+	//オブジェクトのハンドルの取得
+	treasureBoxMainHandle_ = levelDataManager_->GetObjectHandle(levelHandle_, "TreasureBoxMain");
+	treasureBoxLidHandle_ = levelDataManager_->GetObjectHandle(levelHandle_, "TreasureBoxLid");
+	closeFenceInCemeteryHandle_ = levelDataManager_->GetObjectHandle(levelHandle_, "CloseFenceInCemetery");
+	gateDoorRightHandle_ = levelDataManager_->GetObjectHandle(levelHandle_, "GateDoorRight");
+	gateDoorLeftHandle_ = levelDataManager_->GetObjectHandle(levelHandle_, "GateDoorLeft");
 
 	//門の初期回転
 	rightGateRotateTheta_ = 0.0f;
@@ -166,22 +176,22 @@ void GameScene::Initialize() {
 #pragma region 説明
 
 	//説明画像の読み込み
-	uint32_t explanationTextureHandle[EXPLANATION_QUANTITY_] = {};
-	explanationTextureHandle[0] = texturemanager_->Load("Resources/Sprite/Explanation/Explanation1.png");
-	explanationTextureHandle[1] = texturemanager_->Load("Resources/Sprite/Explanation/Explanation2.png");
+	Elysia::TextureRegion explanationTextureRegion[EXPLANATION_QUANTITY_] = {};
+	explanationTextureRegion[0] = UserInterfaceAtlas::GetRegion("Resources/Sprite/Explanation/Explanation1.png");
+	explanationTextureRegion[1] = UserInterfaceAtlas::GetRegion("Resources/Sprite/Explanation/Explanation2.png");
 
 	//生成
 	for (uint32_t i = 0u; i < explanation_.size(); ++i) {
-		explanation_[i].reset(Elysia::Sprite::Create(explanationTextureHandle[i], INITIAL_SPRITE_POSITION));
+		explanation_[i].reset(Elysia::Sprite::Create(explanationTextureRegion[i], INITIAL_SPRITE_POSITION));
 	}
 
 	//スペースで次への画像読み込み
-	uint32_t spaceToNextTextureHandle[EXPLANATION_QUANTITY_] = {};
-	spaceToNextTextureHandle[0] = texturemanager_->Load("Resources/Sprite/Explanation/ExplanationNext1.png");
-	spaceToNextTextureHandle[1] = texturemanager_->Load("Resources/Sprite/Explanation/ExplanationNext2.png");
+	Elysia::TextureRegion spaceToNextTextureRegion[EXPLANATION_QUANTITY_] = {};
+	spaceToNextTextureRegion[0] = UserInterfaceAtlas::GetRegion("Resources/Sprite/Explanation/ExplanationNext1.png");
+	spaceToNextTextureRegion[1] = UserInterfaceAtlas::GetRegion("Resources/Sprite/Explanation/ExplanationNext2.png");
 	//生成
 	for (uint32_t i = 0; i < spaceToNext_.size(); ++i) {
-		spaceToNext_[i].reset(Elysia::Sprite::Create(spaceToNextTextureHandle[i], INITIAL_SPRITE_POSITION));
+		spaceToNext_[i].reset(Elysia::Sprite::Create(spaceToNextTextureRegion[i], INITIAL_SPRITE_POSITION));
 	}
 
 	//最初は0番目
@@ -197,20 +207,20 @@ void GameScene::Initialize() {
 #pragma endregion
 
 #pragma region UI
-	uint32_t playerHPTextureHandle = texturemanager_->Load("Resources/Sprite/Player/PlayerHP.png");
-	uint32_t playerHPBackFrameTextureHandle = texturemanager_->Load("Resources/Sprite/Player/PlayerHPBack.png");
+	Elysia::TextureRegion playerHPTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Player/PlayerHP.png");
+	Elysia::TextureRegion playerHPBackFrameTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Player/PlayerHPBack.png");
 	const Vector2 INITIAL_POSITION = { .x = 20.0f,.y = 80.0f };
 	for (uint32_t i = 0u; i < PLAYER_HP_MAX_QUANTITY_; ++i) {
-		playerHP_[i].reset(Elysia::Sprite::Create(playerHPTextureHandle, { .x = static_cast<float>(i) * 64 + INITIAL_POSITION.x,.y = INITIAL_POSITION.y }));
+		playerHP_[i].reset(Elysia::Sprite::Create(playerHPTextureRegion, { .x = static_cast<float>(i) * 64 + INITIAL_POSITION.x,.y = INITIAL_POSITION.y }));
 	}
 
-	playerHPBackFrame_.reset(Elysia::Sprite::Create(playerHPBackFrameTextureHandle, { .x = INITIAL_POSITION.x,.y = INITIAL_POSITION.y }));
+	playerHPBackFrame_.reset(Elysia::Sprite::Create(playerHPBackFrameTextureRegion, { .x = INITIAL_POSITION.x,.y = INITIAL_POSITION.y }));
 	currentDisplayHP_ = PLAYER_HP_MAX_QUANTITY_;
 
 
 	//ゴールに向かえのテキスト
-	uint32_t toEscapeTextureHandle = texturemanager_->Load("Resources/Sprite/Escape/ToGoal.png");
-	toEscape_.reset(Elysia::Sprite::Create(toEscapeTextureHandle, INITIAL_SPRITE_POSITION));
+	Elysia::TextureRegion toEscapeTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Escape/ToGoal.png");
+	toEscape_.reset(Elysia::Sprite::Create(toEscapeTextureRegion, INITIAL_SPRITE_POSITION));
 
 	//宝箱
 	uint32_t openTreasureBoxSpriteHandle = texturemanager_->Load("Resources/Sprite/TreasureBox/OpenTreasureBox.png");
@@ -254,7 +264,7 @@ void GameScene::ObjectCollision() {
 	//宝箱
 	if (isOpenTreasureBox_==false) {
 		const float RADIUS = 5.0f;
-		Vector3 treasurePosition = levelDataManager_->GetInitialTranslate(levelHandle_, "TreasureBoxMain");
+		Vector3 treasurePosition = levelDataManager_->GetInitialTranslate(treasureBoxMainHandle_);
 
 		if (player_->GetWorldPosition().x >= treasurePosition.x - RADIUS &&
 			player_->GetWorldPosition().x <= treasurePosition.x + RADIUS &&
@@ -285,18 +295,18 @@ void GameScene::ObjectCollision() {
 	//開いた動作
 	else {
 		//初期回転
-		Vector3 initialRotate = levelDataManager_->GetInitialRotate(levelHandle_, "TreasureBoxLid");
+		Vector3 initialRotate = levelDataManager_->GetInitialRotate(treasureBoxLidHandle_);
 		//回転
 		Vector3 rotate = { .x = -std::numbers::pi_v<float> / 3.0f,.y = 0.0f,.z = 0.0f };
 		//再設定
-		levelDataManager_->SetRotate(levelHandle_, "TreasureBoxLid", VectorCalculation::Add(initialRotate, rotate));
+		levelDataManager_->SetRotate(treasureBoxLidHandle_, VectorCalculation::Add(initialRotate, rotate));
 
 	}
 
 	//宝箱を開けたかどうかの設定
 	keyManager_->SetIsOpenTreasureBox(isOpenTreasureBox_);
 	//初期座標を取得
-	Vector3 initialPosition = levelDataManager_->GetInitialTranslate(levelHandle_, "CloseFenceInCemetery");
+	Vector3 initialPosition = levelDataManager_->GetInitialTranslate(closeFenceInCemeteryHandle_);
 
 	//墓場の鍵を取ったら柵が消える
 	if (keyManager_ ->GetIsPickUpKeyInCemetery() == true) {
@@ -315,7 +325,7 @@ void GameScene::ObjectCollision() {
 		}
 	}
 	//座標の再設定
-	levelDataManager_->SetTranslate(levelHandle_, "CloseFenceInCemetery", translate_);
+	levelDataManager_->SetTranslate(closeFenceInCemeteryHandle_, translate_);
 
 #ifdef _DEBUG
 	ImGui::Begin("墓場");
@@ -421,14 +431,14 @@ void GameScene::VigntteProcess(){
 	//プレイヤーがダメージを受けた場合ビネット
 	if (player_->GetIsDamaged() == true) {
 		//時間の加算
-		vignetteChangeTime_ += DELTA_TIME_;
+		vignetteChangeTime_ += Elysia::GameClock::GetInstance()->GetFixedDeltaTime();
 
 		//線形補間で滑らかに変化
 		vignettePow_ = SingleCalculation::Lerp(MAX_VIGNETTE_POW_, 0.0f, vignetteChangeTime_);
 	}
 	//ピンチ演出
 	else if (player_->GetHP() == DANGEROUS_HP) {
-		warningTime_ += DELTA_TIME_;
+		warningTime_ += Elysia::GameClock::GetInstance()->GetFixedDeltaTime();
 		vignettePow_ = SingleCalculation::Lerp(MAX_VIGNETTE_POW_, 0.0f, warningTime_);
 
 		//最大時間
@@ -778,6 +788,7 @@ void GameScene::MoveLightSide() {
 }
 
 void GameScene::Update(Elysia::GameManager* gameManager) {
+	ELYSIA_PROFILE_SCOPE("GameScene::Update");
 
 	//フレーム初めに
 	//コリジョンリストのクリア
@@ -900,11 +911,9 @@ void GameScene::Update(Elysia::GameManager* gameManager) {
 		rightGateRotateTheta_ += ROTATE_VALUE;
 		leftGateRotateTheta_ += ROTATE_VALUE;
 
-		std::string right = "GateDoorRight";
-		std::string left = "GateDoorLeft";
 		//門の回転
-		levelDataManager_->SetRotate(levelHandle_, right, { .x = 0.0f,.y = rightGateRotateTheta_,.z = 0.0f });
-		levelDataManager_->SetRotate(levelHandle_, left, { .x = 0.0f,.y = leftGateRotateTheta_,.z = 0.0f });
+		levelDataManager_->SetRotate(gateDoorRightHandle_, { .x = 0.0f,.y = rightGateRotateTheta_,.z = 0.0f });
+		levelDataManager_->SetRotate(gateDoorLeftHandle_, { .x = 0.0f,.y = leftGateRotateTheta_,.z = 0.0f });
 
 		//音を止める
 		enemyManager_->StopAudio();
@@ -937,6 +946,8 @@ void GameScene::Update(Elysia::GameManager* gameManager) {
 
 	//カメラの更新
 	camera_.Update();
+	//3Dの音の更新(カメラが聞き手)
+	Elysia::Audio::GetInstance()->Update3D(camera_);
 	//プレイヤーの更新
 	player_->Update();
 	//門
@@ -21,6 +21,7 @@
 #include "CollisionCalculation.h"
 
 #include "Vignette.h"
+#include "LevelObjectHandle.h"
 
 
 
@@ -163,6 +164,13 @@ private:
 	Elysia::LevelDataManager* levelDataManager_ = nullptr;
 	//ハンドル
 	uint32_t levelHandle_ = 0u;
+	//毎フレーム触るオブジェクトのハンドル
+	//名前の検索は初期化時だけにする
+	Elysia::LevelObjectHandle treasureBoxMainHandle_ = {};
+	Elysia::LevelObjectHandle treasureBoxLidHandle_ = {};
+	Elysia::LevelObjectHandle closeFenceInCemeteryHandle_ = {};
+	Elysia::LevelObjectHandle gateDoorRightHandle_ = {};
+	Elysia::LevelObjectHandle gateDoorLeftHandle_ = {};
 	//グローバル変数クラス
 	Elysia::GlobalVariables* globalVariables_ = nullptr;
 
@@ -177,8 +185,6 @@ private:
 
 	//説明テクスチャの最大数
 	const uint32_t MAX_EXPLANATION_NUMBER_ = 2u;
-	//時間変化
-	const float_t DELTA_TIME_ = 1.0f / 60.0f;
 	//フェードアウトの具合
 	const float_t FADE_OUT_INTERVAL_ = 0.01f;
 	//負けシーンに遷移するときの値
@@ -10,6 +10,7 @@
 #include "TextureManager.h"
 #include "VectorCalculation.h"
 #include "SingleCalculation.h"
+#include "Profiler.h"
 
 
 LevelEditorSample::LevelEditorSample(){
@@ -63,6 +64,7 @@ void LevelEditorSample::Initialize(){
 }
 
 void LevelEditorSample::Update(GameManager* gameManager){
+	ELYSIA_PROFILE_SCOPE("LevelEditorSample::Update");
 	//リストのクリア
 	collisionManager_->ClearList();
 
@@ -10,6 +10,7 @@
 #include "VectorCalculation.h"
 #include "GlobalVariables.h"
 #include "Easing.h"
+#include "Profiler.h"
 
 
 LoseScene::LoseScene(){
@@ -42,6 +43,10 @@ void LoseScene::Initialize(){
 	
 	//負けシーン用のレベルデータを入れる
 	levelDataHandle_ = levelDataManager_->Load("LoseStage/LoseStage.json");
+	//オブジェクトのハンドルの取得
+	selectArrowHandle_ = levelDataManager_->GetObjectHandle(levelDataHandle_, SELECT_ARROW);
+	toGameHandle_ = levelDataManager_->GetObjectHandle(levelDataHandle_, TO_GAME);
+	toTitleHandle_ = levelDataManager_->GetObjectHandle(levelDataHandle_, TO_TITLE);
 	
 
 	//背景(ポストエフェクト)
@@ -60,11 +65,12 @@ void LoseScene::Initialize(){
 	//調整項目として記録
 	globalVariables_->CreateGroup(DISSOLVE_NAME_);
 	globalVariables_->AddItem(DISSOLVE_NAME_, "Thinkness", dissolve_.edgeThinkness);
+	dissolveThinknessHandle_ = globalVariables_->Bind<float>(DISSOLVE_NAME_, "Thinkness");
 
 	//初期化
 	dissolve_.Initialize();
 	dissolve_.maskTextureHandle = maskTexture;
-	dissolve_.edgeThinkness = globalVariables_->GetFloatValue(DISSOLVE_NAME_, "Thinkness");
+	dissolve_.edgeThinkness = dissolveThinknessHandle_.Get();
 	dissolve_.threshold = 0.0f;
 	//カメラの初期化
 	camera_.Initialize();
@@ -75,11 +81,13 @@ void LoseScene::Initialize(){
 	globalVariables_->CreateGroup(POINT_LIGHT_NAME_);
 	globalVariables_->AddItem(POINT_LIGHT_NAME_, "Translate", pointLight_.position_);
 	globalVariables_->AddItem(POINT_LIGHT_NAME_, "Decay", pointLight_.decay_);
+	pointLightTranslateHandle_ = globalVariables_->Bind<Vector3>(POINT_LIGHT_NAME_, "Translate");
+	pointLightDecayHandle_ = globalVariables_->Bind<float>(POINT_LIGHT_NAME_, "Decay");
 
 	//初期化
 	pointLight_.Initialize();
-	pointLight_.position_ = globalVariables_->GetVector3Value(POINT_LIGHT_NAME_, "Translate");
-	pointLight_.decay_ = globalVariables_->GetFloatValue(POINT_LIGHT_NAME_,"Decay");
+	pointLight_.position_ = pointLightTranslateHandle_.Get();
+	pointLight_.decay_ = pointLightDecayHandle_.Get();
 	pointLight_.radius_ = 0.0f;
 
 	//タイトルに戻る
@@ -87,6 +95,7 @@ void LoseScene::Initialize(){
 }
 
 void LoseScene::Update(Elysia::GameManager* gameManager){
+	ELYSIA_PROFILE_SCOPE("LoseScene::Update");
 
 	//始め
 	//ライトアップをする
@@ -100,8 +109,8 @@ void LoseScene::Update(Elysia::GameManager* gameManager){
 			//不透明にしていく
 			transparencyT_ += INTERVAL;
 			textTransparency_ = Easing::EaseInQuart(transparencyT_);
-			levelDataManager_->SetTransparency(levelDataHandle_, TO_GAME, textTransparency_);
-			levelDataManager_->SetTransparency(levelDataHandle_, TO_TITLE, textTransparency_);
+			levelDataManager_->SetTransparency(toGameHandle_, textTransparency_);
+			levelDataManager_->SetTransparency(toTitleHandle_, textTransparency_);
 
 			//少しだけ待ってから選択できるようにする
 			const float ADD_T_VALUE = 1.0f;
@@ -118,10 +127,10 @@ void LoseScene::Update(Elysia::GameManager* gameManager){
 			//点光源の半径を設定
 			pointLight_.radius_ = Easing::EaseOutSine(startLightUpT_) * MAX_LIGHT_RADIUS_;
 			//テキストは非表示にする
-			levelDataManager_->SetTransparency(levelDataHandle_, TO_GAME, 0.0f);
-			levelDataManager_->SetTransparency(levelDataHandle_, TO_TITLE, 0.0f);
+			levelDataManager_->SetTransparency(toGameHandle_, 0.0f);
+			levelDataManager_->SetTransparency(toTitleHandle_, 0.0f);
 			//矢印も非表示にしておく
-			levelDataManager_->SetInvisible(levelDataHandle_, SELECT_ARROW, true);
+			levelDataManager_->SetInvisible(selectArrowHandle_, true);
 
 		}
 	}
@@ -160,11 +169,11 @@ void LoseScene::Update(Elysia::GameManager* gameManager){
 	camera_.translate = VectorCalculation::Add(camera_.translate, cameraVelocity_);
 	camera_.Update();
 	//点光源の更新
-	pointLight_.position_ = globalVariables_->GetVector3Value(POINT_LIGHT_NAME_, "Translate");
-	pointLight_.decay_ = globalVariables_->GetFloatValue(POINT_LIGHT_NAME_, "Decay");
+	pointLight_.position_ = pointLightTranslateHandle_.Get();
+	pointLight_.decay_ = pointLightDecayHandle_.Get();
 	pointLight_.Update();
 	//ディゾルブの更新
-	dissolve_.edgeThinkness = globalVariables_->GetFloatValue(DISSOLVE_NAME_, "Thinkness");
+	dissolve_.edgeThinkness = dissolveThinknessHandle_.Get();
 	dissolve_.Update();
 
 	//調整
@@ -206,21 +215,21 @@ void LoseScene::DrawSprite(){
 void LoseScene::Select() {
 
 	//矢印を表示させる
-	levelDataManager_->SetInvisible(levelDataHandle_, SELECT_ARROW, false);
+	levelDataManager_->SetInvisible(selectArrowHandle_, false);
 
 	//矢印の回転
 	arrowRotate_ += ROTATE_VALUE_;
-	levelDataManager_->SetRotate(levelDataHandle_, SELECT_ARROW, { .x = 0.0f,.y = arrowRotate_ ,.z = 0.0f });
+	levelDataManager_->SetRotate(selectArrowHandle_, { .x = 0.0f,.y = arrowRotate_ ,.z = 0.0f });
 
 	//矢印の初期座標を取得
-	Vector3 arrowInitialPosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, SELECT_ARROW);
+	Vector3 arrowInitialPosition = levelDataManager_->GetInitialTranslate(selectArrowHandle_);
 	//「ゲームへ」の座標を取得
-	Vector3 toGameInitialPosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, TO_GAME);
+	Vector3 toGameInitialPosition = levelDataManager_->GetInitialTranslate(toGameHandle_);
 	//「タイトルへ」の座標を取得
-	Vector3 toTitleInitialPosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, TO_TITLE);
+	Vector3 toTitleInitialPosition = levelDataManager_->GetInitialTranslate(toTitleHandle_);
 	
 	//非選択時
-	Vector3 noSelectedScale = levelDataManager_->GetInitiaScale(levelDataHandle_, TO_TITLE);
+	Vector3 noSelectedScale = levelDataManager_->GetInitiaScale(toTitleHandle_);
 	//選択時の高さ
 	float selectedHeight = 1.6f;
 
@@ -228,16 +237,16 @@ void LoseScene::Select() {
 	if (isSelectingGame_ == true && isSelectingTitle_ == false) {
 
 		//選択されている方である「ゲーム」は大きくする
-		levelDataManager_->SetScale(levelDataHandle_, TO_GAME, { .x = selectedScale_,.y = selectedScale_ ,.z = selectedScale_ });
-		levelDataManager_->SetTranslate(levelDataHandle_, TO_GAME, { .x = toGameInitialPosition.x,.y = selectedHeight ,.z = toGameInitialPosition.x });
+		levelDataManager_->SetScale(toGameHandle_, { .x = selectedScale_,.y = selectedScale_ ,.z = selectedScale_ });
+		levelDataManager_->SetTranslate(toGameHandle_, { .x = toGameInitialPosition.x,.y = selectedHeight ,.z = toGameInitialPosition.x });
 
 		//選択されていない方である「タイトル」は初期位置で
-		levelDataManager_->SetScale(levelDataHandle_, TO_TITLE, noSelectedScale);
-		levelDataManager_->SetTranslate(levelDataHandle_, TO_TITLE, toTitleInitialPosition);
+		levelDataManager_->SetScale(toTitleHandle_, noSelectedScale);
+		levelDataManager_->SetTranslate(toTitleHandle_, toTitleInitialPosition);
 
 		//右・D押したとき「タイトルへ」に移動
 		if ((input_->IsTriggerKey(DIK_RIGHT) == true) || (input_->IsTriggerKey(DIK_D) == true)) {
-			levelDataManager_->SetTranslate(levelDataHandle_, SELECT_ARROW, { .x = toTitleInitialPosition.x,.y = arrowInitialPosition.y ,.z = toTitleInitialPosition.z });
+			levelDataManager_->SetTranslate(selectArrowHandle_, { .x = toTitleInitialPosition.x,.y = arrowInitialPosition.y ,.z = toTitleInitialPosition.z });
 			isSelectingGame_ = false;
 			isSelectingTitle_ = true;
 		}
@@ -247,15 +256,15 @@ void LoseScene::Select() {
 	else if (isSelectingGame_ == false && isSelectingTitle_ == true) {
 
 		//選択されている方である「タイトル」は大きくする
-		levelDataManager_->SetScale(levelDataHandle_, TO_TITLE, { .x = selectedScale_,.y = selectedScale_ ,.z = selectedScale_ });
-		levelDataManager_->SetTranslate(levelDataHandle_, TO_TITLE, { .x = toTitleInitialPosition.x,.y = selectedHeight ,.z = toTitleInitialPosition.z });
+		levelDataManager_->SetScale(toTitleHandle_, { .x = selectedScale_,.y = selectedScale_ ,.z = selectedScale_ });
+		levelDataManager_->SetTranslate(toTitleHandle_, { .x = toTitleInitialPosition.x,.y = selectedHeight ,.z = toTitleInitialPosition.z });
 
 		//選択されていない方である「ゲーム」は初期位置で
-		levelDataManager_->SetScale(levelDataHandle_, TO_GAME, noSelectedScale);
-		levelDataManager_->SetTranslate(levelDataHandle_, TO_GAME, toGameInitialPosition);
+		levelDataManager_->SetScale(toGameHandle_, noSelectedScale);
+		levelDataManager_->SetTranslate(toGameHandle_, toGameInitialPosition);
 		//左・A押したとき「タイトルへ」に移動
 		if ((input_->IsTriggerKey(DIK_LEFT) == true) || (input_->IsTriggerKey(DIK_A) == true)) {
-			levelDataManager_->SetTranslate(levelDataHandle_, SELECT_ARROW, { .x = toGameInitialPosition.x,.y = arrowInitialPosition.y ,.z = toGameInitialPosition.z });
+			levelDataManager_->SetTranslate(selectArrowHandle_, { .x = toGameInitialPosition.x,.y = arrowInitialPosition.y ,.z = toGameInitialPosition.z });
 			isSelectingGame_ = true;
 			isSelectingTitle_ = false;
 		}
@@ -280,9 +289,9 @@ void LoseScene::ChangeNextScene(){
 	if (isSelectingGame_ == false && isSelectingTitle_ == true) {
 
 		//矢印の初期座標を取得
-		Vector3 arrowInitialPosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, SELECT_ARROW);
+		Vector3 arrowInitialPosition = levelDataManager_->GetInitialTranslate(selectArrowHandle_);
 		//「タイトルへ」の座標を取得
-		Vector3 toTitleInitialPosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, TO_TITLE);
+		Vector3 toTitleInitialPosition = levelDataManager_->GetInitialTranslate(toTitleHandle_);
 
 		//決定されたら跳ねるような動きをする
 		const float INTERVAL = 0.1f;
@@ -293,11 +302,11 @@ void LoseScene::ChangeNextScene(){
 			const float FAST_ROTATE_VALUE = 0.5f;
 			arrowRotate_ += FAST_ROTATE_VALUE;
 			//新しい回転を設定
-			levelDataManager_->SetRotate(levelDataHandle_, SELECT_ARROW, { .x = 0.0f,.y = arrowRotate_ ,.z = 0.0f });
+			levelDataManager_->SetRotate(selectArrowHandle_, { .x = 0.0f,.y = arrowRotate_ ,.z = 0.0f });
 		}
 		else {
 			//回転を止める
-			levelDataManager_->SetRotate(levelDataHandle_, SELECT_ARROW, { .x = 0.0f,.y = std::numbers::pi_v <float> / 2.0f ,.z = 0.0f });
+			levelDataManager_->SetRotate(selectArrowHandle_, { .x = 0.0f,.y = std::numbers::pi_v <float> / 2.0f ,.z = 0.0f });
 		}
 
 
@@ -305,7 +314,7 @@ void LoseScene::ChangeNextScene(){
 		const float HEIGHT = 1.0f;
 		float newArrowPositionY = arrowInitialPosition.y + std::sinf(newTheta) * HEIGHT;
 		//新しい座標を設定
-		levelDataManager_->SetTranslate(levelDataHandle_, SELECT_ARROW, { .x = toTitleInitialPosition.x,.y = newArrowPositionY ,.z = arrowInitialPosition.z });
+		levelDataManager_->SetTranslate(selectArrowHandle_, { .x = toTitleInitialPosition.x,.y = newArrowPositionY ,.z = arrowInitialPosition.z });
 
 		//カメラの動きを待つ時間
 		waitForCameraMoveTime_ += INCREASE_VALUE_;
@@ -327,7 +336,7 @@ void LoseScene::ChangeNextScene(){
 	else if (isSelectingGame_ == true && isSelectingTitle_ == false) {
 
 		//矢印の初期座標を取得
-		Vector3 arrowInitialPosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, SELECT_ARROW);
+		Vector3 arrowInitialPosition = levelDataManager_->GetInitialTranslate(selectArrowHandle_);
 
 		//決定されたら跳ねるような動きをする
 		const float INTERVAL = 0.1f;
@@ -338,11 +347,11 @@ void LoseScene::ChangeNextScene(){
 			const float FAST_ROTATE_VALUE = 0.5f;
 			arrowRotate_ += FAST_ROTATE_VALUE;
 			//新しい回転を設定
-			levelDataManager_->SetRotate(levelDataHandle_, SELECT_ARROW, { .x = 0.0f,.y = arrowRotate_ ,.z = 0.0f });
+			levelDataManager_->SetRotate(selectArrowHandle_, { .x = 0.0f,.y = arrowRotate_ ,.z = 0.0f });
 		}
 		else {
 			//回転を止める
-			levelDataManager_->SetRotate(levelDataHandle_, SELECT_ARROW, { .x = 0.0f,.y = std::numbers::pi_v <float>/2.0f ,.z = 0.0f });
+			levelDataManager_->SetRotate(selectArrowHandle_, { .x = 0.0f,.y = std::numbers::pi_v <float>/2.0f ,.z = 0.0f });
 		}
 		
 		
@@ -350,7 +359,7 @@ void LoseScene::ChangeNextScene(){
 		const float HEIGHT = 1.0f;
 		float newArrowPositionY = arrowInitialPosition.y + std::sinf(newTheta) * HEIGHT;
 		//新しい座標を設定
-		levelDataManager_->SetTranslate(levelDataHandle_, SELECT_ARROW, { .x = arrowInitialPosition.x,.y = newArrowPositionY ,.z = arrowInitialPosition.z });
+		levelDataManager_->SetTranslate(selectArrowHandle_, { .x = arrowInitialPosition.x,.y = newArrowPositionY ,.z = arrowInitialPosition.z });
 
 		//カメラの動きを待つ時間
 		waitForCameraMoveTime_ += INCREASE_VALUE_;
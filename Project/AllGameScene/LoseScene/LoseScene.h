@@ -14,6 +14,8 @@
 #include "BackTexture.h"
 #include "DissolveEffect.h"
 #include "Dissolve.h"
+#include "GlobalVariableHandle.h"
+#include "LevelObjectHandle.h"
 
 
 
@@ -136,6 +138,11 @@ private:
 	Elysia::LevelDataManager* levelDataManager_ = nullptr;
 	//ハンドル
 	uint32_t levelDataHandle_ = 0u;
+	//毎フレーム触るオブジェクトのハンドル
+	//名前の検索は初期化時だけにする
+	Elysia::LevelObjectHandle selectArrowHandle_ = {};
+	Elysia::LevelObjectHandle toGameHandle_ = {};
+	Elysia::LevelObjectHandle toTitleHandle_ = {};
 
 	//モデル管理クラス
 	Elysia::ModelManager* modelManager_ = nullptr;
@@ -148,9 +155,10 @@ private:
 	const std::string POINT_LIGHT_NAME_ = "LoseScenePointLight";
 	//ディゾルブ
 	const std::string DISSOLVE_NAME_ = "LoseSceneDissolve";
-
-	//時間変化
-	const float DELTA_TIME = 1.0f / 60.0f;
+	//毎フレーム読む調整項目
+	Elysia::GlobalVariableHandle<Vector3> pointLightTranslateHandle_ = {};
+	Elysia::GlobalVariableHandle<float> pointLightDecayHandle_ = {};
+	Elysia::GlobalVariableHandle<float> dissolveThinknessHandle_ = {};
 
 	//間隔
 	const float TRANSPARENCY_INTERVAL_ = 0.01f;
@@ -9,6 +9,7 @@
 #include "VectorCalculation.h"
 #include "CollisionCalculation.h"
 #include "PushBackCalculation.h"
+#include "Profiler.h"
 
 TestScene::TestScene(){
 	//インスタンスの取得	
@@ -75,6 +76,7 @@ void TestScene::Initialize(){
 }
 
 void TestScene::Update(Elysia::GameManager* gameManager){
+	ELYSIA_PROFILE_SCOPE("TestScene::Update");
 
 
 	//再読み込み
@@ -15,6 +15,8 @@
 
 #include "SunsetBackTexture.h"
 #include "NightBackTexture.h"
+#include "GameClock.h"
+#include "Profiler.h"
 
 
 TitleScene::TitleScene(){
@@ -90,6 +92,7 @@ void TitleScene::Initialize(){
 }
 
 void TitleScene::Update(Elysia::GameManager* gameManager){
+	ELYSIA_PROFILE_SCOPE("TitleScene::Update");
 
 #pragma region 未スタート
 
@@ -176,8 +179,7 @@ void TitleScene::Update(Elysia::GameManager* gameManager){
 		text_->SetInvisible(true);
 
 		//時間の加算
-		const float DELTA_TIME = 1.0f/60.0f;
-		randomEffectTime_ += DELTA_TIME;
+		randomEffectTime_ += Elysia::GameClock::GetInstance()->GetFixedDeltaTime();
 
 		//開始時間
 		std::array<float, DISPLAY_LENGTH_QUANTITY_> RANDOM_EFFECT_DISPLAY_START_TIME = { 0.0f,2.5f };
@@ -6,6 +6,7 @@
 #include "GameManager.h"
 #include "Input.h"
 #include "VectorCalculation.h"
+#include "Profiler.h"
 
 WinScene::WinScene(){
 	//インスタンスの取得
@@ -37,6 +38,8 @@ void WinScene::Initialize() {
 
 	//レベルデータの読み込み
 	levelDataHandle_ = levelDataManager_->Load("WinStage/WinStage.json");
+	//オブジェクトのハンドルの取得
+	escapeSucceededObjectHandle_ = levelDataManager_->GetObjectHandle(levelDataHandle_, "EscapeSucceededObject");
 
 	//マテリアルの初期化
 	material_.Initialize();
@@ -64,6 +67,7 @@ void WinScene::Initialize() {
 }
 
 void WinScene::Update(Elysia::GameManager* gameManager){
+	ELYSIA_PROFILE_SCOPE("WinScene::Update");
 
 	//増える時間の値
 	const uint32_t INCREASE_VALUE = 1u;
@@ -179,10 +183,9 @@ void WinScene::Update(Elysia::GameManager* gameManager){
 	const float FLLOATING_THETA_INTERVAL = 0.05f;
 	objectFloatingTheta_ += FLLOATING_THETA_INTERVAL;
 	//テキスト
-	const std::string ESCAPE_SUCCEEDED_TEXT = "EscapeSucceededObject";
 	//基準となる座標
 	const float BASED_POSITION_Y = 6.0f;
-	levelDataManager_->SetTranslate(levelDataHandle_, ESCAPE_SUCCEEDED_TEXT, {.x=0.0f,.y=std::sinf(objectFloatingTheta_) +BASED_POSITION_Y,.z=30.0f });
+	levelDataManager_->SetTranslate(escapeSucceededObjectHandle_, {.x=0.0f,.y=std::sinf(objectFloatingTheta_) +BASED_POSITION_Y,.z=30.0f });
 
 
 	//レベルデータの更新
@@ -13,6 +13,7 @@
 #include "Material.h"
 #include "DirectionalLight.h"
 #include "BackTexture.h"
+#include "LevelObjectHandle.h"
 
 
 
@@ -97,6 +98,9 @@ private:
 	Elysia::LevelDataManager* levelDataManager_ = nullptr;
 	//ハンドル
 	uint32_t levelDataHandle_ = 0u;
+	//毎フレーム動かすオブジェクトのハンドル
+	//名前の検索は初期化時だけにする
+	Elysia::LevelObjectHandle escapeSucceededObjectHandle_ = {};
 
 private:
 	//カメラ
@@ -3,6 +3,7 @@
 #include <imgui.h>
 #include <random>
 #include <cassert>
+#include <numbers>
 
 #include "Player/Player.h"
 #include "VectorCalculation.h"
@@ -21,6 +22,7 @@
 #include "NormalEnemy/State/NormalEnemyPreTracking.h"
 #include "NormalEnemy/State/NormalEnemyAttack.h"
 #include <CollisionCalculation.h>
+#include "Profiler.h"
 
 EnemyManager::EnemyManager(){
 	//インスタンスの取得
@@ -30,6 +32,13 @@ EnemyManager::EnemyManager(){
 	audio_ = Elysia::Audio::GetInstance();
 }
 
+EnemyManager::~EnemyManager(){
+	//接近BGMのエミッタを消す
+	for (const std::unique_ptr<StrongEnemy>& strongEnemy : strongEnemies_) {
+		audio_->DestroyEmitter(strongEnemy->GetApproachEmitterId());
+	}
+}
+
 
 void EnemyManager::Initialize(const uint32_t& normalEnemyModel,const uint32_t& strongEnemyModel, const std::string& csvPath){
 	
@@ -43,6 +52,10 @@ void EnemyManager::Initialize(const uint32_t& normalEnemyModel,const uint32_t& s
 	//強敵
 	strongEnemyModelHandle_ = strongEnemyModel;
 
+	//接近BGMの設定
+	//強敵を生成する時にエミッタを作るので先に読み込む
+	audioHandle_ = audio_->Load("Resources/Audio/Enemy/TrackingToPlayer.mp3");
+
 	//ファイルを開ける
 	std::ifstream file;
 	file.open(csvPath);
@@ -116,9 +129,6 @@ void EnemyManager::Initialize(const uint32_t& normalEnemyModel,const uint32_t& s
 
 
 	}
-
-	//接近BGMの設定
-	audioHandle_ = audio_->Load("Resources/Audio/Enemy/TrackingToPlayer.mp3");
 }
 
 void EnemyManager::DeleteEnemy(){
@@ -131,7 +141,9 @@ void EnemyManager::DeleteEnemy(){
 }
 
 void EnemyManager::StopAudio(){
-	audio_->Stop(audioHandle_);
+	for (const std::unique_ptr<StrongEnemy>& strongEnemy : strongEnemies_) {
+		audio_->StopEmitter(strongEnemy->GetApproachEmitterId());
+	}
 }
 
 void EnemyManager::GenerateNormalEnemy(const Vector3& position) {
@@ -162,11 +174,28 @@ void EnemyManager::GenerateStrongEnemy(const Vector3& position){
 	//初期化
 	enemy->Initialize(strongEnemyModelHandle_, position, speed);
 	enemy->SetTrackingStartDistance(STRONG_ENEMY_TRACKING_START_DISTANCE_);
+
+	//接近BGM
+	//追跡開始の距離で聞こえなくなるように線形で減衰させる
+	const Elysia::AudioEmitterSettings APPROACH_SETTINGS = {
+		.minDistance = 0.0f,
+		.maxDistance = STRONG_ENEMY_TRACKING_START_DISTANCE_,
+		.curve = Elysia::AttenuationCurve::Linear,
+		.coneInnerAngle = 2.0f * std::numbers::pi_v<float>,
+		.coneOuterAngle = 2.0f * std::numbers::pi_v<float>,
+		.coneOuterGain = 1.0f,
+		.priority = APPROACH_SE_PRIORITY_,
+	};
+	uint32_t emitterId = audio_->CreateEmitter(audioHandle_, APPROACH_SETTINGS, true);
+	audio_->SetEmitterPosition(emitterId, position);
+	audio_->PlayEmitter(emitterId);
+	enemy->SetApproachEmitterId(emitterId);
 	//挿入
 	strongEnemies_.push_back(std::move(enemy));
 }
 
 void EnemyManager::Update(){
+	ELYSIA_PROFILE_SCOPE("EnemyManager::Update");
 
 	//接近するときの距離
 	const float TRACKING_START_DISTANCE_ = 15.0f;
@@ -534,31 +563,13 @@ void EnemyManager::Update(){
 		Vector3 directionToPlayer = VectorCalculation::Normalize(playerStrongEnemyDifference);
 
 
-		//大きさの処理
-		//追跡開始する距離と強敵とプレイヤーの距離の割合で音量を決める
-		const float MAX_VOLUME = 1.0f;
-		float volume = MAX_VOLUME - (playerStrongEnemyDistance / STRONG_ENEMY_TRACKING_START_DISTANCE_);
-
-
-		//0だったら鳴らす意味はないので止めておく
-		const float MIN_VOLUME = 0.0f;
-		if (volume < MIN_VOLUME) {
-			audio_->Stop(audioHandle_);
-		}
-		else {
-			//再生
-			audio_->Play(audioHandle_, true);
-		}
-
-		//音量変化
-		audio_->ChangeVolume(audioHandle_, volume);
-
-
+		//接近BGMは強敵の位置から鳴らす
+		//音量と左右はAudio::Update3Dで聞き手との距離から決まる
+		audio_->SetEmitterPosition(strongEnemy->GetApproachEmitterId(), strongEnemy->GetWorldPosition());
 
 
 #ifdef _DEBUG
 		ImGui::Begin("強敵");
-		ImGui::InputFloat("距離", &volume);
 		ImGui::InputFloat3("プレイヤーとの方向", &directionToPlayer.x);
 		ImGui::InputFloat3("プレイヤーとの差分", &playerStrongEnemyDifference.x);
 		ImGui::InputFloat("プレイヤーとの距離", &playerStrongEnemyDistance);
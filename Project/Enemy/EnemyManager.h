@@ -83,7 +83,7 @@ public:
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
-	~EnemyManager()=default;
+	~EnemyManager();
 
 public:
 
@@ -169,6 +169,8 @@ private:
 	const float FRONT_DOT_ = 0.7f;
 	//追跡開始の距離
 	const float STRONG_ENEMY_TRACKING_START_DISTANCE_ = 30.0f;
+	//接近BGMの優先度(ボイスが足りない時)
+	const int32_t APPROACH_SE_PRIORITY_ = 8;
 
 private:
 	//エネミーのリスト
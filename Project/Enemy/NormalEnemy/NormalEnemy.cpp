@@ -78,7 +78,10 @@ void NormalEnemy::Initialize(const uint32_t& modelHandle, const Vector3& positio
 	globalVariables_->CreateGroup(GROUNP_NAME_);
 	//振動
 	globalVariables_->AddItem(GROUNP_NAME_, "ShakeOffset", shakeOffset_);
-	shakeOffset_ = globalVariables_->GetFloatValue(GROUNP_NAME_, "ShakeOffset");
+	//敵の数だけ探さなくて良いようにハンドルにしておく
+	//調整した値がそのまま反映される
+	shakeOffsetHandle_ = globalVariables_->Bind<float>(GROUNP_NAME_, "ShakeOffset");
+	shakeOffset_ = shakeOffsetHandle_.Get();
 
 	//状態
 	currentState_ = std::make_unique<NormalEnemyMove>();
@@ -163,6 +166,7 @@ void NormalEnemy::Draw(const Camera& camera, const SpotLight& spotLight) {
 }
 
 NormalEnemy::~NormalEnemy() {
+	//調整した時だけ裏のスレッドで書かれるので、敵が何体消えても止まらない
 	globalVariables_->SaveFile(GROUNP_NAME_);
 }
 
@@ -197,6 +201,7 @@ void NormalEnemy::Damaged() {
 
 
 			//現在の座標に加える
+			shakeOffset_ = shakeOffsetHandle_.Get();
 			worldTransform_.translate.x += distribute(randomEngine) * (1.0f - material_.color.y) * shakeOffset_;
 			worldTransform_.translate.z += distribute(randomEngine) * (1.0f - material_.color.y) * shakeOffset_;
 		}
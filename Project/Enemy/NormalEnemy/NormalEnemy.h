@@ -21,6 +21,7 @@
 #include "EnemyFlashLightCollision.h"
 #include "Enemy/BaseEnemy.h"
 #include "State/BaseNormalEnemyState.h"
+#include "GlobalVariableHandle.h"
 
 #pragma region 前方宣言
 
@@ -196,6 +197,8 @@ private:
 
 	//振動のオフセット
 	float_t shakeOffset_ = 0.05f;
+	//調整項目の振動のオフセット
+	Elysia::GlobalVariableHandle<float> shakeOffsetHandle_ = {};
 	bool isShake_ = false;
 
 	
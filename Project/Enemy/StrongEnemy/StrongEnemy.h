@@ -91,6 +91,22 @@ public:
 	inline StrongEnemyCollisionToPlayer* GetStrongEnemyCollisionToPlayer()const {
 		return collisionToPlayer_.get();
 	}
+
+	/// <summary>
+	/// 接近音のエミッタを設定
+	/// </summary>
+	/// <param name="emitterId">エミッタの番号</param>
+	inline void SetApproachEmitterId(const uint32_t& emitterId) {
+		this->approachEmitterId_ = emitterId;
+	}
+
+	/// <summary>
+	/// 接近音のエミッタを取得
+	/// </summary>
+	/// <returns>エミッタの番号</returns>
+	inline uint32_t GetApproachEmitterId()const {
+		return approachEmitterId_;
+	}
 private:
 
 	//追跡開始距離
@@ -99,6 +115,8 @@ private:
 	std::unique_ptr<StrongEnemyCollisionToPlayer> collisionToPlayer_ = nullptr;
 	//行動状態
 	std::unique_ptr<BaseStongEnemyState> currentState_ = nullptr;
+	//接近音のエミッタ
+	uint32_t approachEmitterId_ = 0u;
 
 	
 };
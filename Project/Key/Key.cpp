@@ -7,6 +7,7 @@
 #include "TextureManager.h"
 #include "Easing.h"
 #include "SingleCalculation.h"
+#include "UserInterface/UserInterfaceAtlas.h"
 
 void Key::Initialize(const uint32_t& modelhandle,const Vector3& position){
 	//モデルの生成
@@ -36,8 +37,8 @@ void Key::Initialize(const uint32_t& modelhandle,const Vector3& position){
 
 
 	//鍵のスプライト
-	uint32_t textureHandle = Elysia::TextureManager::GetInstance()->Load("Resources/Sprite/Item/Key/Key.png");
-	sprite_.reset(Elysia::Sprite::Create(textureHandle, {.x=0.0f,.y=0.0f}));
+	Elysia::TextureRegion textureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Item/Key/Key.png");
+	sprite_.reset(Elysia::Sprite::Create(textureRegion, {.x=0.0f,.y=0.0f}));
 	//アンカーポイントを設定する
 	const Vector2 ANCHOR_POINT = { .x = 0.5f,.y = 0.5f };
 	sprite_->SetAnchorPoint(ANCHOR_POINT);
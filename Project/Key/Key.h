@@ -161,6 +161,22 @@ public:
 		return isDelete_;
 	}
 
+	/// <summary>
+	/// 場所を知らせる音のエミッタを設定
+	/// </summary>
+	/// <param name="emitterId">エミッタの番号</param>
+	inline void SetNotificationEmitterId(const uint32_t& emitterId) {
+		this->notificationEmitterId_ = emitterId;
+	}
+
+	/// <summary>
+	/// 場所を知らせる音のエミッタを取得
+	/// </summary>
+	/// <returns>エミッタの番号</returns>
+	inline uint32_t GetNotificationEmitterId()const {
+		return notificationEmitterId_;
+	}
+
 private:
 	
 	//上下移動の大きさ
@@ -215,6 +231,8 @@ private:
 
 	//消える
 	bool isDelete_ = false;
+	//場所を知らせる音のエミッタ
+	uint32_t notificationEmitterId_ = 0u;
 
 private:
 
@@ -3,6 +3,7 @@
 #include <imgui.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <numbers>
 
 #include "TextureManager.h"
 #include "Input.h"
@@ -11,6 +12,7 @@
 #include "Player/Player.h"
 #include "SingleCalculation.h"
 #include "Easing.h"
+#include "UserInterface/UserInterfaceAtlas.h"
 
 KeyManager::KeyManager() {
 	//インスタンスの取得
@@ -24,6 +26,13 @@ KeyManager::KeyManager() {
 	levelDataManager_ = Elysia::LevelDataManager::GetInstance();
 }
 
+KeyManager::~KeyManager() {
+	//場所を知らせる音のエミッタを消す
+	for (const std::unique_ptr<Key>& key : keies_) {
+		audio_->DestroyEmitter(key->GetNotificationEmitterId());
+	}
+}
+
 void KeyManager::Initialize(const uint32_t& modelHandle, const std::vector<Vector3>& positions) {
 	//プレイヤーが入っているかどうか
 	assert(player_ != nullptr);
@@ -31,8 +40,15 @@ void KeyManager::Initialize(const uint32_t& modelHandle, const std::vector<Vecto
 	//モデルハンドルの代入
 	modelHandle_ = modelHandle;
 
+	//オブジェクトのハンドルの取得
+	keyInHouseHandle_ = levelDataManager_->GetObjectHandle(levelDataHandle_, "KeyInHouse");
+	keyInCemeteryHandle_ = levelDataManager_->GetObjectHandle(levelDataHandle_, "KeyInCemetery");
 
-	Vector3 keyInHousePosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, "KeyInHouse");
+	Vector3 keyInHousePosition = levelDataManager_->GetInitialTranslate(keyInHouseHandle_);
+
+	//知らせる音の読み込み
+	//鍵を生成する時にエミッタを作るので先に読み込む
+	notificationSEHandle_ = audio_->Load("Resources/External/Audio/Key/Shake.mp3");
 
 	for (int i = 0; i < positions.size(); ++i) {
 		//生成
@@ -50,14 +66,14 @@ void KeyManager::Initialize(const uint32_t& modelHandle, const std::vector<Vecto
 
 	//読み込み
 	//リスト
-	uint32_t keyListSpriteHandle = textureManager_->Load("Resources/Sprite/Item/KeyList.png");
+	Elysia::TextureRegion keyListTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Item/KeyList.png");
 	//生成
-	keyListSprite_.reset(Elysia::Sprite::Create(keyListSpriteHandle, initialPosition_));
+	keyListSprite_.reset(Elysia::Sprite::Create(keyListTextureRegion, initialPosition_));
 
-	uint32_t textureHandle = Elysia::TextureManager::GetInstance()->Load("Resources/Sprite/Item/Key/Key.png");
+	Elysia::TextureRegion keyTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Item/Key/Key.png");
 	//サイズを取得
-	keySpriteWidth_ = textureManager_->GetTextureWidth(textureHandle);
-	keySpriteHeight_ = textureManager_->GetTextureHeight(textureHandle);
+	keySpriteWidth_ = static_cast<uint64_t>(keyTextureRegion.size.x);
+	keySpriteHeight_ = static_cast<uint64_t>(keyTextureRegion.size.y);
 
 
 	//鍵
@@ -69,7 +85,7 @@ void KeyManager::Initialize(const uint32_t& modelHandle, const std::vector<Vecto
 			.x = initialPositionAddAnchorPoint.x + keySpriteWidth_ * static_cast<float>(i),
 			.y = initialPositionAddAnchorPoint.y
 		};
-		keySprites_[i].reset(Elysia::Sprite::Create(textureHandle, position));
+		keySprites_[i].reset(Elysia::Sprite::Create(keyTextureRegion, position));
 		//アンカーポイントの設定
 		keySprites_[i]->SetAnchorPoint(ANCHOR_POINT);
 		//初期スケール
@@ -79,33 +95,22 @@ void KeyManager::Initialize(const uint32_t& modelHandle, const std::vector<Vecto
 
 
 
-	//知らせる音の読み込み
-	notificationSEHandle_ = audio_->Load("Resources/External/Audio/Key/Shake.mp3");
 	//拾う音の読み込み
 	pickUpSEHandle = audio_->Load("Resources/External/Audio/Key/PickUp.mp3");
 	//皿の落ちる音の読み込み
 	dropPlateSEHandle_ = audio_->Load("Resources/External/Audio/Plate/DropPlateSE.wav");
 
 	//拾う画像の読み込み
-	uint32_t pickUpTextureManager = textureManager_->Load("Resources/Sprite/Key/PickUpKey.png");
+	Elysia::TextureRegion pickUpTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Key/PickUpKey.png");
 	//生成
 	const Vector2 INITIAL_FADE_POSITION = { .x = 0.0f,.y = 0.0f };
-	pickUpKey_.reset(Elysia::Sprite::Create(pickUpTextureManager, INITIAL_FADE_POSITION));
-
-
-	//再生
-	audio_->Play(notificationSEHandle_, true);
-	//初期の音の設定
-	const float INITIAL_VOLUME = 0.0f;
-	audio_->ChangeVolume(notificationSEHandle_, INITIAL_VOLUME);
+	pickUpKey_.reset(Elysia::Sprite::Create(pickUpTextureRegion, INITIAL_FADE_POSITION));
 }
 
 
 void KeyManager::Update() {
 
-	//全ての要素を消す
-	keyAndPlayerDistances_.clear();
-	Vector3 keyInHousePosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, "KeyInHouse");
+	Vector3 keyInHousePosition = levelDataManager_->GetInitialTranslate(keyInHouseHandle_);
 	//鍵
 	for (const std::unique_ptr<Key>& key : keies_) {
 
@@ -124,40 +129,9 @@ void KeyManager::Update() {
 			.y = initialPosition_.y
 		};
 		key->SetEndPosition(endPosition);
-		//プレイヤーと鍵の差分
-		Vector3 playerAndKeydifference = VectorCalculation::Subtract(player_->GetWorldPosition(), key->GetWorldPosition());
-		//距離
-		float distance = SingleCalculation::Length(playerAndKeydifference);
-		//挿入
-		keyAndPlayerDistances_.push_back(distance);
-	}
-
-	//全ての要素から一番小さい値を調べる
-	auto minIt = std::min_element(keyAndPlayerDistances_.begin(), keyAndPlayerDistances_.end());
-
-	//最短距離を求める
-	float closestDistance = 0.0f;
-	if (minIt != keyAndPlayerDistances_.end()) {
-		closestDistance = (*minIt);
-	}
-
-	//最大の距離を超えないようにする
-	if (closestDistance > MAX_DISTANCE_) {
-		closestDistance = MAX_DISTANCE_;
-	}
-
-	//求めた値から音量設定をする
-	float volume = 1.0f - (closestDistance / MAX_DISTANCE_);
-	audio_->ChangeVolume(notificationSEHandle_, volume);
-
-
-
-
-
-	//現在の鍵の数
-	size_t currentKeyQuantity = keies_.size();
-	if (currentKeyQuantity == 0u) {
-		audio_->Stop(notificationSEHandle_);
+		//場所を知らせる音は鍵の位置から鳴らす
+		//音量と左右はAudio::Update3Dで聞き手との距離から決まる
+		audio_->SetEmitterPosition(key->GetNotificationEmitterId(), key->GetWorldPosition());
 	}
 
 	//取得処理
@@ -168,8 +142,6 @@ void KeyManager::Update() {
 
 #ifdef _DEBUG
 	ImGui::Begin("鍵管理クラス");
-	ImGui::InputFloat("音量", &volume);
-	ImGui::InputFloat("近い距離", &closestDistance);
 	ImGui::Checkbox("墓場用", &isPickUpKeyInCemetery_);
 
 	int newQuantity = static_cast<int>(keyQuantity_);
@@ -223,6 +195,21 @@ void KeyManager::Genarate(const Vector3& position, const bool& isAbleToPickUp) {
 	key->Initialize(modelHandle_, position);
 	//取得可能かどうかの設定
 	key->SetisAbleToPickUp(isAbleToPickUp);
+	//場所を知らせる音
+	//聞こえる最大距離でちょうど聞こえなくなるように線形で減衰させる
+	const Elysia::AudioEmitterSettings NOTIFICATION_SETTINGS = {
+		.minDistance = 0.0f,
+		.maxDistance = MAX_DISTANCE_,
+		.curve = Elysia::AttenuationCurve::Linear,
+		.coneInnerAngle = 2.0f * std::numbers::pi_v<float>,
+		.coneOuterAngle = 2.0f * std::numbers::pi_v<float>,
+		.coneOuterGain = 1.0f,
+		.priority = NOTIFICATION_SE_PRIORITY_,
+	};
+	uint32_t emitterId = audio_->CreateEmitter(notificationSEHandle_, NOTIFICATION_SETTINGS, true);
+	audio_->SetEmitterPosition(emitterId, position);
+	audio_->PlayEmitter(emitterId);
+	key->SetNotificationEmitterId(emitterId);
 	//リストに入れる
 	keies_.push_back(std::move(key));
 }
@@ -235,14 +222,14 @@ void KeyManager::Delete() {
 		if (key->GetIsDelete() == true) {
 
 			//墓場用
-			Vector3 keyInCementeryPosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, "KeyInCemetery");
+			Vector3 keyInCementeryPosition = levelDataManager_->GetInitialTranslate(keyInCemeteryHandle_);
 			if (key->GetWorldPosition().x == keyInCementeryPosition.x &&
 				key->GetWorldPosition().z == keyInCementeryPosition.z) {
 				isPickUpKeyInCemetery_ = true;
 			}
 
 			//小屋用
-			Vector3 keyInHousePosition = levelDataManager_->GetInitialTranslate(levelDataHandle_, "KeyInHouse");
+			Vector3 keyInHousePosition = levelDataManager_->GetInitialTranslate(keyInHouseHandle_);
 			if (key->GetWorldPosition().x == keyInHousePosition.x &&
 				key->GetWorldPosition().z == keyInHousePosition.z) {
 				isPickUpKeyInHouse_ = true;
@@ -261,6 +248,8 @@ void KeyManager::Delete() {
 			keySprites_[keyQuantity_]->SetRotate(rotate);
 			if (spriteTs_[keyQuantity_] >= 1.0f) {
 				++keyQuantity_;
+				//場所を知らせる音のエミッタも消す
+				audio_->DestroyEmitter(key->GetNotificationEmitterId());
 				return true;
 			}
 
@@ -275,7 +264,7 @@ void KeyManager::Delete() {
 
 		const uint32_t SE_PLAY_TIME = 60 * 1;
 		if (dropPlateTime_ == SE_PLAY_TIME) {
-			audio_->Play(dropPlateSEHandle_, false);
+			audio_->PlayOneShot(dropPlateSEHandle_, DROP_PLATE_SE_PRIORITY_, 1.0f);
 		}
 
 	}
@@ -314,8 +303,10 @@ void KeyManager::PickUp() {
 					player_->AddHaveKeyQuantity();
 					//鍵が取得される
 					key->PickedUp();
+					//場所を知らせる音を止める
+					audio_->StopEmitter(key->GetNotificationEmitterId());
 					//取得の音が鳴る
-					audio_->Play(pickUpSEHandle, false);
+					audio_->PlayOneShot(pickUpSEHandle, PICK_UP_SE_PRIORITY_, 1.0f);
 				}
 
 				if (input_->IsTriggerButton(XINPUT_GAMEPAD_B) == true) {
@@ -323,8 +314,10 @@ void KeyManager::PickUp() {
 					player_->AddHaveKeyQuantity();
 					//鍵が取得される
 					key->PickedUp();
+					//場所を知らせる音を止める
+					audio_->StopEmitter(key->GetNotificationEmitterId());
 					//取得の音が鳴る
-					audio_->Play(pickUpSEHandle, false);
+					audio_->PlayOneShot(pickUpSEHandle, PICK_UP_SE_PRIORITY_, 1.0f);
 				}
 
 				
@@ -355,5 +348,7 @@ void KeyManager::PickUp() {
 
 
 void KeyManager::StopAudio() {
-	audio_->ChangeVolume(notificationSEHandle_, 0.0f);
+	for (const std::unique_ptr<Key>& key : keies_) {
+		audio_->StopEmitter(key->GetNotificationEmitterId());
+	}
 }
\ No newline at end of file
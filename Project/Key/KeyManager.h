@@ -12,6 +12,7 @@
 #include "Audio.h"
 #include "Key.h"
 #include "Sprite.h"
+#include "LevelObjectHandle.h"
 
 
 #pragma region 前方宣言
@@ -98,7 +99,7 @@ public:
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
-	~KeyManager() = default;
+	~KeyManager();
 
 
 private:
@@ -203,6 +204,10 @@ private:
 	Elysia::LevelDataManager* levelDataManager_ = nullptr;
 	//ハンドル
 	uint32_t levelDataHandle_ = 0u;
+	//小屋の中の鍵のハンドル
+	Elysia::LevelObjectHandle keyInHouseHandle_ = {};
+	//墓場の鍵のハンドル
+	Elysia::LevelObjectHandle keyInCemeteryHandle_ = {};
 	//プレイヤー
 	Player* player_ = nullptr;
 
@@ -249,11 +254,13 @@ private:
 	std::array<Vector2, MAX_KEY_QUANTITY_> endPositions_ = {};
 	//鍵取得するかどうか
 	std::unique_ptr<Elysia::Sprite> pickUpKey_ = nullptr;
-	//プレイヤーと全ての鍵の距離
-	std::list<float>keyAndPlayerDistances_ = {};
 
 	//拾う音
 	uint32_t pickUpSEHandle = 0u;
+	//効果音の優先度(続けて拾っても重ねて鳴らす)
+	const int32_t PICK_UP_SE_PRIORITY_ = 10;
+	const int32_t DROP_PLATE_SE_PRIORITY_ = 5;
+	const int32_t NOTIFICATION_SE_PRIORITY_ = 1;
 	//鍵の場所を知らせる音
 	uint32_t notificationSEHandle_ = 0u;
 	//取得可能か
@@ -11,6 +11,8 @@
 #include "TextureManager.h"
 #include "VectorCalculation.h"
 #include "SingleCalculation.h"
+#include "UserInterface/UserInterfaceAtlas.h"
+#include "GameClock.h"
 
 
 FlashLight::FlashLight() {
@@ -38,6 +40,13 @@ void FlashLight::Initialize() {
 	globalVariables_->AddItem(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_DECREASE_STRING_, chargeDecreaseValue_);
 	globalVariables_->AddItem(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_GAUGE_SPRITE_POSITION_STRING_, chargeGaugeSpritePosition_);
 	globalVariables_->AddItem(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_PARTICLE_RELEASE_TIME_, releaseTime_);
+	//毎フレーム読むものは探さなくて良いようにハンドルにしておく
+	maxIntensityHandle_ = globalVariables_->Bind<float>(FLASH_LIGHT_INTENSITY_STRING_, MAX_STRING_);
+	minIntensityHandle_ = globalVariables_->Bind<float>(FLASH_LIGHT_INTENSITY_STRING_, MIN_STRING_);
+	maxStartHandle_ = globalVariables_->Bind<float>(FLASH_LIGHT_COS_FALLOWOFF_START_STRING_, MAX_STRING_);
+	minStartHandle_ = globalVariables_->Bind<float>(FLASH_LIGHT_COS_FALLOWOFF_START_STRING_, MIN_STRING_);
+	chargeGaugeSpritePositionHandle_ = globalVariables_->Bind<Vector2>(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_GAUGE_SPRITE_POSITION_STRING_);
+	releaseTimeHandle_ = globalVariables_->Bind<float>(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_PARTICLE_RELEASE_TIME_);
 
 	//スポットライトの初期化
 	spotLight_.Initialize();
@@ -60,9 +69,9 @@ void FlashLight::Initialize() {
 	fan3D_.sidePhiAngleSize = lightSideTheta_;
 
 	//ゲージのスプライトを生成
-	uint32_t gaugeTextureHandle = textureManager_->Load("Resources/Sprite/Gauge/Gauge.png");
+	Elysia::TextureRegion gaugeTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Gauge/Gauge.png");
 	chargeGaugeSpritePosition_ = globalVariables_->GetVector2Value(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_GAUGE_SPRITE_POSITION_STRING_);
-	chargeGaugeSprite_.reset(Elysia::Sprite::Create(gaugeTextureHandle, chargeGaugeSpritePosition_));
+	chargeGaugeSprite_.reset(Elysia::Sprite::Create(gaugeTextureRegion, chargeGaugeSpritePosition_));
 	//チャージの増減値
 	chargeIncreaseValue_ = globalVariables_->GetFloatValue(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_INCREASE_STRING_);
 	chargeDecreaseValue_= globalVariables_->GetFloatValue(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_DECREASE_STRING_);
@@ -71,8 +80,8 @@ void FlashLight::Initialize() {
 	releaseTime_=globalVariables_->GetFloatValue(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_PARTICLE_RELEASE_TIME_);
 
 	//フレーム
-	uint32_t frameSpriteHandle = textureManager_->Load("Resources/Sprite/Gauge/GaugeFrame.png");
-	frameSprite_.reset(Elysia::Sprite::Create(frameSpriteHandle, chargeGaugeSpritePosition_));
+	Elysia::TextureRegion frameTextureRegion = UserInterfaceAtlas::GetRegion("Resources/Sprite/Gauge/GaugeFrame.png");
+	frameSprite_.reset(Elysia::Sprite::Create(frameTextureRegion, chargeGaugeSpritePosition_));
 	//当たり判定の初期化
 	flashLightCollision_ = std::make_unique<FlashLightCollision>();
 	flashLightCollision_->Initialize();
@@ -144,16 +153,16 @@ void FlashLight::Update() {
 
 	//幅から強さを計算する
 	//最大の強さ
-	maxIntensity_ = globalVariables_->GetFloatValue(FLASH_LIGHT_INTENSITY_STRING_, MAX_STRING_);
+	maxIntensity_ = maxIntensityHandle_.Get();
 	//最小の強さ
-	minIntensity_ = globalVariables_->GetFloatValue(FLASH_LIGHT_INTENSITY_STRING_, MIN_STRING_);
+	minIntensity_ = minIntensityHandle_.Get();
 	spotLight_.intensity = SingleCalculation::Lerp(minIntensity_, maxIntensity_, (1.0f - ratio_));
 
 	//cosFallowoffStart
 	//最大
-	maxStart_ = globalVariables_->GetFloatValue(FLASH_LIGHT_COS_FALLOWOFF_START_STRING_, MAX_STRING_);
+	maxStart_ = maxStartHandle_.Get();
 	//最小
-	minStart_ = globalVariables_->GetFloatValue(FLASH_LIGHT_COS_FALLOWOFF_START_STRING_, MAX_STRING_);
+	minStart_ = minStartHandle_.Get();
 	spotLight_.cosFallowoffStart = SingleCalculation::Lerp(minStart_, maxStart_, ratio_);
 
 	//扇
@@ -245,7 +254,7 @@ void FlashLight::Charge() {
 		chargeValue_=std::min<float_t>(MAX_CHARGE_VALUE_, chargeValue_);
 		
 		//パーティクルの生成
-		readyForGenerateParticleTime_ += DELTA_TIME_;
+		readyForGenerateParticleTime_ += Elysia::GameClock::GetInstance()->GetFixedDeltaTime();
 		if (readyForGenerateParticleTime_>releaseTime_) {
 			//GenerateParticle();
 			readyForGenerateParticleTime_ = 0.0f;
@@ -345,11 +354,11 @@ void FlashLight::ImGuiDisplay() {
 
 void FlashLight::Adjustment() {
 	//チャージ座標
-	chargeGaugeSpritePosition_ = globalVariables_->GetVector2Value(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_GAUGE_SPRITE_POSITION_STRING_);
+	chargeGaugeSpritePosition_ = chargeGaugeSpritePositionHandle_.Get();
 	chargeGaugeSprite_->SetPosition(chargeGaugeSpritePosition_);
 
 	//パーティクルの放出時間
-	releaseTime_ = globalVariables_->GetFloatValue(FLASH_LIGHT_CHARGE_VALUE_, CHARGE_PARTICLE_RELEASE_TIME_);
+	releaseTime_ = releaseTimeHandle_.Get();
 
 	//保存
 	globalVariables_->SaveFile(FLASH_LIGHT_INTENSITY_STRING_);
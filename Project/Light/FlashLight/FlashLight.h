@@ -16,6 +16,7 @@
 #include "Model.h"
 #include "Material.h"
 #include "FlashLightCollision.h"
+#include "GlobalVariableHandle.h"
 
 
  /// <summary>
@@ -250,6 +251,14 @@ private:
 	const std::string CHARGE_PARTICLE_RELEASE_TIME_ = "PartcleReleaseTime";
 	float_t releaseTime_ = 0.0f;
 
+	//毎フレーム読む調整項目
+	Elysia::GlobalVariableHandle<float> maxIntensityHandle_ = {};
+	Elysia::GlobalVariableHandle<float> minIntensityHandle_ = {};
+	Elysia::GlobalVariableHandle<float> maxStartHandle_ = {};
+	Elysia::GlobalVariableHandle<float> minStartHandle_ = {};
+	Elysia::GlobalVariableHandle<Vector2> chargeGaugeSpritePositionHandle_ = {};
+	Elysia::GlobalVariableHandle<float> releaseTimeHandle_ = {};
+
 private:
 	//チャージスピード
 	const float_t CHARGE_INTERVAL_VALUE_ = 0.1f;
@@ -259,8 +268,6 @@ private:
 	const float_t MAX_CHARGE_VALUE_ = 10.0f;
 	//最小チャージの値
 	const float_t MIN_CHARGE_VALUE_ = 0.0f;
-	//時間増加
-	const float_t DELTA_TIME_ = 1.0f / 60.0f;
 
 private:
 	//スポットライト
@@ -10,6 +10,7 @@
 #include "SpotLight.h"
 #include "LevelDataManager.h"
 #include "PushBackCalculation.h"
+#include "GameClock.h"
 
 Player::Player(){
 
@@ -142,7 +143,7 @@ void Player::Damaged() {
 		//一時的にコントロールを失う
 		isControll_ = false;
 		//線形補間で振動処理をする
-		vibeTime_ += DELTA_TIME;
+		vibeTime_ += Elysia::GameClock::GetInstance()->GetFixedDeltaTime();
 		//最大の振動の強さ
 		const float MAX_VIBE_ = 1.0f;
 		//最小の振動の強さ
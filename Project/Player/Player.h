@@ -300,8 +300,6 @@ private:
 private:
 	//幅のサイズ
 	const float_t SIDE_SIZE = 0.5f;
-	//時間変化
-	const float_t DELTA_TIME = 1.0f / 60.0f;
 	//チャージの増える値
 	const float_t CHARGE_VALUE_ = 0.1f;
 
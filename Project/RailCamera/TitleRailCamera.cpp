@@ -107,7 +107,7 @@ void TitleRailCamera::Update(){
 	//ワールド行列を計算
 	worldTransform_.worldMatrix = Matrix4x4Calculation::MakeAffineMatrix(worldTransform_.scale, worldTransform_.rotate, worldTransform_.translate);
 	//ビュー行列の計算
-	camera_.viewMatrix = Matrix4x4Calculation::Inverse(worldTransform_.worldMatrix);
+	camera_.viewMatrix = Matrix4x4Calculation::InverseAffine(worldTransform_.worldMatrix);
 
 
 
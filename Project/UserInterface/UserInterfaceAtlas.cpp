@@ -0,0 +1,39 @@
+#include "UserInterfaceAtlas.h"
+
+#include <vector>
+
+#include "TextureManager.h"
+
+namespace {
+	//アトラスの名前
+	const std::string ATLAS_NAME_ = "UserInterfaceAtlas";
+
+	//まとめる画像
+	//1枚ずつ読み込むとSRVとリソースが画像の数だけ増え、描画のたびにテクスチャが切り替わる
+	const std::vector<std::string> FILE_PATHS_ = {
+		//プレイヤーのHP
+		"Resources/Sprite/Player/PlayerHP.png",
+		"Resources/Sprite/Player/PlayerHPBack.png",
+		//鍵
+		"Resources/Sprite/Item/Key/Key.png",
+		"Resources/Sprite/Item/KeyList.png",
+		"Resources/Sprite/Key/PickUpKey.png",
+		//懐中電灯のゲージ
+		"Resources/Sprite/Gauge/Gauge.png",
+		"Resources/Sprite/Gauge/GaugeFrame.png",
+		//説明
+		"Resources/Sprite/Explanation/Explanation1.png",
+		"Resources/Sprite/Explanation/Explanation2.png",
+		"Resources/Sprite/Explanation/ExplanationNext1.png",
+		"Resources/Sprite/Explanation/ExplanationNext2.png",
+		//脱出
+		"Resources/Sprite/Escape/EscapeText.png",
+		"Resources/Sprite/Escape/ToGoal.png",
+	};
+}
+
+Elysia::TextureRegion UserInterfaceAtlas::GetRegion(const std::string& filePath) {
+	//一度読み込んだら2回目からは何もしない
+	Elysia::TextureManager::LoadAtlas(ATLAS_NAME_, FILE_PATHS_);
+	return Elysia::TextureManager::GetInstance()->GetTextureRegion(filePath);
+}
@@ -0,0 +1,25 @@
+#pragma once
+/**
+ * @file UserInterfaceAtlas.h
+ * @brief UIの画像をまとめたアトラス
+ * @author 茂木翼
+ */
+
+#include <string>
+
+#include "TextureRegion.h"
+
+/// <summary>
+/// UIの画像をまとめたアトラス
+/// </summary>
+namespace UserInterfaceAtlas {
+
+	/// <summary>
+	/// 画像の範囲を取得
+	/// 最初に呼んだ時にUIの画像をまとめて読み込む
+	/// </summary>
+	/// <param name="filePath">元の画像のファイルパス</param>
+	/// <returns>範囲</returns>
+	Elysia::TextureRegion GetRegion(const std::string& filePath);
+
+}
@@ -0,0 +1,19 @@
+#include "SpriteBatch.hlsli"
+
+//まとめて描画するスプライトのPS
+//Object2dと同じく色とテクスチャを掛けるだけ
+
+Texture2D<float32_t4> gTexture : register(t0);
+SamplerState gSampler : register(s0);
+
+struct PixelShaderOutput {
+	float32_t4 color : SV_TARGET0;
+};
+
+
+PixelShaderOutput main(VertexShaderOutput input) {
+	PixelShaderOutput output;
+	float32_t4 textureColor = gTexture.Sample(gSampler, input.texcoord);
+	output.color = input.color * textureColor;
+	return output;
+}
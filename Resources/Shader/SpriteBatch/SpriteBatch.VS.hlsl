@@ -0,0 +1,21 @@
+#include "SpriteBatch.hlsli"
+
+//まとめて描画するスプライトのVS
+//座標はCPUでクリップ空間まで計算しているのでそのまま渡す
+
+struct VertexShaderInput {
+	float32_t4 position : POSITION0;
+	float32_t2 texcoord : TEXCOORD0;
+	float32_t4 color : COLOR0;
+};
+
+
+VertexShaderOutput main(VertexShaderInput input) {
+	VertexShaderOutput output;
+	output.position = input.position;
+	//UVトランスフォームもCPUで計算済み
+	output.texcoord = input.texcoord;
+	//マテリアルの色は頂点ごとに持つ
+	output.color = input.color;
+	return output;
+}
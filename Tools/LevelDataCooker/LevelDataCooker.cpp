@@ -0,0 +1,69 @@
+/**
+ * @file LevelDataCooker.cpp
+ * @brief レベルデータ(JSON)をバイナリ(.lvl)に変換するツール
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+#include "LevelDataBinary.h"
+#include "LevelDataParser.h"
+
+int main(int argc, char* argv[]) {
+	//レベルデータの場所
+	//引数で指定されたらそちらを使う
+	std::string levelDataDirectory = std::string(ELYSIA_RESOURCES_DIRECTORY) + "LevelData/";
+	if (argc > 1) {
+		levelDataDirectory = argv[1];
+	}
+
+	//Resources/LevelData/*/*.json
+	std::vector<std::string> filePaths;
+	for (const auto& folder : std::filesystem::directory_iterator(levelDataDirectory)) {
+		if (folder.is_directory() == false) {
+			continue;
+		}
+		for (const auto& entry : std::filesystem::directory_iterator(folder.path())) {
+			if (entry.is_regular_file() && entry.path().extension() == ".json") {
+				filePaths.push_back(entry.path().string());
+			}
+		}
+	}
+	std::sort(filePaths.begin(), filePaths.end());
+
+	uint32_t failedCount = 0u;
+	for (const std::string& filePath : filePaths) {
+		std::string cookedFilePath = LevelDataBinary::GetCookedFilePath(filePath);
+
+		//クック
+		if (LevelDataBinary::Cook(filePath) == false) {
+			std::printf("failed  %s\n", filePath.c_str());
+			++failedCount;
+			continue;
+		}
+
+		//読み戻して数が合っているか確認
+		Elysia::StringInterner stringInterner;
+		std::vector<Elysia::LevelObjectData> jsonObjectDatas;
+		std::vector<Elysia::LevelObjectData> cookedObjectDatas;
+		LevelDataParser::ParseWithSax(filePath, jsonObjectDatas, stringInterner);
+		if (LevelDataBinary::Read(cookedFilePath, cookedObjectDatas, stringInterner) == false ||
+			jsonObjectDatas.size() != cookedObjectDatas.size()) {
+			std::printf("failed  %s (verify)\n", filePath.c_str());
+			++failedCount;
+			continue;
+		}
+
+		std::printf("cooked  %-60s %8ju -> %8ju bytes, %zu objects\n",
+			cookedFilePath.c_str(),
+			static_cast<uintmax_t>(std::filesystem::file_size(filePath)),
+			static_cast<uintmax_t>(std::filesystem::file_size(cookedFilePath)),
+			cookedObjectDatas.size());
+	}
+
+	return (failedCount == 0u) ? 0 : 1;
+}
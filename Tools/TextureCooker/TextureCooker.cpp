@@ -0,0 +1,121 @@
+/**
+ * @file TextureCooker.cpp
+ * @brief テクスチャ(PNG)をミップマップ付きのBC圧縮DDSに変換するツール
+ * @author 茂木翼
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <filesystem>
+
+#include "MappedFile.h"
+#include "TextureCooker.h"
+
+namespace {
+
+	/// <summary>
+	/// 形式の名前
+	/// </summary>
+	/// <param name="format">形式</param>
+	/// <returns>名前</returns>
+	const char* GetFormatName(const uint32_t& format) {
+		switch (format) {
+		case TextureCooker::R8G8B8A8UnormSrgb:
+			return "RGBA8";
+		case TextureCooker::R8Unorm:
+			return "R8";
+		case TextureCooker::BC1UnormSrgb:
+			return "BC1";
+		case TextureCooker::BC3UnormSrgb:
+			return "BC3";
+		case TextureCooker::BC4Unorm:
+			return "BC4";
+		case TextureCooker::BC7UnormSrgb:
+			return "BC7";
+		default:
+			return "?";
+		}
+	}
+
+}
+
+int main(int argc, char* argv[]) {
+	//リソースの場所
+	//引数で指定されたらそちらを使う
+	std::string resourcesDirectory = ELYSIA_RESOURCES_DIRECTORY;
+	if (argc > 1) {
+		resourcesDirectory = argv[1];
+	}
+	std::filesystem::path cookedDirectory = std::filesystem::path(resourcesDirectory) / "Cooked" / "Texture";
+
+	//Resources/**/*.png
+	//jpgはWICのまま読む
+	std::vector<std::string> filePaths;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(resourcesDirectory)) {
+		if (entry.is_regular_file() && entry.path().extension() == ".png") {
+			filePaths.push_back(entry.path().string());
+		}
+	}
+	std::sort(filePaths.begin(), filePaths.end());
+
+	uint32_t failedCount = 0u;
+	std::set<std::string> usedFilePaths;
+	for (const std::string& filePath : filePaths) {
+		Elysia::MappedFile mappedFile;
+		if (mappedFile.Open(filePath) == false) {
+			std::printf("failed   %s (open)\n", filePath.c_str());
+			++failedCount;
+			continue;
+		}
+		uint64_t contentHash = TextureCooker::ComputeContentHash(mappedFile.GetData(), mappedFile.GetSize());
+		std::string cookedFilePath = TextureCooker::GetCookedFilePath(cookedDirectory.string() + "/", contentHash);
+		std::string cookedFileName = std::filesystem::path(cookedFilePath).filename().string();
+
+		//同じ中身はもうクックしてある
+		if (std::filesystem::exists(cookedFilePath)) {
+			usedFilePaths.insert(cookedFileName);
+			continue;
+		}
+
+		//16bitやインターレースは今まで通りWICで読む
+		if (TextureCooker::Cook(mappedFile.GetData(), mappedFile.GetSize(), cookedFilePath) == false) {
+			std::printf("skipped  %s\n", filePath.c_str());
+			continue;
+		}
+		usedFilePaths.insert(cookedFileName);
+
+		//読み戻してヘッダーを確認
+		Elysia::MappedFile cookedFile;
+		TextureCooker::DDSHeader header = {};
+		if (cookedFile.Open(cookedFilePath) == false || cookedFile.GetSize() < sizeof(TextureCooker::DDSHeader)) {
+			std::printf("failed   %s (verify)\n", filePath.c_str());
+			++failedCount;
+			continue;
+		}
+		std::memcpy(&header, cookedFile.GetData(), sizeof(TextureCooker::DDSHeader));
+		std::printf("cooked   %-80s %5ux%-5u %-5s %u mips %10zu -> %10zu bytes\n",
+			filePath.c_str(), header.width, header.height, GetFormatName(header.dxgiFormat), header.mipMapCount,
+			mappedFile.GetSize(), cookedFile.GetSize());
+	}
+
+	//元の画像が変わって使われなくなったものを消す
+	if (std::filesystem::exists(cookedDirectory)) {
+		std::vector<std::filesystem::path> unusedFilePaths;
+		for (const auto& entry : std::filesystem::directory_iterator(cookedDirectory)) {
+			if (usedFilePaths.contains(entry.path().filename().string()) == false) {
+				unusedFilePaths.push_back(entry.path());
+			}
+		}
+		for (const std::filesystem::path& unusedFilePath : unusedFilePaths) {
+			std::printf("removed  %s\n", unusedFilePath.string().c_str());
+			std::filesystem::remove(unusedFilePath);
+		}
+	}
+
+	std::printf("%zu textures, %zu cooked files\n", filePaths.size(), usedFilePaths.size());
+	return (failedCount == 0u) ? 0 : 1;
+}